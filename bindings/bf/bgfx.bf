@@ -739,6 +739,16 @@ public static class bgfx
 		/// </summary>
 		ReadBack               = 0x0000800000000000,
 	
+		/// <summary>
+		/// Texture mips are streamed in after texture is created.
+		/// </summary>
+		Streaming              = 0x0001000000000000,
+	
+		/// <summary>
+		/// Texture can be sampled by handle index from shader.
+		/// </summary>
+		Bindless               = 0x0002000000000000,
+	
 		/// <summary>
 		/// Render target MSAAx2 mode.
 		/// </summary>
@@ -1096,56 +1106,61 @@ public static class bgfx
 		/// </summary>
 		Texture3d              = 0x0000000000020000,
 	
+		/// <summary>
+		/// Bindless textures are supported.
+		/// </summary>
+		TextureBindless        = 0x0000000000040000,
+	
 		/// <summary>
 		/// Texture blit is supported.
 		/// </summary>
-		TextureBlit            = 0x0000000000040000,
-		TextureCompareReserved = 0x0000000000080000,
+		TextureBlit            = 0x0000000000080000,
+		TextureCompareReserved = 0x0000000000100000,
 	
 		/// <summary>
 		/// Texture compare less equal mode is supported.
 		/// </summary>
-		TextureCompareLequal   = 0x0000000000100000,
+		TextureCompareLequal   = 0x0000000000200000,
 	
 		/// <summary>
 		/// Cubemap texture array is supported.
 		/// </summary>
-		TextureCubeArray       = 0x0000000000200000,
+		TextureCubeArray       = 0x0000000000400000,
 	
 		/// <summary>
 		/// CPU direct access to GPU texture memory.
 		/// </summary>
-		TextureDirectAccess    = 0x0000000000400000,
+		TextureDirectAccess    = 0x0000000000800000,
 	
 		/// <summary>
 		/// Read-back texture is supported.
 		/// </summary>
-		TextureReadBack        = 0x0000000000800000,
+		TextureReadBack        = 0x0000000001000000,
 	
 		/// <summary>
 		/// Vertex attribute half-float is supported.
 		/// </summary>
-		VertexAttribHalf       = 0x0000000001000000,
+		VertexAttribHalf       = 0x0000000002000000,
 	
 		/// <summary>
 		/// Vertex attribute 10_10_10_2 is supported.
 		/// </summary>
-		VertexAttribUint10     = 0x0000000002000000,
+		VertexAttribUint10     = 0x0000000004000000,
 	
 		/// <summary>
 		/// Rendering with VertexID only is supported.
 		/// </summary>
-		VertexId               = 0x0000000004000000,
+		VertexId               = 0x0000000008000000,
 	
 		/// <summary>
 		/// Viewport layer is available in vertex shader.
 		/// </summary>
-		ViewportLayerArray     = 0x0000000008000000,
+		ViewportLayerArray     = 0x0000000010000000,
 	
 		/// <summary>
 		/// All texture compare modes are supported.
 		/// </summary>
-		TextureCompareAll      = 0x0000000000180000,
+		TextureCompareAll      = 0x0000000000300000,
 	}
 	
 	[AllowDuplicates]
@@ -2048,6 +2063,10 @@ public static class bgfx
 			public uint32 minResourceCbSize;
 			public uint32 transientVbSize;
 			public uint32 transientIbSize;
+			public uint32 maxDrawCalls;
+			public uint32 textureStreamSize;
+			public uint16 numWorkerThreads;
+			public uint16 renderItemBlock;
 		}
 	
 		public RendererType type;
@@ -2172,10 +2191,12 @@ public static class bgfx
 		public int64 gpuTimerFreq;
 		public int64 waitRender;
 		public int64 waitSubmit;
+		public int64 cpuTimeSort;
 		public uint32 numDraw;
 		public uint32 numCompute;
 		public uint32 numBlit;
 		public uint32 maxGpuLatency;
+		public uint32 numDropped;
 		public uint16 numDynamicIndexBuffers;
 		public uint16 numDynamicVertexBuffers;
 		public uint16 numFrameBuffers;
@@ -2189,8 +2210,14 @@ public static class bgfx
 		public uint16 numVertexLayouts;
 		public int64 textureMemoryUsed;
 		public int64 rtMemoryUsed;
+		public int64 textureStreamResident;
+		public int64 textureStreamPending;
 		public int transientVbUsed;
 		public int transientIbUsed;
+		public uint32 dynamicIbFree;
+		public uint32 dynamicIbLargestFree;
+		public uint32 dynamicVbFree;
+		public uint32 dynamicVbLargestFree;
 		public uint32[5] numPrims;
 		public int64 gpuMemoryMax;
 		public int64 gpuMemoryUsed;
@@ -2218,6 +2245,17 @@ public static class bgfx
 	{
 	}
 	
+	[CRepr]
+	public struct TopologySorter
+	{
+	}
+	
+	[CRepr]
+	public struct BundleHandle {
+	    public uint16 idx;
+	    public bool Valid => idx != uint16.MaxValue;
+	}
+	
 	[CRepr]
 	public struct DynamicIndexBufferHandle {
 	    public uint16 idx;
@@ -2272,6 +2310,12 @@ public static class bgfx
 	    public bool Valid => idx != uint16.MaxValue;
 	}
 	
+	[CRepr]
+	public struct UniformBlockHandle {
+	    public uint16 idx;
+	    public bool Valid => idx != uint16.MaxValue;
+	}
+	
 	[CRepr]
 	public struct UniformHandle {
 	    public uint16 idx;
@@ -2416,6 +2460,22 @@ public static class bgfx
 	[LinkName("bgfx_weld_vertices")]
 	public static extern uint32 weld_vertices(void* _output, VertexLayout* _layout, void* _data, uint32 _num, bool _index32, float _epsilon);
 	
+	/// <summary>
+	/// Weld vertices, and copy unique vertices into compacted vertex stream.
+	/// </summary>
+	///
+	/// <param name="_output">Welded vertices remapping table into `_outVertices`. The size of buffer must be the same as number of vertices.</param>
+	/// <param name="_outVertices">Unique vertices in order of first appearance. The size of buffer must be large enough for all vertices in vertex stream. It can be the same as `_data`.</param>
+	/// <param name="_layout">Vertex stream layout.</param>
+	/// <param name="_data">Vertex stream.</param>
+	/// <param name="_num">Number of vertices in vertex stream.</param>
+	/// <param name="_index32">Set to `true` if input indices are 32-bit.</param>
+	/// <param name="_epsilon">Error tolerance for vertex position comparison.</param>
+	/// <param name="_attributes">Set to `true` to weld only vertices with normal and first texture coordinate within error tolerance too.</param>
+	///
+	[LinkName("bgfx_weld_vertices_compact")]
+	public static extern uint32 weld_vertices_compact(void* _output, void* _outVertices, VertexLayout* _layout, void* _data, uint32 _num, bool _index32, float _epsilon, bool _attributes);
+	
 	/// <summary>
 	/// Convert index buffer for use with different primitive topologies.
 	/// </summary>
@@ -2537,6 +2597,20 @@ public static class bgfx
 	[LinkName("bgfx_get_stats")]
 	public static extern Stats* get_stats();
 	
+	/// <summary>
+	/// Release GPU memory blocks held by renderer's memory allocators that
+	/// have no live allocations.
+	/// @remarks
+	///   Partially used blocks are not compacted and live resources are not
+	///   moved. Memory of destroyed resources returns to allocator once GPU is
+	///   done with them, which is a few frames after destroy. Renderers without
+	///   their own memory allocator (everything except Vulkan) ignore it. It's
+	///   executed on render thread at next `bgfx::frame`.
+	/// </summary>
+	///
+	[LinkName("bgfx_defragment")]
+	public static extern void defragment();
+	
 	/// <summary>
 	/// Allocate buffer to pass to bgfx calls. Data will be freed inside bgfx.
 	/// </summary>
@@ -2982,6 +3056,32 @@ public static class bgfx
 	[LinkName("bgfx_destroy_program")]
 	public static extern void destroy_program(ProgramHandle _handle);
 	
+	/// <summary>
+	/// Compile pipeline state object for program, state and vertex layout combination
+	/// ahead of first use.
+	/// @remarks
+	///   Only renderers that compile pipeline state objects on first use (Vulkan) do
+	///   work here, it's no-op on other renderers.
+	/// </summary>
+	///
+	/// <param name="_program">Program handle.</param>
+	/// <param name="_state">State flags. See: `BGFX_STATE_*`.</param>
+	/// <param name="_layoutHandle">Vertex layout handle.</param>
+	/// <param name="_frameBuffer">Frame buffer whose render target formats pipeline is compiled for. Invalid handle means back buffer.</param>
+	///
+	[LinkName("bgfx_prewarm_pipeline")]
+	public static extern void prewarm_pipeline(ProgramHandle _program, uint64 _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer);
+	
+	/// <summary>
+	/// Write merged pipeline cache blob with `CallbackI::cacheWrite`.
+	/// @remarks
+	///   Pipeline cache is written at shutdown too. Only renderers that keep pipeline
+	///   cache (Vulkan, Direct3D 12) do work here.
+	/// </summary>
+	///
+	[LinkName("bgfx_flush_pipeline_cache")]
+	public static extern void flush_pipeline_cache();
+	
 	/// <summary>
 	/// Validate texture parameters.
 	/// </summary>
@@ -3334,6 +3434,40 @@ public static class bgfx
 	[LinkName("bgfx_destroy_uniform")]
 	public static extern void destroy_uniform(UniformHandle _handle);
 	
+	/// <summary>
+	/// Create uniform block.
+	///
+	/// @remarks
+	///   Uniform block holds values of multiple uniforms. Block is written once
+	///   with `bgfx::updateUniformBlock` and referenced by draw calls with
+	///   `bgfx::setUniformBlock`. Values persist across frames until updated.
+	/// </summary>
+	///
+	[LinkName("bgfx_create_uniform_block")]
+	public static extern UniformBlockHandle create_uniform_block();
+	
+	/// <summary>
+	/// Update uniform value stored in uniform block. Changes are visible to all
+	/// draw calls referencing block starting with next `bgfx::frame` call.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to uniform block object.</param>
+	/// <param name="_uniform">Uniform.</param>
+	/// <param name="_value">Pointer to uniform data.</param>
+	/// <param name="_num">Number of elements. Passing `UINT16_MAX` will use the _num passed on uniform creation.</param>
+	///
+	[LinkName("bgfx_update_uniform_block")]
+	public static extern void update_uniform_block(UniformBlockHandle _handle, UniformHandle _uniform, void* _value, uint16 _num);
+	
+	/// <summary>
+	/// Destroy uniform block.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to uniform block object.</param>
+	///
+	[LinkName("bgfx_destroy_uniform_block")]
+	public static extern void destroy_uniform_block(UniformBlockHandle _handle);
+	
 	/// <summary>
 	/// Create occlusion query.
 	/// </summary>
@@ -3360,6 +3494,60 @@ public static class bgfx
 	[LinkName("bgfx_destroy_occlusion_query")]
 	public static extern void destroy_occlusion_query(OcclusionQueryHandle _handle);
 	
+	/// <summary>
+	/// Destroy bundle.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to bundle object.</param>
+	///
+	[LinkName("bgfx_destroy_bundle")]
+	public static extern void destroy_bundle(BundleHandle _handle);
+	
+	/// <summary>
+	/// Create topology sorter. Sorter can be created and used before `bgfx::init` and after
+	/// `bgfx::shutdown`.
+	/// </summary>
+	///
+	/// <param name="_allocator">Allocator used for sorter and its scratch memory. When NULL, default allocator is used. Allocator passed to `bgfx::init` is not used, since sorter can outlive it.</param>
+	///
+	[LinkName("bgfx_create_topology_sorter")]
+	public static extern TopologySorter* create_topology_sorter(void* _allocator);
+	
+	/// <summary>
+	/// Sort indices. Sort keys of meshes with more than 100K triangles are calculated on
+	/// worker threads shared with other vertex and index utility functions.
+	/// </summary>
+	///
+	/// <param name="_sort">Sort order, see `TopologySort::Enum`.</param>
+	/// <param name="_dst">Destination index buffer.</param>
+	/// <param name="_dstSize">Destination index buffer in bytes. It must be large enough to contain output indices. If destination size is insufficient index buffer will be truncated.</param>
+	/// <param name="_dir">Direction (vector must be normalized).</param>
+	/// <param name="_pos">Position.</param>
+	/// <param name="_vertices">Pointer to first vertex represented as float x, y, z. Must contain at least number of vertices referencende by index buffer.</param>
+	/// <param name="_stride">Vertex stride.</param>
+	/// <param name="_indices">Source indices.</param>
+	/// <param name="_numIndices">Number of input indices.</param>
+	/// <param name="_index32">Set to `true` if input indices are 32-bit.</param>
+	///
+	[LinkName("bgfx_topology_sorter_sort_tri_list")]
+	public static extern void topology_sorter_sort_tri_list(TopologySorter* _this, TopologySort _sort, void* _dst, uint32 _dstSize, float _dir, float _pos, void* _vertices, uint32 _stride, void* _indices, uint32 _numIndices, bool _index32);
+	
+	/// <summary>
+	/// Forget previous order, next sort will sort from scratch.
+	/// </summary>
+	///
+	[LinkName("bgfx_topology_sorter_reset")]
+	public static extern void topology_sorter_reset(TopologySorter* _this);
+	
+	/// <summary>
+	/// Destroy topology sorter.
+	/// </summary>
+	///
+	/// <param name="_sorter">Topology sorter.</param>
+	///
+	[LinkName("bgfx_destroy_topology_sorter")]
+	public static extern void destroy_topology_sorter(TopologySorter* _sorter);
+	
 	/// <summary>
 	/// Set palette color value.
 	/// </summary>
@@ -3661,6 +3849,17 @@ public static class bgfx
 	[LinkName("bgfx_encoder_set_uniform")]
 	public static extern void encoder_set_uniform(Encoder* _this, UniformHandle _handle, void* _value, uint16 _num);
 	
+	/// <summary>
+	/// Set uniform block for draw primitive. Block values are applied before
+	/// uniforms set with `setUniform`, which override them. Draw calls
+	/// referencing blocks with identical content don't update uniforms again.
+	/// </summary>
+	///
+	/// <param name="_handle">Uniform block.</param>
+	///
+	[LinkName("bgfx_encoder_set_uniform_block")]
+	public static extern void encoder_set_uniform_block(Encoder* _this, UniformBlockHandle _handle);
+	
 	/// <summary>
 	/// Set index buffer for draw primitive.
 	/// </summary>
@@ -3879,6 +4078,38 @@ public static class bgfx
 	[LinkName("bgfx_encoder_submit_indirect")]
 	public static extern void encoder_submit_indirect(Encoder* _this, ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16 _start, uint16 _num, uint32 _depth, uint8 _flags);
 	
+	/// <summary>
+	/// Begin recording draw calls into bundle. While recording, `submit` calls
+	/// are captured into bundle instead of being submitted to view. Compute
+	/// dispatch, occlusion queries, and transient buffers can't be recorded.
+	/// </summary>
+	///
+	[LinkName("bgfx_encoder_begin_bundle")]
+	public static extern void encoder_begin_bundle(Encoder* _this);
+	
+	/// <summary>
+	/// End recording draw calls into bundle.
+	/// @remarks
+	///   Returns invalid handle if bundle couldn't be allocated. Resources
+	///   referenced by bundle must stay valid until bundle is destroyed.
+	/// </summary>
+	///
+	[LinkName("bgfx_encoder_end_bundle")]
+	public static extern BundleHandle encoder_end_bundle(Encoder* _this);
+	
+	/// <summary>
+	/// Submit bundle of recorded draw calls for rendering.
+	/// @remarks
+	///   Draw calls are sorted by mode of view they are submitted to, and
+	///   keep recording order in `ViewMode::Sequential` views.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Bundle handle.</param>
+	///
+	[LinkName("bgfx_encoder_submit_bundle")]
+	public static extern void encoder_submit_bundle(Encoder* _this, ViewId _id, BundleHandle _handle);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -4209,6 +4440,17 @@ public static class bgfx
 	[LinkName("bgfx_set_uniform")]
 	public static extern void set_uniform(UniformHandle _handle, void* _value, uint16 _num);
 	
+	/// <summary>
+	/// Set uniform block for draw primitive. Block values are applied before
+	/// uniforms set with `setUniform`, which override them. Draw calls
+	/// referencing blocks with identical content don't update uniforms again.
+	/// </summary>
+	///
+	/// <param name="_handle">Uniform block.</param>
+	///
+	[LinkName("bgfx_set_uniform_block")]
+	public static extern void set_uniform_block(UniformBlockHandle _handle);
+	
 	/// <summary>
 	/// Set index buffer for draw primitive.
 	/// </summary>
@@ -4435,6 +4677,38 @@ public static class bgfx
 	[LinkName("bgfx_submit_indirect")]
 	public static extern void submit_indirect(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16 _start, uint16 _num, uint32 _depth, uint8 _flags);
 	
+	/// <summary>
+	/// Begin recording draw calls into bundle. While recording, `submit` calls
+	/// are captured into bundle instead of being submitted to view. Compute
+	/// dispatch, occlusion queries, and transient buffers can't be recorded.
+	/// </summary>
+	///
+	[LinkName("bgfx_begin_bundle")]
+	public static extern void begin_bundle();
+	
+	/// <summary>
+	/// End recording draw calls into bundle.
+	/// @remarks
+	///   Returns invalid handle if bundle couldn't be allocated. Resources
+	///   referenced by bundle must stay valid until bundle is destroyed.
+	/// </summary>
+	///
+	[LinkName("bgfx_end_bundle")]
+	public static extern BundleHandle end_bundle();
+	
+	/// <summary>
+	/// Submit bundle of recorded draw calls for rendering.
+	/// @remarks
+	///   Draw calls are sorted by mode of view they are submitted to, and
+	///   keep recording order in `ViewMode::Sequential` views.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Bundle handle.</param>
+	///
+	[LinkName("bgfx_submit_bundle")]
+	public static extern void submit_bundle(ViewId _id, BundleHandle _handle);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
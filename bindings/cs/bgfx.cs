@@ -738,6 +738,16 @@ public static partial class bgfx
 		/// </summary>
 		ReadBack               = 0x0000800000000000,
 	
+		/// <summary>
+		/// Texture mips are streamed in after texture is created.
+		/// </summary>
+		Streaming              = 0x0001000000000000,
+	
+		/// <summary>
+		/// Texture can be sampled by handle index from shader.
+		/// </summary>
+		Bindless               = 0x0002000000000000,
+	
 		/// <summary>
 		/// Render target MSAAx2 mode.
 		/// </summary>
@@ -1095,56 +1105,61 @@ public static partial class bgfx
 		/// </summary>
 		Texture3d              = 0x0000000000020000,
 	
+		/// <summary>
+		/// Bindless textures are supported.
+		/// </summary>
+		TextureBindless        = 0x0000000000040000,
+	
 		/// <summary>
 		/// Texture blit is supported.
 		/// </summary>
-		TextureBlit            = 0x0000000000040000,
-		TextureCompareReserved = 0x0000000000080000,
+		TextureBlit            = 0x0000000000080000,
+		TextureCompareReserved = 0x0000000000100000,
 	
 		/// <summary>
 		/// Texture compare less equal mode is supported.
 		/// </summary>
-		TextureCompareLequal   = 0x0000000000100000,
+		TextureCompareLequal   = 0x0000000000200000,
 	
 		/// <summary>
 		/// Cubemap texture array is supported.
 		/// </summary>
-		TextureCubeArray       = 0x0000000000200000,
+		TextureCubeArray       = 0x0000000000400000,
 	
 		/// <summary>
 		/// CPU direct access to GPU texture memory.
 		/// </summary>
-		TextureDirectAccess    = 0x0000000000400000,
+		TextureDirectAccess    = 0x0000000000800000,
 	
 		/// <summary>
 		/// Read-back texture is supported.
 		/// </summary>
-		TextureReadBack        = 0x0000000000800000,
+		TextureReadBack        = 0x0000000001000000,
 	
 		/// <summary>
 		/// Vertex attribute half-float is supported.
 		/// </summary>
-		VertexAttribHalf       = 0x0000000001000000,
+		VertexAttribHalf       = 0x0000000002000000,
 	
 		/// <summary>
 		/// Vertex attribute 10_10_10_2 is supported.
 		/// </summary>
-		VertexAttribUint10     = 0x0000000002000000,
+		VertexAttribUint10     = 0x0000000004000000,
 	
 		/// <summary>
 		/// Rendering with VertexID only is supported.
 		/// </summary>
-		VertexId               = 0x0000000004000000,
+		VertexId               = 0x0000000008000000,
 	
 		/// <summary>
 		/// Viewport layer is available in vertex shader.
 		/// </summary>
-		ViewportLayerArray     = 0x0000000008000000,
+		ViewportLayerArray     = 0x0000000010000000,
 	
 		/// <summary>
 		/// All texture compare modes are supported.
 		/// </summary>
-		TextureCompareAll      = 0x0000000000180000,
+		TextureCompareAll      = 0x0000000000300000,
 	}
 	
 	[Flags]
@@ -2025,6 +2040,10 @@ public static partial class bgfx
 			public uint minResourceCbSize;
 			public uint transientVbSize;
 			public uint transientIbSize;
+			public uint maxDrawCalls;
+			public uint textureStreamSize;
+			public ushort numWorkerThreads;
+			public ushort renderItemBlock;
 		}
 	
 		public RendererType type;
@@ -2138,10 +2157,12 @@ public static partial class bgfx
 		public long gpuTimerFreq;
 		public long waitRender;
 		public long waitSubmit;
+		public long cpuTimeSort;
 		public uint numDraw;
 		public uint numCompute;
 		public uint numBlit;
 		public uint maxGpuLatency;
+		public uint numDropped;
 		public ushort numDynamicIndexBuffers;
 		public ushort numDynamicVertexBuffers;
 		public ushort numFrameBuffers;
@@ -2155,8 +2176,14 @@ public static partial class bgfx
 		public ushort numVertexLayouts;
 		public long textureMemoryUsed;
 		public long rtMemoryUsed;
+		public long textureStreamResident;
+		public long textureStreamPending;
 		public int transientVbUsed;
 		public int transientIbUsed;
+		public uint dynamicIbFree;
+		public uint dynamicIbLargestFree;
+		public uint dynamicVbFree;
+		public uint dynamicVbLargestFree;
 		public fixed uint numPrims[5];
 		public long gpuMemoryMax;
 		public long gpuMemoryUsed;
@@ -2182,6 +2209,15 @@ public static partial class bgfx
 	{
 	}
 	
+	public unsafe struct TopologySorter
+	{
+	}
+	
+	public struct BundleHandle {
+	    public ushort idx;
+	    public bool Valid => idx != UInt16.MaxValue;
+	}
+	
 	public struct DynamicIndexBufferHandle {
 	    public ushort idx;
 	    public bool Valid => idx != UInt16.MaxValue;
@@ -2227,6 +2263,11 @@ public static partial class bgfx
 	    public bool Valid => idx != UInt16.MaxValue;
 	}
 	
+	public struct UniformBlockHandle {
+	    public ushort idx;
+	    public bool Valid => idx != UInt16.MaxValue;
+	}
+	
 	public struct UniformHandle {
 	    public ushort idx;
 	    public bool Valid => idx != UInt16.MaxValue;
@@ -2369,6 +2410,22 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_weld_vertices", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe uint weld_vertices(void* _output, VertexLayout* _layout, void* _data, uint _num, bool _index32, float _epsilon);
 	
+	/// <summary>
+	/// Weld vertices, and copy unique vertices into compacted vertex stream.
+	/// </summary>
+	///
+	/// <param name="_output">Welded vertices remapping table into `_outVertices`. The size of buffer must be the same as number of vertices.</param>
+	/// <param name="_outVertices">Unique vertices in order of first appearance. The size of buffer must be large enough for all vertices in vertex stream. It can be the same as `_data`.</param>
+	/// <param name="_layout">Vertex stream layout.</param>
+	/// <param name="_data">Vertex stream.</param>
+	/// <param name="_num">Number of vertices in vertex stream.</param>
+	/// <param name="_index32">Set to `true` if input indices are 32-bit.</param>
+	/// <param name="_epsilon">Error tolerance for vertex position comparison.</param>
+	/// <param name="_attributes">Set to `true` to weld only vertices with normal and first texture coordinate within error tolerance too.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_weld_vertices_compact", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe uint weld_vertices_compact(void* _output, void* _outVertices, VertexLayout* _layout, void* _data, uint _num, bool _index32, float _epsilon, bool _attributes);
+	
 	/// <summary>
 	/// Convert index buffer for use with different primitive topologies.
 	/// </summary>
@@ -2491,6 +2548,20 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_get_stats", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe Stats* get_stats();
 	
+	/// <summary>
+	/// Release GPU memory blocks held by renderer's memory allocators that
+	/// have no live allocations.
+	/// @remarks
+	///   Partially used blocks are not compacted and live resources are not
+	///   moved. Memory of destroyed resources returns to allocator once GPU is
+	///   done with them, which is a few frames after destroy. Renderers without
+	///   their own memory allocator (everything except Vulkan) ignore it. It's
+	///   executed on render thread at next `bgfx::frame`.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_defragment", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void defragment();
+	
 	/// <summary>
 	/// Allocate buffer to pass to bgfx calls. Data will be freed inside bgfx.
 	/// </summary>
@@ -2937,6 +3008,32 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_destroy_program", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void destroy_program(ProgramHandle _handle);
 	
+	/// <summary>
+	/// Compile pipeline state object for program, state and vertex layout combination
+	/// ahead of first use.
+	/// @remarks
+	///   Only renderers that compile pipeline state objects on first use (Vulkan) do
+	///   work here, it's no-op on other renderers.
+	/// </summary>
+	///
+	/// <param name="_program">Program handle.</param>
+	/// <param name="_state">State flags. See: `BGFX_STATE_*`.</param>
+	/// <param name="_layoutHandle">Vertex layout handle.</param>
+	/// <param name="_frameBuffer">Frame buffer whose render target formats pipeline is compiled for. Invalid handle means back buffer.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_prewarm_pipeline", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void prewarm_pipeline(ProgramHandle _program, ulong _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer);
+	
+	/// <summary>
+	/// Write merged pipeline cache blob with `CallbackI::cacheWrite`.
+	/// @remarks
+	///   Pipeline cache is written at shutdown too. Only renderers that keep pipeline
+	///   cache (Vulkan, Direct3D 12) do work here.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_flush_pipeline_cache", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void flush_pipeline_cache();
+	
 	/// <summary>
 	/// Validate texture parameters.
 	/// </summary>
@@ -3291,6 +3388,40 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_destroy_uniform", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void destroy_uniform(UniformHandle _handle);
 	
+	/// <summary>
+	/// Create uniform block.
+	///
+	/// @remarks
+	///   Uniform block holds values of multiple uniforms. Block is written once
+	///   with `bgfx::updateUniformBlock` and referenced by draw calls with
+	///   `bgfx::setUniformBlock`. Values persist across frames until updated.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_create_uniform_block", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe UniformBlockHandle create_uniform_block();
+	
+	/// <summary>
+	/// Update uniform value stored in uniform block. Changes are visible to all
+	/// draw calls referencing block starting with next `bgfx::frame` call.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to uniform block object.</param>
+	/// <param name="_uniform">Uniform.</param>
+	/// <param name="_value">Pointer to uniform data.</param>
+	/// <param name="_num">Number of elements. Passing `UINT16_MAX` will use the _num passed on uniform creation.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_update_uniform_block", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void update_uniform_block(UniformBlockHandle _handle, UniformHandle _uniform, void* _value, ushort _num);
+	
+	/// <summary>
+	/// Destroy uniform block.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to uniform block object.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_destroy_uniform_block", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void destroy_uniform_block(UniformBlockHandle _handle);
+	
 	/// <summary>
 	/// Create occlusion query.
 	/// </summary>
@@ -3317,6 +3448,60 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_destroy_occlusion_query", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void destroy_occlusion_query(OcclusionQueryHandle _handle);
 	
+	/// <summary>
+	/// Destroy bundle.
+	/// </summary>
+	///
+	/// <param name="_handle">Handle to bundle object.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_destroy_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void destroy_bundle(BundleHandle _handle);
+	
+	/// <summary>
+	/// Create topology sorter. Sorter can be created and used before `bgfx::init` and after
+	/// `bgfx::shutdown`.
+	/// </summary>
+	///
+	/// <param name="_allocator">Allocator used for sorter and its scratch memory. When NULL, default allocator is used. Allocator passed to `bgfx::init` is not used, since sorter can outlive it.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_create_topology_sorter", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe TopologySorter* create_topology_sorter(IntPtr _allocator);
+	
+	/// <summary>
+	/// Sort indices. Sort keys of meshes with more than 100K triangles are calculated on
+	/// worker threads shared with other vertex and index utility functions.
+	/// </summary>
+	///
+	/// <param name="_sort">Sort order, see `TopologySort::Enum`.</param>
+	/// <param name="_dst">Destination index buffer.</param>
+	/// <param name="_dstSize">Destination index buffer in bytes. It must be large enough to contain output indices. If destination size is insufficient index buffer will be truncated.</param>
+	/// <param name="_dir">Direction (vector must be normalized).</param>
+	/// <param name="_pos">Position.</param>
+	/// <param name="_vertices">Pointer to first vertex represented as float x, y, z. Must contain at least number of vertices referencende by index buffer.</param>
+	/// <param name="_stride">Vertex stride.</param>
+	/// <param name="_indices">Source indices.</param>
+	/// <param name="_numIndices">Number of input indices.</param>
+	/// <param name="_index32">Set to `true` if input indices are 32-bit.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_topology_sorter_sort_tri_list", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void topology_sorter_sort_tri_list(TopologySorter* _this, TopologySort _sort, void* _dst, uint _dstSize, float _dir, float _pos, void* _vertices, uint _stride, void* _indices, uint _numIndices, bool _index32);
+	
+	/// <summary>
+	/// Forget previous order, next sort will sort from scratch.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_topology_sorter_reset", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void topology_sorter_reset(TopologySorter* _this);
+	
+	/// <summary>
+	/// Destroy topology sorter.
+	/// </summary>
+	///
+	/// <param name="_sorter">Topology sorter.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_destroy_topology_sorter", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void destroy_topology_sorter(TopologySorter* _sorter);
+	
 	/// <summary>
 	/// Set palette color value.
 	/// </summary>
@@ -3618,6 +3803,17 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_encoder_set_uniform", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void encoder_set_uniform(Encoder* _this, UniformHandle _handle, void* _value, ushort _num);
 	
+	/// <summary>
+	/// Set uniform block for draw primitive. Block values are applied before
+	/// uniforms set with `setUniform`, which override them. Draw calls
+	/// referencing blocks with identical content don't update uniforms again.
+	/// </summary>
+	///
+	/// <param name="_handle">Uniform block.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_set_uniform_block", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_set_uniform_block(Encoder* _this, UniformBlockHandle _handle);
+	
 	/// <summary>
 	/// Set index buffer for draw primitive.
 	/// </summary>
@@ -3836,6 +4032,38 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_indirect", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void encoder_submit_indirect(Encoder* _this, ushort _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, ushort _start, ushort _num, uint _depth, byte _flags);
 	
+	/// <summary>
+	/// Begin recording draw calls into bundle. While recording, `submit` calls
+	/// are captured into bundle instead of being submitted to view. Compute
+	/// dispatch, occlusion queries, and transient buffers can't be recorded.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_begin_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_begin_bundle(Encoder* _this);
+	
+	/// <summary>
+	/// End recording draw calls into bundle.
+	/// @remarks
+	///   Returns invalid handle if bundle couldn't be allocated. Resources
+	///   referenced by bundle must stay valid until bundle is destroyed.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_end_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe BundleHandle encoder_end_bundle(Encoder* _this);
+	
+	/// <summary>
+	/// Submit bundle of recorded draw calls for rendering.
+	/// @remarks
+	///   Draw calls are sorted by mode of view they are submitted to, and
+	///   keep recording order in `ViewMode::Sequential` views.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Bundle handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_encoder_submit_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void encoder_submit_bundle(Encoder* _this, ushort _id, BundleHandle _handle);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
@@ -4166,6 +4394,17 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_set_uniform", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void set_uniform(UniformHandle _handle, void* _value, ushort _num);
 	
+	/// <summary>
+	/// Set uniform block for draw primitive. Block values are applied before
+	/// uniforms set with `setUniform`, which override them. Draw calls
+	/// referencing blocks with identical content don't update uniforms again.
+	/// </summary>
+	///
+	/// <param name="_handle">Uniform block.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_set_uniform_block", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void set_uniform_block(UniformBlockHandle _handle);
+	
 	/// <summary>
 	/// Set index buffer for draw primitive.
 	/// </summary>
@@ -4392,6 +4631,38 @@ public static partial class bgfx
 	[DllImport(DllName, EntryPoint="bgfx_submit_indirect", CallingConvention = CallingConvention.Cdecl)]
 	public static extern unsafe void submit_indirect(ushort _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, ushort _start, ushort _num, uint _depth, byte _flags);
 	
+	/// <summary>
+	/// Begin recording draw calls into bundle. While recording, `submit` calls
+	/// are captured into bundle instead of being submitted to view. Compute
+	/// dispatch, occlusion queries, and transient buffers can't be recorded.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_begin_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void begin_bundle();
+	
+	/// <summary>
+	/// End recording draw calls into bundle.
+	/// @remarks
+	///   Returns invalid handle if bundle couldn't be allocated. Resources
+	///   referenced by bundle must stay valid until bundle is destroyed.
+	/// </summary>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_end_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe BundleHandle end_bundle();
+	
+	/// <summary>
+	/// Submit bundle of recorded draw calls for rendering.
+	/// @remarks
+	///   Draw calls are sorted by mode of view they are submitted to, and
+	///   keep recording order in `ViewMode::Sequential` views.
+	/// </summary>
+	///
+	/// <param name="_id">View id.</param>
+	/// <param name="_handle">Bundle handle.</param>
+	///
+	[DllImport(DllName, EntryPoint="bgfx_submit_bundle", CallingConvention = CallingConvention.Cdecl)]
+	public static extern unsafe void submit_bundle(ushort _id, BundleHandle _handle);
+	
 	/// <summary>
 	/// Set compute index buffer.
 	/// </summary>
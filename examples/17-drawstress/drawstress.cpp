@@ -6,6 +6,8 @@
 #include "common.h"
 #include "bgfx_utils.h"
 
+#include <bx/commandline.h>
+#include <bx/string.h>
 #include <bx/uint32_t.h>
 #include <bx/thread.h>
 #include <bx/os.h>
@@ -95,6 +97,23 @@ static const int64_t highwm = 1000000/65;
 static const int64_t lowwm  = 1000000/57;
 #endif // BX_PLATFORM_EMSCRIPTEN
 
+static const uint32_t kMaxThreads = 8;
+
+// Number of encoder threads used by each benchmark pass.
+static const uint32_t s_benchNumThreads[] = { 1, 4, 8 };
+
+static const uint32_t kBenchWarmupFrames = 60;
+static const uint32_t kBenchFrames       = 240;
+
+struct BenchResult
+{
+	uint32_t numThreads;
+	double   frameMs;
+	double   submitMs;
+	double   sortMs;
+	double   renderMs;
+};
+
 int32_t threadFunc(bx::Thread* _thread, void* _userData);
 
 class ExampleDrawStress : public entry::AppI
@@ -126,12 +145,50 @@ public:
 		m_deltaTimeAvgNs = 0;
 		m_numFrames      = 0;
 
+		m_benchPass     = -1;
+		m_benchFrame    = 0;
+		m_benchFrameNs  = 0;
+		m_benchSortNs   = 0;
+		m_benchSubmitNs = 0;
+		m_benchRenderNs = 0;
+		m_numResults    = 0;
+
+		m_numBatches      = 1;
+		m_maxSubmitTimeNs = 0;
+		bx::memSet(m_submitTimeNs, 0, sizeof(m_submitTimeNs) );
+
 		bgfx::Init init;
 		init.type     = args.m_type;
 		init.vendorId = args.m_pciId;
 		init.resolution.width  = m_width;
 		init.resolution.height = m_height;
 		init.resolution.reset  = m_reset;
+
+		// One encoder for API thread, and one for each submit thread.
+		init.limits.maxEncoders = uint16_t(kMaxThreads+1);
+
+		// Render thread sorts and submits on worker threads, `--workers 0` to disable.
+		bx::CommandLine cmdLine(_argc, _argv);
+		int32_t numWorkerThreads = init.limits.numWorkerThreads;
+		const char* workers = cmdLine.findOption("workers");
+		if (NULL != workers)
+		{
+			bx::fromString(&numWorkerThreads, workers);
+		}
+		init.limits.numWorkerThreads = uint16_t(bx::clamp(numWorkerThreads, 0, 16) );
+		m_numWorkerThreads = init.limits.numWorkerThreads;
+
+		// Encoders claim render items in blocks of this size, `--item-block 0` to claim
+		// them one at a time.
+		int32_t renderItemBlock = init.limits.renderItemBlock;
+		const char* itemBlock = cmdLine.findOption("item-block");
+		if (NULL != itemBlock)
+		{
+			bx::fromString(&renderItemBlock, itemBlock);
+		}
+		init.limits.renderItemBlock = uint16_t(bx::clamp(renderItemBlock, 0, 4095) );
+		m_renderItemBlock = init.limits.renderItemBlock;
+
 		bgfx::init(init);
 
 		const bgfx::Caps* caps = bgfx::getCaps();
@@ -231,33 +288,41 @@ public:
 
 	void submit(uint32_t _tid, uint32_t _xstart, uint32_t _num)
 	{
-		bgfx::Encoder* encoder = bgfx::begin();
-		if (0 != _tid)
-		{
-			m_sync.post();
-		}
+		const int64_t submitBegin = bx::getHPCounter();
 
-		if (NULL != encoder)
-		{
-			const int64_t now = bx::getHPCounter();
-			const double freq = double(bx::getHPFrequency() );
-			float time = (float)( (now-m_timeOffset)/freq);
+		const int64_t now = submitBegin;
+		const double freq = double(bx::getHPFrequency() );
+		float time = (float)( (now-m_timeOffset)/freq);
+
+		const float* mod = s_mod[_tid%BX_COUNTOF(s_mod)];
 
-			const float* mod = s_mod[_tid%BX_COUNTOF(s_mod)];
+		float mtxS[16];
+		const float scale = 0 == m_transform ? 0.25f : 0.0f;
+		bx::mtxScale(mtxS, scale, scale, scale);
 
-			float mtxS[16];
-			const float scale = 0 == m_transform ? 0.25f : 0.0f;
-			bx::mtxScale(mtxS, scale, scale, scale);
+		const float step = 0.6f;
+		float pos[3];
+		pos[0] = -step*m_dim / 2.0f;
+		pos[1] = -step*m_dim / 2.0f;
+		pos[2] = -15.0;
 
-			const float step = 0.6f;
-			float pos[3];
-			pos[0] = -step*m_dim / 2.0f;
-			pos[1] = -step*m_dim / 2.0f;
-			pos[2] = -15.0;
+		// Each batch begins and ends encoder, this stresses how encoders hand over
+		// their render items to frame.
+		const uint32_t dim        = uint32_t(m_dim);
+		const uint32_t numBatches = bx::min<uint32_t>(m_numBatches, dim);
+
+		for (uint32_t batch = 0; batch < numBatches; ++batch)
+		{
+			bgfx::Encoder* encoder = bgfx::begin();
+
+			if (NULL == encoder)
+			{
+				break;
+			}
 
-			for (uint32_t zz = 0; zz < uint32_t(m_dim); ++zz)
+			for (uint32_t zz = batch*dim/numBatches, zend = (batch+1)*dim/numBatches; zz < zend; ++zz)
 			{
-				for (uint32_t yy = 0; yy < uint32_t(m_dim); ++yy)
+				for (uint32_t yy = 0; yy < dim; ++yy)
 				{
 					for (uint32_t xx = _xstart, xend = _xstart+_num; xx < xend; ++xx)
 					{
@@ -286,6 +351,15 @@ public:
 
 			bgfx::end(encoder);
 		}
+
+		m_submitTimeNs[_tid] = (bx::getHPCounter() - submitBegin)*1000000000/bx::getHPFrequency();
+
+		// Signal only after last batch ended, otherwise later batches could end up in
+		// next frame.
+		if (0 != _tid)
+		{
+			m_sync.post();
+		}
 	}
 
 	bool update() override
@@ -358,7 +432,12 @@ public:
 			ImGui::Checkbox("Auto adjust", &m_autoAdjust);
 
 			ImGui::SliderInt("Num threads", &m_numThreads, 1, m_maxThreads);
-			const uint32_t numThreads = m_numThreads;
+			const uint32_t numThreads = 0 > m_benchPass
+				? uint32_t(m_numThreads)
+				: bx::min<uint32_t>(s_benchNumThreads[m_benchPass], m_maxThreads)
+				;
+
+			ImGui::SliderInt("Encoder begin/end", &m_numBatches, 1, 64);
 
 			ImGui::SliderInt("Dim", &m_dim, 5, m_maxDim);
 			ImGui::Text("Draw calls: %d", m_dim*m_dim*m_dim);
@@ -368,9 +447,51 @@ public:
 			const bgfx::Stats* stats = bgfx::getStats();
 			ImGui::Text("GPU %0.6f [ms]", double(stats->gpuTimeEnd - stats->gpuTimeBegin)*1000.0/stats->gpuTimerFreq);
 			ImGui::Text("CPU %0.6f [ms]", double(stats->cpuTimeEnd - stats->cpuTimeBegin)*1000.0/stats->cpuTimerFreq);
+			ImGui::Text("Submit %0.6f [ms]", double(m_maxSubmitTimeNs)/1000000.0);
+			ImGui::Text("Sort %0.6f [ms]", double(stats->cpuTimeSort)*1000.0/stats->cpuTimerFreq);
 			ImGui::Text("Waiting for render thread %0.6f [ms]", double(stats->waitRender) * toMs);
 			ImGui::Text("Waiting for submit thread %0.6f [ms]", double(stats->waitSubmit) * toMs);
 
+			ImGui::Separator();
+			ImGui::Text("Worker threads: %d", m_numWorkerThreads);
+			ImGui::Text("Render item block: %d", m_renderItemBlock);
+
+			if (0 > m_benchPass)
+			{
+				if (ImGui::Button("Benchmark") )
+				{
+					m_autoAdjust    = false;
+					m_benchPass     = 0;
+					m_benchFrame    = 0;
+					m_benchFrameNs  = 0;
+					m_benchSortNs   = 0;
+					m_benchSubmitNs = 0;
+					m_benchRenderNs = 0;
+					m_numResults    = 0;
+				}
+			}
+			else
+			{
+				ImGui::Text("Benchmark %d/%d..."
+					, m_benchPass+1
+					, int32_t(BX_COUNTOF(s_benchNumThreads) )
+					);
+
+				updateBenchmark(stats, frameTime*1000000/hpFreq);
+			}
+
+			for (uint32_t ii = 0; ii < m_numResults; ++ii)
+			{
+				const BenchResult& result = m_result[ii];
+				ImGui::Text("%d thread(s): frame %0.3f, submit %0.3f, sort %0.3f, render %0.3f [ms]"
+					, result.numThreads
+					, result.frameMs
+					, result.submitMs
+					, result.sortMs
+					, result.renderMs
+					);
+			}
+
 			ImGui::End();
 
 			imguiEndFrame();
@@ -395,6 +516,8 @@ public:
 			// if no other draw calls are submitted to view 0.
 			bgfx::touch(0);
 
+			bx::memSet(m_submitTimeNs, 0, sizeof(m_submitTimeNs) );
+
 			if (1 < numThreads)
 			{
 				for (uint32_t ii = 0; ii < numThreads; ++ii)
@@ -412,6 +535,12 @@ public:
 				submit(0, 0, uint32_t(m_dim) );
 			}
 
+			m_maxSubmitTimeNs = 0;
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_submitTimeNs); ++ii)
+			{
+				m_maxSubmitTimeNs = bx::max(m_maxSubmitTimeNs, m_submitTimeNs[ii]);
+			}
+
 			// Advance to next frame. Rendering thread will be kicked to
 			// process submitted rendering primitives.
 			bgfx::frame();
@@ -422,6 +551,53 @@ public:
 		return false;
 	}
 
+	void updateBenchmark(const bgfx::Stats* _stats, int64_t _frameTimeNs)
+	{
+		++m_benchFrame;
+
+		if (kBenchWarmupFrames < m_benchFrame)
+		{
+			m_benchFrameNs  += _frameTimeNs;
+			m_benchSortNs   += _stats->cpuTimeSort*1000000000/_stats->cpuTimerFreq;
+			m_benchSubmitNs += m_maxSubmitTimeNs;
+			m_benchRenderNs += (_stats->cpuTimeEnd - _stats->cpuTimeBegin)*1000000000/_stats->cpuTimerFreq;
+		}
+
+		if (kBenchWarmupFrames+kBenchFrames == m_benchFrame)
+		{
+			BenchResult& result = m_result[m_numResults++];
+			result.numThreads = bx::min<uint32_t>(s_benchNumThreads[m_benchPass], m_maxThreads);
+			result.frameMs    = double(m_benchFrameNs )/double(kBenchFrames)/1000000.0;
+			result.submitMs   = double(m_benchSubmitNs)/double(kBenchFrames)/1000000.0;
+			result.sortMs     = double(m_benchSortNs  )/double(kBenchFrames)/1000000.0;
+			result.renderMs   = double(m_benchRenderNs)/double(kBenchFrames)/1000000.0;
+
+			DBG("Draw calls %d, worker threads %d, render item block %d, encoder threads %d, encoder begin/end %d: frame %0.3f, submit %0.3f, sort %0.3f, render %0.3f [ms]"
+				, m_dim*m_dim*m_dim
+				, m_numWorkerThreads
+				, m_renderItemBlock
+				, result.numThreads
+				, m_numBatches
+				, result.frameMs
+				, result.submitMs
+				, result.sortMs
+				, result.renderMs
+				);
+
+			m_benchFrame    = 0;
+			m_benchFrameNs  = 0;
+			m_benchSortNs   = 0;
+			m_benchSubmitNs = 0;
+			m_benchRenderNs = 0;
+
+			++m_benchPass;
+			if (int32_t(BX_COUNTOF(s_benchNumThreads) ) == m_benchPass)
+			{
+				m_benchPass = -1;
+			}
+		}
+	}
+
 	entry::MouseState m_mouseState;
 
 	uint32_t m_width;
@@ -436,6 +612,8 @@ public:
 	int32_t  m_transform;
 	int32_t  m_numThreads;
 	int32_t  m_maxThreads;
+	int32_t  m_numWorkerThreads;
+	int32_t  m_renderItemBlock;
 
 	int64_t  m_timeOffset;
 
@@ -443,7 +621,21 @@ public:
 	int64_t  m_deltaTimeAvgNs;
 	int64_t  m_numFrames;
 
-	bx::Thread m_thread[5];
+	int32_t  m_benchPass;
+	uint32_t m_benchFrame;
+	int64_t  m_benchFrameNs;
+	int64_t  m_benchSortNs;
+	int64_t  m_benchSubmitNs;
+	int64_t  m_benchRenderNs;
+
+	int32_t  m_numBatches;
+	int64_t  m_submitTimeNs[kMaxThreads+1];
+	int64_t  m_maxSubmitTimeNs;
+
+	BenchResult m_result[BX_COUNTOF(s_benchNumThreads)];
+	uint32_t    m_numResults;
+
+	bx::Thread m_thread[kMaxThreads];
 	bx::Semaphore m_sync;
 
 	bgfx::ProgramHandle m_program;
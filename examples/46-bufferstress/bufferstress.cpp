@@ -0,0 +1,552 @@
+/*
+ * Copyright 2011-2021 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "bgfx_utils.h"
+#include "imgui/imgui.h"
+
+#include <bx/rng.h>
+
+namespace
+{
+
+// Number of dynamic vertex buffers alive at any time.
+const uint32_t kMaxBuffers = 2048;
+
+const uint32_t kDimWidth  = 11;
+const uint32_t kDimHeight = 11;
+
+const uint32_t kMinVertices = 8;
+const uint32_t kMaxVertices = 2048;
+
+// Static buffers are created and destroyed as vertex and index buffer pairs, in cycles of
+// batches that fit into default BGFX_CONFIG_MAX_VERTEX_BUFFERS and BGFX_CONFIG_MAX_INDEX_BUFFERS
+// while previous batch handles are still being released.
+const uint32_t kStaticBatch = 1024;
+const uint32_t kStaticTotal = 100000;
+
+const uint32_t kBenchFrames = 600;
+const uint32_t kBenchChurn  = 256;
+const uint32_t kBenchSeed   = 1337;
+
+struct PosColorVertex
+{
+	float m_x;
+	float m_y;
+	float m_z;
+	uint32_t m_abgr;
+
+	static void init()
+	{
+		ms_layout
+			.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
+			.end();
+	};
+
+	static bgfx::VertexLayout ms_layout;
+};
+
+bgfx::VertexLayout PosColorVertex::ms_layout;
+
+static PosColorVertex s_cubeVertices[] =
+{
+	{-1.0f,  1.0f,  1.0f, 0xff000000 },
+	{ 1.0f,  1.0f,  1.0f, 0xff0000ff },
+	{-1.0f, -1.0f,  1.0f, 0xff00ff00 },
+	{ 1.0f, -1.0f,  1.0f, 0xff00ffff },
+	{-1.0f,  1.0f, -1.0f, 0xffff0000 },
+	{ 1.0f,  1.0f, -1.0f, 0xffff00ff },
+	{-1.0f, -1.0f, -1.0f, 0xffffff00 },
+	{ 1.0f, -1.0f, -1.0f, 0xffffffff },
+};
+
+static const uint16_t s_cubeTriStrip[] =
+{
+	0, 1, 2,
+	3,
+	7,
+	1,
+	5,
+	0,
+	4,
+	2,
+	6,
+	7,
+	4,
+	5,
+};
+
+class ExampleBufferStress : public entry::AppI
+{
+public:
+	ExampleBufferStress(const char* _name, const char* _description, const char* _url)
+		: entry::AppI(_name, _description, _url)
+	{
+	}
+
+	void init(int32_t _argc, const char* const* _argv, uint32_t _width, uint32_t _height) override
+	{
+		Args args(_argc, _argv);
+
+		m_width  = _width;
+		m_height = _height;
+		m_debug  = BGFX_DEBUG_NONE;
+		m_reset  = BGFX_RESET_NONE;
+
+		bgfx::Init init;
+		init.type     = args.m_type;
+		init.vendorId = args.m_pciId;
+		init.resolution.width  = m_width;
+		init.resolution.height = m_height;
+		init.resolution.reset  = m_reset;
+		bgfx::init(init);
+
+		// Enable debug text.
+		bgfx::setDebug(m_debug);
+
+		// Set view 0 clear state.
+		bgfx::setViewClear(0
+			, BGFX_CLEAR_COLOR|BGFX_CLEAR_DEPTH
+			, 0x303030ff
+			, 1.0f
+			, 0
+			);
+
+		// Create vertex stream declaration.
+		PosColorVertex::init();
+
+		m_churn = 256;
+
+		m_benchFrame         = 0;
+		m_benchChurnNs       = 0;
+		m_benchFrameNs       = 0;
+		m_benchNumOps        = 0;
+		m_benchFragmentation = 0.0;
+		m_benchDone          = false;
+
+		m_churnNs = 0;
+		m_frameNs = 0;
+
+		m_numStatic       = 0;
+		m_staticCycled    = 0;
+		m_staticCycling   = false;
+		m_staticCreateNs  = 0;
+		m_staticDestroyNs = 0;
+
+		for (uint32_t ii = 0; ii < kMaxBuffers; ++ii)
+		{
+			m_vbh[ii] = createBuffer();
+		}
+
+		// Create static index buffer.
+		m_ibh = bgfx::createIndexBuffer(bgfx::makeRef(s_cubeTriStrip, sizeof(s_cubeTriStrip) ) );
+
+		// Create program from shaders.
+		m_program = loadProgram("vs_cubes", "fs_cubes");
+
+		m_timeOffset = bx::getHPCounter();
+
+		imguiCreate();
+	}
+
+	virtual int shutdown() override
+	{
+		imguiDestroy();
+
+		// Cleanup.
+		bgfx::destroy(m_ibh);
+
+		for (uint32_t ii = 0; ii < kMaxBuffers; ++ii)
+		{
+			if (bgfx::isValid(m_vbh[ii]) )
+			{
+				bgfx::destroy(m_vbh[ii]);
+			}
+		}
+
+		destroyStatic();
+
+		bgfx::destroy(m_program);
+
+		// Shutdown bgfx.
+		bgfx::shutdown();
+
+		return 0;
+	}
+
+	const bgfx::Memory* allocVertices()
+	{
+		const uint32_t numVertices = kMinVertices + m_mwc.gen() % (kMaxVertices - kMinVertices + 1);
+
+		const bgfx::Memory* mem = bgfx::alloc(numVertices*sizeof(PosColorVertex) );
+		PosColorVertex* vertex = (PosColorVertex*)mem->data;
+
+		for (uint32_t ii = 0; ii < numVertices; ++ii)
+		{
+			vertex[ii] = s_cubeVertices[ii%BX_COUNTOF(s_cubeVertices)];
+		}
+
+		return mem;
+	}
+
+	bgfx::DynamicVertexBufferHandle createBuffer()
+	{
+		return bgfx::createDynamicVertexBuffer(allocVertices(), PosColorVertex::ms_layout);
+	}
+
+	// Creates batch of static vertex and index buffer pairs, until there is kStaticBatch
+	// pairs, or handles run out.
+	void createStatic()
+	{
+		const int64_t begin = bx::getHPCounter();
+
+		for (; m_numStatic < kStaticBatch; ++m_numStatic)
+		{
+			const bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(
+				  bgfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) )
+				, PosColorVertex::ms_layout
+				);
+
+			if (!bgfx::isValid(vbh) )
+			{
+				break;
+			}
+
+			const bgfx::IndexBufferHandle ibh = bgfx::createIndexBuffer(
+				bgfx::makeRef(s_cubeTriStrip, sizeof(s_cubeTriStrip) )
+				);
+
+			if (!bgfx::isValid(ibh) )
+			{
+				bgfx::destroy(vbh);
+				break;
+			}
+
+			m_staticVbh[m_numStatic] = vbh;
+			m_staticIbh[m_numStatic] = ibh;
+		}
+
+		m_staticCycled   += m_numStatic*2;
+		m_staticCreateNs += (bx::getHPCounter() - begin)*1000000000/bx::getHPFrequency();
+	}
+
+	void destroyStatic()
+	{
+		const int64_t begin = bx::getHPCounter();
+
+		for (uint32_t ii = 0; ii < m_numStatic; ++ii)
+		{
+			bgfx::destroy(m_staticVbh[ii]);
+			bgfx::destroy(m_staticIbh[ii]);
+		}
+
+		m_numStatic = 0;
+
+		m_staticDestroyNs += (bx::getHPCounter() - begin)*1000000000/bx::getHPFrequency();
+	}
+
+	// Each frame destroys batch created in previous frame and creates new one, until
+	// kStaticTotal buffers went through create/destroy cycle.
+	void cycleStatic()
+	{
+		destroyStatic();
+
+		if (m_staticCycled < kStaticTotal)
+		{
+			createStatic();
+
+			if (0 == m_numStatic)
+			{
+				// Out of handles, nothing more can be cycled.
+				m_staticCycling = false;
+			}
+		}
+		else
+		{
+			m_staticCycling = false;
+
+			DBG("Static %d buffers: create %0.3f, destroy %0.3f [us/buffer]"
+				, m_staticCycled
+				, double(m_staticCreateNs )/1000.0/double(m_staticCycled)
+				, double(m_staticDestroyNs)/1000.0/double(m_staticCycled)
+				);
+		}
+	}
+
+	// Replaces random buffers with new ones of random size, and returns time spent in
+	// bgfx create and destroy calls.
+	int64_t churn(uint32_t _num)
+	{
+		int64_t elapsed = 0;
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const uint32_t idx = m_mwc.gen() % kMaxBuffers;
+			const bgfx::Memory* mem = allocVertices();
+
+			const int64_t begin = bx::getHPCounter();
+
+			if (bgfx::isValid(m_vbh[idx]) )
+			{
+				bgfx::destroy(m_vbh[idx]);
+			}
+
+			m_vbh[idx] = bgfx::createDynamicVertexBuffer(mem, PosColorVertex::ms_layout);
+
+			elapsed += bx::getHPCounter() - begin;
+		}
+
+		return elapsed;
+	}
+
+	bool update() override
+	{
+		if (!entry::processEvents(m_width, m_height, m_debug, m_reset, &m_mouseState) )
+		{
+			imguiBeginFrame(m_mouseState.m_mx
+				,  m_mouseState.m_my
+				, (m_mouseState.m_buttons[entry::MouseButton::Left  ] ? IMGUI_MBUT_LEFT   : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Right ] ? IMGUI_MBUT_RIGHT  : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Middle] ? IMGUI_MBUT_MIDDLE : 0)
+				,  m_mouseState.m_mz
+				, uint16_t(m_width)
+				, uint16_t(m_height)
+				);
+
+			showExampleDialog(this);
+
+			ImGui::SetNextWindowPos(
+				  ImVec2(m_width - m_width / 4.0f - 10.0f, 10.0f)
+				, ImGuiCond_FirstUseEver
+				);
+			ImGui::SetNextWindowSize(
+				  ImVec2(m_width / 4.0f, m_height / 2.0f)
+				, ImGuiCond_FirstUseEver
+				);
+			ImGui::Begin("Settings"
+				, NULL
+				, 0
+				);
+
+			const bgfx::Stats* stats = bgfx::getStats();
+
+			ImGui::SliderInt("Churn per frame", &m_churn, 0, 1024);
+			ImGui::Text("Create/destroy %0.3f [us/op]", double(m_churnNs)/1000.0/bx::max(1, m_churn) );
+			ImGui::Text("Frame %0.3f [ms]", double(m_frameNs)/1000000.0);
+
+			ImGui::Separator();
+
+			const double fragmentation = 0 == stats->dynamicVbFree
+				? 0.0
+				: 100.0 - 100.0*double(stats->dynamicVbLargestFree)/double(stats->dynamicVbFree)
+				;
+			ImGui::Text("Dynamic VB free %d [KiB]", stats->dynamicVbFree/1024);
+			ImGui::Text("Largest free block %d [KiB]", stats->dynamicVbLargestFree/1024);
+			ImGui::Text("Fragmentation %0.1f%%", fragmentation);
+			ImGui::Text("Vertex buffers %d", stats->numVertexBuffers);
+
+			ImGui::Separator();
+
+			ImGui::Text("Static buffers %d / %d", m_staticCycled, kStaticTotal);
+
+			if (!m_staticCycling)
+			{
+				if (ImGui::Button("Cycle 100K") )
+				{
+					m_staticCycled    = 0;
+					m_staticCreateNs  = 0;
+					m_staticDestroyNs = 0;
+					m_staticCycling   = true;
+				}
+			}
+			else
+			{
+				ImGui::Text("Cycling...");
+			}
+
+			ImGui::SameLine();
+			if (ImGui::Button("Defragment") )
+			{
+				bgfx::defragment();
+			}
+
+			ImGui::Text("Create %0.3f, destroy %0.3f [us/buffer]"
+				, double(m_staticCreateNs )/1000.0/double(bx::max<uint32_t>(1, m_staticCycled) )
+				, double(m_staticDestroyNs)/1000.0/double(bx::max<uint32_t>(1, m_staticCycled) )
+				);
+			ImGui::Text("GPU memory %0.1f / %0.1f [MiB]"
+				, double(stats->gpuMemoryUsed)/(1024.0*1024.0)
+				, double(stats->gpuMemoryMax )/(1024.0*1024.0)
+				);
+
+			ImGui::Separator();
+
+			if (0 == m_benchFrame)
+			{
+				if (ImGui::Button("Benchmark") )
+				{
+					m_mwc.reset(kBenchSeed);
+					m_benchFrame   = kBenchFrames;
+					m_benchChurnNs = 0;
+					m_benchFrameNs = 0;
+					m_benchNumOps  = 0;
+					m_benchDone    = false;
+				}
+			}
+			else
+			{
+				ImGui::Text("Benchmark %d frames left...", m_benchFrame);
+			}
+
+			if (m_benchDone)
+			{
+				ImGui::Text("Create/destroy %0.3f [us/op]", double(m_benchChurnNs)/1000.0/double(bx::max<int64_t>(1, m_benchNumOps) ) );
+				ImGui::Text("Frame %0.3f [ms]", double(m_benchFrameNs)/1000000.0/double(kBenchFrames) );
+				ImGui::Text("Fragmentation %0.1f%%", m_benchFragmentation);
+			}
+
+			ImGui::End();
+
+			imguiEndFrame();
+
+			float time = (float)( (bx::getHPCounter()-m_timeOffset)/double(bx::getHPFrequency() ) );
+
+			const bx::Vec3 at  = { 0.0f, 0.0f,   0.0f };
+			const bx::Vec3 eye = { 0.0f, 0.0f, -35.0f };
+
+			// Set view and projection matrix for view 0.
+			{
+				float view[16];
+				bx::mtxLookAt(view, eye, at);
+
+				float proj[16];
+				bx::mtxProj(proj, 60.0f, float(m_width)/float(m_height), 0.1f, 100.0f, bgfx::getCaps()->homogeneousDepth);
+				bgfx::setViewTransform(0, view, proj);
+
+				// Set view 0 default viewport.
+				bgfx::setViewRect(0, 0, 0, uint16_t(m_width), uint16_t(m_height) );
+			}
+
+			// This dummy draw call is here to make sure that view 0 is cleared
+			// if no other draw calls are submitted to view 0.
+			bgfx::touch(0);
+
+			const uint32_t numChurn = 0 != m_benchFrame ? kBenchChurn : uint32_t(m_churn);
+			m_churnNs = churn(numChurn)*1000000000/bx::getHPFrequency();
+
+			if (m_staticCycling)
+			{
+				cycleStatic();
+			}
+
+			// Submit 11x11 cubes from first buffers, just to show they are valid.
+			for (uint32_t yy = 0; yy < kDimHeight; ++yy)
+			{
+				for (uint32_t xx = 0; xx < kDimWidth; ++xx)
+				{
+					const bgfx::DynamicVertexBufferHandle vbh = m_vbh[yy*kDimWidth+xx];
+
+					if (!bgfx::isValid(vbh) )
+					{
+						continue;
+					}
+
+					float mtx[16];
+					bx::mtxRotateXY(mtx, time + xx*0.21f, time + yy*0.37f);
+					mtx[12] = -15.0f + float(xx)*3.0f;
+					mtx[13] = -15.0f + float(yy)*3.0f;
+					mtx[14] = 0.0f;
+
+					bgfx::setTransform(mtx);
+					bgfx::setVertexBuffer(0, vbh, 0, BX_COUNTOF(s_cubeVertices) );
+					bgfx::setIndexBuffer(m_ibh);
+					bgfx::setState(0
+						| BGFX_STATE_DEFAULT
+						| BGFX_STATE_PT_TRISTRIP
+						);
+					bgfx::submit(0, m_program);
+				}
+			}
+
+			// Advance to next frame. Rendering thread will be kicked to
+			// process submitted rendering primitives.
+			const int64_t frameBegin = bx::getHPCounter();
+			bgfx::frame();
+			m_frameNs = (bx::getHPCounter() - frameBegin)*1000000000/bx::getHPFrequency();
+
+			if (0 != m_benchFrame)
+			{
+				m_benchChurnNs += m_churnNs;
+				m_benchFrameNs += m_frameNs;
+				m_benchNumOps  += numChurn;
+
+				--m_benchFrame;
+				if (0 == m_benchFrame)
+				{
+					const bgfx::Stats* benchStats = bgfx::getStats();
+					m_benchFragmentation = 0 == benchStats->dynamicVbFree
+						? 0.0
+						: 100.0 - 100.0*double(benchStats->dynamicVbLargestFree)/double(benchStats->dynamicVbFree)
+						;
+					m_benchDone = true;
+
+					DBG("Churn %d ops: create/destroy %0.3f [us/op], frame %0.3f [ms], fragmentation %0.1f%%"
+						, uint32_t(m_benchNumOps)
+						, double(m_benchChurnNs)/1000.0/double(m_benchNumOps)
+						, double(m_benchFrameNs)/1000000.0/double(kBenchFrames)
+						, m_benchFragmentation
+						);
+				}
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	entry::MouseState m_mouseState;
+
+	bx::RngMwc m_mwc;
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_debug;
+	uint32_t m_reset;
+
+	int32_t  m_churn;
+	int64_t  m_churnNs;
+	int64_t  m_frameNs;
+
+	uint32_t m_benchFrame;
+	int64_t  m_benchChurnNs;
+	int64_t  m_benchFrameNs;
+	int64_t  m_benchNumOps;
+	double   m_benchFragmentation;
+	bool     m_benchDone;
+
+	uint32_t m_numStatic;
+	uint32_t m_staticCycled;
+	bool     m_staticCycling;
+	int64_t  m_staticCreateNs;
+	int64_t  m_staticDestroyNs;
+
+	bgfx::DynamicVertexBufferHandle m_vbh[kMaxBuffers];
+	bgfx::VertexBufferHandle m_staticVbh[kStaticBatch];
+	bgfx::IndexBufferHandle  m_staticIbh[kStaticBatch];
+	bgfx::IndexBufferHandle m_ibh;
+	bgfx::ProgramHandle m_program;
+	int64_t m_timeOffset;
+};
+
+} // namespace
+
+ENTRY_IMPLEMENT_MAIN(
+	  ExampleBufferStress
+	, "46-bufferstress"
+	, "Buffer allocation stress test."
+	, "https://bkaradzic.github.io/bgfx/examples.html#bufferstress"
+	);
@@ -0,0 +1,409 @@
+/*
+ * Copyright 2011-2021 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "bgfx_utils.h"
+#include "imgui/imgui.h"
+
+#include <bx/math.h>
+
+namespace
+{
+
+// Torus with kNumRings*kNumSides*2 triangles, ~1M triangles.
+const uint32_t kNumRings = 1024;
+const uint32_t kNumSides = 512;
+
+const uint32_t kNumVertices  = (kNumRings+1)*(kNumSides+1);
+const uint32_t kNumTriangles = kNumRings*kNumSides*2;
+const uint32_t kNumIndices   = kNumTriangles*3;
+
+const uint32_t kBenchFrames = 300;
+
+struct PosColorVertex
+{
+	float m_x;
+	float m_y;
+	float m_z;
+	uint32_t m_abgr;
+
+	static void init()
+	{
+		ms_layout
+			.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
+			.end();
+	};
+
+	static bgfx::VertexLayout ms_layout;
+};
+
+bgfx::VertexLayout PosColorVertex::ms_layout;
+
+static const char* s_sortName[] =
+{
+	"Direction front to back (min)",
+	"Direction front to back (avg)",
+	"Direction front to back (max)",
+	"Direction back to front (min)",
+	"Direction back to front (avg)",
+	"Direction back to front (max)",
+	"Distance front to back (min)",
+	"Distance front to back (avg)",
+	"Distance front to back (max)",
+	"Distance back to front (min)",
+	"Distance back to front (avg)",
+	"Distance back to front (max)",
+};
+BX_STATIC_ASSERT(BX_COUNTOF(s_sortName) == bgfx::TopologySort::Count);
+
+class ExampleTopologySort : public entry::AppI
+{
+public:
+	ExampleTopologySort(const char* _name, const char* _description, const char* _url)
+		: entry::AppI(_name, _description, _url)
+	{
+	}
+
+	void init(int32_t _argc, const char* const* _argv, uint32_t _width, uint32_t _height) override
+	{
+		Args args(_argc, _argv);
+
+		m_width  = _width;
+		m_height = _height;
+		m_debug  = BGFX_DEBUG_NONE;
+		m_reset  = BGFX_RESET_VSYNC;
+
+		bgfx::Init init;
+		init.type     = args.m_type;
+		init.vendorId = args.m_pciId;
+		init.resolution.width  = m_width;
+		init.resolution.height = m_height;
+		init.resolution.reset  = m_reset;
+		bgfx::init(init);
+
+		// Enable debug text.
+		bgfx::setDebug(m_debug);
+
+		// Set view 0 clear state.
+		bgfx::setViewClear(0
+			, BGFX_CLEAR_COLOR|BGFX_CLEAR_DEPTH
+			, 0x303030ff
+			, 1.0f
+			, 0
+			);
+
+		// Create vertex stream declaration.
+		PosColorVertex::init();
+
+		createMesh();
+
+		m_vbh = bgfx::createVertexBuffer(
+			  bgfx::makeRef(m_vertices, kNumVertices*sizeof(PosColorVertex) )
+			, PosColorVertex::ms_layout
+			);
+
+		m_ibh = bgfx::createDynamicIndexBuffer(kNumIndices, BGFX_BUFFER_INDEX32);
+
+		// Create program from shaders.
+		m_program = loadProgram("vs_cubes", "fs_cubes");
+
+		m_sort      = bgfx::TopologySort::DistanceBackToFrontAvg;
+		m_useSorter = true;
+		m_sorter    = bgfx::createTopologySorter();
+
+		m_sortNs       = 0;
+		m_benchFrame   = 0;
+		m_benchSortNs  = 0;
+		m_benchMinNs   = 0;
+		m_benchDone    = false;
+
+		m_timeOffset = bx::getHPCounter();
+
+		imguiCreate();
+	}
+
+	virtual int shutdown() override
+	{
+		imguiDestroy();
+
+		// Cleanup.
+		bgfx::destroy(m_sorter);
+		bgfx::destroy(m_ibh);
+		bgfx::destroy(m_vbh);
+		bgfx::destroy(m_program);
+
+		// Shutdown bgfx.
+		bgfx::shutdown();
+
+		delete [] m_vertices;
+		delete [] m_indices;
+
+		return 0;
+	}
+
+	void createMesh()
+	{
+		m_vertices = new PosColorVertex[kNumVertices];
+		m_indices  = new uint32_t[kNumIndices];
+
+		const float ringRadius = 6.0f;
+		const float sideRadius = 2.5f;
+
+		PosColorVertex* vertex = m_vertices;
+
+		for (uint32_t ring = 0; ring <= kNumRings; ++ring)
+		{
+			const float uu = float(ring)/float(kNumRings);
+			const float sr = bx::sin(uu*bx::kPi2);
+			const float cr = bx::cos(uu*bx::kPi2);
+
+			for (uint32_t side = 0; side <= kNumSides; ++side)
+			{
+				const float vv = float(side)/float(kNumSides);
+				const float ss = bx::sin(vv*bx::kPi2);
+				const float cs = bx::cos(vv*bx::kPi2);
+
+				const float radius = ringRadius + sideRadius*cs;
+
+				vertex->m_x = radius*cr;
+				vertex->m_y = sideRadius*ss;
+				vertex->m_z = radius*sr;
+				vertex->m_abgr = 0x80000000
+					| (uint32_t(uu*255.0f)     )
+					| (uint32_t(vv*255.0f) << 8)
+					| 0x00ff0000
+					;
+				++vertex;
+			}
+		}
+
+		uint32_t* index = m_indices;
+
+		for (uint32_t ring = 0; ring < kNumRings; ++ring)
+		{
+			for (uint32_t side = 0; side < kNumSides; ++side)
+			{
+				const uint32_t i0 = ring*(kNumSides+1) + side;
+				const uint32_t i1 = i0 + kNumSides + 1;
+
+				index[0] = i0;
+				index[1] = i1;
+				index[2] = i0 + 1;
+				index[3] = i0 + 1;
+				index[4] = i1;
+				index[5] = i1 + 1;
+				index += 6;
+			}
+		}
+	}
+
+	// Sorts indices and returns time spent in sort.
+	int64_t sortIndices(const bgfx::Memory* _mem, const float _dir[3], const float _pos[3])
+	{
+		const int64_t begin = bx::getHPCounter();
+
+		if (m_useSorter)
+		{
+			m_sorter->sortTriList(
+				  bgfx::TopologySort::Enum(m_sort)
+				, _mem->data
+				, _mem->size
+				, _dir
+				, _pos
+				, m_vertices
+				, sizeof(PosColorVertex)
+				, m_indices
+				, kNumIndices
+				, true
+				);
+		}
+		else
+		{
+			bgfx::topologySortTriList(
+				  bgfx::TopologySort::Enum(m_sort)
+				, _mem->data
+				, _mem->size
+				, _dir
+				, _pos
+				, m_vertices
+				, sizeof(PosColorVertex)
+				, m_indices
+				, kNumIndices
+				, true
+				);
+		}
+
+		return (bx::getHPCounter() - begin)*1000000000/bx::getHPFrequency();
+	}
+
+	bool update() override
+	{
+		if (!entry::processEvents(m_width, m_height, m_debug, m_reset, &m_mouseState) )
+		{
+			imguiBeginFrame(m_mouseState.m_mx
+				,  m_mouseState.m_my
+				, (m_mouseState.m_buttons[entry::MouseButton::Left  ] ? IMGUI_MBUT_LEFT   : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Right ] ? IMGUI_MBUT_RIGHT  : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Middle] ? IMGUI_MBUT_MIDDLE : 0)
+				,  m_mouseState.m_mz
+				, uint16_t(m_width)
+				, uint16_t(m_height)
+				);
+
+			showExampleDialog(this);
+
+			ImGui::SetNextWindowPos(
+				  ImVec2(m_width - m_width / 4.0f - 10.0f, 10.0f)
+				, ImGuiCond_FirstUseEver
+				);
+			ImGui::SetNextWindowSize(
+				  ImVec2(m_width / 4.0f, m_height / 2.0f)
+				, ImGuiCond_FirstUseEver
+				);
+			ImGui::Begin("Settings"
+				, NULL
+				, 0
+				);
+
+			ImGui::Text("Triangles %d", kNumTriangles);
+			ImGui::Combo("Sort", &m_sort, s_sortName, BX_COUNTOF(s_sortName) );
+			ImGui::Checkbox("Use sorter", &m_useSorter);
+
+			ImGui::Text("Sort %0.3f [ms]", double(m_sortNs)/1000000.0);
+
+			ImGui::Separator();
+
+			if (0 == m_benchFrame)
+			{
+				if (ImGui::Button("Benchmark") )
+				{
+					m_benchFrame  = kBenchFrames;
+					m_benchSortNs = 0;
+					m_benchMinNs  = INT64_MAX;
+					m_benchDone   = false;
+				}
+			}
+			else
+			{
+				ImGui::Text("Benchmark %d frames left...", m_benchFrame);
+			}
+
+			if (m_benchDone)
+			{
+				ImGui::Text("Sort avg %0.3f [ms]", double(m_benchSortNs)/1000000.0/double(kBenchFrames) );
+				ImGui::Text("Sort min %0.3f [ms]", double(m_benchMinNs)/1000000.0);
+			}
+
+			ImGui::End();
+
+			imguiEndFrame();
+
+			float time = (float)( (bx::getHPCounter()-m_timeOffset)/double(bx::getHPFrequency() ) );
+
+			// Camera orbits slowly, so consecutive sorts see only small changes in order.
+			const bx::Vec3 at  = { 0.0f, 0.0f, 0.0f };
+			const bx::Vec3 eye =
+			{
+				bx::sin(time*0.2f)*20.0f,
+				8.0f,
+				bx::cos(time*0.2f)*20.0f,
+			};
+
+			// Set view and projection matrix for view 0.
+			{
+				float view[16];
+				bx::mtxLookAt(view, eye, at);
+
+				float proj[16];
+				bx::mtxProj(proj, 60.0f, float(m_width)/float(m_height), 0.1f, 100.0f, bgfx::getCaps()->homogeneousDepth);
+				bgfx::setViewTransform(0, view, proj);
+
+				// Set view 0 default viewport.
+				bgfx::setViewRect(0, 0, 0, uint16_t(m_width), uint16_t(m_height) );
+			}
+
+			const bx::Vec3 dir = bx::normalize(bx::sub(at, eye) );
+
+			const float dirArray[3] = { dir.x, dir.y, dir.z };
+			const float posArray[3] = { eye.x, eye.y, eye.z };
+
+			const bgfx::Memory* mem = bgfx::alloc(kNumIndices*sizeof(uint32_t) );
+			m_sortNs = sortIndices(mem, dirArray, posArray);
+			bgfx::update(m_ibh, 0, mem);
+
+			bgfx::setVertexBuffer(0, m_vbh);
+			bgfx::setIndexBuffer(m_ibh);
+			bgfx::setState(0
+				| BGFX_STATE_WRITE_RGB
+				| BGFX_STATE_DEPTH_TEST_LESS
+				| BGFX_STATE_BLEND_ALPHA
+				);
+			bgfx::submit(0, m_program);
+
+			// Advance to next frame. Rendering thread will be kicked to
+			// process submitted rendering primitives.
+			bgfx::frame();
+
+			if (0 != m_benchFrame)
+			{
+				m_benchSortNs += m_sortNs;
+				m_benchMinNs   = bx::min(m_benchMinNs, m_sortNs);
+
+				--m_benchFrame;
+				if (0 == m_benchFrame)
+				{
+					m_benchDone = true;
+
+					DBG("Topology sort %d triangles, %s: avg %0.3f [ms], min %0.3f [ms]"
+						, kNumTriangles
+						, m_useSorter ? "sorter" : "stateless"
+						, double(m_benchSortNs)/1000000.0/double(kBenchFrames)
+						, double(m_benchMinNs)/1000000.0
+						);
+				}
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	entry::MouseState m_mouseState;
+
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_debug;
+	uint32_t m_reset;
+
+	int32_t m_sort;
+	bool    m_useSorter;
+
+	int64_t  m_sortNs;
+	uint32_t m_benchFrame;
+	int64_t  m_benchSortNs;
+	int64_t  m_benchMinNs;
+	bool     m_benchDone;
+
+	PosColorVertex* m_vertices;
+	uint32_t* m_indices;
+
+	bgfx::TopologySorter* m_sorter;
+	bgfx::VertexBufferHandle m_vbh;
+	bgfx::DynamicIndexBufferHandle m_ibh;
+	bgfx::ProgramHandle m_program;
+	int64_t m_timeOffset;
+};
+
+} // namespace
+
+ENTRY_IMPLEMENT_MAIN(
+	  ExampleTopologySort
+	, "47-topologysort"
+	, "Topology sorter benchmark."
+	, "https://bkaradzic.github.io/bgfx/examples.html#topologysort"
+	);
@@ -0,0 +1,523 @@
+/*
+ * Copyright 2011-2021 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.h"
+#include "bgfx_utils.h"
+#include "imgui/imgui.h"
+
+#include <bx/rng.h>
+#include <bx/string.h>
+
+namespace
+{
+
+// Not multiple of 4 or of conversion block size, so partial groups are verified too.
+const uint32_t kVerifyVertices = 1003;
+
+// Large enough that vertexConvert splits it across worker threads.
+const uint32_t kBenchVertices = 1<<20;
+
+const uint32_t kBenchSeed = 1337;
+
+static const char* s_attribTypeName[] =
+{
+	"Uint8",
+	"Uint10",
+	"Int16",
+	"Half",
+	"Float",
+};
+BX_STATIC_ASSERT(BX_COUNTOF(s_attribTypeName) == bgfx::AttribType::Count);
+
+struct AttribDesc
+{
+	bgfx::AttribType::Enum type;
+	uint8_t num;
+	bool normalized;
+	bool asInt;
+};
+
+static uint16_t genHalf(bx::RngMwc& _rng, bool _special)
+{
+	const uint32_t rnd  = _rng.gen();
+	const uint16_t sign = uint16_t( (rnd & 1) << 15);
+	const uint16_t mant = uint16_t( (rnd >> 1) & 0x3ff);
+
+	switch ( (rnd >> 11) & 7)
+	{
+	case 0:
+		// Signed zero.
+		return sign;
+
+	case 1:
+		// Denormal.
+		return sign | bx::max<uint16_t>(mant, 1);
+
+	default:
+		break;
+	}
+
+	// Out of range values are undefined when packed into integer types, keep them below 2.0.
+	const uint16_t exp = _special
+		? uint16_t(1 + (rnd >> 14) % 31)
+		: uint16_t(1 + (rnd >> 14) % 15)
+		;
+
+	return sign | uint16_t(exp << 10) | mant;
+}
+
+static float genFloat(bx::RngMwc& _rng, bool _special)
+{
+	static const float s_tiny[] =
+	{
+		 0.0f,
+		-0.0f,
+		 1.0e-5f,
+		-3.0e-7f,
+		 1.0e-30f,
+		 6.1e-5f,
+	};
+
+	static const uint32_t s_special[] =
+	{
+		UINT32_C(0x477fefff), //  65519.996
+		UINT32_C(0x477ff000), //  65520.0, rounds to half infinity
+		UINT32_C(0xd01502f9), // -1.0e10
+		UINT32_C(0x7f7fffff), //  max float
+		UINT32_C(0x7f800000), // +inf
+		UINT32_C(0xff800000), // -inf
+		UINT32_C(0x7fc00000), //  quiet NaN
+		UINT32_C(0x7fa00001), //  signaling NaN
+	};
+
+	const uint32_t rnd = _rng.gen();
+
+	switch (rnd & 7)
+	{
+	case 0:
+		return s_tiny[(rnd >> 3) % BX_COUNTOF(s_tiny)];
+
+	case 1:
+		if (_special)
+		{
+			return bx::bitsToFloat(s_special[(rnd >> 3) % BX_COUNTOF(s_special)]);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return bx::frnd(&_rng)*4.0f - 2.0f;
+}
+
+// Source and destination both have Color0 copied, and Position converted. Destination has
+// TexCoord0 which is not in source, and gets cleared.
+static void initLayouts(bgfx::VertexLayout& _src, bgfx::VertexLayout& _dst, const AttribDesc& _srcDesc, const AttribDesc& _dstDesc)
+{
+	_src.begin()
+		.add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
+		.add(bgfx::Attrib::Position, _srcDesc.num, _srcDesc.type, _srcDesc.normalized, _srcDesc.asInt)
+		.end();
+
+	_dst.begin()
+		.add(bgfx::Attrib::Position,  _dstDesc.num, _dstDesc.type, _dstDesc.normalized, _dstDesc.asInt)
+		.add(bgfx::Attrib::Color0,    4, bgfx::AttribType::Uint8, true)
+		.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
+		.end();
+}
+
+static void fillSource(bx::RngMwc& _rng, const bgfx::VertexLayout& _layout, uint8_t* _data, uint32_t _num, bool _special)
+{
+	// Random bytes cover every bit pattern of Uint8, Uint10 and Int16, and padding.
+	const uint32_t size = _layout.getSize(_num);
+	for (uint32_t ii = 0; ii < size; ++ii)
+	{
+		_data[ii] = uint8_t(_rng.gen() );
+	}
+
+	uint8_t num;
+	bgfx::AttribType::Enum type;
+	bool normalized;
+	bool asInt;
+	_layout.decode(bgfx::Attrib::Position, num, type, normalized, asInt);
+
+	const uint16_t stride = _layout.getStride();
+	uint8_t* data = _data + _layout.getOffset(bgfx::Attrib::Position);
+
+	for (uint32_t ii = 0; ii < _num; ++ii, data += stride)
+	{
+		for (uint32_t jj = 0; jj < num; ++jj)
+		{
+			if (bgfx::AttribType::Half == type)
+			{
+				const uint16_t value = genHalf(_rng, _special);
+				bx::memCopy(&data[jj*sizeof(uint16_t)], &value, sizeof(uint16_t) );
+			}
+			else if (bgfx::AttribType::Float == type)
+			{
+				const float value = genFloat(_rng, _special);
+				bx::memCopy(&data[jj*sizeof(float)], &value, sizeof(float) );
+			}
+		}
+	}
+}
+
+// Reference conversion, attribute by attribute and vertex by vertex, same as vertexConvert
+// used to do.
+static void referenceConvert(const bgfx::VertexLayout& _dstLayout, uint8_t* _dst, const bgfx::VertexLayout& _srcLayout, const uint8_t* _src, uint32_t _num)
+{
+	for (uint32_t ii = 0; ii < _num; ++ii)
+	{
+		for (uint32_t attr = 0; attr < bgfx::Attrib::Count; ++attr)
+		{
+			const bgfx::Attrib::Enum attrib = bgfx::Attrib::Enum(attr);
+
+			if (!_dstLayout.has(attrib) )
+			{
+				continue;
+			}
+
+			uint8_t* dst = _dst + ii*_dstLayout.getStride() + _dstLayout.getOffset(attrib);
+
+			if (!_srcLayout.has(attrib) )
+			{
+				// Only TexCoord0 is missing in source.
+				bx::memSet(dst, 0, 2*sizeof(float) );
+			}
+			else if (_dstLayout.m_attributes[attrib] == _srcLayout.m_attributes[attrib])
+			{
+				// Only Color0 is same in source and destination.
+				bx::memCopy(dst, _src + ii*_srcLayout.getStride() + _srcLayout.getOffset(attrib), 4);
+			}
+			else
+			{
+				float value[4] = {};
+				bgfx::vertexUnpack(value, attrib, _srcLayout, _src, ii);
+				bgfx::vertexPack(value, true, attrib, _dstLayout, _dst, ii);
+			}
+		}
+	}
+}
+
+class ExampleVertexConvert : public entry::AppI
+{
+public:
+	ExampleVertexConvert(const char* _name, const char* _description, const char* _url)
+		: entry::AppI(_name, _description, _url)
+	{
+	}
+
+	void init(int32_t _argc, const char* const* _argv, uint32_t _width, uint32_t _height) override
+	{
+		Args args(_argc, _argv);
+
+		m_width  = _width;
+		m_height = _height;
+		m_debug  = BGFX_DEBUG_NONE;
+		m_reset  = BGFX_RESET_VSYNC;
+
+		bgfx::Init init;
+		init.type     = args.m_type;
+		init.vendorId = args.m_pciId;
+		init.resolution.width  = m_width;
+		init.resolution.height = m_height;
+		init.resolution.reset  = m_reset;
+		bgfx::init(init);
+
+		// Enable debug text.
+		bgfx::setDebug(m_debug);
+
+		// Set view 0 clear state.
+		bgfx::setViewClear(0
+			, BGFX_CLEAR_COLOR|BGFX_CLEAR_DEPTH
+			, 0x303030ff
+			, 1.0f
+			, 0
+			);
+
+		m_benchRefNs     = 0;
+		m_benchConvertNs = 0;
+		m_benchMatch     = false;
+		m_benchDone      = false;
+
+		verify();
+
+		imguiCreate();
+	}
+
+	virtual int shutdown() override
+	{
+		imguiDestroy();
+
+		// Shutdown bgfx.
+		bgfx::shutdown();
+
+		return 0;
+	}
+
+	// Converts every pair of source and destination attribute encoding with vertexConvert, and
+	// compares it byte by byte against vertexUnpack/vertexPack.
+	void verify()
+	{
+		bx::RngMwc rng(kBenchSeed);
+
+		AttribDesc desc[bgfx::AttribType::Count*4*2*2];
+		uint32_t numDesc = 0;
+
+		for (uint32_t type = 0; type < bgfx::AttribType::Count; ++type)
+		for (uint8_t  num = 1; num <= 4; ++num)
+		for (uint32_t normalized = 0; normalized < 2; ++normalized)
+		for (uint32_t asInt = 0; asInt < 2; ++asInt)
+		{
+			AttribDesc& ad = desc[numDesc++];
+			ad.type       = bgfx::AttribType::Enum(type);
+			ad.num        = num;
+			ad.normalized = 0 != normalized;
+			ad.asInt      = 0 != asInt;
+		}
+
+		bgfx::VertexLayout srcLayout;
+		bgfx::VertexLayout dstLayout;
+
+		const uint32_t maxSize = kVerifyVertices*64;
+		uint8_t* src = new uint8_t[maxSize];
+		uint8_t* dst = new uint8_t[maxSize];
+		uint8_t* ref = new uint8_t[maxSize];
+
+		m_numVerified = 0;
+		m_numMismatch = 0;
+		m_mismatch[0] = '\0';
+
+		for (uint32_t ii = 0; ii < numDesc; ++ii)
+		{
+			for (uint32_t jj = 0; jj < numDesc; ++jj)
+			{
+				initLayouts(srcLayout, dstLayout, desc[ii], desc[jj]);
+
+				// Identical encoding is copied, not converted.
+				if (srcLayout.m_attributes[bgfx::Attrib::Position] == dstLayout.m_attributes[bgfx::Attrib::Position])
+				{
+					continue;
+				}
+
+				// Inf, NaN and large values are verified only when destination is floating point,
+				// packing them into integer types is undefined.
+				const bool special = false
+					|| bgfx::AttribType::Half  == desc[jj].type
+					|| bgfx::AttribType::Float == desc[jj].type
+					;
+
+				fillSource(rng, srcLayout, src, kVerifyVertices, special);
+
+				const uint32_t dstSize = dstLayout.getSize(kVerifyVertices);
+				bx::memSet(dst, 0xcd, dstSize);
+				bx::memSet(ref, 0xcd, dstSize);
+
+				bgfx::vertexConvert(dstLayout, dst, srcLayout, src, kVerifyVertices);
+				referenceConvert(dstLayout, ref, srcLayout, src, kVerifyVertices);
+
+				++m_numVerified;
+
+				if (0 != bx::memCmp(dst, ref, dstSize) )
+				{
+					if (0 == m_numMismatch)
+					{
+						bx::snprintf(m_mismatch, BX_COUNTOF(m_mismatch)
+							, "%s%d%s%s -> %s%d%s%s"
+							, s_attribTypeName[desc[ii].type], desc[ii].num, desc[ii].normalized ? " norm" : "", desc[ii].asInt ? " int" : ""
+							, s_attribTypeName[desc[jj].type], desc[jj].num, desc[jj].normalized ? " norm" : "", desc[jj].asInt ? " int" : ""
+							);
+					}
+
+					++m_numMismatch;
+				}
+			}
+		}
+
+		delete [] src;
+		delete [] dst;
+		delete [] ref;
+
+		DBG("vertexConvert verified %d combinations, %d mismatches %s"
+			, m_numVerified
+			, m_numMismatch
+			, m_mismatch
+			);
+	}
+
+	// Converts typical full precision mesh into compressed one.
+	void benchmark()
+	{
+		bgfx::VertexLayout srcLayout;
+		srcLayout.begin()
+			.add(bgfx::Attrib::Position,  3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Normal,    3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Tangent,   4, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Color0,    4, bgfx::AttribType::Uint8, true)
+			.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
+			.end();
+
+		bgfx::VertexLayout dstLayout;
+		dstLayout.begin()
+			.add(bgfx::Attrib::Position,  4, bgfx::AttribType::Half)
+			.add(bgfx::Attrib::Normal,    4, bgfx::AttribType::Uint8, true, true)
+			.add(bgfx::Attrib::Tangent,   4, bgfx::AttribType::Uint8, true, true)
+			.add(bgfx::Attrib::Color0,    4, bgfx::AttribType::Uint8, true)
+			.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Int16, true)
+			.end();
+
+		uint8_t* src = new uint8_t[srcLayout.getSize(kBenchVertices)];
+		uint8_t* dst = new uint8_t[dstLayout.getSize(kBenchVertices)];
+		uint8_t* ref = new uint8_t[dstLayout.getSize(kBenchVertices)];
+
+		bx::RngMwc rng(kBenchSeed);
+
+		for (uint32_t ii = 0; ii < kBenchVertices; ++ii)
+		{
+			float value[4];
+
+			for (uint32_t attr = 0; attr < bgfx::Attrib::Count; ++attr)
+			{
+				for (uint32_t jj = 0; jj < 4; ++jj)
+				{
+					value[jj] = bx::frnd(&rng)*2.0f - 1.0f;
+				}
+
+				bgfx::vertexPack(value, true, bgfx::Attrib::Enum(attr), srcLayout, src, ii);
+			}
+		}
+
+		int64_t begin = bx::getHPCounter();
+		referenceConvert(dstLayout, ref, srcLayout, src, kBenchVertices);
+		m_benchRefNs = (bx::getHPCounter() - begin)*1000000000/bx::getHPFrequency();
+
+		begin = bx::getHPCounter();
+		bgfx::vertexConvert(dstLayout, dst, srcLayout, src, kBenchVertices);
+		m_benchConvertNs = (bx::getHPCounter() - begin)*1000000000/bx::getHPFrequency();
+
+		m_benchMatch = 0 == bx::memCmp(dst, ref, dstLayout.getSize(kBenchVertices) );
+		m_benchDone  = true;
+
+		delete [] src;
+		delete [] dst;
+		delete [] ref;
+
+		DBG("vertexConvert %d vertices: reference %0.3f [ms], vertexConvert %0.3f [ms], %s"
+			, kBenchVertices
+			, double(m_benchRefNs)/1000000.0
+			, double(m_benchConvertNs)/1000000.0
+			, m_benchMatch ? "match" : "MISMATCH"
+			);
+	}
+
+	bool update() override
+	{
+		if (!entry::processEvents(m_width, m_height, m_debug, m_reset, &m_mouseState) )
+		{
+			imguiBeginFrame(m_mouseState.m_mx
+				,  m_mouseState.m_my
+				, (m_mouseState.m_buttons[entry::MouseButton::Left  ] ? IMGUI_MBUT_LEFT   : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Right ] ? IMGUI_MBUT_RIGHT  : 0)
+				| (m_mouseState.m_buttons[entry::MouseButton::Middle] ? IMGUI_MBUT_MIDDLE : 0)
+				,  m_mouseState.m_mz
+				, uint16_t(m_width)
+				, uint16_t(m_height)
+				);
+
+			showExampleDialog(this);
+
+			ImGui::SetNextWindowPos(
+				  ImVec2(m_width - m_width / 4.0f - 10.0f, 10.0f)
+				, ImGuiCond_FirstUseEver
+				);
+			ImGui::SetNextWindowSize(
+				  ImVec2(m_width / 4.0f, m_height / 2.0f)
+				, ImGuiCond_FirstUseEver
+				);
+			ImGui::Begin("Settings"
+				, NULL
+				, 0
+				);
+
+			ImGui::Text("Verified %d combinations", m_numVerified);
+
+			if (0 == m_numMismatch)
+			{
+				ImGui::Text("Bit-exact with vertexUnpack/vertexPack.");
+			}
+			else
+			{
+				ImGui::TextColored(ImVec4(1.0f, 0.25f, 0.25f, 1.0f), "%d mismatches!", m_numMismatch);
+				ImGui::Text("First: %s", m_mismatch);
+			}
+
+			if (ImGui::Button("Verify") )
+			{
+				verify();
+			}
+
+			ImGui::Separator();
+
+			if (ImGui::Button("Benchmark") )
+			{
+				benchmark();
+			}
+
+			if (m_benchDone)
+			{
+				ImGui::Text("%d vertices", kBenchVertices);
+				ImGui::Text("Reference %0.3f [ms]", double(m_benchRefNs)/1000000.0);
+				ImGui::Text("vertexConvert %0.3f [ms]", double(m_benchConvertNs)/1000000.0);
+				ImGui::Text("Speedup %0.1fx", double(m_benchRefNs)/double(bx::max<int64_t>(1, m_benchConvertNs) ) );
+				ImGui::Text("Output %s", m_benchMatch ? "matches" : "DOESN'T MATCH");
+			}
+
+			ImGui::End();
+
+			imguiEndFrame();
+
+			// Set view 0 default viewport.
+			bgfx::setViewRect(0, 0, 0, uint16_t(m_width), uint16_t(m_height) );
+
+			// This dummy draw call is here to make sure that view 0 is cleared
+			// if no other draw calls are submitted to view 0.
+			bgfx::touch(0);
+
+			// Advance to next frame. Rendering thread will be kicked to
+			// process submitted rendering primitives.
+			bgfx::frame();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	entry::MouseState m_mouseState;
+
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_debug;
+	uint32_t m_reset;
+
+	uint32_t m_numVerified;
+	uint32_t m_numMismatch;
+	char     m_mismatch[128];
+
+	int64_t m_benchRefNs;
+	int64_t m_benchConvertNs;
+	bool    m_benchMatch;
+	bool    m_benchDone;
+};
+
+} // namespace
+
+ENTRY_IMPLEMENT_MAIN(
+	  ExampleVertexConvert
+	, "48-vertexconvert"
+	, "Vertex conversion verification and benchmark."
+	, "https://bkaradzic.github.io/bgfx/examples.html#vertexconvert"
+	);
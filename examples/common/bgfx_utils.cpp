@@ -369,7 +369,24 @@ void Group::reset()
 	m_vertices = NULL;
 	m_numIndices = 0;
 	m_indices = NULL;
+	m_indices32 = NULL;
+	m_index32 = false;
 	m_prims.clear();
+	m_meshlets.clear();
+	m_meshletVertices = NULL;
+	m_meshletTriangles = NULL;
+	m_lods.clear();
+}
+
+bgfx::IndexBufferHandle Group::getIndexBuffer(uint8_t _lod) const
+{
+	if (0 == _lod
+	||  m_lods.empty() )
+	{
+		return m_ibh;
+	}
+
+	return m_lods[bx::min<uint32_t>(_lod, uint32_t(m_lods.size() ) ) - 1].m_ibh;
 }
 
 namespace bgfx
@@ -377,6 +394,34 @@ namespace bgfx
 	int32_t read(bx::ReaderI* _reader, bgfx::VertexLayout& _layout, bx::Error* _err = NULL);
 }
 
+static const bgfx::Memory* readIndices(bx::ReaderI* _reader, uint32_t _numIndices, bool _index32, bool _compressed)
+{
+	const uint32_t indexSize = _index32 ? sizeof(uint32_t) : sizeof(uint16_t);
+	const bgfx::Memory* mem = bgfx::alloc(_numIndices*indexSize);
+
+	if (_compressed)
+	{
+		bx::AllocatorI* allocator = entry::getAllocator();
+
+		uint32_t compressedSize;
+		bx::read(_reader, compressedSize);
+
+		void* compressedIndices = BX_ALLOC(allocator, compressedSize);
+
+		bx::read(_reader, compressedIndices, compressedSize);
+
+		meshopt_decodeIndexBuffer(mem->data, _numIndices, indexSize, (uint8_t*)compressedIndices, compressedSize);
+
+		BX_FREE(allocator, compressedIndices);
+	}
+	else
+	{
+		bx::read(_reader, mem->data, mem->size);
+	}
+
+	return mem;
+}
+
 void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 {
 	constexpr uint32_t kChunkVertexBuffer           = BX_MAKEFOURCC('V', 'B', ' ', 0x1);
@@ -385,6 +430,14 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 	constexpr uint32_t kChunkIndexBufferCompressed  = BX_MAKEFOURCC('I', 'B', 'C', 0x1);
 	constexpr uint32_t kChunkPrimitive              = BX_MAKEFOURCC('P', 'R', 'I', 0x0);
 
+	constexpr uint32_t kChunkVertexBuffer32           = BX_MAKEFOURCC('V', 'B', '3', 0x0);
+	constexpr uint32_t kChunkVertexBufferCompressed32 = BX_MAKEFOURCC('V', 'B', 'D', 0x0);
+	constexpr uint32_t kChunkIndexBuffer32            = BX_MAKEFOURCC('I', 'B', '3', 0x0);
+	constexpr uint32_t kChunkIndexBufferCompressed32  = BX_MAKEFOURCC('I', 'B', 'D', 0x0);
+
+	constexpr uint32_t kChunkMeshlet                  = BX_MAKEFOURCC('M', 'S', 'H', 0x0);
+	constexpr uint32_t kChunkLod                      = BX_MAKEFOURCC('L', 'O', 'D', 0x0);
+
 	using namespace bx;
 	using namespace bgfx;
 
@@ -400,6 +453,7 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 		switch (chunk)
 		{
 			case kChunkVertexBuffer:
+			case kChunkVertexBuffer32:
 			{
 				read(_reader, group.m_sphere);
 				read(_reader, group.m_aabb);
@@ -409,7 +463,17 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 
 				uint16_t stride = m_layout.getStride();
 
-				read(_reader, group.m_numVertices);
+				if (kChunkVertexBuffer32 == chunk)
+				{
+					read(_reader, group.m_numVertices);
+				}
+				else
+				{
+					uint16_t numVertices;
+					read(_reader, numVertices);
+					group.m_numVertices = numVertices;
+				}
+
 				const bgfx::Memory* mem = bgfx::alloc(group.m_numVertices*stride);
 				read(_reader, mem->data, mem->size);
 
@@ -424,6 +488,7 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 				break;
 
 			case kChunkVertexBufferCompressed:
+			case kChunkVertexBufferCompressed32:
 			{
 				read(_reader, group.m_sphere);
 				read(_reader, group.m_aabb);
@@ -433,7 +498,16 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 
 				uint16_t stride = m_layout.getStride();
 
-				read(_reader, group.m_numVertices);
+				if (kChunkVertexBufferCompressed32 == chunk)
+				{
+					read(_reader, group.m_numVertices);
+				}
+				else
+				{
+					uint16_t numVertices;
+					read(_reader, numVertices);
+					group.m_numVertices = numVertices;
+				}
 
 				const bgfx::Memory* mem = bgfx::alloc(group.m_numVertices*stride);
 
@@ -458,45 +532,86 @@ void Mesh::load(bx::ReaderSeekerI* _reader, bool _ramcopy)
 				break;
 
 			case kChunkIndexBuffer:
+			case kChunkIndexBufferCompressed:
+			case kChunkIndexBuffer32:
+			case kChunkIndexBufferCompressed32:
 			{
+				group.m_index32 = kChunkIndexBuffer32 == chunk || kChunkIndexBufferCompressed32 == chunk;
+				const bool compressed = kChunkIndexBufferCompressed == chunk || kChunkIndexBufferCompressed32 == chunk;
+
 				read(_reader, group.m_numIndices);
-				const bgfx::Memory* mem = bgfx::alloc(group.m_numIndices*2);
-				read(_reader, mem->data, mem->size);
+				const bgfx::Memory* mem = readIndices(_reader, group.m_numIndices, group.m_index32, compressed);
 
 				if (_ramcopy)
 				{
-					group.m_indices = (uint16_t*)BX_ALLOC(allocator, group.m_numIndices*2);
-					bx::memCopy(group.m_indices, mem->data, mem->size);
+					void* indices = BX_ALLOC(allocator, mem->size);
+					bx::memCopy(indices, mem->data, mem->size);
+
+					if (group.m_index32)
+					{
+						group.m_indices32 = (uint32_t*)indices;
+					}
+					else
+					{
+						group.m_indices = (uint16_t*)indices;
+					}
 				}
 
-				group.m_ibh = bgfx::createIndexBuffer(mem);
+				group.m_ibh = bgfx::createIndexBuffer(mem, group.m_index32 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE);
 			}
 				break;
 
-			case kChunkIndexBufferCompressed:
+			case kChunkMeshlet:
 			{
-				bx::read(_reader, group.m_numIndices);
+				uint32_t numMeshlets;
+				read(_reader, numMeshlets);
 
-				const bgfx::Memory* mem = bgfx::alloc(group.m_numIndices*2);
+				group.m_meshlets.resize(numMeshlets);
 
-				uint32_t compressedSize;
-				bx::read(_reader, compressedSize);
+				for (uint32_t ii = 0; ii < numMeshlets; ++ii)
+				{
+					Meshlet& meshlet = group.m_meshlets[ii];
+					read(_reader, meshlet.m_vertexOffset);
+					read(_reader, meshlet.m_triangleOffset);
+					read(_reader, meshlet.m_numVertices);
+					read(_reader, meshlet.m_numTriangles);
+					read(_reader, meshlet.m_sphere);
+					read(_reader, meshlet.m_coneApex, sizeof(meshlet.m_coneApex) );
+					read(_reader, meshlet.m_coneAxis, sizeof(meshlet.m_coneAxis) );
+					read(_reader, meshlet.m_coneCutoff);
+				}
 
-				void* compressedIndices = BX_ALLOC(allocator, compressedSize);
+				uint32_t numVertices;
+				read(_reader, numVertices);
+				group.m_meshletVertices = (uint32_t*)BX_ALLOC(allocator, numVertices*sizeof(uint32_t) );
+				read(_reader, group.m_meshletVertices, numVertices*sizeof(uint32_t) );
 
-				bx::read(_reader, compressedIndices, compressedSize);
+				uint32_t numTriangleBytes;
+				read(_reader, numTriangleBytes);
+				group.m_meshletTriangles = (uint8_t*)BX_ALLOC(allocator, numTriangleBytes);
+				read(_reader, group.m_meshletTriangles, numTriangleBytes);
+			}
+				break;
 
-				meshopt_decodeIndexBuffer(mem->data, group.m_numIndices, 2, (uint8_t*)compressedIndices, compressedSize);
+			case kChunkLod:
+			{
+				uint8_t compressed;
+				read(_reader, compressed);
 
-				BX_FREE(allocator, compressedIndices);
+				uint16_t num;
+				read(_reader, num);
 
-				if (_ramcopy)
+				for (uint32_t ii = 0; ii < num; ++ii)
 				{
-					group.m_indices = (uint16_t*)BX_ALLOC(allocator, group.m_numIndices*2);
-					bx::memCopy(group.m_indices, mem->data, mem->size);
-				}
+					Lod lod;
+					read(_reader, lod.m_error);
+					read(_reader, lod.m_numIndices);
+
+					const bgfx::Memory* mem = readIndices(_reader, lod.m_numIndices, group.m_index32, 0 != compressed);
+					lod.m_ibh = bgfx::createIndexBuffer(mem, group.m_index32 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE);
 
-				group.m_ibh = bgfx::createIndexBuffer(mem);
+					group.m_lods.push_back(lod);
+				}
 			}
 				break;
 
@@ -567,11 +682,31 @@ void Mesh::unload()
 		{
 			BX_FREE(allocator, group.m_indices);
 		}
+
+		if (NULL != group.m_indices32)
+		{
+			BX_FREE(allocator, group.m_indices32);
+		}
+
+		if (NULL != group.m_meshletVertices)
+		{
+			BX_FREE(allocator, group.m_meshletVertices);
+		}
+
+		if (NULL != group.m_meshletTriangles)
+		{
+			BX_FREE(allocator, group.m_meshletTriangles);
+		}
+
+		for (LodArray::const_iterator lodIt = group.m_lods.begin(), lodItEnd = group.m_lods.end(); lodIt != lodItEnd; ++lodIt)
+		{
+			bgfx::destroy(lodIt->m_ibh);
+		}
 	}
 	m_groups.clear();
 }
 
-void Mesh::submit(bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state) const
+void Mesh::submit(bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state, uint8_t _lod) const
 {
 	if (BGFX_STATE_MASK == _state)
 	{
@@ -592,13 +727,13 @@ void Mesh::submit(bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _
 	{
 		const Group& group = *it;
 
-		bgfx::setIndexBuffer(group.m_ibh);
+		bgfx::setIndexBuffer(group.getIndexBuffer(_lod) );
 		bgfx::setVertexBuffer(0, group.m_vbh);
 		bgfx::submit(_id, _program, 0, (it == itEnd-1) ? (BGFX_DISCARD_INDEX_BUFFER | BGFX_DISCARD_VERTEX_STREAMS | BGFX_DISCARD_STATE) : BGFX_DISCARD_NONE);
 	}
 }
 
-void Mesh::submit(const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices) const
+void Mesh::submit(const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices, uint8_t _lod) const
 {
 	uint32_t cached = bgfx::setTransform(_mtx, _numMatrices);
 
@@ -624,7 +759,7 @@ void Mesh::submit(const MeshState*const* _state, uint8_t _numPasses, const float
 		{
 			const Group& group = *it;
 
-			bgfx::setIndexBuffer(group.m_ibh);
+			bgfx::setIndexBuffer(group.getIndexBuffer(_lod) );
 			bgfx::setVertexBuffer(0, group.m_vbh);
 			bgfx::submit(
 				  state.m_viewId
@@ -673,14 +808,14 @@ void meshStateDestroy(MeshState* _meshState)
 	BX_FREE(entry::getAllocator(), _meshState);
 }
 
-void meshSubmit(const Mesh* _mesh, bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state)
+void meshSubmit(const Mesh* _mesh, bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state, uint8_t _lod)
 {
-	_mesh->submit(_id, _program, _mtx, _state);
+	_mesh->submit(_id, _program, _mtx, _state, _lod);
 }
 
-void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices)
+void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices, uint8_t _lod)
 {
-	_mesh->submit(_state, _numPasses, _mtx, _numMatrices);
+	_mesh->submit(_state, _numPasses, _mtx, _numMatrices, _lod);
 }
 
 struct RendererTypeRemap
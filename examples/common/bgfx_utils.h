@@ -99,21 +99,53 @@ struct Primitive
 
 typedef stl::vector<Primitive> PrimitiveArray;
 
+struct Meshlet
+{
+	uint32_t m_vertexOffset;   //!< Offset into Group::m_meshletVertices.
+	uint32_t m_triangleOffset; //!< Offset into Group::m_meshletTriangles.
+	uint32_t m_numVertices;
+	uint32_t m_numTriangles;
+
+	Sphere m_sphere;
+	float  m_coneApex[3];
+	float  m_coneAxis[3];
+	float  m_coneCutoff;       //!< Cosine of normal cone half angle.
+};
+
+typedef stl::vector<Meshlet> MeshletArray;
+
+struct Lod
+{
+	bgfx::IndexBufferHandle m_ibh;
+	uint32_t m_numIndices;
+	float    m_error;          //!< Absolute simplification error in mesh units.
+};
+
+typedef stl::vector<Lod> LodArray;
+
 struct Group
 {
 	Group();
 	void reset();
 
+	bgfx::IndexBufferHandle getIndexBuffer(uint8_t _lod) const;
+
 	bgfx::VertexBufferHandle m_vbh;
 	bgfx::IndexBufferHandle m_ibh;
-	uint16_t m_numVertices;
+	uint32_t m_numVertices;
 	uint8_t* m_vertices;
 	uint32_t m_numIndices;
 	uint16_t* m_indices;
+	uint32_t* m_indices32;     //!< RAM copy of indices when group uses 32-bit indices.
+	bool m_index32;
 	Sphere m_sphere;
 	Aabb m_aabb;
 	Obb m_obb;
 	PrimitiveArray m_prims;
+	MeshletArray m_meshlets;
+	uint32_t* m_meshletVertices;
+	uint8_t* m_meshletTriangles;
+	LodArray m_lods;
 };
 typedef stl::vector<Group> GroupArray;
 
@@ -121,8 +153,8 @@ struct Mesh
 {
 	void load(bx::ReaderSeekerI* _reader, bool _ramcopy);
 	void unload();
-	void submit(bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state) const;
-	void submit(const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices) const;
+	void submit(bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state, uint8_t _lod = 0) const;
+	void submit(const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices, uint8_t _lod = 0) const;
 
 	bgfx::VertexLayout m_layout;
 	GroupArray m_groups;
@@ -141,10 +173,10 @@ MeshState* meshStateCreate();
 void meshStateDestroy(MeshState* _meshState);
 
 ///
-void meshSubmit(const Mesh* _mesh, bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state = BGFX_STATE_MASK);
+void meshSubmit(const Mesh* _mesh, bgfx::ViewId _id, bgfx::ProgramHandle _program, const float* _mtx, uint64_t _state = BGFX_STATE_MASK, uint8_t _lod = 0);
 
 ///
-void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices = 1);
+void meshSubmit(const Mesh* _mesh, const MeshState*const* _state, uint8_t _numPasses, const float* _mtx, uint16_t _numMatrices = 1, uint8_t _lod = 0);
 
 /// bgfx::RendererType::Enum to name.
 bx::StringView getName(bgfx::RendererType::Enum _type);
@@ -315,6 +315,8 @@ Atlas::~Atlas()
 
 void Atlas::init()
 {
+	bx::memSet(m_dirty, 0, sizeof(m_dirty) );
+
 	m_texelSize = float(UINT16_MAX) / float(m_textureSize);
 	float texelHalf = m_texelSize/2.0f;
 	switch (bgfx::getRendererType() )
@@ -393,7 +395,10 @@ uint16_t Atlas::addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bit
 	region.height = _height;
 	region.mask = m_layers[idx].faceRegion.mask;
 
-	updateRegion(region, _bitmapBuffer);
+	if (NULL != _bitmapBuffer)
+	{
+		updateRegion(region, _bitmapBuffer);
+	}
 
 	region.x += outline;
 	region.y += outline;
@@ -405,11 +410,8 @@ uint16_t Atlas::addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bit
 
 void Atlas::updateRegion(const AtlasRegion& _region, const uint8_t* _bitmapBuffer)
 {
-	uint32_t size = _region.width * _region.height * 4;
-	if (0 < size)
+	if (0 < _region.width * _region.height)
 	{
-		const bgfx::Memory* mem = bgfx::alloc(size);
-		bx::memSet(mem->data, 0, mem->size);
 		if (_region.getType() == AtlasRegion::TYPE_BGRA8)
 		{
 			const uint8_t* inLineBuffer = _bitmapBuffer;
@@ -421,8 +423,6 @@ void Atlas::updateRegion(const AtlasRegion& _region, const uint8_t* _bitmapBuffe
 				inLineBuffer += _region.width * 4;
 				outLineBuffer += m_textureSize * 4;
 			}
-
-			bx::memCopy(mem->data, _bitmapBuffer, mem->size);
 		}
 		else
 		{
@@ -437,13 +437,65 @@ void Atlas::updateRegion(const AtlasRegion& _region, const uint8_t* _bitmapBuffe
 					outLineBuffer[(xx * 4) + layer] = inLineBuffer[xx];
 				}
 
-				bx::memCopy(mem->data + yy * _region.width * 4, outLineBuffer, _region.width * 4);
 				inLineBuffer += _region.width;
 				outLineBuffer += m_textureSize * 4;
 			}
 		}
 
-		bgfx::updateTextureCube(m_textureHandle, 0, (uint8_t)_region.getFaceIndex(), 0, _region.x, _region.y, _region.width, _region.height, mem);
+		// Texture is uploaded from the mirrored buffer in update(), so that many regions added in
+		// the same frame result in a single texture update per face.
+		AtlasRegion& dirty = m_dirty[_region.getFaceIndex()];
+
+		if (0 == dirty.width)
+		{
+			dirty.x      = _region.x;
+			dirty.y      = _region.y;
+			dirty.width  = _region.width;
+			dirty.height = _region.height;
+		}
+		else
+		{
+			const uint16_t x0 = bx::min(dirty.x, _region.x);
+			const uint16_t y0 = bx::min(dirty.y, _region.y);
+			const uint16_t x1 = bx::max<uint16_t>(dirty.x + dirty.width,  _region.x + _region.width);
+			const uint16_t y1 = bx::max<uint16_t>(dirty.y + dirty.height, _region.y + _region.height);
+
+			dirty.x      = x0;
+			dirty.y      = y0;
+			dirty.width  = x1 - x0;
+			dirty.height = y1 - y0;
+		}
+	}
+}
+
+void Atlas::update()
+{
+	for (uint32_t face = 0; face < 6; ++face)
+	{
+		AtlasRegion& dirty = m_dirty[face];
+
+		if (0 == dirty.width)
+		{
+			continue;
+		}
+
+		const uint32_t pitch = dirty.width * 4;
+		const bgfx::Memory* mem = bgfx::alloc(pitch * dirty.height);
+
+		const uint8_t* inLineBuffer = m_textureBuffer + face * (m_textureSize * m_textureSize * 4) + ( ( (dirty.y * m_textureSize) + dirty.x) * 4);
+		uint8_t* outLineBuffer = mem->data;
+
+		for (int yy = 0; yy < dirty.height; ++yy)
+		{
+			bx::memCopy(outLineBuffer, inLineBuffer, pitch);
+			inLineBuffer += m_textureSize * 4;
+			outLineBuffer += pitch;
+		}
+
+		bgfx::updateTextureCube(m_textureHandle, 0, (uint8_t)face, 0, dirty.x, dirty.y, dirty.width, dirty.height, mem);
+
+		dirty.width  = 0;
+		dirty.height = 0;
 	}
 }
 
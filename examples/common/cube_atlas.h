@@ -68,11 +68,17 @@ public:
 	~Atlas();
 
 	/// add a region to the atlas, and copy the content of mem to the underlying texture
+	/// @remark when _bitmapBuffer is NULL region is only reserved and stays blank until updateRegion
 	uint16_t addRegion(uint16_t _width, uint16_t _height, const uint8_t* _bitmapBuffer, AtlasRegion::Type _type = AtlasRegion::TYPE_BGRA8, uint16_t outline = 0);
 
 	/// update a preallocated region
+	/// @remark texture is not updated until next call to update()
 	void updateRegion(const AtlasRegion& _region, const uint8_t* _bitmapBuffer);
 
+	/// upload regions added or updated since the last call, with one texture update per modified face
+	/// @remark call once per frame before submitting anything that samples the atlas
+	void update();
+
 	/// Pack the UV coordinates of the four corners of a region to a vertex buffer using the supplied vertex format.
 	/// v0 -- v3
 	/// |     |     encoded in that order:  v0,v1,v2,v3
@@ -142,6 +148,9 @@ private:
 	AtlasRegion* m_regions;
 	uint8_t* m_textureBuffer;
 
+	// bounding rectangle of modified texels per face, empty when width is 0
+	AtlasRegion m_dirty[6];
+
 	uint32_t m_usedLayers;
 	uint32_t m_usedFaces;
 
@@ -4,6 +4,9 @@
  */
 
 #include <bx/bx.h>
+#include <bx/mutex.h>
+#include <bx/semaphore.h>
+#include <bx/thread.h>
 #include <stb/stb_truetype.h>
 #include "../common.h"
 #include <bgfx/bgfx.h>
@@ -19,6 +22,7 @@ BX_PRAGMA_DIAGNOSTIC_POP()
 
 #include <tinystl/allocator.h>
 #include <tinystl/unordered_map.h>
+#include <tinystl/vector.h>
 namespace stl = tinystl;
 
 #include "font_manager.h"
@@ -49,6 +53,13 @@ public:
 	/// @ remark buffer min size: glyphInfo.m_width * glyphInfo * height * sizeof(char)
 	bool bakeGlyphDistance(CodePoint _codePoint, GlyphInfo& _outGlyphInfo, uint8_t* _outBuffer);
 
+	/// return the buffer size needed to raster a glyph with bakeGlyphAlpha or bakeGlyphDistance
+	uint32_t getGlyphBufferSize(CodePoint _codePoint, bool _distance);
+
+	/// fill the GlyphInfo the same way bakeGlyphAlpha or bakeGlyphDistance would, without
+	/// rasterizing the glyph
+	void getGlyphInfo(CodePoint _codePoint, bool _distance, GlyphInfo& _outGlyphInfo);
+
 private:
 	friend class FontManager;
 
@@ -207,6 +218,268 @@ bool TrueTypeFont::bakeGlyphDistance(CodePoint _codePoint, GlyphInfo& _glyphInfo
 	return true;
 }
 
+uint32_t TrueTypeFont::getGlyphBufferSize(CodePoint _codePoint, bool _distance)
+{
+	BX_ASSERT(m_font != NULL, "TrueTypeFont not initialized");
+
+	int32_t x0, y0, x1, y1;
+	stbtt_GetCodepointBitmapBox(&m_font, _codePoint, m_scale, m_scale, &x0, &y0, &x1, &y1);
+
+	const uint32_t ww = x1-x0;
+	const uint32_t hh = y1-y0;
+
+	if (_distance
+	&&  ww * hh > 0)
+	{
+		return (ww + m_widthPadding * 2) * (hh + m_heightPadding * 2);
+	}
+
+	return ww * hh;
+}
+
+void TrueTypeFont::getGlyphInfo(CodePoint _codePoint, bool _distance, GlyphInfo& _glyphInfo)
+{
+	BX_ASSERT(m_font != NULL, "TrueTypeFont not initialized");
+
+	int32_t ascent, descent, lineGap;
+	stbtt_GetFontVMetrics(&m_font, &ascent, &descent, &lineGap);
+
+	int32_t advance, lsb;
+	stbtt_GetCodepointHMetrics(&m_font, _codePoint, &advance, &lsb);
+
+	const float scale = m_scale;
+	int32_t x0, y0, x1, y1;
+	stbtt_GetCodepointBitmapBox(&m_font, _codePoint, scale, scale, &x0, &y0, &x1, &y1);
+
+	const int32_t ww = x1-x0;
+	const int32_t hh = y1-y0;
+
+	_glyphInfo.offset_x  = (float)x0;
+	_glyphInfo.offset_y  = (float)y0;
+	_glyphInfo.width     = (float)ww;
+	_glyphInfo.height    = (float)hh;
+	_glyphInfo.advance_x = bx::round(((float)advance) * scale);
+	_glyphInfo.advance_y = bx::round(((float)(ascent + descent + lineGap)) * scale);
+
+	if (_distance
+	&&  ww * hh > 0)
+	{
+		_glyphInfo.offset_x -= (float)m_widthPadding;
+		_glyphInfo.offset_y -= (float)m_heightPadding;
+		_glyphInfo.width  = (float)(ww + m_widthPadding * 2);
+		_glyphInfo.height = (float)(hh + m_heightPadding * 2);
+	}
+}
+
+static void bakeGlyph(TrueTypeFont* _font, uint32_t _fontType, CodePoint _codePoint, GlyphInfo& _glyphInfo, uint8_t* _outBuffer)
+{
+	switch (_fontType)
+	{
+	case FONT_TYPE_ALPHA:
+		_font->bakeGlyphAlpha(_codePoint, _glyphInfo, _outBuffer);
+		break;
+
+	case FONT_TYPE_DISTANCE:
+		_font->bakeGlyphDistance(_codePoint, _glyphInfo, _outBuffer);
+		break;
+
+	case FONT_TYPE_DISTANCE_SUBPIXEL:
+		_font->bakeGlyphDistance(_codePoint, _glyphInfo, _outBuffer);
+		break;
+
+	case FONT_TYPE_DISTANCE_OUTLINE:
+	case FONT_TYPE_DISTANCE_OUTLINE_IMAGE:
+	case FONT_TYPE_DISTANCE_DROP_SHADOW:
+	case FONT_TYPE_DISTANCE_DROP_SHADOW_IMAGE:
+	case FONT_TYPE_DISTANCE_OUTLINE_DROP_SHADOW_IMAGE:
+		_font->bakeGlyphDistance(_codePoint, _glyphInfo, _outBuffer);
+		break;
+
+	default:
+		BX_ASSERT(false, "TextureType not supported yet");
+	}
+}
+
+#define GLYPH_BAKE_THREADS 2
+
+struct GlyphBakeJob
+{
+	TrueTypeFont* font;
+	uint32_t      fontType;
+	CodePoint     codePoint;
+	uint16_t      regionIndex;
+	uint8_t*      buffer;
+};
+
+// Glyph metrics and atlas region are known before glyph is rasterized, so glyph can be used for
+// text layout right away. Its region stays blank until glyph is rasterized on one of the worker
+// threads, and copied into atlas by FontManager::update.
+class GlyphBaker
+{
+public:
+	GlyphBaker();
+	~GlyphBaker();
+
+	/// Queue glyph to be rasterized into atlas region.
+	void push(TrueTypeFont* _font, uint32_t _fontType, CodePoint _codePoint, uint16_t _regionIndex);
+
+	/// Copy rasterized glyphs into atlas.
+	void collect(Atlas* _atlas);
+
+	/// Wait for all queued glyphs, and copy them into atlas.
+	void wait(Atlas* _atlas);
+
+private:
+	static void bake(GlyphBakeJob& _job);
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	static int32_t threadFunc(bx::Thread* _self, void* _userData);
+
+	bx::Thread    m_thread[GLYPH_BAKE_THREADS];
+	bx::Semaphore m_workStart;
+	bx::Semaphore m_workDone;
+	bool          m_exit;
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	bx::Mutex m_mutex;
+	stl::vector<GlyphBakeJob> m_queue;
+	stl::vector<GlyphBakeJob> m_done;
+	uint32_t m_queueRead;
+	uint32_t m_numPending;
+};
+
+GlyphBaker::GlyphBaker()
+	: m_queueRead(0)
+	, m_numPending(0)
+{
+#if BX_CONFIG_SUPPORTS_THREADING
+	m_exit = false;
+
+	for (uint32_t ii = 0; ii < GLYPH_BAKE_THREADS; ++ii)
+	{
+		m_thread[ii].init(threadFunc, this, 0, "font - bake glyphs");
+	}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+}
+
+GlyphBaker::~GlyphBaker()
+{
+	BX_ASSERT(0 == m_numPending, "All the glyphs must be baked before destroying the baker");
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	m_exit = true;
+	m_workStart.post(GLYPH_BAKE_THREADS);
+
+	for (uint32_t ii = 0; ii < GLYPH_BAKE_THREADS; ++ii)
+	{
+		m_thread[ii].shutdown();
+	}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+}
+
+void GlyphBaker::push(TrueTypeFont* _font, uint32_t _fontType, CodePoint _codePoint, uint16_t _regionIndex)
+{
+	GlyphBakeJob job;
+	job.font        = _font;
+	job.fontType    = _fontType;
+	job.codePoint   = _codePoint;
+	job.regionIndex = _regionIndex;
+	job.buffer      = NULL;
+
+	++m_numPending;
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	{
+		bx::MutexScope lock(m_mutex);
+		m_queue.push_back(job);
+	}
+
+	m_workStart.post();
+#else
+	bake(job);
+	m_done.push_back(job);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+}
+
+void GlyphBaker::collect(Atlas* _atlas)
+{
+	bx::MutexScope lock(m_mutex);
+
+	for (uint32_t ii = 0, num = uint32_t(m_done.size() ); ii < num; ++ii)
+	{
+		GlyphBakeJob& job = m_done[ii];
+		_atlas->updateRegion(_atlas->getRegion(job.regionIndex), job.buffer);
+		delete [] job.buffer;
+	}
+
+	m_numPending -= uint32_t(m_done.size() );
+	m_done.clear();
+}
+
+void GlyphBaker::wait(Atlas* _atlas)
+{
+	collect(_atlas);
+
+	while (0 != m_numPending)
+	{
+#if BX_CONFIG_SUPPORTS_THREADING
+		m_workDone.wait();
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+		collect(_atlas);
+	}
+}
+
+void GlyphBaker::bake(GlyphBakeJob& _job)
+{
+	const bool distance = FONT_TYPE_ALPHA != _job.fontType;
+	_job.buffer = new uint8_t[_job.font->getGlyphBufferSize(_job.codePoint, distance)];
+
+	GlyphInfo glyphInfo;
+	bakeGlyph(_job.font, _job.fontType, _job.codePoint, glyphInfo, _job.buffer);
+}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+int32_t GlyphBaker::threadFunc(bx::Thread* /*_self*/, void* _userData)
+{
+	GlyphBaker* baker = (GlyphBaker*)_userData;
+
+	for (;;)
+	{
+		baker->m_workStart.wait();
+
+		if (baker->m_exit)
+		{
+			break;
+		}
+
+		// Each post of m_workStart matches one queued job.
+		GlyphBakeJob job;
+		{
+			bx::MutexScope lock(baker->m_mutex);
+			job = baker->m_queue[baker->m_queueRead++];
+
+			if (baker->m_queueRead == baker->m_queue.size() )
+			{
+				baker->m_queue.clear();
+				baker->m_queueRead = 0;
+			}
+		}
+
+		bake(job);
+
+		{
+			bx::MutexScope lock(baker->m_mutex);
+			baker->m_done.push_back(job);
+		}
+
+		baker->m_workDone.post();
+	}
+
+	return bx::kExitSuccess;
+}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
 typedef stl::unordered_map<CodePoint, GlyphInfo> GlyphHashMap;
 
 // cache font data
@@ -247,6 +520,7 @@ void FontManager::init()
 	m_cachedFiles = new CachedFile[MAX_OPENED_FILES];
 	m_cachedFonts = new CachedFont[MAX_OPENED_FONT];
 	m_buffer = new uint8_t[MAX_FONT_BUFFER_SIZE];
+	m_glyphBaker = new GlyphBaker;
 
 	const uint32_t W = 3;
 	// Create filler rectangle
@@ -262,6 +536,9 @@ void FontManager::init()
 
 FontManager::~FontManager()
 {
+	m_glyphBaker->wait(m_atlas);
+	delete m_glyphBaker;
+
 	BX_ASSERT(m_fontHandles.getNumHandles() == 0, "All the fonts must be destroyed before destroying the manager");
 	delete [] m_cachedFonts;
 
@@ -291,6 +568,10 @@ TrueTypeHandle FontManager::createTtf(const uint8_t* _buffer, uint32_t _size)
 void FontManager::destroyTtf(TrueTypeHandle _handle)
 {
 	BX_ASSERT(bgfx::isValid(_handle), "Invalid handle used");
+
+	// Queued glyphs read font data.
+	m_glyphBaker->wait(m_atlas);
+
 	delete m_cachedFiles[_handle.idx].buffer;
 	m_cachedFiles[_handle.idx].bufferSize = 0;
 	m_cachedFiles[_handle.idx].buffer = NULL;
@@ -362,6 +643,7 @@ void FontManager::destroyFont(FontHandle _handle)
 
 	if (font.trueTypeFont != NULL)
 	{
+		m_glyphBaker->wait(m_atlas);
 		delete font.trueTypeFont;
 		font.trueTypeFont = NULL;
 	}
@@ -407,46 +689,21 @@ bool FontManager::preloadGlyph(FontHandle _handle, CodePoint _codePoint)
 	if (NULL != font.trueTypeFont)
 	{
 		GlyphInfo glyphInfo;
+		font.trueTypeFont->getGlyphInfo(_codePoint, FONT_TYPE_ALPHA != fontInfo.fontType, glyphInfo);
 
-		switch (font.fontInfo.fontType)
-		{
-		case FONT_TYPE_ALPHA:
-			font.trueTypeFont->bakeGlyphAlpha(_codePoint, glyphInfo, m_buffer);
-			break;
-
-		case FONT_TYPE_DISTANCE:
-			font.trueTypeFont->bakeGlyphDistance(_codePoint, glyphInfo, m_buffer);
-			break;
+		const bool empty = 0.0f == glyphInfo.width * glyphInfo.height;
 
-		case FONT_TYPE_DISTANCE_SUBPIXEL:
-			font.trueTypeFont->bakeGlyphDistance(_codePoint, glyphInfo, m_buffer);
-			break;
-
-		case FONT_TYPE_DISTANCE_OUTLINE:
-		case FONT_TYPE_DISTANCE_OUTLINE_IMAGE:
-		case FONT_TYPE_DISTANCE_DROP_SHADOW:
-		case FONT_TYPE_DISTANCE_DROP_SHADOW_IMAGE:
-		case FONT_TYPE_DISTANCE_OUTLINE_DROP_SHADOW_IMAGE:
-			font.trueTypeFont->bakeGlyphDistance(_codePoint, glyphInfo, m_buffer);
-			break;
-
-		default:
-			BX_ASSERT(false, "TextureType not supported yet");
-		}
-
-		if (!addBitmap(glyphInfo, m_buffer) )
+		if (!addGlyph(font, _codePoint, glyphInfo, NULL) )
 		{
 			return false;
 		}
 
-		glyphInfo.advance_x = (glyphInfo.advance_x * fontInfo.scale);
-		glyphInfo.advance_y = (glyphInfo.advance_y * fontInfo.scale);
-		glyphInfo.offset_x = (glyphInfo.offset_x * fontInfo.scale);
-		glyphInfo.offset_y = (glyphInfo.offset_y * fontInfo.scale);
-		glyphInfo.height = (glyphInfo.height * fontInfo.scale);
-		glyphInfo.width = (glyphInfo.width * fontInfo.scale);
+		if (!empty
+		&&  UINT16_MAX != glyphInfo.regionIndex)
+		{
+			m_glyphBaker->push(font.trueTypeFont, fontInfo.fontType, _codePoint, glyphInfo.regionIndex);
+		}
 
-		font.cachedGlyphs[_codePoint] = glyphInfo;
 		return true;
 	}
 
@@ -556,6 +813,31 @@ const GlyphInfo* FontManager::getGlyphInfo(FontHandle _handle, CodePoint _codePo
 	return &it->second;
 }
 
+bool FontManager::addGlyph(CachedFont& _font, CodePoint _codePoint, GlyphInfo& _glyphInfo, const uint8_t* _data)
+{
+	if (!addBitmap(_glyphInfo, _data) )
+	{
+		return false;
+	}
+
+	const FontInfo& fontInfo = _font.fontInfo;
+	_glyphInfo.advance_x = (_glyphInfo.advance_x * fontInfo.scale);
+	_glyphInfo.advance_y = (_glyphInfo.advance_y * fontInfo.scale);
+	_glyphInfo.offset_x = (_glyphInfo.offset_x * fontInfo.scale);
+	_glyphInfo.offset_y = (_glyphInfo.offset_y * fontInfo.scale);
+	_glyphInfo.height = (_glyphInfo.height * fontInfo.scale);
+	_glyphInfo.width = (_glyphInfo.width * fontInfo.scale);
+
+	_font.cachedGlyphs[_codePoint] = _glyphInfo;
+	return true;
+}
+
+void FontManager::update()
+{
+	m_glyphBaker->collect(m_atlas);
+	m_atlas->update();
+}
+
 bool FontManager::addBitmap(GlyphInfo& _glyphInfo, const uint8_t* _data)
 {
 	_glyphInfo.regionIndex = m_atlas->addRegion(
@@ -11,6 +11,7 @@
 #include <bgfx/bgfx.h>
 
 class Atlas;
+class GlyphBaker;
 
 #define MAX_OPENED_FILES 64
 #define MAX_OPENED_FONT  64
@@ -172,6 +173,10 @@ public:
 	bool preloadGlyph(FontHandle _handle, const wchar_t* _string);
 
 	/// Preload a single glyph, return true on success.
+	///
+	/// @remarks Glyph metrics and atlas region are available right away,
+	///   but glyph is rasterized on worker thread. Its region stays blank
+	///   until update() after rasterization is done.
 	bool preloadGlyph(FontHandle _handle, CodePoint _character);
 
 	bool addGlyphBitmap(FontHandle _handle, CodePoint _character, uint16_t _width, uint16_t height, uint16_t _pitch, float extraScale, const uint8_t* _bitmapBuffer, float glyphOffsetX, float glyphOffsetY);
@@ -193,6 +198,11 @@ public:
 		return m_blackGlyph;
 	}
 
+	/// Copy glyphs rasterized on worker threads into the atlas, and upload
+	/// glyphs added since the last call to the atlas texture. Called by
+	/// TextBufferManager before submitting text.
+	void update();
+
 private:
 	struct CachedFont;
 	struct CachedFile
@@ -203,6 +213,7 @@ private:
 
 	void init();
 	bool addBitmap(GlyphInfo& _glyphInfo, const uint8_t* _data);
+	bool addGlyph(CachedFont& _font, CodePoint _codePoint, GlyphInfo& _glyphInfo, const uint8_t* _data);
 
 	bool m_ownAtlas;
 	Atlas* m_atlas;
@@ -217,6 +228,8 @@ private:
 
 	//temporary buffer to raster glyph
 	uint8_t* m_buffer;
+
+	GlyphBaker* m_glyphBaker;
 };
 
 #endif // FONT_MANAGER_H_HEADER_GUARD
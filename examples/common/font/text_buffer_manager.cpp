@@ -972,6 +972,8 @@ void TextBufferManager::submitTextBuffer(TextBufferHandle _handle, bgfx::ViewId
 {
 	BX_ASSERT(bgfx::isValid(_handle), "Invalid handle used");
 
+	m_fontManager->update();
+
 	BufferCache& bc = m_textBuffers[_handle.idx];
 
 	uint32_t indexSize  = bc.textBuffer->getIndexCount()  * bc.textBuffer->getIndexSize();
@@ -10,8 +10,13 @@
 #include "../bgfx_utils.h"
 #include "../packrect.h"
 
+#include <bx/cpu.h>
 #include <bx/easing.h>
 #include <bx/handlealloc.h>
+#include <bx/semaphore.h>
+#include <bx/simd_t.h>
+#include <bx/sort.h>
+#include <bx/thread.h>
 
 #include "vs_particle.bin.h"
 #include "fs_particle.bin.h"
@@ -96,25 +101,30 @@ void EmitterUniforms::reset()
 
 namespace ps
 {
-	struct Particle
+	// Particles are stored as structure of arrays, so that update and render can process four
+	// particles at once with SIMD.
+	struct ParticleStream
 	{
-		bx::Vec3 start;
-		bx::Vec3 end[2];
-		float blendStart;
-		float blendEnd;
-		float scaleStart;
-		float scaleEnd;
-
-		uint32_t rgba[5];
-
-		float life;
-		float lifeSpan;
-	};
-
-	struct ParticleSort
-	{
-		float    dist;
-		uint32_t idx;
+		enum Enum
+		{
+			StartX,
+			StartY,
+			StartZ,
+			End0X,
+			End0Y,
+			End0Z,
+			End1X,
+			End1Y,
+			End1Z,
+			BlendStart,
+			BlendEnd,
+			ScaleStart,
+			ScaleEnd,
+			Life,
+			LifeSpan,
+
+			Count
+		};
 	};
 
 	inline uint32_t toAbgr(const float* _rgba)
@@ -137,6 +147,11 @@ namespace ps
 			;
 	}
 
+	inline bx::simd128_t simdLerp(bx::simd128_t _a, bx::simd128_t _b, bx::simd128_t _t)
+	{
+		return bx::simd_add(_a, bx::simd_mul(bx::simd_sub(_b, _a), _t) );
+	}
+
 #define SPRITE_TEXTURE_SIZE 1024
 	template<uint16_t MaxHandlesT = 256, uint16_t TextureSizeT = 1024>
 	struct SpriteT
@@ -195,23 +210,55 @@ namespace ps
 			m_rng.reset();
 		}
 
+		void copyParticle(uint32_t _dst, uint32_t _src)
+		{
+			for (uint32_t ii = 0; ii < ParticleStream::Count; ++ii)
+			{
+				m_stream[ii][_dst] = m_stream[ii][_src];
+			}
+
+			bx::memCopy(&m_rgba[_dst*5], &m_rgba[_src*5], 5*sizeof(uint32_t) );
+		}
+
+		// Advances life of particles in range [_begin, _begin+_num), ranges of one emitter can be
+		// integrated in parallel. _begin must be multiple of four.
+		void integrate(float _dt, uint32_t _begin, uint32_t _num)
+		{
+			using namespace bx;
+
+			float*       life     = &m_stream[ParticleStream::Life    ][_begin];
+			const float* lifeSpan = &m_stream[ParticleStream::LifeSpan][_begin];
+
+			// Streams are padded to multiple of four particles.
+			const simd128_t dt = simd_splat(_dt);
+			for (uint32_t ii = 0; ii < _num; ii += 4)
+			{
+				const simd128_t tmp = simd_div(dt, simd_ld<simd128_t>(&lifeSpan[ii]) );
+				simd_st(&life[ii], simd_add(simd_ld<simd128_t>(&life[ii]), tmp) );
+			}
+		}
+
+		// Removes dead particles and spawns new ones, must be called after all ranges are
+		// integrated.
 		void update(float _dt)
 		{
+			const float* life = m_stream[ParticleStream::Life];
+
 			uint32_t num = m_num;
-			for (uint32_t ii = 0; ii < num; ++ii)
+			for (uint32_t ii = 0; ii < num;)
 			{
-				Particle& particle = m_particles[ii];
-				particle.life += _dt * 1.0f/particle.lifeSpan;
-
-				if (particle.life > 1.0f)
+				if (life[ii] > 1.0f)
 				{
-					if (ii != num-1)
+					--num;
+
+					if (ii != num)
 					{
-						bx::memCopy(&particle, &m_particles[num-1], sizeof(Particle) );
-						--ii;
+						copyParticle(ii, num);
 					}
-
-					--num;
+				}
+				else
+				{
+					++ii;
 				}
 			}
 
@@ -245,7 +292,7 @@ namespace ps
 				; ++ii
 				)
 			{
-				Particle& particle = m_particles[m_num];
+				const uint32_t idx = m_num;
 				m_num++;
 
 				bx::Vec3 pos;
@@ -301,121 +348,199 @@ namespace ps
 				const bx::Vec3 tmp1 = bx::mul(dir, endOffset);
 				const bx::Vec3 end  = bx::add(tmp1, start);
 
-				particle.life = time;
-				particle.lifeSpan = bx::lerp(m_uniforms.m_lifeSpan[0], m_uniforms.m_lifeSpan[1], bx::frnd(&m_rng) );
+				const float lifeSpan = bx::lerp(m_uniforms.m_lifeSpan[0], m_uniforms.m_lifeSpan[1], bx::frnd(&m_rng) );
+				m_stream[ParticleStream::Life    ][idx] = time;
+				m_stream[ParticleStream::LifeSpan][idx] = lifeSpan;
 
-				const bx::Vec3 gravity = { 0.0f, -9.81f * m_uniforms.m_gravityScale * bx::square(particle.lifeSpan), 0.0f };
+				const bx::Vec3 gravity = { 0.0f, -9.81f * m_uniforms.m_gravityScale * bx::square(lifeSpan), 0.0f };
 
-				particle.start  = bx::mul(start, mtx);
-				particle.end[0] = bx::mul(end,   mtx);
-				particle.end[1] = bx::add(particle.end[0], gravity);
+				const bx::Vec3 pstart = bx::mul(start, mtx);
+				const bx::Vec3 pend0  = bx::mul(end,   mtx);
+				const bx::Vec3 pend1  = bx::add(pend0, gravity);
 
-				bx::memCopy(particle.rgba, m_uniforms.m_rgba, BX_COUNTOF(m_uniforms.m_rgba)*sizeof(uint32_t) );
+				m_stream[ParticleStream::StartX][idx] = pstart.x;
+				m_stream[ParticleStream::StartY][idx] = pstart.y;
+				m_stream[ParticleStream::StartZ][idx] = pstart.z;
+				m_stream[ParticleStream::End0X ][idx] = pend0.x;
+				m_stream[ParticleStream::End0Y ][idx] = pend0.y;
+				m_stream[ParticleStream::End0Z ][idx] = pend0.z;
+				m_stream[ParticleStream::End1X ][idx] = pend1.x;
+				m_stream[ParticleStream::End1Y ][idx] = pend1.y;
+				m_stream[ParticleStream::End1Z ][idx] = pend1.z;
 
-				particle.blendStart = bx::lerp(m_uniforms.m_blendStart[0], m_uniforms.m_blendStart[1], bx::frnd(&m_rng) );
-				particle.blendEnd   = bx::lerp(m_uniforms.m_blendEnd[0],   m_uniforms.m_blendEnd[1],   bx::frnd(&m_rng) );
+				bx::memCopy(&m_rgba[idx*5], m_uniforms.m_rgba, BX_COUNTOF(m_uniforms.m_rgba)*sizeof(uint32_t) );
 
-				particle.scaleStart = bx::lerp(m_uniforms.m_scaleStart[0], m_uniforms.m_scaleStart[1], bx::frnd(&m_rng) );
-				particle.scaleEnd   = bx::lerp(m_uniforms.m_scaleEnd[0],   m_uniforms.m_scaleEnd[1],   bx::frnd(&m_rng) );
+				m_stream[ParticleStream::BlendStart][idx] = bx::lerp(m_uniforms.m_blendStart[0], m_uniforms.m_blendStart[1], bx::frnd(&m_rng) );
+				m_stream[ParticleStream::BlendEnd  ][idx] = bx::lerp(m_uniforms.m_blendEnd[0],   m_uniforms.m_blendEnd[1],   bx::frnd(&m_rng) );
+
+				m_stream[ParticleStream::ScaleStart][idx] = bx::lerp(m_uniforms.m_scaleStart[0], m_uniforms.m_scaleStart[1], bx::frnd(&m_rng) );
+				m_stream[ParticleStream::ScaleEnd  ][idx] = bx::lerp(m_uniforms.m_scaleEnd[0],   m_uniforms.m_scaleEnd[1],   bx::frnd(&m_rng) );
 
 				time += timePerParticle;
 			}
 		}
 
-		uint32_t render(const float _uv[4], const float* _mtxView, const bx::Vec3& _eye, uint32_t _first, uint32_t _max, ParticleSort* _outSort, PosColorTexCoord0Vertex* _outVertices)
+		// Renders particles in range [_begin, _begin+_num) into output slots starting at _first,
+		// four vertices per particle. _begin must be multiple of four.
+		void render(
+			  const float _uv[4]
+			, const float* _mtxView
+			, const bx::Vec3& _eye
+			, uint32_t _begin
+			, uint32_t _num
+			, uint32_t _first
+			, uint32_t* _outKeys
+			, uint32_t* _outValues
+			, PosColorTexCoord0Vertex* _outVertices
+			, Aabb& _outAabb
+			)
 		{
-			bx::EaseFn easeRgba  = bx::getEaseFunc(m_uniforms.m_easeRgba);
-			bx::EaseFn easePos   = bx::getEaseFunc(m_uniforms.m_easePos);
-			bx::EaseFn easeBlend = bx::getEaseFunc(m_uniforms.m_easeBlend);
-			bx::EaseFn easeScale = bx::getEaseFunc(m_uniforms.m_easeScale);
+			using namespace bx;
+
+			EaseFn easeRgba  = getEaseFunc(m_uniforms.m_easeRgba);
+			EaseFn easePos   = getEaseFunc(m_uniforms.m_easePos);
+			EaseFn easeBlend = getEaseFunc(m_uniforms.m_easeBlend);
+			EaseFn easeScale = getEaseFunc(m_uniforms.m_easeScale);
 
 			Aabb aabb =
 			{
-				{  bx::kInfinity,  bx::kInfinity,  bx::kInfinity },
-				{ -bx::kInfinity, -bx::kInfinity, -bx::kInfinity },
+				{  kInfinity,  kInfinity,  kInfinity },
+				{ -kInfinity, -kInfinity, -kInfinity },
 			};
 
-			for (uint32_t jj = 0, num = m_num, current = _first
-				; jj < num && current < _max
-				; ++jj, ++current
-				)
+			const simd128_t eye[3] =
 			{
-				const Particle& particle = m_particles[jj];
-
-				const float ttPos   = easePos(particle.life);
-				const float ttScale = easeScale(particle.life);
-				const float ttBlend = bx::clamp(easeBlend(particle.life), 0.0f, 1.0f);
-				const float ttRgba  = bx::clamp(easeRgba(particle.life),  0.0f, 1.0f);
-
-				const bx::Vec3 p0  = bx::lerp(particle.start,  particle.end[0], ttPos);
-				const bx::Vec3 p1  = bx::lerp(particle.end[0], particle.end[1], ttPos);
-				const bx::Vec3 pos = bx::lerp(p0, p1, ttPos);
-
-				ParticleSort& sort = _outSort[current];
-				const bx::Vec3 tmp0 = bx::sub(_eye, pos);
-				sort.dist = bx::length(tmp0);
-				sort.idx  = current;
-
-				uint32_t idx = uint32_t(ttRgba*4);
-				float ttmod = bx::mod(ttRgba, 0.25f)/0.25f;
-				uint32_t rgbaStart = particle.rgba[idx];
-				uint32_t rgbaEnd   = particle.rgba[idx+1];
-
-				float rr = bx::lerp( ( (uint8_t*)&rgbaStart)[0], ( (uint8_t*)&rgbaEnd)[0], ttmod)/255.0f;
-				float gg = bx::lerp( ( (uint8_t*)&rgbaStart)[1], ( (uint8_t*)&rgbaEnd)[1], ttmod)/255.0f;
-				float bb = bx::lerp( ( (uint8_t*)&rgbaStart)[2], ( (uint8_t*)&rgbaEnd)[2], ttmod)/255.0f;
-				float aa = bx::lerp( ( (uint8_t*)&rgbaStart)[3], ( (uint8_t*)&rgbaEnd)[3], ttmod)/255.0f;
-
-				float blend = bx::lerp(particle.blendStart, particle.blendEnd, ttBlend);
-				float scale = bx::lerp(particle.scaleStart, particle.scaleEnd, ttScale);
-
-				uint32_t abgr = toAbgr(rr, gg, bb, aa);
-
-				const bx::Vec3 udir = { _mtxView[0]*scale, _mtxView[4]*scale, _mtxView[8]*scale };
-				const bx::Vec3 vdir = { _mtxView[1]*scale, _mtxView[5]*scale, _mtxView[9]*scale };
-
-				PosColorTexCoord0Vertex* vertex = &_outVertices[current*4];
-
-				const bx::Vec3 ul = bx::sub(bx::sub(pos, udir), vdir);
-				bx::store(&vertex->m_x, ul);
-				aabbExpand(aabb, ul);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[0];
-				vertex->m_v     = _uv[1];
-				vertex->m_blend = blend;
-				++vertex;
-
-				const bx::Vec3 ur = bx::sub(bx::add(pos, udir), vdir);
-				bx::store(&vertex->m_x, ur);
-				aabbExpand(aabb, ur);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[2];
-				vertex->m_v     = _uv[1];
-				vertex->m_blend = blend;
-				++vertex;
-
-				const bx::Vec3 br = bx::add(bx::add(pos, udir), vdir);
-				bx::store(&vertex->m_x, br);
-				aabbExpand(aabb, br);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[2];
-				vertex->m_v     = _uv[3];
-				vertex->m_blend = blend;
-				++vertex;
-
-				const bx::Vec3 bl = bx::add(bx::sub(pos, udir), vdir);
-				bx::store(&vertex->m_x, bl);
-				aabbExpand(aabb, bl);
-				vertex->m_abgr  = abgr;
-				vertex->m_u     = _uv[0];
-				vertex->m_v     = _uv[3];
-				vertex->m_blend = blend;
-				++vertex;
-			}
+				simd_splat(_eye.x),
+				simd_splat(_eye.y),
+				simd_splat(_eye.z),
+			};
+
+			const float* life = &m_stream[ParticleStream::Life][_begin];
 
-			m_aabb = aabb;
+			for (uint32_t ii = 0; ii < _num; ii += 4)
+			{
+				// Easing functions are scalar, everything else is evaluated four particles at
+				// once. Lanes past the end operate on padding and are not written out.
+				BX_ALIGN_DECL_16(float tt[4][4]);
+
+				for (uint32_t lane = 0; lane < 4; ++lane)
+				{
+					const float particleLife = life[ii+lane];
+					tt[0][lane] = easePos(particleLife);
+					tt[1][lane] = easeScale(particleLife);
+					tt[2][lane] = clamp(easeBlend(particleLife), 0.0f, 1.0f);
+					tt[3][lane] = clamp(easeRgba(particleLife),  0.0f, 1.0f);
+				}
+
+				const simd128_t ttPos   = simd_ld<simd128_t>(tt[0]);
+				const simd128_t ttScale = simd_ld<simd128_t>(tt[1]);
+				const simd128_t ttBlend = simd_ld<simd128_t>(tt[2]);
+
+				BX_ALIGN_DECL_16(float out[6][4]);
+
+				simd128_t distSq = simd_zero();
+
+				for (uint32_t axis = 0; axis < 3; ++axis)
+				{
+					const simd128_t start = simd_ld<simd128_t>(&m_stream[ParticleStream::StartX+axis][_begin+ii]);
+					const simd128_t end0  = simd_ld<simd128_t>(&m_stream[ParticleStream::End0X +axis][_begin+ii]);
+					const simd128_t end1  = simd_ld<simd128_t>(&m_stream[ParticleStream::End1X +axis][_begin+ii]);
+
+					const simd128_t p0  = simdLerp(start, end0, ttPos);
+					const simd128_t p1  = simdLerp(end0,  end1, ttPos);
+					const simd128_t pos = simdLerp(p0,    p1,   ttPos);
+					simd_st(out[axis], pos);
+
+					const simd128_t tmp = simd_sub(eye[axis], pos);
+					distSq = simd_add(distSq, simd_mul(tmp, tmp) );
+				}
+
+				const simd128_t blend = simdLerp(
+					  simd_ld<simd128_t>(&m_stream[ParticleStream::BlendStart][_begin+ii])
+					, simd_ld<simd128_t>(&m_stream[ParticleStream::BlendEnd  ][_begin+ii])
+					, ttBlend
+					);
+				const simd128_t scale = simdLerp(
+					  simd_ld<simd128_t>(&m_stream[ParticleStream::ScaleStart][_begin+ii])
+					, simd_ld<simd128_t>(&m_stream[ParticleStream::ScaleEnd  ][_begin+ii])
+					, ttScale
+					);
 
-			return m_num;
+				simd_st(out[3], simd_sqrt(distSq) );
+				simd_st(out[4], blend);
+				simd_st(out[5], scale);
+
+				for (uint32_t lane = 0, numLanes = uint32_min(4, _num-ii); lane < numLanes; ++lane)
+				{
+					const uint32_t current = _first + ii + lane;
+
+					// Back to front.
+					_outKeys[current]   = floatFlip(floatToBits(out[3][lane]) ) ^ UINT32_MAX;
+					_outValues[current] = current;
+
+					const float ttRgba4 = tt[3][lane]*4.0f;
+					const uint32_t idx  = uint32_min(uint32_t(ttRgba4), 3);
+					const float ttmod   = ttRgba4 - float(idx);
+					const uint32_t* rgba = &m_rgba[(_begin+ii+lane)*5];
+					uint32_t rgbaStart = rgba[idx];
+					uint32_t rgbaEnd   = rgba[idx+1];
+
+					float rr = lerp( ( (uint8_t*)&rgbaStart)[0], ( (uint8_t*)&rgbaEnd)[0], ttmod)/255.0f;
+					float gg = lerp( ( (uint8_t*)&rgbaStart)[1], ( (uint8_t*)&rgbaEnd)[1], ttmod)/255.0f;
+					float bb = lerp( ( (uint8_t*)&rgbaStart)[2], ( (uint8_t*)&rgbaEnd)[2], ttmod)/255.0f;
+					float aa = lerp( ( (uint8_t*)&rgbaStart)[3], ( (uint8_t*)&rgbaEnd)[3], ttmod)/255.0f;
+
+					const float blendLane = out[4][lane];
+					const float scaleLane = out[5][lane];
+
+					const Vec3 pos = { out[0][lane], out[1][lane], out[2][lane] };
+
+					uint32_t abgr = toAbgr(rr, gg, bb, aa);
+
+					const Vec3 udir = { _mtxView[0]*scaleLane, _mtxView[4]*scaleLane, _mtxView[8]*scaleLane };
+					const Vec3 vdir = { _mtxView[1]*scaleLane, _mtxView[5]*scaleLane, _mtxView[9]*scaleLane };
+
+					PosColorTexCoord0Vertex* vertex = &_outVertices[current*4];
+
+					const Vec3 ul = sub(sub(pos, udir), vdir);
+					store(&vertex->m_x, ul);
+					aabbExpand(aabb, ul);
+					vertex->m_abgr  = abgr;
+					vertex->m_u     = _uv[0];
+					vertex->m_v     = _uv[1];
+					vertex->m_blend = blendLane;
+					++vertex;
+
+					const Vec3 ur = sub(add(pos, udir), vdir);
+					store(&vertex->m_x, ur);
+					aabbExpand(aabb, ur);
+					vertex->m_abgr  = abgr;
+					vertex->m_u     = _uv[2];
+					vertex->m_v     = _uv[1];
+					vertex->m_blend = blendLane;
+					++vertex;
+
+					const Vec3 br = add(add(pos, udir), vdir);
+					store(&vertex->m_x, br);
+					aabbExpand(aabb, br);
+					vertex->m_abgr  = abgr;
+					vertex->m_u     = _uv[2];
+					vertex->m_v     = _uv[3];
+					vertex->m_blend = blendLane;
+					++vertex;
+
+					const Vec3 bl = add(sub(pos, udir), vdir);
+					store(&vertex->m_x, bl);
+					aabbExpand(aabb, bl);
+					vertex->m_abgr  = abgr;
+					vertex->m_u     = _uv[0];
+					vertex->m_v     = _uv[3];
+					vertex->m_blend = blendLane;
+					++vertex;
+				}
+			}
+
+			_outAabb = aabb;
 		}
 
 		EmitterShape::Enum     m_shape;
@@ -427,21 +552,41 @@ namespace ps
 
 		Aabb m_aabb;
 
-		Particle* m_particles;
-		uint32_t m_num;
-		uint32_t m_max;
+		void*     m_mem;
+		float*    m_stream[ParticleStream::Count];
+		uint32_t* m_rgba;
+		uint32_t  m_num;
+		uint32_t  m_max;
 	};
 
-	static int32_t particleSortFn(const void* _lhs, const void* _rhs)
+	struct EmitterJob
 	{
-		const ParticleSort& lhs = *(const ParticleSort*)_lhs;
-		const ParticleSort& rhs = *(const ParticleSort*)_rhs;
-		return lhs.dist > rhs.dist ? -1 : 1;
-	}
+		Aabb     aabb;
+		float    uv[4];
+		uint32_t begin;
+		uint32_t num;
+		uint32_t first;
+		uint16_t emitter;
+	};
 
 	struct ParticleSystem
 	{
-		void init(uint16_t _maxEmitters, bx::AllocatorI* _allocator)
+		struct JobType
+		{
+			enum Enum
+			{
+				Integrate,
+				Update,
+				Render,
+			};
+		};
+
+		static constexpr uint32_t kMaxWorkerThreads = 8;
+
+		// Emitters with more particles are split into multiple jobs. Must be multiple of four.
+		static constexpr uint32_t kParticlesPerJob = 4096;
+
+		void init(uint16_t _maxEmitters, uint8_t _numWorkerThreads, bx::AllocatorI* _allocator)
 		{
 			m_allocator = _allocator;
 
@@ -454,6 +599,14 @@ namespace ps
 			m_emitterAlloc = bx::createHandleAlloc(m_allocator, _maxEmitters);
 			m_emitter = (Emitter*)BX_ALLOC(m_allocator, sizeof(Emitter)*_maxEmitters);
 
+			m_job         = NULL;
+			m_maxJobs     = 0;
+			m_sortTemp    = NULL;
+			m_maxSortTemp = 0;
+			m_maxDynamic  = 0;
+			m_dvbh        = BGFX_INVALID_HANDLE;
+			m_dibh        = BGFX_INVALID_HANDLE;
+
 			PosColorTexCoord0Vertex::init();
 
 			m_num = 0;
@@ -473,20 +626,183 @@ namespace ps
 				, bgfx::createEmbeddedShader(s_embeddedShaders, type, "fs_particle")
 				, true
 				);
+
+			m_exit = false;
+			m_numWorkerThreads = 0;
+
+#if BX_CONFIG_SUPPORTS_THREADING
+			m_numWorkerThreads = bx::uint32_min(_numWorkerThreads, kMaxWorkerThreads);
+
+			for (uint32_t ii = 0; ii < m_numWorkerThreads; ++ii)
+			{
+				m_thread[ii].init(workerThreadFunc, this, 0, "ps - worker");
+			}
+#else
+			BX_UNUSED(_numWorkerThreads);
+#endif // BX_CONFIG_SUPPORTS_THREADING
 		}
 
 		void shutdown()
 		{
+#if BX_CONFIG_SUPPORTS_THREADING
+			m_exit = true;
+			m_workStart.post(m_numWorkerThreads);
+
+			for (uint32_t ii = 0; ii < m_numWorkerThreads; ++ii)
+			{
+				m_thread[ii].shutdown();
+			}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+			if (isValid(m_dvbh) )
+			{
+				bgfx::destroy(m_dvbh);
+				bgfx::destroy(m_dibh);
+			}
+
 			bgfx::destroy(m_particleProgram);
 			bgfx::destroy(m_texture);
 			bgfx::destroy(s_texColor);
 
 			bx::destroyHandleAlloc(m_allocator, m_emitterAlloc);
 			BX_FREE(m_allocator, m_emitter);
+			BX_FREE(m_allocator, m_job);
+			BX_FREE(m_allocator, m_sortTemp);
 
 			m_allocator = NULL;
 		}
 
+#if BX_CONFIG_SUPPORTS_THREADING
+		static int32_t workerThreadFunc(bx::Thread* /*_self*/, void* _userData)
+		{
+			ParticleSystem* ps = (ParticleSystem*)_userData;
+
+			for (;;)
+			{
+				ps->m_workStart.wait();
+
+				if (ps->m_exit)
+				{
+					break;
+				}
+
+				ps->processJobs();
+				ps->m_workDone.post();
+			}
+
+			return bx::kExitSuccess;
+		}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+		void runJob(uint32_t _idx)
+		{
+			switch (m_jobType)
+			{
+			case JobType::Integrate:
+				{
+					const EmitterJob& job = m_job[_idx];
+					m_emitter[job.emitter].integrate(m_jobDt, job.begin, job.num);
+				}
+				break;
+
+			case JobType::Update:
+				{
+					const uint16_t idx = m_emitterAlloc->getHandleAt(uint16_t(_idx) );
+					m_emitter[idx].update(m_jobDt);
+				}
+				break;
+
+			case JobType::Render:
+				{
+					EmitterJob& job = m_job[_idx];
+					m_emitter[job.emitter].render(
+						  job.uv
+						, m_jobMtxView
+						, m_jobEye
+						, job.begin
+						, job.num
+						, job.first
+						, m_jobKeys
+						, m_jobValues
+						, m_jobVertices
+						, job.aabb
+						);
+				}
+				break;
+			}
+		}
+
+		void processJobs()
+		{
+			for (int32_t ii = bx::atomicFetchAndAdd(&m_jobNext, 1)
+				; ii < int32_t(m_numJobs)
+				; ii = bx::atomicFetchAndAdd(&m_jobNext, 1)
+				)
+			{
+				runJob(uint32_t(ii) );
+			}
+		}
+
+		// Jobs are independent, each one is picked up by the first free worker. The calling
+		// thread participates and returns once all jobs are done.
+		void dispatch(JobType::Enum _type, uint32_t _numJobs)
+		{
+			m_jobType = _type;
+			m_numJobs = _numJobs;
+			m_jobNext = 0;
+
+			const uint32_t numWorkers = bx::uint32_min(m_numWorkerThreads, _numJobs-1);
+
+#if BX_CONFIG_SUPPORTS_THREADING
+			m_workStart.post(numWorkers);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+			processJobs();
+
+#if BX_CONFIG_SUPPORTS_THREADING
+			for (uint32_t ii = 0; ii < numWorkers; ++ii)
+			{
+				m_workDone.wait();
+			}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+		}
+
+		template<typename Ty>
+		void reserve(Ty*& _ptr, uint32_t& _max, uint32_t _num)
+		{
+			if (_max < _num)
+			{
+				_max = bx::uint32_max(_num, _max + _max/2);
+				_ptr = (Ty*)BX_REALLOC(m_allocator, _ptr, _max*sizeof(Ty) );
+			}
+		}
+
+		// Splits _num particles of emitter into ranges of kParticlesPerJob. At least one job is
+		// added, so that empty emitters still get their bounds updated.
+		uint32_t addJobs(uint32_t _numJobs, uint16_t _emitter, uint32_t _num, uint32_t _first)
+		{
+			uint32_t begin = 0;
+
+			do
+			{
+				EmitterJob& job = m_job[_numJobs++];
+				job.begin   = begin;
+				job.num     = bx::uint32_min(_num - begin, kParticlesPerJob);
+				job.first   = _first + begin;
+				job.emitter = _emitter;
+
+				begin += job.num;
+			}
+			while (begin < _num);
+
+			return _numJobs;
+		}
+
+		uint32_t getMaxJobs(uint16_t _numEmitters, uint32_t _numParticles) const
+		{
+			return _numEmitters + _numParticles/kParticlesPerJob;
+		}
+
 		EmitterSpriteHandle createSprite(uint16_t _width, uint16_t _height, const void* _data)
 		{
 			EmitterSpriteHandle handle = m_sprite.create(_width, _height);
@@ -516,13 +832,37 @@ namespace ps
 
 		void update(float _dt)
 		{
+			const uint16_t numEmitters = m_emitterAlloc->getNumHandles();
+
+			if (0 < numEmitters)
+			{
+				m_jobDt = _dt;
+
+				uint32_t numParticles = 0;
+				for (uint16_t ii = 0; ii < numEmitters; ++ii)
+				{
+					const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
+					numParticles += m_emitter[idx].m_num;
+				}
+
+				reserve(m_job, m_maxJobs, getMaxJobs(numEmitters, numParticles) );
+
+				uint32_t numJobs = 0;
+				for (uint16_t ii = 0; ii < numEmitters; ++ii)
+				{
+					const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
+					numJobs = addJobs(numJobs, idx, m_emitter[idx].m_num, 0);
+				}
+
+				dispatch(JobType::Integrate, numJobs);
+				dispatch(JobType::Update, numEmitters);
+			}
+
 			uint32_t numParticles = 0;
-			for (uint16_t ii = 0, num = m_emitterAlloc->getNumHandles(); ii < num; ++ii)
+			for (uint16_t ii = 0; ii < numEmitters; ++ii)
 			{
 				const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
-				Emitter& emitter = m_emitter[idx];
-				emitter.update(_dt);
-				numParticles += emitter.m_num;
+				numParticles += m_emitter[idx].m_num;
 			}
 
 			m_num = numParticles;
@@ -532,61 +872,145 @@ namespace ps
 		{
 			if (0 != m_num)
 			{
+				const uint32_t max = m_num;
+
+				// 16-bit indices can address only 16K quads.
+				bool index32 = max > (UINT16_MAX+1)/4;
+
+				// Transient buffers are shared by everything drawn in the frame, and with default
+				// sizes fit only ~50K particles. When they can't fit all particles, vertices and
+				// indices are uploaded into dynamic buffers owned by particle system instead.
+				const uint32_t numIndices = index32
+					? bgfx::getAvailTransientIndexBuffer(max*6*2)/2
+					: bgfx::getAvailTransientIndexBuffer(max*6)
+					;
+				const bool transient = true
+					&& max*4 == bgfx::getAvailTransientVertexBuffer(max*4, PosColorTexCoord0Vertex::ms_layout)
+					&& max*6 == numIndices
+					;
+
 				bgfx::TransientVertexBuffer tvb;
 				bgfx::TransientIndexBuffer tib;
+				const bgfx::Memory* vertexMem = NULL;
+				const bgfx::Memory* indexMem  = NULL;
+				void* indexData;
 
-				const uint32_t numVertices = bgfx::getAvailTransientVertexBuffer(m_num*4, PosColorTexCoord0Vertex::ms_layout);
-				const uint32_t numIndices  = bgfx::getAvailTransientIndexBuffer(m_num*6);
-				const uint32_t max = bx::uint32_min(numVertices/4, numIndices/6);
-				BX_WARN(m_num == max
-					, "Truncating transient buffer for particles to maximum available (requested %d, available %d)."
-					, m_num
-					, max
-					);
+				if (transient)
+				{
+					bgfx::allocTransientVertexBuffer(&tvb, max*4, PosColorTexCoord0Vertex::ms_layout);
+					bgfx::allocTransientIndexBuffer(&tib, max*6, index32);
+					m_jobVertices = (PosColorTexCoord0Vertex*)tvb.data;
+					indexData     = tib.data;
+				}
+				else
+				{
+					if (m_maxDynamic < max)
+					{
+						if (isValid(m_dvbh) )
+						{
+							bgfx::destroy(m_dvbh);
+							bgfx::destroy(m_dibh);
+						}
+
+						m_maxDynamic = bx::uint32_max(max, m_maxDynamic + m_maxDynamic/2);
+						m_dvbh = bgfx::createDynamicVertexBuffer(m_maxDynamic*4, PosColorTexCoord0Vertex::ms_layout);
+						m_dibh = bgfx::createDynamicIndexBuffer(m_maxDynamic*6, BGFX_BUFFER_INDEX32);
+					}
+
+					index32   = true;
+					vertexMem = bgfx::alloc(max*4*PosColorTexCoord0Vertex::ms_layout.getStride() );
+					indexMem  = bgfx::alloc(max*6*sizeof(uint32_t) );
+					m_jobVertices = (PosColorTexCoord0Vertex*)vertexMem->data;
+					indexData     = indexMem->data;
+				}
+
+				// Sort buffers are kept between frames, and grow only when more particles are
+				// rendered.
+				reserve(m_sortTemp, m_maxSortTemp, max*4);
+				uint32_t* keys       = &m_sortTemp[max*0];
+				uint32_t* values     = &m_sortTemp[max*1];
+				uint32_t* tempKeys   = &m_sortTemp[max*2];
+				uint32_t* tempValues = &m_sortTemp[max*3];
 
-				if (0 < max)
+				const uint16_t numEmitters = m_emitterAlloc->getNumHandles();
+
+				reserve(m_job, m_maxJobs, getMaxJobs(numEmitters, max) );
+
+				uint32_t numJobs = 0;
+				uint32_t pos = 0;
+				for (uint16_t ii = 0; ii < numEmitters; ++ii)
 				{
-					bgfx::allocTransientBuffers(&tvb
-						, PosColorTexCoord0Vertex::ms_layout
-						, max*4
-						, &tib
-						, max*6
-						);
-					PosColorTexCoord0Vertex* vertices = (PosColorTexCoord0Vertex*)tvb.data;
+					const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
+					Emitter& emitter = m_emitter[idx];
 
-					ParticleSort* particleSort = (ParticleSort*)BX_ALLOC(m_allocator, max*sizeof(ParticleSort) );
+					const Pack2D& pack = m_sprite.get(emitter.m_uniforms.m_handle);
+					const float invTextureSize = 1.0f/SPRITE_TEXTURE_SIZE;
+					const float uv[4] =
+					{
+						 pack.m_x                  * invTextureSize,
+						 pack.m_y                  * invTextureSize,
+						(pack.m_x + pack.m_width ) * invTextureSize,
+						(pack.m_y + pack.m_height) * invTextureSize,
+					};
+
+					const uint32_t first = numJobs;
+					numJobs = addJobs(numJobs, idx, emitter.m_num, pos);
 
-					uint32_t pos = 0;
-					for (uint16_t ii = 0, numEmitters = m_emitterAlloc->getNumHandles(); ii < numEmitters; ++ii)
+					for (uint32_t jj = first; jj < numJobs; ++jj)
 					{
-						const uint16_t idx = m_emitterAlloc->getHandleAt(ii);
-						Emitter& emitter = m_emitter[idx];
+						bx::memCopy(m_job[jj].uv, uv, sizeof(uv) );
+					}
 
-						const Pack2D& pack = m_sprite.get(emitter.m_uniforms.m_handle);
-						const float invTextureSize = 1.0f/SPRITE_TEXTURE_SIZE;
-						const float uv[4] =
-						{
-							 pack.m_x                  * invTextureSize,
-							 pack.m_y                  * invTextureSize,
-							(pack.m_x + pack.m_width ) * invTextureSize,
-							(pack.m_y + pack.m_height) * invTextureSize,
-						};
+					pos += emitter.m_num;
+				}
+
+				m_jobMtxView = _mtxView;
+				m_jobEye     = _eye;
+				m_jobKeys    = keys;
+				m_jobValues  = values;
+				dispatch(JobType::Render, numJobs);
+
+				// Merge bounds of emitters split into multiple jobs.
+				for (uint32_t ii = 0; ii < numJobs; ++ii)
+				{
+					const EmitterJob& job = m_job[ii];
+					Aabb& aabb = m_emitter[job.emitter].m_aabb;
 
-						pos += emitter.render(uv, _mtxView, _eye, pos, max, particleSort, vertices);
+					if (0 == job.begin)
+					{
+						aabb = job.aabb;
+					}
+					else
+					{
+						aabb.min = bx::min(aabb.min, job.aabb.min);
+						aabb.max = bx::max(aabb.max, job.aabb.max);
 					}
+				}
 
-					qsort(particleSort
-						, max
-						, sizeof(ParticleSort)
-						, particleSortFn
-						);
+				bx::radixSort(keys, tempKeys, values, tempValues, max);
 
-					uint16_t* indices = (uint16_t*)tib.data;
+				if (index32)
+				{
+					uint32_t* indices = (uint32_t*)indexData;
+					for (uint32_t ii = 0; ii < max; ++ii)
+					{
+						uint32_t* index = &indices[ii*6];
+						const uint32_t idx = values[ii];
+						index[0] = idx*4+0;
+						index[1] = idx*4+1;
+						index[2] = idx*4+2;
+						index[3] = idx*4+2;
+						index[4] = idx*4+3;
+						index[5] = idx*4+0;
+					}
+				}
+				else
+				{
+					uint16_t* indices = (uint16_t*)indexData;
 					for (uint32_t ii = 0; ii < max; ++ii)
 					{
-						const ParticleSort& sort = particleSort[ii];
 						uint16_t* index = &indices[ii*6];
-						uint16_t idx = (uint16_t)sort.idx;
+						const uint16_t idx = (uint16_t)values[ii];
 						index[0] = idx*4+0;
 						index[1] = idx*4+1;
 						index[2] = idx*4+2;
@@ -594,21 +1018,31 @@ namespace ps
 						index[4] = idx*4+3;
 						index[5] = idx*4+0;
 					}
+				}
 
-					BX_FREE(m_allocator, particleSort);
+				bgfx::setState(0
+					| BGFX_STATE_WRITE_RGB
+					| BGFX_STATE_WRITE_A
+					| BGFX_STATE_DEPTH_TEST_LESS
+					| BGFX_STATE_CULL_CW
+					| BGFX_STATE_BLEND_NORMAL
+					);
+				bgfx::setTexture(0, s_texColor, m_texture);
 
-					bgfx::setState(0
-						| BGFX_STATE_WRITE_RGB
-						| BGFX_STATE_WRITE_A
-						| BGFX_STATE_DEPTH_TEST_LESS
-						| BGFX_STATE_CULL_CW
-						| BGFX_STATE_BLEND_NORMAL
-						);
+				if (transient)
+				{
 					bgfx::setVertexBuffer(0, &tvb);
 					bgfx::setIndexBuffer(&tib);
-					bgfx::setTexture(0, s_texColor, m_texture);
-					bgfx::submit(_view, m_particleProgram);
 				}
+				else
+				{
+					bgfx::update(m_dvbh, 0, vertexMem);
+					bgfx::update(m_dibh, 0, indexMem);
+					bgfx::setVertexBuffer(0, m_dvbh, 0, max*4);
+					bgfx::setIndexBuffer(m_dibh, 0, max*6);
+				}
+
+				bgfx::submit(_view, m_particleProgram);
 			}
 		}
 
@@ -668,14 +1102,41 @@ namespace ps
 		bx::HandleAlloc* m_emitterAlloc;
 		Emitter* m_emitter;
 
+		EmitterJob*       m_job;
+		uint32_t          m_maxJobs;
+		uint32_t*         m_sortTemp;
+		uint32_t          m_maxSortTemp;
+		uint32_t          m_maxDynamic;
+
 		typedef SpriteT<256, SPRITE_TEXTURE_SIZE> Sprite;
 		Sprite m_sprite;
 
 		bgfx::UniformHandle s_texColor;
 		bgfx::TextureHandle m_texture;
 		bgfx::ProgramHandle m_particleProgram;
+		bgfx::DynamicVertexBufferHandle m_dvbh;
+		bgfx::DynamicIndexBufferHandle  m_dibh;
 
 		uint32_t m_num;
+
+#if BX_CONFIG_SUPPORTS_THREADING
+		bx::Thread    m_thread[kMaxWorkerThreads];
+		bx::Semaphore m_workStart;
+		bx::Semaphore m_workDone;
+#endif // BX_CONFIG_SUPPORTS_THREADING
+		uint32_t m_numWorkerThreads;
+		bool     m_exit;
+
+		JobType::Enum m_jobType;
+		uint32_t      m_numJobs;
+		int32_t       m_jobNext;
+
+		float                    m_jobDt;
+		const float*             m_jobMtxView;
+		bx::Vec3                 m_jobEye;
+		uint32_t*                m_jobKeys;
+		uint32_t*                m_jobValues;
+		PosColorTexCoord0Vertex* m_jobVertices;
 	};
 
 	static ParticleSystem s_ctx;
@@ -687,22 +1148,35 @@ namespace ps
 		m_shape     = _shape;
 		m_direction = _direction;
 		m_max       = _maxParticles;
-		m_particles = (Particle*)BX_ALLOC(s_ctx.m_allocator, m_max*sizeof(Particle) );
+
+		// Streams are padded to multiple of four particles and aligned for SIMD loads.
+		const uint32_t maxAligned = bx::strideAlign(m_max, 4);
+		const uint32_t size = maxAligned*(ParticleStream::Count*sizeof(float) + 5*sizeof(uint32_t) );
+		m_mem = BX_ALIGNED_ALLOC(s_ctx.m_allocator, size, 16);
+		bx::memSet(m_mem, 0, size);
+
+		float* stream = (float*)m_mem;
+		for (uint32_t ii = 0; ii < ParticleStream::Count; ++ii, stream += maxAligned)
+		{
+			m_stream[ii] = stream;
+		}
+
+		m_rgba = (uint32_t*)stream;
 	}
 
 	void Emitter::destroy()
 	{
-		BX_FREE(s_ctx.m_allocator, m_particles);
-		m_particles = NULL;
+		BX_ALIGNED_FREE(s_ctx.m_allocator, m_mem, 16);
+		m_mem = NULL;
 	}
 
 } // namespace ps
 
 using namespace ps;
 
-void psInit(uint16_t _maxEmitters, bx::AllocatorI* _allocator)
+void psInit(uint16_t _maxEmitters, bx::AllocatorI* _allocator, uint8_t _numWorkerThreads)
 {
-	s_ctx.init(_maxEmitters, _allocator);
+	s_ctx.init(_maxEmitters, _numWorkerThreads, _allocator);
 }
 
 void psShutdown()
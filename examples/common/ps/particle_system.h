@@ -73,8 +73,10 @@ struct EmitterUniforms
 	EmitterSpriteHandle m_handle;
 };
 
-///
-void psInit(uint16_t _maxEmitters = 64, bx::AllocatorI* _allocator = NULL);
+/// Emitters are updated and rendered on calling thread. When `_numWorkerThreads` is not zero,
+/// that many worker threads are created to help, and emitters with many particles are split
+/// into multiple jobs.
+void psInit(uint16_t _maxEmitters = 64, bx::AllocatorI* _allocator = NULL, uint8_t _numWorkerThreads = 0);
 
 ///
 void psShutdown();
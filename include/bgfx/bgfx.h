@@ -393,6 +393,7 @@ namespace bgfx
 
 	static const uint16_t kInvalidHandle = UINT16_MAX;
 
+	BGFX_HANDLE(BundleHandle)
 	BGFX_HANDLE(DynamicIndexBufferHandle)
 	BGFX_HANDLE(DynamicVertexBufferHandle)
 	BGFX_HANDLE(FrameBufferHandle)
@@ -402,13 +403,15 @@ namespace bgfx
 	BGFX_HANDLE(ProgramHandle)
 	BGFX_HANDLE(ShaderHandle)
 	BGFX_HANDLE(TextureHandle)
+	BGFX_HANDLE(UniformBlockHandle)
 	BGFX_HANDLE(UniformHandle)
 	BGFX_HANDLE(VertexBufferHandle)
 	BGFX_HANDLE(VertexLayoutHandle)
 
 	/// Callback interface to implement application specific behavior.
-	/// Cached items are currently used for OpenGL and Direct3D 12 binary
-	/// shaders.
+	/// Cached items are currently used for OpenGL binary shaders, and for
+	/// Vulkan and Direct3D 12 pipeline cache (single item per renderer, see
+	/// `bgfx::flushPipelineCache`).
 	///
 	/// @remarks
 	///   'fatal' and 'trace' callbacks can be called from any thread. Other
@@ -685,6 +688,14 @@ namespace bgfx
 			uint32_t minResourceCbSize; //!< Minimum resource command buffer size.
 			uint32_t transientVbSize;   //!< Maximum transient vertex buffer size.
 			uint32_t transientIbSize;   //!< Maximum transient index buffer size.
+			uint32_t maxDrawCalls;      //!< Maximum number of draw and compute calls per frame. Frame
+			                            //!  storage grows on demand up to this limit.
+			uint32_t textureStreamSize; //!< Maximum number of bytes of streaming texture mips uploaded
+			                            //!  per frame.
+			uint16_t numWorkerThreads;  //!< Number of worker threads used to split frame processing
+			                            //!  into parallel jobs and to decode textures.
+			uint16_t renderItemBlock;   //!< Number of render items encoder claims from frame at once.
+			                            //!  When 0 each render item is claimed individually.
 		};
 
 		Limits limits; // Configurable runtime limits.
@@ -973,11 +984,14 @@ namespace bgfx
 		int64_t waitRender;                 //!< Time spent waiting for render backend thread to finish issuing
 		                                    //!  draw commands to underlying graphics API.
 		int64_t waitSubmit;                 //!< Time spent waiting for submit thread to advance to next frame.
+		int64_t cpuTimeSort;                //!< Render thread CPU time spent sorting render items.
 
 		uint32_t numDraw;                   //!< Number of draw calls submitted.
 		uint32_t numCompute;                //!< Number of compute calls submitted.
 		uint32_t numBlit;                   //!< Number of blit calls submitted.
 		uint32_t maxGpuLatency;             //!< GPU driver latency.
+		uint32_t numDropped;                //!< Number of draw and compute calls dropped because frame
+		                                    //!  storage was exhausted.
 
 		uint16_t numDynamicIndexBuffers;    //!< Number of used dynamic index buffers.
 		uint16_t numDynamicVertexBuffers;   //!< Number of used dynamic vertex buffers.
@@ -993,8 +1007,14 @@ namespace bgfx
 
 		int64_t textureMemoryUsed;          //!< Estimate of texture memory used.
 		int64_t rtMemoryUsed;               //!< Estimate of render target memory used.
+		int64_t textureStreamResident;      //!< Streaming texture mips resident on GPU in bytes.
+		int64_t textureStreamPending;       //!< Streaming texture mips waiting for upload in bytes.
 		int32_t transientVbUsed;            //!< Amount of transient vertex buffer used.
 		int32_t transientIbUsed;            //!< Amount of transient index buffer used.
+		uint32_t dynamicIbFree;             //!< Amount of free memory in dynamic index buffer pool.
+		uint32_t dynamicIbLargestFree;      //!< Largest free block in dynamic index buffer pool.
+		uint32_t dynamicVbFree;             //!< Amount of free memory in dynamic vertex buffer pool.
+		uint32_t dynamicVbLargestFree;      //!< Largest free block in dynamic vertex buffer pool.
 
 		uint32_t numPrims[Topology::Count]; //!< Number of primitives rendered.
 
@@ -1169,6 +1189,16 @@ namespace bgfx
 			, uint16_t _num = 1
 			);
 
+		/// Set uniform block for draw primitive. Block values are applied before
+		/// uniforms set with `setUniform`, which override them. Draw calls
+		/// referencing blocks with identical content don't update uniforms again.
+		///
+		/// @param[in] _handle Uniform block.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_set_uniform_block`.
+		///
+		void setUniformBlock(UniformBlockHandle _handle);
+
 		/// Set index buffer for draw primitive.
 		///
 		/// @param[in] _handle Index buffer.
@@ -1489,6 +1519,42 @@ namespace bgfx
 			, uint8_t _flags = BGFX_DISCARD_ALL
 			);
 
+		/// Begin recording draw calls into bundle. While recording, `submit` calls
+		/// are captured into bundle instead of being submitted to view. Compute
+		/// dispatch, occlusion queries, and transient buffers can't be recorded.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_begin_bundle`.
+		///
+		void beginBundle();
+
+		/// End recording draw calls into bundle.
+		///
+		/// @returns Handle to bundle object.
+		///
+		/// @remarks
+		///   Returns invalid handle if bundle couldn't be allocated. Resources
+		///   referenced by bundle must stay valid until bundle is destroyed.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_end_bundle`.
+		///
+		BundleHandle endBundle();
+
+		/// Submit bundle of recorded draw calls for rendering.
+		///
+		/// @param[in] _id View id.
+		/// @param[in] _handle Bundle handle.
+		///
+		/// @remarks
+		///   Draw calls are sorted by mode of view they are submitted to, and
+		///   keep recording order in `ViewMode::Sequential` views.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_submit_bundle`.
+		///
+		void submit(
+			  ViewId _id
+			, BundleHandle _handle
+			);
+
 		/// Set compute index buffer.
 		///
 		/// @param[in] _stage Compute stage.
@@ -1697,6 +1763,56 @@ namespace bgfx
 			);
 	};
 
+	/// Topology sorter keeps scratch memory and sorted order between calls, and when order
+	/// changed only a little since previous call, it refines previous order instead of sorting
+	/// from scratch. Sorter doesn't depend on bgfx being initialized. It can be used from any
+	/// thread, but only from one thread at the time. Use `bgfx::createTopologySorter()` to
+	/// create sorter.
+	///
+	/// @attention C99 equivalent is `bgfx_topology_sorter_t`.
+	///
+	struct TopologySorter
+	{
+		/// Sort indices. Sort keys of meshes with more than 100K triangles are calculated on
+		/// worker threads shared with other vertex and index utility functions.
+		///
+		/// @param[in] _sort Sort order, see `TopologySort::Enum`.
+		/// @param[in] _dst Destination index buffer.
+		/// @param[in] _dstSize Destination index buffer in bytes. It must be
+		///    large enough to contain output indices. If destination size is
+		///    insufficient index buffer will be truncated.
+		/// @param[in] _dir Direction (vector must be normalized).
+		/// @param[in] _pos Position.
+		/// @param[in] _vertices Pointer to first vertex represented as
+		///    float x, y, z. Must contain at least number of vertices
+		///    referencende by index buffer.
+		/// @param[in] _stride Vertex stride.
+		/// @param[in] _indices Source indices.
+		/// @param[in] _numIndices Number of input indices.
+		/// @param[in] _index32 Set to `true` if input indices are 32-bit.
+		///
+		/// @attention C99 equivalent is `bgfx_topology_sorter_sort_tri_list`.
+		///
+		void sortTriList(
+			  TopologySort::Enum _sort
+			, void* _dst
+			, uint32_t _dstSize
+			, const float _dir[3]
+			, const float _pos[3]
+			, const void* _vertices
+			, uint32_t _stride
+			, const void* _indices
+			, uint32_t _numIndices
+			, bool _index32
+			);
+
+		/// Forget previous order, next sort will sort from scratch.
+		///
+		/// @attention C99 equivalent is `bgfx_topology_sorter_reset`.
+		///
+		void reset();
+	};
+
 	/// Vertex layout.
 	///
 	/// @attention C99 equivalent is `bgfx_vertex_layout_t`.
@@ -1828,6 +1944,11 @@ namespace bgfx
 	/// @param[in] _srcData Source vertex stream data.
 	/// @param[in] _num Number of vertices to convert from source to destination.
 	///
+	/// @remarks
+	///   Result is bit-exact with `vertexUnpack` followed by `vertexPack`. Streams with 128K
+	///   or more vertices are split across worker threads, and function returns once all of
+	///   them are converted.
+	///
 	/// @attention C99 equivalent is `bgfx_vertex_convert`.
 	///
 	void vertexConvert(
@@ -1860,6 +1981,34 @@ namespace bgfx
 		, float _epsilon = 0.001f
 		);
 
+	/// Weld vertices, and copy unique vertices into compacted vertex stream.
+	///
+	/// @param[in] _output Welded vertices remapping table into `_outVertices`. The size of
+	///   buffer must be the same as number of vertices.
+	/// @param[in] _outVertices Unique vertices in order of first appearance. The size of buffer
+	///   must be large enough for all vertices in vertex stream. It can be the same as `_data`.
+	/// @param[in] _layout Vertex stream layout.
+	/// @param[in] _data Vertex stream.
+	/// @param[in] _num Number of vertices in vertex stream.
+	/// @param[in] _index32 Set to `true` if input indices are 32-bit.
+	/// @param[in] _epsilon Error tolerance for vertex position comparison.
+	/// @param[in] _attributes Set to `true` to weld only vertices with normal and first texture
+	///   coordinate within error tolerance too.
+	/// @returns Number of unique vertices after vertex welding.
+	///
+	/// @attention C99 equivalent is `bgfx_weld_vertices_compact`.
+	///
+	uint32_t weldVertices(
+		  void* _output
+		, void* _outVertices
+		, const VertexLayout& _layout
+		, const void* _data
+		, uint32_t _num
+		, bool _index32
+		, float _epsilon = 0.001f
+		, bool _attributes = false
+		);
+
 	/// Convert index buffer for use with different primitive topologies.
 	///
 	/// @param[in] _conversion Conversion type, see `TopologyConvert::Enum`.
@@ -1917,6 +2066,27 @@ namespace bgfx
 		, bool _index32
 		);
 
+	/// Create topology sorter. Sorter can be created and used before `bgfx::init` and after
+	/// `bgfx::shutdown`.
+	///
+	/// @param[in] _allocator Allocator used for sorter and its scratch memory. When NULL,
+	///   default allocator is used. Allocator passed to `bgfx::init` is not used, since
+	///   sorter can outlive it.
+	///
+	/// @returns Topology sorter.
+	///
+	/// @attention C99 equivalent is `bgfx_create_topology_sorter`.
+	///
+	TopologySorter* createTopologySorter(bx::AllocatorI* _allocator = NULL);
+
+	/// Destroy topology sorter.
+	///
+	/// @param[in] _sorter Topology sorter.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_topology_sorter`.
+	///
+	void destroy(TopologySorter* _sorter);
+
 	/// Returns supported backend API renderers.
 	///
 	/// @param[in] _max Maximum number of elements in _enum array.
@@ -2034,6 +2204,20 @@ namespace bgfx
 	///
 	const Stats* getStats();
 
+	/// Release GPU memory blocks held by renderer's memory allocators that
+	/// have no live allocations.
+	///
+	/// @remarks
+	///   Partially used blocks are not compacted and live resources are not
+	///   moved. Memory of destroyed resources returns to allocator once GPU is
+	///   done with them, which is a few frames after destroy. Renderers without
+	///   their own memory allocator (everything except Vulkan) ignore it. It's
+	///   executed on render thread at next `bgfx::frame`.
+	///
+	/// @attention C99 equivalent is `bgfx_defragment`.
+	///
+	void defragment();
+
 	/// Allocate buffer to pass to bgfx calls. Data will be freed inside bgfx.
 	///
 	/// @param[in] _size Size to allocate.
@@ -2061,6 +2245,10 @@ namespace bgfx
 	/// `bgfx::frame` calls. `ReleaseFn` function must be able to be called
 	/// from any thread.
 	///
+	/// @remarks `ReleaseFn` is called either from render thread, or from API
+	///   thread (thread calling `bgfx::frame`). It's never called from bgfx
+	///   worker threads, even when texture data is decoded there.
+	///
 	/// @param[in] _data Pointer to data.
 	/// @param[in] _size Size of data.
 	/// @param[in] _releaseFn Callback function to release memory after use.
@@ -2612,6 +2800,41 @@ namespace bgfx
 	///
 	void destroy(ProgramHandle _handle);
 
+	/// Compile pipeline state object for program, state and vertex layout combination
+	/// ahead of first use.
+	///
+	/// @param[in] _program Program handle.
+	/// @param[in] _state State flags. See: `BGFX_STATE_*`.
+	/// @param[in] _layoutHandle Vertex layout handle.
+	/// @param[in] _frameBuffer Frame buffer whose render target formats pipeline is
+	///   compiled for. Invalid handle means back buffer.
+	///
+	/// @remarks
+	///   Only renderers that compile pipeline state objects on first use (Vulkan) do
+	///   work here, it's no-op on other renderers. Use it during loading screens to
+	///   avoid hitches, or skipped draws when asynchronous compilation is enabled
+	///   (see `BGFX_CONFIG_NUM_PIPELINE_COMPILE_THREADS`). Pipeline is compiled for
+	///   single vertex stream, default stencil state, and no instance data.
+	///
+	/// @attention C99 equivalent is `bgfx_prewarm_pipeline`.
+	///
+	void prewarmPipeline(
+		  ProgramHandle _program
+		, uint64_t _state
+		, VertexLayoutHandle _layoutHandle
+		, FrameBufferHandle _frameBuffer = BGFX_INVALID_HANDLE
+		);
+
+	/// Write merged pipeline cache blob with `CallbackI::cacheWrite`.
+	///
+	/// @remarks
+	///   Pipeline cache is written at shutdown too. Only renderers that keep pipeline
+	///   cache (Vulkan, Direct3D 12) do work here.
+	///
+	/// @attention C99 equivalent is `bgfx_flush_pipeline_cache`.
+	///
+	void flushPipelineCache();
+
 	/// Validate texture parameters.
 	///
 	/// @param[in] _depth Depth dimension of volume texture.
@@ -2709,6 +2932,25 @@ namespace bgfx
 	///   `_mem` is NULL content of the texture is uninitialized. When `_numLayers` is more than
 	///   1, expected memory layout is texture and all mips together for each array element.
 	///
+	/// @remarks
+	///   With `BGFX_TEXTURE_STREAMING` flag `_mem` contains only the smallest mips (mip tail),
+	///   and larger mips are uploaded later with `bgfx::updateTexture2D`, one whole mip per
+	///   call. Uploads are spread over frames by `Init::Limits::textureStreamSize`, and texture
+	///   is sampled only from mips that are resident. Mip memory obtained with `bgfx::makeRef`
+	///   is copied, since its upload might wait longer than two frames. Streaming textures are
+	///   not immutable, and must be single layer 2D textures with mips.
+	///
+	/// @remarks
+	///   Resident mip range is enforced with renderer's min LOD clamp. D3D9 and WebGPU renderers
+	///   don't support it and ignore it, with those renderers texture is sampled from all mips,
+	///   including ones that are not uploaded yet.
+	///
+	/// @remarks
+	///   With `BGFX_TEXTURE_BINDLESS` flag texture can be sampled from shader by handle index with
+	///   `textureBindless2D*`, using sampler flags texture was created with. Only textures that
+	///   are used this way should be created with it, since on OpenGL texture state becomes
+	///   immutable, and `BGFX_TEXTURE_STREAMING` or min LOD changes are not supported.
+	///
 	/// @attention C99 equivalent is `bgfx_create_texture_2d`.
 	///
 	TextureHandle createTexture2D(
@@ -3171,6 +3413,45 @@ namespace bgfx
 	///
 	void destroy(UniformHandle _handle);
 
+	/// Create uniform block.
+	///
+	/// @returns Handle to uniform block object.
+	///
+	/// @remarks
+	///   Uniform block holds values of multiple uniforms. Block is written once
+	///   with `bgfx::updateUniformBlock` and referenced by draw calls with
+	///   `bgfx::setUniformBlock`. Values persist across frames until updated.
+	///
+	/// @attention C99 equivalent is `bgfx_create_uniform_block`.
+	///
+	UniformBlockHandle createUniformBlock();
+
+	/// Update uniform value stored in uniform block. Changes are visible to all
+	/// draw calls referencing block starting with next `bgfx::frame` call.
+	///
+	/// @param[in] _handle Handle to uniform block object.
+	/// @param[in] _uniform Uniform.
+	/// @param[in] _value Pointer to uniform data.
+	/// @param[in] _num Number of elements. Passing `UINT16_MAX` will
+	///   use the _num passed on uniform creation.
+	///
+	/// @attention C99 equivalent is `bgfx_update_uniform_block`.
+	///
+	void updateUniformBlock(
+		  UniformBlockHandle _handle
+		, UniformHandle _uniform
+		, const void* _value
+		, uint16_t _num = 1
+		);
+
+	/// Destroy uniform block.
+	///
+	/// @param[in] _handle Handle to uniform block object.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_uniform_block`.
+	///
+	void destroy(UniformBlockHandle _handle);
+
 	/// Create occlusion query.
 	///
 	/// @returns Handle to occlusion query object.
@@ -3201,6 +3482,14 @@ namespace bgfx
 	///
 	void destroy(OcclusionQueryHandle _handle);
 
+	/// Destroy bundle.
+	///
+	/// @param[in] _handle Handle to bundle object.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_bundle`.
+	///
+	void destroy(BundleHandle _handle);
+
 	/// Set palette color value.
 	///
 	/// @param[in] _index Index into palette.
@@ -3588,6 +3877,16 @@ namespace bgfx
 		, uint16_t _num = 1
 		);
 
+	/// Set uniform block for draw primitive. Block values are applied before
+	/// uniforms set with `setUniform`, which override them. Draw calls
+	/// referencing blocks with identical content don't update uniforms again.
+	///
+	/// @param[in] _handle Uniform block.
+	///
+	/// @attention C99 equivalent is `bgfx_set_uniform_block`.
+	///
+	void setUniformBlock(UniformBlockHandle _handle);
+
 	/// Set index buffer for draw primitive.
 	///
 	/// @param[in] _handle Index buffer.
@@ -3906,6 +4205,42 @@ namespace bgfx
 		, uint8_t _flags  = BGFX_DISCARD_ALL
 		);
 
+	/// Begin recording draw calls into bundle. While recording, `submit` calls
+	/// are captured into bundle instead of being submitted to view. Compute
+	/// dispatch, occlusion queries, and transient buffers can't be recorded.
+	///
+	/// @attention C99 equivalent is `bgfx_begin_bundle`.
+	///
+	void beginBundle();
+
+	/// End recording draw calls into bundle.
+	///
+	/// @returns Handle to bundle object.
+	///
+	/// @remarks
+	///   Returns invalid handle if bundle couldn't be allocated. Resources
+	///   referenced by bundle must stay valid until bundle is destroyed.
+	///
+	/// @attention C99 equivalent is `bgfx_end_bundle`.
+	///
+	BundleHandle endBundle();
+
+	/// Submit bundle of recorded draw calls for rendering.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _handle Bundle handle.
+	///
+	/// @remarks
+	///   Draw calls are sorted by mode of view they are submitted to, and
+	///   keep recording order in `ViewMode::Sequential` views.
+	///
+	/// @attention C99 equivalent is `bgfx_submit_bundle`.
+	///
+	void submit(
+		  ViewId _id
+		, BundleHandle _handle
+		);
+
 	/// Set compute index buffer.
 	///
 	/// @param[in] _stage Compute stage.
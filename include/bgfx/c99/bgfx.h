@@ -440,6 +440,8 @@ typedef struct bgfx_callback_vtbl_s
 
 } bgfx_callback_vtbl_t;
 
+typedef struct bgfx_bundle_handle_s { uint16_t idx; } bgfx_bundle_handle_t;
+
 typedef struct bgfx_dynamic_index_buffer_handle_s { uint16_t idx; } bgfx_dynamic_index_buffer_handle_t;
 
 typedef struct bgfx_dynamic_vertex_buffer_handle_s { uint16_t idx; } bgfx_dynamic_vertex_buffer_handle_t;
@@ -458,6 +460,8 @@ typedef struct bgfx_shader_handle_s { uint16_t idx; } bgfx_shader_handle_t;
 
 typedef struct bgfx_texture_handle_s { uint16_t idx; } bgfx_texture_handle_t;
 
+typedef struct bgfx_uniform_block_handle_s { uint16_t idx; } bgfx_uniform_block_handle_t;
+
 typedef struct bgfx_uniform_handle_s { uint16_t idx; } bgfx_uniform_handle_t;
 
 typedef struct bgfx_vertex_buffer_handle_s { uint16_t idx; } bgfx_vertex_buffer_handle_t;
@@ -635,6 +639,10 @@ typedef struct bgfx_init_limits_s
     uint32_t             minResourceCbSize;  /** Minimum resource command buffer size.    */
     uint32_t             transientVbSize;    /** Maximum transient vertex buffer size.    */
     uint32_t             transientIbSize;    /** Maximum transient index buffer size.     */
+    uint32_t             maxDrawCalls;       /** Maximum number of draw and compute calls per frame. Frame storage grows on demand up to this limit. */
+    uint32_t             textureStreamSize;  /** Maximum number of bytes of streaming texture mips uploaded per frame. */
+    uint16_t             numWorkerThreads;   /** Number of worker threads used to split frame processing into parallel jobs and to decode textures. */
+    uint16_t             renderItemBlock;    /** Number of render items encoder claims from frame at once. When 0 each render item is claimed individually. */
 
 } bgfx_init_limits_t;
 
@@ -845,10 +853,12 @@ typedef struct bgfx_stats_s
     int64_t              gpuTimerFreq;       /** GPU timer frequency.                     */
     int64_t              waitRender;         /** Time spent waiting for render backend thread to finish issuing draw commands to underlying graphics API. */
     int64_t              waitSubmit;         /** Time spent waiting for submit thread to advance to next frame. */
+    int64_t              cpuTimeSort;        /** Render thread CPU time spent sorting render items. */
     uint32_t             numDraw;            /** Number of draw calls submitted.          */
     uint32_t             numCompute;         /** Number of compute calls submitted.       */
     uint32_t             numBlit;            /** Number of blit calls submitted.          */
     uint32_t             maxGpuLatency;      /** GPU driver latency.                      */
+    uint32_t             numDropped;         /** Number of draw and compute calls dropped because frame storage was exhausted. */
     uint16_t             numDynamicIndexBuffers; /** Number of used dynamic index buffers.    */
     uint16_t             numDynamicVertexBuffers; /** Number of used dynamic vertex buffers.   */
     uint16_t             numFrameBuffers;    /** Number of used frame buffers.            */
@@ -862,8 +872,14 @@ typedef struct bgfx_stats_s
     uint16_t             numVertexLayouts;   /** Number of used vertex layouts.           */
     int64_t              textureMemoryUsed;  /** Estimate of texture memory used.         */
     int64_t              rtMemoryUsed;       /** Estimate of render target memory used.   */
+    int64_t              textureStreamResident; /** Streaming texture mips resident on GPU in bytes. */
+    int64_t              textureStreamPending; /** Streaming texture mips waiting for upload in bytes. */
     int32_t              transientVbUsed;    /** Amount of transient vertex buffer used.  */
     int32_t              transientIbUsed;    /** Amount of transient index buffer used.   */
+    uint32_t             dynamicIbFree;      /** Amount of free memory in dynamic index buffer pool. */
+    uint32_t             dynamicIbLargestFree; /** Largest free block in dynamic index buffer pool. */
+    uint32_t             dynamicVbFree;      /** Amount of free memory in dynamic vertex buffer pool. */
+    uint32_t             dynamicVbLargestFree; /** Largest free block in dynamic vertex buffer pool. */
     uint32_t             numPrims[BGFX_TOPOLOGY_COUNT]; /** Number of primitives rendered.           */
     int64_t              gpuMemoryMax;       /** Maximum available GPU memory for application. */
     int64_t              gpuMemoryUsed;      /** Amount of GPU memory used by the application. */
@@ -899,6 +915,17 @@ typedef struct bgfx_vertex_layout_s
 struct bgfx_encoder_s;
 typedef struct bgfx_encoder_s bgfx_encoder_t;
 
+/**
+ * Topology sorter keeps scratch memory and sorted order between calls, and when order
+ * changed only a little since previous call, it refines previous order instead of sorting
+ * from scratch. Sorter doesn't depend on bgfx being initialized. It can be used from any
+ * thread, but only from one thread at the time. Use `bgfx::createTopologySorter()` to
+ * create sorter.
+ *
+ */
+struct bgfx_topology_sorter_s;
+typedef struct bgfx_topology_sorter_s bgfx_topology_sorter_t;
+
 
 
 /**
@@ -1027,6 +1054,27 @@ BGFX_C_API void bgfx_vertex_convert(const bgfx_vertex_layout_t * _dstLayout, voi
  */
 BGFX_C_API uint32_t bgfx_weld_vertices(void* _output, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon);
 
+/**
+ * Weld vertices, and copy unique vertices into compacted vertex stream.
+ *
+ * @param[in] _output Welded vertices remapping table into `_outVertices`. The size of
+ *  buffer must be the same as number of vertices.
+ * @param[in] _outVertices Unique vertices in order of first appearance. The size of buffer
+ *  must be large enough for all vertices in vertex stream. It can be
+ *  the same as `_data`.
+ * @param[in] _layout Vertex stream layout.
+ * @param[in] _data Vertex stream.
+ * @param[in] _num Number of vertices in vertex stream.
+ * @param[in] _index32 Set to `true` if input indices are 32-bit.
+ * @param[in] _epsilon Error tolerance for vertex position comparison.
+ * @param[in] _attributes Set to `true` to weld only vertices with normal and first texture
+ *  coordinate within error tolerance too.
+ *
+ * @returns Number of unique vertices after vertex welding.
+ *
+ */
+BGFX_C_API uint32_t bgfx_weld_vertices_compact(void* _output, void* _outVertices, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, bool _attributes);
+
 /**
  * Convert index buffer for use with different primitive topologies.
  *
@@ -1165,6 +1213,19 @@ BGFX_C_API const bgfx_caps_t* bgfx_get_caps(void);
  */
 BGFX_C_API const bgfx_stats_t* bgfx_get_stats(void);
 
+/**
+ * Release GPU memory blocks held by renderer's memory allocators that
+ * have no live allocations.
+ * @remarks
+ *   Partially used blocks are not compacted and live resources are not
+ *   moved. Memory of destroyed resources returns to allocator once GPU is
+ *   done with them, which is a few frames after destroy. Renderers without
+ *   their own memory allocator (everything except Vulkan) ignore it. It's
+ *   executed on render thread at next `bgfx::frame`.
+ *
+ */
+BGFX_C_API void bgfx_defragment(void);
+
 /**
  * Allocate buffer to pass to bgfx calls. Data will be freed inside bgfx.
  *
@@ -1692,6 +1753,30 @@ BGFX_C_API bgfx_program_handle_t bgfx_create_compute_program(bgfx_shader_handle_
  */
 BGFX_C_API void bgfx_destroy_program(bgfx_program_handle_t _handle);
 
+/**
+ * Compile pipeline state object for program, state and vertex layout combination
+ * ahead of first use.
+ * @remarks
+ *   Only renderers that compile pipeline state objects on first use (Vulkan) do
+ *   work here, it's no-op on other renderers.
+ *
+ * @param[in] _program Program handle.
+ * @param[in] _state State flags. See: `BGFX_STATE_*`.
+ * @param[in] _layoutHandle Vertex layout handle.
+ * @param[in] _frameBuffer Frame buffer whose render target formats pipeline is compiled for. Invalid handle means back buffer.
+ *
+ */
+BGFX_C_API void bgfx_prewarm_pipeline(bgfx_program_handle_t _program, uint64_t _state, bgfx_vertex_layout_handle_t _layoutHandle, bgfx_frame_buffer_handle_t _frameBuffer);
+
+/**
+ * Write merged pipeline cache blob with `CallbackI::cacheWrite`.
+ * @remarks
+ *   Pipeline cache is written at shutdown too. Only renderers that keep pipeline
+ *   cache (Vulkan, Direct3D 12) do work here.
+ *
+ */
+BGFX_C_API void bgfx_flush_pipeline_cache(void);
+
 /**
  * Validate texture parameters.
  *
@@ -2120,6 +2205,40 @@ BGFX_C_API void bgfx_get_uniform_info(bgfx_uniform_handle_t _handle, bgfx_unifor
  */
 BGFX_C_API void bgfx_destroy_uniform(bgfx_uniform_handle_t _handle);
 
+/**
+ * Create uniform block.
+ *
+ * @remarks
+ *   Uniform block holds values of multiple uniforms. Block is written once
+ *   with `bgfx::updateUniformBlock` and referenced by draw calls with
+ *   `bgfx::setUniformBlock`. Values persist across frames until updated.
+ *
+ * @returns Handle to uniform block object.
+ *
+ */
+BGFX_C_API bgfx_uniform_block_handle_t bgfx_create_uniform_block(void);
+
+/**
+ * Update uniform value stored in uniform block. Changes are visible to all
+ * draw calls referencing block starting with next `bgfx::frame` call.
+ *
+ * @param[in] _handle Handle to uniform block object.
+ * @param[in] _uniform Uniform.
+ * @param[in] _value Pointer to uniform data.
+ * @param[in] _num Number of elements. Passing `UINT16_MAX` will
+ *  use the _num passed on uniform creation.
+ *
+ */
+BGFX_C_API void bgfx_update_uniform_block(bgfx_uniform_block_handle_t _handle, bgfx_uniform_handle_t _uniform, const void* _value, uint16_t _num);
+
+/**
+ * Destroy uniform block.
+ *
+ * @param[in] _handle Handle to uniform block object.
+ *
+ */
+BGFX_C_API void bgfx_destroy_uniform_block(bgfx_uniform_block_handle_t _handle);
+
 /**
  * Create occlusion query.
  *
@@ -2146,6 +2265,63 @@ BGFX_C_API bgfx_occlusion_query_result_t bgfx_get_result(bgfx_occlusion_query_ha
  */
 BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _handle);
 
+/**
+ * Destroy bundle.
+ *
+ * @param[in] _handle Handle to bundle object.
+ *
+ */
+BGFX_C_API void bgfx_destroy_bundle(bgfx_bundle_handle_t _handle);
+
+/**
+ * Create topology sorter. Sorter can be created and used before `bgfx::init` and after
+ * `bgfx::shutdown`.
+ *
+ * @param[in] _allocator Allocator used for sorter and its scratch memory. When NULL,
+ *  default allocator is used. Allocator passed to `bgfx::init`
+ *  is not used, since sorter can outlive it.
+ *
+ * @returns Topology sorter.
+ *
+ */
+BGFX_C_API bgfx_topology_sorter_t* bgfx_create_topology_sorter(bgfx_allocator_interface_t* _allocator);
+
+/**
+ * Sort indices. Sort keys of meshes with more than 100K triangles are calculated on
+ * worker threads shared with other vertex and index utility functions.
+ *
+ * @param[in] _sort Sort order, see `TopologySort::Enum`.
+ * @param[out] _dst Destination index buffer.
+ * @param[in] _dstSize Destination index buffer in bytes. It must be
+ *  large enough to contain output indices. If destination size is
+ *  insufficient index buffer will be truncated.
+ * @param[in] _dir Direction (vector must be normalized).
+ * @param[in] _pos Position.
+ * @param[in] _vertices Pointer to first vertex represented as
+ *  float x, y, z. Must contain at least number of vertices
+ *  referencende by index buffer.
+ * @param[in] _stride Vertex stride.
+ * @param[in] _indices Source indices.
+ * @param[in] _numIndices Number of input indices.
+ * @param[in] _index32 Set to `true` if input indices are 32-bit.
+ *
+ */
+BGFX_C_API void bgfx_topology_sorter_sort_tri_list(bgfx_topology_sorter_t* _this, bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
+
+/**
+ * Forget previous order, next sort will sort from scratch.
+ *
+ */
+BGFX_C_API void bgfx_topology_sorter_reset(bgfx_topology_sorter_t* _this);
+
+/**
+ * Destroy topology sorter.
+ *
+ * @param[in] _sorter Topology sorter.
+ *
+ */
+BGFX_C_API void bgfx_destroy_topology_sorter(bgfx_topology_sorter_t* _sorter);
+
 /**
  * Set palette color value.
  *
@@ -2450,6 +2626,16 @@ BGFX_C_API uint32_t bgfx_encoder_alloc_transform(bgfx_encoder_t* _this, bgfx_tra
  */
 BGFX_C_API void bgfx_encoder_set_uniform(bgfx_encoder_t* _this, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
 
+/**
+ * Set uniform block for draw primitive. Block values are applied before
+ * uniforms set with `setUniform`, which override them. Draw calls
+ * referencing blocks with identical content don't update uniforms again.
+ *
+ * @param[in] _handle Uniform block.
+ *
+ */
+BGFX_C_API void bgfx_encoder_set_uniform_block(bgfx_encoder_t* _this, bgfx_uniform_block_handle_t _handle);
+
 /**
  * Set index buffer for draw primitive.
  *
@@ -2660,6 +2846,37 @@ BGFX_C_API void bgfx_encoder_submit_occlusion_query(bgfx_encoder_t* _this, bgfx_
  */
 BGFX_C_API void bgfx_encoder_submit_indirect(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, uint8_t _flags);
 
+/**
+ * Begin recording draw calls into bundle. While recording, `submit` calls
+ * are captured into bundle instead of being submitted to view. Compute
+ * dispatch, occlusion queries, and transient buffers can't be recorded.
+ *
+ */
+BGFX_C_API void bgfx_encoder_begin_bundle(bgfx_encoder_t* _this);
+
+/**
+ * End recording draw calls into bundle.
+ * @remarks
+ *   Returns invalid handle if bundle couldn't be allocated. Resources
+ *   referenced by bundle must stay valid until bundle is destroyed.
+ *
+ * @returns Handle to bundle object.
+ *
+ */
+BGFX_C_API bgfx_bundle_handle_t bgfx_encoder_end_bundle(bgfx_encoder_t* _this);
+
+/**
+ * Submit bundle of recorded draw calls for rendering.
+ * @remarks
+ *   Draw calls are sorted by mode of view they are submitted to, and
+ *   keep recording order in `ViewMode::Sequential` views.
+ *
+ * @param[in] _id View id.
+ * @param[in] _handle Bundle handle.
+ *
+ */
+BGFX_C_API void bgfx_encoder_submit_bundle(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_bundle_handle_t _handle);
+
 /**
  * Set compute index buffer.
  *
@@ -3001,6 +3218,16 @@ BGFX_C_API uint32_t bgfx_alloc_transform(bgfx_transform_t* _transform, uint16_t
  */
 BGFX_C_API void bgfx_set_uniform(bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
 
+/**
+ * Set uniform block for draw primitive. Block values are applied before
+ * uniforms set with `setUniform`, which override them. Draw calls
+ * referencing blocks with identical content don't update uniforms again.
+ *
+ * @param[in] _handle Uniform block.
+ *
+ */
+BGFX_C_API void bgfx_set_uniform_block(bgfx_uniform_block_handle_t _handle);
+
 /**
  * Set index buffer for draw primitive.
  *
@@ -3222,6 +3449,37 @@ BGFX_C_API void bgfx_submit_occlusion_query(bgfx_view_id_t _id, bgfx_program_han
  */
 BGFX_C_API void bgfx_submit_indirect(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, uint8_t _flags);
 
+/**
+ * Begin recording draw calls into bundle. While recording, `submit` calls
+ * are captured into bundle instead of being submitted to view. Compute
+ * dispatch, occlusion queries, and transient buffers can't be recorded.
+ *
+ */
+BGFX_C_API void bgfx_begin_bundle(void);
+
+/**
+ * End recording draw calls into bundle.
+ * @remarks
+ *   Returns invalid handle if bundle couldn't be allocated. Resources
+ *   referenced by bundle must stay valid until bundle is destroyed.
+ *
+ * @returns Handle to bundle object.
+ *
+ */
+BGFX_C_API bgfx_bundle_handle_t bgfx_end_bundle(void);
+
+/**
+ * Submit bundle of recorded draw calls for rendering.
+ * @remarks
+ *   Draw calls are sorted by mode of view they are submitted to, and
+ *   keep recording order in `ViewMode::Sequential` views.
+ *
+ * @param[in] _id View id.
+ * @param[in] _handle Bundle handle.
+ *
+ */
+BGFX_C_API void bgfx_submit_bundle(bgfx_view_id_t _id, bgfx_bundle_handle_t _handle);
+
 /**
  * Set compute index buffer.
  *
@@ -3560,6 +3818,7 @@ struct bgfx_interface_vtbl
     void (*vertex_unpack)(float _output[4], bgfx_attrib_t _attr, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _index);
     void (*vertex_convert)(const bgfx_vertex_layout_t * _dstLayout, void* _dstData, const bgfx_vertex_layout_t * _srcLayout, const void* _srcData, uint32_t _num);
     uint32_t (*weld_vertices)(void* _output, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon);
+    uint32_t (*weld_vertices_compact)(void* _output, void* _outVertices, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, bool _attributes);
     uint32_t (*topology_convert)(bgfx_topology_convert_t _conversion, void* _dst, uint32_t _dstSize, const void* _indices, uint32_t _numIndices, bool _index32);
     void (*topology_sort_tri_list)(bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
     uint8_t (*get_supported_renderers)(uint8_t _max, bgfx_renderer_type_t* _enum);
@@ -3572,6 +3831,7 @@ struct bgfx_interface_vtbl
     bgfx_renderer_type_t (*get_renderer_type)(void);
     const bgfx_caps_t* (*get_caps)(void);
     const bgfx_stats_t* (*get_stats)(void);
+    void (*defragment)(void);
     const bgfx_memory_t* (*alloc)(uint32_t _size);
     const bgfx_memory_t* (*copy)(const void* _data, uint32_t _size);
     const bgfx_memory_t* (*make_ref)(const void* _data, uint32_t _size);
@@ -3613,6 +3873,8 @@ struct bgfx_interface_vtbl
     bgfx_program_handle_t (*create_program)(bgfx_shader_handle_t _vsh, bgfx_shader_handle_t _fsh, bool _destroyShaders);
     bgfx_program_handle_t (*create_compute_program)(bgfx_shader_handle_t _csh, bool _destroyShaders);
     void (*destroy_program)(bgfx_program_handle_t _handle);
+    void (*prewarm_pipeline)(bgfx_program_handle_t _program, uint64_t _state, bgfx_vertex_layout_handle_t _layoutHandle, bgfx_frame_buffer_handle_t _frameBuffer);
+    void (*flush_pipeline_cache)(void);
     bool (*is_texture_valid)(uint16_t _depth, bool _cubeMap, uint16_t _numLayers, bgfx_texture_format_t _format, uint64_t _flags);
     bool (*is_frame_buffer_valid)(uint8_t _num, const bgfx_attachment_t* _attachment);
     void (*calc_texture_size)(bgfx_texture_info_t * _info, uint16_t _width, uint16_t _height, uint16_t _depth, bool _cubeMap, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format);
@@ -3639,9 +3901,17 @@ struct bgfx_interface_vtbl
     bgfx_uniform_handle_t (*create_uniform)(const char* _name, bgfx_uniform_type_t _type, uint16_t _num);
     void (*get_uniform_info)(bgfx_uniform_handle_t _handle, bgfx_uniform_info_t * _info);
     void (*destroy_uniform)(bgfx_uniform_handle_t _handle);
+    bgfx_uniform_block_handle_t (*create_uniform_block)(void);
+    void (*update_uniform_block)(bgfx_uniform_block_handle_t _handle, bgfx_uniform_handle_t _uniform, const void* _value, uint16_t _num);
+    void (*destroy_uniform_block)(bgfx_uniform_block_handle_t _handle);
     bgfx_occlusion_query_handle_t (*create_occlusion_query)(void);
     bgfx_occlusion_query_result_t (*get_result)(bgfx_occlusion_query_handle_t _handle, int32_t* _result);
     void (*destroy_occlusion_query)(bgfx_occlusion_query_handle_t _handle);
+    void (*destroy_bundle)(bgfx_bundle_handle_t _handle);
+    bgfx_topology_sorter_t* (*create_topology_sorter)(bgfx_allocator_interface_t* _allocator);
+    void (*topology_sorter_sort_tri_list)(bgfx_topology_sorter_t* _this, bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32);
+    void (*topology_sorter_reset)(bgfx_topology_sorter_t* _this);
+    void (*destroy_topology_sorter)(bgfx_topology_sorter_t* _sorter);
     void (*set_palette_color)(uint8_t _index, const float _rgba[4]);
     void (*set_palette_color_rgba8)(uint8_t _index, uint32_t _rgba);
     void (*set_view_name)(bgfx_view_id_t _id, const char* _name);
@@ -3667,6 +3937,7 @@ struct bgfx_interface_vtbl
     void (*encoder_set_transform_cached)(bgfx_encoder_t* _this, uint32_t _cache, uint16_t _num);
     uint32_t (*encoder_alloc_transform)(bgfx_encoder_t* _this, bgfx_transform_t* _transform, uint16_t _num);
     void (*encoder_set_uniform)(bgfx_encoder_t* _this, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
+    void (*encoder_set_uniform_block)(bgfx_encoder_t* _this, bgfx_uniform_block_handle_t _handle);
     void (*encoder_set_index_buffer)(bgfx_encoder_t* _this, bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*encoder_set_dynamic_index_buffer)(bgfx_encoder_t* _this, bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*encoder_set_transient_index_buffer)(bgfx_encoder_t* _this, const bgfx_transient_index_buffer_t* _tib, uint32_t _firstIndex, uint32_t _numIndices);
@@ -3686,6 +3957,9 @@ struct bgfx_interface_vtbl
     void (*encoder_submit)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, uint32_t _depth, uint8_t _flags);
     void (*encoder_submit_occlusion_query)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, uint8_t _flags);
     void (*encoder_submit_indirect)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, uint8_t _flags);
+    void (*encoder_begin_bundle)(bgfx_encoder_t* _this);
+    bgfx_bundle_handle_t (*encoder_end_bundle)(bgfx_encoder_t* _this);
+    void (*encoder_submit_bundle)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_bundle_handle_t _handle);
     void (*encoder_set_compute_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_vertex_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_dynamic_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
@@ -3712,6 +3986,7 @@ struct bgfx_interface_vtbl
     void (*set_transform_cached)(uint32_t _cache, uint16_t _num);
     uint32_t (*alloc_transform)(bgfx_transform_t* _transform, uint16_t _num);
     void (*set_uniform)(bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
+    void (*set_uniform_block)(bgfx_uniform_block_handle_t _handle);
     void (*set_index_buffer)(bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*set_dynamic_index_buffer)(bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*set_transient_index_buffer)(const bgfx_transient_index_buffer_t* _tib, uint32_t _firstIndex, uint32_t _numIndices);
@@ -3731,6 +4006,9 @@ struct bgfx_interface_vtbl
     void (*submit)(bgfx_view_id_t _id, bgfx_program_handle_t _program, uint32_t _depth, uint8_t _flags);
     void (*submit_occlusion_query)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, uint8_t _flags);
     void (*submit_indirect)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, uint8_t _flags);
+    void (*begin_bundle)(void);
+    bgfx_bundle_handle_t (*end_bundle)(void);
+    void (*submit_bundle)(bgfx_view_id_t _id, bgfx_bundle_handle_t _handle);
     void (*set_compute_index_buffer)(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_vertex_buffer)(uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_dynamic_index_buffer)(uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
@@ -228,6 +228,7 @@ function bgfxProjectBase(_kind, _defines)
 			path.join(BGFX_DIR, "src/hmd**.cpp"),
 			path.join(BGFX_DIR, "src/image.cpp"),
 			path.join(BGFX_DIR, "src/nvapi.cpp"),
+			path.join(BGFX_DIR, "src/parallel.cpp"),
 			path.join(BGFX_DIR, "src/renderer_**.cpp"),
 			path.join(BGFX_DIR, "src/shader**.cpp"),
 			path.join(BGFX_DIR, "src/topology.cpp"),
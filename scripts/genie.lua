@@ -584,6 +584,9 @@ or _OPTIONS["with-combined-examples"] then
 		, "43-denoise"
 		, "44-sss"
 		, "45-bokeh"
+		, "46-bufferstress"
+		, "47-topologysort"
+		, "48-vertexconvert"
 		)
 
 	-- 17-drawstress requires multithreading, does not compile for singlethreaded wasm
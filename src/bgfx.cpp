@@ -1237,11 +1237,19 @@ namespace bgfx
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS <= renderItemIdx)
+		if (m_record)
+		{
+			BX_WARN(!isValid(_occlusionQuery), "Occlusion query can't be recorded into bundle, it's ignored.");
+			record(_program, _depth, _flags);
+			return;
+		}
+
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (m_frame->m_maxRenderItems <= renderItemIdx)
 		{
 			discard(_flags);
 			++m_numDropped;
+			m_frame->dropRenderItem();
 			return;
 		}
 
@@ -1275,35 +1283,259 @@ namespace bgfx
 		m_draw.m_uniformBegin = m_uniformBegin;
 		m_draw.m_uniformEnd   = m_uniformEnd;
 
-		if (UINT8_MAX != m_draw.m_streamMask)
+		m_draw.m_numVertices = getNumVertices();
+
+		if (isValid(_occlusionQuery) )
+		{
+			m_draw.m_stateFlags |= BGFX_STATE_INTERNAL_OCCLUSION_QUERY;
+			m_draw.m_occlusionQuery = _occlusionQuery;
+		}
+
+		m_frame->m_renderItem[renderItemIdx].draw = m_draw;
+		m_frame->m_renderItemBind[renderItemIdx]  = m_bind;
+
+		m_draw.clear(_flags);
+		m_bind.clear(_flags);
+		if (_flags & BGFX_DISCARD_STATE)
+		{
+			m_uniformBegin = m_uniformEnd;
+		}
+	}
+
+	void EncoderImpl::submit(ViewId _id, BundleHandle _handle)
+	{
+		BX_ASSERT(!m_record, "Bundle can't be submitted while recording bundle.");
+
+		const Bundle& bundle = s_ctx->m_bundle[_handle.idx];
+		const uint32_t num = bundle.m_num;
+
+		if (0 == num)
+		{
+			return;
+		}
+
+		// Bundle uniform data is appended to encoder's uniform buffer. Uniforms set since last
+		// discard are copied after it, so they still apply to the next draw call.
+		const uint32_t pending = m_frame->m_uniformBuffer[m_uniformIdx]->getPos() - m_uniformBegin;
+		const uint32_t size    = bundle.m_uniformSize + pending;
+		UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx], size + (64<<10), size + (1<<20) );
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		const uint32_t uniformBase = uniformBuffer->getPos();
+		uniformBuffer->write(bundle.m_uniform, bundle.m_uniformSize);
+
+		if (0 < pending)
+		{
+			const uint32_t uniformBegin = uniformBuffer->getPos();
+			uniformBuffer->write(uniformBuffer->getPtr(m_uniformBegin), pending);
+			m_uniformBegin = uniformBegin;
+		}
+
+		MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+		uint16_t numMatrices = uint16_t(bx::min<uint32_t>(bundle.m_numMatrices, UINT16_MAX) );
+		uint32_t firstMatrix = 0;
+
+		if (0 < numMatrices)
+		{
+			firstMatrix = matrixCache.reserve(&numMatrices);
+			bx::memCopy(&matrixCache.m_cache[firstMatrix], bundle.m_matrix, sizeof(Matrix4)*numMatrices);
+		}
+
+		// Draw calls whose transforms didn't fit into matrix cache are dropped, rendering them
+		// with identity transform would be wrong.
+		const bool matrixShortfall = numMatrices < bundle.m_numMatrices;
+		uint32_t numDraws = num;
+
+		if (matrixShortfall)
+		{
+			numDraws = 0;
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				const RenderDraw& draw = bundle.m_item[ii].draw;
+
+				if (0 == draw.m_startMatrix
+				||  draw.m_startMatrix - 1 + draw.m_numMatrices <= numMatrices)
+				{
+					++numDraws;
+				}
+			}
+
+			BX_WARN(false, "Matrix cache overflow, dropping %d of %d bundle draw calls.", num - numDraws, num);
+			m_numDropped += num - numDraws;
+			m_frame->dropRenderItem(num - numDraws);
+		}
+
+		uint32_t begin;
+		const uint32_t numItems = allocRenderItems(numDraws, &begin);
+
+		if (numItems < numDraws)
+		{
+			m_numDropped += numDraws - numItems;
+			m_frame->dropRenderItem(numDraws - numItems);
+		}
+
+		m_numSubmitted += numItems;
+
+		// Keys were encoded with view 0 and sequence relative to bundle start, both fields are
+		// zero in recorded keys so offsetting them is just addition.
+		const ViewMode::Enum mode = s_ctx->m_view[_id].m_mode;
+		uint64_t keyOffset = (uint64_t(_id) << kSortKeyViewBitShift) & kSortKeyViewMask;
+
+		if (ViewMode::Sequential == mode)
+		{
+			const uint32_t seq = s_ctx->getSeqIncr(_id, num);
+			BX_ASSERT(0 == ( (uint64_t(seq + num - 1) << kSortKeyDraw2SeqShift) & ~kSortKeyDraw2SeqMask)
+				, "SortKey error, sequence is truncated (m_seq: %d)."
+				, seq + num - 1
+				);
+			keyOffset += uint64_t(seq) << kSortKeyDraw2SeqShift;
+		}
+
+		const uint64_t* sortKey = bundle.m_sortKey[mode];
+		uint64_t*        keys   = &m_frame->m_sortKeys[begin];
+		RenderItemCount* values = &m_frame->m_sortValues[begin];
+
+		if (!matrixShortfall)
 		{
-			uint32_t numVertices = UINT32_MAX;
-			for (uint32_t idx = 0, streamMask = m_draw.m_streamMask
-				; 0 != streamMask
-				; streamMask >>= 1, idx += 1
-				)
+			for (uint32_t ii = 0; ii < numItems; ++ii)
 			{
-				const uint32_t ntz = bx::uint32_cnttz(streamMask);
-				streamMask >>= ntz;
-				idx         += ntz;
-				numVertices = bx::min(numVertices, m_numVertices[idx]);
+				keys[ii]   = sortKey[ii] + keyOffset;
+				values[ii] = RenderItemCount(begin + ii);
 			}
 
-			m_draw.m_numVertices = numVertices;
+			bx::memCopy(&m_frame->m_renderItem[begin],     bundle.m_item, sizeof(RenderItem)*numItems);
+			bx::memCopy(&m_frame->m_renderItemBind[begin], bundle.m_bind, sizeof(RenderBind)*numItems);
 		}
 		else
 		{
-			m_draw.m_numVertices = m_numVertices[0];
+			for (uint32_t ii = 0, dst = 0; dst < numItems; ++ii)
+			{
+				const RenderDraw& draw = bundle.m_item[ii].draw;
+
+				if (0 == draw.m_startMatrix
+				||  draw.m_startMatrix - 1 + draw.m_numMatrices <= numMatrices)
+				{
+					keys[dst]   = sortKey[ii] + keyOffset;
+					values[dst] = RenderItemCount(begin + dst);
+					m_frame->m_renderItem[begin + dst]     = bundle.m_item[ii];
+					m_frame->m_renderItemBind[begin + dst] = bundle.m_bind[ii];
+					++dst;
+				}
+			}
 		}
 
-		if (isValid(_occlusionQuery) )
+		for (uint32_t ii = begin, end = begin + numItems; ii < end; ++ii)
 		{
-			m_draw.m_stateFlags |= BGFX_STATE_INTERNAL_OCCLUSION_QUERY;
-			m_draw.m_occlusionQuery = _occlusionQuery;
+			RenderDraw& draw = m_frame->m_renderItem[ii].draw;
+			draw.m_uniformIdx    = m_uniformIdx;
+			draw.m_uniformBegin += uniformBase;
+			draw.m_uniformEnd   += uniformBase;
+
+			if (0 != draw.m_startMatrix)
+			{
+				draw.m_startMatrix += firstMatrix - 1;
+			}
+
+			if (UINT16_MAX != draw.m_scissor)
+			{
+				const Rect& rect = bundle.m_rect[draw.m_scissor];
+				draw.m_scissor = uint16_t(m_frame->m_frameCache.m_rectCache.add(rect.m_x, rect.m_y, rect.m_width, rect.m_height) );
+			}
 		}
+	}
 
-		m_frame->m_renderItem[renderItemIdx].draw = m_draw;
-		m_frame->m_renderItemBind[renderItemIdx]  = m_bind;
+	void EncoderImpl::beginBundle()
+	{
+		BX_ASSERT(!m_record, "Bundle is already being recorded.");
+
+		m_bundle = s_ctx->createBundle();
+		m_record = true;
+	}
+
+	BundleHandle EncoderImpl::endBundle()
+	{
+		BX_ASSERT(m_record, "endBundle called without beginBundle.");
+
+		const BundleHandle handle = m_bundle;
+		m_bundle.idx = kInvalidHandle;
+		m_record     = false;
+
+		return handle;
+	}
+
+	void EncoderImpl::record(ProgramHandle _program, uint32_t _depth, uint8_t _flags)
+	{
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		m_uniformEnd = uniformBuffer->getPos();
+
+		const uint16_t tib = m_frame->m_transientIb->handle.idx;
+		const uint16_t tvb = m_frame->m_transientVb->handle.idx;
+
+		bool transient = false
+			|| (isValid(m_draw.m_indexBuffer)        && tib == m_draw.m_indexBuffer.idx)
+			|| (isValid(m_draw.m_instanceDataBuffer) && tvb == m_draw.m_instanceDataBuffer.idx)
+			;
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VERTEX_STREAMS; ++ii)
+		{
+			transient |= 0 != (m_draw.m_streamMask & (1<<ii) )
+				&& tvb == m_draw.m_stream[ii].m_handle.idx
+				;
+		}
+
+		BX_WARN(!transient, "Transient buffers are valid only for one frame, draw call is not recorded into bundle.");
+
+		if (isValid(m_bundle)
+		&&  !transient)
+		{
+			Bundle& bundle = s_ctx->m_bundle[m_bundle.idx];
+			const uint32_t idx = bundle.alloc();
+
+			SortKey key = m_key;
+			key.m_view    = 0;
+			key.m_seq     = idx;
+			key.m_program = isValid(_program)
+				? _program
+				: ProgramHandle{0}
+				;
+			key.m_depth = _depth;
+
+			bundle.m_sortKey[ViewMode::Default        ][idx] = key.encodeDraw(SortKey::SortProgram);
+			bundle.m_sortKey[ViewMode::Sequential     ][idx] = key.encodeDraw(SortKey::SortSequence);
+			bundle.m_sortKey[ViewMode::DepthAscending ][idx] = key.encodeDraw(SortKey::SortDepth);
+
+			key.m_depth = UINT32_MAX-_depth;
+			bundle.m_sortKey[ViewMode::DepthDescending][idx] = key.encodeDraw(SortKey::SortDepth);
+
+			RenderDraw& draw = bundle.m_item[idx].draw;
+			draw = m_draw;
+			draw.m_numVertices = getNumVertices();
+
+			const uint32_t uniformSize = m_uniformEnd - m_uniformBegin;
+			draw.m_uniformBegin = bundle.allocUniform(uniformSize);
+			draw.m_uniformEnd   = draw.m_uniformBegin + uniformSize;
+			bx::memCopy(&bundle.m_uniform[draw.m_uniformBegin], uniformBuffer->getPtr(m_uniformBegin), uniformSize);
+
+			if (0 != m_draw.m_startMatrix)
+			{
+				const uint32_t first = bundle.allocMatrices(m_draw.m_numMatrices);
+				bx::memCopy(
+					  &bundle.m_matrix[first]
+					, m_frame->m_frameCache.m_matrixCache.toPtr(m_draw.m_startMatrix)
+					, sizeof(Matrix4)*m_draw.m_numMatrices
+					);
+				draw.m_startMatrix = first + 1;
+			}
+
+			if (UINT16_MAX != m_draw.m_scissor)
+			{
+				const uint32_t rect = bundle.allocRect();
+				bundle.m_rect[rect] = m_frame->m_frameCache.m_rectCache.m_cache[m_draw.m_scissor];
+				draw.m_scissor = uint16_t(rect);
+			}
+
+			bundle.m_bind[idx] = m_bind;
+		}
 
 		m_draw.clear(_flags);
 		m_bind.clear(_flags);
@@ -1320,17 +1552,21 @@ namespace bgfx
 			m_uniformSet.clear();
 		}
 
-		if (m_discard)
+		BX_WARN(!m_record, "Compute dispatch can't be recorded into bundle, it's ignored.");
+
+		if (m_discard
+		||  m_record)
 		{
 			discard(_flags);
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= renderItemIdx)
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (m_frame->m_maxRenderItems <= renderItemIdx)
 		{
 			discard(_flags);
 			++m_numDropped;
+			m_frame->dropRenderItem();
 			return;
 		}
 
@@ -1397,10 +1633,113 @@ namespace bgfx
 		}
 	}
 
+	struct SortViewJob
+	{
+		uint64_t*        m_keys;
+		RenderItemCount* m_values;
+		uint64_t*        m_outKeys;
+		RenderItemCount* m_outValues;
+		uint32_t         m_begin[BGFX_CONFIG_MAX_VIEWS];
+		uint32_t         m_num[BGFX_CONFIG_MAX_VIEWS];
+	};
+
+	static void sortViewJob(void* _userData, uint32_t _idx)
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Sort view", 0xff2040ff);
+
+		const SortViewJob& job = *(const SortViewJob*)_userData;
+		const uint32_t begin = job.m_begin[_idx];
+		const uint32_t num   = job.m_num[_idx];
+
+		bx::radixSort(
+			  &job.m_keys[begin]
+			, &job.m_outKeys[begin]
+			, &job.m_values[begin]
+			, &job.m_outValues[begin]
+			, num
+			);
+
+		// Frame sort arrays were used as scratch, copy sorted view range back.
+		bx::memCopy(&job.m_outKeys[begin],   &job.m_keys[begin],   num*sizeof(uint64_t) );
+		bx::memCopy(&job.m_outValues[begin], &job.m_values[begin], num*sizeof(RenderItemCount) );
+	}
+
+	static void siftDownRenderItemRun(RenderItemRun* _heap, uint32_t _num, uint32_t _idx, const uint64_t* _keys)
+	{
+		const RenderItemRun run = _heap[_idx];
+		const uint64_t key = _keys[run.m_begin];
+
+		for (uint32_t child = 2*_idx+1; child < _num; child = 2*_idx+1)
+		{
+			if (child+1 < _num
+			&&  _keys[_heap[child+1].m_begin] < _keys[_heap[child].m_begin])
+			{
+				++child;
+			}
+
+			if (key <= _keys[_heap[child].m_begin])
+			{
+				break;
+			}
+
+			_heap[_idx] = _heap[child];
+			_idx = child;
+		}
+
+		_heap[_idx] = run;
+	}
+
+	static uint32_t mergeRenderItemRuns(
+		  uint64_t* _outKeys
+		, RenderItemCount* _outValues
+		, const uint64_t* _keys
+		, const RenderItemCount* _values
+		, RenderItemRun* _runs
+		, uint32_t _numRuns
+		)
+	{
+		// Runs are consumed in place, array is used as binary min-heap ordered by run head key.
+		RenderItemRun* heap = _runs;
+		uint32_t numRuns = _numRuns;
+
+		for (uint32_t ii = numRuns/2; 0 < ii--;)
+		{
+			siftDownRenderItemRun(heap, numRuns, ii, _keys);
+		}
+
+		uint32_t num = 0;
+
+		while (0 < numRuns)
+		{
+			RenderItemRun& top = heap[0];
+			_outKeys[num]   = _keys[top.m_begin];
+			_outValues[num] = _values[top.m_begin];
+			++num;
+
+			++top.m_begin;
+			--top.m_num;
+
+			if (0 == top.m_num)
+			{
+				--numRuns;
+				heap[0] = heap[numRuns];
+			}
+
+			if (0 < numRuns)
+			{
+				siftDownRenderItemRun(heap, numRuns, 0, _keys);
+			}
+		}
+
+		return num;
+	}
+
 	void Frame::sort()
 	{
 		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
 
+		const int64_t timeBegin = bx::getHPCounter();
+
 		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
 		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
 		{
@@ -1436,19 +1775,122 @@ namespace bgfx
 			}
 		}
 
-		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+		bool merged = false;
+
+		if (0 < m_renderItemBlock)
+		{
+			bool identityRemap = true;
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS && identityRemap; ++ii)
+			{
+				identityRemap = viewRemap[ii] == ii;
+			}
+
+			if (identityRemap)
+			{
+				// Encoders already sorted their runs, and without view remap merged
+				// runs are in final order.
+				m_numRenderItems = mergeRenderItemRuns(
+					  s_ctx->m_tempKeys
+					, s_ctx->m_tempValues
+					, m_sortKeys
+					, m_sortValues
+					, m_renderItemRun
+					, m_numRenderItemRuns
+					);
+				m_numRenderItemRuns = 0;
+				merged = true;
+
+				bx::memCopy(m_sortKeys,   s_ctx->m_tempKeys,   m_numRenderItems*sizeof(uint64_t) );
+				bx::memCopy(m_sortValues, s_ctx->m_tempValues, m_numRenderItems*sizeof(RenderItemCount) );
+			}
+			else
+			{
+				// Drop gaps left by partially filled blocks, and sort all keys.
+				uint32_t num = 0;
+				for (uint32_t ii = 0, numRuns = m_numRenderItemRuns; ii < numRuns; ++ii)
+				{
+					const RenderItemRun& run = m_renderItemRun[ii];
+					bx::memCopy(&s_ctx->m_tempKeys[num],   &m_sortKeys[run.m_begin],   run.m_num*sizeof(uint64_t) );
+					bx::memCopy(&s_ctx->m_tempValues[num], &m_sortValues[run.m_begin], run.m_num*sizeof(RenderItemCount) );
+					num += run.m_num;
+				}
+
+				m_numRenderItems    = num;
+				m_numRenderItemRuns = 0;
+
+				bx::memCopy(m_sortKeys,   s_ctx->m_tempKeys,   num*sizeof(uint64_t) );
+				bx::memCopy(m_sortValues, s_ctx->m_tempValues, num*sizeof(RenderItemCount) );
+			}
+		}
+
+		if (merged)
 		{
-			m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
+			// Render items are already sorted.
+		}
+		else if (BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS <= m_numRenderItems
+		&&  0 < s_ctx->m_jobPool.getNumThreads() )
+		{
+			uint32_t histogram[BGFX_CONFIG_MAX_VIEWS];
+			bx::memSet(histogram, 0, sizeof(histogram) );
+
+			for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+			{
+				const uint64_t key = SortKey::remapView(m_sortKeys[ii], viewRemap);
+				m_sortKeys[ii] = key;
+				++histogram[SortKey::decodeView(key)];
+			}
+
+			SortViewJob job;
+			job.m_keys      = s_ctx->m_tempKeys;
+			job.m_values    = s_ctx->m_tempValues;
+			job.m_outKeys   = m_sortKeys;
+			job.m_outValues = m_sortValues;
+
+			uint32_t numJobs = 0;
+			uint32_t offset[BGFX_CONFIG_MAX_VIEWS];
+			for (uint32_t ii = 0, begin = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+			{
+				offset[ii] = begin;
+
+				if (0 != histogram[ii])
+				{
+					job.m_begin[numJobs] = begin;
+					job.m_num[numJobs]   = histogram[ii];
+					++numJobs;
+				}
+
+				begin += histogram[ii];
+			}
+
+			// Bucket keys by view, after this each view's keys are sorted independently.
+			for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+			{
+				const uint64_t key = m_sortKeys[ii];
+				const uint32_t dst = offset[SortKey::decodeView(key)]++;
+				s_ctx->m_tempKeys[dst]   = key;
+				s_ctx->m_tempValues[dst] = m_sortValues[ii];
+			}
+
+			s_ctx->m_jobPool.run(sortViewJob, &job, numJobs);
 		}
+		else
+		{
+			for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+			{
+				m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
+			}
 
-		bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
+			bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
+		}
 
 		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
 		{
 			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
 		}
 
-		bx::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
+		bx::radixSort(m_blitKeys, (uint32_t*)s_ctx->m_tempKeys, m_numBlitItems);
+
+		m_perfStats.cpuTimeSort = bx::getHPCounter() - timeBegin;
 	}
 
 	RenderFrame::Enum renderFrame(int32_t _msecs)
@@ -1511,6 +1953,69 @@ namespace bgfx
 		write(&_handle, sizeof(UniformHandle) );
 	}
 
+	void UniformBlock::set(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num)
+	{
+		const uint32_t size = g_uniformTypeSize[_type]*_num;
+
+		for (uint32_t pos = 0; pos < m_size;)
+		{
+			uint32_t opcode;
+			bx::memCopy(&opcode, &m_data[pos], sizeof(uint32_t) );
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+			const uint32_t entrySize = sizeof(uint32_t) + g_uniformTypeSize[type]*num;
+
+			if (loc == _loc)
+			{
+				if (type == _type
+				&&  num  == _num)
+				{
+					bx::memCopy(&m_data[pos + sizeof(uint32_t)], _value, size);
+					return;
+				}
+
+				bx::memMove(&m_data[pos], &m_data[pos + entrySize], m_size - pos - entrySize);
+				m_size -= entrySize;
+				break;
+			}
+
+			pos += entrySize;
+		}
+
+		const uint32_t entrySize = sizeof(uint32_t) + size;
+		if (m_size + entrySize > m_max)
+		{
+			m_max  = bx::max(m_max*2, m_size + entrySize, 256u);
+			m_data = (char*)BX_REALLOC(g_allocator, m_data, m_max);
+		}
+
+		const uint32_t opcode = UniformBuffer::encodeOpcode(_type, _loc, _num, true);
+		bx::memCopy(&m_data[m_size], &opcode, sizeof(uint32_t) );
+		bx::memCopy(&m_data[m_size + sizeof(uint32_t)], _value, size);
+		m_size += entrySize;
+	}
+
+	void RenderUniformBlock::update(const void* _data, uint32_t _size)
+	{
+		if (NULL == m_uniformBuffer)
+		{
+			m_uniformBuffer = UniformBuffer::create(bx::max<uint32_t>(_size*2, 256) );
+		}
+
+		m_uniformBuffer->reset();
+		UniformBuffer::update(&m_uniformBuffer, _size + sizeof(uint32_t), _size + sizeof(uint32_t) );
+		m_uniformBuffer->write(_data, _size);
+		m_uniformBuffer->finish();
+
+		m_size = _size;
+		m_hash = bx::hash<bx::HashMurmur2A>(_data, _size);
+	}
+
 	void UniformBuffer::writeMarker(const char* _marker)
 	{
 		uint16_t num = (uint16_t)bx::strLen(_marker)+1;
@@ -1546,6 +2051,7 @@ namespace bgfx
 		CAPS_FLAGS(BGFX_CAPS_SWAP_CHAIN),
 		CAPS_FLAGS(BGFX_CAPS_TEXTURE_2D_ARRAY),
 		CAPS_FLAGS(BGFX_CAPS_TEXTURE_3D),
+		CAPS_FLAGS(BGFX_CAPS_TEXTURE_BINDLESS),
 		CAPS_FLAGS(BGFX_CAPS_TEXTURE_BLIT),
 		CAPS_FLAGS(BGFX_CAPS_TEXTURE_COMPARE_ALL),
 		CAPS_FLAGS(BGFX_CAPS_TEXTURE_COMPARE_LEQUAL),
@@ -1768,12 +2274,211 @@ namespace bgfx
 					;
 		}
 
-		if (convert)
+		if (convert)
+		{
+			return TextureFormat::BGRA8;
+		}
+
+		return TextureFormat::Enum(_imageContainer.m_format);
+	}
+
+	bool TextureDecoder::needsDecode(const bimg::ImageContainer& _imageContainer, const Memory* _mem)
+	{
+		if (NULL == _imageContainer.m_data
+		||  getViableTextureFormat(_imageContainer) == TextureFormat::Enum(_imageContainer.m_format) )
+		{
+			return false;
+		}
+
+		bx::MemoryReader reader(_mem->data, _mem->size);
+
+		uint32_t magic;
+		bx::read(&reader, magic);
+
+		if (BGFX_CHUNK_MAGIC_TEX == magic)
+		{
+			TextureCreate tc;
+			bx::read(&reader, tc);
+
+			return NULL != tc.m_mem;
+		}
+
+		return true;
+	}
+
+	static void decodeToBgra8(uint8_t* _dst, const bimg::ImageMip& _mip, uint32_t _width, uint32_t _height)
+	{
+		const uint32_t dstPitch  = _width*4;
+		const uint32_t dstSlice  = dstPitch*_height;
+		const uint32_t srcSlice  = _mip.m_size / _mip.m_depth;
+		const bool     blockPad  = _mip.m_width != _width || _mip.m_height != _height;
+		const uint32_t tempPitch = _mip.m_width*4;
+
+		uint8_t* temp = blockPad
+			? (uint8_t*)BX_ALLOC(g_allocator, tempPitch*_mip.m_height)
+			: NULL
+			;
+
+		for (uint32_t zz = 0; zz < _mip.m_depth; ++zz)
+		{
+			const uint8_t* src = _mip.m_data + zz*srcSlice;
+			uint8_t*       dst = _dst + zz*dstSlice;
+
+			if (blockPad)
+			{
+				// Block compressed mips smaller than block are decoded at block size, and only
+				// used part is kept.
+				bimg::imageDecodeToBgra8(g_allocator, temp, src, _mip.m_width, _mip.m_height, tempPitch, _mip.m_format);
+				bx::memCopy(dst, dstPitch, temp, tempPitch, dstPitch, _height);
+			}
+			else
+			{
+				bimg::imageDecodeToBgra8(g_allocator, dst, src, _width, _height, dstPitch, _mip.m_format);
+			}
+		}
+
+		if (NULL != temp)
+		{
+			BX_FREE(g_allocator, temp);
+		}
+	}
+
+	void TextureDecoder::getDecodedCreate(TextureCreate& _create, const bimg::ImageContainer& _imageContainer, uint8_t _skip)
+	{
+		const uint8_t startLod = bx::min<uint8_t>(_skip, _imageContainer.m_numMips - 1);
+		const uint16_t depth   = uint16_t(bx::max<uint32_t>(1, _imageContainer.m_depth >> startLod) );
+
+		_create.m_width     = uint16_t(bx::max<uint32_t>(1, _imageContainer.m_width  >> startLod) );
+		_create.m_height    = uint16_t(bx::max<uint32_t>(1, _imageContainer.m_height >> startLod) );
+		_create.m_depth     = 1 < _imageContainer.m_depth ? depth : 0;
+		_create.m_numLayers = _imageContainer.m_numLayers;
+		_create.m_numMips   = _imageContainer.m_numMips - startLod;
+		_create.m_format    = TextureFormat::BGRA8;
+		_create.m_cubeMap   = _imageContainer.m_cubeMap;
+		_create.m_mem       = NULL;
+	}
+
+	void TextureDecoder::decode(Job& _job)
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Texture decode", 0xff2040ff);
+
+		const Memory* mem = _job.m_mem;
+
+		bimg::ImageContainer imageContainer;
+		if (!bimg::imageParse(imageContainer, mem->data, mem->size) )
+		{
+			return;
+		}
+
+		TextureCreate tc;
+		getDecodedCreate(tc, imageContainer, _job.m_skip);
+
+		const uint8_t  startLod = bx::min<uint8_t>(_job.m_skip, imageContainer.m_numMips - 1);
+		const uint16_t width    = tc.m_width;
+		const uint16_t height   = tc.m_height;
+		const uint16_t depth    = bx::max<uint16_t>(1, tc.m_depth);
+		const uint8_t  numMips  = tc.m_numMips;
+		const uint16_t numSides = imageContainer.m_numLayers * (imageContainer.m_cubeMap ? 6 : 1);
+
+		uint32_t size = 0;
+		for (uint8_t lod = 0; lod < numMips; ++lod)
+		{
+			size += bx::max<uint32_t>(1, width  >> lod)
+				  * bx::max<uint32_t>(1, height >> lod)
+				  * bx::max<uint32_t>(1, depth  >> lod)
+				  * 4
+				  ;
+		}
+
+		const Memory* data = alloc(size*numSides);
+		uint8_t* dst = data->data;
+
+		for (uint16_t side = 0; side < numSides; ++side)
+		{
+			for (uint8_t lod = 0; lod < numMips; ++lod)
+			{
+				const uint32_t mipWidth  = bx::max<uint32_t>(1, width  >> lod);
+				const uint32_t mipHeight = bx::max<uint32_t>(1, height >> lod);
+				const uint32_t mipDepth  = bx::max<uint32_t>(1, depth  >> lod);
+
+				bimg::ImageMip mip;
+				if (bimg::imageGetRawData(imageContainer, side, lod + startLod, mem->data, mem->size, mip) )
+				{
+					decodeToBgra8(dst, mip, mipWidth, mipHeight);
+				}
+
+				dst += mipWidth*mipHeight*mipDepth*4;
+			}
+		}
+
+		const Memory* header = alloc(sizeof(uint32_t) + sizeof(TextureCreate) );
+
+		bx::StaticMemoryBlockWriter writer(header->data, header->size);
+		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
+		bx::write(&writer, magic);
+
+		tc.m_mem = data;
+		bx::write(&writer, tc);
+
+		bx::MemoryReader reader(mem->data, mem->size);
+		bx::read(&reader, magic);
+
+		if (BGFX_CHUNK_MAGIC_TEX == magic)
 		{
-			return TextureFormat::BGRA8;
+			bx::read(&reader, tc);
+			release(tc.m_mem);
 		}
 
-		return TextureFormat::Enum(_imageContainer.m_format);
+		_job.m_src  = mem;
+		_job.m_mem  = header;
+		_job.m_skip = 0;
+	}
+
+	uint32_t getTextureMipSize(TextureFormat::Enum _format, uint16_t _width, uint16_t _height, uint8_t _mip)
+	{
+		const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(bimg::TextureFormat::Enum(_format) );
+		const uint32_t blockWidth  = blockInfo.blockWidth;
+		const uint32_t blockHeight = blockInfo.blockHeight;
+		const uint32_t width  = bx::max<uint32_t>(1, _width  >> _mip);
+		const uint32_t height = bx::max<uint32_t>(1, _height >> _mip);
+		const uint32_t numBlocksX = bx::max<uint32_t>(blockInfo.minBlockX, (width  + blockWidth  - 1) / blockWidth);
+		const uint32_t numBlocksY = bx::max<uint32_t>(blockInfo.minBlockY, (height + blockHeight - 1) / blockHeight);
+
+		return numBlocksX*numBlocksY*blockInfo.blockSize;
+	}
+
+	const Memory* decodeTextureUpdate(TextureFormat::Enum _format, uint16_t _width, uint16_t _height, uint16_t _depth, uint16_t& _pitch, const Memory* _mem)
+	{
+		const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(bimg::TextureFormat::Enum(_format) );
+		const uint32_t blockWidth  = blockInfo.blockWidth;
+		const uint32_t blockHeight = blockInfo.blockHeight;
+		const uint32_t width  = bx::max<uint32_t>(blockWidth  * blockInfo.minBlockX, ( (_width  + blockWidth  - 1) / blockWidth )*blockWidth);
+		const uint32_t height = bx::max<uint32_t>(blockHeight * blockInfo.minBlockY, ( (_height + blockHeight - 1) / blockHeight)*blockHeight);
+
+		BX_WARN(UINT16_MAX == _pitch || _pitch == width*blockInfo.bitsPerPixel/8
+			, "Texture update with custom pitch %d in format %s that needs decode is not supported."
+			, _pitch
+			, getName(_format)
+			);
+
+		bimg::ImageMip mip;
+		mip.m_width     = width;
+		mip.m_height    = height;
+		mip.m_depth     = bx::max<uint16_t>(1, _depth);
+		mip.m_blockSize = blockInfo.blockSize;
+		mip.m_size      = _mem->size;
+		mip.m_bpp       = blockInfo.bitsPerPixel;
+		mip.m_format    = bimg::TextureFormat::Enum(_format);
+		mip.m_hasAlpha  = false;
+		mip.m_data      = _mem->data;
+
+		const Memory* data = alloc(width*height*mip.m_depth*4);
+		decodeToBgra8(data->data, mip, width, height);
+
+		release(_mem);
+
+		_pitch = uint16_t(width*4);
+		return data;
 	}
 
 	const char* getName(TextureFormat::Enum _fmt)
@@ -1898,10 +2603,26 @@ namespace bgfx
 		m_debug   = BGFX_DEBUG_NONE;
 		m_frameTimeLast = bx::getHPCounter();
 
-		m_submit->create(_init.limits.minResourceCbSize);
+		m_submit->create(_init.limits.minResourceCbSize, _init.limits.renderItemBlock);
+
+		m_renderItemCapacity  = BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE;
+		m_renderItemPeak      = 0;
+		m_renderItemLowFrames = 0;
+		m_matrixCacheCapacity = BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE+1;
+		resizeTempItems(m_renderItemCapacity);
+
+		m_jobPool.init(m_init.limits.numWorkerThreads);
+		BX_TRACE("Number of worker threads: %d", m_jobPool.getNumThreads() );
+
+		m_textureDecoder.init(&m_jobPool);
+
+		m_numTextureStreamUploads = 0;
+		m_textureStreamSeq        = 0;
+		m_textureStreamResident   = 0;
+		m_textureStreamPending    = 0;
 
 #if BGFX_CONFIG_MULTITHREADED
-		m_render->create(_init.limits.minResourceCbSize);
+		m_render->create(_init.limits.minResourceCbSize, _init.limits.renderItemBlock);
 
 		if (s_renderFrameCalled)
 		{
@@ -1957,7 +2678,7 @@ namespace bgfx
 		m_encoderStats  = (EncoderStats*)BX_ALLOC(g_allocator, sizeof(EncoderStats)*_init.limits.maxEncoders);
 		for (uint32_t ii = 0, num = _init.limits.maxEncoders; ii < num; ++ii)
 		{
-			BX_PLACEMENT_NEW(&m_encoder[ii], EncoderImpl);
+			BX_PLACEMENT_NEW(&m_encoder[ii], EncoderImpl)(_init.limits.renderItemBlock);
 		}
 
 		uint16_t idx = m_encoderHandle->alloc();
@@ -1979,6 +2700,9 @@ namespace bgfx
 #if BGFX_CONFIG_MULTITHREADED
 			m_render->destroy();
 #endif // BGFX_CONFIG_MULTITHREADED
+			m_textureDecoder.shutdown();
+			m_jobPool.shutdown();
+			resizeTempItems(0);
 			return false;
 		}
 
@@ -2012,14 +2736,14 @@ namespace bgfx
 		m_textVideoMemBlitter.init();
 		m_clearQuad.init();
 
-		m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
-		m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
+		m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize, NULL, BGFX_BUFFER_INTERNAL_TRANSIENT);
+		m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize, BGFX_BUFFER_INTERNAL_TRANSIENT);
 		frame();
 
 		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
 		{
-			m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
-			m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
+			m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize, NULL, BGFX_BUFFER_INTERNAL_TRANSIENT);
+			m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize, BGFX_BUFFER_INTERNAL_TRANSIENT);
 			frame();
 		}
 
@@ -2030,11 +2754,15 @@ namespace bgfx
 
 	void Context::shutdown()
 	{
+		flushTextureDecode();
+
 		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
 		frame();
 
 		destroyTransientVertexBuffer(m_submit->m_transientVb);
 		destroyTransientIndexBuffer(m_submit->m_transientIb);
+		m_submit->m_transientVb = NULL;
+		m_submit->m_transientIb = NULL;
 		m_textVideoMemBlitter.shutdown();
 		m_clearQuad.shutdown();
 		frame();
@@ -2043,6 +2771,8 @@ namespace bgfx
 		{
 			destroyTransientVertexBuffer(m_submit->m_transientVb);
 			destroyTransientIndexBuffer(m_submit->m_transientIb);
+			m_submit->m_transientVb = NULL;
+			m_submit->m_transientIb = NULL;
 			frame();
 		}
 
@@ -2064,6 +2794,16 @@ namespace bgfx
 		BX_ALIGNED_FREE(g_allocator, m_encoder, BX_ALIGNOF(EncoderImpl) );
 		BX_FREE(g_allocator, m_encoderStats);
 
+		for (uint16_t ii = 0, num = m_bundleHandle.getNumHandles(); ii < num; ++ii)
+		{
+			m_bundle[m_bundleHandle.getHandleAt(ii)].destroy();
+		}
+
+		for (uint16_t ii = 0, num = m_uniformBlockHandle.getNumHandles(); ii < num; ++ii)
+		{
+			m_uniformBlock[m_uniformBlockHandle.getHandleAt(ii)].destroy();
+		}
+
 		m_dynVertexBufferAllocator.compact();
 		m_dynIndexBufferAllocator.compact();
 
@@ -2091,6 +2831,10 @@ namespace bgfx
 		m_render->destroy();
 #endif // BGFX_CONFIG_MULTITHREADED
 
+		m_textureDecoder.shutdown();
+		m_jobPool.shutdown();
+		resizeTempItems(0);
+
 		bx::memSet(&g_internalData, 0, sizeof(InternalData) );
 		s_ctx = NULL;
 
@@ -2170,6 +2914,8 @@ namespace bgfx
 			CHECK_HANDLE_LEAK_NAME   ("FrameBufferHandle",         m_frameBufferHandle,        FrameBufferRef, m_frameBufferRef);
 			CHECK_HANDLE_LEAK_RC_NAME("UniformHandle",             m_uniformHandle,            UniformRef,     m_uniformRef    );
 			CHECK_HANDLE_LEAK        ("OcclusionQueryHandle",      m_occlusionQueryHandle                                      );
+			CHECK_HANDLE_LEAK        ("BundleHandle",              m_bundleHandle                                              );
+			CHECK_HANDLE_LEAK        ("UniformBlockHandle",        m_uniformBlockHandle                                        );
 #undef CHECK_HANDLE_LEAK
 #undef CHECK_HANDLE_LEAK_NAME
 		}
@@ -2196,6 +2942,28 @@ namespace bgfx
 		m_numFreeOcclusionQueryHandles = 0;
 	}
 
+	void Context::updateUniformBlocks()
+	{
+		for (uint16_t ii = 0, num = m_numDirtyUniformBlocks; ii < num; ++ii)
+		{
+			const UniformBlockHandle handle = m_dirtyUniformBlock[ii];
+			UniformBlock& block = m_uniformBlock[handle.idx];
+
+			// Block might be destroyed after it was updated.
+			if (block.m_dirty)
+			{
+				block.m_dirty = false;
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateUniformBlock);
+				cmdbuf.write(handle);
+				cmdbuf.write(block.m_size);
+				cmdbuf.write(block.m_data, block.m_size);
+			}
+		}
+
+		m_numDirtyUniformBlocks = 0;
+	}
+
 	void Context::freeAllHandles(Frame* _frame)
 	{
 		for (uint16_t ii = 0, num = _frame->m_freeIndexBuffer.getNumQueued(); ii < num; ++ii)
@@ -2237,6 +3005,18 @@ namespace bgfx
 		{
 			m_uniformHandle.free(_frame->m_freeUniform.get(ii).idx);
 		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeUniformBlock.getNumQueued(); ii < num; ++ii)
+		{
+			m_uniformBlockHandle.free(_frame->m_freeUniformBlock.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeBundle.getNumQueued(); ii < num; ++ii)
+		{
+			const BundleHandle handle = _frame->m_freeBundle.get(ii);
+			m_bundle[handle.idx].destroy();
+			m_bundleHandle.free(handle.idx);
+		}
 	}
 
 	Encoder* Context::begin(bool _forThread)
@@ -2291,6 +3071,9 @@ namespace bgfx
 		encoderApiWait();
 #endif // BGFX_CONFIG_MULTITHREADED
 
+		retireTextureDecode();
+		flushTextureStream(m_init.limits.textureStreamSize);
+
 		m_submit->m_capture = _capture;
 
 		BGFX_PROFILER_SCOPE("bgfx/API thread frame", 0xff2040ff);
@@ -2328,6 +3111,8 @@ namespace bgfx
 			bx::memCopy(m_submit->m_colorPalette, m_clearColor, sizeof(m_clearColor) );
 		}
 
+		updateUniformBlocks();
+
 		freeAllHandles(m_submit);
 		m_submit->resetFreeHandles();
 
@@ -2337,15 +3122,30 @@ namespace bgfx
 
 		bx::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
 
+		const uint32_t renderItemDemand  = m_render->getRenderItemDemand();
+		const uint32_t matrixCacheDemand = m_render->m_frameCache.m_matrixCache.getDemand();
+		const uint32_t vbDemand = m_render->m_vbdemand;
+		const uint32_t ibDemand = m_render->m_ibdemand;
+
 		if (!BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
 		||  m_singleThreaded)
 		{
 			renderFrame();
 		}
 
+		// Render thread is not using submit frame, nor sorting at this point.
+		updateRenderItemCapacity(renderItemDemand);
+		updateMatrixCacheCapacity(matrixCacheDemand);
+		m_submit->resizeRenderItems(m_renderItemCapacity);
+		m_submit->m_frameCache.m_matrixCache.resize(m_matrixCacheCapacity);
+		resizeTempItems(bx::max(m_render->m_maxRenderItems, m_submit->m_maxRenderItems) );
+
 		m_frames++;
 		m_submit->start();
 
+		// Must be after start, recreated transient buffers are pre commands of the new submit frame.
+		updateTransientBufferCapacity(vbDemand, ibDemand);
+
 		bx::memSet(m_seq, 0, sizeof(m_seq) );
 
 		m_submit->m_textVideoMem->resize(
@@ -2359,6 +3159,122 @@ namespace bgfx
 		m_frameTimeLast = now;
 	}
 
+	void Context::updateRenderItemCapacity(uint32_t _demand)
+	{
+		const uint32_t chunk = BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE;
+		const uint32_t limit = m_init.limits.maxDrawCalls;
+
+		if (_demand > m_renderItemCapacity)
+		{
+			// Grow with some headroom so that slowly increasing demand doesn't drop draws every frame.
+			m_renderItemCapacity  = bx::min(bx::strideAlign(_demand + _demand/2, chunk), limit);
+			m_renderItemPeak      = 0;
+			m_renderItemLowFrames = 0;
+			return;
+		}
+
+		m_renderItemPeak = bx::max(m_renderItemPeak, _demand);
+
+		if (m_renderItemPeak < m_renderItemCapacity/4)
+		{
+			++m_renderItemLowFrames;
+
+			if (BGFX_CONFIG_RENDER_ITEM_SHRINK_FRAMES <= m_renderItemLowFrames)
+			{
+				m_renderItemCapacity  = bx::max(bx::strideAlign(m_renderItemPeak*2, chunk), chunk);
+				m_renderItemPeak      = 0;
+				m_renderItemLowFrames = 0;
+			}
+		}
+		else
+		{
+			m_renderItemPeak      = 0;
+			m_renderItemLowFrames = 0;
+		}
+	}
+
+	void Context::updateMatrixCacheCapacity(uint32_t _demand)
+	{
+		// Matrix cache grows with render items (one transform per draw call), and past them when
+		// draw calls use multiple matrices. Like transient buffers, it doesn't shrink.
+		const uint32_t chunk = BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE;
+		const uint32_t limit = bx::max<uint32_t>(BGFX_CONFIG_MAX_MATRIX_CACHE, m_init.limits.maxDrawCalls+1);
+
+		uint32_t capacity = bx::max(m_matrixCacheCapacity, m_renderItemCapacity+1);
+
+		if (_demand > m_matrixCacheCapacity)
+		{
+			// Grow with some headroom so that slowly increasing demand doesn't drop draws every frame.
+			capacity = bx::max(capacity, bx::strideAlign(_demand + _demand/2, chunk) );
+		}
+
+		m_matrixCacheCapacity = bx::min(capacity, limit);
+	}
+
+	void Context::updateTransientBufferCapacity(uint32_t _vbDemand, uint32_t _ibDemand)
+	{
+		// Each frame owns its transient buffers. The render thread is done with the submit frame,
+		// so its buffers can be replaced here. The other frame catches up on the next swap since
+		// demand is tracked unclamped.
+		if (NULL != m_submit->m_transientVb
+		&&  _vbDemand > m_submit->m_transientVb->size
+		&&  m_submit->m_transientVb->size < BGFX_CONFIG_MAX_TRANSIENT_VERTEX_BUFFER_SIZE)
+		{
+			const uint32_t size = bx::min<uint32_t>(
+				  bx::strideAlign(_vbDemand + _vbDemand/2, 64<<10)
+				, BGFX_CONFIG_MAX_TRANSIENT_VERTEX_BUFFER_SIZE
+				);
+
+			BX_TRACE("Growing transient vertex buffer %d -> %d bytes.", m_submit->m_transientVb->size, size);
+			destroyTransientVertexBuffer(m_submit->m_transientVb);
+			m_submit->m_transientVb = createTransientVertexBuffer(size, NULL, BGFX_BUFFER_INTERNAL_TRANSIENT);
+			BX_ASSERT(NULL != m_submit->m_transientVb, "Failed to grow transient vertex buffer.");
+		}
+
+		if (NULL != m_submit->m_transientIb
+		&&  _ibDemand > m_submit->m_transientIb->size
+		&&  m_submit->m_transientIb->size < BGFX_CONFIG_MAX_TRANSIENT_INDEX_BUFFER_SIZE)
+		{
+			const uint32_t size = bx::min<uint32_t>(
+				  bx::strideAlign(_ibDemand + _ibDemand/2, 64<<10)
+				, BGFX_CONFIG_MAX_TRANSIENT_INDEX_BUFFER_SIZE
+				);
+
+			BX_TRACE("Growing transient index buffer %d -> %d bytes.", m_submit->m_transientIb->size, size);
+			destroyTransientIndexBuffer(m_submit->m_transientIb);
+			m_submit->m_transientIb = createTransientIndexBuffer(size, BGFX_BUFFER_INTERNAL_TRANSIENT);
+			BX_ASSERT(NULL != m_submit->m_transientIb, "Failed to grow transient index buffer.");
+		}
+
+		if (NULL != m_submit->m_transientVb
+		&&  NULL != m_render->m_transientVb)
+		{
+			g_caps.limits.transientVbSize = bx::min(m_submit->m_transientVb->size, m_render->m_transientVb->size);
+			g_caps.limits.transientIbSize = bx::min(m_submit->m_transientIb->size, m_render->m_transientIb->size);
+		}
+	}
+
+	void Context::resizeTempItems(uint32_t _num)
+	{
+		if (_num == m_maxTempItems)
+		{
+			return;
+		}
+
+		BX_FREE(g_allocator, m_tempKeys);
+		BX_FREE(g_allocator, m_tempValues);
+		m_tempKeys   = NULL;
+		m_tempValues = NULL;
+
+		m_maxTempItems = _num;
+
+		if (0 < _num)
+		{
+			m_tempKeys   = (uint64_t*       )BX_ALLOC(g_allocator, sizeof(uint64_t)*_num);
+			m_tempValues = (RenderItemCount*)BX_ALLOC(g_allocator, sizeof(RenderItemCount)*_num);
+		}
+	}
+
 	///
 	RendererContextI* rendererCreate(const Init& _init);
 
@@ -2431,6 +3347,8 @@ namespace bgfx
 			{
 				{
 					BGFX_PROFILER_SCOPE("bgfx/Render submit", 0xff2040ff);
+					m_uniformBlockApplied  = false;
+					m_uniformBlockLast.idx = kInvalidHandle;
 					m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
 					m_flipped = false;
 				}
@@ -2471,6 +3389,12 @@ namespace bgfx
 
 	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
 	{
+		if (_begin < _end)
+		{
+			// Uniforms set per draw call might override values set by uniform block.
+			s_ctx->m_uniformBlockApplied = false;
+		}
+
 		_uniformBuffer->reset(_begin);
 		while (_uniformBuffer->getPos() < _end)
 		{
@@ -2507,6 +3431,46 @@ namespace bgfx
 		}
 	}
 
+	bool rendererUpdateUniforms(RendererContextI* _renderCtx, const Frame* _render, const RenderDraw& _draw)
+	{
+		bool changed = false;
+
+		if (isValid(_draw.m_uniformBlock) )
+		{
+			const RenderUniformBlock& block = s_ctx->m_renderUniformBlock[_draw.m_uniformBlock.idx];
+
+			// Blocks with identical content are replayed only once, until other uniform
+			// updates invalidate values written by block. Blocks don't change during
+			// submit, so same block is never replayed twice.
+			const bool applied = s_ctx->m_uniformBlockApplied
+				&& (s_ctx->m_uniformBlockLast.idx == _draw.m_uniformBlock.idx
+				||  block.isEqual(s_ctx->m_renderUniformBlock[s_ctx->m_uniformBlockLast.idx]) )
+				;
+
+			if (0 < block.m_size
+			&&  !applied)
+			{
+				rendererUpdateUniforms(_renderCtx, block.m_uniformBuffer, 0, block.m_size);
+				s_ctx->m_uniformBlockApplied = true;
+				s_ctx->m_uniformBlockLast    = _draw.m_uniformBlock;
+				changed = true;
+			}
+		}
+
+		if (_draw.m_uniformBegin < _draw.m_uniformEnd)
+		{
+			rendererUpdateUniforms(_renderCtx, _render->m_uniformBuffer[_draw.m_uniformIdx], _draw.m_uniformBegin, _draw.m_uniformEnd);
+			changed = true;
+		}
+
+		return changed;
+	}
+
+	JobPool& rendererGetJobPool()
+	{
+		return s_ctx->m_jobPool;
+	}
+
 	void Context::flushTextureUpdateBatch(CommandBuffer& _cmdbuf)
 	{
 		if (m_textureUpdateBatch.sort() )
@@ -2826,6 +3790,11 @@ namespace bgfx
 					rendererDestroy(m_renderCtx);
 					m_renderCtx = NULL;
 
+					for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_UNIFORM_BLOCKS; ++ii)
+					{
+						m_renderUniformBlock[ii].destroy();
+					}
+
 					m_exit = true;
 				}
 				BX_FALLTHROUGH;
@@ -3194,6 +4163,20 @@ namespace bgfx
 				}
 				break;
 
+			case CommandBuffer::SetTextureMinLod:
+				{
+					BGFX_PROFILER_SCOPE("SetTextureMinLod", 0xff2040ff);
+
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					uint8_t minLod;
+					_cmdbuf.read(minLod);
+
+					m_renderCtx->setTextureMinLod(handle, minLod);
+				}
+				break;
+
 			case CommandBuffer::DestroyTexture:
 				{
 					BGFX_PROFILER_SCOPE("DestroyTexture", 0xff2040ff);
@@ -3291,6 +4274,33 @@ namespace bgfx
 				}
 				break;
 
+			case CommandBuffer::UpdateUniformBlock:
+				{
+					BGFX_PROFILER_SCOPE("UpdateUniformBlock", 0xff2040ff);
+
+					UniformBlockHandle handle;
+					_cmdbuf.read(handle);
+
+					uint32_t size;
+					_cmdbuf.read(size);
+
+					const uint8_t* data = _cmdbuf.skip(size);
+
+					m_renderUniformBlock[handle.idx].update(data, size);
+				}
+				break;
+
+			case CommandBuffer::DestroyUniformBlock:
+				{
+					BGFX_PROFILER_SCOPE("DestroyUniformBlock", 0xff2040ff);
+
+					UniformBlockHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderUniformBlock[handle.idx].destroy();
+				}
+				break;
+
 			case CommandBuffer::UpdateViewName:
 				{
 					BGFX_PROFILER_SCOPE("UpdateViewName", 0xff2040ff);
@@ -3334,6 +4344,42 @@ namespace bgfx
 				}
 				break;
 
+			case CommandBuffer::PrewarmPipeline:
+				{
+					BGFX_PROFILER_SCOPE("PrewarmPipeline", 0xff2040ff);
+
+					ProgramHandle program;
+					_cmdbuf.read(program);
+
+					uint64_t state;
+					_cmdbuf.read(state);
+
+					VertexLayoutHandle layoutHandle;
+					_cmdbuf.read(layoutHandle);
+
+					FrameBufferHandle frameBuffer;
+					_cmdbuf.read(frameBuffer);
+
+					m_renderCtx->prewarmPipeline(program, state, layoutHandle, frameBuffer);
+				}
+				break;
+
+			case CommandBuffer::FlushPipelineCache:
+				{
+					BGFX_PROFILER_SCOPE("FlushPipelineCache", 0xff2040ff);
+
+					m_renderCtx->flushPipelineCache();
+				}
+				break;
+
+			case CommandBuffer::Defragment:
+				{
+					BGFX_PROFILER_SCOPE("Defragment", 0xff2040ff);
+
+					m_renderCtx->defragment();
+				}
+				break;
+
 			default:
 				BX_ASSERT(false, "Invalid command: %d", command);
 				break;
@@ -3348,6 +4394,14 @@ namespace bgfx
 		return weldVertices(_output, _layout, _data, _num, _index32, _epsilon, g_allocator);
 	}
 
+	uint32_t weldVertices(void* _output, void* _outVertices, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, bool _attributes)
+	{
+		BX_ASSERT(NULL != _outVertices, "weldVertices: Output vertex stream must not be NULL.");
+		BX_ASSERT(_layout.has(Attrib::Position), "weldVertices: Vertex layout must have position attribute.");
+		BX_ASSERT(_index32 || _num <= UINT16_MAX+1, "weldVertices: 16-bit remapping table can't index %d vertices.", _num);
+		return weldVertices(_output, _outVertices, _layout, _data, _num, _index32, _epsilon, _attributes, g_allocator);
+	}
+
 	uint32_t topologyConvert(TopologyConvert::Enum _conversion, void* _dst, uint32_t _dstSize, const void* _indices, uint32_t _numIndices, bool _index32)
 	{
 		return topologyConvert(_conversion, _dst, _dstSize, _indices, _numIndices, _index32, g_allocator);
@@ -3358,6 +4412,36 @@ namespace bgfx
 		topologySortTriList(_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32, g_allocator);
 	}
 
+	// Sorters can outlive allocator passed to init, they use their own allocator.
+	static bx::DefaultAllocator s_topologySorterAllocator;
+
+	TopologySorter* createTopologySorter(bx::AllocatorI* _allocator)
+	{
+		bx::AllocatorI* allocator = NULL != _allocator ? _allocator : &s_topologySorterAllocator;
+		TopologySorterImpl* sorter = BX_NEW(allocator, TopologySorterImpl)(allocator);
+		return reinterpret_cast<TopologySorter*>(sorter);
+	}
+
+	void destroy(TopologySorter* _sorter)
+	{
+		TopologySorterImpl* sorter = reinterpret_cast<TopologySorterImpl*>(_sorter);
+		BX_DELETE(sorter->getAllocator(), sorter);
+	}
+
+#define BGFX_TOPOLOGY_SORTER(_func) reinterpret_cast<TopologySorterImpl*>(this)->_func
+
+	void TopologySorter::sortTriList(TopologySort::Enum _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32)
+	{
+		BGFX_TOPOLOGY_SORTER(sort(_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32) );
+	}
+
+	void TopologySorter::reset()
+	{
+		BGFX_TOPOLOGY_SORTER(reset() );
+	}
+
+#undef BGFX_TOPOLOGY_SORTER
+
 	uint8_t getSupportedRenderers(uint8_t _max, RendererType::Enum* _enum)
 	{
 		_enum = _max == 0 ? NULL : _enum;
@@ -3418,6 +4502,10 @@ namespace bgfx
 		, minResourceCbSize(BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE)
 		, transientVbSize(BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE)
 		, transientIbSize(BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE)
+		, maxDrawCalls(BGFX_CONFIG_MAX_DRAW_CALLS)
+		, textureStreamSize(BGFX_CONFIG_TEXTURE_STREAM_SIZE)
+		, numWorkerThreads(BGFX_CONFIG_NUM_WORKER_THREADS)
+		, renderItemBlock(BGFX_CONFIG_ENCODER_RENDER_ITEM_BLOCK)
 	{
 	}
 
@@ -3455,6 +4543,8 @@ namespace bgfx
 
 		init.limits.maxEncoders       = bx::clamp<uint16_t>(init.limits.maxEncoders, 1, (0 != BGFX_CONFIG_MULTITHREADED) ? 128 : 1);
 		init.limits.minResourceCbSize = bx::min<uint32_t>(init.limits.minResourceCbSize, BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE);
+		init.limits.maxDrawCalls      = bx::max<uint32_t>(init.limits.maxDrawCalls, BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+		init.limits.renderItemBlock   = bx::min<uint16_t>(init.limits.renderItemBlock, BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE-1);
 
 		struct ErrorState
 		{
@@ -3489,7 +4579,7 @@ namespace bgfx
 		}
 
 		bx::memSet(&g_caps, 0, sizeof(g_caps) );
-		g_caps.limits.maxDrawCalls            = BGFX_CONFIG_MAX_DRAW_CALLS;
+		g_caps.limits.maxDrawCalls            = init.limits.maxDrawCalls;
 		g_caps.limits.maxBlits                = BGFX_CONFIG_MAX_BLIT_ITEMS;
 		g_caps.limits.maxTextureSize          = 0;
 		g_caps.limits.maxTextureLayers        = 1;
@@ -3673,6 +4763,12 @@ namespace bgfx
 		BGFX_ENCODER(setUniform(uniform.m_type, _handle, _value, UINT16_MAX != _num ? _num : uniform.m_num) );
 	}
 
+	void Encoder::setUniformBlock(UniformBlockHandle _handle)
+	{
+		BGFX_CHECK_HANDLE("setUniformBlock", s_ctx->m_uniformBlockHandle, _handle);
+		BGFX_ENCODER(setUniformBlock(_handle) );
+	}
+
 	void Encoder::setIndexBuffer(IndexBufferHandle _handle)
 	{
 		setIndexBuffer(_handle, 0, UINT32_MAX);
@@ -3846,6 +4942,22 @@ namespace bgfx
 		BGFX_ENCODER(submit(_id, _program, _indirectHandle, _start, _num, _depth, _flags) );
 	}
 
+	void Encoder::beginBundle()
+	{
+		BGFX_ENCODER(beginBundle() );
+	}
+
+	BundleHandle Encoder::endBundle()
+	{
+		return BGFX_ENCODER(endBundle() );
+	}
+
+	void Encoder::submit(ViewId _id, BundleHandle _handle)
+	{
+		BGFX_CHECK_HANDLE("submit", s_ctx->m_bundleHandle, _handle);
+		BGFX_ENCODER(submit(_id, _handle) );
+	}
+
 	void Encoder::setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BX_ASSERT(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
@@ -3997,6 +5109,11 @@ namespace bgfx
 		return s_ctx->getPerfStats();
 	}
 
+	void defragment()
+	{
+		s_ctx->defragment();
+	}
+
 	RendererType::Enum getRendererType()
 	{
 		return g_caps.rendererType;
@@ -4331,6 +5448,16 @@ namespace bgfx
 		s_ctx->destroyProgram(_handle);
 	}
 
+	void prewarmPipeline(ProgramHandle _program, uint64_t _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer)
+	{
+		s_ctx->prewarmPipeline(_program, _state, _layoutHandle, _frameBuffer);
+	}
+
+	void flushPipelineCache()
+	{
+		s_ctx->flushPipelineCache();
+	}
+
 	void isFrameBufferValid(uint8_t _num, const Attachment* _attachment, bx::Error* _err)
 	{
 		BX_ERROR_SCOPE(_err, "Frame buffer validation");
@@ -4535,6 +5662,15 @@ namespace bgfx
 			, ""
 			);
 
+		BGFX_ERROR_CHECK(false
+			|| 0 == (_flags & BGFX_TEXTURE_STREAMING)
+			|| 0 == (_flags & BGFX_TEXTURE_BINDLESS)
+			, _err
+			, BGFX_ERROR_TEXTURE_VALIDATION
+			, "Can't create texture with both `BGFX_TEXTURE_STREAMING` and `BGFX_TEXTURE_BINDLESS` flags."
+			, ""
+			);
+
 		BGFX_ERROR_CHECK(false
 			|| 1 >= _numLayers
 			|| 0 != (g_caps.supported & BGFX_CAPS_TEXTURE_2D_ARRAY)
@@ -4680,8 +5816,11 @@ namespace bgfx
 		const uint8_t numMips = calcNumMips(_hasMips, _width, _height);
 		_numLayers = bx::max<uint16_t>(_numLayers, 1);
 
+		const bool streaming = 0 != (_flags & BGFX_TEXTURE_STREAMING);
+
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG)
-		&&  NULL != _mem)
+		&&  NULL != _mem
+		&&  !streaming)
 		{
 			TextureInfo ti;
 			calcTextureSize(ti, _width, _height, 1, false, _hasMips, _numLayers, _format);
@@ -4710,7 +5849,7 @@ namespace bgfx
 		tc.m_mem       = _mem;
 		bx::write(&writer, tc);
 
-		return s_ctx->createTexture(mem, _flags, 0, NULL, _ratio, NULL != _mem);
+		return s_ctx->createTexture(mem, _flags, 0, NULL, _ratio, NULL != _mem && !streaming);
 	}
 
 	TextureHandle createTexture2D(uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format, uint64_t _flags, const Memory* _mem)
@@ -4979,6 +6118,21 @@ namespace bgfx
 		s_ctx->destroyUniform(_handle);
 	}
 
+	UniformBlockHandle createUniformBlock()
+	{
+		return s_ctx->createUniformBlock();
+	}
+
+	void updateUniformBlock(UniformBlockHandle _handle, UniformHandle _uniform, const void* _value, uint16_t _num)
+	{
+		s_ctx->updateUniformBlock(_handle, _uniform, _value, _num);
+	}
+
+	void destroy(UniformBlockHandle _handle)
+	{
+		s_ctx->destroyUniformBlock(_handle);
+	}
+
 	OcclusionQueryHandle createOcclusionQuery()
 	{
 		BGFX_CHECK_CAPS(BGFX_CAPS_OCCLUSION_QUERY, "Occlusion query is not supported!");
@@ -4997,6 +6151,11 @@ namespace bgfx
 		s_ctx->destroyOcclusionQuery(_handle);
 	}
 
+	void destroy(BundleHandle _handle)
+	{
+		s_ctx->destroyBundle(_handle);
+	}
+
 	void setPaletteColor(uint8_t _index, uint32_t _rgba)
 	{
 		const uint8_t rr = uint8_t(_rgba>>24);
@@ -5163,6 +6322,12 @@ namespace bgfx
 		s_ctx->m_encoder0->setUniform(_handle, _value, _num);
 	}
 
+	void setUniformBlock(UniformBlockHandle _handle)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->setUniformBlock(_handle);
+	}
+
 	void setIndexBuffer(IndexBufferHandle _handle)
 	{
 		setIndexBuffer(_handle, 0, UINT32_MAX);
@@ -5313,6 +6478,24 @@ namespace bgfx
 		s_ctx->m_encoder0->submit(_id, _program, _indirectHandle, _start, _num, _depth, _flags);
 	}
 
+	void beginBundle()
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->beginBundle();
+	}
+
+	BundleHandle endBundle()
+	{
+		BGFX_CHECK_API_THREAD();
+		return s_ctx->m_encoder0->endBundle();
+	}
+
+	void submit(ViewId _id, BundleHandle _handle)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->submit(_id, _handle);
+	}
+
 	void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BGFX_CHECK_API_THREAD();
@@ -5575,6 +6758,7 @@ BX_STATIC_ASSERT( (0
 	| BGFX_CAPS_SWAP_CHAIN
 	| BGFX_CAPS_TEXTURE_2D_ARRAY
 	| BGFX_CAPS_TEXTURE_3D
+	| BGFX_CAPS_TEXTURE_BINDLESS
 	| BGFX_CAPS_TEXTURE_BLIT
 	| BGFX_CAPS_TEXTURE_CUBE_ARRAY
 	| BGFX_CAPS_TEXTURE_DIRECT_ACCESS
@@ -5600,6 +6784,7 @@ BX_STATIC_ASSERT( (0
 	^ BGFX_CAPS_SWAP_CHAIN
 	^ BGFX_CAPS_TEXTURE_2D_ARRAY
 	^ BGFX_CAPS_TEXTURE_3D
+	^ BGFX_CAPS_TEXTURE_BINDLESS
 	^ BGFX_CAPS_TEXTURE_BLIT
 	^ BGFX_CAPS_TEXTURE_CUBE_ARRAY
 	^ BGFX_CAPS_TEXTURE_DIRECT_ACCESS
@@ -120,6 +120,12 @@ BGFX_C_API uint32_t bgfx_weld_vertices(void* _output, const bgfx_vertex_layout_t
 	return bgfx::weldVertices(_output, layout, _data, _num, _index32, _epsilon);
 }
 
+BGFX_C_API uint32_t bgfx_weld_vertices_compact(void* _output, void* _outVertices, const bgfx_vertex_layout_t * _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, bool _attributes)
+{
+	const bgfx::VertexLayout & layout = *(const bgfx::VertexLayout *)_layout;
+	return bgfx::weldVertices(_output, _outVertices, layout, _data, _num, _index32, _epsilon, _attributes);
+}
+
 BGFX_C_API uint32_t bgfx_topology_convert(bgfx_topology_convert_t _conversion, void* _dst, uint32_t _dstSize, const void* _indices, uint32_t _numIndices, bool _index32)
 {
 	return bgfx::topologyConvert((bgfx::TopologyConvert::Enum)_conversion, _dst, _dstSize, _indices, _numIndices, _index32);
@@ -174,6 +180,11 @@ BGFX_C_API const bgfx_stats_t* bgfx_get_stats(void)
 	return (const bgfx_stats_t*)bgfx::getStats();
 }
 
+BGFX_C_API void bgfx_defragment(void)
+{
+	bgfx::defragment();
+}
+
 BGFX_C_API const bgfx_memory_t* bgfx_alloc(uint32_t _size)
 {
 	return (const bgfx_memory_t*)bgfx::alloc(_size);
@@ -428,6 +439,19 @@ BGFX_C_API void bgfx_destroy_program(bgfx_program_handle_t _handle)
 	bgfx::destroy(handle.cpp);
 }
 
+BGFX_C_API void bgfx_prewarm_pipeline(bgfx_program_handle_t _program, uint64_t _state, bgfx_vertex_layout_handle_t _layoutHandle, bgfx_frame_buffer_handle_t _frameBuffer)
+{
+	union { bgfx_program_handle_t c; bgfx::ProgramHandle cpp; } program = { _program };
+	union { bgfx_vertex_layout_handle_t c; bgfx::VertexLayoutHandle cpp; } layoutHandle = { _layoutHandle };
+	union { bgfx_frame_buffer_handle_t c; bgfx::FrameBufferHandle cpp; } frameBuffer = { _frameBuffer };
+	bgfx::prewarmPipeline(program.cpp, _state, layoutHandle.cpp, frameBuffer.cpp);
+}
+
+BGFX_C_API void bgfx_flush_pipeline_cache(void)
+{
+	bgfx::flushPipelineCache();
+}
+
 BGFX_C_API bool bgfx_is_texture_valid(uint16_t _depth, bool _cubeMap, uint16_t _numLayers, bgfx_texture_format_t _format, uint64_t _flags)
 {
 	return bgfx::isTextureValid(_depth, _cubeMap, _numLayers, (bgfx::TextureFormat::Enum)_format, _flags);
@@ -596,6 +620,26 @@ BGFX_C_API void bgfx_destroy_uniform(bgfx_uniform_handle_t _handle)
 	bgfx::destroy(handle.cpp);
 }
 
+BGFX_C_API bgfx_uniform_block_handle_t bgfx_create_uniform_block(void)
+{
+	union { bgfx_uniform_block_handle_t c; bgfx::UniformBlockHandle cpp; } handle_ret;
+	handle_ret.cpp = bgfx::createUniformBlock();
+	return handle_ret.c;
+}
+
+BGFX_C_API void bgfx_update_uniform_block(bgfx_uniform_block_handle_t _handle, bgfx_uniform_handle_t _uniform, const void* _value, uint16_t _num)
+{
+	union { bgfx_uniform_block_handle_t c; bgfx::UniformBlockHandle cpp; } handle = { _handle };
+	union { bgfx_uniform_handle_t c; bgfx::UniformHandle cpp; } uniform = { _uniform };
+	bgfx::updateUniformBlock(handle.cpp, uniform.cpp, _value, _num);
+}
+
+BGFX_C_API void bgfx_destroy_uniform_block(bgfx_uniform_block_handle_t _handle)
+{
+	union { bgfx_uniform_block_handle_t c; bgfx::UniformBlockHandle cpp; } handle = { _handle };
+	bgfx::destroy(handle.cpp);
+}
+
 BGFX_C_API bgfx_occlusion_query_handle_t bgfx_create_occlusion_query(void)
 {
 	union { bgfx_occlusion_query_handle_t c; bgfx::OcclusionQueryHandle cpp; } handle_ret;
@@ -615,6 +659,34 @@ BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _hand
 	bgfx::destroy(handle.cpp);
 }
 
+BGFX_C_API void bgfx_destroy_bundle(bgfx_bundle_handle_t _handle)
+{
+	union { bgfx_bundle_handle_t c; bgfx::BundleHandle cpp; } handle = { _handle };
+	bgfx::destroy(handle.cpp);
+}
+
+BGFX_C_API bgfx_topology_sorter_t* bgfx_create_topology_sorter(bgfx_allocator_interface_t* _allocator)
+{
+	return (bgfx_topology_sorter_t*)bgfx::createTopologySorter((bx::AllocatorI*)_allocator);
+}
+
+BGFX_C_API void bgfx_topology_sorter_sort_tri_list(bgfx_topology_sorter_t* _this, bgfx_topology_sort_t _sort, void* _dst, uint32_t _dstSize, const float _dir[3], const float _pos[3], const void* _vertices, uint32_t _stride, const void* _indices, uint32_t _numIndices, bool _index32)
+{
+	bgfx::TopologySorter* This = (bgfx::TopologySorter*)_this;
+	This->sortTriList((bgfx::TopologySort::Enum)_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32);
+}
+
+BGFX_C_API void bgfx_topology_sorter_reset(bgfx_topology_sorter_t* _this)
+{
+	bgfx::TopologySorter* This = (bgfx::TopologySorter*)_this;
+	This->reset();
+}
+
+BGFX_C_API void bgfx_destroy_topology_sorter(bgfx_topology_sorter_t* _sorter)
+{
+	bgfx::destroy((bgfx::TopologySorter*)_sorter);
+}
+
 BGFX_C_API void bgfx_set_palette_color(uint8_t _index, const float _rgba[4])
 {
 	bgfx::setPaletteColor(_index, _rgba);
@@ -753,6 +825,13 @@ BGFX_C_API void bgfx_encoder_set_uniform(bgfx_encoder_t* _this, bgfx_uniform_han
 	This->setUniform(handle.cpp, _value, _num);
 }
 
+BGFX_C_API void bgfx_encoder_set_uniform_block(bgfx_encoder_t* _this, bgfx_uniform_block_handle_t _handle)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_uniform_block_handle_t c; bgfx::UniformBlockHandle cpp; } handle = { _handle };
+	This->setUniformBlock(handle.cpp);
+}
+
 BGFX_C_API void bgfx_encoder_set_index_buffer(bgfx_encoder_t* _this, bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -885,6 +964,27 @@ BGFX_C_API void bgfx_encoder_submit_indirect(bgfx_encoder_t* _this, bgfx_view_id
 	This->submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, _num, _depth, _flags);
 }
 
+BGFX_C_API void bgfx_encoder_begin_bundle(bgfx_encoder_t* _this)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->beginBundle();
+}
+
+BGFX_C_API bgfx_bundle_handle_t bgfx_encoder_end_bundle(bgfx_encoder_t* _this)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_bundle_handle_t c; bgfx::BundleHandle cpp; } handle_ret;
+	handle_ret.cpp = This->endBundle();
+	return handle_ret.c;
+}
+
+BGFX_C_API void bgfx_encoder_submit_bundle(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_bundle_handle_t _handle)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_bundle_handle_t c; bgfx::BundleHandle cpp; } handle = { _handle };
+	This->submit((bgfx::ViewId)_id, handle.cpp);
+}
+
 BGFX_C_API void bgfx_encoder_set_compute_index_buffer(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -1042,6 +1142,12 @@ BGFX_C_API void bgfx_set_uniform(bgfx_uniform_handle_t _handle, const void* _val
 	bgfx::setUniform(handle.cpp, _value, _num);
 }
 
+BGFX_C_API void bgfx_set_uniform_block(bgfx_uniform_block_handle_t _handle)
+{
+	union { bgfx_uniform_block_handle_t c; bgfx::UniformBlockHandle cpp; } handle = { _handle };
+	bgfx::setUniformBlock(handle.cpp);
+}
+
 BGFX_C_API void bgfx_set_index_buffer(bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices)
 {
 	union { bgfx_index_buffer_handle_t c; bgfx::IndexBufferHandle cpp; } handle = { _handle };
@@ -1155,6 +1261,24 @@ BGFX_C_API void bgfx_submit_indirect(bgfx_view_id_t _id, bgfx_program_handle_t _
 	bgfx::submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, _num, _depth, _flags);
 }
 
+BGFX_C_API void bgfx_begin_bundle(void)
+{
+	bgfx::beginBundle();
+}
+
+BGFX_C_API bgfx_bundle_handle_t bgfx_end_bundle(void)
+{
+	union { bgfx_bundle_handle_t c; bgfx::BundleHandle cpp; } handle_ret;
+	handle_ret.cpp = bgfx::endBundle();
+	return handle_ret.c;
+}
+
+BGFX_C_API void bgfx_submit_bundle(bgfx_view_id_t _id, bgfx_bundle_handle_t _handle)
+{
+	union { bgfx_bundle_handle_t c; bgfx::BundleHandle cpp; } handle = { _handle };
+	bgfx::submit((bgfx::ViewId)_id, handle.cpp);
+}
+
 BGFX_C_API void bgfx_set_compute_index_buffer(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	union { bgfx_index_buffer_handle_t c; bgfx::IndexBufferHandle cpp; } handle = { _handle };
@@ -1267,6 +1391,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_vertex_unpack,
 			bgfx_vertex_convert,
 			bgfx_weld_vertices,
+			bgfx_weld_vertices_compact,
 			bgfx_topology_convert,
 			bgfx_topology_sort_tri_list,
 			bgfx_get_supported_renderers,
@@ -1279,6 +1404,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_get_renderer_type,
 			bgfx_get_caps,
 			bgfx_get_stats,
+			bgfx_defragment,
 			bgfx_alloc,
 			bgfx_copy,
 			bgfx_make_ref,
@@ -1320,6 +1446,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_create_program,
 			bgfx_create_compute_program,
 			bgfx_destroy_program,
+			bgfx_prewarm_pipeline,
+			bgfx_flush_pipeline_cache,
 			bgfx_is_texture_valid,
 			bgfx_is_frame_buffer_valid,
 			bgfx_calc_texture_size,
@@ -1346,9 +1474,17 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_create_uniform,
 			bgfx_get_uniform_info,
 			bgfx_destroy_uniform,
+			bgfx_create_uniform_block,
+			bgfx_update_uniform_block,
+			bgfx_destroy_uniform_block,
 			bgfx_create_occlusion_query,
 			bgfx_get_result,
 			bgfx_destroy_occlusion_query,
+			bgfx_destroy_bundle,
+			bgfx_create_topology_sorter,
+			bgfx_topology_sorter_sort_tri_list,
+			bgfx_topology_sorter_reset,
+			bgfx_destroy_topology_sorter,
 			bgfx_set_palette_color,
 			bgfx_set_palette_color_rgba8,
 			bgfx_set_view_name,
@@ -1374,6 +1510,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_set_transform_cached,
 			bgfx_encoder_alloc_transform,
 			bgfx_encoder_set_uniform,
+			bgfx_encoder_set_uniform_block,
 			bgfx_encoder_set_index_buffer,
 			bgfx_encoder_set_dynamic_index_buffer,
 			bgfx_encoder_set_transient_index_buffer,
@@ -1393,6 +1530,9 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_submit,
 			bgfx_encoder_submit_occlusion_query,
 			bgfx_encoder_submit_indirect,
+			bgfx_encoder_begin_bundle,
+			bgfx_encoder_end_bundle,
+			bgfx_encoder_submit_bundle,
 			bgfx_encoder_set_compute_index_buffer,
 			bgfx_encoder_set_compute_vertex_buffer,
 			bgfx_encoder_set_compute_dynamic_index_buffer,
@@ -1419,6 +1559,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_set_transform_cached,
 			bgfx_alloc_transform,
 			bgfx_set_uniform,
+			bgfx_set_uniform_block,
 			bgfx_set_index_buffer,
 			bgfx_set_dynamic_index_buffer,
 			bgfx_set_transient_index_buffer,
@@ -1438,6 +1579,9 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_submit,
 			bgfx_submit_occlusion_query,
 			bgfx_submit_indirect,
+			bgfx_begin_bundle,
+			bgfx_end_bundle,
+			bgfx_submit_bundle,
 			bgfx_set_compute_index_buffer,
 			bgfx_set_compute_vertex_buffer,
 			bgfx_set_compute_dynamic_index_buffer,
@@ -237,6 +237,8 @@ namespace stl = std;
 
 #define BGFX_RESET_INTERNAL_FORCE           UINT32_C(0x80000000)
 
+#define BGFX_BUFFER_INTERNAL_TRANSIENT      UINT16_C(0x8000)
+
 #define BGFX_STATE_INTERNAL_SCISSOR         UINT64_C(0x2000000000000000)
 #define BGFX_STATE_INTERNAL_OCCLUSION_QUERY UINT64_C(0x4000000000000000)
 
@@ -304,11 +306,7 @@ namespace bgfx
 	extern bool g_platformDataChangedSinceReset;
 	extern void isFrameBufferValid(uint8_t _num, const Attachment* _attachment, bx::Error* _err);
 
-#if BGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
-	typedef uint16_t RenderItemCount;
-#else
 	typedef uint32_t RenderItemCount;
-#endif // BGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
 
 	struct Handle
 	{
@@ -514,10 +512,13 @@ namespace bgfx
 	void setGraphicsDebuggerPresent(bool _present);
 	bool isGraphicsDebuggerPresent();
 	void release(const Memory* _mem);
+	bool isMemoryRef(const Memory* _mem);
 	const char* getAttribName(Attrib::Enum _attr);
 	const char* getAttribNameShort(Attrib::Enum _attr);
 	void getTextureSizeFromRatio(BackbufferRatio::Enum _ratio, uint16_t& _width, uint16_t& _height);
 	TextureFormat::Enum getViableTextureFormat(const bimg::ImageContainer& _imageContainer);
+	uint32_t getTextureMipSize(TextureFormat::Enum _format, uint16_t _width, uint16_t _height, uint8_t _mip);
+	const Memory* decodeTextureUpdate(TextureFormat::Enum _format, uint16_t _width, uint16_t _height, uint16_t _depth, uint16_t& _pitch, const Memory* _mem);
 	const char* getName(TextureFormat::Enum _fmt);
 	const char* getName(UniformHandle _handle);
 	const char* getName(ShaderHandle _handle);
@@ -838,11 +839,15 @@ namespace bgfx
 			CreateTexture,
 			UpdateTexture,
 			ResizeTexture,
+			SetTextureMinLod,
 			CreateFrameBuffer,
 			CreateUniform,
+			UpdateUniformBlock,
 			UpdateViewName,
 			InvalidateOcclusionQuery,
 			SetName,
+			PrewarmPipeline,
+			FlushPipelineCache,
 			End,
 			RendererShutdownEnd,
 			DestroyVertexLayout,
@@ -855,7 +860,9 @@ namespace bgfx
 			DestroyTexture,
 			DestroyFrameBuffer,
 			DestroyUniform,
+			DestroyUniformBlock,
 			ReadTexture,
+			Defragment,
 		};
 
 		void resize(uint32_t _capacity = 0)
@@ -1296,23 +1303,57 @@ namespace bgfx
 	struct MatrixCache
 	{
 		MatrixCache()
-			: m_num(1)
+			: m_cache(NULL)
+			, m_num(1)
+			, m_numDropped(0)
+			, m_max(0)
+		{
+		}
+
+		void resize(uint32_t _max)
 		{
-			m_cache[0].setIdentity();
+			if (_max == m_max)
+			{
+				return;
+			}
+
+			// Content is not preserved, this is called only between frames.
+			BX_ALIGNED_FREE(g_allocator, m_cache, 16);
+			m_cache = NULL;
+			m_max   = _max;
+
+			if (0 < _max)
+			{
+				m_cache = (Matrix4*)BX_ALIGNED_ALLOC(g_allocator, sizeof(Matrix4)*_max, 16);
+				m_cache[0].setIdentity();
+			}
 		}
 
 		void reset()
 		{
-			m_num = 1;
+			m_num        = 1;
+			m_numDropped = 0;
+		}
+
+		/// Returns number of matrices requested during frame, including dropped ones.
+		uint32_t getDemand() const
+		{
+			return m_num + m_numDropped;
 		}
 
 		uint32_t reserve(uint16_t* _num)
 		{
 			uint32_t num = *_num;
-			uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, BGFX_CONFIG_MAX_MATRIX_CACHE - 1);
-			BX_WARN(first+num < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache overflow. %d (max: %d)", first+num, BGFX_CONFIG_MAX_MATRIX_CACHE);
-			num = bx::min(num, BGFX_CONFIG_MAX_MATRIX_CACHE-1-first);
-			*_num = (uint16_t)num;
+			uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, m_max - 1);
+			BX_WARN(first+num < m_max, "Matrix cache overflow. %d (max: %d)", first+num, m_max);
+			const uint32_t avail = bx::min(num, m_max-1-first);
+
+			if (avail < num)
+			{
+				bx::atomicFetchAndAdd<uint32_t>(&m_numDropped, num-avail);
+			}
+
+			*_num = (uint16_t)avail;
 			return first;
 		}
 
@@ -1330,9 +1371,9 @@ namespace bgfx
 
 		float* toPtr(uint32_t _cacheIdx)
 		{
-			BX_ASSERT(_cacheIdx < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			BX_ASSERT(_cacheIdx < m_max, "Matrix cache out of bounds index %d (max: %d)"
 				, _cacheIdx
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				, m_max
 				);
 			return m_cache[_cacheIdx].un.val;
 		}
@@ -1342,8 +1383,10 @@ namespace bgfx
 			return uint32_t( (const Matrix4*)_ptr - m_cache);
 		}
 
-		Matrix4 m_cache[BGFX_CONFIG_MAX_MATRIX_CACHE];
+		Matrix4* m_cache;
 		uint32_t m_num;
+		uint32_t m_numDropped;
+		uint32_t m_max;
 	};
 
 	struct RectCache
@@ -1493,6 +1536,12 @@ namespace bgfx
 			return m_pos;
 		}
 
+		const char* getPtr(uint32_t _pos) const
+		{
+			BX_ASSERT(_pos <= m_size, "Out of bounds %d (size: %d).", _pos, m_size);
+			return &m_buffer[_pos];
+		}
+
 		void reset(uint32_t _pos = 0)
 		{
 			m_pos = _pos;
@@ -1643,6 +1692,7 @@ namespace bgfx
 				m_stencil       = packStencil(BGFX_STENCIL_DEFAULT, BGFX_STENCIL_DEFAULT);
 				m_rgba          = 0;
 				m_scissor       = UINT16_MAX;
+				m_uniformBlock.idx = kInvalidHandle;
 			}
 
 			if (0 != (_flags & BGFX_DISCARD_TRANSFORM) )
@@ -1723,6 +1773,7 @@ namespace bgfx
 		VertexBufferHandle   m_instanceDataBuffer;
 		IndirectBufferHandle m_indirectBuffer;
 		OcclusionQueryHandle m_occlusionQuery;
+		UniformBlockHandle   m_uniformBlock;
 	};
 
 	BX_ALIGN_DECL_CACHE_LINE(struct) RenderCompute
@@ -1880,6 +1931,10 @@ namespace bgfx
 			m_owned       = false;
 			m_immutable   = _immutable;
 			m_cubeMap     = _cubeMap;
+			m_decoded     = false;
+			m_streaming   = 0 != (_flags & BGFX_TEXTURE_STREAMING);
+			m_residentMip = 0;
+			m_streamMips  = 0;
 			m_flags       = _flags;
 		}
 
@@ -1919,6 +1974,10 @@ namespace bgfx
 		bool     m_owned;
 		bool     m_immutable;
 		bool     m_cubeMap;
+		bool     m_decoded;
+		bool     m_streaming;
+		uint8_t  m_residentMip;
+		uint32_t m_streamMips;
 	};
 
 	struct FrameBufferRef
@@ -2014,6 +2073,13 @@ namespace bgfx
 		uint8_t m_mode;
 	};
 
+	/// Contiguous range of render items written by single encoder.
+	struct RenderItemRun
+	{
+		uint32_t m_begin;
+		uint32_t m_num;
+	};
+
 	struct FrameCache
 	{
 		void reset()
@@ -2047,15 +2113,19 @@ namespace bgfx
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
 		Frame()
-			: m_waitSubmit(0)
+			: m_sortKeys(NULL)
+			, m_sortValues(NULL)
+			, m_renderItem(NULL)
+			, m_renderItemBind(NULL)
+			, m_maxRenderItems(0)
+			, m_numDroppedRenderItems(0)
+			, m_renderItemRun(NULL)
+			, m_maxRenderItemRuns(0)
+			, m_renderItemBlock(0)
+			, m_waitSubmit(0)
 			, m_waitRender(0)
 			, m_capture(false)
 		{
-			SortKey term;
-			term.reset();
-			term.m_program = BGFX_INVALID_HANDLE;
-			m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS]   = term.encodeDraw(SortKey::SortProgram);
-			m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS] = BGFX_CONFIG_MAX_DRAW_CALLS;
 			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
 
 			m_perfStats.viewStats = m_viewStats;
@@ -2065,11 +2135,13 @@ namespace bgfx
 		{
 		}
 
-		void create(uint32_t _minResourceCbSize)
+		void create(uint32_t _minResourceCbSize, uint32_t _renderItemBlock)
 		{
 			m_cmdPre.init(_minResourceCbSize);
 			m_cmdPost.init(_minResourceCbSize);
 
+			m_renderItemBlock = _renderItemBlock;
+
 			{
 				const uint32_t num = g_caps.limits.maxEncoders;
 
@@ -2081,6 +2153,9 @@ namespace bgfx
 				}
 			}
 
+			resizeRenderItems(BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+			m_frameCache.m_matrixCache.resize(BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE+1);
+
 			reset();
 			start();
 			m_textVideoMem = BX_NEW(g_allocator, TextVideoMem);
@@ -2095,6 +2170,64 @@ namespace bgfx
 
 			BX_FREE(g_allocator, m_uniformBuffer);
 			BX_DELETE(g_allocator, m_textVideoMem);
+
+			resizeRenderItems(0);
+			m_frameCache.m_matrixCache.resize(0);
+		}
+
+		void resizeRenderItems(uint32_t _num)
+		{
+			if (_num == m_maxRenderItems)
+			{
+				return;
+			}
+
+			// Content is not preserved, this is called only between frames.
+			if (0 < m_maxRenderItems)
+			{
+				BX_FREE(g_allocator, m_sortKeys);
+				BX_FREE(g_allocator, m_sortValues);
+				BX_ALIGNED_FREE(g_allocator, m_renderItem,     BX_ALIGNOF(RenderItem) );
+				BX_ALIGNED_FREE(g_allocator, m_renderItemBind, BX_ALIGNOF(RenderBind) );
+				BX_FREE(g_allocator, m_renderItemRun);
+
+				m_sortKeys       = NULL;
+				m_sortValues     = NULL;
+				m_renderItem     = NULL;
+				m_renderItemBind = NULL;
+				m_renderItemRun  = NULL;
+			}
+
+			m_maxRenderItems    = _num;
+			m_maxRenderItemRuns = 0;
+
+			if (0 < _num)
+			{
+				m_sortKeys       = (uint64_t*       )BX_ALLOC(g_allocator, sizeof(uint64_t)*(_num+1) );
+				m_sortValues     = (RenderItemCount*)BX_ALLOC(g_allocator, sizeof(RenderItemCount)*(_num+1) );
+				m_renderItem     = (RenderItem*     )BX_ALIGNED_ALLOC(g_allocator, sizeof(RenderItem)*(_num+1), BX_ALIGNOF(RenderItem) );
+				m_renderItemBind = (RenderBind*     )BX_ALIGNED_ALLOC(g_allocator, sizeof(RenderBind)*(_num+1), BX_ALIGNOF(RenderBind) );
+
+				SortKey term;
+				term.reset();
+				term.m_program = BGFX_INVALID_HANDLE;
+				m_sortKeys[_num]   = term.encodeDraw(SortKey::SortProgram);
+				m_sortValues[_num] = _num;
+
+				if (0 < m_renderItemBlock)
+				{
+					// Encoder flushes a run on every end, and can begin/end any number of times per
+					// frame. Runs are disjoint and never empty, so there can't be more runs than items.
+					m_maxRenderItemRuns = _num;
+					m_renderItemRun     = (RenderItemRun*)BX_ALLOC(g_allocator, sizeof(RenderItemRun)*m_maxRenderItemRuns);
+				}
+			}
+		}
+
+		/// Returns number of render items requested during frame, including dropped ones.
+		uint32_t getRenderItemDemand() const
+		{
+			return bx::min(m_numRenderItems, m_maxRenderItems) + m_numDroppedRenderItems;
 		}
 
 		void reset()
@@ -2108,12 +2241,17 @@ namespace bgfx
 		{
 			m_perfStats.transientVbUsed = m_vboffset;
 			m_perfStats.transientIbUsed = m_iboffset;
+			m_perfStats.numDropped      = m_numDroppedRenderItems;
 
 			m_frameCache.reset();
-			m_numRenderItems = 0;
-			m_numBlitItems   = 0;
+			m_numRenderItems        = 0;
+			m_numDroppedRenderItems = 0;
+			m_numRenderItemRuns     = 0;
+			m_numBlitItems          = 0;
 			m_iboffset = 0;
 			m_vboffset = 0;
+			m_ibdemand = 0;
+			m_vbdemand = 0;
 			m_cmdPre.start();
 			m_cmdPost.start();
 			m_capture = false;
@@ -2125,31 +2263,51 @@ namespace bgfx
 			m_cmdPre.finish();
 			m_cmdPost.finish();
 
-//			if (0 < m_numDropped)
-//			{
-//				BX_TRACE("Too many draw calls: %d, dropped %d (max: %d)"
-//					, m_numRenderItems+m_numDropped
-//					, m_numDropped
-//					, BGFX_CONFIG_MAX_DRAW_CALLS
-//					);
-//			}
+			BX_WARN(0 == m_numDroppedRenderItems
+				, "Too many draw calls: %d, dropped %d (max: %d)."
+				, getRenderItemDemand()
+				, m_numDroppedRenderItems
+				, m_maxRenderItems
+				);
+		}
+
+		void dropRenderItem(uint32_t _num = 1)
+		{
+			bx::atomicFetchAndAdd<uint32_t>(&m_numDroppedRenderItems, _num);
 		}
 
 		void sort();
 
-		uint32_t getAvailTransientIndexBuffer(uint32_t _num)
+		void addRenderItemRun(uint32_t _begin, uint32_t _num)
+		{
+			const uint32_t idx = bx::atomicFetchAndAddsat<uint32_t>(&m_numRenderItemRuns, 1, m_maxRenderItemRuns);
+			BX_ASSERT(idx < m_maxRenderItemRuns, "Render item run overflow %d (max: %d).", idx, m_maxRenderItemRuns);
+
+			if (idx >= m_maxRenderItemRuns)
+			{
+				dropRenderItem(_num);
+				return;
+			}
+
+			RenderItemRun& run = m_renderItemRun[idx];
+			run.m_begin = _begin;
+			run.m_num   = _num;
+		}
+
+		uint32_t getAvailTransientIndexBuffer(uint32_t _num, uint32_t _indexSize = sizeof(uint16_t) )
 		{
-			uint32_t offset   = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
-			uint32_t iboffset = offset + _num*sizeof(uint16_t);
-			iboffset = bx::min<uint32_t>(iboffset, g_caps.limits.transientIbSize);
-			uint32_t num = (iboffset-offset)/sizeof(uint16_t);
+			uint32_t offset   = bx::strideAlign(m_iboffset, _indexSize);
+			uint32_t iboffset = offset + _num*_indexSize;
+			m_ibdemand = bx::max(m_ibdemand, iboffset);
+			iboffset = bx::min<uint32_t>(iboffset, m_transientIb->size);
+			uint32_t num = (bx::max(iboffset, offset)-offset)/_indexSize;
 			return num;
 		}
 
 		uint32_t allocTransientIndexBuffer(uint32_t& _num, uint32_t _indexSize)
 		{
 			uint32_t offset = bx::strideAlign(m_iboffset, _indexSize);
-			uint32_t num    = getAvailTransientIndexBuffer(_num);
+			uint32_t num    = getAvailTransientIndexBuffer(_num, _indexSize);
 			m_iboffset = offset + num*_indexSize;
 			_num = num;
 
@@ -2160,8 +2318,9 @@ namespace bgfx
 		{
 			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
 			uint32_t vboffset = offset + _num * _stride;
-			vboffset = bx::min<uint32_t>(vboffset, g_caps.limits.transientVbSize);
-			uint32_t num = (vboffset-offset)/_stride;
+			m_vbdemand = bx::max(m_vbdemand, vboffset);
+			vboffset = bx::min<uint32_t>(vboffset, m_transientVb->size);
+			uint32_t num = (bx::max(vboffset, offset)-offset)/_stride;
 			return num;
 		}
 
@@ -2215,6 +2374,16 @@ namespace bgfx
 			return m_freeUniform.queue(_handle);
 		}
 
+		bool free(UniformBlockHandle _handle)
+		{
+			return m_freeUniformBlock.queue(_handle);
+		}
+
+		bool free(BundleHandle _handle)
+		{
+			return m_freeBundle.queue(_handle);
+		}
+
 		void resetFreeHandles()
 		{
 			m_freeIndexBuffer.reset();
@@ -2225,6 +2394,8 @@ namespace bgfx
 			m_freeTexture.reset();
 			m_freeFrameBuffer.reset();
 			m_freeUniform.reset();
+			m_freeUniformBlock.reset();
+			m_freeBundle.reset();
 		}
 
 		ViewId m_viewRemap[BGFX_CONFIG_MAX_VIEWS];
@@ -2234,10 +2405,12 @@ namespace bgfx
 
 		int32_t m_occlusion[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
 
-		uint64_t m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItemCount m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItem m_renderItem[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderBind m_renderItemBind[BGFX_CONFIG_MAX_DRAW_CALLS + 1];
+		uint64_t*        m_sortKeys;
+		RenderItemCount* m_sortValues;
+		RenderItem*      m_renderItem;
+		RenderBind*      m_renderItemBind;
+		uint32_t         m_maxRenderItems;
+		uint32_t         m_numDroppedRenderItems;
 
 		uint32_t m_blitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 		BlitItem m_blitItem[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
@@ -2248,8 +2421,15 @@ namespace bgfx
 		uint32_t m_numRenderItems;
 		uint16_t m_numBlitItems;
 
+		RenderItemRun* m_renderItemRun;
+		uint32_t m_numRenderItemRuns;
+		uint32_t m_maxRenderItemRuns;
+		uint32_t m_renderItemBlock;
+
 		uint32_t m_iboffset;
 		uint32_t m_vboffset;
+		uint32_t m_ibdemand;
+		uint32_t m_vbdemand;
 		TransientIndexBuffer* m_transientIb;
 		TransientVertexBuffer* m_transientVb;
 
@@ -2326,6 +2506,8 @@ namespace bgfx
 		FreeHandle<TextureHandle,      BGFX_CONFIG_MAX_TEXTURES>       m_freeTexture;
 		FreeHandle<FrameBufferHandle,  BGFX_CONFIG_MAX_FRAME_BUFFERS>  m_freeFrameBuffer;
 		FreeHandle<UniformHandle,      BGFX_CONFIG_MAX_UNIFORMS>       m_freeUniform;
+		FreeHandle<UniformBlockHandle, BGFX_CONFIG_MAX_UNIFORM_BLOCKS> m_freeUniformBlock;
+		FreeHandle<BundleHandle,       BGFX_CONFIG_MAX_BUNDLES>        m_freeBundle;
 
 		TextVideoMem* m_textVideoMem;
 
@@ -2338,13 +2520,271 @@ namespace bgfx
 		bool m_capture;
 	};
 
+	// Retained list of draw calls. Draw state is captured once by the encoder and
+	// copied into frame on each submit. Matrices, scissor rects and uniform data
+	// are stored inside bundle, since frame caches are reset every frame. Draw
+	// m_startMatrix is 1-based index into m_matrix (0 is identity), m_scissor is
+	// index into m_rect, and m_uniformBegin/End are offsets into m_uniform.
+	struct Bundle
+	{
+		Bundle()
+			: m_item(NULL)
+			, m_bind(NULL)
+			, m_matrix(NULL)
+			, m_rect(NULL)
+			, m_uniform(NULL)
+			, m_num(0)
+			, m_max(0)
+			, m_numMatrices(0)
+			, m_maxMatrices(0)
+			, m_numRects(0)
+			, m_maxRects(0)
+			, m_uniformSize(0)
+			, m_maxUniformSize(0)
+		{
+			bx::memSet(m_sortKey, 0, sizeof(m_sortKey) );
+		}
+
+		void reset()
+		{
+			m_num         = 0;
+			m_numMatrices = 0;
+			m_numRects    = 0;
+			m_uniformSize = 0;
+		}
+
+		void destroy()
+		{
+			for (uint32_t ii = 0; ii < ViewMode::Count; ++ii)
+			{
+				resize(m_sortKey[ii], 0, 0);
+			}
+
+			resize(m_item,    0, 0);
+			resize(m_bind,    0, 0);
+			resize(m_matrix,  0, 0);
+			resize(m_rect,    0, 0);
+			resize(m_uniform, 0, 0);
+
+			m_max            = 0;
+			m_maxMatrices    = 0;
+			m_maxRects       = 0;
+			m_maxUniformSize = 0;
+
+			reset();
+		}
+
+		uint32_t alloc()
+		{
+			if (m_num == m_max)
+			{
+				const uint32_t max = bx::max<uint32_t>(m_max*2, 64);
+
+				for (uint32_t ii = 0; ii < ViewMode::Count; ++ii)
+				{
+					resize(m_sortKey[ii], m_num, max);
+				}
+
+				resize(m_item, m_num, max);
+				resize(m_bind, m_num, max);
+				m_max = max;
+			}
+
+			return m_num++;
+		}
+
+		uint32_t allocMatrices(uint32_t _num)
+		{
+			if (m_numMatrices + _num > m_maxMatrices)
+			{
+				const uint32_t max = bx::max(m_maxMatrices*2, m_numMatrices + _num, 64u);
+				resize(m_matrix, m_numMatrices, max);
+				m_maxMatrices = max;
+			}
+
+			const uint32_t first = m_numMatrices;
+			m_numMatrices += _num;
+			return first;
+		}
+
+		uint32_t allocRect()
+		{
+			if (m_numRects == m_maxRects)
+			{
+				const uint32_t max = bx::max<uint32_t>(m_maxRects*2, 16);
+				resize(m_rect, m_numRects, max);
+				m_maxRects = max;
+			}
+
+			return m_numRects++;
+		}
+
+		uint32_t allocUniform(uint32_t _size)
+		{
+			if (m_uniformSize + _size > m_maxUniformSize)
+			{
+				const uint32_t max = bx::max(m_maxUniformSize*2, m_uniformSize + _size, 4u<<10);
+				resize(m_uniform, m_uniformSize, max);
+				m_maxUniformSize = max;
+			}
+
+			const uint32_t offset = m_uniformSize;
+			m_uniformSize += _size;
+			return offset;
+		}
+
+		template<typename Ty>
+		static void resize(Ty*& _data, uint32_t _num, uint32_t _max)
+		{
+			Ty* data = NULL;
+
+			if (0 < _max)
+			{
+				data = (Ty*)BX_ALIGNED_ALLOC(g_allocator, sizeof(Ty)*_max, BX_ALIGNOF(Ty) );
+
+				if (0 < _num)
+				{
+					bx::memCopy(data, _data, sizeof(Ty)*_num);
+				}
+			}
+
+			if (NULL != _data)
+			{
+				BX_ALIGNED_FREE(g_allocator, _data, BX_ALIGNOF(Ty) );
+			}
+
+			_data = data;
+		}
+
+		// Sort keys are encoded at record time for each view mode, with view 0 and sequence
+		// relative to the first draw, so that submit only has to offset them.
+		uint64_t*   m_sortKey[ViewMode::Count];
+		RenderItem* m_item;
+		RenderBind* m_bind;
+		Matrix4*    m_matrix;
+		Rect*       m_rect;
+		char*       m_uniform;
+
+		uint32_t m_num;
+		uint32_t m_max;
+		uint32_t m_numMatrices;
+		uint32_t m_maxMatrices;
+		uint32_t m_numRects;
+		uint32_t m_maxRects;
+		uint32_t m_uniformSize;
+		uint32_t m_maxUniformSize;
+	};
+
+	// Persistent uniform values referenced by draw calls. Data is stored in the same
+	// opcode stream format as UniformBuffer, with at most one entry per uniform. API
+	// thread copy is edited in place, and it's sent to render thread on frame only if
+	// it was changed.
+	struct UniformBlock
+	{
+		UniformBlock()
+			: m_data(NULL)
+			, m_size(0)
+			, m_max(0)
+			, m_dirty(false)
+		{
+		}
+
+		void reset()
+		{
+			m_size  = 0;
+			m_dirty = false;
+		}
+
+		void destroy()
+		{
+			if (NULL != m_data)
+			{
+				BX_FREE(g_allocator, m_data);
+				m_data = NULL;
+			}
+
+			m_max = 0;
+			reset();
+		}
+
+		void set(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num);
+
+		char*    m_data;
+		uint32_t m_size;
+		uint32_t m_max;
+		bool     m_dirty;
+	};
+
+	// Render thread copy of uniform block. Hash of content is used to skip replaying
+	// blocks with identical content on consecutive draw calls, content is compared
+	// only when hashes match.
+	struct RenderUniformBlock
+	{
+		RenderUniformBlock()
+			: m_uniformBuffer(NULL)
+			, m_size(0)
+			, m_hash(0)
+		{
+		}
+
+		void update(const void* _data, uint32_t _size);
+
+		bool isEqual(const RenderUniformBlock& _other) const
+		{
+			return m_hash == _other.m_hash
+				&& m_size == _other.m_size
+				&& 0 == bx::memCmp(m_uniformBuffer->getPtr(0), _other.m_uniformBuffer->getPtr(0), m_size)
+				;
+		}
+
+		void destroy()
+		{
+			if (NULL != m_uniformBuffer)
+			{
+				UniformBuffer::destroy(m_uniformBuffer);
+				m_uniformBuffer = NULL;
+			}
+
+			m_size = 0;
+			m_hash = 0;
+		}
+
+		UniformBuffer* m_uniformBuffer;
+		uint32_t       m_size;
+		uint32_t       m_hash;
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) EncoderImpl
 	{
-		EncoderImpl()
+		EncoderImpl(uint32_t _renderItemBlock)
+			: m_tempKeys(NULL)
+			, m_tempValues(NULL)
+			, m_maxTempItems(0)
 		{
+			resizeTempItems(_renderItemBlock);
 			discard(BGFX_DISCARD_ALL);
 		}
 
+		~EncoderImpl()
+		{
+			resizeTempItems(0);
+		}
+
+		void resizeTempItems(uint32_t _num)
+		{
+			BX_FREE(g_allocator, m_tempKeys);
+			BX_FREE(g_allocator, m_tempValues);
+			m_tempKeys     = NULL;
+			m_tempValues   = NULL;
+			m_maxTempItems = _num;
+
+			if (0 < _num)
+			{
+				m_tempKeys   = (uint64_t*       )BX_ALLOC(g_allocator, sizeof(uint64_t)*_num);
+				m_tempValues = (RenderItemCount*)BX_ALLOC(g_allocator, sizeof(RenderItemCount)*_num);
+			}
+		}
+
 		void begin(Frame* _frame, uint8_t _idx)
 		{
 			m_frame = _frame;
@@ -2360,10 +2800,21 @@ namespace bgfx
 
 			m_numSubmitted = 0;
 			m_numDropped   = 0;
+
+			m_renderItemBegin = 0;
+			m_renderItemPos   = 0;
+			m_renderItemEnd   = 0;
+
+			m_bundle.idx = kInvalidHandle;
+			m_record     = false;
 		}
 
 		void end(bool _finalize)
 		{
+			BX_ASSERT(!m_record, "Encoder ended while recording bundle, endBundle must be called first.");
+
+			flushRenderItems();
+
 			if (_finalize)
 			{
 				UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
@@ -2406,6 +2857,11 @@ namespace bgfx
 			uniformBuffer->writeUniform(_type, _handle.idx, _value, _num);
 		}
 
+		void setUniformBlock(UniformBlockHandle _handle)
+		{
+			m_draw.m_uniformBlock = _handle;
+		}
+
 		void setState(uint64_t _state, uint32_t _rgba)
 		{
 			uint8_t blend = ( (_state&BGFX_STATE_BLEND_MASK)>>BGFX_STATE_BLEND_SHIFT)&0xff;
@@ -2458,12 +2914,13 @@ namespace bgfx
 
 		void setTransform(uint32_t _cache, uint16_t _num)
 		{
-			BX_ASSERT(_cache < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			const uint32_t maxMatrices = m_frame->m_frameCache.m_matrixCache.m_max;
+			BX_ASSERT(_cache < maxMatrices, "Matrix cache out of bounds index %d (max: %d)"
 				, _cache
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				, maxMatrices
 				);
 			m_draw.m_startMatrix = _cache;
-			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, BGFX_CONFIG_MAX_MATRIX_CACHE-1) - _cache);
+			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, maxMatrices-1) - _cache);
 		}
 
 		void setIndexBuffer(IndexBufferHandle _handle, const IndexBuffer& _ib, uint32_t _firstIndex, uint32_t _numIndices)
@@ -2654,8 +3111,125 @@ namespace bgfx
 			m_bind.clear(_flags);
 		}
 
+		uint32_t allocRenderItem()
+		{
+			const uint32_t blockSize = m_frame->m_renderItemBlock;
+
+			if (0 == blockSize)
+			{
+				return bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, m_frame->m_maxRenderItems);
+			}
+
+			if (m_renderItemPos == m_renderItemEnd)
+			{
+				flushRenderItems();
+
+				const uint32_t maxRenderItems = m_frame->m_maxRenderItems;
+				const uint32_t begin = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, blockSize, maxRenderItems);
+				m_renderItemBegin = bx::min(begin, maxRenderItems);
+				m_renderItemPos   = m_renderItemBegin;
+				m_renderItemEnd   = bx::min(begin + blockSize, maxRenderItems);
+
+				if (m_renderItemPos == m_renderItemEnd)
+				{
+					return maxRenderItems;
+				}
+			}
+
+			return m_renderItemPos++;
+		}
+
+		/// Claims up to `_num` contiguous render items, returns number of claimed items.
+		uint32_t allocRenderItems(uint32_t _num, uint32_t* _begin)
+		{
+			const uint32_t maxRenderItems = m_frame->m_maxRenderItems;
+			const uint32_t blockSize      = m_frame->m_renderItemBlock;
+
+			if (0 == blockSize)
+			{
+				const uint32_t begin = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, _num, maxRenderItems);
+				*_begin = bx::min(begin, maxRenderItems);
+				return bx::min(begin + _num, maxRenderItems) - *_begin;
+			}
+
+			if (m_renderItemEnd - m_renderItemPos < _num)
+			{
+				flushRenderItems();
+
+				// Claim at least a block, so that remainder is used by following draw calls.
+				const uint32_t size  = bx::max(_num, blockSize);
+				const uint32_t begin = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, size, maxRenderItems);
+				m_renderItemBegin = bx::min(begin, maxRenderItems);
+				m_renderItemPos   = m_renderItemBegin;
+				m_renderItemEnd   = bx::min(begin + size, maxRenderItems);
+			}
+
+			const uint32_t num = bx::min(_num, m_renderItemEnd - m_renderItemPos);
+			*_begin = m_renderItemPos;
+			m_renderItemPos += num;
+
+			return num;
+		}
+
+		void flushRenderItems()
+		{
+			const uint32_t num = m_renderItemPos - m_renderItemBegin;
+
+			if (0 < num)
+			{
+				// Bundles can claim runs longer than a block.
+				if (num > m_maxTempItems)
+				{
+					resizeTempItems(num);
+				}
+
+				// Pre-sort encoder's range, Frame::sort only needs to merge sorted runs.
+				bx::radixSort(
+					  &m_frame->m_sortKeys[m_renderItemBegin]
+					, m_tempKeys
+					, &m_frame->m_sortValues[m_renderItemBegin]
+					, m_tempValues
+					, num
+					);
+
+				m_frame->addRenderItemRun(m_renderItemBegin, num);
+			}
+
+			m_renderItemBegin = m_renderItemPos;
+		}
+
+		uint32_t getNumVertices() const
+		{
+			if (UINT8_MAX != m_draw.m_streamMask)
+			{
+				uint32_t numVertices = UINT32_MAX;
+				for (uint32_t idx = 0, streamMask = m_draw.m_streamMask
+					; 0 != streamMask
+					; streamMask >>= 1, idx += 1
+					)
+				{
+					const uint32_t ntz = bx::uint32_cnttz(streamMask);
+					streamMask >>= ntz;
+					idx         += ntz;
+					numVertices = bx::min(numVertices, m_numVertices[idx]);
+				}
+
+				return numVertices;
+			}
+
+			return m_numVertices[0];
+		}
+
 		void submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, uint8_t _flags);
 
+		void submit(ViewId _id, BundleHandle _handle);
+
+		void beginBundle();
+
+		BundleHandle endBundle();
+
+		void record(ProgramHandle _program, uint32_t _depth, uint8_t _flags);
+
 		void submit(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, uint8_t _flags)
 		{
 			m_draw.m_startIndirect  = _start;
@@ -2688,12 +3262,22 @@ namespace bgfx
 		uint32_t m_numSubmitted;
 		uint32_t m_numDropped;
 
+		uint32_t m_renderItemBegin;
+		uint32_t m_renderItemPos;
+		uint32_t m_renderItemEnd;
+		uint64_t*        m_tempKeys;
+		RenderItemCount* m_tempValues;
+		uint32_t         m_maxTempItems;
+
 		uint32_t m_uniformBegin;
 		uint32_t m_uniformEnd;
 		uint32_t m_numVertices[BGFX_CONFIG_MAX_VERTEX_STREAMS];
 		uint8_t  m_uniformIdx;
 		bool     m_discard;
 
+		BundleHandle m_bundle;
+		bool         m_record;
+
 		typedef stl::unordered_set<uint16_t> HandleSet;
 		HandleSet m_uniformSet;
 		HandleSet m_occlusionQuerySet;
@@ -2799,7 +3383,9 @@ namespace bgfx
 		VertexLayoutHandle m_dynamicVertexBufferRef[BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS];
 	};
 
-	// First-fit non-local allocator.
+	// Two-level segregated fit allocator for suballocating ranges in GPU buffers.
+	// Free blocks are binned by size class (first level power of two, second level
+	// linear subdivision), and neighbouring free blocks are coalesced on free.
 	class NonLocalAllocator
 	{
 	public:
@@ -2807,6 +3393,7 @@ namespace bgfx
 
 		NonLocalAllocator()
 		{
+			reset();
 		}
 
 		~NonLocalAllocator()
@@ -2815,24 +3402,35 @@ namespace bgfx
 
 		void reset()
 		{
-			m_free.clear();
+			m_blocks.clear();
+			m_unusedBlocks.clear();
+			m_freeBegin.clear();
+			m_freeEnd.clear();
 			m_used.clear();
+
+			m_flBitmap  = 0;
+			m_totalFree = 0;
+			bx::memSet(m_slBitmap, 0, sizeof(m_slBitmap) );
+			bx::memSet(m_bin, 0xff, sizeof(m_bin) );
 		}
 
 		void add(uint64_t _ptr, uint32_t _size)
 		{
-			m_free.push_back(Free(_ptr, _size) );
+			insertFree(_ptr, _size);
 		}
 
 		uint64_t remove()
 		{
 			BX_ASSERT(0 == m_used.size(), "");
 
-			if (0 < m_free.size() )
+			if (0 != m_flBitmap)
 			{
-				Free freeBlock = m_free.front();
-				m_free.pop_front();
-				return freeBlock.m_ptr;
+				const uint32_t fl  = bx::uint32_cnttz(m_flBitmap);
+				const uint32_t sl  = bx::uint32_cnttz(m_slBitmap[fl]);
+				const uint32_t idx = m_bin[fl][sl];
+				const uint64_t ptr = m_blocks[idx].m_ptr;
+				removeFree(idx);
+				return ptr;
 			}
 
 			return 0;
@@ -2842,30 +3440,25 @@ namespace bgfx
 		{
 			_size = bx::max(_size, 16u);
 
-			for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+			const uint32_t idx = findFree(_size);
+			if (kInvalidIdx == idx)
 			{
-				if (it->m_size >= _size)
-				{
-					uint64_t ptr = it->m_ptr;
-
-					m_used.insert(stl::make_pair(ptr, _size) );
+				// there is no block large enough.
+				return kInvalidBlock;
+			}
 
-					if (it->m_size != _size)
-					{
-						it->m_size -= _size;
-						it->m_ptr  += _size;
-					}
-					else
-					{
-						m_free.erase(it);
-					}
+			const Block block = m_blocks[idx];
+			removeFree(idx);
 
-					return ptr;
-				}
+			if (block.m_size != _size)
+			{
+				// Remaining neighbours of free block are used, no need to coalesce.
+				insertFree(block.m_ptr + _size, block.m_size - _size);
 			}
 
-			// there is no block large enough.
-			return kInvalidBlock;
+			m_used.insert(stl::make_pair(block.m_ptr, _size) );
+
+			return block.m_ptr;
 		}
 
 		void free(uint64_t _block)
@@ -2873,55 +3466,219 @@ namespace bgfx
 			UsedList::iterator it = m_used.find(_block);
 			if (it != m_used.end() )
 			{
-				m_free.push_front(Free(it->first, it->second) );
+				uint64_t ptr  = it->first;
+				uint32_t size = it->second;
 				m_used.erase(it);
+
+				FreeMap::iterator prev = m_freeEnd.find(ptr);
+				if (prev != m_freeEnd.end() )
+				{
+					const uint32_t idx = prev->second;
+					ptr   = m_blocks[idx].m_ptr;
+					size += m_blocks[idx].m_size;
+					removeFree(idx);
+				}
+
+				FreeMap::iterator next = m_freeBegin.find(ptr + size);
+				if (next != m_freeBegin.end() )
+				{
+					const uint32_t idx = next->second;
+					size += m_blocks[idx].m_size;
+					removeFree(idx);
+				}
+
+				insertFree(ptr, size);
 			}
 		}
 
 		bool compact()
 		{
-			m_free.sort();
+			// Free blocks are coalesced when released, only report if all blocks are free.
+			return 0 == m_used.size();
+		}
+
+		uint32_t getTotalFree() const
+		{
+			return m_totalFree;
+		}
+
+		uint32_t getLargestFree() const
+		{
+			uint32_t largest = 0;
 
-			for (FreeList::iterator it = m_free.begin(), next = it, itEnd = m_free.end(); next != itEnd;)
+			if (0 != m_flBitmap)
 			{
-				if ( (it->m_ptr + it->m_size) == next->m_ptr)
+				const uint32_t fl = 31 - bx::uint32_cntlz(m_flBitmap);
+				const uint32_t sl = 31 - bx::uint32_cntlz(m_slBitmap[fl]);
+
+				for (uint32_t idx = m_bin[fl][sl]; kInvalidIdx != idx; idx = m_blocks[idx].m_next)
 				{
-					it->m_size += next->m_size;
-					next = m_free.erase(next);
+					largest = bx::max(largest, m_blocks[idx].m_size);
 				}
-				else
+			}
+
+			return largest;
+		}
+
+	private:
+		static const uint32_t kInvalidIdx = UINT32_MAX;
+		static const uint32_t kSlShift    = 4;
+		static const uint32_t kNumSl      = 1<<kSlShift;
+		static const uint32_t kNumFl      = 32;
+
+		struct Block
+		{
+			uint64_t m_ptr;
+			uint32_t m_size;
+			uint32_t m_prev;
+			uint32_t m_next;
+		};
+
+		static void mapping(uint32_t _size, uint32_t& _fl, uint32_t& _sl)
+		{
+			if (_size < kNumSl)
+			{
+				_fl = 0;
+				_sl = _size;
+			}
+			else
+			{
+				const uint32_t log2 = 31 - bx::uint32_cntlz(_size);
+				_fl = log2 - kSlShift + 1;
+				_sl = (_size >> (log2 - kSlShift) ) ^ kNumSl;
+			}
+		}
+
+		uint32_t findFree(uint32_t _size) const
+		{
+			uint32_t fl, sl;
+
+			// Round up to next size class, so that any block in found bin fits.
+			const uint32_t log2  = 31 - bx::uint32_cntlz(_size);
+			const uint32_t round = log2 >= kSlShift ? (1u << (log2 - kSlShift) ) - 1 : 0;
+			mapping(bx::uint32_satadd(_size, round), fl, sl);
+
+			uint32_t slBitmap = fl < kNumFl ? m_slBitmap[fl] & (UINT32_MAX << sl) : 0;
+			if (0 == slBitmap)
+			{
+				const uint32_t flBitmap = fl+1 < kNumFl ? m_flBitmap & (UINT32_MAX << (fl+1) ) : 0;
+				if (0 != flBitmap)
 				{
-					it = next;
-					++next;
+					fl = bx::uint32_cnttz(flBitmap);
+					slBitmap = m_slBitmap[fl];
 				}
 			}
 
-			return 0 == m_used.size();
+			if (0 != slBitmap)
+			{
+				sl = bx::uint32_cnttz(slBitmap);
+				return m_bin[fl][sl];
+			}
+
+			// Blocks in size class of requested size might still fit.
+			mapping(_size, fl, sl);
+			for (uint32_t idx = m_bin[fl][sl]; kInvalidIdx != idx; idx = m_blocks[idx].m_next)
+			{
+				if (m_blocks[idx].m_size >= _size)
+				{
+					return idx;
+				}
+			}
+
+			return kInvalidIdx;
 		}
 
-	private:
-		struct Free
+		void insertFree(uint64_t _ptr, uint32_t _size)
 		{
-			Free(uint64_t _ptr, uint32_t _size)
-				: m_ptr(_ptr)
-				, m_size(_size)
+			uint32_t idx;
+			if (0 < m_unusedBlocks.size() )
+			{
+				idx = m_unusedBlocks.back();
+				m_unusedBlocks.pop_back();
+			}
+			else
 			{
+				idx = uint32_t(m_blocks.size() );
+				m_blocks.push_back(Block() );
 			}
 
-			bool operator<(const Free& rhs) const
+			uint32_t fl, sl;
+			mapping(_size, fl, sl);
+
+			Block& block = m_blocks[idx];
+			block.m_ptr  = _ptr;
+			block.m_size = _size;
+			block.m_prev = kInvalidIdx;
+			block.m_next = m_bin[fl][sl];
+
+			if (kInvalidIdx != block.m_next)
 			{
-				return m_ptr < rhs.m_ptr;
+				m_blocks[block.m_next].m_prev = idx;
 			}
 
-			uint64_t m_ptr;
-			uint32_t m_size;
-		};
+			m_bin[fl][sl]   = idx;
+			m_flBitmap     |= 1u << fl;
+			m_slBitmap[fl] |= 1u << sl;
+
+			m_freeBegin.insert(stl::make_pair(_ptr, idx) );
+			m_freeEnd.insert(stl::make_pair(_ptr + _size, idx) );
+			m_totalFree += _size;
+		}
+
+		void removeFree(uint32_t _idx)
+		{
+			const Block& block = m_blocks[_idx];
+
+			uint32_t fl, sl;
+			mapping(block.m_size, fl, sl);
+
+			if (kInvalidIdx != block.m_prev)
+			{
+				m_blocks[block.m_prev].m_next = block.m_next;
+			}
+			else
+			{
+				m_bin[fl][sl] = block.m_next;
+
+				if (kInvalidIdx == block.m_next)
+				{
+					m_slBitmap[fl] &= ~(1u << sl);
+					if (0 == m_slBitmap[fl])
+					{
+						m_flBitmap &= ~(1u << fl);
+					}
+				}
+			}
+
+			if (kInvalidIdx != block.m_next)
+			{
+				m_blocks[block.m_next].m_prev = block.m_prev;
+			}
+
+			m_freeBegin.erase(m_freeBegin.find(block.m_ptr) );
+			m_freeEnd.erase(m_freeEnd.find(block.m_ptr + block.m_size) );
+			m_totalFree -= block.m_size;
+
+			m_unusedBlocks.push_back(_idx);
+		}
 
-		typedef stl::list<Free> FreeList;
-		FreeList m_free;
+		typedef stl::vector<Block> BlockArray;
+		BlockArray m_blocks;
+
+		typedef stl::vector<uint32_t> IndexArray;
+		IndexArray m_unusedBlocks;
+
+		typedef stl::unordered_map<uint64_t, uint32_t> FreeMap;
+		FreeMap m_freeBegin;
+		FreeMap m_freeEnd;
 
 		typedef stl::unordered_map<uint64_t, uint32_t> UsedList;
 		UsedList m_used;
+
+		uint32_t m_bin[kNumFl][kNumSl];
+		uint32_t m_slBitmap[kNumFl];
+		uint32_t m_flBitmap;
+		uint32_t m_totalFree;
 	};
 
 	struct BX_NO_VTABLE RendererContextI
@@ -2952,7 +3709,9 @@ namespace bgfx
 		virtual void updateTexture(TextureHandle _handle, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem) = 0;
 		virtual void updateTextureEnd() = 0;
 		virtual void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) = 0;
+		virtual uint32_t getReadTextureLatency() const = 0;
 		virtual void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) = 0;
+		virtual void setTextureMinLod(TextureHandle _handle, uint8_t _minLod) = 0;
 		virtual void overrideInternal(TextureHandle _handle, uintptr_t _ptr) = 0;
 		virtual uintptr_t getInternal(TextureHandle _handle) = 0;
 		virtual void destroyTexture(TextureHandle _handle) = 0;
@@ -2967,6 +3726,9 @@ namespace bgfx
 		virtual void invalidateOcclusionQuery(OcclusionQueryHandle _handle) = 0;
 		virtual void setMarker(const char* _marker, uint16_t _len) = 0;
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) = 0;
+		virtual void prewarmPipeline(ProgramHandle _program, uint64_t _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer) = 0;
+		virtual void flushPipelineCache() = 0;
+		virtual void defragment() = 0;
 		virtual void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) = 0;
 		virtual void blitSetup(TextVideoMemBlitter& _blitter) = 0;
 		virtual void blitRender(TextVideoMemBlitter& _blitter, uint32_t _numIndices) = 0;
@@ -2977,472 +3739,955 @@ namespace bgfx
 	}
 
 	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
+	bool rendererUpdateUniforms(RendererContextI* _renderCtx, const Frame* _render, const RenderDraw& _draw);
 
-#if BGFX_CONFIG_DEBUG
-#	define BGFX_API_FUNC(_func) BX_NO_INLINE _func
-#else
-#	define BGFX_API_FUNC(_func) _func
-#endif // BGFX_CONFIG_DEBUG
-
-	struct Context
+	/// Pool of worker threads owned by bgfx. Used by render thread to split
+	/// frame processing work into independent jobs, and by API thread to queue
+	/// background work (texture decoding) that is retired later.
+	class JobPool
 	{
-		static constexpr uint32_t kAlignment = 64;
-
-		Context()
-			: m_render(&m_frame[0])
-			, m_submit(&m_frame[BGFX_CONFIG_MULTITHREADED ? 1 : 0])
-			, m_numFreeDynamicIndexBufferHandles(0)
-			, m_numFreeDynamicVertexBufferHandles(0)
-			, m_numFreeOcclusionQueryHandles(0)
-			, m_colorPaletteDirty(0)
-			, m_frames(0)
-			, m_debug(BGFX_DEBUG_NONE)
-			, m_rtMemoryUsed(0)
-			, m_textureMemoryUsed(0)
-			, m_renderCtx(NULL)
-			, m_rendererInitialized(false)
+	public:
+		static constexpr uint32_t kMaxThreads   = 16;
+		static constexpr uint32_t kMaxAsyncJobs = BGFX_CONFIG_MAX_TEXTURE_DECODE_JOBS;
+
+		typedef void (*JobFn)(void* _userData, uint32_t _idx);
+		typedef void (*AsyncJobFn)(void* _userData);
+
+		JobPool()
+			: m_numThreads(0)
+			, m_fn(NULL)
+			, m_userData(NULL)
+			, m_num(0)
+			, m_next(0)
+			, m_numTokens(0)
+			, m_asyncRead(0)
+			, m_asyncWrite(0)
 			, m_exit(false)
-			, m_flipAfterRender(false)
-			, m_singleThreaded(false)
 		{
 		}
 
-		~Context()
+		void init(uint32_t _numThreads)
 		{
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+			m_numThreads = bx::min(_numThreads, kMaxThreads);
+			m_numTokens  = 0;
+			m_asyncRead  = 0;
+			m_asyncWrite = 0;
+			m_exit       = false;
+
+			for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+			{
+				m_thread[ii].init(workerThread, this, 0, "bgfx - worker thread");
+			}
+#else
+			BX_UNUSED(_numThreads);
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
 		}
 
-#if BX_CONFIG_SUPPORTS_THREADING
-		static int32_t renderThread(bx::Thread* /*_self*/, void* /*_userData*/)
+		void shutdown()
 		{
-			BX_TRACE("render thread start");
-			BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Render Thread");
-			while (RenderFrame::Exiting != bgfx::renderFrame() ) {};
-			BX_TRACE("render thread exit");
-			return bx::kExitSuccess;
-		}
-#endif
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+			BX_ASSERT(m_asyncRead == m_asyncWrite, "Async jobs must be retired before shutdown.");
 
-		// game thread
-		bool init(const Init& _init);
-		void shutdown();
+			m_exit = true;
+			m_workSem.post(m_numThreads);
 
-		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd)
-		{
-			CommandBuffer& cmdbuf = _cmd < CommandBuffer::End ? m_submit->m_cmdPre : m_submit->m_cmdPost;
-			uint8_t cmd = (uint8_t)_cmd;
-			cmdbuf.write(cmd);
-			return cmdbuf;
+			for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+			{
+				m_thread[ii].shutdown();
+			}
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+
+			m_numThreads = 0;
 		}
 
-		BGFX_API_FUNC(void reset(uint32_t _width, uint32_t _height, uint32_t _flags, TextureFormat::Enum _format) )
+		uint32_t getNumThreads() const
 		{
-			const TextureFormat::Enum format = TextureFormat::Count != _format ? _format : m_init.resolution.format;
+			return m_numThreads;
+		}
 
-			if (!g_platformDataChangedSinceReset
-			&&  m_init.resolution.format == format
-			&&  m_init.resolution.width  == _width
-			&&  m_init.resolution.height == _height
-			&&  m_init.resolution.reset  == _flags)
+		/// Executes `_fn` for every index in [0, _num) and returns when all jobs are
+		/// done. Calling thread participates in processing jobs.
+		void run(JobFn _fn, void* _userData, uint32_t _num)
+		{
+			if (0 == _num)
 			{
-				// Nothing changed, ignore request.
 				return;
 			}
 
-			BX_WARN(g_caps.limits.maxTextureSize >= _width
-				&&  g_caps.limits.maxTextureSize >= _height
-				, "Frame buffer resolution width or height can't be larger than limits.maxTextureSize %d (width %d, height %d)."
-				, g_caps.limits.maxTextureSize
-				, _width
-				, _height
-				);
-			m_init.resolution.format = format;
-			m_init.resolution.width  = bx::clamp(_width,  1u, g_caps.limits.maxTextureSize);
-			m_init.resolution.height = bx::clamp(_height, 1u, g_caps.limits.maxTextureSize);
-			m_init.resolution.reset  = 0
-				| _flags
-				| (g_platformDataChangedSinceReset ? BGFX_RESET_INTERNAL_FORCE : 0)
-				;
-			dump(m_init.resolution);
-			g_platformDataChangedSinceReset = false;
+			m_fn       = _fn;
+			m_userData = _userData;
+			m_num      = _num;
+			m_next     = 0;
 
-			m_flipAfterRender = !!(_flags & BGFX_RESET_FLIP_AFTER_RENDER);
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+			const uint32_t numThreads = bx::min(m_numThreads, _num-1);
+			bx::atomicFetchAndAdd<uint32_t>(&m_numTokens, numThreads);
+			m_workSem.post(numThreads);
+			process();
 
-			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+			// Workers busy with async jobs might not get to this run before calling thread
+			// finished all jobs. Take back their tokens instead of waiting for them.
+			const uint32_t numWorking = numThreads - claimTokens(UINT32_MAX);
+
+			for (uint32_t ii = 0; ii < numWorking; ++ii)
 			{
-				m_view[ii].setFrameBuffer(BGFX_INVALID_HANDLE);
+				m_doneSem.wait();
 			}
+#else
+			process();
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+		}
 
-			for (uint16_t ii = 0, num = m_textureHandle.getNumHandles(); ii < num; ++ii)
+		/// Queues `_fn` to be executed on worker thread, and returns immediately. Caller is
+		/// responsible for tracking completion, and for not having more than `kMaxAsyncJobs`
+		/// jobs in flight. Returns false when there are no worker threads, in which case
+		/// caller should execute work itself.
+		bool runAsync(AsyncJobFn _fn, void* _userData)
+		{
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+			if (0 < m_numThreads)
 			{
-				uint16_t textureIdx = m_textureHandle.getHandleAt(ii);
-				const TextureRef& ref = m_textureRef[textureIdx];
-				if (BackbufferRatio::Count != ref.m_bbRatio)
 				{
-					TextureHandle handle = { textureIdx };
-					resizeTexture(handle
-						, uint16_t(m_init.resolution.width)
-						, uint16_t(m_init.resolution.height)
-						, ref.m_numMips
-						, ref.m_numLayers
-						);
-					m_init.resolution.reset |= BGFX_RESET_INTERNAL_FORCE;
+					bx::MutexScope scope(m_asyncMutex);
+					BX_ASSERT(m_asyncWrite - m_asyncRead < kMaxAsyncJobs, "Async job queue is full.");
+
+					AsyncJob& job = m_asyncJob[m_asyncWrite % kMaxAsyncJobs];
+					job.m_fn       = _fn;
+					job.m_userData = _userData;
+					++m_asyncWrite;
 				}
+
+				m_workSem.post();
+				return true;
 			}
-		}
+#else
+			BX_UNUSED(_fn, _userData);
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
 
-		BGFX_API_FUNC(void setDebug(uint32_t _debug) )
-		{
-			m_debug = _debug;
+			return false;
 		}
 
-		BGFX_API_FUNC(void dbgTextClear(uint8_t _attr, bool _small) )
+	private:
+		void process()
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
-			m_submit->m_textVideoMem->resize(_small, (uint16_t)m_init.resolution.width, (uint16_t)m_init.resolution.height);
-			m_submit->m_textVideoMem->clear(_attr);
+			for (uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_next, 1)
+				; idx < m_num
+				; idx = bx::atomicFetchAndAdd<uint32_t>(&m_next, 1)
+				)
+			{
+				m_fn(m_userData, idx);
+			}
 		}
 
-		BGFX_API_FUNC(void dbgTextPrintfVargs(uint16_t _x, uint16_t _y, uint8_t _attr, const char* _format, va_list _argList) )
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+		struct AsyncJob
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
-			m_submit->m_textVideoMem->printfVargs(_x, _y, _attr, _format, _argList);
-		}
+			AsyncJobFn m_fn;
+			void*      m_userData;
+		};
 
-		BGFX_API_FUNC(void dbgTextImage(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const void* _data, uint16_t _pitch) )
+		/// Work semaphore is shared between `run` and `runAsync`. Each post made by `run`
+		/// is paired with a token, worker that claims token participates in `run`,
+		/// otherwise it executes one async job. Posts are never fewer than tokens plus
+		/// queued async jobs, so async jobs can't be starved.
+		uint32_t claimTokens(uint32_t _max)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			for (uint32_t num = m_numTokens; 0 < num; num = m_numTokens)
+			{
+				const uint32_t claim = bx::min(num, _max);
 
-			m_submit->m_textVideoMem->image(_x, _y, _width, _height, _data, _pitch);
+				if (num == bx::atomicCompareAndSwap<uint32_t>(&m_numTokens, num, num - claim) )
+				{
+					return claim;
+				}
+			}
+
+			return 0;
 		}
 
-		BGFX_API_FUNC(const Stats* getPerfStats() )
+		void processAsync()
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			AsyncJob job;
 
-			Stats& stats = m_submit->m_perfStats;
-			const Resolution& resolution = m_submit->m_resolution;
-			stats.width  = uint16_t(resolution.width);
-			stats.height = uint16_t(resolution.height);
-			const TextVideoMem* tvm = m_submit->m_textVideoMem;
-			stats.textWidth  = tvm->m_width;
-			stats.textHeight = tvm->m_height;
-			stats.encoderStats = m_encoderStats;
+			{
+				bx::MutexScope scope(m_asyncMutex);
 
-			stats.numDynamicIndexBuffers  = m_dynamicIndexBufferHandle.getNumHandles();
-			stats.numDynamicVertexBuffers = m_dynamicVertexBufferHandle.getNumHandles();
-			stats.numFrameBuffers         = m_frameBufferHandle.getNumHandles();
-			stats.numIndexBuffers         = m_indexBufferHandle.getNumHandles();
-			stats.numOcclusionQueries     = m_occlusionQueryHandle.getNumHandles();
-			stats.numPrograms             = m_programHandle.getNumHandles();
-			stats.numShaders              = m_shaderHandle.getNumHandles();
-			stats.numTextures             = m_textureHandle.getNumHandles();
-			stats.numUniforms             = m_uniformHandle.getNumHandles();
-			stats.numVertexBuffers        = m_vertexBufferHandle.getNumHandles();
-			stats.numVertexLayouts        = m_layoutHandle.getNumHandles();
+				if (m_asyncRead == m_asyncWrite)
+				{
+					// Post left behind by tokens taken back in `run`.
+					return;
+				}
 
-			stats.textureMemoryUsed = m_textureMemoryUsed;
-			stats.rtMemoryUsed      = m_rtMemoryUsed;
+				job = m_asyncJob[m_asyncRead % kMaxAsyncJobs];
+				++m_asyncRead;
+			}
 
-			return &stats;
+			job.m_fn(job.m_userData);
 		}
 
-		BGFX_API_FUNC(IndexBufferHandle createIndexBuffer(const Memory* _mem, uint16_t _flags) )
+		static int32_t workerThread(bx::Thread* /*_self*/, void* _userData)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
-			IndexBufferHandle handle = { m_indexBufferHandle.alloc() };
+			JobPool* pool = (JobPool*)_userData;
+			BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Worker Thread");
 
-			BX_WARN(isValid(handle), "Failed to allocate index buffer handle.");
-			if (isValid(handle) )
+			for (;;)
 			{
-				IndexBuffer& ib = m_indexBuffers[handle.idx];
-				ib.m_size  = _mem->size;
-				ib.m_flags = _flags;
+				pool->m_workSem.wait();
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateIndexBuffer);
-				cmdbuf.write(handle);
-				cmdbuf.write(_mem);
-				cmdbuf.write(_flags);
+				if (pool->m_exit)
+				{
+					break;
+				}
 
-				setDebugName(convert(handle) );
-			}
-			else
-			{
-				release(_mem);
+				if (0 != pool->claimTokens(1) )
+				{
+					pool->process();
+					pool->m_doneSem.post();
+				}
+				else
+				{
+					pool->processAsync();
+				}
 			}
 
-			return handle;
+			return bx::kExitSuccess;
 		}
 
-		BGFX_API_FUNC(void setName(IndexBufferHandle _handle, const bx::StringView& _name) )
-		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+		bx::Thread    m_thread[kMaxThreads];
+		bx::Semaphore m_workSem;
+		bx::Semaphore m_doneSem;
+		bx::Mutex     m_asyncMutex;
+		AsyncJob      m_asyncJob[kMaxAsyncJobs];
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
 
-			BGFX_CHECK_HANDLE("setName", m_indexBufferHandle, _handle);
+		uint32_t m_numThreads;
+		JobFn    m_fn;
+		void*    m_userData;
+		uint32_t m_num;
+		uint32_t m_next;
+		uint32_t m_numTokens;
+		uint32_t m_asyncRead;
+		uint32_t m_asyncWrite;
+		volatile bool m_exit;
+	};
 
-			IndexBuffer& ref = m_indexBuffers[_handle.idx];
-			ref.m_name.set(_name);
+	/// Returns worker thread pool. Must be used only from render thread.
+	JobPool& rendererGetJobPool();
 
-			setName(convert(_handle), _name);
-		}
+	/// Decodes textures in formats renderer can't sample from on worker threads, so that
+	/// render thread only copies already decoded data into upload memory. Jobs are retired
+	/// in the order they were queued. Textures of jobs that are still decoding at frame end
+	/// are created empty, and decoded data is uploaded once job is retired.
+	class TextureDecoder
+	{
+	public:
+		static constexpr uint32_t kMaxJobs = BGFX_CONFIG_MAX_TEXTURE_DECODE_JOBS;
+
+		struct Job
+		{
+			TextureHandle m_handle;
+			const Memory* m_mem;
+			const Memory* m_src;
+			TextureCreate m_create;
+			uint64_t      m_flags;
+			uint8_t       m_skip;
+			bool          m_done;
+			bool          m_created;
+			bool          m_canceled;
+		};
 
-		BGFX_API_FUNC(void destroyIndexBuffer(IndexBufferHandle _handle) )
+		TextureDecoder()
+			: m_jobPool(NULL)
+			, m_read(0)
+			, m_next(0)
+			, m_write(0)
+			, m_create(0)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
-			BGFX_CHECK_HANDLE("destroyIndexBuffer", m_indexBufferHandle, _handle);
-			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
-			BX_ASSERT(ok, "Index buffer handle %d is already destroyed!", _handle.idx);
-
-			IndexBuffer& ref = m_indexBuffers[_handle.idx];
-			ref.m_name.clear();
-
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyIndexBuffer);
-			cmdbuf.write(_handle);
 		}
 
-		VertexLayoutHandle findVertexLayout(const VertexLayout& _layout)
+		/// Decode jobs are executed by worker threads of `_jobPool`.
+		void init(JobPool* _jobPool)
 		{
-			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.find(_layout.m_hash);
-
-			if (!isValid(layoutHandle) )
-			{
-				layoutHandle.idx = m_layoutHandle.alloc();
-				if (!isValid(layoutHandle) )
-				{
-					return layoutHandle;
-				}
-
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexLayout);
-				cmdbuf.write(layoutHandle);
-				cmdbuf.write(_layout);
-			}
-
-			return layoutHandle;
+			m_jobPool = _jobPool;
 		}
 
-		BGFX_API_FUNC(VertexLayoutHandle createVertexLayout(const VertexLayout& _layout) )
+		void shutdown()
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
-			VertexLayoutHandle handle = findVertexLayout(_layout);
-			if (!isValid(handle) )
-			{
-				BX_TRACE("WARNING: Failed to allocate vertex layout handle (BGFX_CONFIG_MAX_VERTEX_LAYOUTS, max: %d).", BGFX_CONFIG_MAX_VERTEX_LAYOUTS);
-				return BGFX_INVALID_HANDLE;
-			}
-
-			m_vertexLayoutRef.add(handle, _layout.m_hash);
+			BX_ASSERT(isEmpty(), "Texture decode jobs must be retired before shutdown.");
+			m_jobPool = NULL;
+		}
 
-			return handle;
+		uint32_t getNumThreads() const
+		{
+			return NULL != m_jobPool ? m_jobPool->getNumThreads() : 0;
 		}
 
-		BGFX_API_FUNC(void destroyVertexLayout(VertexLayoutHandle _handle) )
+		bool isEmpty() const
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-			if (isValid(m_vertexLayoutRef.release(_handle) ) )
-			{
-				m_submit->free(_handle);
-			}
+			return m_read == m_write;
 		}
 
-		BGFX_API_FUNC(VertexBufferHandle createVertexBuffer(const Memory* _mem, const VertexLayout& _layout, uint16_t _flags) )
+		bool isFull() const
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			return m_write - m_read == kMaxJobs;
+		}
 
-			VertexBufferHandle handle = { m_vertexBufferHandle.alloc() };
+		/// Queues texture for decode. Caller must retire oldest job when queue is full.
+		void push(const Job& _job)
+		{
+			BX_ASSERT(!isFull(), "Texture decode queue is full.");
 
-			if (isValid(handle) )
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+			if (0 < getNumThreads() )
 			{
-				VertexLayoutHandle layoutHandle = findVertexLayout(_layout);
-				if (!isValid(layoutHandle) )
 				{
-					BX_TRACE("WARNING: Failed to allocate vertex layout handle (BGFX_CONFIG_MAX_VERTEX_LAYOUTS, max: %d).", BGFX_CONFIG_MAX_VERTEX_LAYOUTS);
-					m_vertexBufferHandle.free(handle.idx);
-					return BGFX_INVALID_HANDLE;
+					bx::MutexScope scope(m_mutex);
+					Job& job = m_job[m_write % kMaxJobs];
+					job = _job;
+					job.m_src      = NULL;
+					job.m_done     = false;
+					job.m_created  = false;
+					job.m_canceled = false;
+					++m_write;
 				}
 
-				m_vertexLayoutRef.add(handle, layoutHandle, _layout.m_hash);
-
-				VertexBuffer& vb = m_vertexBuffers[handle.idx];
-				vb.m_size   = _mem->size;
-				vb.m_stride = _layout.m_stride;
-
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexBuffer);
-				cmdbuf.write(handle);
-				cmdbuf.write(_mem);
-				cmdbuf.write(layoutHandle);
-				cmdbuf.write(_flags);
-
-				setDebugName(convert(handle) );
-
-				return handle;
+				m_jobPool->runAsync(decodeJob, this);
+				return;
 			}
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
 
-			BX_TRACE("WARNING: Failed to allocate vertex buffer handle (BGFX_CONFIG_MAX_VERTEX_BUFFERS, max: %d).", BGFX_CONFIG_MAX_VERTEX_BUFFERS);
-			release(_mem);
-
-			return BGFX_INVALID_HANDLE;
+			// Without worker threads texture is decoded on calling thread.
+			Job& job = m_job[m_write % kMaxJobs];
+			job = _job;
+			job.m_src      = NULL;
+			job.m_created  = false;
+			job.m_canceled = false;
+			decode(job);
+			job.m_done = true;
+			++m_write;
 		}
 
-		BGFX_API_FUNC(void setName(VertexBufferHandle _handle, const bx::StringView& _name) )
+		/// Waits for the oldest job to finish and removes it from queue.
+		Job pop()
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			BX_ASSERT(!isEmpty(), "Texture decode queue is empty.");
 
-			BGFX_CHECK_HANDLE("setName", m_vertexBufferHandle, _handle);
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+			bx::MutexScope scope(m_mutex);
 
-			VertexBuffer& ref = m_vertexBuffers[_handle.idx];
-			ref.m_name.set(_name);
+			while (!m_job[m_read % kMaxJobs].m_done)
+			{
+				m_mutex.unlock();
+				m_doneSem.wait();
+				m_mutex.lock();
+			}
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
 
-			setName(convert(_handle), _name);
+			return retire();
 		}
 
-		BGFX_API_FUNC(void destroyVertexBuffer(VertexBufferHandle _handle) )
+		/// Removes the oldest job from queue if it's finished, without waiting.
+		bool tryPop(Job& _job)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
-			BGFX_CHECK_HANDLE("destroyVertexBuffer", m_vertexBufferHandle, _handle);
-			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
-			BX_ASSERT(ok, "Vertex buffer handle %d is already destroyed!", _handle.idx);
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+			bx::MutexScope scope(m_mutex);
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
 
-			VertexBuffer& ref = m_vertexBuffers[_handle.idx];
-			ref.m_name.clear();
+			if (isEmpty()
+			||  !m_job[m_read % kMaxJobs].m_done)
+			{
+				return false;
+			}
 
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexBuffer);
-			cmdbuf.write(_handle);
+			_job = retire();
+			return true;
 		}
 
-		void destroyVertexBufferInternal(VertexBufferHandle _handle)
+		/// Marks the oldest job without texture created as created. Only handle, flags and
+		/// decoded texture description of job are returned, the rest is still used by decode.
+		bool markCreated(Job& _job)
 		{
-			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.release(_handle);
-			if (isValid(layoutHandle) )
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+			bx::MutexScope scope(m_mutex);
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+
+			if (m_create == m_write)
 			{
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexLayout);
-				cmdbuf.write(layoutHandle);
-				m_render->free(layoutHandle);
+				return false;
 			}
 
-			m_vertexBufferHandle.free(_handle.idx);
+			Job& job = m_job[m_create % kMaxJobs];
+			job.m_created = true;
+			++m_create;
+
+			_job.m_handle = job.m_handle;
+			_job.m_create = job.m_create;
+			_job.m_flags  = job.m_flags;
+
+			return true;
 		}
 
-		uint64_t allocDynamicIndexBuffer(uint32_t _size, uint16_t _flags)
+		/// Texture was destroyed, decoded data of its queued jobs is dropped.
+		void cancel(TextureHandle _handle)
 		{
-			uint64_t ptr = m_dynIndexBufferAllocator.alloc(_size);
-			if (ptr == NonLocalAllocator::kInvalidBlock)
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+			bx::MutexScope scope(m_mutex);
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+
+			for (uint32_t ii = m_read; ii != m_write; ++ii)
 			{
-				IndexBufferHandle indexBufferHandle = { m_indexBufferHandle.alloc() };
-				if (!isValid(indexBufferHandle) )
+				Job& job = m_job[ii % kMaxJobs];
+
+				if (job.m_handle.idx == _handle.idx)
 				{
-					BX_TRACE("Failed to allocate index buffer handle.");
-					return NonLocalAllocator::kInvalidBlock;
+					job.m_canceled = true;
 				}
+			}
+		}
 
-				const uint32_t allocSize = bx::max<uint32_t>(BGFX_CONFIG_DYNAMIC_INDEX_BUFFER_SIZE, _size);
-
-				IndexBuffer& ib = m_indexBuffers[indexBufferHandle.idx];
-				ib.m_size = allocSize;
-
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
-				cmdbuf.write(indexBufferHandle);
-				cmdbuf.write(allocSize);
-				cmdbuf.write(_flags);
+		/// Returns size and format of texture after decode.
+		static void getDecodedCreate(TextureCreate& _create, const bimg::ImageContainer& _imageContainer, uint8_t _skip);
 
-				m_dynIndexBufferAllocator.add(uint64_t(indexBufferHandle.idx) << 32, allocSize);
-				ptr = m_dynIndexBufferAllocator.alloc(_size);
-			}
+		/// Returns true if texture data has to be decoded before renderer can use it.
+		static bool needsDecode(const bimg::ImageContainer& _imageContainer, const Memory* _mem);
 
-			return ptr;
-		}
+		/// Decodes job's texture to BGRA8, replaces job's memory with decoded texture. Source
+		/// memory is moved to `m_src`, it's not released here since decode might run on worker
+		/// thread and user's `ReleaseFn` must be called from API thread.
+		static void decode(Job& _job);
 
-		uint64_t allocIndexBuffer(uint32_t _size, uint16_t _flags)
+	private:
+		Job retire()
 		{
-			IndexBufferHandle indexBufferHandle = { m_indexBufferHandle.alloc() };
-			if (!isValid(indexBufferHandle) )
+			Job job = m_job[m_read % kMaxJobs];
+
+			if (m_create == m_read)
 			{
-				BX_TRACE("Failed to allocate index buffer handle.");
-				return NonLocalAllocator::kInvalidBlock;
+				++m_create;
 			}
 
-			IndexBuffer& ib = m_indexBuffers[indexBufferHandle.idx];
-			ib.m_size = _size;
-
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
-			cmdbuf.write(indexBufferHandle);
-			cmdbuf.write(_size);
-			cmdbuf.write(_flags);
-
-			setDebugName(convert(indexBufferHandle), "Dynamic Index Buffer");
+			++m_read;
 
-			return uint64_t(indexBufferHandle.idx) << 32;
+			return job;
 		}
 
-		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num, uint16_t _flags) )
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+		static void decodeJob(void* _userData)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			TextureDecoder* decoder = (TextureDecoder*)_userData;
 
-			DynamicIndexBufferHandle handle = { m_dynamicIndexBufferHandle.alloc() };
-			if (!isValid(handle) )
+			Job* job;
 			{
-				BX_TRACE("Failed to allocate dynamic index buffer handle.");
-				return handle;
+				bx::MutexScope scope(decoder->m_mutex);
+				job = &decoder->m_job[decoder->m_next % kMaxJobs];
+				++decoder->m_next;
 			}
 
-			const uint32_t indexSize = 0 == (_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
-			const uint32_t size = bx::alignUp(_num*indexSize, 16);
-
-			const uint64_t ptr = (0 != (_flags & BGFX_BUFFER_COMPUTE_READ_WRITE) )
-				? allocIndexBuffer(size, _flags)
-				: allocDynamicIndexBuffer(size, _flags)
-				;
+			decode(*job);
 
-			if (ptr == NonLocalAllocator::kInvalidBlock)
 			{
-				m_dynamicIndexBufferHandle.free(handle.idx);
-				return BGFX_INVALID_HANDLE;
+				bx::MutexScope scope(decoder->m_mutex);
+				job->m_done = true;
 			}
 
-			DynamicIndexBuffer& dib = m_dynamicIndexBuffers[handle.idx];
-			dib.m_handle.idx = uint16_t(ptr>>32);
-			dib.m_offset     = uint32_t(ptr);
-			dib.m_size       = _num * indexSize;
-			dib.m_startIndex = bx::strideAlign(dib.m_offset, indexSize)/indexSize;
-			dib.m_flags      = _flags;
-
-			return handle;
+			decoder->m_doneSem.post();
 		}
 
-		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(const Memory* _mem, uint16_t _flags) )
-		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+		bx::Semaphore m_doneSem;
+		bx::Mutex     m_mutex;
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
 
-			BX_ASSERT(0 == (_flags &  BGFX_BUFFER_COMPUTE_READ_WRITE), "Cannot initialize compute buffer from CPU.");
-			const uint32_t indexSize = 0 == (_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
-			DynamicIndexBufferHandle handle = createDynamicIndexBuffer(_mem->size/indexSize, _flags);
+		JobPool* m_jobPool;
+		Job      m_job[kMaxJobs];
+		uint32_t m_read;
+		uint32_t m_next;
+		uint32_t m_write;
+		uint32_t m_create;
+	};
 
-			if (!isValid(handle) )
-			{
-				release(_mem);
-				return BGFX_INVALID_HANDLE;
-			}
+#if BGFX_CONFIG_DEBUG
+#	define BGFX_API_FUNC(_func) BX_NO_INLINE _func
+#else
+#	define BGFX_API_FUNC(_func) _func
+#endif // BGFX_CONFIG_DEBUG
 
-			update(handle, 0, _mem);
+	struct Context
+	{
+		static constexpr uint32_t kAlignment = 64;
 
-			return handle;
+		Context()
+			: m_render(&m_frame[0])
+			, m_submit(&m_frame[BGFX_CONFIG_MULTITHREADED ? 1 : 0])
+			, m_tempKeys(NULL)
+			, m_tempValues(NULL)
+			, m_maxTempItems(0)
+			, m_renderItemCapacity(0)
+			, m_renderItemPeak(0)
+			, m_renderItemLowFrames(0)
+			, m_matrixCacheCapacity(0)
+			, m_numFreeDynamicIndexBufferHandles(0)
+			, m_numFreeDynamicVertexBufferHandles(0)
+			, m_numFreeOcclusionQueryHandles(0)
+			, m_numDirtyUniformBlocks(0)
+			, m_uniformBlockApplied(false)
+			, m_colorPaletteDirty(0)
+			, m_frames(0)
+			, m_debug(BGFX_DEBUG_NONE)
+			, m_rtMemoryUsed(0)
+			, m_textureMemoryUsed(0)
+			, m_renderCtx(NULL)
+			, m_rendererInitialized(false)
+			, m_exit(false)
+			, m_flipAfterRender(false)
+			, m_singleThreaded(false)
+		{
 		}
 
-		BGFX_API_FUNC(void update(DynamicIndexBufferHandle _handle, uint32_t _startIndex, const Memory* _mem) )
+		~Context()
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
-			BGFX_CHECK_HANDLE("updateDynamicIndexBuffer", m_dynamicIndexBufferHandle, _handle);
-
-			DynamicIndexBuffer& dib = m_dynamicIndexBuffers[_handle.idx];
-			BX_ASSERT(0 == (dib.m_flags &  BGFX_BUFFER_COMPUTE_WRITE), "Can't update GPU buffer from CPU.");
-			const uint32_t indexSize = 0 == (dib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+		}
 
-			if (dib.m_size < _mem->size
+#if BX_CONFIG_SUPPORTS_THREADING
+		static int32_t renderThread(bx::Thread* /*_self*/, void* /*_userData*/)
+		{
+			BX_TRACE("render thread start");
+			BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Render Thread");
+			while (RenderFrame::Exiting != bgfx::renderFrame() ) {};
+			BX_TRACE("render thread exit");
+			return bx::kExitSuccess;
+		}
+#endif
+
+		// game thread
+		bool init(const Init& _init);
+		void shutdown();
+
+		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd)
+		{
+			CommandBuffer& cmdbuf = _cmd < CommandBuffer::End ? m_submit->m_cmdPre : m_submit->m_cmdPost;
+			uint8_t cmd = (uint8_t)_cmd;
+			cmdbuf.write(cmd);
+			return cmdbuf;
+		}
+
+		BGFX_API_FUNC(void reset(uint32_t _width, uint32_t _height, uint32_t _flags, TextureFormat::Enum _format) )
+		{
+			const TextureFormat::Enum format = TextureFormat::Count != _format ? _format : m_init.resolution.format;
+
+			if (!g_platformDataChangedSinceReset
+			&&  m_init.resolution.format == format
+			&&  m_init.resolution.width  == _width
+			&&  m_init.resolution.height == _height
+			&&  m_init.resolution.reset  == _flags)
+			{
+				// Nothing changed, ignore request.
+				return;
+			}
+
+			BX_WARN(g_caps.limits.maxTextureSize >= _width
+				&&  g_caps.limits.maxTextureSize >= _height
+				, "Frame buffer resolution width or height can't be larger than limits.maxTextureSize %d (width %d, height %d)."
+				, g_caps.limits.maxTextureSize
+				, _width
+				, _height
+				);
+			m_init.resolution.format = format;
+			m_init.resolution.width  = bx::clamp(_width,  1u, g_caps.limits.maxTextureSize);
+			m_init.resolution.height = bx::clamp(_height, 1u, g_caps.limits.maxTextureSize);
+			m_init.resolution.reset  = 0
+				| _flags
+				| (g_platformDataChangedSinceReset ? BGFX_RESET_INTERNAL_FORCE : 0)
+				;
+			dump(m_init.resolution);
+			g_platformDataChangedSinceReset = false;
+
+			m_flipAfterRender = !!(_flags & BGFX_RESET_FLIP_AFTER_RENDER);
+
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+			{
+				m_view[ii].setFrameBuffer(BGFX_INVALID_HANDLE);
+			}
+
+			for (uint16_t ii = 0, num = m_textureHandle.getNumHandles(); ii < num; ++ii)
+			{
+				uint16_t textureIdx = m_textureHandle.getHandleAt(ii);
+				const TextureRef& ref = m_textureRef[textureIdx];
+				if (BackbufferRatio::Count != ref.m_bbRatio)
+				{
+					TextureHandle handle = { textureIdx };
+					resizeTexture(handle
+						, uint16_t(m_init.resolution.width)
+						, uint16_t(m_init.resolution.height)
+						, ref.m_numMips
+						, ref.m_numLayers
+						);
+					m_init.resolution.reset |= BGFX_RESET_INTERNAL_FORCE;
+				}
+			}
+		}
+
+		BGFX_API_FUNC(void setDebug(uint32_t _debug) )
+		{
+			m_debug = _debug;
+		}
+
+		BGFX_API_FUNC(void dbgTextClear(uint8_t _attr, bool _small) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			m_submit->m_textVideoMem->resize(_small, (uint16_t)m_init.resolution.width, (uint16_t)m_init.resolution.height);
+			m_submit->m_textVideoMem->clear(_attr);
+		}
+
+		BGFX_API_FUNC(void dbgTextPrintfVargs(uint16_t _x, uint16_t _y, uint8_t _attr, const char* _format, va_list _argList) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			m_submit->m_textVideoMem->printfVargs(_x, _y, _attr, _format, _argList);
+		}
+
+		BGFX_API_FUNC(void dbgTextImage(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const void* _data, uint16_t _pitch) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			m_submit->m_textVideoMem->image(_x, _y, _width, _height, _data, _pitch);
+		}
+
+		BGFX_API_FUNC(const Stats* getPerfStats() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			Stats& stats = m_submit->m_perfStats;
+			const Resolution& resolution = m_submit->m_resolution;
+			stats.width  = uint16_t(resolution.width);
+			stats.height = uint16_t(resolution.height);
+			const TextVideoMem* tvm = m_submit->m_textVideoMem;
+			stats.textWidth  = tvm->m_width;
+			stats.textHeight = tvm->m_height;
+			stats.encoderStats = m_encoderStats;
+
+			stats.numDynamicIndexBuffers  = m_dynamicIndexBufferHandle.getNumHandles();
+			stats.numDynamicVertexBuffers = m_dynamicVertexBufferHandle.getNumHandles();
+			stats.numFrameBuffers         = m_frameBufferHandle.getNumHandles();
+			stats.numIndexBuffers         = m_indexBufferHandle.getNumHandles();
+			stats.numOcclusionQueries     = m_occlusionQueryHandle.getNumHandles();
+			stats.numPrograms             = m_programHandle.getNumHandles();
+			stats.numShaders              = m_shaderHandle.getNumHandles();
+			stats.numTextures             = m_textureHandle.getNumHandles();
+			stats.numUniforms             = m_uniformHandle.getNumHandles();
+			stats.numVertexBuffers        = m_vertexBufferHandle.getNumHandles();
+			stats.numVertexLayouts        = m_layoutHandle.getNumHandles();
+
+			stats.textureMemoryUsed = m_textureMemoryUsed;
+			stats.rtMemoryUsed      = m_rtMemoryUsed;
+
+			stats.textureStreamResident = m_textureStreamResident;
+			stats.textureStreamPending  = m_textureStreamPending;
+
+			stats.dynamicIbFree        = m_dynIndexBufferAllocator.getTotalFree();
+			stats.dynamicIbLargestFree = m_dynIndexBufferAllocator.getLargestFree();
+			stats.dynamicVbFree        = m_dynVertexBufferAllocator.getTotalFree();
+			stats.dynamicVbLargestFree = m_dynVertexBufferAllocator.getLargestFree();
+
+			return &stats;
+		}
+
+		BGFX_API_FUNC(IndexBufferHandle createIndexBuffer(const Memory* _mem, uint16_t _flags) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			IndexBufferHandle handle = { m_indexBufferHandle.alloc() };
+
+			BX_WARN(isValid(handle), "Failed to allocate index buffer handle.");
+			if (isValid(handle) )
+			{
+				IndexBuffer& ib = m_indexBuffers[handle.idx];
+				ib.m_size  = _mem->size;
+				ib.m_flags = _flags;
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateIndexBuffer);
+				cmdbuf.write(handle);
+				cmdbuf.write(_mem);
+				cmdbuf.write(_flags);
+
+				setDebugName(convert(handle) );
+			}
+			else
+			{
+				release(_mem);
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void setName(IndexBufferHandle _handle, const bx::StringView& _name) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("setName", m_indexBufferHandle, _handle);
+
+			IndexBuffer& ref = m_indexBuffers[_handle.idx];
+			ref.m_name.set(_name);
+
+			setName(convert(_handle), _name);
+		}
+
+		BGFX_API_FUNC(void destroyIndexBuffer(IndexBufferHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyIndexBuffer", m_indexBufferHandle, _handle);
+			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
+			BX_ASSERT(ok, "Index buffer handle %d is already destroyed!", _handle.idx);
+
+			IndexBuffer& ref = m_indexBuffers[_handle.idx];
+			ref.m_name.clear();
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyIndexBuffer);
+			cmdbuf.write(_handle);
+		}
+
+		VertexLayoutHandle findVertexLayout(const VertexLayout& _layout)
+		{
+			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.find(_layout.m_hash);
+
+			if (!isValid(layoutHandle) )
+			{
+				layoutHandle.idx = m_layoutHandle.alloc();
+				if (!isValid(layoutHandle) )
+				{
+					return layoutHandle;
+				}
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexLayout);
+				cmdbuf.write(layoutHandle);
+				cmdbuf.write(_layout);
+			}
+
+			return layoutHandle;
+		}
+
+		BGFX_API_FUNC(VertexLayoutHandle createVertexLayout(const VertexLayout& _layout) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			VertexLayoutHandle handle = findVertexLayout(_layout);
+			if (!isValid(handle) )
+			{
+				BX_TRACE("WARNING: Failed to allocate vertex layout handle (BGFX_CONFIG_MAX_VERTEX_LAYOUTS, max: %d).", BGFX_CONFIG_MAX_VERTEX_LAYOUTS);
+				return BGFX_INVALID_HANDLE;
+			}
+
+			m_vertexLayoutRef.add(handle, _layout.m_hash);
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void destroyVertexLayout(VertexLayoutHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			if (isValid(m_vertexLayoutRef.release(_handle) ) )
+			{
+				m_submit->free(_handle);
+			}
+		}
+
+		BGFX_API_FUNC(VertexBufferHandle createVertexBuffer(const Memory* _mem, const VertexLayout& _layout, uint16_t _flags) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			VertexBufferHandle handle = { m_vertexBufferHandle.alloc() };
+
+			if (isValid(handle) )
+			{
+				VertexLayoutHandle layoutHandle = findVertexLayout(_layout);
+				if (!isValid(layoutHandle) )
+				{
+					BX_TRACE("WARNING: Failed to allocate vertex layout handle (BGFX_CONFIG_MAX_VERTEX_LAYOUTS, max: %d).", BGFX_CONFIG_MAX_VERTEX_LAYOUTS);
+					m_vertexBufferHandle.free(handle.idx);
+					return BGFX_INVALID_HANDLE;
+				}
+
+				m_vertexLayoutRef.add(handle, layoutHandle, _layout.m_hash);
+
+				VertexBuffer& vb = m_vertexBuffers[handle.idx];
+				vb.m_size   = _mem->size;
+				vb.m_stride = _layout.m_stride;
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexBuffer);
+				cmdbuf.write(handle);
+				cmdbuf.write(_mem);
+				cmdbuf.write(layoutHandle);
+				cmdbuf.write(_flags);
+
+				setDebugName(convert(handle) );
+
+				return handle;
+			}
+
+			BX_TRACE("WARNING: Failed to allocate vertex buffer handle (BGFX_CONFIG_MAX_VERTEX_BUFFERS, max: %d).", BGFX_CONFIG_MAX_VERTEX_BUFFERS);
+			release(_mem);
+
+			return BGFX_INVALID_HANDLE;
+		}
+
+		BGFX_API_FUNC(void setName(VertexBufferHandle _handle, const bx::StringView& _name) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("setName", m_vertexBufferHandle, _handle);
+
+			VertexBuffer& ref = m_vertexBuffers[_handle.idx];
+			ref.m_name.set(_name);
+
+			setName(convert(_handle), _name);
+		}
+
+		BGFX_API_FUNC(void destroyVertexBuffer(VertexBufferHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyVertexBuffer", m_vertexBufferHandle, _handle);
+			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
+			BX_ASSERT(ok, "Vertex buffer handle %d is already destroyed!", _handle.idx);
+
+			VertexBuffer& ref = m_vertexBuffers[_handle.idx];
+			ref.m_name.clear();
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexBuffer);
+			cmdbuf.write(_handle);
+		}
+
+		void destroyVertexBufferInternal(VertexBufferHandle _handle)
+		{
+			VertexLayoutHandle layoutHandle = m_vertexLayoutRef.release(_handle);
+			if (isValid(layoutHandle) )
+			{
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyVertexLayout);
+				cmdbuf.write(layoutHandle);
+				m_render->free(layoutHandle);
+			}
+
+			m_vertexBufferHandle.free(_handle.idx);
+		}
+
+		uint64_t allocDynamicIndexBuffer(uint32_t _size, uint16_t _flags)
+		{
+			uint64_t ptr = m_dynIndexBufferAllocator.alloc(_size);
+			if (ptr == NonLocalAllocator::kInvalidBlock)
+			{
+				IndexBufferHandle indexBufferHandle = { m_indexBufferHandle.alloc() };
+				if (!isValid(indexBufferHandle) )
+				{
+					BX_TRACE("Failed to allocate index buffer handle.");
+					return NonLocalAllocator::kInvalidBlock;
+				}
+
+				const uint32_t allocSize = bx::max<uint32_t>(BGFX_CONFIG_DYNAMIC_INDEX_BUFFER_SIZE, _size);
+
+				IndexBuffer& ib = m_indexBuffers[indexBufferHandle.idx];
+				ib.m_size = allocSize;
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
+				cmdbuf.write(indexBufferHandle);
+				cmdbuf.write(allocSize);
+				cmdbuf.write(_flags);
+
+				m_dynIndexBufferAllocator.add(uint64_t(indexBufferHandle.idx) << 32, allocSize);
+				ptr = m_dynIndexBufferAllocator.alloc(_size);
+			}
+
+			return ptr;
+		}
+
+		uint64_t allocIndexBuffer(uint32_t _size, uint16_t _flags)
+		{
+			IndexBufferHandle indexBufferHandle = { m_indexBufferHandle.alloc() };
+			if (!isValid(indexBufferHandle) )
+			{
+				BX_TRACE("Failed to allocate index buffer handle.");
+				return NonLocalAllocator::kInvalidBlock;
+			}
+
+			IndexBuffer& ib = m_indexBuffers[indexBufferHandle.idx];
+			ib.m_size = _size;
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
+			cmdbuf.write(indexBufferHandle);
+			cmdbuf.write(_size);
+			cmdbuf.write(_flags);
+
+			setDebugName(convert(indexBufferHandle), "Dynamic Index Buffer");
+
+			return uint64_t(indexBufferHandle.idx) << 32;
+		}
+
+		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num, uint16_t _flags) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			DynamicIndexBufferHandle handle = { m_dynamicIndexBufferHandle.alloc() };
+			if (!isValid(handle) )
+			{
+				BX_TRACE("Failed to allocate dynamic index buffer handle.");
+				return handle;
+			}
+
+			const uint32_t indexSize = 0 == (_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+			const uint32_t size = bx::alignUp(_num*indexSize, 16);
+
+			const uint64_t ptr = (0 != (_flags & BGFX_BUFFER_COMPUTE_READ_WRITE) )
+				? allocIndexBuffer(size, _flags)
+				: allocDynamicIndexBuffer(size, _flags)
+				;
+
+			if (ptr == NonLocalAllocator::kInvalidBlock)
+			{
+				m_dynamicIndexBufferHandle.free(handle.idx);
+				return BGFX_INVALID_HANDLE;
+			}
+
+			DynamicIndexBuffer& dib = m_dynamicIndexBuffers[handle.idx];
+			dib.m_handle.idx = uint16_t(ptr>>32);
+			dib.m_offset     = uint32_t(ptr);
+			dib.m_size       = _num * indexSize;
+			dib.m_startIndex = bx::strideAlign(dib.m_offset, indexSize)/indexSize;
+			dib.m_flags      = _flags;
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(const Memory* _mem, uint16_t _flags) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BX_ASSERT(0 == (_flags &  BGFX_BUFFER_COMPUTE_READ_WRITE), "Cannot initialize compute buffer from CPU.");
+			const uint32_t indexSize = 0 == (_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+			DynamicIndexBufferHandle handle = createDynamicIndexBuffer(_mem->size/indexSize, _flags);
+
+			if (!isValid(handle) )
+			{
+				release(_mem);
+				return BGFX_INVALID_HANDLE;
+			}
+
+			update(handle, 0, _mem);
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void update(DynamicIndexBufferHandle _handle, uint32_t _startIndex, const Memory* _mem) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("updateDynamicIndexBuffer", m_dynamicIndexBufferHandle, _handle);
+
+			DynamicIndexBuffer& dib = m_dynamicIndexBuffers[_handle.idx];
+			BX_ASSERT(0 == (dib.m_flags &  BGFX_BUFFER_COMPUTE_WRITE), "Can't update GPU buffer from CPU.");
+			const uint32_t indexSize = 0 == (dib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+
+			if (dib.m_size < _mem->size
 			&&  0 != (dib.m_flags & BGFX_BUFFER_ALLOW_RESIZE) )
 			{
 				m_dynIndexBufferAllocator.free(uint64_t(dib.m_handle.idx)<<32 | dib.m_offset);
@@ -3728,7 +4973,7 @@ namespace bgfx
 			return m_submit->getAvailTransientVertexBuffer(_num, _stride);
 		}
 
-		TransientIndexBuffer* createTransientIndexBuffer(uint32_t _size)
+		TransientIndexBuffer* createTransientIndexBuffer(uint32_t _size, uint16_t _flags = BGFX_BUFFER_NONE)
 		{
 			TransientIndexBuffer* tib = NULL;
 
@@ -3739,8 +4984,7 @@ namespace bgfx
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicIndexBuffer);
 				cmdbuf.write(handle);
 				cmdbuf.write(_size);
-				uint16_t flags = BGFX_BUFFER_NONE;
-				cmdbuf.write(flags);
+				cmdbuf.write(_flags);
 
 				const uint32_t size = 0
 					+ bx::alignUp<uint32_t>(sizeof(TransientIndexBuffer), 16)
@@ -3783,7 +5027,7 @@ namespace bgfx
 			_tib->isIndex16  = isIndex16;
 		}
 
-		TransientVertexBuffer* createTransientVertexBuffer(uint32_t _size, const VertexLayout* _layout = NULL)
+		TransientVertexBuffer* createTransientVertexBuffer(uint32_t _size, const VertexLayout* _layout = NULL, uint16_t _flags = BGFX_BUFFER_NONE)
 		{
 			TransientVertexBuffer* tvb = NULL;
 
@@ -3806,8 +5050,7 @@ namespace bgfx
 				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateDynamicVertexBuffer);
 				cmdbuf.write(handle);
 				cmdbuf.write(_size);
-				uint16_t flags = BGFX_BUFFER_NONE;
-				cmdbuf.write(flags);
+				cmdbuf.write(_flags);
 
 				const uint32_t size = 0
 					+ bx::alignUp<uint32_t>(sizeof(TransientVertexBuffer), 16)
@@ -4054,347 +5297,803 @@ namespace bgfx
 				}
 			}
 
-			if (0 != sr.m_num)
+			if (0 != sr.m_num)
+			{
+				uint32_t size = sr.m_num*sizeof(UniformHandle);
+				sr.m_uniforms = (UniformHandle*)BX_ALLOC(g_allocator, size);
+				bx::memCopy(sr.m_uniforms, uniforms, size);
+			}
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateShader);
+			cmdbuf.write(handle);
+			cmdbuf.write(_mem);
+
+			setDebugName(convert(handle) );
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(uint16_t getShaderUniforms(ShaderHandle _handle, UniformHandle* _uniforms, uint16_t _max) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			if (!isValid(_handle) )
+			{
+				BX_WARN(false, "Passing invalid shader handle to bgfx::getShaderUniforms.");
+				return 0;
+			}
+
+			ShaderRef& sr = m_shaderRef[_handle.idx];
+			if (NULL != _uniforms)
+			{
+				bx::memCopy(_uniforms, sr.m_uniforms, bx::min<uint16_t>(_max, sr.m_num)*sizeof(UniformHandle) );
+			}
+
+			return sr.m_num;
+		}
+
+		void setName(Handle _handle, const bx::StringView& _name)
+		{
+			char tmp[1024];
+			uint16_t len = 1+(uint16_t)bx::snprintf(tmp, BX_COUNTOF(tmp), "%sH %d: %.*s", getTypeName(_handle), _handle.idx, _name.getLength(), _name.getPtr() );
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::SetName);
+			cmdbuf.write(_handle);
+			cmdbuf.write(len);
+			cmdbuf.write(tmp, len);
+		}
+
+		void setDebugName(Handle _handle, const bx::StringView& _name = "")
+		{
+			if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
+			{
+				setName(_handle, _name);
+			}
+		}
+
+		BGFX_API_FUNC(void setName(ShaderHandle _handle, const bx::StringView& _name) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("setName", m_shaderHandle, _handle);
+
+			ShaderRef& sr = m_shaderRef[_handle.idx];
+			sr.m_name.set(_name);
+
+			setName(convert(_handle), _name);
+		}
+
+		BGFX_API_FUNC(void destroyShader(ShaderHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyShader", m_shaderHandle, _handle);
+
+			if (!isValid(_handle) )
+			{
+				BX_WARN(false, "Passing invalid shader handle to bgfx::destroyShader.");
+				return;
+			}
+
+			shaderDecRef(_handle);
+		}
+
+		void shaderTakeOwnership(ShaderHandle _handle)
+		{
+			shaderDecRef(_handle);
+		}
+
+		void shaderIncRef(ShaderHandle _handle)
+		{
+			ShaderRef& sr = m_shaderRef[_handle.idx];
+			++sr.m_refCount;
+		}
+
+		void shaderDecRef(ShaderHandle _handle)
+		{
+			ShaderRef& sr = m_shaderRef[_handle.idx];
+			int32_t refs = --sr.m_refCount;
+			if (0 == refs)
+			{
+				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
+				BX_ASSERT(ok, "Shader handle %d is already destroyed!", _handle.idx);
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyShader);
+				cmdbuf.write(_handle);
+
+				if (0 != sr.m_num)
+				{
+					for (uint32_t ii = 0, num = sr.m_num; ii < num; ++ii)
+					{
+						destroyUniform(sr.m_uniforms[ii]);
+					}
+
+					BX_FREE(g_allocator, sr.m_uniforms);
+					sr.m_uniforms = NULL;
+					sr.m_num = 0;
+				}
+
+				m_shaderHashMap.removeByHandle(_handle.idx);
+			}
+		}
+
+		BGFX_API_FUNC(ProgramHandle createProgram(ShaderHandle _vsh, ShaderHandle _fsh, bool _destroyShaders) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			if (!isValid(_vsh)
+			||  !isValid(_fsh) )
+			{
+				BX_TRACE("Vertex/fragment shader is invalid (vsh %d, fsh %d).", _vsh.idx, _fsh.idx);
+				return BGFX_INVALID_HANDLE;
+			}
+
+			ProgramHandle handle = { m_programHashMap.find(uint32_t(_fsh.idx<<16)|_vsh.idx) };
+			if (isValid(handle) )
+			{
+				ProgramRef& pr = m_programRef[handle.idx];
+				++pr.m_refCount;
+				shaderIncRef(pr.m_vsh);
+				shaderIncRef(pr.m_fsh);
+			}
+			else
+			{
+				const ShaderRef& vsr = m_shaderRef[_vsh.idx];
+				const ShaderRef& fsr = m_shaderRef[_fsh.idx];
+				if (vsr.m_hashOut != fsr.m_hashIn)
+				{
+					BX_TRACE("Vertex shader output doesn't match fragment shader input.");
+					return BGFX_INVALID_HANDLE;
+				}
+
+				handle.idx = m_programHandle.alloc();
+
+				BX_WARN(isValid(handle), "Failed to allocate program handle.");
+				if (isValid(handle) )
+				{
+					shaderIncRef(_vsh);
+					shaderIncRef(_fsh);
+					ProgramRef& pr = m_programRef[handle.idx];
+					pr.m_vsh = _vsh;
+					pr.m_fsh = _fsh;
+					pr.m_refCount = 1;
+
+					const uint32_t key = uint32_t(_fsh.idx<<16)|_vsh.idx;
+					bool ok = m_programHashMap.insert(key, handle.idx);
+					BX_ASSERT(ok, "Program already exists (key: %x, handle: %3d)!", key, handle.idx); BX_UNUSED(ok);
+
+					CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateProgram);
+					cmdbuf.write(handle);
+					cmdbuf.write(_vsh);
+					cmdbuf.write(_fsh);
+				}
+			}
+
+			if (_destroyShaders)
+			{
+				shaderTakeOwnership(_vsh);
+				shaderTakeOwnership(_fsh);
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(ProgramHandle createProgram(ShaderHandle _vsh, bool _destroyShader) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			if (!isValid(_vsh) )
+			{
+				BX_WARN(false, "Compute shader is invalid (vsh %d).", _vsh.idx);
+				return BGFX_INVALID_HANDLE;
+			}
+
+			ProgramHandle handle = { m_programHashMap.find(_vsh.idx) };
+
+			if (isValid(handle) )
+			{
+				ProgramRef& pr = m_programRef[handle.idx];
+				++pr.m_refCount;
+				shaderIncRef(pr.m_vsh);
+			}
+			else
+			{
+				handle.idx = m_programHandle.alloc();
+
+				BX_WARN(isValid(handle), "Failed to allocate program handle.");
+				if (isValid(handle) )
+				{
+					shaderIncRef(_vsh);
+					ProgramRef& pr = m_programRef[handle.idx];
+					pr.m_vsh = _vsh;
+					ShaderHandle fsh = BGFX_INVALID_HANDLE;
+					pr.m_fsh = fsh;
+					pr.m_refCount = 1;
+
+					const uint32_t key = uint32_t(_vsh.idx);
+					bool ok = m_programHashMap.insert(key, handle.idx);
+					BX_ASSERT(ok, "Program already exists (key: %x, handle: %3d)!", key, handle.idx); BX_UNUSED(ok);
+
+					CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateProgram);
+					cmdbuf.write(handle);
+					cmdbuf.write(_vsh);
+					cmdbuf.write(fsh);
+				}
+			}
+
+			if (_destroyShader)
 			{
-				uint32_t size = sr.m_num*sizeof(UniformHandle);
-				sr.m_uniforms = (UniformHandle*)BX_ALLOC(g_allocator, size);
-				bx::memCopy(sr.m_uniforms, uniforms, size);
+				shaderTakeOwnership(_vsh);
 			}
 
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateShader);
-			cmdbuf.write(handle);
-			cmdbuf.write(_mem);
-
-			setDebugName(convert(handle) );
-
 			return handle;
 		}
 
-		BGFX_API_FUNC(uint16_t getShaderUniforms(ShaderHandle _handle, UniformHandle* _uniforms, uint16_t _max) )
+		BGFX_API_FUNC(void destroyProgram(ProgramHandle _handle) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
-			if (!isValid(_handle) )
+			BGFX_CHECK_HANDLE("destroyProgram", m_programHandle, _handle);
+
+			ProgramRef& pr = m_programRef[_handle.idx];
+			shaderDecRef(pr.m_vsh);
+
+			if (isValid(pr.m_fsh) )
 			{
-				BX_WARN(false, "Passing invalid shader handle to bgfx::getShaderUniforms.");
-				return 0;
+				shaderDecRef(pr.m_fsh);
 			}
 
-			ShaderRef& sr = m_shaderRef[_handle.idx];
-			if (NULL != _uniforms)
+			int32_t refs = --pr.m_refCount;
+			if (0 == refs)
 			{
-				bx::memCopy(_uniforms, sr.m_uniforms, bx::min<uint16_t>(_max, sr.m_num)*sizeof(UniformHandle) );
-			}
+				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
+				BX_ASSERT(ok, "Program handle %d is already destroyed!", _handle.idx);
 
-			return sr.m_num;
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyProgram);
+				cmdbuf.write(_handle);
+
+				m_programHashMap.removeByHandle(_handle.idx);
+			}
 		}
 
-		void setName(Handle _handle, const bx::StringView& _name)
+		BGFX_API_FUNC(void prewarmPipeline(ProgramHandle _program, uint64_t _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer) )
 		{
-			char tmp[1024];
-			uint16_t len = 1+(uint16_t)bx::snprintf(tmp, BX_COUNTOF(tmp), "%sH %d: %.*s", getTypeName(_handle), _handle.idx, _name.getLength(), _name.getPtr() );
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::SetName);
-			cmdbuf.write(_handle);
-			cmdbuf.write(len);
-			cmdbuf.write(tmp, len);
-		}
+			BGFX_CHECK_HANDLE("prewarmPipeline", m_programHandle, _program);
+			BGFX_CHECK_HANDLE("prewarmPipeline", m_layoutHandle, _layoutHandle);
+			BGFX_CHECK_HANDLE_INVALID_OK("prewarmPipeline", m_frameBufferHandle, _frameBuffer);
 
-		void setDebugName(Handle _handle, const bx::StringView& _name = "")
-		{
-			if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
-			{
-				setName(_handle, _name);
-			}
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::PrewarmPipeline);
+			cmdbuf.write(_program);
+			cmdbuf.write(_state);
+			cmdbuf.write(_layoutHandle);
+			cmdbuf.write(_frameBuffer);
 		}
 
-		BGFX_API_FUNC(void setName(ShaderHandle _handle, const bx::StringView& _name) )
+		BGFX_API_FUNC(void flushPipelineCache() )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
-			BGFX_CHECK_HANDLE("setName", m_shaderHandle, _handle);
+			getCommandBuffer(CommandBuffer::FlushPipelineCache);
+		}
 
-			ShaderRef& sr = m_shaderRef[_handle.idx];
-			sr.m_name.set(_name);
+		BGFX_API_FUNC(void defragment() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
-			setName(convert(_handle), _name);
+			// Post command, executed after this frame's destroy commands. Memory of resources
+			// still used by GPU is returned to allocator later, and released by next defragment.
+			getCommandBuffer(CommandBuffer::Defragment);
 		}
 
-		BGFX_API_FUNC(void destroyShader(ShaderHandle _handle) )
+		BGFX_API_FUNC(TextureHandle createTexture(const Memory* _mem, uint64_t _flags, uint8_t _skip, TextureInfo* _info, BackbufferRatio::Enum _ratio, bool _immutable) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
-			BGFX_CHECK_HANDLE("destroyShader", m_shaderHandle, _handle);
+			TextureInfo ti;
+			if (NULL == _info)
+			{
+				_info = &ti;
+			}
 
-			if (!isValid(_handle) )
+			const Memory* mipTail = NULL;
+			if (0 != (_flags & BGFX_TEXTURE_STREAMING) )
 			{
-				BX_WARN(false, "Passing invalid shader handle to bgfx::destroyShader.");
-				return;
+				mipTail = detachMipTail(_mem, _flags);
 			}
 
-			shaderDecRef(_handle);
-		}
+			bimg::ImageContainer imageContainer;
+			if (bimg::imageParse(imageContainer, _mem->data, _mem->size) )
+			{
+				calcTextureSize(*_info
+					, (uint16_t)imageContainer.m_width
+					, (uint16_t)imageContainer.m_height
+					, (uint16_t)imageContainer.m_depth
+					, imageContainer.m_cubeMap
+					, imageContainer.m_numMips > 1
+					, imageContainer.m_numLayers
+					, TextureFormat::Enum(imageContainer.m_format)
+					);
+			}
+			else
+			{
+				_info->format = TextureFormat::Unknown;
+				_info->storageSize = 0;
+				_info->width   = 0;
+				_info->height  = 0;
+				_info->depth   = 0;
+				_info->numMips = 0;
+				_info->bitsPerPixel = 0;
+				_info->cubeMap = false;
 
-		void shaderTakeOwnership(ShaderHandle _handle)
-		{
-			shaderDecRef(_handle);
-		}
+				if (NULL != mipTail)
+				{
+					release(mipTail);
+				}
 
-		void shaderIncRef(ShaderHandle _handle)
-		{
-			ShaderRef& sr = m_shaderRef[_handle.idx];
-			++sr.m_refCount;
-		}
+				return BGFX_INVALID_HANDLE;
+			}
 
-		void shaderDecRef(ShaderHandle _handle)
-		{
-			ShaderRef& sr = m_shaderRef[_handle.idx];
-			int32_t refs = --sr.m_refCount;
-			if (0 == refs)
-			{
-				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
-				BX_ASSERT(ok, "Shader handle %d is already destroyed!", _handle.idx);
+			_flags |= imageContainer.m_srgb ? BGFX_TEXTURE_SRGB : 0;
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyShader);
-				cmdbuf.write(_handle);
+			TextureHandle handle = { m_textureHandle.alloc() };
+			BX_WARN(isValid(handle), "Failed to allocate texture handle.");
 
-				if (0 != sr.m_num)
-				{
-					for (uint32_t ii = 0, num = sr.m_num; ii < num; ++ii)
-					{
-						destroyUniform(sr.m_uniforms[ii]);
-					}
+			if (!isValid(handle) )
+			{
+				release(_mem);
 
-					BX_FREE(g_allocator, sr.m_uniforms);
-					sr.m_uniforms = NULL;
-					sr.m_num = 0;
+				if (NULL != mipTail)
+				{
+					release(mipTail);
 				}
 
-				m_shaderHashMap.removeByHandle(_handle.idx);
+				return BGFX_INVALID_HANDLE;
 			}
-		}
 
-		BGFX_API_FUNC(ProgramHandle createProgram(ShaderHandle _vsh, ShaderHandle _fsh, bool _destroyShaders) )
-		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			TextureRef& ref = m_textureRef[handle.idx];
+			ref.init(
+				  _ratio
+				, uint16_t(imageContainer.m_width)
+				, uint16_t(imageContainer.m_height)
+				, uint16_t(imageContainer.m_depth)
+				, _info->format
+				, _info->storageSize
+				, imageContainer.m_numMips
+				, imageContainer.m_numLayers
+				, 0 != (g_caps.supported & BGFX_CAPS_TEXTURE_DIRECT_ACCESS)
+				, _immutable
+				, imageContainer.m_cubeMap
+				, _flags
+				);
 
-			if (!isValid(_vsh)
-			||  !isValid(_fsh) )
+			if (ref.isRt() )
 			{
-				BX_TRACE("Vertex/fragment shader is invalid (vsh %d, fsh %d).", _vsh.idx, _fsh.idx);
-				return BGFX_INVALID_HANDLE;
+				m_rtMemoryUsed += int64_t(ref.m_storageSize);
+			}
+			else
+			{
+				m_textureMemoryUsed += int64_t(ref.m_storageSize);
 			}
 
-			ProgramHandle handle = { m_programHashMap.find(uint32_t(_fsh.idx<<16)|_vsh.idx) };
-			if (isValid(handle) )
+			if (TextureDecoder::needsDecode(imageContainer, _mem) )
 			{
-				ProgramRef& pr = m_programRef[handle.idx];
-				++pr.m_refCount;
-				shaderIncRef(pr.m_vsh);
-				shaderIncRef(pr.m_fsh);
+				if (m_textureDecoder.isFull() )
+				{
+					writeCreateTexture(m_textureDecoder.pop() );
+				}
+
+				ref.m_decoded = true;
+
+				TextureDecoder::Job job;
+				job.m_handle = handle;
+				job.m_mem    = _mem;
+				job.m_flags  = _flags;
+				job.m_skip   = _skip;
+				TextureDecoder::getDecodedCreate(job.m_create, imageContainer, _skip);
+				m_textureDecoder.push(job);
 			}
 			else
 			{
-				const ShaderRef& vsr = m_shaderRef[_vsh.idx];
-				const ShaderRef& fsr = m_shaderRef[_fsh.idx];
-				if (vsr.m_hashOut != fsr.m_hashIn)
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
+				cmdbuf.write(handle);
+				cmdbuf.write(_mem);
+				cmdbuf.write(_flags);
+				cmdbuf.write(_skip);
+
+				setDebugName(convert(handle) );
+			}
+
+			if (ref.m_streaming)
+			{
+				streamMipTail(handle, mipTail);
+			}
+
+			return handle;
+		}
+
+		const Memory* detachMipTail(const Memory* _mem, uint64_t& _flags)
+		{
+			bx::MemoryReader reader(_mem->data, _mem->size);
+
+			uint32_t magic;
+			bx::read(&reader, magic);
+
+			TextureCreate tc;
+			bx::read(&reader, tc);
+
+			if (BGFX_CHUNK_MAGIC_TEX != magic
+			||  0 != tc.m_depth
+			||  tc.m_cubeMap
+			||  1 != tc.m_numLayers
+			||  2 > tc.m_numMips)
+			{
+				BX_WARN(false, "Streaming texture must be single layer 2D texture with mips.");
+				_flags &= ~BGFX_TEXTURE_STREAMING;
+				return NULL;
+			}
+
+			// Texture is created without data, mip tail is uploaded after it's created.
+			const Memory* mipTail = tc.m_mem;
+			tc.m_mem = NULL;
+
+			bx::StaticMemoryBlockWriter writer(_mem->data, _mem->size);
+			bx::write(&writer, magic);
+			bx::write(&writer, tc);
+
+			return mipTail;
+		}
+
+		void streamMipTail(TextureHandle _handle, const Memory* _mem)
+		{
+			TextureRef& ref = m_textureRef[_handle.idx];
+			const TextureFormat::Enum format = TextureFormat::Enum(ref.m_format);
+
+			uint8_t  mip  = ref.m_numMips;
+			uint32_t size = 0;
+
+			if (NULL != _mem)
+			{
+				for (; 0 < mip; --mip)
 				{
-					BX_TRACE("Vertex shader output doesn't match fragment shader input.");
-					return BGFX_INVALID_HANDLE;
+					const uint32_t mipSize = getTextureMipSize(format, ref.m_width, ref.m_height, mip-1);
+					if (size + mipSize > _mem->size)
+					{
+						break;
+					}
+
+					size += mipSize;
 				}
 
-				handle.idx = m_programHandle.alloc();
+				BX_WARN(size == _mem->size
+					, "Streaming texture %d mip tail size doesn't match mip sizes (mip tail size: %d, mips size: %d)."
+					, _handle.idx
+					, _mem->size
+					, size
+					);
 
-				BX_WARN(isValid(handle), "Failed to allocate program handle.");
-				if (isValid(handle) )
+				uint32_t offset = 0;
+				for (uint8_t lod = mip; lod < ref.m_numMips; ++lod)
 				{
-					shaderIncRef(_vsh);
-					shaderIncRef(_fsh);
-					ProgramRef& pr = m_programRef[handle.idx];
-					pr.m_vsh = _vsh;
-					pr.m_fsh = _fsh;
-					pr.m_refCount = 1;
+					const uint32_t mipSize = getTextureMipSize(format, ref.m_width, ref.m_height, lod);
+					writeUpdateTexture(_handle, lod, copy(&_mem->data[offset], mipSize) );
+					offset += mipSize;
 
-					const uint32_t key = uint32_t(_fsh.idx<<16)|_vsh.idx;
-					bool ok = m_programHashMap.insert(key, handle.idx);
-					BX_ASSERT(ok, "Program already exists (key: %x, handle: %3d)!", key, handle.idx); BX_UNUSED(ok);
+					ref.m_streamMips |= UINT32_C(1)<<lod;
+				}
+
+				release(_mem);
+			}
+
+			BX_WARN(mip < ref.m_numMips, "Streaming texture %d is created without mip tail.", _handle.idx);
+
+			m_textureStreamResident += size;
+
+			ref.m_residentMip = bx::min<uint8_t>(mip, ref.m_numMips-1);
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::SetTextureMinLod);
+			cmdbuf.write(_handle);
+			cmdbuf.write(ref.m_residentMip);
+		}
+
+		void writeUpdateTexture(TextureHandle _handle, uint8_t _mip, const Memory* _mem)
+		{
+			const TextureRef& ref = m_textureRef[_handle.idx];
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateTexture);
+			cmdbuf.write(_handle);
+			cmdbuf.write(uint8_t(0) );
+			cmdbuf.write(_mip);
+			Rect rect;
+			rect.m_x = 0;
+			rect.m_y = 0;
+			rect.m_width  = bx::max<uint16_t>(1, ref.m_width  >> _mip);
+			rect.m_height = bx::max<uint16_t>(1, ref.m_height >> _mip);
+			cmdbuf.write(rect);
+			cmdbuf.write(uint16_t(0) );
+			cmdbuf.write(uint16_t(1) );
+			cmdbuf.write(uint16_t(UINT16_MAX) );
+			cmdbuf.write(_mem);
+		}
 
-					CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateProgram);
-					cmdbuf.write(handle);
-					cmdbuf.write(_vsh);
-					cmdbuf.write(_fsh);
-				}
+		void streamTextureMip(TextureHandle _handle, uint8_t _mip, const Memory* _mem)
+		{
+			if (BGFX_CONFIG_MAX_TEXTURE_STREAM_UPLOADS == m_numTextureStreamUploads)
+			{
+				BX_WARN(false, "Too many streaming texture uploads pending, uploading over budget.");
+				flushTextureStream(UINT32_MAX);
 			}
 
-			if (_destroyShaders)
+			// Upload might wait for budget longer than two frames, which is how long memory
+			// obtained with `makeRef` is required to stay valid.
+			if (isMemoryRef(_mem) )
 			{
-				shaderTakeOwnership(_vsh);
-				shaderTakeOwnership(_fsh);
+				const Memory* mem = copy(_mem->data, _mem->size);
+				release(_mem);
+				_mem = mem;
 			}
 
-			return handle;
+			TextureStreamUpload& upload = m_textureStreamUpload[m_numTextureStreamUploads++];
+			upload.m_handle = _handle;
+			upload.m_mip    = _mip;
+			upload.m_seq    = m_textureStreamSeq++;
+			upload.m_mem    = _mem;
+
+			m_textureStreamPending += _mem->size;
 		}
 
-		BGFX_API_FUNC(ProgramHandle createProgram(ShaderHandle _vsh, bool _destroyShader) )
+		static int32_t compareTextureStreamUpload(const void* _lhs, const void* _rhs)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			const TextureStreamUpload& lhs = *(const TextureStreamUpload*)_lhs;
+			const TextureStreamUpload& rhs = *(const TextureStreamUpload*)_rhs;
 
-			if (!isValid(_vsh) )
+			// Smaller mips first, they are cheaper and make larger share of texture visible.
+			if (lhs.m_mip != rhs.m_mip)
 			{
-				BX_WARN(false, "Compute shader is invalid (vsh %d).", _vsh.idx);
-				return BGFX_INVALID_HANDLE;
+				return lhs.m_mip > rhs.m_mip ? -1 : 1;
 			}
 
-			ProgramHandle handle = { m_programHashMap.find(_vsh.idx) };
+			return lhs.m_seq < rhs.m_seq ? -1 : 1;
+		}
 
-			if (isValid(handle) )
+		void flushTextureStream(uint32_t _budget)
+		{
+			if (0 == m_numTextureStreamUploads)
 			{
-				ProgramRef& pr = m_programRef[handle.idx];
-				++pr.m_refCount;
-				shaderIncRef(pr.m_vsh);
+				return;
 			}
-			else
+
+			bx::quickSort(
+				  m_textureStreamUpload
+				, m_numTextureStreamUploads
+				, sizeof(TextureStreamUpload)
+				, compareTextureStreamUpload
+				);
+
+			uint32_t uploaded = 0;
+			uint32_t num      = 0;
+
+			for (; num < m_numTextureStreamUploads; ++num)
 			{
-				handle.idx = m_programHandle.alloc();
+				const TextureStreamUpload& upload = m_textureStreamUpload[num];
+				const uint32_t size = upload.m_mem->size;
 
-				BX_WARN(isValid(handle), "Failed to allocate program handle.");
-				if (isValid(handle) )
+				// Always make some progress, even when single mip is larger than budget.
+				if (0 < num
+				&&  uploaded + size > _budget)
 				{
-					shaderIncRef(_vsh);
-					ProgramRef& pr = m_programRef[handle.idx];
-					pr.m_vsh = _vsh;
-					ShaderHandle fsh = BGFX_INVALID_HANDLE;
-					pr.m_fsh = fsh;
-					pr.m_refCount = 1;
+					break;
+				}
 
-					const uint32_t key = uint32_t(_vsh.idx);
-					bool ok = m_programHashMap.insert(key, handle.idx);
-					BX_ASSERT(ok, "Program already exists (key: %x, handle: %3d)!", key, handle.idx); BX_UNUSED(ok);
+				uploaded += size;
 
-					CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateProgram);
-					cmdbuf.write(handle);
-					cmdbuf.write(_vsh);
-					cmdbuf.write(fsh);
+				TextureRef& ref = m_textureRef[upload.m_handle.idx];
+				writeUpdateTexture(upload.m_handle, upload.m_mip, upload.m_mem);
+
+				const uint32_t mipBit = UINT32_C(1)<<upload.m_mip;
+				if (0 == (ref.m_streamMips & mipBit) )
+				{
+					ref.m_streamMips |= mipBit;
+					m_textureStreamResident += getTextureMipSize(TextureFormat::Enum(ref.m_format), ref.m_width, ref.m_height, upload.m_mip);
 				}
-			}
 
-			if (_destroyShader)
-			{
-				shaderTakeOwnership(_vsh);
+				uint8_t residentMip = ref.m_residentMip;
+				while (0 < residentMip
+				&&     0 != (ref.m_streamMips & (UINT32_C(1)<<(residentMip-1) ) ) )
+				{
+					--residentMip;
+				}
+
+				if (residentMip != ref.m_residentMip)
+				{
+					ref.m_residentMip = residentMip;
+
+					CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::SetTextureMinLod);
+					cmdbuf.write(upload.m_handle);
+					cmdbuf.write(residentMip);
+				}
 			}
 
-			return handle;
+			m_textureStreamPending -= uploaded;
+			m_numTextureStreamUploads -= num;
+
+			bx::memMove(
+				  &m_textureStreamUpload[0]
+				, &m_textureStreamUpload[num]
+				, m_numTextureStreamUploads*sizeof(TextureStreamUpload)
+				);
 		}
 
-		BGFX_API_FUNC(void destroyProgram(ProgramHandle _handle) )
+		void discardTextureStream(TextureHandle _handle)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			TextureRef& ref = m_textureRef[_handle.idx];
 
-			BGFX_CHECK_HANDLE("destroyProgram", m_programHandle, _handle);
+			for (uint8_t lod = 0; lod < ref.m_numMips; ++lod)
+			{
+				if (0 != (ref.m_streamMips & (UINT32_C(1)<<lod) ) )
+				{
+					m_textureStreamResident -= getTextureMipSize(TextureFormat::Enum(ref.m_format), ref.m_width, ref.m_height, lod);
+				}
+			}
 
-			ProgramRef& pr = m_programRef[_handle.idx];
-			shaderDecRef(pr.m_vsh);
+			ref.m_streamMips = 0;
 
-			if (isValid(pr.m_fsh) )
+			uint32_t num = 0;
+			for (uint32_t ii = 0; ii < m_numTextureStreamUploads; ++ii)
 			{
-				shaderDecRef(pr.m_fsh);
+				const TextureStreamUpload& upload = m_textureStreamUpload[ii];
+
+				if (upload.m_handle.idx == _handle.idx)
+				{
+					m_textureStreamPending -= upload.m_mem->size;
+					release(upload.m_mem);
+				}
+				else
+				{
+					m_textureStreamUpload[num++] = upload;
+				}
 			}
 
-			int32_t refs = --pr.m_refCount;
-			if (0 == refs)
+			m_numTextureStreamUploads = num;
+		}
+
+		void writeCreateTexture(const TextureDecoder::Job& _job)
+		{
+			if (_job.m_created)
 			{
-				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
-				BX_ASSERT(ok, "Program handle %d is already destroyed!", _handle.idx);
+				writeUpdateDecodedTexture(_job);
+			}
+			else
+			{
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
+				cmdbuf.write(_job.m_handle);
+				cmdbuf.write(_job.m_mem);
+				cmdbuf.write(_job.m_flags);
+				cmdbuf.write(_job.m_skip);
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyProgram);
-				cmdbuf.write(_handle);
+				setDebugName(convert(_job.m_handle) );
+			}
 
-				m_programHashMap.removeByHandle(_handle.idx);
+			if (NULL != _job.m_src)
+			{
+				release(_job.m_src);
 			}
 		}
 
-		BGFX_API_FUNC(TextureHandle createTexture(const Memory* _mem, uint64_t _flags, uint8_t _skip, TextureInfo* _info, BackbufferRatio::Enum _ratio, bool _immutable) )
+		// Creates texture of job that is still decoding, without data.
+		void writeCreateDecodingTexture(const TextureDecoder::Job& _job)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+			const Memory* mem = alloc(sizeof(uint32_t) + sizeof(TextureCreate) );
 
-			TextureInfo ti;
-			if (NULL == _info)
-			{
-				_info = &ti;
-			}
+			bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+			uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
+			bx::write(&writer, magic);
+			bx::write(&writer, _job.m_create);
 
-			bimg::ImageContainer imageContainer;
-			if (bimg::imageParse(imageContainer, _mem->data, _mem->size) )
+			const uint8_t skip = 0;
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
+			cmdbuf.write(_job.m_handle);
+			cmdbuf.write(mem);
+			cmdbuf.write(_job.m_flags);
+			cmdbuf.write(skip);
+
+			setDebugName(convert(_job.m_handle) );
+		}
+
+		// Uploads decoded data into texture created while job was still decoding.
+		void writeUpdateDecodedTexture(const TextureDecoder::Job& _job)
+		{
+			const Memory* mem = _job.m_mem;
+
+			bx::MemoryReader reader(mem->data, mem->size);
+
+			uint32_t magic;
+			bx::read(&reader, magic);
+
+			TextureCreate tc;
+			tc.m_mem = NULL;
+
+			if (BGFX_CHUNK_MAGIC_TEX == magic)
 			{
-				calcTextureSize(*_info
-					, (uint16_t)imageContainer.m_width
-					, (uint16_t)imageContainer.m_height
-					, (uint16_t)imageContainer.m_depth
-					, imageContainer.m_cubeMap
-					, imageContainer.m_numMips > 1
-					, imageContainer.m_numLayers
-					, TextureFormat::Enum(imageContainer.m_format)
-					);
+				bx::read(&reader, tc);
 			}
-			else
+
+			// Source memory is moved out of job only when decode succeeded.
+			if (!_job.m_canceled
+			&&  NULL != _job.m_src)
 			{
-				_info->format = TextureFormat::Unknown;
-				_info->storageSize = 0;
-				_info->width   = 0;
-				_info->height  = 0;
-				_info->depth   = 0;
-				_info->numMips = 0;
-				_info->bitsPerPixel = 0;
-				_info->cubeMap = false;
+				const uint16_t numFaces = tc.m_cubeMap ? 6 : 1;
+				const uint16_t numSides = tc.m_numLayers * numFaces;
+				const uint8_t* data = tc.m_mem->data;
 
-				return BGFX_INVALID_HANDLE;
+				for (uint16_t side = 0; side < numSides; ++side)
+				{
+					for (uint8_t lod = 0; lod < tc.m_numMips; ++lod)
+					{
+						const uint16_t width  = bx::max<uint16_t>(1, tc.m_width  >> lod);
+						const uint16_t height = bx::max<uint16_t>(1, tc.m_height >> lod);
+						const uint16_t depth  = bx::max<uint16_t>(1, tc.m_depth  >> lod);
+						const uint32_t size   = width*height*depth*4;
+
+						const uint8_t  face  = uint8_t(side % numFaces);
+						const uint16_t layer = side / numFaces;
+						const uint16_t pitch = UINT16_MAX;
+
+						Rect rect;
+						rect.m_x      = 0;
+						rect.m_y      = 0;
+						rect.m_width  = width;
+						rect.m_height = height;
+
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateTexture);
+						cmdbuf.write(_job.m_handle);
+						cmdbuf.write(face);
+						cmdbuf.write(lod);
+						cmdbuf.write(rect);
+						cmdbuf.write(layer);
+						cmdbuf.write(depth);
+						cmdbuf.write(pitch);
+						cmdbuf.write(copy(data, size) );
+
+						data += size;
+					}
+				}
 			}
 
-			_flags |= imageContainer.m_srgb ? BGFX_TEXTURE_SRGB : 0;
+			if (NULL != tc.m_mem)
+			{
+				release(tc.m_mem);
+			}
 
-			TextureHandle handle = { m_textureHandle.alloc() };
-			BX_WARN(isValid(handle), "Failed to allocate texture handle.");
+			release(mem);
+		}
 
-			if (!isValid(handle) )
+		// Waits for all queued decode jobs.
+		void flushTextureDecode()
+		{
+			while (!m_textureDecoder.isEmpty() )
 			{
-				release(_mem);
-				return BGFX_INVALID_HANDLE;
+				writeCreateTexture(m_textureDecoder.pop() );
 			}
+		}
 
-			TextureRef& ref = m_textureRef[handle.idx];
-			ref.init(
-				  _ratio
-				, uint16_t(imageContainer.m_width)
-				, uint16_t(imageContainer.m_height)
-				, uint16_t(imageContainer.m_depth)
-				, _info->format
-				, _info->storageSize
-				, imageContainer.m_numMips
-				, imageContainer.m_numLayers
-				, 0 != (g_caps.supported & BGFX_CAPS_TEXTURE_DIRECT_ACCESS)
-				, _immutable
-				, imageContainer.m_cubeMap
-				, _flags
-				);
+		// Retires finished decode jobs without waiting, and creates textures of jobs still
+		// decoding so that they can be used this frame. Their data is uploaded in later frame.
+		void retireTextureDecode()
+		{
+			TextureDecoder::Job job;
 
-			if (ref.isRt() )
+			while (m_textureDecoder.tryPop(job) )
 			{
-				m_rtMemoryUsed += int64_t(ref.m_storageSize);
+				writeCreateTexture(job);
 			}
-			else
+
+			while (m_textureDecoder.markCreated(job) )
 			{
-				m_textureMemoryUsed += int64_t(ref.m_storageSize);
+				writeCreateDecodingTexture(job);
 			}
-
-			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
-			cmdbuf.write(handle);
-			cmdbuf.write(_mem);
-			cmdbuf.write(_flags);
-			cmdbuf.write(_skip);
-
-			setDebugName(convert(handle) );
-
-			return handle;
 		}
 
 		BGFX_API_FUNC(void setName(TextureHandle _handle, const bx::StringView& _name) )
@@ -4402,6 +6101,8 @@ namespace bgfx
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 			BGFX_CHECK_HANDLE("setName", m_textureHandle, _handle);
 
+			flushTextureDecode();
+
 			TextureRef& ref = m_textureRef[_handle.idx];
 			ref.m_name.set(_name);
 
@@ -4453,7 +6154,7 @@ namespace bgfx
 			cmdbuf.write(_handle);
 			cmdbuf.write(_data);
 			cmdbuf.write(_mip);
-			return m_frames + 2;
+			return m_frames + 2 + m_renderCtx->getReadTextureLatency();
 		}
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers)
@@ -4512,6 +6213,16 @@ namespace bgfx
 					m_textureMemoryUsed -= int64_t(ref.m_storageSize);
 				}
 
+				if (ref.m_streaming)
+				{
+					discardTextureStream(_handle);
+				}
+
+				if (ref.m_decoded)
+				{
+					m_textureDecoder.cancel(_handle);
+				}
+
 				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 				BX_ASSERT(ok, "Texture handle %d is already destroyed!", _handle.idx);
 
@@ -4544,6 +6255,26 @@ namespace bgfx
 				return;
 			}
 
+			flushTextureDecode();
+
+			if (ref.m_decoded)
+			{
+				_mem = decodeTextureUpdate(TextureFormat::Enum(ref.m_format), _width, _height, _depth, _pitch, _mem);
+			}
+
+			if (ref.m_streaming
+			&&  0 == _side
+			&&  0 == _x
+			&&  0 == _y
+			&&  bx::max<uint16_t>(1, ref.m_width  >> _mip) == _width
+			&&  bx::max<uint16_t>(1, ref.m_height >> _mip) == _height
+			&&  UINT16_MAX == _pitch)
+			{
+				// Whole mip of streaming texture is uploaded within per frame budget.
+				streamTextureMip(_handle, _mip, _mem);
+				return;
+			}
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateTexture);
 			cmdbuf.write(_handle);
 			cmdbuf.write(_side);
@@ -4573,6 +6304,8 @@ namespace bgfx
 				return BGFX_INVALID_HANDLE;
 			}
 
+			flushTextureDecode();
+
 			FrameBufferHandle handle = { m_frameBufferHandle.alloc() };
 			BX_WARN(isValid(handle), "Failed to allocate frame buffer handle.");
 
@@ -4810,6 +6543,56 @@ namespace bgfx
 			}
 		}
 
+		BGFX_API_FUNC(UniformBlockHandle createUniformBlock() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			UniformBlockHandle handle = { m_uniformBlockHandle.alloc() };
+			BX_WARN(isValid(handle), "Failed to allocate uniform block handle.");
+
+			if (isValid(handle) )
+			{
+				m_uniformBlock[handle.idx].reset();
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void updateUniformBlock(UniformBlockHandle _handle, UniformHandle _uniform, const void* _value, uint16_t _num) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("updateUniformBlock", m_uniformBlockHandle, _handle);
+			BGFX_CHECK_HANDLE("updateUniformBlock", m_uniformHandle, _uniform);
+
+			const UniformRef& uniform = m_uniformRef[_uniform.idx];
+			BX_ASSERT(_num == UINT16_MAX || uniform.m_num >= _num, "Truncated uniform update. %d (max: %d)", _num, uniform.m_num);
+
+			UniformBlock& block = m_uniformBlock[_handle.idx];
+			block.set(uniform.m_type, _uniform.idx, _value, UINT16_MAX != _num ? _num : uniform.m_num);
+
+			if (!block.m_dirty)
+			{
+				block.m_dirty = true;
+				m_dirtyUniformBlock[m_numDirtyUniformBlocks++] = _handle;
+			}
+		}
+
+		BGFX_API_FUNC(void destroyUniformBlock(UniformBlockHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyUniformBlock", m_uniformBlockHandle, _handle);
+
+			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
+			BX_ASSERT(ok, "Uniform block handle %d is already destroyed!", _handle.idx);
+
+			m_uniformBlock[_handle.idx].destroy();
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyUniformBlock);
+			cmdbuf.write(_handle);
+		}
+
 		BGFX_API_FUNC(OcclusionQueryHandle createOcclusionQuery() )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4856,6 +6639,33 @@ namespace bgfx
 			m_freeOcclusionQueryHandle[m_numFreeOcclusionQueryHandles++] = _handle;
 		}
 
+		BGFX_API_FUNC(BundleHandle createBundle() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BundleHandle handle = { m_bundleHandle.alloc() };
+			BX_WARN(isValid(handle), "Failed to allocate bundle handle.");
+
+			if (isValid(handle) )
+			{
+				m_bundle[handle.idx].reset();
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void destroyBundle(BundleHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyBundle", m_bundleHandle, _handle);
+
+			// Encoders might still submit or record this bundle, it's released at the end of frame.
+			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
+			BX_ASSERT(ok, "Bundle handle %d is already destroyed!", _handle.idx);
+		}
+
+
 		BGFX_API_FUNC(void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4990,14 +6800,19 @@ namespace bgfx
 
 		BGFX_API_FUNC(uint32_t frame(bool _capture = false) );
 
-		uint32_t getSeqIncr(ViewId _id)
+		uint32_t getSeqIncr(ViewId _id, uint32_t _num = 1)
 		{
-			return bx::atomicFetchAndAdd<uint32_t>(&m_seq[_id], 1);
+			return bx::atomicFetchAndAdd<uint32_t>(&m_seq[_id], _num);
 		}
 
 		void dumpViewStats();
+		void updateRenderItemCapacity(uint32_t _demand);
+		void updateMatrixCacheCapacity(uint32_t _demand);
+		void updateTransientBufferCapacity(uint32_t _vbDemand, uint32_t _ibDemand);
+		void resizeTempItems(uint32_t _num);
 		void freeDynamicBuffers();
 		void freeAllHandles(Frame* _frame);
+		void updateUniformBlocks();
 		void frameNoRenderWait();
 		void swap();
 
@@ -5123,8 +6938,30 @@ namespace bgfx
 		Frame* m_render;
 		Frame* m_submit;
 
-		uint64_t m_tempKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
-		RenderItemCount m_tempValues[BGFX_CONFIG_MAX_DRAW_CALLS];
+		uint64_t*        m_tempKeys;
+		RenderItemCount* m_tempValues;
+		uint32_t         m_maxTempItems;
+		uint32_t         m_renderItemCapacity;
+		uint32_t         m_renderItemPeak;
+		uint32_t         m_renderItemLowFrames;
+		uint32_t         m_matrixCacheCapacity;
+
+		JobPool m_jobPool;
+		TextureDecoder m_textureDecoder;
+
+		struct TextureStreamUpload
+		{
+			TextureHandle m_handle;
+			uint8_t       m_mip;
+			uint32_t      m_seq;
+			const Memory* m_mem;
+		};
+
+		TextureStreamUpload m_textureStreamUpload[BGFX_CONFIG_MAX_TEXTURE_STREAM_UPLOADS];
+		uint32_t m_numTextureStreamUploads;
+		uint32_t m_textureStreamSeq;
+		int64_t  m_textureStreamResident;
+		int64_t  m_textureStreamPending;
 
 		IndexBuffer  m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
 		VertexBuffer m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
@@ -5154,6 +6991,8 @@ namespace bgfx
 		bx::HandleAllocT<BGFX_CONFIG_MAX_FRAME_BUFFERS> m_frameBufferHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_UNIFORMS> m_uniformHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_OCCLUSION_QUERIES> m_occlusionQueryHandle;
+		bx::HandleAllocT<BGFX_CONFIG_MAX_BUNDLES> m_bundleHandle;
+		bx::HandleAllocT<BGFX_CONFIG_MAX_UNIFORM_BLOCKS> m_uniformBlockHandle;
 
 		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_UNIFORMS*2> UniformHashMap;
 		UniformHashMap m_uniformHashMap;
@@ -5170,6 +7009,16 @@ namespace bgfx
 		TextureRef      m_textureRef[BGFX_CONFIG_MAX_TEXTURES];
 		FrameBufferRef  m_frameBufferRef[BGFX_CONFIG_MAX_FRAME_BUFFERS];
 		VertexLayoutRef m_vertexLayoutRef;
+		Bundle          m_bundle[BGFX_CONFIG_MAX_BUNDLES];
+
+		UniformBlock       m_uniformBlock[BGFX_CONFIG_MAX_UNIFORM_BLOCKS];
+		UniformBlockHandle m_dirtyUniformBlock[BGFX_CONFIG_MAX_UNIFORM_BLOCKS];
+		uint16_t           m_numDirtyUniformBlocks;
+
+		// Render thread uniform block state.
+		RenderUniformBlock m_renderUniformBlock[BGFX_CONFIG_MAX_UNIFORM_BLOCKS];
+		UniformBlockHandle m_uniformBlockLast;
+		bool               m_uniformBlockApplied;
 
 		ViewId m_viewRemap[BGFX_CONFIG_MAX_VIEWS];
 		uint32_t m_seq[BGFX_CONFIG_MAX_VIEWS];
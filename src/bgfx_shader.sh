@@ -640,6 +640,47 @@ mat3 mtxFromCols(vec3 _0, vec3 _1, vec3 _2)
 #define mtxFromCols4(_0, _1, _2, _3) transpose(mat4(_0, _1, _2, _3) )
 #endif // BGFX_SHADER_LANGUAGE_GLSL
 
+// Bindless textures are indexed by TextureHandle.idx. shaderc defines BGFX_SHADER_TEXTURE_BINDLESS
+// when shader uses textureBindless2D*. Only textures created with BGFX_TEXTURE_BINDLESS can be
+// sampled, and they are sampled with sampler state they were created with.
+#if BGFX_SHADER_TEXTURE_BINDLESS
+#	if !defined(BGFX_CONFIG_MAX_BINDLESS_TEXTURES)
+#		define BGFX_CONFIG_MAX_BINDLESS_TEXTURES 4096
+#	endif // !defined(BGFX_CONFIG_MAX_BINDLESS_TEXTURES)
+
+#	if BGFX_SHADER_LANGUAGE_SPIRV
+[[vk::binding(0, 1)]] uniform Texture2D    s_bindlessTexture[BGFX_CONFIG_MAX_BINDLESS_TEXTURES];
+[[vk::binding(1, 1)]] uniform SamplerState s_bindlessSampler[BGFX_CONFIG_MAX_BINDLESS_TEXTURES];
+
+vec4 textureBindless2D(uint _index, vec2 _coord)
+{
+	return s_bindlessTexture[NonUniformResourceIndex(_index)].Sample(s_bindlessSampler[NonUniformResourceIndex(_index)], _coord);
+}
+
+vec4 textureBindless2DLod(uint _index, vec2 _coord, float _level)
+{
+	return s_bindlessTexture[NonUniformResourceIndex(_index)].SampleLevel(s_bindlessSampler[NonUniformResourceIndex(_index)], _coord, _level);
+}
+#	elif BGFX_SHADER_LANGUAGE_GLSL
+// Texture handles are in storage buffer bound just after last texture sampler stage, define must
+// match BGFX_CONFIG_MAX_TEXTURE_SAMPLERS renderer is built with.
+#		if !defined(BGFX_CONFIG_MAX_TEXTURE_SAMPLERS)
+#			define BGFX_CONFIG_MAX_TEXTURE_SAMPLERS 16
+#		endif // !defined(BGFX_CONFIG_MAX_TEXTURE_SAMPLERS)
+layout(std430, binding=BGFX_CONFIG_MAX_TEXTURE_SAMPLERS) readonly buffer BgfxBindlessTexture { uvec2 s_bindlessTexture[]; };
+
+vec4 textureBindless2D(uint _index, vec2 _coord)
+{
+	return texture(sampler2D(s_bindlessTexture[_index]), _coord);
+}
+
+vec4 textureBindless2DLod(uint _index, vec2 _coord, float _level)
+{
+	return textureLod(sampler2D(s_bindlessTexture[_index]), _coord, _level);
+}
+#	endif // BGFX_SHADER_LANGUAGE_*
+#endif // BGFX_SHADER_TEXTURE_BINDLESS
+
 uniform vec4  u_viewRect;
 uniform vec4  u_viewTexel;
 uniform mat4  u_view;
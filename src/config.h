@@ -209,14 +209,36 @@
 #endif // BGFX_CONFIG_MULTITHREADED
 
 #ifndef BGFX_CONFIG_MAX_DRAW_CALLS
+// Default for `Init::limits.maxDrawCalls`, maximum number of draw and compute calls per frame.
 #	define BGFX_CONFIG_MAX_DRAW_CALLS ( (64<<10)-1)
 #endif // BGFX_CONFIG_MAX_DRAW_CALLS
 
+#ifndef BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE
+// Frame render item arrays are allocated on demand in multiples of this many items.
+#	define BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE (4<<10)
+#endif // BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE
+
+#ifndef BGFX_CONFIG_RENDER_ITEM_SHRINK_FRAMES
+// Number of consecutive frames with low render item usage before frame render item
+// arrays are shrunk.
+#	define BGFX_CONFIG_RENDER_ITEM_SHRINK_FRAMES 120
+#endif // BGFX_CONFIG_RENDER_ITEM_SHRINK_FRAMES
+
+#ifndef BGFX_CONFIG_ENCODER_RENDER_ITEM_BLOCK
+// Default for `Init::limits.renderItemBlock`. When non-zero encoders claim render items
+// from frame in blocks of this size and write them into encoder owned contiguous ranges.
+// Each range is sorted by encoder, and ranges are merged in Frame::sort. When 0 every
+// render item is claimed individually from shared frame arrays.
+#	define BGFX_CONFIG_ENCODER_RENDER_ITEM_BLOCK 0
+#endif // BGFX_CONFIG_ENCODER_RENDER_ITEM_BLOCK
+
 #ifndef BGFX_CONFIG_MAX_BLIT_ITEMS
 #	define BGFX_CONFIG_MAX_BLIT_ITEMS (1<<10)
 #endif // BGFX_CONFIG_MAX_BLIT_ITEMS
 
 #ifndef BGFX_CONFIG_MAX_MATRIX_CACHE
+// Frame matrix cache grows on demand, alongside render items, up to the larger of this
+// value and `Init::limits.maxDrawCalls+1`.
 #	define BGFX_CONFIG_MAX_MATRIX_CACHE (BGFX_CONFIG_MAX_DRAW_CALLS+1)
 #endif // BGFX_CONFIG_MAX_MATRIX_CACHE
 
@@ -229,7 +251,7 @@
 #endif // BGFX_CONFIG_SORT_KEY_NUM_BITS_DEPTH
 
 #ifndef BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ
-#	define BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ 20
+#	define BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ 32
 #endif // BGFX_CONFIG_SORT_KEY_NUM_BITS_SEQ
 
 #ifndef BGFX_CONFIG_SORT_KEY_NUM_BITS_PROGRAM
@@ -267,6 +289,12 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_MAX_VERTEX_STREAMS 4
 #endif // BGFX_CONFIG_MAX_VERTEX_STREAMS
 
+/// Maximum number of vertex array objects kept by GL renderer when vertex
+/// attribute binding is not available.
+#ifndef BGFX_CONFIG_MAX_VERTEX_ARRAY_CACHE
+#	define BGFX_CONFIG_MAX_VERTEX_ARRAY_CACHE 512
+#endif // BGFX_CONFIG_MAX_VERTEX_ARRAY_CACHE
+
 #ifndef BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS
 #	define BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS (4<<10)
 #endif // BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS
@@ -307,10 +335,31 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_MAX_UNIFORMS 512
 #endif // BGFX_CONFIG_MAX_UNIFORMS
 
+#ifndef BGFX_CONFIG_MAX_UNIFORM_BLOCKS
+#	define BGFX_CONFIG_MAX_UNIFORM_BLOCKS 1024
+#endif // BGFX_CONFIG_MAX_UNIFORM_BLOCKS
+
+/// Initial size of streaming buffer used by GL renderer to upload per draw
+/// uniform blocks. Buffer is used as ring, ranges are reused once GPU is done
+/// with frame that wrote them.
+#ifndef BGFX_CONFIG_UNIFORM_STREAM_BUFFER_SIZE
+#	define BGFX_CONFIG_UNIFORM_STREAM_BUFFER_SIZE (1<<20)
+#endif // BGFX_CONFIG_UNIFORM_STREAM_BUFFER_SIZE
+
+/// Maximum size of GL uniform streaming buffer. When frames in flight fill the
+/// whole buffer, it's doubled up to this size instead of waiting for GPU.
+#ifndef BGFX_CONFIG_MAX_UNIFORM_STREAM_BUFFER_SIZE
+#	define BGFX_CONFIG_MAX_UNIFORM_STREAM_BUFFER_SIZE (64<<20)
+#endif // BGFX_CONFIG_MAX_UNIFORM_STREAM_BUFFER_SIZE
+
 #ifndef BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 #	define BGFX_CONFIG_MAX_OCCLUSION_QUERIES 256
 #endif // BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 
+#ifndef BGFX_CONFIG_MAX_BUNDLES
+#	define BGFX_CONFIG_MAX_BUNDLES 256
+#endif // BGFX_CONFIG_MAX_BUNDLES
+
 #ifndef BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE
 #	define BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE (64<<10)
 #endif // BGFX_CONFIG_MIN_RESOURCE_COMMAND_BUFFER_SIZE
@@ -323,6 +372,16 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
 
+/// Transient buffers grow at runtime when frame demand exceeds their size,
+/// but never beyond these limits.
+#ifndef BGFX_CONFIG_MAX_TRANSIENT_VERTEX_BUFFER_SIZE
+#	define BGFX_CONFIG_MAX_TRANSIENT_VERTEX_BUFFER_SIZE (64<<20)
+#endif // BGFX_CONFIG_MAX_TRANSIENT_VERTEX_BUFFER_SIZE
+
+#ifndef BGFX_CONFIG_MAX_TRANSIENT_INDEX_BUFFER_SIZE
+#	define BGFX_CONFIG_MAX_TRANSIENT_INDEX_BUFFER_SIZE (32<<20)
+#endif // BGFX_CONFIG_MAX_TRANSIENT_INDEX_BUFFER_SIZE
+
 #ifndef BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
 #	define BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT 5
 #endif // BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
@@ -357,6 +416,86 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_DEFAULT_MAX_ENCODERS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 8 : 1)
 #endif // BGFX_CONFIG_DEFAULT_MAX_ENCODERS
 
+#ifndef BGFX_CONFIG_NUM_WORKER_THREADS
+// Default for `Init::limits.numWorkerThreads`, number of worker threads used by render
+// thread to split frame processing (sort key sorting, etc.) into parallel jobs, and by
+// API thread to decode textures in formats not supported by renderer. When 0 all work
+// is done on render and API thread, and texture decode blocks texture creation.
+#	define BGFX_CONFIG_NUM_WORKER_THREADS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 2 : 0)
+#endif // BGFX_CONFIG_NUM_WORKER_THREADS
+
+#ifndef BGFX_CONFIG_TEXTURE_STREAM_SIZE
+// Default for `Init::limits.textureStreamSize`, maximum number of bytes of streaming
+// texture mips uploaded per frame.
+#	define BGFX_CONFIG_TEXTURE_STREAM_SIZE (4<<20)
+#endif // BGFX_CONFIG_TEXTURE_STREAM_SIZE
+
+#ifndef BGFX_CONFIG_MAX_TEXTURE_STREAM_UPLOADS
+// Maximum number of streaming texture mip uploads waiting for upload budget.
+#	define BGFX_CONFIG_MAX_TEXTURE_STREAM_UPLOADS (4<<10)
+#endif // BGFX_CONFIG_MAX_TEXTURE_STREAM_UPLOADS
+
+#ifndef BGFX_CONFIG_MAX_TEXTURE_DECODE_JOBS
+// Maximum number of texture decodes in flight.
+#	define BGFX_CONFIG_MAX_TEXTURE_DECODE_JOBS 256
+#endif // BGFX_CONFIG_MAX_TEXTURE_DECODE_JOBS
+
+#ifndef BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS
+// Minimum number of render items per frame before sort is split per view and
+// distributed over worker threads.
+#	define BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS (4<<10)
+#endif // BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS
+
+#ifndef BGFX_CONFIG_NUM_PIPELINE_COMPILE_THREADS
+// Number of threads used by renderers that create pipeline state objects on first use
+// (Vulkan) to compile them in background. Draw calls using pipeline that is still being
+// compiled are skipped. When 0 pipelines are compiled on render thread when needed.
+#	define BGFX_CONFIG_NUM_PIPELINE_COMPILE_THREADS 0
+#endif // BGFX_CONFIG_NUM_PIPELINE_COMPILE_THREADS
+
+#ifndef BGFX_CONFIG_MAX_SECONDARY_COMMAND_BUFFERS
+// Maximum number of secondary command buffers per frame used by renderers that record
+// views in parallel on worker threads (Vulkan). Views that don't get secondary command
+// buffer are recorded on render thread.
+#	define BGFX_CONFIG_MAX_SECONDARY_COMMAND_BUFFERS 64
+#endif // BGFX_CONFIG_MAX_SECONDARY_COMMAND_BUFFERS
+
+#ifndef BGFX_CONFIG_SECONDARY_COMMAND_BUFFER_MIN_DRAWS
+// Minimum number of draw calls recorded into single secondary command buffer. Views with
+// less than twice as many draw calls are recorded on render thread.
+#	define BGFX_CONFIG_SECONDARY_COMMAND_BUFFER_MIN_DRAWS 512
+#endif // BGFX_CONFIG_SECONDARY_COMMAND_BUFFER_MIN_DRAWS
+
+#ifndef BGFX_CONFIG_DESCRIPTOR_SET_CACHE_MAX_AGE
+// Number of frames cached descriptor set can stay unused before it's evicted from descriptor
+// set cache (Vulkan). Must be larger than maximum number of frames in flight, since uniform
+// buffers used by descriptor sets are different for each frame in flight.
+#	define BGFX_CONFIG_DESCRIPTOR_SET_CACHE_MAX_AGE 16
+#endif // BGFX_CONFIG_DESCRIPTOR_SET_CACHE_MAX_AGE
+
+#ifndef BGFX_CONFIG_MAX_BINDLESS_TEXTURES
+// Size of global texture array shaders index with TextureHandle.idx (Vulkan, OpenGL). Must
+// match BGFX_CONFIG_MAX_BINDLESS_TEXTURES shaders are compiled with (see bgfx_shader.sh).
+#	define BGFX_CONFIG_MAX_BINDLESS_TEXTURES (4<<10)
+#endif // BGFX_CONFIG_MAX_BINDLESS_TEXTURES
+
+#ifndef BGFX_CONFIG_DEVICE_MEMORY_BLOCK_SIZE
+// Size of device memory blocks renderers that suballocate resources (Vulkan) allocate from
+// driver. Must be power of two. Resources larger than half of block get dedicated allocation.
+#	define BGFX_CONFIG_DEVICE_MEMORY_BLOCK_SIZE (64<<20)
+#endif // BGFX_CONFIG_DEVICE_MEMORY_BLOCK_SIZE
+
+#ifndef BGFX_CONFIG_STAGING_BUFFER_SIZE
+// Initial size of per frame in flight staging buffer used for buffer and texture uploads
+// (Vulkan). Staging buffer grows up to BGFX_CONFIG_MAX_STAGING_BUFFER_SIZE when frames upload
+// more, uploads that don't fit use dedicated staging buffer.
+#	define BGFX_CONFIG_STAGING_BUFFER_SIZE (4<<20)
+#endif // BGFX_CONFIG_STAGING_BUFFER_SIZE
+
+#ifndef BGFX_CONFIG_MAX_STAGING_BUFFER_SIZE
+#	define BGFX_CONFIG_MAX_STAGING_BUFFER_SIZE (64<<20)
+#endif // BGFX_CONFIG_MAX_STAGING_BUFFER_SIZE
+
 #ifndef BGFX_CONFIG_MAX_BACK_BUFFERS
 #	define BGFX_CONFIG_MAX_BACK_BUFFERS 4
 #endif // BGFX_CONFIG_MAX_BACK_BUFFERS
@@ -365,6 +504,17 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_MAX_FRAME_LATENCY 3
 #endif // BGFX_CONFIG_MAX_FRAME_LATENCY
 
+#ifndef BGFX_CONFIG_MAX_TEXTURE_READ_BACKS
+/// Maximum number of asynchronous texture read backs in flight.
+#	define BGFX_CONFIG_MAX_TEXTURE_READ_BACKS 64
+#endif // BGFX_CONFIG_MAX_TEXTURE_READ_BACKS
+
+#ifndef BGFX_CONFIG_TEXTURE_READ_BACK_LATENCY
+/// Number of frames asynchronous texture read back can stay in flight before renderer
+/// waits for it (OpenGL).
+#	define BGFX_CONFIG_TEXTURE_READ_BACK_LATENCY 2
+#endif // BGFX_CONFIG_TEXTURE_READ_BACK_LATENCY
+
 #ifndef BGFX_CONFIG_PREFER_DISCRETE_GPU
 // On laptops with integrated and discrete GPU, prefer selection of discrete GPU.
 // nVidia and AMD, on Windows only.
@@ -115,10 +115,34 @@ namespace bgfx
 	{
 	}
 
+	static uint64_t getDriverVersion(IDXGIAdapter* _adapter)
+	{
+		// CheckInterfaceSupport with IDXGIDevice returns user mode driver version of adapter.
+		LARGE_INTEGER umdVersion;
+		HRESULT hr = _adapter->CheckInterfaceSupport(IID_IDXGIDevice0, &umdVersion);
+
+		if (FAILED(hr) )
+		{
+			BX_TRACE("Failed to get driver version 0x%08x.", hr);
+			return 0;
+		}
+
+		const uint64_t version = uint64_t(umdVersion.QuadPart);
+		BX_TRACE("Driver version: %d.%d.%d.%d"
+			, uint32_t(version>>48) & 0xffff
+			, uint32_t(version>>32) & 0xffff
+			, uint32_t(version>>16) & 0xffff
+			, uint32_t(version    ) & 0xffff
+			);
+
+		return version;
+	}
+
 	Dxgi::Dxgi()
 		: m_dxgiDll(NULL)
 		, m_dxgiDebugDll(NULL)
 		, m_driverType(D3D_DRIVER_TYPE_NULL)
+		, m_driverVersion(0)
 		, m_factory(NULL)
 		, m_adapter(NULL)
 		, m_output(NULL)
@@ -312,6 +336,8 @@ namespace bgfx
 			hr = m_adapter->GetDesc(&m_adapterDesc);
 			BX_WARN(SUCCEEDED(hr), "Adapter GetDesc failed 0x%08x.", hr);
 
+			m_driverVersion = getDriverVersion(m_adapter);
+
 			m_adapter->EnumOutputs(0, &m_output);
 
 			_caps.vendorId = 0 == m_adapterDesc.VendorId
@@ -355,6 +381,8 @@ namespace bgfx
 			hr = m_adapter->GetDesc(&m_adapterDesc);
 			BX_WARN(SUCCEEDED(hr), "Adapter GetDesc failed 0x%08x.", hr);
 
+			m_driverVersion = getDriverVersion(m_adapter);
+
 			DX_CHECK(m_adapter->GetParent(IID_IDXGIFactory2, (void**)&m_factory) );
 		}
 
@@ -105,6 +105,7 @@ namespace bgfx
 
 		D3D_DRIVER_TYPE   m_driverType;
 		DXGI_ADAPTER_DESC m_adapterDesc;
+		uint64_t          m_driverVersion; //!< User mode driver version, 0 when unknown.
 		FactoryI* m_factory;
 		AdapterI* m_adapter;
 		OutputI*  m_output;
@@ -21,12 +21,19 @@ namespace bgfx { namespace gl
 #	define EGL_CONTEXT_FLAG_NO_ERROR_BIT_KHR 0x00000008
 #endif // EGL_CONTEXT_FLAG_NO_ERROR_BIT_KHR
 
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#	define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif // EGL_PLATFORM_SURFACELESS_MESA
+
+	typedef EGLDisplay (EGLAPIENTRY* PFNEGLGETPLATFORMDISPLAYBGFXPROC)(EGLenum platform, void* native_display, const EGLint* attrib_list);
+
 #if BGFX_USE_GL_DYNAMIC_LIB
 
 	typedef void (*EGLPROC)(void);
 
 	typedef EGLBoolean  (EGLAPIENTRY* PFNEGLCHOOSECONFIGPROC)(EGLDisplay dpy, const EGLint *attrib_list,	EGLConfig *configs, EGLint config_size,	EGLint *num_config);
 	typedef EGLContext  (EGLAPIENTRY* PFNEGLCREATECONTEXTPROC)(EGLDisplay dpy, EGLConfig config, EGLContext share_context, const EGLint *attrib_list);
+	typedef EGLSurface  (EGLAPIENTRY* PFNEGLCREATEPBUFFERSURFACEPROC)(EGLDisplay dpy, EGLConfig config, const EGLint *attrib_list);
 	typedef EGLSurface  (EGLAPIENTRY* PFNEGLCREATEWINDOWSURFACEPROC)(EGLDisplay dpy, EGLConfig config, EGLNativeWindowType win, const EGLint *attrib_list);
 	typedef EGLint      (EGLAPIENTRY* PFNEGLGETERRORPROC)(void);
 	typedef EGLDisplay  (EGLAPIENTRY* PFNEGLGETDISPLAYPROC)(EGLNativeDisplayType display_id);
@@ -43,6 +50,7 @@ namespace bgfx { namespace gl
 #define EGL_IMPORT                                                          \
 	EGL_IMPORT_FUNC(PFNEGLCHOOSECONFIGPROC,        eglChooseConfig);        \
 	EGL_IMPORT_FUNC(PFNEGLCREATECONTEXTPROC,       eglCreateContext);       \
+	EGL_IMPORT_FUNC(PFNEGLCREATEPBUFFERSURFACEPROC, eglCreatePbufferSurface); \
 	EGL_IMPORT_FUNC(PFNEGLCREATEWINDOWSURFACEPROC, eglCreateWindowSurface); \
 	EGL_IMPORT_FUNC(PFNEGLGETDISPLAYPROC,          eglGetDisplay);          \
 	EGL_IMPORT_FUNC(PFNEGLGETERRORPROC,            eglGetError);            \
@@ -101,6 +109,18 @@ EGL_IMPORT
 
 	static EGLint s_contextAttrs[16];
 
+	static EGLSurface createPbufferSurface(EGLDisplay _display, EGLConfig _config, uint32_t _width, uint32_t _height)
+	{
+		const EGLint attrs[] =
+		{
+			EGL_WIDTH,  EGLint(bx::max<uint32_t>(_width,  1) ),
+			EGL_HEIGHT, EGLint(bx::max<uint32_t>(_height, 1) ),
+			EGL_NONE
+		};
+
+		return eglCreatePbufferSurface(_display, _config, attrs);
+	}
+
 	struct SwapChainGL
 	{
 		SwapChainGL(EGLDisplay _display, EGLConfig _config, EGLContext _context, EGLNativeWindowType _nwh)
@@ -173,14 +193,45 @@ EGL_IMPORT
 			EGLNativeDisplayType ndt = (EGLNativeDisplayType)g_platformData.ndt;
 			EGLNativeWindowType  nwh = (EGLNativeWindowType )g_platformData.nwh;
 
+			// Without window render into pbuffer, this allows rendering on servers without
+			// display server (for example Mesa llvmpipe).
+			const bool headless = true
+				&& NULL == g_platformData.nwh
+				&& !BX_ENABLED(BX_PLATFORM_ANDROID)
+				&& !BX_ENABLED(BX_PLATFORM_RPI)
+				;
+			m_headless = headless;
+
 #	if BX_PLATFORM_WINDOWS
-			if (NULL == g_platformData.ndt)
+			if (NULL == g_platformData.ndt
+			&&  !headless)
 			{
 				ndt = GetDC( (HWND)g_platformData.nwh);
 			}
 #	endif // BX_PLATFORM_WINDOWS
 
-			m_display = eglGetDisplay(ndt);
+			m_display = EGL_NO_DISPLAY;
+
+			if (headless
+			&&  NULL == g_platformData.ndt)
+			{
+				const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+				PFNEGLGETPLATFORMDISPLAYBGFXPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYBGFXPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+				if (NULL != clientExtensions
+				&&  NULL != getPlatformDisplay
+				&&  !bx::findIdentifierMatch(clientExtensions, "EGL_MESA_platform_surfaceless").isEmpty() )
+				{
+					BX_TRACE("Headless, using EGL_MESA_platform_surfaceless display.");
+					m_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, (void*)EGL_DEFAULT_DISPLAY, NULL);
+				}
+			}
+
+			if (EGL_NO_DISPLAY == m_display)
+			{
+				m_display = eglGetDisplay(ndt);
+			}
 			BGFX_FATAL(m_display != EGL_NO_DISPLAY, Fatal::UnableToInitialize, "Failed to create display %p", m_display);
 
 			EGLint major = 0;
@@ -210,6 +261,7 @@ EGL_IMPORT
 			EGLint attrs[] =
 			{
 				EGL_RENDERABLE_TYPE, (gles >= 30) ? EGL_OPENGL_ES3_BIT_KHR : EGL_OPENGL_ES2_BIT,
+				EGL_SURFACE_TYPE,    headless ? EGL_PBUFFER_BIT : EGL_WINDOW_BIT,
 
 				EGL_BLUE_SIZE, 8,
 				EGL_GREEN_SIZE, 8,
@@ -267,8 +319,19 @@ EGL_IMPORT
 			vc_dispmanx_update_submit_sync(dispmanUpdate);
 #	endif // BX_PLATFORM_ANDROID
 
-			m_surface = eglCreateWindowSurface(m_display, m_config, nwh, NULL);
-			BGFX_FATAL(m_surface != EGL_NO_SURFACE, Fatal::UnableToInitialize, "Failed to create surface.");
+			if (headless)
+			{
+				m_surface = createPbufferSurface(m_display, m_config, _width, _height);
+
+				const bool hasEglKhrSurfaceless = !bx::findIdentifierMatch(extensions, "EGL_KHR_surfaceless_context").isEmpty();
+				BGFX_FATAL(m_surface != EGL_NO_SURFACE || hasEglKhrSurfaceless, Fatal::UnableToInitialize, "Failed to create pbuffer surface.");
+				BX_WARN(m_surface != EGL_NO_SURFACE, "Failed to create pbuffer surface, using surfaceless context. Backbuffer is not available.");
+			}
+			else
+			{
+				m_surface = eglCreateWindowSurface(m_display, m_config, nwh, NULL);
+				BGFX_FATAL(m_surface != EGL_NO_SURFACE, Fatal::UnableToInitialize, "Failed to create surface.");
+			}
 
 			const bool hasEglKhrCreateContext = !bx::findIdentifierMatch(extensions, "EGL_KHR_create_context").isEmpty();
 			const bool hasEglKhrNoError       = !bx::findIdentifierMatch(extensions, "EGL_KHR_create_context_no_error").isEmpty();
@@ -345,7 +408,12 @@ EGL_IMPORT
 		{
 			eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
 			eglDestroyContext(m_display, m_context);
-			eglDestroySurface(m_display, m_surface);
+
+			if (EGL_NO_SURFACE != m_surface)
+			{
+				eglDestroySurface(m_display, m_surface);
+			}
+
 			eglTerminate(m_display);
 			m_context = NULL;
 		}
@@ -377,7 +445,18 @@ EGL_IMPORT
 #	elif BX_PLATFORM_EMSCRIPTEN
 		EMSCRIPTEN_CHECK(emscripten_set_canvas_element_size(HTML5_TARGET_CANVAS_SELECTOR, _width, _height) );
 #	else
-		BX_UNUSED(_width, _height);
+		if (m_headless
+		&&  EGL_NO_SURFACE != m_surface)
+		{
+			// Headless, pbuffer size is fixed, recreate it with new backbuffer size.
+			eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			eglDestroySurface(m_display, m_surface);
+			m_surface = createPbufferSurface(m_display, m_config, _width, _height);
+			BGFX_FATAL(m_surface != EGL_NO_SURFACE, Fatal::UnableToInitialize, "Failed to create pbuffer surface.");
+			EGLBoolean success = eglMakeCurrent(m_display, m_surface, m_surface, m_context);
+			BGFX_FATAL(success, Fatal::UnableToInitialize, "Failed to set context.");
+			m_current = NULL;
+		}
 #	endif // BX_PLATFORM_*
 
 		if (NULL != m_display)
@@ -415,7 +494,8 @@ EGL_IMPORT
 
 		if (NULL == _swapChain)
 		{
-			if (NULL != m_display)
+			if (NULL != m_display
+			&&  EGL_NO_SURFACE != m_surface)
 			{
 				eglSwapBuffers(m_display, m_surface);
 			}
@@ -26,6 +26,7 @@ namespace bgfx { namespace gl
 			, m_context(NULL)
 			, m_display(NULL)
 			, m_surface(NULL)
+			, m_headless(false)
 		{
 		}
 
@@ -52,6 +53,7 @@ namespace bgfx { namespace gl
 		EGLContext m_context;
 		EGLDisplay m_display;
 		EGLSurface m_surface;
+		bool       m_headless;
 	};
 } /* namespace gl */ } // namespace bgfx
 
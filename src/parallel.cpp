@@ -0,0 +1,151 @@
+/*
+ * Copyright 2011-2021 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/cpu.h>
+#include <bx/semaphore.h>
+#include <bx/thread.h>
+
+#include "parallel.h"
+
+namespace bgfx
+{
+#if BX_CONFIG_SUPPORTS_THREADING
+	class ParallelForPool
+	{
+	public:
+		static constexpr uint32_t kMaxThreads = 7;
+
+		ParallelForPool()
+			: m_numThreads(0)
+			, m_busy(0)
+			, m_fn(NULL)
+			, m_userData(NULL)
+			, m_num(0)
+			, m_numJobs(0)
+			, m_next(0)
+			, m_exit(false)
+		{
+		}
+
+		~ParallelForPool()
+		{
+			m_exit = true;
+			m_workStart.post(m_numThreads);
+
+			for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+			{
+				m_thread[ii].shutdown();
+			}
+		}
+
+		bool run(ParallelForFn _fn, void* _userData, uint32_t _num, uint32_t _numJobs)
+		{
+			if (0 != bx::atomicCompareAndSwap<uint32_t>(&m_busy, 0, 1) )
+			{
+				return false;
+			}
+
+			const uint32_t numWorkers = _numJobs-1;
+
+			for (; m_numThreads < numWorkers; ++m_numThreads)
+			{
+				m_thread[m_numThreads].init(workerThread, this, 0, "bgfx - parallel for");
+			}
+
+			m_fn       = _fn;
+			m_userData = _userData;
+			m_num      = _num;
+			m_numJobs  = _numJobs;
+			m_next     = 0;
+
+			m_workStart.post(numWorkers);
+			process();
+
+			for (uint32_t ii = 0; ii < numWorkers; ++ii)
+			{
+				m_workDone.wait();
+			}
+
+			bx::atomicCompareAndSwap<uint32_t>(&m_busy, 1, 0);
+
+			return true;
+		}
+
+	private:
+		void process()
+		{
+			const uint32_t numPerJob = m_num/m_numJobs;
+
+			for (uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_next, 1)
+				; idx < m_numJobs
+				; idx = bx::atomicFetchAndAdd<uint32_t>(&m_next, 1)
+				)
+			{
+				const uint32_t begin = idx*numPerJob;
+				const uint32_t end   = idx == m_numJobs-1 ? m_num : begin+numPerJob;
+				m_fn(m_userData, begin, end);
+			}
+		}
+
+		static int32_t workerThread(bx::Thread* /*_self*/, void* _userData)
+		{
+			ParallelForPool* pool = (ParallelForPool*)_userData;
+
+			for (;;)
+			{
+				pool->m_workStart.wait();
+
+				if (pool->m_exit)
+				{
+					break;
+				}
+
+				pool->process();
+				pool->m_workDone.post();
+			}
+
+			return bx::kExitSuccess;
+		}
+
+		bx::Thread    m_thread[kMaxThreads];
+		bx::Semaphore m_workStart;
+		bx::Semaphore m_workDone;
+
+		uint32_t      m_numThreads;
+		uint32_t      m_busy;
+		ParallelForFn m_fn;
+		void*         m_userData;
+		uint32_t      m_num;
+		uint32_t      m_numJobs;
+		uint32_t      m_next;
+		volatile bool m_exit;
+	};
+
+	static ParallelForPool s_parallelFor;
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	void parallelFor(ParallelForFn _fn, void* _userData, uint32_t _num, uint32_t _minPerJob)
+	{
+		if (0 == _num)
+		{
+			return;
+		}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+		const uint32_t numJobs = bx::min(_num/bx::max(_minPerJob, 1u), ParallelForPool::kMaxThreads+1);
+
+		if (1 < numJobs
+		&&  s_parallelFor.run(_fn, _userData, _num, numJobs) )
+		{
+			return;
+		}
+#else
+		BX_UNUSED(_minPerJob);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+		_fn(_userData, 0, _num);
+	}
+
+} // namespace bgfx
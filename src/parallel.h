@@ -0,0 +1,26 @@
+/*
+ * Copyright 2011-2021 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_PARALLEL_H_HEADER_GUARD
+#define BGFX_PARALLEL_H_HEADER_GUARD
+
+#include <bx/bx.h>
+
+namespace bgfx
+{
+	/// Processes items in range [_begin, _end).
+	typedef void (*ParallelForFn)(void* _userData, uint32_t _begin, uint32_t _end);
+
+	/// Splits items [0, _num) into ranges of at least `_minPerJob` items, and processes them on
+	/// calling thread and worker threads shared by CPU side utilities (vertex conversion, vertex
+	/// welding, triangle sorting). Workers don't depend on bgfx being initialized, they are
+	/// created on first use and live until process exits. When workers are busy with call from
+	/// another thread, or when called from worker, all items are processed on calling thread.
+	///
+	void parallelFor(ParallelForFn _fn, void* _userData, uint32_t _num, uint32_t _minPerJob);
+
+} // namespace bgfx
+
+#endif // BGFX_PARALLEL_H_HEADER_GUARD
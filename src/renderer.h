@@ -476,6 +476,100 @@ namespace bgfx
 		return false;
 	}
 
+	/// Header of merged pipeline cache blob stored with `CallbackI::cacheWrite`. Blob is
+	/// discarded when it was written by different device or driver.
+	struct PipelineCacheHeader
+	{
+		static constexpr uint32_t kMagic   = BX_MAKEFOURCC('B', 'P', 'C', 0x0);
+		static constexpr uint32_t kVersion = 1;
+
+		uint32_t magic;
+		uint32_t version;
+		uint32_t vendorId;
+		uint32_t deviceId;
+		uint32_t driverVersion;
+		uint8_t  uuid[16];
+		uint32_t size;
+		uint32_t hash;
+	};
+
+	/// Cache id of merged pipeline cache blob. Upper 32 bits don't overlap with 32-bit
+	/// shader/pipeline hashes used as cache ids elsewhere.
+	inline uint64_t getPipelineCacheId(RendererType::Enum _type)
+	{
+		return (uint64_t(PipelineCacheHeader::kMagic)<<32) | uint64_t(_type);
+	}
+
+	inline void initPipelineCacheHeader(PipelineCacheHeader& _header, uint32_t _vendorId, uint32_t _deviceId, uint32_t _driverVersion, const void* _uuid, uint32_t _uuidSize)
+	{
+		bx::memSet(&_header, 0, sizeof(PipelineCacheHeader) );
+		_header.magic         = PipelineCacheHeader::kMagic;
+		_header.version       = PipelineCacheHeader::kVersion;
+		_header.vendorId      = _vendorId;
+		_header.deviceId      = _deviceId;
+		_header.driverVersion = _driverVersion;
+		bx::memCopy(_header.uuid, _uuid, bx::min<uint32_t>(_uuidSize, sizeof(_header.uuid) ) );
+	}
+
+	/// Reads merged pipeline cache blob. Returns NULL if there is no cached blob, or it
+	/// doesn't match `_expected` header. Returned data must be freed with `BX_FREE`.
+	inline void* pipelineCacheRead(uint64_t _id, const PipelineCacheHeader& _expected, uint32_t& _size)
+	{
+		_size = 0;
+
+		const uint32_t length = g_callback->cacheReadSize(_id);
+		if (length <= sizeof(PipelineCacheHeader) )
+		{
+			return NULL;
+		}
+
+		uint8_t* data = (uint8_t*)BX_ALLOC(g_allocator, length);
+		if (!g_callback->cacheRead(_id, data, length) )
+		{
+			BX_FREE(g_allocator, data);
+			return NULL;
+		}
+
+		PipelineCacheHeader header;
+		bx::memCopy(&header, data, sizeof(PipelineCacheHeader) );
+
+		const uint32_t size = length - uint32_t(sizeof(PipelineCacheHeader) );
+		uint8_t* payload = &data[sizeof(PipelineCacheHeader)];
+
+		if (0 != bx::memCmp(&header, &_expected, BX_OFFSETOF(PipelineCacheHeader, size) )
+		||  header.size != size
+		||  header.hash != bx::hash<bx::HashMurmur2A>(payload, size) )
+		{
+			BX_TRACE("Pipeline cache blob was created by different device or driver, or it's corrupted. Ignoring it.");
+			BX_FREE(g_allocator, data);
+			return NULL;
+		}
+
+		bx::memMove(data, payload, size);
+		_size = size;
+
+		return data;
+	}
+
+	/// Writes merged pipeline cache blob prefixed with `_header`.
+	inline void pipelineCacheWrite(uint64_t _id, const PipelineCacheHeader& _header, const void* _data, uint32_t _size)
+	{
+		const uint32_t length = uint32_t(sizeof(PipelineCacheHeader) ) + _size;
+		uint8_t* data = (uint8_t*)BX_ALLOC(g_allocator, length);
+
+		PipelineCacheHeader header = _header;
+		header.size = _size;
+		header.hash = bx::hash<bx::HashMurmur2A>(_data, _size);
+
+		bx::memCopy(data, &header, sizeof(PipelineCacheHeader) );
+		bx::memCopy(&data[sizeof(PipelineCacheHeader)], _data, _size);
+
+		BX_TRACE("Writing pipeline cache blob (size %d).", length);
+		g_callback->cacheWrite(_id, data, length);
+
+		BX_FREE(g_allocator, data);
+	}
+
 	template<typename Ty>
 	struct Profiler
 	{
@@ -1820,6 +1820,11 @@ namespace bgfx { namespace d3d11
 		{
 		}
 
+		uint32_t getReadTextureLatency() const override
+		{
+			return 0;
+		}
+
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
 			const TextureD3D11& texture = m_textures[_handle.idx];
@@ -1876,6 +1881,12 @@ namespace bgfx { namespace d3d11
 			release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle _handle, uint8_t _minLod) override
+		{
+			const TextureD3D11& texture = m_textures[_handle.idx];
+			m_deviceCtx->SetResourceMinLOD(texture.m_ptr, float(_minLod) );
+		}
+
 		void overrideInternal(TextureHandle _handle, uintptr_t _ptr) override
 		{
 			// Resource ref. counts might be messed up outside of bgfx.
@@ -2098,6 +2109,19 @@ namespace bgfx { namespace d3d11
 			}
 		}
 
+		virtual void prewarmPipeline(ProgramHandle _program, uint64_t _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer) override
+		{
+			BX_UNUSED(_program, _state, _layoutHandle, _frameBuffer);
+		}
+
+		virtual void flushPipelineCache() override
+		{
+		}
+
+		virtual void defragment() override
+		{
+		}
+
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
@@ -6001,8 +6025,7 @@ namespace bgfx { namespace d3d11
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				bool constantsChanged = rendererUpdateUniforms(this, _render, draw);
 
 				if (key.m_program.idx != currentProgram.idx)
 				{
@@ -401,6 +401,7 @@ namespace bgfx { namespace d3d12
 	static const GUID IID_ID3D12GraphicsCommandList3 = { 0x6FDA83A7, 0xB84C, 0x4E38, { 0x9A, 0xC8, 0xC7, 0xBD, 0x22, 0x01, 0x6B, 0x3D } };
 	static const GUID IID_ID3D12GraphicsCommandList4 = { 0x8754318e, 0xd3a9, 0x4541, { 0x98, 0xcf, 0x64, 0x5b, 0x50, 0xdc, 0x48, 0x74 } };
 	static const GUID IID_ID3D12InfoQueue            = { 0x0742a90b, 0xc387, 0x483f, { 0xb9, 0x46, 0x30, 0xa7, 0xe4, 0xe6, 0x14, 0x58 } };
+	static const GUID IID_ID3D12PipelineLibrary      = { 0xc64226a8, 0x9201, 0x46af, { 0xb4, 0xcc, 0x53, 0xfb, 0x9f, 0xf7, 0x41, 0x4f } };
 	static const GUID IID_ID3D12PipelineState        = { 0x765a30f3, 0xf624, 0x4c6f, { 0xa8, 0x28, 0xac, 0xe9, 0x48, 0x62, 0x24, 0x45 } };
 	static const GUID IID_ID3D12Resource             = { 0x696442be, 0xa72e, 0x4059, { 0xbc, 0x79, 0x5b, 0x5c, 0x98, 0x04, 0x0f, 0xad } };
 	static const GUID IID_ID3D12RootSignature        = { 0xc54a6b66, 0x72df, 0x4ee8, { 0x8b, 0xe5, 0xa9, 0x46, 0xa1, 0x42, 0x92, 0x14 } };
@@ -576,6 +577,14 @@ namespace bgfx { namespace d3d12
 		}
 	}
 
+	static void getPipelineName(wchar_t* _out, uint32_t _max, char _type, uint32_t _hash)
+	{
+		char temp[16];
+		int32_t size = bx::min<int32_t>(bx::min<int32_t>(sizeof(temp), _max)-1, bx::snprintf(temp, sizeof(temp), "%c%08x", _type, _hash) );
+		temp[size] = '\0';
+		mbstowcs(_out, temp, size+1);
+	}
+
 #if USE_D3D12_DYNAMIC_LIB
 	static PFN_D3D12_ENABLE_EXPERIMENTAL_FEATURES D3D12EnableExperimentalFeatures;
 	static PFN_D3D12_CREATE_DEVICE                D3D12CreateDevice;
@@ -1086,8 +1095,8 @@ namespace bgfx { namespace d3d12
 
 				for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
 				{
-					m_scratchBuffer[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS*1024
-						, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + BGFX_CONFIG_MAX_DRAW_CALLS
+					m_scratchBuffer[ii].create(g_caps.limits.maxDrawCalls*1024
+						, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + g_caps.limits.maxDrawCalls
 						);
 				}
 				m_samplerAllocator.create(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
@@ -1368,6 +1377,8 @@ namespace bgfx { namespace d3d12
 				m_nvapi.initAftermath(m_device, m_commandList);
 			}
 
+			initPipelineLibrary();
+
 			g_internalData.context = m_device;
 			return true;
 
@@ -1426,6 +1437,7 @@ namespace bgfx { namespace d3d12
 			}
 
 			m_pipelineStateCache.invalidate();
+			shutdownPipelineLibrary();
 
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_indexBuffers); ++ii)
 			{
@@ -1634,6 +1646,11 @@ namespace bgfx { namespace d3d12
 		{
 		}
 
+		uint32_t getReadTextureLatency() const override
+		{
+			return 0;
+		}
+
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip ) override
 		{
 			const TextureD3D12& texture = m_textures[_handle.idx];
@@ -1727,6 +1744,16 @@ namespace bgfx { namespace d3d12
 			release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle _handle, uint8_t _minLod) override
+		{
+			// SRVs are created when texture is bound, clamp is picked up on next bind.
+			TextureD3D12& texture = m_textures[_handle.idx];
+			if (D3D12_SRV_DIMENSION_TEXTURE2D == texture.m_srvd.ViewDimension)
+			{
+				texture.m_srvd.Texture2D.ResourceMinLODClamp = float(_minLod);
+			}
+		}
+
 		void overrideInternal(TextureHandle _handle, uintptr_t _ptr) override
 		{
 			// Resource ref. counts might be messed up outside of bgfx.
@@ -1940,6 +1967,11 @@ namespace bgfx { namespace d3d12
 			}
 		}
 
+		virtual void prewarmPipeline(ProgramHandle _program, uint64_t _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer) override
+		{
+			BX_UNUSED(_program, _state, _layoutHandle, _frameBuffer);
+		}
+
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
@@ -2751,6 +2783,139 @@ namespace bgfx { namespace d3d12
 			}
 		}
 
+		void initPipelineLibrary()
+		{
+			m_pipelineLibrary     = NULL;
+			m_pipelineLibraryData = NULL;
+			m_pipelineCacheDirty  = false;
+
+			ID3D12Device1* device1;
+			HRESULT hr = m_device->QueryInterface(IID_ID3D12Device1, (void**)&device1);
+			if (FAILED(hr) )
+			{
+				BX_TRACE("Pipeline library is not supported.");
+				return;
+			}
+
+			// Pipeline library is invalidated by driver update, so user mode driver version
+			// identifies blob together with exact adapter.
+			const DXGI_ADAPTER_DESC& adapterDesc = m_dxgi.m_adapterDesc;
+
+			struct AdapterId
+			{
+				uint64_t driverVersion;
+				uint32_t subSysId;
+				uint32_t revision;
+			};
+
+			AdapterId adapterId;
+			adapterId.driverVersion = m_dxgi.m_driverVersion;
+			adapterId.subSysId      = adapterDesc.SubSysId;
+			adapterId.revision      = adapterDesc.Revision;
+
+			initPipelineCacheHeader(m_pipelineCacheHeader
+				, adapterDesc.VendorId
+				, adapterDesc.DeviceId
+				, uint32_t(m_dxgi.m_driverVersion)
+				, &adapterId
+				, sizeof(adapterId)
+				);
+
+			uint32_t size;
+			m_pipelineLibraryData = pipelineCacheRead(getPipelineCacheId(RendererType::Direct3D12), m_pipelineCacheHeader, size);
+
+			if (NULL != m_pipelineLibraryData)
+			{
+				// Blob must stay valid for the lifetime of pipeline library.
+				hr = device1->CreatePipelineLibrary(m_pipelineLibraryData
+					, size
+					, IID_ID3D12PipelineLibrary
+					, (void**)&m_pipelineLibrary
+					);
+				if (FAILED(hr) )
+				{
+					BX_TRACE("Failed to load cached pipeline library (HRESULT 0x%08x).", hr);
+					BX_FREE(g_allocator, m_pipelineLibraryData);
+					m_pipelineLibraryData = NULL;
+					m_pipelineLibrary     = NULL;
+				}
+				else
+				{
+					BX_TRACE("Loaded cached pipeline library (size %d).", size);
+				}
+			}
+
+			if (NULL == m_pipelineLibrary)
+			{
+				hr = device1->CreatePipelineLibrary(NULL
+					, 0
+					, IID_ID3D12PipelineLibrary
+					, (void**)&m_pipelineLibrary
+					);
+				if (FAILED(hr) )
+				{
+					BX_TRACE("Failed to create pipeline library (HRESULT 0x%08x).", hr);
+					m_pipelineLibrary = NULL;
+				}
+			}
+
+			device1->Release(); // BK - ignore ref count.
+		}
+
+		void shutdownPipelineLibrary()
+		{
+			flushPipelineCache();
+
+			DX_RELEASE_I(m_pipelineLibrary);
+
+			if (NULL != m_pipelineLibraryData)
+			{
+				BX_FREE(g_allocator, m_pipelineLibraryData);
+				m_pipelineLibraryData = NULL;
+			}
+		}
+
+		void storePipeline(const wchar_t* _name, ID3D12PipelineState* _pso)
+		{
+			if (NULL != m_pipelineLibrary)
+			{
+				// Fails when same name was already stored with different description
+				// (e.g. wireframe toggled), in which case pipeline is just not cached.
+				HRESULT hr = m_pipelineLibrary->StorePipeline(_name, _pso);
+				m_pipelineCacheDirty |= SUCCEEDED(hr);
+			}
+		}
+
+		void defragment() override
+		{
+		}
+
+		void flushPipelineCache() override
+		{
+			if (NULL == m_pipelineLibrary
+			||  !m_pipelineCacheDirty)
+			{
+				return;
+			}
+
+			m_pipelineCacheDirty = false;
+
+			const SIZE_T size = m_pipelineLibrary->GetSerializedSize();
+			void* data = BX_ALLOC(g_allocator, size);
+
+			HRESULT hr = m_pipelineLibrary->Serialize(data, size);
+			if (SUCCEEDED(hr) )
+			{
+				pipelineCacheWrite(getPipelineCacheId(RendererType::Direct3D12), m_pipelineCacheHeader, data, uint32_t(size) );
+			}
+			else
+			{
+				BX_TRACE("Failed to serialize pipeline library (HRESULT 0x%08x).", hr);
+			}
+
+			BX_FREE(g_allocator, data);
+		}
+
 		ID3D12PipelineState* getPipelineState(ProgramHandle _program)
 		{
 			ProgramD3D12& program = m_program[_program.idx];
@@ -2773,31 +2938,19 @@ namespace bgfx { namespace d3d12
 			desc.NodeMask           = 1;
 			desc.Flags              = D3D12_PIPELINE_STATE_FLAG_NONE;
 
-			uint32_t length = g_callback->cacheReadSize(hash);
-			const bool cached = length > 0;
+			wchar_t name[16];
+			getPipelineName(name, BX_COUNTOF(name), 'c', hash);
 
-			void* cachedData = NULL;
-
-			if (cached)
+			if (NULL != m_pipelineLibrary)
 			{
-				cachedData = BX_ALLOC(g_allocator, length);
-				if (g_callback->cacheRead(hash, cachedData, length) )
+				HRESULT hr = m_pipelineLibrary->LoadComputePipeline(name
+					, &desc
+					, IID_ID3D12PipelineState
+					, (void**)&pso
+					);
+				if (FAILED(hr) )
 				{
-					BX_TRACE("Loading cached compute PSO (size %d).", length);
-					bx::MemoryReader reader(cachedData, length);
-
-					desc.CachedPSO.pCachedBlob           = reader.getDataPtr();
-					desc.CachedPSO.CachedBlobSizeInBytes = (size_t)reader.remaining();
-
-					HRESULT hr = m_device->CreateComputePipelineState(&desc
-						, IID_ID3D12PipelineState
-						, (void**)&pso
-						);
-					if (FAILED(hr) )
-					{
-						BX_TRACE("Failed to load cached compute PSO (HRESULT 0x%08x).", hr);
-						bx::memSet(&desc.CachedPSO, 0, sizeof(desc.CachedPSO) );
-					}
+					pso = NULL;
 				}
 			}
 
@@ -2807,27 +2960,11 @@ namespace bgfx { namespace d3d12
 					, IID_ID3D12PipelineState
 					, (void**)&pso
 					) );
+				storePipeline(name, pso);
 			}
 
 			m_pipelineStateCache.add(hash, pso);
 
-			ID3DBlob* blob;
-			HRESULT hr = pso->GetCachedBlob(&blob);
-			if (SUCCEEDED(hr) )
-			{
-				void* data = blob->GetBufferPointer();
-				length = (uint32_t)blob->GetBufferSize();
-
-				g_callback->cacheWrite(hash, data, length);
-
-				DX_RELEASE(blob, 0);
-			}
-
-			if (NULL != cachedData)
-			{
-				BX_FREE(g_allocator, cachedData);
-			}
-
 			return pso;
 		}
 
@@ -3054,31 +3191,19 @@ namespace bgfx { namespace d3d12
 
 			desc.SampleDesc = m_scd.sampleDesc;
 
-			uint32_t length = g_callback->cacheReadSize(hash);
-			const bool cached = length > 0;
-
-			void* cachedData = NULL;
+			wchar_t name[16];
+			getPipelineName(name, BX_COUNTOF(name), 'g', hash);
 
-			if (cached)
+			if (NULL != m_pipelineLibrary)
 			{
-				cachedData = BX_ALLOC(g_allocator, length);
-				if (g_callback->cacheRead(hash, cachedData, length) )
+				HRESULT hr = m_pipelineLibrary->LoadGraphicsPipeline(name
+					, &desc
+					, IID_ID3D12PipelineState
+					, (void**)&pso
+					);
+				if (FAILED(hr) )
 				{
-					BX_TRACE("Loading cached graphics PSO (size %d).", length);
-					bx::MemoryReader reader(cachedData, length);
-
-					desc.CachedPSO.pCachedBlob           = reader.getDataPtr();
-					desc.CachedPSO.CachedBlobSizeInBytes = (size_t)reader.remaining();
-
-					HRESULT hr = m_device->CreateGraphicsPipelineState(&desc
-									, IID_ID3D12PipelineState
-									, (void**)&pso
-									);
-					if (FAILED(hr) )
-					{
-						BX_TRACE("Failed to load cached graphics PSO (HRESULT 0x%08x).", hr);
-						bx::memSet(&desc.CachedPSO, 0, sizeof(desc.CachedPSO) );
-					}
+					pso = NULL;
 				}
 			}
 
@@ -3088,6 +3213,11 @@ namespace bgfx { namespace d3d12
 					, IID_ID3D12PipelineState
 					, (void**)&pso
 					) );
+
+				if (NULL != pso)
+				{
+					storePipeline(name, pso);
+				}
 			}
 
 			BGFX_FATAL(NULL != pso, Fatal::InvalidShader, "Failed to create PSO!");
@@ -3099,23 +3229,6 @@ namespace bgfx { namespace d3d12
 				release(temp);
 			}
 
-			ID3DBlob* blob;
-			HRESULT hr = pso->GetCachedBlob(&blob);
-			if (SUCCEEDED(hr) )
-			{
-				void* data = blob->GetBufferPointer();
-				length = (uint32_t)blob->GetBufferSize();
-
-				g_callback->cacheWrite(hash, data, length);
-
-				DX_RELEASE(blob, 0);
-			}
-
-			if (NULL != cachedData)
-			{
-				BX_FREE(g_allocator, cachedData);
-			}
-
 			return pso;
 		}
 
@@ -3383,6 +3496,11 @@ namespace bgfx { namespace d3d12
 		ID3D12RootSignature*    m_rootSignature;
 		ID3D12CommandSignature* m_commandSignature[3];
 
+		ID3D12PipelineLibrary* m_pipelineLibrary;
+		void* m_pipelineLibraryData;
+		PipelineCacheHeader m_pipelineCacheHeader;
+		bool m_pipelineCacheDirty;
+
 		CommandQueueD3D12 m_cmd;
 		BatchD3D12 m_batch;
 		ID3D12GraphicsCommandList* m_commandList;
@@ -4426,6 +4544,28 @@ namespace bgfx { namespace d3d12
 		ID3D12Device* device = s_renderD3D12->m_device;
 		ID3D12GraphicsCommandList* commandList = s_renderD3D12->m_commandList;
 
+		if (m_flags & BGFX_BUFFER_INTERNAL_TRANSIENT)
+		{
+			m_ring = (TransientRingD3D12*)BX_ALLOC(g_allocator, sizeof(TransientRingD3D12) );
+			m_ring->m_num     = BX_COUNTOF(m_ring->m_ptr);
+			m_ring->m_current = 0;
+
+			D3D12_RANGE readRange = { 0, 0 };
+
+			for (uint32_t ii = 0; ii < m_ring->m_num; ++ii)
+			{
+				m_ring->m_ptr[ii]   = createCommittedResource(device, HeapProperty::Upload, _size);
+				m_ring->m_fence[ii] = 0;
+				DX_CHECK(m_ring->m_ptr[ii]->Map(0, &readRange, (void**)&m_ring->m_data[ii]) );
+			}
+
+			// Upload heap resources must stay in generic read state.
+			m_ptr   = m_ring->m_ptr[0];
+			m_gpuVA = m_ptr->GetGPUVirtualAddress();
+			m_state = D3D12_RESOURCE_STATE_GENERIC_READ;
+			return;
+		}
+
 		m_ptr   = createCommittedResource(device, HeapProperty::Default, _size, D3D12_RESOURCE_FLAGS(flags) );
 		m_gpuVA = m_ptr->GetGPUVirtualAddress();
 		setState(commandList, drawIndirect
@@ -4441,6 +4581,19 @@ namespace bgfx { namespace d3d12
 
 	void BufferD3D12::update(ID3D12GraphicsCommandList* _commandList, uint32_t _offset, uint32_t _size, void* _data, bool /*_discard*/)
 	{
+		if (NULL != m_ring)
+		{
+			uint8_t* dst = &m_ring->m_data[m_ring->m_current][_offset];
+
+			// Data written in place by the API thread doesn't need a copy.
+			if (dst != _data)
+			{
+				bx::memCopy(dst, _data, _size);
+			}
+
+			return;
+		}
+
 		ID3D12Resource* staging = createCommittedResource(s_renderD3D12->m_device, HeapProperty::Upload, _size);
 		uint8_t* data;
 
@@ -4459,7 +4612,21 @@ namespace bgfx { namespace d3d12
 
 	void BufferD3D12::destroy()
 	{
-		if (NULL != m_ptr)
+		if (NULL != m_ring)
+		{
+			for (uint32_t ii = 0; ii < m_ring->m_num; ++ii)
+			{
+				m_ring->m_ptr[ii]->Unmap(0, NULL);
+				s_renderD3D12->m_cmd.release(m_ring->m_ptr[ii]);
+			}
+
+			BX_FREE(g_allocator, m_ring);
+			m_ring    = NULL;
+			m_ptr     = NULL;
+			m_dynamic = false;
+			m_state   = D3D12_RESOURCE_STATE_COMMON;
+		}
+		else if (NULL != m_ptr)
 		{
 			s_renderD3D12->m_cmd.release(m_ptr);
 			m_dynamic = false;
@@ -4467,6 +4634,26 @@ namespace bgfx { namespace d3d12
 		}
 	}
 
+	uint8_t* BufferD3D12::advance(uint64_t _fence)
+	{
+		BX_ASSERT(NULL != m_ring, "Only transient buffers have a ring.");
+
+		m_ring->m_fence[m_ring->m_current] = _fence;
+		m_ring->m_current = (m_ring->m_current + 1) % m_ring->m_num;
+
+		// GPU is too far behind, wait until it's done reading from the slot.
+		const uint64_t fence = m_ring->m_fence[m_ring->m_current];
+		if (fence > s_renderD3D12->m_cmd.m_completedFence)
+		{
+			s_renderD3D12->m_cmd.finish(fence);
+		}
+
+		m_ptr   = m_ring->m_ptr[m_ring->m_current];
+		m_gpuVA = m_ptr->GetGPUVirtualAddress();
+
+		return m_ring->m_data[m_ring->m_current];
+	}
+
 	D3D12_RESOURCE_STATES BufferD3D12::setState(ID3D12GraphicsCommandList* _commandList, D3D12_RESOURCE_STATES _state)
 	{
 		if (m_state != _state)
@@ -6426,8 +6613,7 @@ namespace bgfx { namespace d3d12
 					primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
 				}
 
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				bool constantsChanged = rendererUpdateUniforms(this, _render, draw);
 
 				if (0 != draw.m_streamMask)
 				{
@@ -7041,7 +7227,20 @@ namespace bgfx { namespace d3d12
 		}
 #endif // BX_PLATFORM_WINDOWS
 
-		m_backBufferColorFence[m_backBufferColorIdx] = kick();
+		const uint64_t fence = kick();
+		m_backBufferColorFence[m_backBufferColorIdx] = fence;
+
+		// Next time this frame is submitted the API thread writes transient data directly into
+		// the next ring slot, and upload at the start of submit becomes a no-op.
+		if (NULL != _render->m_transientIb)
+		{
+			_render->m_transientIb->data = m_indexBuffers[_render->m_transientIb->handle.idx].advance(fence);
+		}
+
+		if (NULL != _render->m_transientVb)
+		{
+			_render->m_transientVb->data = m_vertexBuffers[_render->m_transientVb->handle.idx].advance(fence);
+		}
 	}
 
 } /* namespace d3d12 */ } // namespace bgfx
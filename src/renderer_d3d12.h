@@ -201,10 +201,22 @@ namespace bgfx { namespace d3d12
 		uint16_t m_numDescriptorsPerBlock;
 	};
 
+	// Persistently mapped upload heap copies of a transient buffer. The API thread writes the
+	// next frame's data straight into a slot whose fence has already completed.
+	struct TransientRingD3D12
+	{
+		ID3D12Resource* m_ptr[BGFX_CONFIG_MAX_FRAME_LATENCY+2];
+		uint8_t*        m_data[BGFX_CONFIG_MAX_FRAME_LATENCY+2];
+		uint64_t        m_fence[BGFX_CONFIG_MAX_FRAME_LATENCY+2];
+		uint32_t        m_num;
+		uint32_t        m_current;
+	};
+
 	struct BufferD3D12
 	{
 		BufferD3D12()
 			: m_ptr(NULL)
+			, m_ring(NULL)
 			, m_state(D3D12_RESOURCE_STATE_COMMON)
 			, m_size(0)
 			, m_flags(BGFX_BUFFER_NONE)
@@ -216,11 +228,15 @@ namespace bgfx { namespace d3d12
 		void update(ID3D12GraphicsCommandList* _commandList, uint32_t _offset, uint32_t _size, void* _data, bool _discard = false);
 		void destroy();
 
+		// Retires current transient ring slot with fence, returns mapped memory of the next one.
+		uint8_t* advance(uint64_t _fence);
+
 		D3D12_RESOURCE_STATES setState(ID3D12GraphicsCommandList* _commandList, D3D12_RESOURCE_STATES _state);
 
 		D3D12_SHADER_RESOURCE_VIEW_DESC  m_srvd;
 		D3D12_UNORDERED_ACCESS_VIEW_DESC m_uavd;
 		ID3D12Resource* m_ptr;
+		TransientRingD3D12* m_ring;
 		D3D12_GPU_VIRTUAL_ADDRESS m_gpuVA;
 		D3D12_RESOURCE_STATES m_state;
 		uint32_t m_size;
@@ -1092,6 +1092,11 @@ namespace bgfx { namespace d3d9
 			m_updateTexture = NULL;
 		}
 
+		uint32_t getReadTextureLatency() const override
+		{
+			return 0;
+		}
+
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
 			TextureD3D9& texture = m_textures[_handle.idx];
@@ -1153,6 +1158,10 @@ namespace bgfx { namespace d3d9
 			release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle /*_handle*/, uint8_t /*_minLod*/) override
+		{
+		}
+
 		void overrideInternal(TextureHandle _handle, uintptr_t _ptr) override
 		{
 			// Resource ref. counts might be messed up outside of bgfx.
@@ -1336,6 +1345,19 @@ namespace bgfx { namespace d3d9
 			BX_UNUSED(_handle, _name, _len)
 		}
 
+		virtual void prewarmPipeline(ProgramHandle _program, uint64_t _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer) override
+		{
+			BX_UNUSED(_program, _state, _layoutHandle, _frameBuffer);
+		}
+
+		virtual void flushPipelineCache() override
+		{
+		}
+
+		virtual void defragment() override
+		{
+		}
+
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
@@ -4125,8 +4147,7 @@ namespace bgfx { namespace d3d9
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				bool constantsChanged = rendererUpdateUniforms(this, _render, draw);
 
 				if (key.m_program.idx != currentProgram.idx)
 				{
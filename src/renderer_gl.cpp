@@ -498,6 +498,8 @@ namespace bgfx { namespace gl
 			APPLE_texture_format_BGRA8888,
 			APPLE_texture_max_level,
 
+			ARB_bindless_texture,
+			ARB_buffer_storage,
 			ARB_clip_control,
 			ARB_compute_shader,
 			ARB_conservative_depth,
@@ -532,6 +534,7 @@ namespace bgfx { namespace gl
 			ARB_shader_image_load_store,
 			ARB_shader_storage_buffer_object,
 			ARB_shader_texture_lod,
+			ARB_sync,
 			ARB_texture_compression_bptc,
 			ARB_texture_compression_rgtc,
 			ARB_texture_cube_map_array,
@@ -545,6 +548,7 @@ namespace bgfx { namespace gl
 			ARB_timer_query,
 			ARB_uniform_buffer_object,
 			ARB_vertex_array_object,
+			ARB_vertex_attrib_binding,
 			ARB_vertex_type_2_10_10_10_rev,
 
 			ATI_meminfo,
@@ -712,6 +716,8 @@ namespace bgfx { namespace gl
 		{ "APPLE_texture_format_BGRA8888",            false,                             true  },
 		{ "APPLE_texture_max_level",                  false,                             true  },
 
+		{ "ARB_bindless_texture",                     false,                             true  },
+		{ "ARB_buffer_storage",                       BGFX_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_clip_control",                         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_compute_shader",                       BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_conservative_depth",                   BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
@@ -746,6 +752,7 @@ namespace bgfx { namespace gl
 		{ "ARB_shader_image_load_store",              BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
 		{ "ARB_shader_storage_buffer_object",         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_shader_texture_lod",                   BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
+		{ "ARB_sync",                                 BGFX_CONFIG_RENDERER_OPENGL >= 32, true  },
 		{ "ARB_texture_compression_bptc",             BGFX_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_texture_compression_rgtc",             BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
 		{ "ARB_texture_cube_map_array",               BGFX_CONFIG_RENDERER_OPENGL >= 40, true  },
@@ -759,6 +766,7 @@ namespace bgfx { namespace gl
 		{ "ARB_timer_query",                          BGFX_CONFIG_RENDERER_OPENGL >= 33, true  },
 		{ "ARB_uniform_buffer_object",                BGFX_CONFIG_RENDERER_OPENGL >= 31, true  },
 		{ "ARB_vertex_array_object",                  BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
+		{ "ARB_vertex_attrib_binding",                BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_vertex_type_2_10_10_10_rev",           false,                             true  },
 
 		{ "ATI_meminfo",                              false,                             true  },
@@ -2147,7 +2155,10 @@ namespace bgfx { namespace gl
 			, m_blitSupported(false)
 			, m_readBackSupported(BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL) )
 			, m_vaoSupport(false)
+			, m_vertexAttribBindingSupport(false)
 			, m_samplerObjectSupport(false)
+			, m_uniformBufferSupport(false)
+			, m_readBackAsyncSupport(false)
 			, m_shadowSamplersSupport(false)
 			, m_srgbWriteControlSupport(BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL) )
 			, m_borderColorSupport(BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL) )
@@ -2158,14 +2169,29 @@ namespace bgfx { namespace gl
 			, m_occlusionQuerySupport(false)
 			, m_atocSupport(false)
 			, m_conservativeRasterSupport(false)
+			, m_bindlessSupport(false)
 			, m_flip(false)
 			, m_hash( (BX_PLATFORM_WINDOWS<<1) | BX_ARCH_64BIT)
 			, m_backBufferFbo(0)
 			, m_msaaBackBufferFbo(0)
+			, m_uniformStream(0)
+			, m_uniformStreamPtr(NULL)
+			, m_uniformStreamSize(0)
+			, m_uniformStreamHead(0)
+			, m_uniformStreamTail(0)
+			, m_uniformStreamAlign(256)
+			, m_uniformStreamGen(0)
+			, m_uniformStreamFenceRead(0)
+			, m_uniformStreamFenceWrite(0)
+			, m_maxUniformBlockSize(0)
+			, m_bindlessBuffer(0)
+			, m_bindlessDirtyBegin(UINT32_MAX)
+			, m_bindlessDirtyEnd(0)
 			, m_clearQuadColor(BGFX_INVALID_HANDLE)
 			, m_clearQuadDepth(BGFX_INVALID_HANDLE)
 		{
 			bx::memSet(m_msaaBackBufferRbos, 0, sizeof(m_msaaBackBufferRbos) );
+			bx::memSet(m_bindlessHandle, 0, sizeof(m_bindlessHandle) );
 		}
 
 		~RendererContextGL()
@@ -2832,11 +2858,62 @@ namespace bgfx { namespace gl
 					GL_CHECK(glGenVertexArrays(1, &m_vao) );
 				}
 
+				m_vertexAttribBindingSupport = m_vaoSupport
+					&& (!!(BGFX_CONFIG_RENDERER_OPENGLES >= 31)
+						|| s_extension[Extension::ARB_vertex_attrib_binding].m_supported
+						)
+					&& NULL != glBindVertexBuffer
+					;
+
 				m_samplerObjectSupport = !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN)
 					&& (!!(BGFX_CONFIG_RENDERER_OPENGLES >= 30)
 						|| s_extension[Extension::ARB_sampler_objects].m_supported
 						);
 
+				m_uniformBufferSupport = !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN)
+					&& !!(BGFX_CONFIG_RENDERER_OPENGL >= 31 || BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+					&& (!!(BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+						|| s_extension[Extension::ARB_uniform_buffer_object].m_supported
+						)
+					&& NULL != glBindBufferRange
+					&& NULL != glUniformBlockBinding
+					&& (!!(BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+						|| s_extension[Extension::ARB_sync].m_supported
+						)
+					&& NULL != glFenceSync
+					&& NULL != glClientWaitSync
+					&& NULL != glDeleteSync
+					;
+
+				m_readBackAsyncSupport = !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN)
+					&& !!(BGFX_CONFIG_RENDERER_OPENGL >= 30 || BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+					&& (!!(BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+						|| s_extension[Extension::ARB_sync].m_supported
+						)
+					&& NULL != glFenceSync
+					&& NULL != glClientWaitSync
+					&& NULL != glDeleteSync
+					&& NULL != glMapBufferRange
+					&& NULL != glUnmapBuffer
+					;
+
+				if (m_uniformBufferSupport)
+				{
+					GLint align = 0;
+					GL_CHECK(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align) );
+					m_uniformStreamAlign = bx::max<uint32_t>(align, 16);
+
+					GLint maxBlockSize = 0;
+					GL_CHECK(glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &maxBlockSize) );
+					m_maxUniformBlockSize = uint32_t(maxBlockSize);
+
+					createUniformStream(BGFX_CONFIG_UNIFORM_STREAM_BUFFER_SIZE);
+
+					bx::memSet(m_uniformBlockGen,   0xff, sizeof(m_uniformBlockGen) );
+					bx::memSet(m_uniformBlockSize,  0,    sizeof(m_uniformBlockSize) );
+					bx::memSet(m_uniformBlockDirty, true, sizeof(m_uniformBlockDirty) );
+				}
+
 				m_shadowSamplersSupport = !!(BGFX_CONFIG_RENDERER_OPENGL || BGFX_CONFIG_RENDERER_OPENGLES >= 30)
 					|| s_extension[Extension::EXT_shadow_samplers].m_supported
 					;
@@ -2898,6 +2975,30 @@ namespace bgfx { namespace gl
 					|| s_extension[Extension::EXT_shader_image_load_store].m_supported
 					;
 
+#if BGFX_CONFIG_RENDERER_OPENGL
+				// Texture handles are read from storage buffer bound after last texture stage.
+				if (computeSupport
+				&&  m_samplerObjectSupport
+				&&  s_extension[Extension::ARB_bindless_texture            ].m_supported
+				&&  s_extension[Extension::ARB_shader_storage_buffer_object].m_supported
+				&&  NULL != glGetTextureHandleARB
+				&&  NULL != glMakeTextureHandleResidentARB
+				&&  NULL != glMakeTextureHandleNonResidentARB)
+				{
+					GLint maxBindings = 0;
+					GL_CHECK(glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &maxBindings) );
+					m_bindlessSupport = BGFX_CONFIG_MAX_TEXTURE_SAMPLERS < maxBindings;
+				}
+
+				if (m_bindlessSupport)
+				{
+					GL_CHECK(glGenBuffers(1, &m_bindlessBuffer) );
+					GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_bindlessBuffer) );
+					GL_CHECK(glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(m_bindlessHandle), m_bindlessHandle, GL_DYNAMIC_DRAW) );
+					GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0) );
+				}
+#endif // BGFX_CONFIG_RENDERER_OPENGL
+
 				g_caps.supported |= 0
 					| (m_atocSupport               ? BGFX_CAPS_ALPHA_TO_COVERAGE      : 0)
 					| (m_conservativeRasterSupport ? BGFX_CAPS_CONSERVATIVE_RASTER    : 0)
@@ -2905,6 +3006,7 @@ namespace bgfx { namespace gl
 					| (m_depthTextureSupport       ? BGFX_CAPS_TEXTURE_COMPARE_LEQUAL : 0)
 					| (computeSupport              ? BGFX_CAPS_COMPUTE                : 0)
 					| (m_imageLoadStoreSupport     ? BGFX_CAPS_IMAGE_RW               : 0)
+					| (m_bindlessSupport           ? BGFX_CAPS_TEXTURE_BINDLESS       : 0)
 					;
 
 				g_caps.supported |= m_glctx.getCaps();
@@ -3041,6 +3143,11 @@ namespace bgfx { namespace gl
 					m_occlusionQuery.create();
 				}
 
+				if (m_readBackAsyncSupport)
+				{
+					m_readBack.create();
+				}
+
 				// Init reserved part of view name.
 				for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
 				{
@@ -3072,6 +3179,23 @@ namespace bgfx { namespace gl
 				GL_CHECK(glBindVertexArray(0) );
 				GL_CHECK(glDeleteVertexArrays(1, &m_vao) );
 				m_vao = 0;
+				m_vertexArrayCache.invalidate();
+			}
+
+			if (0 != m_uniformStream)
+			{
+				while (m_uniformStreamFenceRead != m_uniformStreamFenceWrite)
+				{
+					waitUniformStream();
+				}
+
+				destroyUniformStream();
+			}
+
+			if (0 != m_bindlessBuffer)
+			{
+				GL_CHECK(glDeleteBuffers(1, &m_bindlessBuffer) );
+				m_bindlessBuffer = 0;
 			}
 
 			captureFinish();
@@ -3088,6 +3212,11 @@ namespace bgfx { namespace gl
 				m_occlusionQuery.destroy();
 			}
 
+			if (m_readBackAsyncSupport)
+			{
+				m_readBack.destroy();
+			}
+
 			destroyMsaaFbo();
 			m_glctx.destroy();
 
@@ -3148,6 +3277,7 @@ namespace bgfx { namespace gl
 
 		void destroyIndexBuffer(IndexBufferHandle _handle) override
 		{
+			m_vertexArrayCache.invalidateWithIndexBuffer(_handle);
 			m_indexBuffers[_handle.idx].destroy();
 		}
 
@@ -3158,8 +3288,9 @@ namespace bgfx { namespace gl
 			dump(layout);
 		}
 
-		void destroyVertexLayout(VertexLayoutHandle /*_handle*/) override
+		void destroyVertexLayout(VertexLayoutHandle _handle) override
 		{
+			m_vertexArrayCache.invalidateWithVertexLayout(_handle);
 		}
 
 		void createVertexBuffer(VertexBufferHandle _handle, const Memory* _mem, VertexLayoutHandle _layoutHandle, uint16_t _flags) override
@@ -3169,6 +3300,7 @@ namespace bgfx { namespace gl
 
 		void destroyVertexBuffer(VertexBufferHandle _handle) override
 		{
+			m_vertexArrayCache.invalidateWithVertexBuffer(_handle);
 			m_vertexBuffers[_handle.idx].destroy();
 		}
 
@@ -3184,6 +3316,7 @@ namespace bgfx { namespace gl
 
 		void destroyDynamicIndexBuffer(IndexBufferHandle _handle) override
 		{
+			m_vertexArrayCache.invalidateWithIndexBuffer(_handle);
 			m_indexBuffers[_handle.idx].destroy();
 		}
 
@@ -3200,6 +3333,7 @@ namespace bgfx { namespace gl
 
 		void destroyDynamicVertexBuffer(VertexBufferHandle _handle) override
 		{
+			m_vertexArrayCache.invalidateWithVertexBuffer(_handle);
 			m_vertexBuffers[_handle.idx].destroy();
 		}
 
@@ -3221,12 +3355,19 @@ namespace bgfx { namespace gl
 
 		void destroyProgram(ProgramHandle _handle) override
 		{
+			m_vertexArrayCache.invalidateWithProgram(_handle);
 			m_program[_handle.idx].destroy();
 		}
 
 		void* createTexture(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip) override
 		{
 			m_textures[_handle.idx].create(_mem, _flags, _skip);
+
+			if (m_bindlessSupport)
+			{
+				makeBindlessResident(_handle);
+			}
+
 			return NULL;
 		}
 
@@ -3243,6 +3384,11 @@ namespace bgfx { namespace gl
 		{
 		}
 
+		uint32_t getReadTextureLatency() const override
+		{
+			return m_readBackAsyncSupport ? BGFX_CONFIG_TEXTURE_READ_BACK_LATENCY : 0;
+		}
+
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
 			if (m_readBackSupported)
@@ -3259,6 +3405,24 @@ namespace bgfx { namespace gl
 						, _data
 						) );
 				}
+				else if (m_readBackAsyncSupport
+					 &&  GL_TEXTURE_2D == texture.m_target)
+				{
+					const uint32_t bpp    = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(texture.m_textureFormat) );
+					const uint32_t width  = bx::max<uint32_t>(1, texture.m_width  >> _mip);
+					const uint32_t height = bx::max<uint32_t>(1, texture.m_height >> _mip);
+					const uint32_t rowSize = width*bpp/8;
+
+					// Rows are packed with default GL_PACK_ALIGNMENT, last row is not padded.
+					m_readBack.begin(_data, bx::strideAlign(rowSize, 4)*(height-1) + rowSize);
+					GL_CHECK(glGetTexImage(texture.m_target
+						, _mip
+						, texture.m_fmt
+						, texture.m_type
+						, NULL
+						) );
+					m_readBack.end();
+				}
 				else
 				{
 					GL_CHECK(glGetTexImage(texture.m_target
@@ -3300,6 +3464,11 @@ namespace bgfx { namespace gl
 
 					if (GL_FRAMEBUFFER_COMPLETE == glCheckFramebufferStatus(GL_FRAMEBUFFER) )
 					{
+						if (m_readBackAsyncSupport)
+						{
+							m_readBack.begin(_data, texture.m_width*texture.m_height*4);
+						}
+
 						GL_CHECK(glReadPixels(
 							  0
 							, 0
@@ -3307,8 +3476,13 @@ namespace bgfx { namespace gl
 							, texture.m_height
 							, m_readPixelsFmt
 							, GL_UNSIGNED_BYTE
-							, _data
+							, m_readBackAsyncSupport ? NULL : _data
 							) );
+
+						if (m_readBackAsyncSupport)
+						{
+							m_readBack.end();
+						}
 					}
 
 					frameBuffer.destroy();
@@ -3338,15 +3512,48 @@ namespace bgfx { namespace gl
 			tc.m_mem       = NULL;
 			bx::write(&writer, tc);
 
+			if (m_bindlessSupport)
+			{
+				makeBindlessNonResident(_handle);
+			}
+
 			texture.destroy();
 			texture.create(mem, texture.m_flags, 0);
 
+			if (m_bindlessSupport)
+			{
+				makeBindlessResident(_handle);
+			}
+
 			release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle _handle, uint8_t _minLod) override
+		{
+			// Texture state is immutable once bindless handle is created.
+			if (BGFX_CONFIG_MAX_BINDLESS_TEXTURES > _handle.idx
+			&&  0 != m_bindlessHandle[_handle.idx])
+			{
+				return;
+			}
+
+			// Min LOD is part of sampler state, it's applied next time texture is bound.
+			m_textures[_handle.idx].m_minLod = _minLod;
+		}
+
 		void overrideInternal(TextureHandle _handle, uintptr_t _ptr) override
 		{
+			if (m_bindlessSupport)
+			{
+				makeBindlessNonResident(_handle);
+			}
+
 			m_textures[_handle.idx].overrideInternal(_ptr);
+
+			if (m_bindlessSupport)
+			{
+				makeBindlessResident(_handle);
+			}
 		}
 
 		uintptr_t getInternal(TextureHandle _handle) override
@@ -3356,9 +3563,75 @@ namespace bgfx { namespace gl
 
 		void destroyTexture(TextureHandle _handle) override
 		{
+			if (m_bindlessSupport)
+			{
+				makeBindlessNonResident(_handle);
+			}
+
 			m_textures[_handle.idx].destroy();
 		}
 
+		void makeBindlessResident(TextureHandle _handle)
+		{
+#if BGFX_CONFIG_RENDERER_OPENGL
+			const TextureGL& texture = m_textures[_handle.idx];
+
+			// Resident texture's state is immutable, only textures that opted in are made resident,
+			// others keep min LOD clamp and sampler state changes.
+			if (BGFX_CONFIG_MAX_BINDLESS_TEXTURES > _handle.idx
+			&&  0 != texture.m_id
+			&&  GL_TEXTURE_2D == texture.m_target
+			&&  0 != (texture.m_flags & BGFX_TEXTURE_BINDLESS) )
+			{
+				// Handle samples with texture's own sampler state, set when texture was created.
+				const GLuint64 handle = glGetTextureHandleARB(texture.m_id);
+				GL_CHECK(glMakeTextureHandleResidentARB(handle) );
+
+				m_bindlessHandle[_handle.idx] = handle;
+				m_bindlessDirtyBegin = bx::min<uint32_t>(m_bindlessDirtyBegin, _handle.idx);
+				m_bindlessDirtyEnd   = bx::max<uint32_t>(m_bindlessDirtyEnd,   _handle.idx+1);
+			}
+#else
+			BX_UNUSED(_handle);
+#endif // BGFX_CONFIG_RENDERER_OPENGL
+		}
+
+		void makeBindlessNonResident(TextureHandle _handle)
+		{
+#if BGFX_CONFIG_RENDERER_OPENGL
+			if (BGFX_CONFIG_MAX_BINDLESS_TEXTURES > _handle.idx
+			&&  0 != m_bindlessHandle[_handle.idx])
+			{
+				GL_CHECK(glMakeTextureHandleNonResidentARB(m_bindlessHandle[_handle.idx]) );
+
+				m_bindlessHandle[_handle.idx] = 0;
+				m_bindlessDirtyBegin = bx::min<uint32_t>(m_bindlessDirtyBegin, _handle.idx);
+				m_bindlessDirtyEnd   = bx::max<uint32_t>(m_bindlessDirtyEnd,   _handle.idx+1);
+			}
+#else
+			BX_UNUSED(_handle);
+#endif // BGFX_CONFIG_RENDERER_OPENGL
+		}
+
+		void updateBindless()
+		{
+			if (m_bindlessDirtyBegin < m_bindlessDirtyEnd)
+			{
+				GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_bindlessBuffer) );
+				GL_CHECK(glBufferSubData(GL_SHADER_STORAGE_BUFFER
+					, m_bindlessDirtyBegin*sizeof(uint64_t)
+					, (m_bindlessDirtyEnd - m_bindlessDirtyBegin)*sizeof(uint64_t)
+					, &m_bindlessHandle[m_bindlessDirtyBegin]
+					) );
+				GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0) );
+
+				m_bindlessDirtyBegin = UINT32_MAX;
+				m_bindlessDirtyEnd   = 0;
+			}
+
+			GL_CHECK(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, m_bindlessBuffer) );
+		}
+
 		void createFrameBuffer(FrameBufferHandle _handle, uint8_t _num, const Attachment* _attachment) override
 		{
 			m_frameBuffers[_handle.idx].create(_num, _attachment);
@@ -3516,8 +3789,70 @@ namespace bgfx { namespace gl
 			}
 		}
 
+		virtual void prewarmPipeline(ProgramHandle _program, uint64_t _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer) override
+		{
+			BX_UNUSED(_program, _state, _layoutHandle, _frameBuffer);
+		}
+
+		virtual void flushPipelineCache() override
+		{
+		}
+
+		virtual void defragment() override
+		{
+		}
+
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
+		void getVertexArrayKey(VertexArrayKey& _key, const RenderDraw& _draw, ProgramHandle _program, bool _buffers) const
+		{
+			_key.clear();
+			_key.m_program = _program.idx;
+
+			if (UINT8_MAX != _draw.m_streamMask)
+			{
+				for (uint32_t idx = 0, streamMask = _draw.m_streamMask
+					; 0 != streamMask
+					; streamMask >>= 1, idx += 1
+					)
+				{
+					const uint32_t ntz = bx::uint32_cnttz(streamMask);
+					streamMask >>= ntz;
+					idx         += ntz;
+
+					const Stream& stream = _draw.m_stream[idx];
+					const VertexBufferGL& vb = m_vertexBuffers[stream.m_handle.idx];
+					_key.m_layout[idx] = isValid(stream.m_layoutHandle)
+						? stream.m_layoutHandle.idx
+						: vb.m_layoutHandle.idx
+						;
+
+					if (_buffers)
+					{
+						_key.m_handle[idx]      = stream.m_handle.idx;
+						_key.m_startVertex[idx] = stream.m_startVertex;
+					}
+				}
+			}
+
+			if (isValid(_draw.m_instanceDataBuffer) )
+			{
+				_key.m_instanceDataBuffer = 0;
+
+				if (_buffers)
+				{
+					_key.m_instanceDataBuffer = _draw.m_instanceDataBuffer.idx;
+					_key.m_instanceDataOffset = _draw.m_instanceDataOffset;
+					_key.m_instanceDataStride = _draw.m_instanceDataStride;
+				}
+			}
+
+			if (_buffers)
+			{
+				_key.m_indexBuffer = _draw.m_indexBuffer.idx;
+			}
+		}
+
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
 
 		void blitSetup(TextVideoMemBlitter& _blitter) override
@@ -3548,11 +3883,8 @@ namespace bgfx { namespace gl
 			float proj[16];
 			bx::mtxOrtho(proj, 0.0f, (float)width, (float)height, 0.0f, 0.0f, 1000.0f, 0.0f, g_caps.homogeneousDepth);
 
-			setUniformMatrix4fv(program.m_predefined[0].m_loc
-				, 1
-				, GL_FALSE
-				, proj
-				);
+			setShaderUniform4x4f(0, program.m_predefined[0].m_loc, proj, 1);
+			commitUniformBlocks(program);
 
 			GL_CHECK(glActiveTexture(GL_TEXTURE0) );
 			GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_textures[_blitter.m_texture.idx].m_id) );
@@ -3653,19 +3985,245 @@ namespace bgfx { namespace gl
 
 		void setShaderUniform4f(uint8_t /*_flags*/, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
-			setUniform4fv(_regIndex
-				, _numRegs
-				, (const GLfloat*)_val
-				);
+			if (0 != (_regIndex & kUniformBlockBit) )
+			{
+				setUniformBlock(_regIndex, UniformType::Vec4, _val, _numRegs);
+			}
+			else
+			{
+				setUniform4fv(_regIndex
+					, _numRegs
+					, (const GLfloat*)_val
+					);
+			}
 		}
 
 		void setShaderUniform4x4f(uint8_t /*_flags*/, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
-			setUniformMatrix4fv(_regIndex
-				, _numRegs
-				, GL_FALSE
-				, (const GLfloat*)_val
-				);
+			if (0 != (_regIndex & kUniformBlockBit) )
+			{
+				setUniformBlock(_regIndex, UniformType::Mat4, _val, _numRegs);
+			}
+			else
+			{
+				setUniformMatrix4fv(_regIndex
+					, _numRegs
+					, GL_FALSE
+					, (const GLfloat*)_val
+					);
+			}
+		}
+
+		void setUniformBlock(uint32_t _loc, UniformType::Enum _type, const void* _val, uint32_t _num)
+		{
+			const uint32_t stage = 0 != (_loc & kUniformBlockFragmentBit) ? 1 : 0;
+			uint8_t* scratch = 0 == stage ? m_vsScratch : m_fsScratch;
+			uint8_t* dst = &scratch[_loc & kUniformBlockOffsetMask];
+
+			// Block is uploaded only when its content changes.
+			if (UniformType::Mat3 == _type)
+			{
+				// std140 pads each mat3 column to vec4.
+				const float* src = (const float*)_val;
+				for (uint32_t ii = 0, num = _num*3; ii < num; ++ii)
+				{
+					if (0 != bx::memCmp(&dst[ii*16], &src[ii*3], 3*sizeof(float) ) )
+					{
+						bx::memCopy(&dst[ii*16], &src[ii*3], 3*sizeof(float) );
+						m_uniformBlockDirty[stage] = true;
+					}
+				}
+			}
+			else
+			{
+				const uint32_t size = g_uniformTypeSize[_type]*_num;
+				if (0 != bx::memCmp(dst, _val, size) )
+				{
+					bx::memCopy(dst, _val, size);
+					m_uniformBlockDirty[stage] = true;
+				}
+			}
+		}
+
+		void fenceUniformStream()
+		{
+			if (m_uniformStreamFenceWrite - m_uniformStreamFenceRead == BX_COUNTOF(m_uniformStreamFence) )
+			{
+				waitUniformStream();
+			}
+
+			UniformStreamFence& fence = m_uniformStreamFence[m_uniformStreamFenceWrite % BX_COUNTOF(m_uniformStreamFence)];
+			fence.m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			fence.m_end  = m_uniformStreamHead;
+			++m_uniformStreamFenceWrite;
+		}
+
+		// Returns false if GPU is not done with the oldest fenced frame within timeout.
+		bool waitUniformStream(uint64_t _timeout = UINT64_MAX)
+		{
+			UniformStreamFence& fence = m_uniformStreamFence[m_uniformStreamFenceRead % BX_COUNTOF(m_uniformStreamFence)];
+
+			const GLenum result = glClientWaitSync(fence.m_sync, GL_SYNC_FLUSH_COMMANDS_BIT, _timeout);
+			BX_WARN(GL_WAIT_FAILED != result, "Uniform stream fence wait failed.");
+
+			if (GL_TIMEOUT_EXPIRED == result)
+			{
+				return false;
+			}
+
+			GL_CHECK(glDeleteSync(fence.m_sync) );
+			fence.m_sync = NULL;
+
+			m_uniformStreamTail = fence.m_end;
+			++m_uniformStreamFenceRead;
+
+			return true;
+		}
+
+		void createUniformStream(uint32_t _size)
+		{
+			GL_CHECK(glGenBuffers(1, &m_uniformStream) );
+			GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, m_uniformStream) );
+
+#if BGFX_CONFIG_RENDERER_OPENGL
+			if (s_extension[Extension::ARB_buffer_storage].m_supported
+			&&  NULL != glBufferStorage
+			&&  NULL != glMapBufferRange)
+			{
+				// Uniform blocks are written directly into persistently mapped
+				// storage, without any GL call per draw other than binding range.
+				const GLbitfield flags = GL_MAP_WRITE_BIT|GL_MAP_PERSISTENT_BIT|GL_MAP_COHERENT_BIT;
+				GL_CHECK(glBufferStorage(GL_UNIFORM_BUFFER, _size, NULL, flags) );
+				m_uniformStreamPtr = (uint8_t*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, _size, flags);
+			}
+#endif // BGFX_CONFIG_RENDERER_OPENGL
+
+			if (NULL == m_uniformStreamPtr)
+			{
+				GL_CHECK(glBufferData(GL_UNIFORM_BUFFER, _size, NULL, GL_DYNAMIC_DRAW) );
+			}
+
+			GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, 0) );
+
+			m_uniformStreamSize = _size;
+			m_uniformStreamHead = 0;
+			m_uniformStreamTail = 0;
+
+			// Ranges bound from previous buffer must be uploaded again.
+			++m_uniformStreamGen;
+		}
+
+		void destroyUniformStream()
+		{
+			if (NULL != m_uniformStreamPtr)
+			{
+				GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, m_uniformStream) );
+				GL_CHECK(glUnmapBuffer(GL_UNIFORM_BUFFER) );
+				GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, 0) );
+				m_uniformStreamPtr = NULL;
+			}
+
+			// Pending fences refer to positions in this buffer. GL keeps deleted buffer alive
+			// until draws already submitted are done reading from it.
+			for (; m_uniformStreamFenceRead != m_uniformStreamFenceWrite; ++m_uniformStreamFenceRead)
+			{
+				UniformStreamFence& fence = m_uniformStreamFence[m_uniformStreamFenceRead % BX_COUNTOF(m_uniformStreamFence)];
+				GL_CHECK(glDeleteSync(fence.m_sync) );
+				fence.m_sync = NULL;
+			}
+
+			GL_CHECK(glDeleteBuffers(1, &m_uniformStream) );
+			m_uniformStream = 0;
+		}
+
+		uint32_t allocUniformStream(uint32_t _size)
+		{
+			// Stream buffer is used as ring. Head and tail are positions that only grow, tail
+			// is position up to which GPU is done reading, as reported by frame fences.
+			const uint64_t size  = m_uniformStreamSize;
+			const uint64_t align = m_uniformStreamAlign;
+			uint64_t offset = (m_uniformStreamHead + align - 1) / align * align;
+
+			if (offset % size + _size > size)
+			{
+				// Range doesn't fit before end of buffer, wrap around. Blocks bound in
+				// previous pass over buffer must be uploaded again.
+				offset = (offset / size + 1) * size;
+				++m_uniformStreamGen;
+			}
+
+			while (offset + _size - m_uniformStreamTail > size)
+			{
+				// Reclaim ranges of frames GPU is already done with.
+				if (m_uniformStreamFenceRead != m_uniformStreamFenceWrite
+				&&  waitUniformStream(0) )
+				{
+					continue;
+				}
+
+				// Frames in flight use whole buffer, grow it instead of waiting for GPU.
+				if (size < BGFX_CONFIG_MAX_UNIFORM_STREAM_BUFFER_SIZE)
+				{
+					BX_TRACE("Uniform stream buffer grows to %d bytes.", uint32_t(size*2) );
+					destroyUniformStream();
+					createUniformStream(uint32_t(bx::min<uint64_t>(size*2, BGFX_CONFIG_MAX_UNIFORM_STREAM_BUFFER_SIZE) ) );
+					return allocUniformStream(_size);
+				}
+
+				if (m_uniformStreamFenceRead == m_uniformStreamFenceWrite)
+				{
+					// Current frame alone filled whole buffer.
+					fenceUniformStream();
+				}
+
+				waitUniformStream();
+			}
+
+			m_uniformStreamHead = offset + _size;
+
+			return uint32_t(offset % size);
+		}
+
+		void commitUniformBlocks(const ProgramGL& _program)
+		{
+			const ShaderGL* shaders[] = { _program.m_vsh, _program.m_fsh };
+			const uint8_t*  scratch[] = { m_vsScratch,    m_fsScratch    };
+
+			bool bound = false;
+
+			for (uint32_t ii = 0; ii < BX_COUNTOF(shaders); ++ii)
+			{
+				const ShaderGL* shader = shaders[ii];
+
+				// Range bound to block binding stays valid until block content changes, until
+				// program with different block size is used, or until ring wraps around.
+				if (NULL != shader
+				&&  0 != shader->m_size
+				&&  (m_uniformBlockDirty[ii] || m_uniformBlockSize[ii] != shader->m_size || m_uniformBlockGen[ii] != m_uniformStreamGen) )
+				{
+					const uint32_t offset = allocUniformStream(shader->m_size);
+
+					if (NULL != m_uniformStreamPtr)
+					{
+						bx::memCopy(&m_uniformStreamPtr[offset], scratch[ii], shader->m_size);
+					}
+					else
+					{
+						if (!bound)
+						{
+							GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, m_uniformStream) );
+							bound = true;
+						}
+
+						GL_CHECK(glBufferSubData(GL_UNIFORM_BUFFER, offset, shader->m_size, scratch[ii]) );
+					}
+
+					GL_CHECK(glBindBufferRange(GL_UNIFORM_BUFFER, ii, m_uniformStream, offset, shader->m_size) );
+					m_uniformBlockDirty[ii] = false;
+					m_uniformBlockSize[ii]  = shader->m_size;
+					m_uniformBlockGen[ii]   = m_uniformStreamGen;
+				}
+			}
 		}
 
 		uint32_t setFrameBuffer(FrameBufferHandle _fbh, uint32_t _height, uint16_t _discard = BGFX_CLEAR_NONE, bool _msaa = true)
@@ -3862,7 +4420,7 @@ namespace bgfx { namespace gl
 			}
 		}
 
-		void setSamplerState(uint32_t _stage, uint32_t _numMips, uint32_t _flags, const float _rgba[4])
+		void setSamplerState(uint32_t _stage, uint32_t _numMips, uint8_t _minLod, uint32_t _flags, const float _rgba[4])
 		{
 			if ( (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL) || BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES >= 30) )
 			&&  m_samplerObjectSupport)
@@ -3883,6 +4441,7 @@ namespace bgfx { namespace gl
 
 					murmur.begin();
 					murmur.add(_flags);
+					murmur.add(_minLod);
 					if (!needBorderColor(_flags) )
 					{
 						murmur.add(-1);
@@ -3934,6 +4493,8 @@ namespace bgfx { namespace gl
 							GL_CHECK(glSamplerParameterf(sampler, GL_TEXTURE_LOD_BIAS, float(BGFX_CONFIG_MIP_LOD_BIAS) ) );
 						}
 
+						GL_CHECK(glSamplerParameterf(sampler, GL_TEXTURE_MIN_LOD, float(_minLod) ) );
+
 						if (m_borderColorSupport
 						&&  hasBorderColor)
 						{
@@ -4090,6 +4651,26 @@ namespace bgfx { namespace gl
 			}
 		}
 
+		void commit(const ProgramGL& _program)
+		{
+			if (NULL != _program.m_constantBuffer)
+			{
+				commit(*_program.m_constantBuffer);
+			}
+
+			if (NULL != _program.m_vsh
+			&&  NULL != _program.m_vsh->m_constantBuffer)
+			{
+				commit(*_program.m_vsh->m_constantBuffer);
+			}
+
+			if (NULL != _program.m_fsh
+			&&  NULL != _program.m_fsh->m_constantBuffer)
+			{
+				commit(*_program.m_fsh->m_constantBuffer);
+			}
+		}
+
 		void commit(UniformBuffer& _uniformBuffer)
 		{
 			_uniformBuffer.reset();
@@ -4123,6 +4704,12 @@ namespace bgfx { namespace gl
 
 				uint32_t loc = _uniformBuffer.read();
 
+				if (0 != (loc & kUniformBlockBit) )
+				{
+					setUniformBlock(loc, type, data, num);
+					continue;
+				}
+
 #define CASE_IMPLEMENT_UNIFORM(_uniform, _glsuffix, _dxsuffix, _type) \
 		case UniformType::_uniform: \
 				{ \
@@ -4326,7 +4913,8 @@ namespace bgfx { namespace gl
 
 				updateUniform(m_clearQuadColor.idx, mrtClearColor[0], numMrt * sizeof(float) * 4);
 
-				commit(*program.m_constantBuffer);
+				commit(program);
+				commitUniformBlocks(program);
 
 				GL_CHECK(glDrawArrays(GL_TRIANGLE_STRIP
 					, 0
@@ -4441,8 +5029,10 @@ namespace bgfx { namespace gl
 
 		TimerQueryGL m_gpuTimer;
 		OcclusionQueryGL m_occlusionQuery;
+		ReadBackGL m_readBack;
 
 		SamplerStateCache m_samplerStateCache;
+		VertexArrayCache m_vertexArrayCache;
 		UniformStateCache m_uniformStateCache;
 
 		TextVideoMem m_textVideoMem;
@@ -4462,7 +5052,10 @@ namespace bgfx { namespace gl
 		bool m_blitSupported;
 		bool m_readBackSupported;
 		bool m_vaoSupport;
+		bool m_vertexAttribBindingSupport;
 		bool m_samplerObjectSupport;
+		bool m_uniformBufferSupport;
+		bool m_readBackAsyncSupport;
 		bool m_shadowSamplersSupport;
 		bool m_srgbWriteControlSupport;
 		bool m_borderColorSupport;
@@ -4474,6 +5067,7 @@ namespace bgfx { namespace gl
 		bool m_atocSupport;
 		bool m_conservativeRasterSupport;
 		bool m_imageLoadStoreSupport;
+		bool m_bindlessSupport;
 		bool m_flip;
 
 		uint64_t m_hash;
@@ -4482,6 +5076,32 @@ namespace bgfx { namespace gl
 		GLuint m_backBufferFbo;
 		GLuint m_msaaBackBufferFbo;
 		GLuint m_msaaBackBufferRbos[2];
+		struct UniformStreamFence
+		{
+			GLsync   m_sync;
+			uint64_t m_end;
+		};
+
+		GLuint   m_uniformStream;
+		uint8_t* m_uniformStreamPtr;
+		uint32_t m_uniformStreamSize;
+		uint64_t m_uniformStreamHead;
+		uint64_t m_uniformStreamTail;
+		uint32_t m_uniformStreamAlign;
+		uint32_t m_uniformStreamGen;
+		UniformStreamFence m_uniformStreamFence[BGFX_CONFIG_MAX_FRAME_LATENCY+2];
+		uint32_t m_uniformStreamFenceRead;
+		uint32_t m_uniformStreamFenceWrite;
+		uint32_t m_uniformBlockGen[2];
+		uint32_t m_uniformBlockSize[2];
+		bool     m_uniformBlockDirty[2];
+		uint32_t m_maxUniformBlockSize;
+		GLuint m_bindlessBuffer;
+		uint32_t m_bindlessDirtyBegin;
+		uint32_t m_bindlessDirtyEnd;
+		uint64_t m_bindlessHandle[BGFX_CONFIG_MAX_BINDLESS_TEXTURES];
+		uint8_t m_vsScratch[64<<10];
+		uint8_t m_fsScratch[64<<10];
 		GlContext m_glctx;
 		bool m_needPresent;
 
@@ -4739,6 +5359,9 @@ namespace bgfx { namespace gl
 			s_renderGL->programCache(m_id, id);
 		}
 
+		m_vsh = &_vsh;
+		m_fsh = 0 != _fsh.m_id ? &_fsh : NULL;
+
 		init();
 
 		if (!cached
@@ -4763,6 +5386,8 @@ namespace bgfx { namespace gl
 			m_constantBuffer = NULL;
 		}
 		m_numPredefined = 0;
+		m_vsh = NULL;
+		m_fsh = NULL;
 
 		if (0 != m_id)
 		{
@@ -4891,6 +5516,12 @@ namespace bgfx { namespace gl
 				loc = glGetUniformLocation(m_id, name);
 			}
 
+			if (-1 == loc)
+			{
+				// Uniform block member, it's set via shader's uniform block.
+				continue;
+			}
+
 			num = bx::uint32_max(num, 1);
 
 			int32_t offset = 0;
@@ -5005,6 +5636,27 @@ namespace bgfx { namespace gl
 			m_constantBuffer->finish();
 		}
 
+		const ShaderGL* shaders[] = { m_vsh, m_fsh };
+		for (uint32_t ii = 0; ii < BX_COUNTOF(shaders); ++ii)
+		{
+			const ShaderGL* shader = shaders[ii];
+
+			if (NULL != shader
+			&&  0 != shader->m_size)
+			{
+				bx::memCopy(&m_predefined[m_numPredefined], shader->m_predefined, shader->m_numPredefined*sizeof(PredefinedUniform) );
+				m_numPredefined += shader->m_numPredefined;
+
+				const GLuint index = glGetUniformBlockIndex(m_id, 0 == ii ? "bgfx_VertexUniforms" : "bgfx_FragmentUniforms");
+				if (GL_INVALID_INDEX != index)
+				{
+					GL_CHECK(glUniformBlockBinding(m_id, index, ii) );
+				}
+
+				BX_TRACE("Uniform block %d: size %d, predefined %d", ii, shader->m_size, shader->m_numPredefined);
+			}
+		}
+
 		if (piqSupported)
 		{
 			struct VariableInfo
@@ -5126,6 +5778,51 @@ namespace bgfx { namespace gl
 		applyLazyEnabledVertexAttributes();
 	}
 
+	void ProgramGL::bindAttributesFormat(const VertexLayout& _layout, uint8_t _binding)
+	{
+		for (uint32_t ii = 0, iiEnd = m_usedCount; ii < iiEnd; ++ii)
+		{
+			Attrib::Enum attr = Attrib::Enum(m_used[ii]);
+			GLint loc = m_attributes[attr];
+
+			uint8_t num;
+			AttribType::Enum type;
+			bool normalized;
+			bool asInt;
+			_layout.decode(attr, num, type, normalized, asInt);
+
+			if (-1 != loc
+			&&  UINT16_MAX != _layout.m_attributes[attr])
+			{
+				GL_CHECK(glEnableVertexAttribArray(loc) );
+
+				if ( (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL >= 30) ||  BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES >= 31) )
+				&& (AttribType::Uint8 == type || AttribType::Int16 == type)
+				&&  !normalized)
+				{
+					GL_CHECK(glVertexAttribIFormat(loc
+						, num
+						, s_attribType[type]
+						, _layout.m_offset[attr]
+						) );
+				}
+				else
+				{
+					GL_CHECK(glVertexAttribFormat(loc
+						, num
+						, s_attribType[type]
+						, normalized
+						, _layout.m_offset[attr]
+						) );
+				}
+
+				GL_CHECK(glVertexAttribBinding(loc, _binding) );
+
+				m_unboundUsedAttrib[ii] = Attrib::Count;
+			}
+		}
+	}
+
 	void ProgramGL::unbindAttributes()
 	{
 		for(uint32_t ii = 0, iiEnd = m_usedCount; ii < iiEnd; ++ii)
@@ -5152,6 +5849,19 @@ namespace bgfx { namespace gl
 		}
 	}
 
+	void ProgramGL::bindInstanceDataFormat(uint8_t _binding) const
+	{
+		uint32_t offset = 0;
+		for (uint32_t ii = 0; 0xffff != m_instanceData[ii]; ++ii)
+		{
+			GLint loc = m_instanceData[ii];
+			GL_CHECK(glEnableVertexAttribArray(loc) );
+			GL_CHECK(glVertexAttribFormat(loc, 4, GL_FLOAT, GL_FALSE, offset) );
+			GL_CHECK(glVertexAttribBinding(loc, _binding) );
+			offset += 16;
+		}
+	}
+
 	void ProgramGL::unbindInstanceData() const
 	{
 		for(uint32_t ii = 0; 0xffff != m_instanceData[ii]; ++ii)
@@ -5177,6 +5887,7 @@ namespace bgfx { namespace gl
 	{
 		m_target  = _target;
 		m_numMips = _numMips;
+		m_minLod  = 0;
 		m_flags   = _flags;
 		m_width   = _width;
 		m_height  = _height;
@@ -5724,6 +6435,7 @@ namespace bgfx { namespace gl
 		bx::HashMurmur2A murmur;
 		murmur.begin();
 		murmur.add(flags);
+		murmur.add(m_minLod);
 		if (NULL != _rgba)
 		{
 			if (BGFX_SAMPLER_U_BORDER == (flags & BGFX_SAMPLER_U_BORDER)
@@ -5767,92 +6479,309 @@ namespace bgfx { namespace gl
 				GL_CHECK(glTexParameterf(target, GL_TEXTURE_LOD_BIAS, float(BGFX_CONFIG_MIP_LOD_BIAS) ) );
 			}
 
+			if (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL || BGFX_CONFIG_RENDERER_OPENGLES >= 30) )
+			{
+				GL_CHECK(glTexParameterf(target, GL_TEXTURE_MIN_LOD, float(m_minLod) ) );
+			}
+
 			if (s_renderGL->m_borderColorSupport
 			&&  hasBorderColor)
 			{
 				GL_CHECK(glTexParameterfv(target, GL_TEXTURE_BORDER_COLOR, _rgba) );
 			}
 
-			if (0 != (flags & (BGFX_SAMPLER_MIN_ANISOTROPIC|BGFX_SAMPLER_MAG_ANISOTROPIC) )
-			&&  0.0f < s_renderGL->m_maxAnisotropy)
+			if (0 != (flags & (BGFX_SAMPLER_MIN_ANISOTROPIC|BGFX_SAMPLER_MAG_ANISOTROPIC) )
+			&&  0.0f < s_renderGL->m_maxAnisotropy)
+			{
+				GL_CHECK(glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY_EXT, s_renderGL->m_maxAnisotropy) );
+			}
+
+			if (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+			||  s_renderGL->m_shadowSamplersSupport)
+			{
+				const uint32_t cmpFunc = (flags&BGFX_SAMPLER_COMPARE_MASK)>>BGFX_SAMPLER_COMPARE_SHIFT;
+				if (0 == cmpFunc)
+				{
+					GL_CHECK(glTexParameteri(target, GL_TEXTURE_COMPARE_MODE, GL_NONE) );
+				}
+				else
+				{
+					GL_CHECK(glTexParameteri(target, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE) );
+					GL_CHECK(glTexParameteri(target, GL_TEXTURE_COMPARE_FUNC, s_cmpFunc[cmpFunc]) );
+				}
+			}
+
+			m_currentSamplerHash = hash;
+		}
+	}
+
+	void TextureGL::commit(uint32_t _stage, uint32_t _flags, const float _palette[][4])
+	{
+		const uint32_t flags = 0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & _flags)
+			? _flags
+			: uint32_t(m_flags)
+			;
+		const uint32_t index = (flags & BGFX_SAMPLER_BORDER_COLOR_MASK) >> BGFX_SAMPLER_BORDER_COLOR_SHIFT;
+
+		GL_CHECK(glActiveTexture(GL_TEXTURE0+_stage) );
+		GL_CHECK(glBindTexture(m_target, m_id) );
+
+		if (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES)
+		&&  BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES < 30) )
+		{
+			// GLES2 doesn't have support for sampler object.
+			setSamplerState(flags, _palette[index]);
+		}
+		else if (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL)
+			 &&  BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL < 31) )
+		{
+			// In case that GL 2.1 sampler object is supported via extension.
+			if (s_renderGL->m_samplerObjectSupport)
+			{
+				s_renderGL->setSamplerState(_stage, m_numMips, m_minLod, flags, _palette[index]);
+			}
+			else
+			{
+				setSamplerState(flags, _palette[index]);
+			}
+		}
+		else
+		{
+			// Everything else has sampler object.
+			s_renderGL->setSamplerState(_stage, m_numMips, m_minLod, flags, _palette[index]);
+		}
+	}
+
+	void TextureGL::resolve(uint8_t _resolve) const
+	{
+		const bool renderTarget = 0 != (m_flags&BGFX_TEXTURE_RT_MASK);
+		if (renderTarget
+		&&  1 < m_numMips
+		&&  0 != (_resolve & BGFX_RESOLVE_AUTO_GEN_MIPS) )
+		{
+			GL_CHECK(glBindTexture(m_target, m_id) );
+			GL_CHECK(glGenerateMipmap(m_target) );
+			GL_CHECK(glBindTexture(m_target, 0) );
+		}
+	}
+
+	void strins(char* _str, const char* _insert)
+	{
+		size_t len = bx::strLen(_insert);
+		bx::memMove(&_str[len], _str, bx::strLen(_str)+1);
+		bx::memCopy(_str, _insert, len);
+	}
+
+	struct UniformBlockMember
+	{
+		bx::StringView    m_name;
+		bx::StringView    m_decl;
+		UniformType::Enum m_type;
+		uint16_t          m_num;
+		uint16_t          m_offset;
+	};
+
+	static bx::StringView findUniformDecl(const bx::StringView& _code, const bx::StringView& _name)
+	{
+		for (bx::StringView ident = bx::findIdentifierMatch(_code, _name)
+			; !ident.isEmpty()
+			; ident = bx::findIdentifierMatch(bx::StringView(ident.getTerm(), _code.getTerm() ), _name)
+			)
+		{
+			const char* bol = ident.getPtr();
+			while (bol > _code.getPtr()
+			&&     '\n' != bol[-1])
+			{
+				--bol;
+			}
+
+			const bx::StringView line = bx::strLTrimSpace(bx::StringView(bol, _code.getTerm() ) );
+			if (0 == bx::strCmp(line, "uniform ", 8) )
+			{
+				const bx::StringView eol = bx::strFind(bx::StringView(ident.getTerm(), _code.getTerm() ), ';');
+				if (!eol.isEmpty() )
+				{
+					return bx::StringView(line.getPtr(), eol.getTerm() );
+				}
+			}
+		}
+
+		return bx::StringView();
+	}
+
+	static bool supportsUniformBlock(const bx::StringView& _code)
+	{
+		const bx::StringView version = bx::strFind(_code, "#version");
+		if (version.isEmpty() )
+		{
+			return false;
+		}
+
+		const bx::StringView eol  = bx::strFindEol(bx::StringView(version.getTerm(), _code.getTerm() ) );
+		const bx::StringView line = bx::strLTrimSpace(bx::StringView(version.getTerm(), eol.getPtr() ) );
+
+		int32_t ver = 0;
+		if (!bx::fromString(&ver, line) )
+		{
+			return false;
+		}
+
+		// Uniform blocks with std140 layout are available from GLSL 1.40 and ESSL 3.00.
+		const bool essl = !bx::findIdentifierMatch(line, "es").isEmpty();
+		return essl ? 300 <= ver : 140 <= ver;
+	}
+
+	static bool createUniformBlock(ShaderGL& _shader, char* _temp, int32_t _tempLen, const bx::StringView& _code, UniformBlockMember* _members, uint16_t _numMembers)
+	{
+		// Move non-sampler uniforms into std140 block. Members are renamed per stage since
+		// vertex and fragment shader might declare the same uniform, and block members share
+		// program global namespace.
+		uint32_t blockSize = 0;
+		const char* insert = _code.getTerm();
+
+		for (uint16_t ii = 0; ii < _numMembers; ++ii)
+		{
+			UniformBlockMember& member = _members[ii];
+			member.m_decl = findUniformDecl(_code, member.m_name);
+
+			const char* typeName = UniformType::Vec4 == member.m_type ? "vec4"
+				: UniformType::Mat3 == member.m_type ? "mat3"
+				: "mat4"
+				;
+
+			if (member.m_decl.isEmpty()
+			||  bx::findIdentifierMatch(member.m_decl, typeName).isEmpty()
+			|| !bx::strFind(member.m_decl, ',').isEmpty() )
 			{
-				GL_CHECK(glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY_EXT, s_renderGL->m_maxAnisotropy) );
+				BX_TRACE("Uniform '%.*s' declaration not found, uniform block is not used."
+					, member.m_name.getLength()
+					, member.m_name.getPtr()
+					);
+				return false;
 			}
 
-			if (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES >= 30)
-			||  s_renderGL->m_shadowSamplersSupport)
+			insert = bx::min(insert, member.m_decl.getPtr() );
+
+			const uint32_t stride = UniformType::Mat3 == member.m_type ? 48 : g_uniformTypeSize[member.m_type];
+			member.m_offset = uint16_t(blockSize);
+			blockSize += stride*member.m_num;
+		}
+
+		if (blockSize > s_renderGL->m_maxUniformBlockSize
+		||  blockSize > kUniformBlockOffsetMask)
+		{
+			BX_TRACE("Uniform block size %d is over limit, uniform block is not used.", blockSize);
+			return false;
+		}
+
+		// Block is declared in place of the first uniform declaration, which is after all
+		// #extension directives and precision statements.
+		for (bx::StringView extension = bx::strFind(_code, "#extension")
+			; !extension.isEmpty()
+			; extension = bx::strFind(bx::StringView(extension.getTerm(), _code.getTerm() ), "#extension")
+			)
+		{
+			if (extension.getPtr() > insert)
 			{
-				const uint32_t cmpFunc = (flags&BGFX_SAMPLER_COMPARE_MASK)>>BGFX_SAMPLER_COMPARE_SHIFT;
-				if (0 == cmpFunc)
-				{
-					GL_CHECK(glTexParameteri(target, GL_TEXTURE_COMPARE_MODE, GL_NONE) );
-				}
-				else
-				{
-					GL_CHECK(glTexParameteri(target, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE) );
-					GL_CHECK(glTexParameteri(target, GL_TEXTURE_COMPARE_FUNC, s_cmpFunc[cmpFunc]) );
-				}
+				BX_TRACE("Uniform declared before #extension directive, uniform block is not used.");
+				return false;
 			}
+		}
 
-			m_currentSamplerHash = hash;
+		bx::StaticMemoryBlockWriter writer(_temp, _tempLen);
+		bx::Error err;
+
+		bx::write(&writer, _code.getPtr(), int32_t(insert - _code.getPtr() ), &err);
+
+		const char stage = GL_FRAGMENT_SHADER == _shader.m_type ? 'f' : 'v';
+
+		for (uint16_t ii = 0; ii < _numMembers; ++ii)
+		{
+			const bx::StringView& name = _members[ii].m_name;
+			bx::write(&writer, &err, "#define %.*s bgfx_%c_%.*s\n"
+				, name.getLength(), name.getPtr()
+				, stage
+				, name.getLength(), name.getPtr()
+				);
 		}
-	}
 
-	void TextureGL::commit(uint32_t _stage, uint32_t _flags, const float _palette[][4])
-	{
-		const uint32_t flags = 0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & _flags)
-			? _flags
-			: uint32_t(m_flags)
-			;
-		const uint32_t index = (flags & BGFX_SAMPLER_BORDER_COLOR_MASK) >> BGFX_SAMPLER_BORDER_COLOR_SHIFT;
+		bx::write(&writer, &err, "layout(std140) uniform %s\n{\n"
+			, GL_FRAGMENT_SHADER == _shader.m_type ? "bgfx_FragmentUniforms" : "bgfx_VertexUniforms"
+			);
 
-		GL_CHECK(glActiveTexture(GL_TEXTURE0+_stage) );
-		GL_CHECK(glBindTexture(m_target, m_id) );
+		const int32_t uniformLen = bx::strLen("uniform");
 
-		if (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES)
-		&&  BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES < 30) )
+		for (uint16_t ii = 0; ii < _numMembers; ++ii)
 		{
-			// GLES2 doesn't have support for sampler object.
-			setSamplerState(flags, _palette[index]);
+			const bx::StringView& decl = _members[ii].m_decl;
+			bx::write(&writer, "\t");
+			bx::write(&writer, decl.getPtr() + uniformLen, decl.getLength() - uniformLen);
+			bx::write(&writer, "\n");
 		}
-		else if (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL)
-			 &&  BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL < 31) )
+
+		bx::write(&writer, "};\n");
+
+		const int64_t codePos = bx::seek(&writer, 0, bx::Whence::Current) - (insert - _code.getPtr() );
+
+		bx::write(&writer, insert, int32_t(_code.getTerm() - insert), &err);
+		bx::write(&writer, '\0', &err);
+
+		if (!err.isOk() )
 		{
-			// In case that GL 2.1 sampler object is supported via extension.
-			if (s_renderGL->m_samplerObjectSupport)
+			BX_TRACE("Uniform block doesn't fit into temporary buffer, uniform block is not used.");
+			return false;
+		}
+
+		const uint32_t stageBit = GL_FRAGMENT_SHADER == _shader.m_type ? kUniformBlockFragmentBit : 0;
+
+		for (uint16_t ii = 0; ii < _numMembers; ++ii)
+		{
+			const UniformBlockMember& member = _members[ii];
+
+			// Blank original declaration, it's declared inside block now.
+			bx::memSet(&_temp[codePos + (member.m_decl.getPtr() - _code.getPtr() )], ' ', member.m_decl.getLength() );
+
+			char name[256];
+			bx::strCopy(name, BX_COUNTOF(name), member.m_name);
+
+			const uint32_t loc = kUniformBlockBit | stageBit | member.m_offset;
+
+			PredefinedUniform::Enum predefined = nameToPredefinedUniformEnum(name);
+			if (PredefinedUniform::Count != predefined)
 			{
-				s_renderGL->setSamplerState(_stage, m_numMips, flags, _palette[index]);
+				_shader.m_predefined[_shader.m_numPredefined].m_loc   = loc;
+				_shader.m_predefined[_shader.m_numPredefined].m_count = member.m_num;
+				_shader.m_predefined[_shader.m_numPredefined].m_type  = uint8_t(predefined);
+				_shader.m_numPredefined++;
 			}
 			else
 			{
-				setSamplerState(flags, _palette[index]);
+				const UniformRegInfo* info = s_renderGL->m_uniformReg.find(name);
+				BX_WARN(NULL != info, "User defined uniform '%s' is not found, it won't be set.", name);
+
+				if (NULL != info)
+				{
+					if (NULL == _shader.m_constantBuffer)
+					{
+						_shader.m_constantBuffer = UniformBuffer::create(1024);
+					}
+
+					_shader.m_constantBuffer->writeUniformHandle(member.m_type, 0, info->m_handle, member.m_num);
+					_shader.m_constantBuffer->write(loc);
+				}
 			}
+
+			BX_TRACE("\tblock %c %s, offset %d, num %d", stage, name, member.m_offset, member.m_num);
 		}
-		else
-		{
-			// Everything else has sampler object.
-			s_renderGL->setSamplerState(_stage, m_numMips, flags, _palette[index]);
-		}
-	}
 
-	void TextureGL::resolve(uint8_t _resolve) const
-	{
-		const bool renderTarget = 0 != (m_flags&BGFX_TEXTURE_RT_MASK);
-		if (renderTarget
-		&&  1 < m_numMips
-		&&  0 != (_resolve & BGFX_RESOLVE_AUTO_GEN_MIPS) )
+		if (NULL != _shader.m_constantBuffer)
 		{
-			GL_CHECK(glBindTexture(m_target, m_id) );
-			GL_CHECK(glGenerateMipmap(m_target) );
-			GL_CHECK(glBindTexture(m_target, 0) );
+			_shader.m_constantBuffer->finish();
 		}
-	}
 
-	void strins(char* _str, const char* _insert)
-	{
-		size_t len = bx::strLen(_insert);
-		bx::memMove(&_str[len], _str, bx::strLen(_str)+1);
-		bx::memCopy(_str, _insert, len);
+		_shader.m_size = uint16_t(blockSize);
+
+		return true;
 	}
 
 	void ShaderGL::create(const Memory* _mem)
@@ -5898,11 +6827,22 @@ namespace bgfx { namespace gl
 			, count
 			);
 
+		const bool uniformBlock = true
+			&& s_renderGL->m_uniformBufferSupport
+			&& GL_COMPUTE_SHADER != m_type
+			;
+
+		UniformBlockMember* members = (UniformBlockMember*)alloca(bx::max<uint32_t>(count, 1)*sizeof(UniformBlockMember) );
+		uint16_t numMembers = 0;
+		int32_t  membersLen = 0;
+
 		for (uint32_t ii = 0; ii < count; ++ii)
 		{
 			uint8_t nameSize = 0;
 			bx::read(&reader, nameSize);
 
+			const char* namePtr = (const char*)reader.getDataPtr();
+
 			char name[256];
 			bx::read(&reader, &name, nameSize);
 			name[nameSize] = '\0';
@@ -5930,6 +6870,21 @@ namespace bgfx { namespace gl
 				uint16_t texFormat = 0;
 				bx::read(&reader, texFormat);
 			}
+
+			const UniformType::Enum uniformType = UniformType::Enum(type & ~kUniformMask);
+
+			if (uniformBlock
+			&&  0 == (kUniformSamplerBit & type)
+			&&  (UniformType::Vec4 == uniformType || UniformType::Mat3 == uniformType || UniformType::Mat4 == uniformType) )
+			{
+				UniformBlockMember& member = members[numMembers++];
+				member.m_name   = bx::StringView(namePtr, nameSize);
+				member.m_decl   = bx::StringView();
+				member.m_type   = uniformType;
+				member.m_num    = bx::max<uint16_t>(num, 1);
+				member.m_offset = 0;
+				membersLen += 2*nameSize + 32;
+			}
 		}
 
 		uint32_t shaderSize;
@@ -6441,7 +7396,7 @@ namespace bgfx { namespace gl
 							);
 					}
 
-					bx::write(&writer, code.getPtr(), code.getLength() );
+					bx::write(&writer, code);
 					bx::write(&writer, '\0');
 				}
 
@@ -6474,6 +7429,18 @@ namespace bgfx { namespace gl
 				code = temp;
 			}
 
+			if (0 != numMembers
+			&&  supportsUniformBlock(code) )
+			{
+				int32_t tempLen = code.getLength() + membersLen + (1<<10);
+				char* temp = (char*)alloca(tempLen);
+
+				if (createUniformBlock(*this, temp, tempLen, code, members, numMembers) )
+				{
+					code.set(temp);
+				}
+			}
+
 			{
 				const GLchar* str = (const GLchar*)code.getPtr();
 				int32_t len = code.getLength();
@@ -6520,6 +7487,14 @@ namespace bgfx { namespace gl
 
 	void ShaderGL::destroy()
 	{
+		if (NULL != m_constantBuffer)
+		{
+			UniformBuffer::destroy(m_constantBuffer);
+			m_constantBuffer = NULL;
+		}
+		m_numPredefined = 0;
+		m_size = 0;
+
 		if (0 != m_id)
 		{
 			GL_CHECK(glDeleteShader(m_id) );
@@ -6960,6 +7935,108 @@ namespace bgfx { namespace gl
 		}
 	}
 
+	void ReadBackGL::create()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_query); ++ii)
+		{
+			Query& query = m_query[ii];
+			GL_CHECK(glGenBuffers(1, &query.m_pbo) );
+			query.m_sync = NULL;
+			query.m_data     = NULL;
+			query.m_size     = 0;
+			query.m_capacity = 0;
+		}
+	}
+
+	void ReadBackGL::destroy()
+	{
+		resolve(true);
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_query); ++ii)
+		{
+			Query& query = m_query[ii];
+			GL_CHECK(glDeleteBuffers(1, &query.m_pbo) );
+		}
+	}
+
+	void ReadBackGL::begin(void* _data, uint32_t _size)
+	{
+		while (0 == m_control.reserve(1) )
+		{
+			resolve(true);
+		}
+
+		Query& query = m_query[m_control.m_current];
+		query.m_data  = _data;
+		query.m_size  = _size;
+		query.m_frame = m_frame;
+
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, query.m_pbo) );
+
+		if (query.m_capacity < _size)
+		{
+			GL_CHECK(glBufferData(GL_PIXEL_PACK_BUFFER, _size, NULL, GL_STREAM_READ) );
+			query.m_capacity = _size;
+		}
+	}
+
+	void ReadBackGL::end()
+	{
+		Query& query = m_query[m_control.m_current];
+		query.m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+		m_control.commit(1);
+	}
+
+	void ReadBackGL::resolve(bool _wait)
+	{
+		while (0 != m_control.available() )
+		{
+			Query& query = m_query[m_control.m_read];
+
+			// Don't let read back slip more than configured number of frames behind, so that
+			// frame number returned by bgfx::readTexture stays valid.
+			const bool wait = _wait
+				|| m_frame - query.m_frame >= BGFX_CONFIG_TEXTURE_READ_BACK_LATENCY
+				;
+
+			const GLenum result = glClientWaitSync(query.m_sync
+				, GL_SYNC_FLUSH_COMMANDS_BIT
+				, wait ? UINT64_MAX : 0
+				);
+
+			if (GL_TIMEOUT_EXPIRED == result)
+			{
+				break;
+			}
+
+			BX_WARN(GL_WAIT_FAILED != result, "Texture read back fence wait failed.");
+
+			GL_CHECK(glDeleteSync(query.m_sync) );
+			query.m_sync = NULL;
+
+			GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, query.m_pbo) );
+
+			const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, query.m_size, GL_MAP_READ_BIT);
+			if (NULL != data)
+			{
+				bx::memCopy(query.m_data, data, query.m_size);
+				GL_CHECK(glUnmapBuffer(GL_PIXEL_PACK_BUFFER) );
+			}
+
+			GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+
+			m_control.consume(1);
+		}
+	}
+
+	void ReadBackGL::update()
+	{
+		++m_frame;
+		resolve();
+	}
+
 	void RendererContextGL::submitBlit(BlitState& _bs, uint16_t _view)
 	{
 		if (m_blitSupported)
@@ -7052,9 +8129,11 @@ namespace bgfx { namespace gl
 		&&  m_vaoSupport)
 		{
 			m_vaoSupport = false;
+			m_vertexAttribBindingSupport = false;
 			GL_CHECK(glBindVertexArray(0) );
 			GL_CHECK(glDeleteVertexArrays(1, &m_vao) );
 			m_vao = 0;
+			m_vertexArrayCache.invalidate();
 		}
 
 		const GLuint defaultVao = m_vao;
@@ -7093,6 +8172,11 @@ namespace bgfx { namespace gl
 			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
 		}
 
+		if (m_bindlessSupport)
+		{
+			updateBindless();
+		}
+
 		_render->sort();
 
 		RenderDraw currentState;
@@ -7108,6 +8192,18 @@ namespace bgfx { namespace gl
 
 		ProgramHandle currentProgram = BGFX_INVALID_HANDLE;
 		ProgramHandle boundProgram   = BGFX_INVALID_HANDLE;
+
+		// Without vertex attribute binding, vertex array objects are cached per program,
+		// stream and index buffer combination. Transient buffers are orphaned every frame
+		// and keep using default vertex array object.
+		const bool vertexArrayCache = m_vaoSupport && !m_vertexAttribBindingSupport;
+		const uint16_t transientVb  = _render->m_transientVb->handle.idx;
+		const uint16_t transientIb  = _render->m_transientIb->handle.idx;
+		GLuint boundVao = defaultVao;
+
+		VertexArrayKey boundFormat;
+		boundFormat.clear();
+
 		SortKey key;
 		uint16_t view = UINT16_MAX;
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
@@ -7161,6 +8257,11 @@ namespace bgfx { namespace gl
 			m_occlusionQuery.resolve(_render);
 		}
 
+		if (m_readBackAsyncSupport)
+		{
+			m_readBack.update();
+		}
+
 		if (0 == (_render->m_debug&BGFX_DEBUG_IFH) )
 		{
 			GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_msaaBackBufferFbo) );
@@ -7226,6 +8327,8 @@ namespace bgfx { namespace gl
 					if (BGFX_CLEAR_NONE != (clear.m_flags & BGFX_CLEAR_MASK) )
 					{
 						clearQuad(_clearQuad, viewState.m_rect, clear, resolutionHeight, _render->m_colorPalette);
+						boundVao = defaultVao;
+						boundFormat.clear();
 					}
 
 					GL_CHECK(glDisable(GL_STENCIL_TEST) );
@@ -7740,9 +8843,8 @@ namespace bgfx { namespace gl
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
+				bool constantsChanged = rendererUpdateUniforms(this, _render, draw);
 				bool bindAttribs = false;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
 				if (key.m_program.idx != currentProgram.idx)
 				{
@@ -7762,13 +8864,13 @@ namespace bgfx { namespace gl
 				{
 					ProgramGL& program = m_program[currentProgram.idx];
 
-					if (constantsChanged
-					&&  NULL != program.m_constantBuffer)
+					if (constantsChanged)
 					{
-						commit(*program.m_constantBuffer);
+						commit(program);
 					}
 
 					viewState.setPredefined<1>(this, view, program, _render, draw);
+					commitUniformBlocks(program);
 
 					{
 						GLbitfield barrier = 0;
@@ -7874,7 +8976,12 @@ namespace bgfx { namespace gl
 						{
 							currentState.m_indexBuffer = draw.m_indexBuffer;
 
-							if (isValid(draw.m_indexBuffer) )
+							if (vertexArrayCache)
+							{
+								// Index buffer binding is part of vertex array object state.
+								bindAttribs = true;
+							}
+							else if (isValid(draw.m_indexBuffer) )
 							{
 								IndexBufferGL& ib = m_indexBuffers[draw.m_indexBuffer.idx];
 								GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ib.m_id) );
@@ -7890,19 +8997,52 @@ namespace bgfx { namespace gl
 							currentState.m_startIndex = draw.m_startIndex;
 						}
 
-						if (0 != currentState.m_streamMask)
+						if (0 != currentState.m_streamMask
+						&&  bindAttribs)
 						{
-							if (bindAttribs)
+							if (m_vertexAttribBindingSupport)
 							{
-								if (isValid(boundProgram) )
+								VertexArrayKey format;
+								getVertexArrayKey(format, draw, currentProgram, false);
+
+								if (format != boundFormat)
 								{
-									m_program[boundProgram.idx].unbindAttributes();
-									m_program[boundProgram.idx].unbindInstanceData();
-								}
+									boundFormat = format;
+
+									if (isValid(boundProgram) )
+									{
+										m_program[boundProgram.idx].unbindAttributes();
+										m_program[boundProgram.idx].unbindInstanceData();
+									}
+
+									boundProgram = currentProgram;
+
+									program.bindAttributesBegin();
+
+									if (UINT8_MAX != draw.m_streamMask)
+									{
+										for (uint32_t idx = 0, streamMask = draw.m_streamMask
+											; 0 != streamMask
+											; streamMask >>= 1, idx += 1
+											)
+										{
+											const uint32_t ntz = bx::uint32_cnttz(streamMask);
+											streamMask >>= ntz;
+											idx         += ntz;
+
+											program.bindAttributesFormat(m_vertexLayouts[format.m_layout[idx] ], uint8_t(idx) );
+											GL_CHECK(glVertexBindingDivisor(idx, 0) );
+										}
+									}
 
-								boundProgram = currentProgram;
+									program.bindAttributesEnd();
 
-								program.bindAttributesBegin();
+									if (isValid(draw.m_instanceDataBuffer) )
+									{
+										program.bindInstanceDataFormat(BGFX_CONFIG_MAX_VERTEX_STREAMS);
+										GL_CHECK(glVertexBindingDivisor(BGFX_CONFIG_MAX_VERTEX_STREAMS, 1) );
+									}
+								}
 
 								if (UINT8_MAX != draw.m_streamMask)
 								{
@@ -7916,20 +9056,143 @@ namespace bgfx { namespace gl
 										idx         += ntz;
 
 										const VertexBufferGL& vb = m_vertexBuffers[draw.m_stream[idx].m_handle.idx];
-										const uint16_t decl = isValid(draw.m_stream[idx].m_layoutHandle)
-											? draw.m_stream[idx].m_layoutHandle.idx
-											: vb.m_layoutHandle.idx;
-										GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, vb.m_id) );
-										program.bindAttributes(m_vertexLayouts[decl], draw.m_stream[idx].m_startVertex);
+										const uint16_t stride = m_vertexLayouts[format.m_layout[idx] ].m_stride;
+										GL_CHECK(glBindVertexBuffer(idx
+											, vb.m_id
+											, GLintptr(draw.m_stream[idx].m_startVertex)*stride
+											, stride
+											) );
 									}
 								}
 
-								program.bindAttributesEnd();
-
 								if (isValid(draw.m_instanceDataBuffer) )
 								{
-									GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffers[draw.m_instanceDataBuffer.idx].m_id) );
-									program.bindInstanceData(draw.m_instanceDataStride, draw.m_instanceDataOffset);
+									GL_CHECK(glBindVertexBuffer(BGFX_CONFIG_MAX_VERTEX_STREAMS
+										, m_vertexBuffers[draw.m_instanceDataBuffer.idx].m_id
+										, draw.m_instanceDataOffset
+										, draw.m_instanceDataStride
+										) );
+								}
+							}
+							else
+							{
+								GLuint vao = 0;
+
+								if (vertexArrayCache)
+								{
+									VertexArrayKey vertexArray;
+									getVertexArrayKey(vertexArray, draw, currentProgram, true);
+
+									if (vertexArray.m_indexBuffer != transientIb
+									&&  !vertexArray.hasVertexBuffer(transientVb) )
+									{
+										if (boundVao == defaultVao
+										&&  isValid(boundProgram) )
+										{
+											m_program[boundProgram.idx].unbindAttributes();
+											m_program[boundProgram.idx].unbindInstanceData();
+											boundProgram = BGFX_INVALID_HANDLE;
+										}
+
+										vao = m_vertexArrayCache.find(vertexArray);
+
+										if (0 == vao)
+										{
+											vao = m_vertexArrayCache.add(vertexArray);
+
+											GL_CHECK(glBindVertexArray(vao) );
+											boundVao = vao;
+
+											if (isValid(draw.m_indexBuffer) )
+											{
+												GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffers[draw.m_indexBuffer.idx].m_id) );
+											}
+
+											program.bindAttributesBegin();
+
+											if (UINT8_MAX != draw.m_streamMask)
+											{
+												for (uint32_t idx = 0, streamMask = draw.m_streamMask
+													; 0 != streamMask
+													; streamMask >>= 1, idx += 1
+													)
+												{
+													const uint32_t ntz = bx::uint32_cnttz(streamMask);
+													streamMask >>= ntz;
+													idx         += ntz;
+
+													GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffers[vertexArray.m_handle[idx] ].m_id) );
+													program.bindAttributes(m_vertexLayouts[vertexArray.m_layout[idx] ], vertexArray.m_startVertex[idx]);
+												}
+											}
+
+											program.bindAttributesEnd();
+
+											if (isValid(draw.m_instanceDataBuffer) )
+											{
+												GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffers[draw.m_instanceDataBuffer.idx].m_id) );
+												program.bindInstanceData(draw.m_instanceDataStride, draw.m_instanceDataOffset);
+											}
+										}
+										else if (vao != boundVao)
+										{
+											GL_CHECK(glBindVertexArray(vao) );
+											boundVao = vao;
+										}
+									}
+									else
+									{
+										if (boundVao != defaultVao)
+										{
+											GL_CHECK(glBindVertexArray(defaultVao) );
+											boundVao = defaultVao;
+										}
+
+										GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER
+											, isValid(draw.m_indexBuffer) ? m_indexBuffers[draw.m_indexBuffer.idx].m_id : 0
+											) );
+									}
+								}
+
+								if (0 == vao)
+								{
+									if (isValid(boundProgram) )
+									{
+										m_program[boundProgram.idx].unbindAttributes();
+										m_program[boundProgram.idx].unbindInstanceData();
+									}
+
+									boundProgram = currentProgram;
+
+									program.bindAttributesBegin();
+
+									if (UINT8_MAX != draw.m_streamMask)
+									{
+										for (uint32_t idx = 0, streamMask = draw.m_streamMask
+											; 0 != streamMask
+											; streamMask >>= 1, idx += 1
+											)
+										{
+											const uint32_t ntz = bx::uint32_cnttz(streamMask);
+											streamMask >>= ntz;
+											idx         += ntz;
+
+											const VertexBufferGL& vb = m_vertexBuffers[draw.m_stream[idx].m_handle.idx];
+											const uint16_t decl = isValid(draw.m_stream[idx].m_layoutHandle)
+												? draw.m_stream[idx].m_layoutHandle.idx
+												: vb.m_layoutHandle.idx;
+											GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, vb.m_id) );
+											program.bindAttributes(m_vertexLayouts[decl], draw.m_stream[idx].m_startVertex);
+										}
+									}
+
+									program.bindAttributesEnd();
+
+									if (isValid(draw.m_instanceDataBuffer) )
+									{
+										GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffers[draw.m_instanceDataBuffer.idx].m_id) );
+										program.bindInstanceData(draw.m_instanceDataStride, draw.m_instanceDataOffset);
+									}
 								}
 							}
 						}
@@ -8093,6 +9356,8 @@ namespace bgfx { namespace gl
 				boundProgram = BGFX_INVALID_HANDLE;
 			}
 
+			boundFormat.clear();
+
 			if (wasCompute)
 			{
 				setViewType(view, "C");
@@ -8359,6 +9624,12 @@ namespace bgfx { namespace gl
 
 			BGFX_GL_PROFILER_END();
 		}
+
+		if (0 != m_uniformStream)
+		{
+			// Uniform stream ranges written this frame are reused once GPU is done with frame.
+			fenceUniformStream();
+		}
 	}
 } } // namespace bgfx
 
@@ -113,6 +113,7 @@ typedef double GLdouble;
 #		endif // BX_PLATFORM_
 typedef int64_t  GLint64;
 typedef uint64_t GLuint64;
+typedef struct __GLsync* GLsync;
 #		define GL_PROGRAM_BINARY_LENGTH GL_PROGRAM_BINARY_LENGTH_OES
 #		define GL_HALF_FLOAT GL_HALF_FLOAT_OES
 #		define GL_RGBA8 GL_RGBA8_OES
@@ -797,6 +798,78 @@ typedef uint64_t GLuint64;
 #	define GL_SAMPLER_2D_ARRAY_SHADOW 0x8DC4
 #endif // GL_SAMPLER_2D_ARRAY_SHADOW
 
+#ifndef GL_TEXTURE_BASE_LEVEL
+#	define GL_TEXTURE_BASE_LEVEL 0x813C
+#endif // GL_TEXTURE_BASE_LEVEL
+
+#ifndef GL_STREAM_DRAW
+#	define GL_STREAM_DRAW 0x88E0
+#endif // GL_STREAM_DRAW
+
+#ifndef GL_STREAM_READ
+#	define GL_STREAM_READ 0x88E1
+#endif // GL_STREAM_READ
+
+#ifndef GL_PIXEL_PACK_BUFFER
+#	define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif // GL_PIXEL_PACK_BUFFER
+
+#ifndef GL_MAP_READ_BIT
+#	define GL_MAP_READ_BIT 0x0001
+#endif // GL_MAP_READ_BIT
+
+#ifndef GL_MAP_WRITE_BIT
+#	define GL_MAP_WRITE_BIT 0x0002
+#endif // GL_MAP_WRITE_BIT
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#	define GL_MAP_PERSISTENT_BIT 0x0040
+#endif // GL_MAP_PERSISTENT_BIT
+
+#ifndef GL_MAP_COHERENT_BIT
+#	define GL_MAP_COHERENT_BIT 0x0080
+#endif // GL_MAP_COHERENT_BIT
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#	define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif // GL_SYNC_GPU_COMMANDS_COMPLETE
+
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#	define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif // GL_SYNC_FLUSH_COMMANDS_BIT
+
+#ifndef GL_ALREADY_SIGNALED
+#	define GL_ALREADY_SIGNALED 0x911A
+#endif // GL_ALREADY_SIGNALED
+
+#ifndef GL_TIMEOUT_EXPIRED
+#	define GL_TIMEOUT_EXPIRED 0x911B
+#endif // GL_TIMEOUT_EXPIRED
+
+#ifndef GL_CONDITION_SATISFIED
+#	define GL_CONDITION_SATISFIED 0x911C
+#endif // GL_CONDITION_SATISFIED
+
+#ifndef GL_WAIT_FAILED
+#	define GL_WAIT_FAILED 0x911D
+#endif // GL_WAIT_FAILED
+
+#ifndef GL_UNIFORM_BUFFER
+#	define GL_UNIFORM_BUFFER 0x8A11
+#endif // GL_UNIFORM_BUFFER
+
+#ifndef GL_MAX_UNIFORM_BLOCK_SIZE
+#	define GL_MAX_UNIFORM_BLOCK_SIZE 0x8A30
+#endif // GL_MAX_UNIFORM_BLOCK_SIZE
+
+#ifndef GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+#	define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#endif // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+
+#ifndef GL_INVALID_INDEX
+#	define GL_INVALID_INDEX 0xFFFFFFFFu
+#endif // GL_INVALID_INDEX
+
 #ifndef GL_TEXTURE_MAX_LEVEL
 #	define GL_TEXTURE_MAX_LEVEL 0x813D
 #endif // GL_TEXTURE_MAX_LEVEL
@@ -1084,6 +1157,10 @@ typedef uint64_t GLuint64;
 #	define GL_TEXTURE_LOD_BIAS 0x8501
 #endif // GL_TEXTURE_LOD_BIAS
 
+#ifndef GL_TEXTURE_MIN_LOD
+#	define GL_TEXTURE_MIN_LOD 0x813A
+#endif // GL_TEXTURE_MIN_LOD
+
 #if BX_PLATFORM_WINDOWS
 #	include <windows.h>
 #elif BX_PLATFORM_LINUX || BX_PLATFORM_BSD
@@ -1284,6 +1361,218 @@ namespace bgfx { namespace gl
 		HashMap m_hashMap;
 	};
 
+	struct VertexArrayKey
+	{
+		void clear()
+		{
+			bx::memSet(this, 0xff, sizeof(VertexArrayKey) );
+			m_instanceDataStride = 0;
+			m_instanceDataOffset = 0;
+			bx::memSet(m_startVertex, 0, sizeof(m_startVertex) );
+		}
+
+		bool operator==(const VertexArrayKey& _rhs) const
+		{
+			return 0 == bx::memCmp(this, &_rhs, sizeof(VertexArrayKey) );
+		}
+
+		bool operator!=(const VertexArrayKey& _rhs) const
+		{
+			return !(*this == _rhs);
+		}
+
+		bool hasVertexBuffer(uint16_t _idx) const
+		{
+			bool used = m_instanceDataBuffer == _idx;
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VERTEX_STREAMS && !used; ++ii)
+			{
+				used = m_handle[ii] == _idx;
+			}
+
+			return used;
+		}
+
+		uint32_t hash() const
+		{
+			bx::HashMurmur2A murmur;
+			murmur.begin();
+			murmur.add(this, sizeof(VertexArrayKey) );
+			return murmur.end();
+		}
+
+		uint16_t m_program;
+		uint16_t m_indexBuffer;
+		uint16_t m_instanceDataBuffer;
+		uint16_t m_instanceDataStride;
+		uint32_t m_instanceDataOffset;
+		uint16_t m_handle[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+		uint16_t m_layout[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+		uint32_t m_startVertex[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+	};
+
+	class VertexArrayCache
+	{
+	public:
+		GLuint add(const VertexArrayKey& _key)
+		{
+			const uint32_t hash = _key.hash();
+			invalidate(hash);
+
+			uint16_t handle = m_alloc.alloc();
+			if (UINT16_MAX == handle)
+			{
+				release(m_alloc.getBack() );
+				handle = m_alloc.alloc();
+			}
+
+			BX_ASSERT(UINT16_MAX != handle, "Failed to find handle.");
+
+			Data& data = m_data[handle];
+			data.m_key  = _key;
+			data.m_hash = hash;
+			GL_CHECK(glGenVertexArrays(1, &data.m_vao) );
+
+			m_hashMap.insert(stl::make_pair(hash, handle) );
+
+			return data.m_vao;
+		}
+
+		GLuint find(const VertexArrayKey& _key)
+		{
+			HashMap::iterator it = m_hashMap.find(_key.hash() );
+			if (it != m_hashMap.end() )
+			{
+				const uint16_t handle = it->second;
+				if (m_data[handle].m_key == _key)
+				{
+					m_alloc.touch(handle);
+					return m_data[handle].m_vao;
+				}
+			}
+
+			return 0;
+		}
+
+		void invalidateWithProgram(ProgramHandle _handle)
+		{
+			for (uint16_t ii = 0; ii < m_alloc.getNumHandles();)
+			{
+				const uint16_t handle = m_alloc.getHandleAt(ii);
+
+				if (m_data[handle].m_key.m_program == _handle.idx)
+				{
+					release(handle);
+				}
+				else
+				{
+					++ii;
+				}
+			}
+		}
+
+		void invalidateWithIndexBuffer(IndexBufferHandle _handle)
+		{
+			for (uint16_t ii = 0; ii < m_alloc.getNumHandles();)
+			{
+				const uint16_t handle = m_alloc.getHandleAt(ii);
+
+				if (m_data[handle].m_key.m_indexBuffer == _handle.idx)
+				{
+					release(handle);
+				}
+				else
+				{
+					++ii;
+				}
+			}
+		}
+
+		void invalidateWithVertexLayout(VertexLayoutHandle _handle)
+		{
+			for (uint16_t ii = 0; ii < m_alloc.getNumHandles();)
+			{
+				const uint16_t handle = m_alloc.getHandleAt(ii);
+				const VertexArrayKey& key = m_data[handle].m_key;
+
+				bool used = false;
+				for (uint32_t jj = 0; jj < BGFX_CONFIG_MAX_VERTEX_STREAMS && !used; ++jj)
+				{
+					used = key.m_layout[jj] == _handle.idx;
+				}
+
+				if (used)
+				{
+					release(handle);
+				}
+				else
+				{
+					++ii;
+				}
+			}
+		}
+
+		void invalidateWithVertexBuffer(VertexBufferHandle _handle)
+		{
+			for (uint16_t ii = 0; ii < m_alloc.getNumHandles();)
+			{
+				const uint16_t handle = m_alloc.getHandleAt(ii);
+
+				if (m_data[handle].m_key.hasVertexBuffer(_handle.idx) )
+				{
+					release(handle);
+				}
+				else
+				{
+					++ii;
+				}
+			}
+		}
+
+		void invalidate()
+		{
+			while (0 < m_alloc.getNumHandles() )
+			{
+				release(m_alloc.getHandleAt(0) );
+			}
+		}
+
+		uint32_t getCount() const
+		{
+			return uint32_t(m_hashMap.size() );
+		}
+
+	private:
+		void invalidate(uint32_t _hash)
+		{
+			HashMap::iterator it = m_hashMap.find(_hash);
+			if (it != m_hashMap.end() )
+			{
+				release(it->second);
+			}
+		}
+
+		void release(uint16_t _handle)
+		{
+			Data& data = m_data[_handle];
+			GL_CHECK(glDeleteVertexArrays(1, &data.m_vao) );
+			m_hashMap.erase(m_hashMap.find(data.m_hash) );
+			m_alloc.free(_handle);
+		}
+
+		typedef stl::unordered_map<uint32_t, uint16_t> HashMap;
+		HashMap m_hashMap;
+		bx::HandleAllocLruT<BGFX_CONFIG_MAX_VERTEX_ARRAY_CACHE> m_alloc;
+
+		struct Data
+		{
+			VertexArrayKey m_key;
+			uint32_t m_hash;
+			GLuint m_vao;
+		};
+
+		Data m_data[BGFX_CONFIG_MAX_VERTEX_ARRAY_CACHE];
+	};
+
 	struct IndexBufferGL
 	{
 		void create(uint32_t _size, void* _data, uint16_t _flags)
@@ -1389,6 +1678,7 @@ namespace bgfx { namespace gl
 			, m_flags(0)
 			, m_currentSamplerHash(UINT32_MAX)
 			, m_numMips(0)
+			, m_minLod(0)
 		{
 		}
 
@@ -1421,16 +1711,26 @@ namespace bgfx { namespace gl
 		uint32_t m_depth;
 		uint32_t m_numLayers;
 		uint8_t m_numMips;
+		uint8_t m_minLod;
 		uint8_t m_requestedFormat;
 		uint8_t m_textureFormat;
 	};
 
+	// Uniforms packed into std140 uniform block are addressed by byte offset
+	// instead of uniform location.
+	constexpr uint32_t kUniformBlockBit         = UINT32_C(0x80000000);
+	constexpr uint32_t kUniformBlockFragmentBit = UINT32_C(0x40000000);
+	constexpr uint32_t kUniformBlockOffsetMask  = UINT32_C(0x0000ffff);
+
 	struct ShaderGL
 	{
 		ShaderGL()
 			: m_id(0)
 			, m_type(0)
 			, m_hash(0)
+			, m_constantBuffer(NULL)
+			, m_size(0)
+			, m_numPredefined(0)
 		{
 		}
 
@@ -1440,6 +1740,11 @@ namespace bgfx { namespace gl
 		GLuint m_id;
 		GLenum m_type;
 		uint32_t m_hash;
+
+		UniformBuffer* m_constantBuffer;
+		PredefinedUniform m_predefined[PredefinedUniform::Count];
+		uint16_t m_size;
+		uint8_t m_numPredefined;
 	};
 
 	struct FrameBufferGL
@@ -1475,6 +1780,8 @@ namespace bgfx { namespace gl
 	{
 		ProgramGL()
 			: m_id(0)
+			, m_vsh(NULL)
+			, m_fsh(NULL)
 			, m_constantBuffer(NULL)
 			, m_numPredefined(0)
 		{
@@ -1485,6 +1792,7 @@ namespace bgfx { namespace gl
 		void init();
 		void bindInstanceData(uint32_t _stride, uint32_t _baseVertex = 0) const;
 		void unbindInstanceData() const;
+		void bindInstanceDataFormat(uint8_t _binding) const;
 
 		void bindAttributesBegin()
 		{
@@ -1492,6 +1800,7 @@ namespace bgfx { namespace gl
 		}
 
 		void bindAttributes(const VertexLayout& _layout, uint32_t _baseVertex = 0);
+		void bindAttributesFormat(const VertexLayout& _layout, uint8_t _binding);
 
 		void bindAttributesEnd()
 		{
@@ -1519,8 +1828,11 @@ namespace bgfx { namespace gl
 		GLint m_sampler[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
 		uint8_t m_numSamplers;
 
+		const ShaderGL* m_vsh;
+		const ShaderGL* m_fsh;
+
 		UniformBuffer* m_constantBuffer;
-		PredefinedUniform m_predefined[PredefinedUniform::Count];
+		PredefinedUniform m_predefined[PredefinedUniform::Count * 2];
 		uint8_t m_numPredefined;
 	};
 
@@ -1689,6 +2001,36 @@ namespace bgfx { namespace gl
 		bx::RingBufferControl m_control;
 	};
 
+	struct ReadBackGL
+	{
+		ReadBackGL()
+			: m_control(BX_COUNTOF(m_query) )
+			, m_frame(0)
+		{
+		}
+
+		void create();
+		void destroy();
+		void begin(void* _data, uint32_t _size);
+		void end();
+		void resolve(bool _wait = false);
+		void update();
+
+		struct Query
+		{
+			GLuint   m_pbo;
+			GLsync   m_sync;
+			void*    m_data;
+			uint32_t m_size;
+			uint32_t m_capacity;
+			uint32_t m_frame;
+		};
+
+		Query m_query[BGFX_CONFIG_MAX_TEXTURE_READ_BACKS];
+		bx::RingBufferControl m_control;
+		uint32_t m_frame;
+	};
+
 } /* namespace gl */ } // namespace bgfx
 
 #endif // BGFX_RENDERER_GL_H_HEADER_GUARD
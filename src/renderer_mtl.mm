@@ -843,6 +843,11 @@ namespace bgfx { namespace mtl
 		{
 		}
 
+		uint32_t getReadTextureLatency() const override
+		{
+			return 0;
+		}
+
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
 			const TextureMtl& texture = m_textures[_handle.idx];
@@ -899,6 +904,13 @@ namespace bgfx { namespace mtl
 			release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle _handle, uint8_t _minLod) override
+		{
+			TextureMtl& texture = m_textures[_handle.idx];
+			texture.m_minLod  = _minLod;
+			texture.m_sampler = getSamplerState(uint32_t(texture.m_flags), _minLod);
+		}
+
 		void overrideInternal(TextureHandle _handle, uintptr_t _ptr) override
 		{
 			m_textures[_handle.idx].overrideInternal(_ptr);
@@ -1082,6 +1094,19 @@ namespace bgfx { namespace mtl
 			}
 		}
 
+		virtual void prewarmPipeline(ProgramHandle _program, uint64_t _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer) override
+		{
+			BX_UNUSED(_program, _state, _layoutHandle, _frameBuffer);
+		}
+
+		virtual void flushPipelineCache() override
+		{
+		}
+
+		virtual void defragment() override
+		{
+		}
+
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
@@ -2254,10 +2279,11 @@ namespace bgfx { namespace mtl
 		}
 
 
-		SamplerState getSamplerState(uint32_t _flags)
+		SamplerState getSamplerState(uint32_t _flags, uint8_t _minLod = 0)
 		{
 			_flags &= BGFX_SAMPLER_BITS_MASK;
-			SamplerState sampler = m_samplerStateCache.find(_flags);
+			const uint64_t key = uint64_t(_flags) | (uint64_t(_minLod)<<32);
+			SamplerState sampler = m_samplerStateCache.find(key);
 
 			if (NULL == sampler)
 			{
@@ -2267,7 +2293,7 @@ namespace bgfx { namespace mtl
 				m_samplerDescriptor.minFilter    = s_textureFilterMinMag[(_flags&BGFX_SAMPLER_MIN_MASK)>>BGFX_SAMPLER_MIN_SHIFT];
 				m_samplerDescriptor.magFilter    = s_textureFilterMinMag[(_flags&BGFX_SAMPLER_MAG_MASK)>>BGFX_SAMPLER_MAG_SHIFT];
 				m_samplerDescriptor.mipFilter    = s_textureFilterMip[(_flags&BGFX_SAMPLER_MIP_MASK)>>BGFX_SAMPLER_MIP_SHIFT];
-				m_samplerDescriptor.lodMinClamp  = 0;
+				m_samplerDescriptor.lodMinClamp  = float(_minLod);
 				m_samplerDescriptor.lodMaxClamp  = FLT_MAX;
 				m_samplerDescriptor.normalizedCoordinates = TRUE;
 				m_samplerDescriptor.maxAnisotropy =  (0 != (_flags & (BGFX_SAMPLER_MIN_ANISOTROPIC|BGFX_SAMPLER_MAG_ANISOTROPIC) ) ) ? m_mainFrameBuffer.m_swapChain->m_maxAnisotropy : 1;
@@ -2283,7 +2309,7 @@ namespace bgfx { namespace mtl
 				}
 
 				sampler = m_device.newSamplerStateWithDescriptor(m_samplerDescriptor);
-				m_samplerStateCache.add(_flags, sampler);
+				m_samplerStateCache.add(key, sampler);
 			}
 
 			return sampler;
@@ -2650,6 +2676,7 @@ namespace bgfx { namespace mtl
 
 	void TextureMtl::create(const Memory* _mem, uint64_t _flags, uint8_t _skip)
 	{
+		m_minLod  = 0;
 		m_sampler = s_renderMtl->getSamplerState(uint32_t(_flags) );
 
 		bimg::ImageContainer imageContainer;
@@ -2997,7 +3024,7 @@ namespace bgfx { namespace mtl
 			s_renderMtl->m_renderCommandEncoder.setVertexTexture(m_ptr, _stage);
 			s_renderMtl->m_renderCommandEncoder.setVertexSamplerState(
 				  0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & _flags)
-					? s_renderMtl->getSamplerState(_flags)
+					? s_renderMtl->getSamplerState(_flags, m_minLod)
 					: m_sampler
 				, _stage
 				);
@@ -3008,7 +3035,7 @@ namespace bgfx { namespace mtl
 			s_renderMtl->m_renderCommandEncoder.setFragmentTexture(m_ptr, _stage);
 			s_renderMtl->m_renderCommandEncoder.setFragmentSamplerState(
 				  0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & _flags)
-					? s_renderMtl->getSamplerState(_flags)
+					? s_renderMtl->getSamplerState(_flags, m_minLod)
 					: m_sampler
 				, _stage
 				);
@@ -4159,7 +4186,7 @@ namespace bgfx { namespace mtl
 									m_computeCommandEncoder.setTexture(texture.m_ptr, stage);
 									m_computeCommandEncoder.setSamplerState(
 										0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & flags)
-										? getSamplerState(flags)
+										? getSamplerState(flags, texture.m_minLod)
 										: texture.m_sampler
 										, stage
 										);
@@ -4377,7 +4404,7 @@ namespace bgfx { namespace mtl
 				}
 
 				bool programChanged = false;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				rendererUpdateUniforms(this, _render, draw);
 
 				bool vertexStreamChanged = hasVertexStreamChanged(currentState, draw);
 
@@ -174,6 +174,11 @@ namespace bgfx { namespace noop
 		{
 		}
 
+		uint32_t getReadTextureLatency() const override
+		{
+			return 0;
+		}
+
 		void readTexture(TextureHandle /*_handle*/, void* /*_data*/, uint8_t /*_mip*/) override
 		{
 		}
@@ -182,6 +187,10 @@ namespace bgfx { namespace noop
 		{
 		}
 
+		void setTextureMinLod(TextureHandle /*_handle*/, uint8_t /*_minLod*/) override
+		{
+		}
+
 		void overrideInternal(TextureHandle /*_handle*/, uintptr_t /*_ptr*/) override
 		{
 		}
@@ -239,6 +248,18 @@ namespace bgfx { namespace noop
 		{
 		}
 
+		virtual void prewarmPipeline(ProgramHandle /*_program*/, uint64_t /*_state*/, VertexLayoutHandle /*_layoutHandle*/, FrameBufferHandle /*_frameBuffer*/) override
+		{
+		}
+
+		virtual void flushPipelineCache() override
+		{
+		}
+
+		virtual void defragment() override
+		{
+		}
+
 		void submit(Frame* _render, ClearQuad& /*_clearQuad*/, TextVideoMemBlitter& /*_textVideoMemBlitter*/) override
 		{
 			const int64_t timerFreq = bx::getHPFrequency();
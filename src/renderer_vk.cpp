@@ -312,6 +312,9 @@ VK_IMPORT_DEVICE
 			EXT_conservative_rasterization,
 			EXT_line_rasterization,
 			EXT_shader_viewport_index_layer,
+			KHR_push_descriptor,
+			KHR_maintenance3,
+			EXT_descriptor_indexing,
 
 			Count
 		};
@@ -334,7 +337,10 @@ VK_IMPORT_DEVICE
 		{ "VK_KHR_get_physical_device_properties2", 1, false, false, true                         , Layer::Count },
 		{ "VK_EXT_conservative_rasterization",      1, false, false, true                         , Layer::Count },
 		{ "VK_EXT_line_rasterization",              1, false, false, true                         , Layer::Count },
-		{ "VK_EXT_shader_viewport_index_layer",     1, false, false, true                         , Layer::Count }
+		{ "VK_EXT_shader_viewport_index_layer",     1, false, false, true                         , Layer::Count },
+		{ "VK_KHR_push_descriptor",                 1, false, false, true                         , Layer::Count },
+		{ "VK_KHR_maintenance3",                    1, false, false, true                         , Layer::Count },
+		{ "VK_EXT_descriptor_indexing",             1, false, false, true                         , Layer::Count },
 	};
 	BX_STATIC_ASSERT(Extension::Count == BX_COUNTOF(s_extension) );
 
@@ -1012,6 +1018,8 @@ VK_IMPORT_DEVICE
 			);
 	}
 
+	struct RecordDrawJob;
+
 	struct RendererContextVK : public RendererContextI
 	{
 		RendererContextVK()
@@ -1022,7 +1030,6 @@ VK_IMPORT_DEVICE
 			, m_depthClamp(false)
 			, m_wireframe(false)
 			, m_captureBuffer(VK_NULL_HANDLE)
-			, m_captureMemory(VK_NULL_HANDLE)
 			, m_captureData(NULL)
 			, m_captureSize(0)
 		{
@@ -1053,9 +1060,11 @@ VK_IMPORT_DEVICE
 			const bool headless = NULL == g_platformData.nwh;
 
 			VkPhysicalDeviceLineRasterizationFeaturesEXT lineRasterizationFeatures;
+			VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures;
 			const void* nextFeatures = NULL;
 
 			bx::memSet(&lineRasterizationFeatures, 0, sizeof(lineRasterizationFeatures) );
+			bx::memSet(&descriptorIndexingFeatures, 0, sizeof(descriptorIndexingFeatures) );
 
 			m_fbh.idx = kInvalidHandle;
 			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
@@ -1398,6 +1407,14 @@ VK_IMPORT_INSTANCE
 						lineRasterizationFeatures.pNext = NULL;
 					}
 
+					if (s_extension[Extension::EXT_descriptor_indexing].m_supported)
+					{
+						next->pNext = (VkBaseOutStructure*)&descriptorIndexingFeatures;
+						next = (VkBaseOutStructure*)&descriptorIndexingFeatures;
+						descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+						descriptorIndexingFeatures.pNext = NULL;
+					}
+
 					nextFeatures = deviceFeatures2.pNext;
 
 					vkGetPhysicalDeviceFeatures2KHR(m_physicalDevice, &deviceFeatures2);
@@ -1415,6 +1432,20 @@ VK_IMPORT_INSTANCE
 					&& lineRasterizationFeatures.smoothLines
 					;
 
+				// Bindless textures need one array of sampled images and one of samplers per set,
+				// sized BGFX_CONFIG_MAX_BINDLESS_TEXTURES, indexed non-uniformly from shader.
+				m_bindlessSupport = true
+					&& s_extension[Extension::KHR_maintenance3].m_supported
+					&& s_extension[Extension::EXT_descriptor_indexing].m_supported
+					&& descriptorIndexingFeatures.descriptorBindingPartiallyBound
+					&& descriptorIndexingFeatures.runtimeDescriptorArray
+					&& descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing
+					&& m_deviceProperties.limits.maxPerStageDescriptorSampledImages >= BGFX_CONFIG_MAX_BINDLESS_TEXTURES
+					&& m_deviceProperties.limits.maxPerStageDescriptorSamplers      >= BGFX_CONFIG_MAX_BINDLESS_TEXTURES
+					&& m_deviceProperties.limits.maxDescriptorSetSampledImages      >= BGFX_CONFIG_MAX_BINDLESS_TEXTURES
+					&& m_deviceProperties.limits.maxDescriptorSetSamplers           >= BGFX_CONFIG_MAX_BINDLESS_TEXTURES
+					;
+
 				const bool indirectDrawSupport = true
 					&& m_deviceFeatures.multiDrawIndirect
 					&& m_deviceFeatures.drawIndirectFirstInstance
@@ -1444,6 +1475,7 @@ VK_IMPORT_INSTANCE
 				g_caps.supported |= 0
 					| (s_extension[Extension::EXT_conservative_rasterization ].m_supported ? BGFX_CAPS_CONSERVATIVE_RASTER  : 0)
 					| (s_extension[Extension::EXT_shader_viewport_index_layer].m_supported ? BGFX_CAPS_VIEWPORT_LAYER_ARRAY : 0)
+					| (m_bindlessSupport ? BGFX_CAPS_TEXTURE_BINDLESS : 0)
 					;
 
 				const uint32_t maxAttachments = bx::min<uint32_t>(m_deviceProperties.limits.maxFragmentOutputAttachments, m_deviceProperties.limits.maxColorAttachments);
@@ -1728,9 +1760,16 @@ VK_IMPORT_DEVICE
 				goto error;
 			}
 
+			m_pushDescriptorSupport = true
+				&& s_extension[Extension::KHR_push_descriptor].m_supported
+				&& NULL != vkCmdPushDescriptorSetKHR
+				;
+
 			vkGetDeviceQueue(m_device, m_qfiGraphics, 0, &m_queueGraphics);
 			vkGetDeviceQueue(m_device, m_qfiCompute,  0, &m_queueCompute);
 
+			m_memoryAllocator.init(m_memoryProperties, BGFX_CONFIG_DEVICE_MEMORY_BLOCK_SIZE);
+
 			{
 				m_numFramesInFlight = _init.resolution.maxFrameLatency == 0
 					? BGFX_CONFIG_MAX_FRAME_LATENCY
@@ -1787,39 +1826,33 @@ VK_IMPORT_DEVICE
 			errorState = ErrorState::SwapChainCreated;
 
 			{
-				VkDescriptorPoolSize dps[] =
-				{
-					{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          (10 * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS) << 10 },
-					{ VK_DESCRIPTOR_TYPE_SAMPLER,                (10 * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS) << 10 },
-					{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 10<<10                           },
-					{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 10 },
-					{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 10 },
-				};
-
-				VkDescriptorPoolCreateInfo dpci;
-				dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-				dpci.pNext = NULL;
-				dpci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-				dpci.maxSets       = 10<<10;
-				dpci.poolSizeCount = BX_COUNTOF(dps);
-				dpci.pPoolSizes    = dps;
-
-				result = vkCreateDescriptorPool(m_device, &dpci, m_allocatorCb, &m_descriptorPool);
+				initPipelineCacheHeader(m_pipelineCacheHeader
+					, m_deviceProperties.vendorID
+					, m_deviceProperties.deviceID
+					, m_deviceProperties.driverVersion
+					, m_deviceProperties.pipelineCacheUUID
+					, VK_UUID_SIZE
+					);
 
-				if (VK_SUCCESS != result)
-				{
-					BX_TRACE("Init error: vkCreateDescriptorPool failed %d: %s.", result, getName(result) );
-					goto error;
-				}
+				uint32_t cachedSize;
+				void* cachedData = pipelineCacheRead(getPipelineCacheId(RendererType::Vulkan), m_pipelineCacheHeader, cachedSize);
 
 				VkPipelineCacheCreateInfo pcci;
 				pcci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
 				pcci.pNext = NULL;
 				pcci.flags = 0;
-				pcci.initialDataSize = 0;
-				pcci.pInitialData    = NULL;
+				pcci.initialDataSize = cachedSize;
+				pcci.pInitialData    = cachedData;
 				result = vkCreatePipelineCache(m_device, &pcci, m_allocatorCb, &m_pipelineCache);
 
+				if (NULL != cachedData)
+				{
+					BX_TRACE("Loaded cached pipeline state (size %d).", cachedSize);
+					BX_FREE(g_allocator, cachedData);
+				}
+
+				m_pipelineCacheDirty = false;
+
 				if (VK_SUCCESS != result)
 				{
 					BX_TRACE("Init error: vkCreatePipelineCache failed %d: %s.", result, getName(result) );
@@ -1829,12 +1862,29 @@ VK_IMPORT_DEVICE
 
 			{
 				const uint32_t size = 128;
-				const uint32_t count = BGFX_CONFIG_MAX_DRAW_CALLS;
-				const uint32_t maxDescriptors = 1024;
+				const uint32_t count = g_caps.limits.maxDrawCalls;
 				for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 				{
 					BX_TRACE("Create scratch buffer %d", ii);
-					m_scratchBuffer[ii].create(size, count, maxDescriptors);
+					m_scratchBuffer[ii].create(size, count);
+				}
+
+				for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+				{
+					m_stagingRing[ii].create(BGFX_CONFIG_STAGING_BUFFER_SIZE);
+				}
+			}
+
+			if (m_bindlessSupport)
+			{
+				result = m_bindlessTexture.init(m_numFramesInFlight);
+
+				if (VK_SUCCESS != result)
+				{
+					BX_TRACE("Init warning: creating bindless texture set failed %d: %s.", result, getName(result) );
+					m_bindlessTexture.shutdown();
+					m_bindlessSupport = false;
+					g_caps.supported &= ~BGFX_CAPS_TEXTURE_BINDLESS;
 				}
 			}
 
@@ -1873,6 +1923,8 @@ VK_IMPORT_DEVICE
 				goto error;
 			}
 
+			m_pipelineCompiler.init(BGFX_CONFIG_NUM_PIPELINE_COMPILE_THREADS);
+
 			g_internalData.context = m_device;
 			return true;
 
@@ -1884,9 +1936,10 @@ VK_IMPORT_DEVICE
 				for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 				{
 					m_scratchBuffer[ii].destroy();
+					m_stagingRing[ii].destroy();
 				}
+				m_bindlessTexture.shutdown();
 				vkDestroy(m_pipelineCache);
-				vkDestroy(m_descriptorPool);
 				BX_FALLTHROUGH;
 
 			case ErrorState::SwapChainCreated:
@@ -1898,6 +1951,7 @@ VK_IMPORT_DEVICE
 				BX_FALLTHROUGH;
 
 			case ErrorState::DeviceCreated:
+				m_memoryAllocator.shutdown();
 				vkDestroyDevice(m_device, m_allocatorCb);
 				BX_FALLTHROUGH;
 
@@ -1932,15 +1986,27 @@ VK_IMPORT_DEVICE
 
 			preReset();
 
+			m_pipelineCompiler.shutdown();
+			finishPipelines(false);
+			flushPipelineCache();
+
 			m_pipelineStateCache.invalidate();
 			m_descriptorSetLayoutCache.invalidate();
 			m_renderPassCache.invalidate();
 			m_samplerCache.invalidate();
 			m_imageViewCache.invalidate();
+			m_descriptorSetCache.destroy();
+			m_bindlessTexture.shutdown();
 
 			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 			{
 				m_scratchBuffer[ii].destroy();
+				m_stagingRing[ii].destroy();
+
+				for (uint32_t jj = 0; jj < kMaxRecordJobs; ++jj)
+				{
+					m_recordDescriptor[ii][jj].destroy();
+				}
 			}
 
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
@@ -1969,12 +2035,13 @@ VK_IMPORT_DEVICE
 			}
 
 			vkDestroy(m_pipelineCache);
-			vkDestroy(m_descriptorPool);
 
 			m_backBuffer.destroy();
 
 			m_cmd.shutdown();
 
+			m_memoryAllocator.shutdown();
+
 			vkDestroyDevice(m_device, m_allocatorCb);
 
 			if (VK_NULL_HANDLE != m_debugReportCallback)
@@ -2093,6 +2160,7 @@ VK_IMPORT_DEVICE
 
 		void destroyShader(ShaderHandle _handle) override
 		{
+			finishPipelines(true);
 			m_shaders[_handle.idx].destroy();
 		}
 
@@ -2103,12 +2171,20 @@ VK_IMPORT_DEVICE
 
 		void destroyProgram(ProgramHandle _handle) override
 		{
+			finishPipelines(true);
 			m_program[_handle.idx].destroy();
 		}
 
 		void* createTexture(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip) override
 		{
-			return m_textures[_handle.idx].create(m_commandBuffer, _mem, _flags, _skip);
+			void* directAccessPtr = m_textures[_handle.idx].create(m_commandBuffer, _mem, _flags, _skip);
+
+			if (m_bindlessSupport)
+			{
+				m_bindlessTexture.invalidate(_handle);
+			}
+
+			return directAccessPtr;
 		}
 
 		void updateTextureBegin(TextureHandle /*_handle*/, uint8_t /*_side*/, uint8_t /*_mip*/) override
@@ -2124,6 +2200,11 @@ VK_IMPORT_DEVICE
 		{
 		}
 
+		uint32_t getReadTextureLatency() const override
+		{
+			return m_numFramesInFlight;
+		}
+
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
 			TextureVK& texture = m_textures[_handle.idx];
@@ -2132,7 +2213,7 @@ VK_IMPORT_DEVICE
 			uint32_t pitch  = texture.m_readback.pitch(_mip);
 			uint32_t size = height * pitch;
 
-			VkDeviceMemory stagingMemory;
+			DeviceMemoryAllocationVK stagingMemory;
 			VkBuffer stagingBuffer;
 			VK_CHECK(createStagingBuffer(size, &stagingBuffer, &stagingMemory) );
 
@@ -2144,12 +2225,9 @@ VK_IMPORT_DEVICE
 				, _mip
 				);
 
-			kick(true);
-
-			texture.m_readback.readback(stagingMemory, 0, _data, _mip);
-
-			vkDestroy(stagingBuffer);
-			vkDestroy(stagingMemory);
+			// Copy is recorded into current frame command buffer, staging buffer is read back
+			// and released once command queue consumes that frame.
+			m_cmd.readback(texture.m_readback, stagingBuffer, stagingMemory, _data, _mip);
 		}
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) override
@@ -2177,9 +2255,26 @@ VK_IMPORT_DEVICE
 			texture.destroy();
 			texture.create(m_commandBuffer, mem, texture.m_flags, 0);
 
+			if (m_bindlessSupport)
+			{
+				m_bindlessTexture.invalidate(_handle);
+			}
+
 			bgfx::release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle _handle, uint8_t _minLod) override
+		{
+			// Sampler min LOD keeps texture size and mip selection as is, and only prevents
+			// sampling from mips that are not uploaded yet.
+			m_textures[_handle.idx].m_minLod = _minLod;
+
+			if (m_bindlessSupport)
+			{
+				m_bindlessTexture.invalidate(_handle);
+			}
+		}
+
 		void overrideInternal(TextureHandle /*_handle*/, uintptr_t /*_ptr*/) override
 		{
 		}
@@ -2288,14 +2383,14 @@ VK_IMPORT_DEVICE
 			const uint8_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(swapChain.m_colorFormat) );
 			const uint32_t size = frameBuffer.m_width * frameBuffer.m_height * bpp / 8;
 
-			VkDeviceMemory stagingMemory;
+			DeviceMemoryAllocationVK stagingMemory;
 			VkBuffer stagingBuffer;
 			VK_CHECK(createStagingBuffer(size, &stagingBuffer, &stagingMemory) );
 
 			readSwapChain(swapChain, stagingBuffer, stagingMemory, callback, _filePath);
 
 			vkDestroy(stagingBuffer);
-			vkDestroy(stagingMemory);
+			m_memoryAllocator.free(stagingMemory);
 		}
 
 		void updateViewName(ViewId _id, const char* _name) override
@@ -2366,6 +2461,30 @@ VK_IMPORT_DEVICE
 			}
 		}
 
+		void prewarmPipeline(ProgramHandle _program, uint64_t _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer) override
+		{
+			const FrameBufferVK& frameBuffer = isValid(_frameBuffer)
+				? m_frameBuffers[_frameBuffer.idx]
+				: m_backBuffer
+				;
+
+			if (VK_NULL_HANDLE == frameBuffer.m_renderPass)
+			{
+				return;
+			}
+
+			const VertexLayout* layout = &m_vertexLayouts[_layoutHandle.idx];
+			getPipeline(_state
+				, packStencil(BGFX_STENCIL_DEFAULT, BGFX_STENCIL_DEFAULT)
+				, 1
+				, &layout
+				, _program
+				, 0
+				, _frameBuffer
+				, true
+				);
+		}
+
 		template<typename Ty>
 		void release(Ty& _object)
 		{
@@ -2376,7 +2495,31 @@ VK_IMPORT_DEVICE
 			}
 		}
 
+		void release(DeviceMemoryAllocationVK& _alloc)
+		{
+			if (VK_NULL_HANDLE != _alloc.m_mem)
+			{
+				m_cmd.release(_alloc);
+				_alloc = DeviceMemoryAllocationVK();
+			}
+		}
+
 		void submitBlit(BlitState& _bs, uint16_t _view);
+		void submitDrawsParallel(
+			  Frame* _render
+			, ViewState& _viewState
+			, uint16_t _view
+			, int32_t _begin
+			, int32_t _end
+			, const VkRenderPassBeginInfo& _rpbi
+			, const Rect& _viewScissorRect
+			, ScratchBufferVK& _scratchBuffer
+			, uint32_t* _numPrimsSubmitted
+			, uint32_t* _numPrimsRendered
+			, uint32_t* _numInstances
+			, uint32_t& _numIndices
+			);
+		void recordDraws(RecordDrawJob& _job, uint32_t _idx, VkCommandBuffer _commandBuffer);
 
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
 
@@ -2417,6 +2560,7 @@ VK_IMPORT_DEVICE
 				, &layout
 				, _blitter.m_program
 				, 0
+				, m_fbh
 				);
 			vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pso);
 
@@ -2436,86 +2580,31 @@ VK_IMPORT_DEVICE
 			}
 
 			ScratchBufferVK& scratchBuffer = m_scratchBuffer[m_cmd.m_currentFrameInFlight];
-			VkDescriptorSetAllocateInfo dsai;
-			dsai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			dsai.pNext = NULL;
-			dsai.descriptorPool = m_descriptorPool;
-			dsai.descriptorSetCount = 1;
-			dsai.pSetLayouts = &program.m_descriptorSetLayout;
-			VK_CHECK(vkAllocateDescriptorSets(
-				  m_device
-				, &dsai
-				, &scratchBuffer.m_descriptorSet[scratchBuffer.m_currentDs]
-				) );
+			const uint32_t offsets[2] = { scratchBuffer.write(m_vsScratch, program.m_vsh->m_size), 0 };
 
 			TextureVK& texture = m_textures[_blitter.m_texture.idx];
 			uint32_t samplerFlags = (uint32_t)(texture.m_flags & BGFX_SAMPLER_BITS_MASK);
-			VkSampler sampler = getSampler(samplerFlags, 1);
-
-			const uint32_t bufferOffset = scratchBuffer.write(m_vsScratch, program.m_vsh->m_size);
-
-			VkDescriptorBufferInfo bufferInfo;
-			bufferInfo.buffer = scratchBuffer.m_buffer;
-			bufferInfo.offset = 0;
-			bufferInfo.range  = program.m_vsh->m_size;
-
-			VkWriteDescriptorSet wds[3];
-			wds[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			wds[0].pNext = NULL;
-			wds[0].dstSet = scratchBuffer.m_descriptorSet[scratchBuffer.m_currentDs];
-			wds[0].dstBinding = program.m_vsh->m_uniformBinding;
-			wds[0].dstArrayElement = 0;
-			wds[0].descriptorCount = 1;
-			wds[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-			wds[0].pImageInfo = NULL;
-			wds[0].pBufferInfo = &bufferInfo;
-			wds[0].pTexelBufferView = NULL;
-
-			VkDescriptorImageInfo imageInfo;
-			imageInfo.imageLayout = texture.m_currentImageLayout;
-			imageInfo.sampler     = sampler;
-			imageInfo.imageView   = getCachedImageView(
+			VkSampler sampler = getSampler(samplerFlags, 1, 0);
+
+			DescriptorWriteVK writes[4];
+			writes[0].m_type    = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+			writes[0].m_binding = program.m_fsh->m_bindInfo[0].binding;
+			writes[0].m_image.imageLayout = texture.m_currentImageLayout;
+			writes[0].m_image.sampler     = sampler;
+			writes[0].m_image.imageView   = getCachedImageView(
 				  _blitter.m_texture
 				, 0
 				, texture.m_numMips
 				, texture.m_type
 				);
 
-			wds[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			wds[1].pNext = NULL;
-			wds[1].dstSet = scratchBuffer.m_descriptorSet[scratchBuffer.m_currentDs];
-			wds[1].dstBinding = program.m_fsh->m_bindInfo[0].binding;
-			wds[1].dstArrayElement = 0;
-			wds[1].descriptorCount = 1;
-			wds[1].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-			wds[1].pImageInfo = &imageInfo;
-			wds[1].pBufferInfo = NULL;
-			wds[1].pTexelBufferView = NULL;
-
-			wds[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			wds[2].pNext = NULL;
-			wds[2].dstSet = scratchBuffer.m_descriptorSet[scratchBuffer.m_currentDs];
-			wds[2].dstBinding = program.m_fsh->m_bindInfo[0].samplerBinding;
-			wds[2].dstArrayElement = 0;
-			wds[2].descriptorCount = 1;
-			wds[2].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
-			wds[2].pImageInfo = &imageInfo;
-			wds[2].pBufferInfo = NULL;
-			wds[2].pTexelBufferView = NULL;
-
-			vkUpdateDescriptorSets(m_device, 3, wds, 0, NULL);
-			vkCmdBindDescriptorSets(
-				  m_commandBuffer
-				, VK_PIPELINE_BIND_POINT_GRAPHICS
-				, program.m_pipelineLayout
-				, 0
-				, 1
-				, &scratchBuffer.m_descriptorSet[scratchBuffer.m_currentDs]
-				, 1
-				, &bufferOffset
-				);
+			writes[1].m_type    = VK_DESCRIPTOR_TYPE_SAMPLER;
+			writes[1].m_binding = program.m_fsh->m_bindInfo[0].samplerBinding;
+			writes[1].m_image   = writes[0].m_image;
 
-			scratchBuffer.m_currentDs++;
+			const uint32_t numWrites = 2 + getUniformWrites(&writes[2], program, scratchBuffer, offsets);
+
+			bindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS, program, writes, numWrites, offsets, 1);
 
 			VertexBufferVK& vb  = m_vertexBuffers[_blitter.m_vb->handle.idx];
 			VkDeviceSize offset = 0;
@@ -2537,6 +2626,7 @@ VK_IMPORT_DEVICE
 			{
 				m_indexBuffers[_blitter.m_ib->handle.idx].update(m_commandBuffer, 0, _numIndices*2, _blitter.m_ib->data);
 				m_vertexBuffers[_blitter.m_vb->handle.idx].update(m_commandBuffer, 0, numVertices*_blitter.m_layout.m_stride, _blitter.m_vb->data, true);
+				flushCopyBuffers();
 
 				VkRenderPassBeginInfo rpbi;
 				rpbi.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -2597,7 +2687,7 @@ VK_IMPORT_DEVICE
 					release(m_captureMemory);
 
 					m_captureSize = captureSize;
-					VK_CHECK(createStagingBuffer(m_captureSize, &m_captureBuffer, &m_captureMemory) );
+					VK_CHECK(createStagingBuffer(m_captureSize, &m_captureBuffer, &m_captureMemory, NULL, false) );
 
 					m_captureData = BX_REALLOC(g_allocator, m_captureData, dstSize);
 				}
@@ -2627,6 +2717,7 @@ VK_IMPORT_DEVICE
 			if (m_depthClamp != depthClamp)
 			{
 				m_depthClamp = depthClamp;
+				finishPipelines(true);
 				m_pipelineStateCache.invalidate();
 			}
 
@@ -2673,6 +2764,10 @@ VK_IMPORT_DEVICE
 				m_backBuffer.update(m_commandBuffer, m_resolution);
 
 				postReset();
+
+				// Render targets are usually recreated on resize, return blocks
+				// that became empty back to driver.
+				m_memoryAllocator.defragment();
 			}
 
 			return suspended;
@@ -2787,6 +2882,7 @@ VK_IMPORT_DEVICE
 			if (m_wireframe != wireframe)
 			{
 				m_wireframe = wireframe;
+				finishPipelines(true);
 				m_pipelineStateCache.invalidate();
 			}
 		}
@@ -3221,12 +3317,13 @@ VK_IMPORT_DEVICE
 			return getRenderPass(BX_COUNTOF(formats), formats, aspects, resolve, samples, _renderPass);
 		}
 
-		VkSampler getSampler(uint32_t _samplerFlags, uint32_t _mipLevels)
+		VkSampler getSampler(uint32_t _samplerFlags, uint32_t _mipLevels, uint8_t _minLod)
 		{
 			bx::HashMurmur2A hash;
 			hash.begin();
 			hash.add(_samplerFlags);
 			hash.add(_mipLevels);
+			hash.add(_minLod);
 			uint32_t hashKey = hash.end();
 
 			VkSampler sampler = m_samplerCache.find(hashKey);
@@ -3253,7 +3350,7 @@ VK_IMPORT_DEVICE
 			sci.maxAnisotropy    = m_maxAnisotropy;
 			sci.compareEnable    = 0 != cmpFunc;
 			sci.compareOp        = s_cmpFunc[cmpFunc];
-			sci.minLod           = 0.0f;
+			sci.minLod           = float(_minLod);
 			sci.maxLod           = (float)_mipLevels;
 			sci.borderColor      = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
 			sci.unnormalizedCoordinates = VK_FALSE;
@@ -3345,126 +3442,51 @@ VK_IMPORT_DEVICE
 			VK_CHECK(vkCreateComputePipelines(m_device, m_pipelineCache, 1, &cpci, m_allocatorCb, &pipeline) );
 
 			m_pipelineStateCache.add(hash, pipeline);
+			m_pipelineCacheDirty = true;
 
 			return pipeline;
 		}
 
-		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData)
+		void setPipelineDesc(PipelineDescVK& _desc, uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, const ProgramVK& _program, uint8_t _numInstanceData, const FrameBufferVK& _frameBuffer)
 		{
-			ProgramVK& program = m_program[_program.idx];
-
-			_state &= 0
-				| BGFX_STATE_WRITE_RGB
-				| BGFX_STATE_WRITE_A
-				| BGFX_STATE_WRITE_Z
-				| BGFX_STATE_DEPTH_TEST_MASK
-				| BGFX_STATE_BLEND_MASK
-				| BGFX_STATE_BLEND_EQUATION_MASK
-				| (g_caps.supported & BGFX_CAPS_BLEND_INDEPENDENT ? BGFX_STATE_BLEND_INDEPENDENT : 0)
-				| BGFX_STATE_BLEND_ALPHA_TO_COVERAGE
-				| BGFX_STATE_CULL_MASK
-				| BGFX_STATE_FRONT_CCW
-				| BGFX_STATE_MSAA
-				| (m_lineAASupport ? BGFX_STATE_LINEAA : 0)
-				| (g_caps.supported & BGFX_CAPS_CONSERVATIVE_RASTER ? BGFX_STATE_CONSERVATIVE_RASTER : 0)
-				| BGFX_STATE_PT_MASK
-				;
-
-			_stencil &= packStencil(~BGFX_STENCIL_FUNC_REF_MASK, ~BGFX_STENCIL_FUNC_REF_MASK);
-
-			VertexLayout layout;
-			if (0 < _numStreams)
-			{
-				bx::memCopy(&layout, _layouts[0], sizeof(VertexLayout) );
-				const uint16_t* attrMask = program.m_vsh->m_attrMask;
-
-				for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
-				{
-					uint16_t mask = attrMask[ii];
-					uint16_t attr = (layout.m_attributes[ii] & mask);
-					layout.m_attributes[ii] = attr == 0 ? UINT16_MAX : attr == UINT16_MAX ? 0 : attr;
-				}
-			}
-
-			const FrameBufferVK& frameBuffer = isValid(m_fbh)
-				? m_frameBuffers[m_fbh.idx]
-				: m_backBuffer
-				;
-
-			bx::HashMurmur2A murmur;
-			murmur.begin();
-			murmur.add(_state);
-			murmur.add(_stencil);
-			murmur.add(program.m_vsh->m_hash);
-			murmur.add(program.m_vsh->m_attrMask, sizeof(program.m_vsh->m_attrMask) );
-
-			if (NULL != program.m_fsh)
-			{
-				murmur.add(program.m_fsh->m_hash);
-			}
-
-			for (uint8_t ii = 0; ii < _numStreams; ++ii)
-			{
-				murmur.add(_layouts[ii]->m_hash);
-			}
-
-			murmur.add(layout.m_attributes, sizeof(layout.m_attributes) );
-			murmur.add(_numInstanceData);
-			murmur.add(frameBuffer.m_renderPass);
-			const uint32_t hash = murmur.end();
-
-			VkPipeline pipeline = m_pipelineStateCache.find(hash);
-
-			if (VK_NULL_HANDLE != pipeline)
-			{
-				return pipeline;
-			}
-
-			VkPipelineColorBlendAttachmentState blendAttachmentState[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
-			VkPipelineColorBlendStateCreateInfo colorBlendState;
-			colorBlendState.pAttachments = blendAttachmentState;
+			VkPipelineColorBlendStateCreateInfo& colorBlendState = _desc.m_colorBlendState;
+			colorBlendState.pAttachments = _desc.m_blendAttachmentState;
 			setBlendState(colorBlendState, _state);
 
-			VkPipelineInputAssemblyStateCreateInfo inputAssemblyState;
+			VkPipelineInputAssemblyStateCreateInfo& inputAssemblyState = _desc.m_inputAssemblyState;
 			inputAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
 			inputAssemblyState.pNext = NULL;
 			inputAssemblyState.flags = 0;
 			inputAssemblyState.topology = s_primInfo[(_state&BGFX_STATE_PT_MASK) >> BGFX_STATE_PT_SHIFT].m_topology;
 			inputAssemblyState.primitiveRestartEnable = VK_FALSE;
 
-			VkPipelineRasterizationStateCreateInfo rasterizationState;
+			VkPipelineRasterizationStateCreateInfo& rasterizationState = _desc.m_rasterizationState;
 			setRasterizerState(rasterizationState, _state, m_wireframe);
 
 			VkBaseInStructure* nextRasterizationState = (VkBaseInStructure*)&rasterizationState;
 
-			VkPipelineRasterizationConservativeStateCreateInfoEXT conservativeRasterizationState;
 			if (s_extension[Extension::EXT_conservative_rasterization].m_supported)
 			{
-				nextRasterizationState->pNext = (VkBaseInStructure*)&conservativeRasterizationState;
-				nextRasterizationState = (VkBaseInStructure*)&conservativeRasterizationState;
-				setConservativeRasterizerState(conservativeRasterizationState, _state);
+				nextRasterizationState->pNext = (VkBaseInStructure*)&_desc.m_conservativeRasterizationState;
+				nextRasterizationState = (VkBaseInStructure*)&_desc.m_conservativeRasterizationState;
+				setConservativeRasterizerState(_desc.m_conservativeRasterizationState, _state);
 			}
 
-			VkPipelineRasterizationLineStateCreateInfoEXT lineRasterizationState;
 			if (m_lineAASupport)
 			{
-				nextRasterizationState->pNext = (VkBaseInStructure*)&lineRasterizationState;
-				nextRasterizationState = (VkBaseInStructure*)&lineRasterizationState;
-				setLineRasterizerState(lineRasterizationState, _state);
+				nextRasterizationState->pNext = (VkBaseInStructure*)&_desc.m_lineRasterizationState;
+				nextRasterizationState = (VkBaseInStructure*)&_desc.m_lineRasterizationState;
+				setLineRasterizerState(_desc.m_lineRasterizationState, _state);
 			}
 
-			VkPipelineDepthStencilStateCreateInfo depthStencilState;
-			setDepthStencilState(depthStencilState, _state, _stencil);
-
-			VkVertexInputBindingDescription  inputBinding[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
-			VkVertexInputAttributeDescription inputAttrib[Attrib::Count + BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT];
+			setDepthStencilState(_desc.m_depthStencilState, _state, _stencil);
 
-			VkPipelineVertexInputStateCreateInfo vertexInputState;
-			vertexInputState.pVertexBindingDescriptions   = inputBinding;
-			vertexInputState.pVertexAttributeDescriptions = inputAttrib;
-			setInputLayout(vertexInputState, _numStreams, _layouts, program, _numInstanceData);
+			VkPipelineVertexInputStateCreateInfo& vertexInputState = _desc.m_vertexInputState;
+			vertexInputState.pVertexBindingDescriptions   = _desc.m_inputBinding;
+			vertexInputState.pVertexAttributeDescriptions = _desc.m_inputAttrib;
+			setInputLayout(vertexInputState, _numStreams, _layouts, _program, _numInstanceData);
 
-			const VkDynamicState dynamicStates[] =
+			static const VkDynamicState dynamicStates[] =
 			{
 				VK_DYNAMIC_STATE_VIEWPORT,
 				VK_DYNAMIC_STATE_SCISSOR,
@@ -3472,34 +3494,34 @@ VK_IMPORT_DEVICE
 				VK_DYNAMIC_STATE_STENCIL_REFERENCE,
 			};
 
-			VkPipelineDynamicStateCreateInfo dynamicState;
+			VkPipelineDynamicStateCreateInfo& dynamicState = _desc.m_dynamicState;
 			dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
 			dynamicState.pNext = NULL;
 			dynamicState.flags = 0;
 			dynamicState.dynamicStateCount = BX_COUNTOF(dynamicStates);
 			dynamicState.pDynamicStates    = dynamicStates;
 
-			VkPipelineShaderStageCreateInfo shaderStages[2];
+			VkPipelineShaderStageCreateInfo* shaderStages = _desc.m_shaderStages;
 			shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 			shaderStages[0].pNext = NULL;
 			shaderStages[0].flags = 0;
 			shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-			shaderStages[0].module = program.m_vsh->m_module;
+			shaderStages[0].module = _program.m_vsh->m_module;
 			shaderStages[0].pName  = "main";
 			shaderStages[0].pSpecializationInfo = NULL;
 
-			if (NULL != program.m_fsh)
+			if (NULL != _program.m_fsh)
 			{
 				shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 				shaderStages[1].pNext = NULL;
 				shaderStages[1].flags = 0;
 				shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-				shaderStages[1].module = program.m_fsh->m_module;
+				shaderStages[1].module = _program.m_fsh->m_module;
 				shaderStages[1].pName  = "main";
 				shaderStages[1].pSpecializationInfo = NULL;
 			}
 
-			VkPipelineViewportStateCreateInfo viewportState;
+			VkPipelineViewportStateCreateInfo& viewportState = _desc.m_viewportState;
 			viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
 			viewportState.pNext = NULL;
 			viewportState.flags = 0;
@@ -3508,22 +3530,22 @@ VK_IMPORT_DEVICE
 			viewportState.scissorCount  = 1;
 			viewportState.pScissors     = NULL;
 
-			VkPipelineMultisampleStateCreateInfo multisampleState;
+			VkPipelineMultisampleStateCreateInfo& multisampleState = _desc.m_multisampleState;
 			multisampleState.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
 			multisampleState.pNext = NULL;
 			multisampleState.flags = 0;
-			multisampleState.rasterizationSamples  = frameBuffer.m_sampler.Sample;
+			multisampleState.rasterizationSamples  = _frameBuffer.m_sampler.Sample;
 			multisampleState.sampleShadingEnable   = VK_FALSE;
 			multisampleState.minSampleShading      = 0.0f;
 			multisampleState.pSampleMask           = NULL;
 			multisampleState.alphaToCoverageEnable = !!(BGFX_STATE_BLEND_ALPHA_TO_COVERAGE & _state);
 			multisampleState.alphaToOneEnable      = VK_FALSE;
 
-			VkGraphicsPipelineCreateInfo graphicsPipeline;
+			VkGraphicsPipelineCreateInfo& graphicsPipeline = _desc.m_graphicsPipeline;
 			graphicsPipeline.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 			graphicsPipeline.pNext = NULL;
 			graphicsPipeline.flags = 0;
-			graphicsPipeline.stageCount = NULL == program.m_fsh ? 1 : 2;
+			graphicsPipeline.stageCount = NULL == _program.m_fsh ? 1 : 2;
 			graphicsPipeline.pStages    = shaderStages;
 			graphicsPipeline.pVertexInputState   = &vertexInputState;
 			graphicsPipeline.pInputAssemblyState = &inputAssemblyState;
@@ -3531,108 +3553,219 @@ VK_IMPORT_DEVICE
 			graphicsPipeline.pViewportState      = &viewportState;
 			graphicsPipeline.pRasterizationState = &rasterizationState;
 			graphicsPipeline.pMultisampleState   = &multisampleState;
-			graphicsPipeline.pDepthStencilState  = &depthStencilState;
+			graphicsPipeline.pDepthStencilState  = &_desc.m_depthStencilState;
 			graphicsPipeline.pColorBlendState    = &colorBlendState;
 			graphicsPipeline.pDynamicState       = &dynamicState;
-			graphicsPipeline.layout     = program.m_pipelineLayout;
-			graphicsPipeline.renderPass = frameBuffer.m_renderPass;
+			graphicsPipeline.layout     = _program.m_pipelineLayout;
+			graphicsPipeline.renderPass = _frameBuffer.m_renderPass;
 			graphicsPipeline.subpass    = 0;
 			graphicsPipeline.basePipelineHandle = VK_NULL_HANDLE;
 			graphicsPipeline.basePipelineIndex  = 0;
+		}
 
-			uint32_t length = g_callback->cacheReadSize(hash);
-			bool cached = length > 0;
+		void defragment() override
+		{
+			m_memoryAllocator.defragment();
+		}
 
-			void* cachedData = NULL;
+		void flushPipelineCache() override
+		{
+			if (!m_pipelineCacheDirty)
+			{
+				return;
+			}
 
-			VkPipelineCacheCreateInfo pcci;
-			pcci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-			pcci.pNext = NULL;
-			pcci.flags = 0;
-			pcci.initialDataSize = 0;
-			pcci.pInitialData    = NULL;
+			m_pipelineCacheDirty = false;
 
-			if (cached)
-			{
-				cachedData = BX_ALLOC(g_allocator, length);
-				if (g_callback->cacheRead(hash, cachedData, length) )
-				{
-					BX_TRACE("Loading cached pipeline state (size %d).", length);
-					bx::MemoryReader reader(cachedData, length);
+			size_t dataSize;
+			VK_CHECK(vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, NULL) );
 
-					pcci.initialDataSize = (size_t)reader.remaining();
-					pcci.pInitialData    = reader.getDataPtr();
-				}
+			if (0 < dataSize)
+			{
+				void* data = BX_ALLOC(g_allocator, dataSize);
+				VK_CHECK(vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, data) );
+				pipelineCacheWrite(getPipelineCacheId(RendererType::Vulkan), m_pipelineCacheHeader, data, uint32_t(dataSize) );
+				BX_FREE(g_allocator, data);
 			}
+		}
 
-			VkPipelineCache cache;
-			VK_CHECK(vkCreatePipelineCache(m_device, &pcci, m_allocatorCb, &cache) );
+		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint8_t _numStreams, const VertexLayout** _layouts, ProgramHandle _program, uint8_t _numInstanceData, FrameBufferHandle _fbh, bool _async = false)
+		{
+			ProgramVK& program = m_program[_program.idx];
 
-			VK_CHECK(vkCreateGraphicsPipelines(
-				  m_device
-				, cache
-				, 1
-				, &graphicsPipeline
-				, m_allocatorCb
-				, &pipeline
-				) );
-			m_pipelineStateCache.add(hash, pipeline);
+			_state &= 0
+				| BGFX_STATE_WRITE_RGB
+				| BGFX_STATE_WRITE_A
+				| BGFX_STATE_WRITE_Z
+				| BGFX_STATE_DEPTH_TEST_MASK
+				| BGFX_STATE_BLEND_MASK
+				| BGFX_STATE_BLEND_EQUATION_MASK
+				| (g_caps.supported & BGFX_CAPS_BLEND_INDEPENDENT ? BGFX_STATE_BLEND_INDEPENDENT : 0)
+				| BGFX_STATE_BLEND_ALPHA_TO_COVERAGE
+				| BGFX_STATE_CULL_MASK
+				| BGFX_STATE_FRONT_CCW
+				| BGFX_STATE_MSAA
+				| (m_lineAASupport ? BGFX_STATE_LINEAA : 0)
+				| (g_caps.supported & BGFX_CAPS_CONSERVATIVE_RASTER ? BGFX_STATE_CONSERVATIVE_RASTER : 0)
+				| BGFX_STATE_PT_MASK
+				;
 
-			size_t dataSize;
-			VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, NULL) );
+			_stencil &= packStencil(~BGFX_STENCIL_FUNC_REF_MASK, ~BGFX_STENCIL_FUNC_REF_MASK);
 
-			if (0 < dataSize)
+			VertexLayout layout;
+			if (0 < _numStreams)
 			{
-				if (length < dataSize)
+				bx::memCopy(&layout, _layouts[0], sizeof(VertexLayout) );
+				const uint16_t* attrMask = program.m_vsh->m_attrMask;
+
+				for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
 				{
-					cachedData = BX_REALLOC(g_allocator, cachedData, dataSize);
+					uint16_t mask = attrMask[ii];
+					uint16_t attr = (layout.m_attributes[ii] & mask);
+					layout.m_attributes[ii] = attr == 0 ? UINT16_MAX : attr == UINT16_MAX ? 0 : attr;
 				}
-
-				VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, cachedData) );
-				g_callback->cacheWrite(hash, cachedData, (uint32_t)dataSize);
 			}
 
-			VK_CHECK(vkMergePipelineCaches(m_device, m_pipelineCache, 1, &cache) );
-			vkDestroy(cache);
+			const FrameBufferVK& frameBuffer = isValid(_fbh)
+				? m_frameBuffers[_fbh.idx]
+				: m_backBuffer
+				;
+
+			bx::HashMurmur2A murmur;
+			murmur.begin();
+			murmur.add(_state);
+			murmur.add(_stencil);
+			murmur.add(program.m_vsh->m_hash);
+			murmur.add(program.m_vsh->m_attrMask, sizeof(program.m_vsh->m_attrMask) );
 
-			if (NULL != cachedData)
+			if (NULL != program.m_fsh)
 			{
-				BX_FREE(g_allocator, cachedData);
+				murmur.add(program.m_fsh->m_hash);
 			}
 
-			return pipeline;
-		}
+			for (uint8_t ii = 0; ii < _numStreams; ++ii)
+			{
+				murmur.add(_layouts[ii]->m_hash);
+			}
 
-		void allocDescriptorSet(const ProgramVK& program, const RenderBind& renderBind, ScratchBufferVK& scratchBuffer)
-		{
-			VkDescriptorSetAllocateInfo dsai;
-			dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			dsai.pNext              = NULL;
-			dsai.descriptorPool     = m_descriptorPool;
-			dsai.descriptorSetCount = 1;
-			dsai.pSetLayouts        = &program.m_descriptorSetLayout;
+			murmur.add(layout.m_attributes, sizeof(layout.m_attributes) );
+			murmur.add(_numInstanceData);
+			murmur.add(frameBuffer.m_renderPass);
+			const uint32_t hash = murmur.end();
 
-			VkDescriptorSet& descriptorSet = scratchBuffer.m_descriptorSet[scratchBuffer.m_currentDs];
-			vkAllocateDescriptorSets(m_device, &dsai, &descriptorSet);
-			scratchBuffer.m_currentDs++;
+			VkPipeline pipeline = m_pipelineStateCache.find(hash);
 
-			VkDescriptorImageInfo  imageInfo[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
-			VkDescriptorBufferInfo bufferInfo[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
+			if (VK_NULL_HANDLE != pipeline)
+			{
+				return pipeline;
+			}
 
-			constexpr int32_t kMaxDescriptorSets = 2 * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS + 2;
-			VkWriteDescriptorSet wds[kMaxDescriptorSets] = {};
+			if (_async
+			&&  m_pipelineCompiler.isEnabled() )
+			{
+				if (!m_pipelineCompiler.isPending(hash) )
+				{
+					PipelineCompilerVK::Job* job = BX_NEW(g_allocator, PipelineCompilerVK::Job);
+					job->m_pipeline = VK_NULL_HANDLE;
+					job->m_hash     = hash;
+					setPipelineDesc(job->m_desc, _state, _stencil, _numStreams, _layouts, program, _numInstanceData, frameBuffer);
 
-			uint32_t wdsCount    = 0;
-			uint32_t bufferCount = 0;
-			uint32_t imageCount  = 0;
+					m_pipelineCompiler.push(job);
+				}
 
-			for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
-			{
-				const Binding& bind = renderBind.m_bind[stage];
-				const BindInfo& bindInfo = program.m_bindInfo[stage];
+				return VK_NULL_HANDLE;
+			}
 
-				if (kInvalidHandle != bind.m_idx
-				&&  isValid(bindInfo.uniformHandle) )
+			PipelineDescVK desc;
+			setPipelineDesc(desc, _state, _stencil, _numStreams, _layouts, program, _numInstanceData, frameBuffer);
+
+			VK_CHECK(vkCreateGraphicsPipelines(
+				  m_device
+				, m_pipelineCache
+				, 1
+				, &desc.m_graphicsPipeline
+				, m_allocatorCb
+				, &pipeline
+				) );
+			m_pipelineStateCache.add(hash, pipeline);
+			m_pipelineCacheDirty = true;
+
+			return pipeline;
+		}
+
+		void finishPipelines(bool _wait)
+		{
+			for (PipelineCompilerVK::Job* job = m_pipelineCompiler.pop(_wait); NULL != job; job = m_pipelineCompiler.pop(_wait) )
+			{
+				if (VK_NULL_HANDLE != job->m_pipeline)
+				{
+					if (VK_NULL_HANDLE == m_pipelineStateCache.find(job->m_hash) )
+					{
+						m_pipelineStateCache.add(job->m_hash, job->m_pipeline);
+					}
+					else
+					{
+						// Same pipeline was meanwhile compiled on render thread.
+						release(job->m_pipeline);
+					}
+
+					m_pipelineCacheDirty = true;
+				}
+
+				BX_DELETE(g_allocator, job);
+			}
+		}
+
+		// Sampler and texture use separate bindings, and there are up to two uniform buffers.
+		static constexpr uint32_t kMaxDescriptorWrites = 2 * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS + 2;
+
+		// Calling thread participates in running jobs.
+		static constexpr uint32_t kMaxRecordJobs = JobPool::kMaxThreads + 1;
+
+		// Transitions bound images to layout their descriptors expect. It's done separately, so
+		// that descriptor writes can be created on threads that don't own command buffer.
+		void setBindImageLayouts(const ProgramVK& _program, const RenderBind& _renderBind)
+		{
+			for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+			{
+				const Binding& bind = _renderBind.m_bind[stage];
+				const BindInfo& bindInfo = _program.m_bindInfo[stage];
+
+				if (kInvalidHandle != bind.m_idx
+				&&  isValid(bindInfo.uniformHandle)
+				&& (Binding::Image   == bind.m_type
+				||  Binding::Texture == bind.m_type) )
+				{
+					TextureVK& texture = m_textures[bind.m_idx];
+
+					if (VK_IMAGE_LAYOUT_GENERAL != texture.m_currentImageLayout)
+					{
+						const VkImageLayout layout = Binding::Image == bind.m_type && BindType::Image == bindInfo.type
+							? VK_IMAGE_LAYOUT_GENERAL
+							: VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+							;
+						texture.setImageMemoryBarrier(m_commandBuffer, layout);
+					}
+				}
+			}
+		}
+
+		uint32_t getDescriptorWrites(DescriptorWriteVK* _writes, const ProgramVK& _program, const RenderBind& _renderBind, bool _setImageLayouts = true)
+		{
+			if (_setImageLayouts)
+			{
+				setBindImageLayouts(_program, _renderBind);
+			}
+
+			uint32_t num = 0;
+
+			for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+			{
+				const Binding& bind = _renderBind.m_bind[stage];
+				const BindInfo& bindInfo = _program.m_bindInfo[stage];
+
+				if (kInvalidHandle != bind.m_idx
+				&&  isValid(bindInfo.uniformHandle) )
 				{
 					switch (bind.m_type)
 					{
@@ -3640,35 +3773,12 @@ VK_IMPORT_DEVICE
 						{
 							const bool isImageDescriptor = BindType::Image == bindInfo.type;
 
-							wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-							wds[wdsCount].pNext            = NULL;
-							wds[wdsCount].dstSet           = descriptorSet;
-							wds[wdsCount].dstBinding       = bindInfo.binding;
-							wds[wdsCount].dstArrayElement  = 0;
-							wds[wdsCount].descriptorCount  = 1;
-							wds[wdsCount].descriptorType   = isImageDescriptor
-								? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
-								: VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE
-								;
-							wds[wdsCount].pImageInfo       = NULL;
-							wds[wdsCount].pBufferInfo      = NULL;
-							wds[wdsCount].pTexelBufferView = NULL;
-
-							TextureVK& texture = m_textures[bind.m_idx];
-
-							if (VK_IMAGE_LAYOUT_GENERAL != texture.m_currentImageLayout)
-							{
-								const VkImageLayout layout = isImageDescriptor
-									? VK_IMAGE_LAYOUT_GENERAL
-									: VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-									;
-								texture.setImageMemoryBarrier(m_commandBuffer, layout);
-							}
+							const TextureVK& texture = m_textures[bind.m_idx];
 
 							VkImageViewType type = texture.m_type;
 							if (UINT32_MAX != bindInfo.index)
 							{
-								type = program.m_textures[bindInfo.index].type;
+								type = _program.m_textures[bindInfo.index].type;
 							}
 							else if (type == VK_IMAGE_VIEW_TYPE_CUBE
 							     ||  type == VK_IMAGE_VIEW_TYPE_CUBE_ARRAY)
@@ -3676,158 +3786,208 @@ VK_IMPORT_DEVICE
 								type = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
 							}
 
-							imageInfo[imageCount].imageLayout = texture.m_currentImageLayout;
-							imageInfo[imageCount].sampler     = VK_NULL_HANDLE;
-							imageInfo[imageCount].imageView   = getCachedImageView(
+							DescriptorWriteVK& write = _writes[num++];
+							write.m_type    = isImageDescriptor
+								? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
+								: VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE
+								;
+							write.m_binding = bindInfo.binding;
+							write.m_image.imageLayout = texture.m_currentImageLayout;
+							write.m_image.sampler     = VK_NULL_HANDLE;
+							write.m_image.imageView   = getCachedImageView(
 								  { bind.m_idx }
 								, bind.m_mip
 								, 1
 								, type
 								);
-							wds[wdsCount].pImageInfo = &imageInfo[imageCount];
-							++imageCount;
-
-							++wdsCount;
 						}
 						break;
 
 					case Binding::VertexBuffer:
 					case Binding::IndexBuffer:
 						{
-							wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-							wds[wdsCount].pNext            = NULL;
-							wds[wdsCount].dstSet           = descriptorSet;
-							wds[wdsCount].dstBinding       = bindInfo.binding;
-							wds[wdsCount].dstArrayElement  = 0;
-							wds[wdsCount].descriptorCount  = 1;
-							wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-							wds[wdsCount].pImageInfo       = NULL;
-							wds[wdsCount].pBufferInfo      = NULL;
-							wds[wdsCount].pTexelBufferView = NULL;
-
 							BufferVK& sb = bind.m_type == Binding::VertexBuffer ? m_vertexBuffers[bind.m_idx] : m_indexBuffers[bind.m_idx];
-							bufferInfo[bufferCount].buffer = sb.m_buffer;
-							bufferInfo[bufferCount].offset = 0;
-							bufferInfo[bufferCount].range  = sb.m_size;
-							wds[wdsCount].pBufferInfo = &bufferInfo[bufferCount];
-							++bufferCount;
 
-							++wdsCount;
+							DescriptorWriteVK& write = _writes[num++];
+							write.m_type    = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+							write.m_binding = bindInfo.binding;
+							write.m_buffer.buffer = sb.m_buffer;
+							write.m_buffer.offset = 0;
+							write.m_buffer.range  = sb.m_size;
 						}
 						break;
 
 					case Binding::Texture:
 						{
-							TextureVK& texture = m_textures[bind.m_idx];
+							const TextureVK& texture = m_textures[bind.m_idx];
 							VkSampler sampler = getSampler(
 								(0 == (BGFX_SAMPLER_INTERNAL_DEFAULT & bind.m_samplerFlags)
 									? bind.m_samplerFlags
 									: (uint32_t)texture.m_flags
 								) & (BGFX_SAMPLER_BITS_MASK | BGFX_SAMPLER_BORDER_COLOR_MASK)
 								, texture.m_numMips
+								, texture.m_minLod
 								);
 
-							if (VK_IMAGE_LAYOUT_GENERAL != texture.m_currentImageLayout)
-							{
-								texture.setImageMemoryBarrier(m_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-							}
-
 							const VkImageViewType type = UINT32_MAX == bindInfo.index
 								? texture.m_type
-								: program.m_textures[bindInfo.index].type
+								: _program.m_textures[bindInfo.index].type
 								;
 
-							imageInfo[imageCount].imageLayout = texture.m_currentImageLayout;
-							imageInfo[imageCount].sampler     = sampler;
-							imageInfo[imageCount].imageView   = getCachedImageView(
+							DescriptorWriteVK& write = _writes[num++];
+							write.m_type    = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+							write.m_binding = bindInfo.binding;
+							write.m_image.imageLayout = texture.m_currentImageLayout;
+							write.m_image.sampler     = sampler;
+							write.m_image.imageView   = getCachedImageView(
 								  { bind.m_idx }
 								, 0
 								, texture.m_numMips
 								, type
 								);
 
-							wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-							wds[wdsCount].pNext            = NULL;
-							wds[wdsCount].dstSet           = descriptorSet;
-							wds[wdsCount].dstBinding       = bindInfo.binding;
-							wds[wdsCount].dstArrayElement  = 0;
-							wds[wdsCount].descriptorCount  = 1;
-							wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-							wds[wdsCount].pImageInfo       = &imageInfo[imageCount];
-							wds[wdsCount].pBufferInfo      = NULL;
-							wds[wdsCount].pTexelBufferView = NULL;
-							++wdsCount;
-
-							wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-							wds[wdsCount].pNext            = NULL;
-							wds[wdsCount].dstSet           = descriptorSet;
-							wds[wdsCount].dstBinding       = bindInfo.samplerBinding;
-							wds[wdsCount].dstArrayElement  = 0;
-							wds[wdsCount].descriptorCount  = 1;
-							wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_SAMPLER;
-							wds[wdsCount].pImageInfo       = &imageInfo[imageCount];
-							wds[wdsCount].pBufferInfo      = NULL;
-							wds[wdsCount].pTexelBufferView = NULL;
-							++wdsCount;
-
-							++imageCount;
+							DescriptorWriteVK& samplerWrite = _writes[num++];
+							samplerWrite.m_type    = VK_DESCRIPTOR_TYPE_SAMPLER;
+							samplerWrite.m_binding = bindInfo.samplerBinding;
+							samplerWrite.m_image   = write.m_image;
 						}
 						break;
 					}
 				}
 			}
 
-			const uint32_t vsize = program.m_vsh->m_size;
-			const uint32_t fsize = NULL != program.m_fsh ? program.m_fsh->m_size : 0;
-			const uint32_t total = vsize + fsize;
+			return num;
+		}
+
+		uint32_t getUniformWrites(DescriptorWriteVK* _writes, const ProgramVK& _program, const ScratchBufferVK& _scratchBuffer, const uint32_t* _offsets)
+		{
+			// Descriptor sets use dynamic uniform buffers, with offset passed when descriptor
+			// set is bound. Push descriptors can't be dynamic, and offset is part of descriptor.
+			const VkDescriptorType type = _program.m_pushDescriptor
+				? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+				: VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
+				;
+
+			const uint32_t vsize = _program.m_vsh->m_size;
+			const uint32_t fsize = NULL != _program.m_fsh ? _program.m_fsh->m_size : 0;
+
+			uint32_t num = 0;
 
-			if (0 < total)
+			if (vsize > 0)
 			{
-				uint32_t vsUniformBinding = program.m_vsh->m_uniformBinding;
-				uint32_t fsUniformBinding = NULL != program.m_fsh ? program.m_fsh->m_uniformBinding : 0;
+				DescriptorWriteVK& write = _writes[num];
+				write.m_type    = type;
+				write.m_binding = _program.m_vsh->m_uniformBinding;
+				write.m_buffer.buffer = _scratchBuffer.m_buffer;
+				write.m_buffer.offset = _program.m_pushDescriptor ? _offsets[num] : 0;
+				write.m_buffer.range  = vsize;
+				++num;
+			}
 
-				if (vsize > 0)
-				{
-					bufferInfo[bufferCount].buffer = scratchBuffer.m_buffer;
-					bufferInfo[bufferCount].offset = 0;
-					bufferInfo[bufferCount].range  = vsize;
-
-					wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-					wds[wdsCount].pNext            = NULL;
-					wds[wdsCount].dstSet           = descriptorSet;
-					wds[wdsCount].dstBinding       = vsUniformBinding;
-					wds[wdsCount].dstArrayElement  = 0;
-					wds[wdsCount].descriptorCount  = 1;
-					wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-					wds[wdsCount].pImageInfo       = NULL;
-					wds[wdsCount].pBufferInfo      = &bufferInfo[bufferCount];
-					wds[wdsCount].pTexelBufferView = NULL;
-					++wdsCount;
-					++bufferCount;
-				}
+			if (fsize > 0)
+			{
+				DescriptorWriteVK& write = _writes[num];
+				write.m_type    = type;
+				write.m_binding = _program.m_fsh->m_uniformBinding;
+				write.m_buffer.buffer = _scratchBuffer.m_buffer;
+				write.m_buffer.offset = _program.m_pushDescriptor ? _offsets[num] : 0;
+				write.m_buffer.range  = fsize;
+				++num;
+			}
 
-				if (fsize > 0)
+			return num;
+		}
+
+		static uint32_t toWriteDescriptorSet(VkWriteDescriptorSet* _wds, VkDescriptorSet _descriptorSet, const DescriptorWriteVK* _writes, uint32_t _num)
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				const DescriptorWriteVK& write = _writes[ii];
+				const bool isBuffer = write.isBuffer();
+
+				VkWriteDescriptorSet& wds = _wds[ii];
+				wds.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				wds.pNext            = NULL;
+				wds.dstSet           = _descriptorSet;
+				wds.dstBinding       = write.m_binding;
+				wds.dstArrayElement  = 0;
+				wds.descriptorCount  = 1;
+				wds.descriptorType   = write.m_type;
+				wds.pImageInfo       = isBuffer ? NULL : &write.m_image;
+				wds.pBufferInfo      = isBuffer ? &write.m_buffer : NULL;
+				wds.pTexelBufferView = NULL;
+			}
+
+			return _num;
+		}
+
+		// Returns descriptor set from cache. Sets that can't be cached are allocated from
+		// `_allocator`, or from render thread's transient allocator when it's NULL. Record jobs
+		// must hold m_cacheMutex.
+		VkDescriptorSet getDescriptorSet(const ProgramVK& _program, const DescriptorWriteVK* _writes, uint32_t _num, DescriptorAllocatorVK* _allocator = NULL)
+		{
+			bx::HashMurmur2A murmur;
+			murmur.begin();
+			murmur.add(_program.m_descriptorSetLayout);
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				_writes[ii].hash(murmur);
+			}
+			const uint32_t hash = murmur.end();
+
+			VkDescriptorSet descriptorSet = m_descriptorSetCache.find(hash, _program.m_descriptorSetLayout, _writes, _num);
+
+			if (VK_NULL_HANDLE == descriptorSet)
+			{
+				descriptorSet = m_descriptorSetCache.add(hash, _program.m_descriptorSetLayout, _writes, _num);
+
+				if (VK_NULL_HANDLE == descriptorSet)
 				{
-					bufferInfo[bufferCount].buffer = scratchBuffer.m_buffer;
-					bufferInfo[bufferCount].offset = 0;
-					bufferInfo[bufferCount].range  = fsize;
-
-					wds[wdsCount].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-					wds[wdsCount].pNext            = NULL;
-					wds[wdsCount].dstSet           = descriptorSet;
-					wds[wdsCount].dstBinding       = fsUniformBinding;
-					wds[wdsCount].dstArrayElement  = 0;
-					wds[wdsCount].descriptorCount  = 1;
-					wds[wdsCount].descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-					wds[wdsCount].pImageInfo       = NULL;
-					wds[wdsCount].pBufferInfo      = &bufferInfo[bufferCount];
-					wds[wdsCount].pTexelBufferView = NULL;
-					++wdsCount;
-					++bufferCount;
+					DescriptorAllocatorVK& allocator = NULL != _allocator
+						? *_allocator
+						: m_recordDescriptor[m_cmd.m_currentFrameInFlight][0]
+						;
+					return allocator.alloc(_program.m_descriptorSetLayout, _writes, _num);
 				}
 			}
 
-			vkUpdateDescriptorSets(m_device, wdsCount, wds, 0, NULL);
+			return descriptorSet;
+		}
+
+		static void pushDescriptorSet(VkCommandBuffer _commandBuffer, VkPipelineBindPoint _bindPoint, VkPipelineLayout _layout, const DescriptorWriteVK* _writes, uint32_t _num)
+		{
+			VkWriteDescriptorSet wds[kMaxDescriptorWrites];
+			vkCmdPushDescriptorSetKHR(
+				  _commandBuffer
+				, _bindPoint
+				, _layout
+				, 0
+				, toWriteDescriptorSet(wds, VK_NULL_HANDLE, _writes, _num)
+				, wds
+				);
+		}
+
+		void bindDescriptorSet(VkPipelineBindPoint _bindPoint, const ProgramVK& _program, const DescriptorWriteVK* _writes, uint32_t _num, const uint32_t* _offsets, uint32_t _numOffsets)
+		{
+			if (_program.m_pushDescriptor)
+			{
+				pushDescriptorSet(m_commandBuffer, _bindPoint, _program.m_pipelineLayout, _writes, _num);
+			}
+			else
+			{
+				const VkDescriptorSet descriptorSet = getDescriptorSet(_program, _writes, _num);
+
+				vkCmdBindDescriptorSets(
+					  m_commandBuffer
+					, _bindPoint
+					, _program.m_pipelineLayout
+					, 0
+					, 1
+					, &descriptorSet
+					, _numOffsets
+					, _offsets
+					);
+			}
 		}
 
 		bool isSwapChainReadable(const SwapChainVK& _swapChain)
@@ -3842,7 +4002,7 @@ VK_IMPORT_DEVICE
 
 		typedef void (*SwapChainReadFunc)(void* /*src*/, uint32_t /*width*/, uint32_t /*height*/, uint32_t /*pitch*/, const void* /*userData*/);
 
-		bool readSwapChain(const SwapChainVK& _swapChain, VkBuffer _buffer, VkDeviceMemory _memory, SwapChainReadFunc _func, const void* _userData = NULL)
+		bool readSwapChain(const SwapChainVK& _swapChain, VkBuffer _buffer, const DeviceMemoryAllocationVK& _memory, SwapChainReadFunc _func, const void* _userData = NULL)
 		{
 			if (isSwapChainReadable(_swapChain) )
 			{
@@ -3862,8 +4022,7 @@ VK_IMPORT_DEVICE
 				// stall for commandbuffer to finish
 				kick(true);
 
-				uint8_t* src;
-				VK_CHECK(vkMapMemory(m_device, _memory, 0, VK_WHOLE_SIZE, 0, (void**)&src) );
+				uint8_t* src = _memory.m_data;
 
 				if (_swapChain.m_colorFormat == TextureFormat::RGBA8)
 				{
@@ -3888,8 +4047,6 @@ VK_IMPORT_DEVICE
 					BX_FREE(g_allocator, dst);
 				}
 
-				vkUnmapMemory(m_device, _memory);
-
 				readback.destroy();
 
 				return true;
@@ -3914,6 +4071,28 @@ VK_IMPORT_DEVICE
 			}
 		}
 
+		// Writes vertex and fragment shader constants to scratch buffer, fragment shader constants
+		// follow at scratch buffer alignment. Returns offset of vertex shader constants.
+		uint32_t writeConstants(ScratchBufferVK& _scratchBuffer, const ProgramVK& _program, const RenderDraw& _draw, bool _hasPredefined)
+		{
+			const uint32_t vsize = _program.m_vsh->m_size;
+			const uint32_t fsize = NULL != _program.m_fsh ? _program.m_fsh->m_size : 0;
+
+			// Draw that takes all its uniforms from uniform block has same constants as other
+			// draws using the same block with the same program.
+			if (isValid(_draw.m_uniformBlock)
+			&&  _draw.m_uniformBegin == _draw.m_uniformEnd
+			&&  !_hasPredefined)
+			{
+				return m_uniformCache.write(_scratchBuffer, m_vsScratch, vsize, m_fsScratch, fsize);
+			}
+
+			const uint32_t offset = _scratchBuffer.write(m_vsScratch, vsize);
+			_scratchBuffer.write(m_fsScratch, fsize);
+
+			return offset;
+		}
+
 		void commit(UniformBuffer& _uniformBuffer)
 		{
 			_uniformBuffer.reset();
@@ -4085,6 +4264,8 @@ VK_IMPORT_DEVICE
 
 		void kick(bool _finishAll = false)
 		{
+			flushCopyBuffers();
+
 			m_cmd.kick(_finishAll);
 			VK_CHECK(m_cmd.alloc(&m_commandBuffer) );
 			m_cmd.finish(_finishAll);
@@ -4132,7 +4313,7 @@ VK_IMPORT_DEVICE
 			return result;
 		}
 
-		VkResult createStagingBuffer(uint32_t _size, ::VkBuffer* _buffer, ::VkDeviceMemory* _memory, const void* _data = NULL)
+		VkResult createStagingBuffer(uint32_t _size, ::VkBuffer* _buffer, DeviceMemoryAllocationVK* _memory, const void* _data = NULL, bool _transient = true)
 		{
 			VkResult result = VK_SUCCESS;
 
@@ -4156,14 +4337,19 @@ VK_IMPORT_DEVICE
 			VkMemoryRequirements mr;
 			vkGetBufferMemoryRequirements(m_device, *_buffer, &mr);
 
-			result = allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, _memory);
+			result = m_memoryAllocator.alloc(
+				  mr
+				, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+				, _transient ? DeviceMemoryAllocatorVK::Usage::Transient : DeviceMemoryAllocatorVK::Usage::Buffer
+				, _memory
+				);
 			if (VK_SUCCESS != result)
 			{
 				BX_TRACE("Create staging buffer error: vkAllocateMemory failed %d: %s.", result, getName(result) );
 				return result;
 			}
 
-			result = vkBindBufferMemory(m_device, *_buffer, *_memory, 0);
+			result = vkBindBufferMemory(m_device, *_buffer, _memory->m_mem, _memory->m_offset);
 			if (VK_SUCCESS != result)
 			{
 				BX_TRACE("Create staging buffer error: vkBindBufferMemory failed %d: %s.", result, getName(result) );
@@ -4172,19 +4358,126 @@ VK_IMPORT_DEVICE
 
 			if (_data != NULL)
 			{
-				void* dst;
-				result = vkMapMemory(m_device, *_memory, 0, _size, 0, &dst);
-				if (VK_SUCCESS != result)
+				bx::memCopy(_memory->m_data, _data, _size);
+			}
+
+			return result;
+		}
+
+		StagingBufferVK allocStagingBuffer(uint32_t _size, uint32_t _align, const void* _data = NULL)
+		{
+			StagingBufferVK staging;
+
+			if (!m_stagingRing[m_cmd.m_currentFrameInFlight].alloc(_size, _align, &staging) )
+			{
+				staging.m_offset   = 0;
+				staging.m_size     = _size;
+				staging.m_fromRing = false;
+				VK_CHECK(createStagingBuffer(_size, &staging.m_buffer, &staging.m_deviceMem) );
+				staging.m_data = staging.m_deviceMem.m_data;
+			}
+
+			if (NULL != _data)
+			{
+				bx::memCopy(staging.m_data, _data, _size);
+			}
+
+			return staging;
+		}
+
+		void releaseStagingBuffer(StagingBufferVK& _staging)
+		{
+			if (!_staging.m_fromRing)
+			{
+				release(_staging.m_buffer);
+				release(_staging.m_deviceMem);
+			}
+		}
+
+		// Buffer copies are deferred and recorded as one vkCmdCopyBuffer per source and
+		// destination pair, on flush.
+		void copyBuffer(VkBuffer _src, VkBuffer _dst, const VkBufferCopy& _region)
+		{
+			if (m_bufferCopy.size() >= kMaxPendingBufferCopies)
+			{
+				flushCopyBuffers();
+			}
+			else
+			{
+				// Regions of single copy command must not overlap.
+				for (const BufferCopy& copy : m_bufferCopy)
 				{
-					BX_TRACE("Create staging buffer error: vkMapMemory failed %d: %s.", result, getName(result) );
-					return result;
+					if (copy.m_dst.vk == _dst.vk
+					&&  copy.m_region.dstOffset < _region.dstOffset + _region.size
+					&&  _region.dstOffset < copy.m_region.dstOffset + copy.m_region.size)
+					{
+						flushCopyBuffers();
+						break;
+					}
 				}
+			}
 
-				bx::memCopy(dst, _data, _size);
-				vkUnmapMemory(m_device, *_memory);
+			BufferCopy copy;
+			copy.m_src    = _src;
+			copy.m_dst    = _dst;
+			copy.m_region = _region;
+			m_bufferCopy.push_back(copy);
+		}
+
+		void flushCopyBuffers()
+		{
+			const uint32_t num = uint32_t(m_bufferCopy.size() );
+
+			if (0 == num)
+			{
+				return;
 			}
 
-			return result;
+			bx::quickSort(
+				  m_bufferCopy.data()
+				, num
+				, sizeof(BufferCopy)
+				, [](const void* _a, const void* _b) -> int32_t {
+					const BufferCopy& lhs = *(const BufferCopy*)(_a);
+					const BufferCopy& rhs = *(const BufferCopy*)(_b);
+					const uint64_t lhsDst = uint64_t(lhs.m_dst.vk);
+					const uint64_t rhsDst = uint64_t(rhs.m_dst.vk);
+					const uint64_t lhsSrc = uint64_t(lhs.m_src.vk);
+					const uint64_t rhsSrc = uint64_t(rhs.m_src.vk);
+					if (lhsDst != rhsDst) { return lhsDst < rhsDst ? -1 : 1; }
+					if (lhsSrc != rhsSrc) { return lhsSrc < rhsSrc ? -1 : 1; }
+					return 0;
+				});
+
+			m_bufferCopyRegion.clear();
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				const BufferCopy& copy = m_bufferCopy[ii];
+				m_bufferCopyRegion.push_back(copy.m_region);
+
+				if (ii + 1 == num
+				||  m_bufferCopy[ii + 1].m_dst.vk != copy.m_dst.vk
+				||  m_bufferCopy[ii + 1].m_src.vk != copy.m_src.vk)
+				{
+					vkCmdCopyBuffer(
+						  m_commandBuffer
+						, copy.m_src
+						, copy.m_dst
+						, uint32_t(m_bufferCopyRegion.size() )
+						, m_bufferCopyRegion.data()
+						);
+					m_bufferCopyRegion.clear();
+				}
+			}
+
+			setMemoryBarrier(
+				  m_commandBuffer
+				, VK_PIPELINE_STAGE_TRANSFER_BIT
+				, VK_PIPELINE_STAGE_TRANSFER_BIT
+				);
+
+			m_bufferCopy.clear();
 		}
 
 		VkAllocationCallbacks*   m_allocatorCb;
@@ -4195,9 +4488,12 @@ VK_IMPORT_DEVICE
 
 		VkPhysicalDeviceProperties       m_deviceProperties;
 		VkPhysicalDeviceMemoryProperties m_memoryProperties;
+		DeviceMemoryAllocatorVK          m_memoryAllocator;
 		VkPhysicalDeviceFeatures         m_deviceFeatures;
 
 		bool m_lineAASupport;
+		bool m_pushDescriptorSupport;
+		bool m_bindlessSupport;
 
 		FrameBufferVK m_backBuffer;
 
@@ -4206,6 +4502,26 @@ VK_IMPORT_DEVICE
 		int64_t m_presentElapsed;
 
 		ScratchBufferVK m_scratchBuffer[BGFX_CONFIG_MAX_FRAME_LATENCY];
+		StagingRingVK   m_stagingRing[BGFX_CONFIG_MAX_FRAME_LATENCY];
+
+		struct BufferCopy
+		{
+			VkBuffer     m_src;
+			VkBuffer     m_dst;
+			VkBufferCopy m_region;
+		};
+
+		static constexpr uint32_t kMaxPendingBufferCopies = 1024;
+
+		stl::vector<BufferCopy>   m_bufferCopy;
+		stl::vector<VkBufferCopy> m_bufferCopyRegion;
+
+		stl::vector<DrawItemVK> m_drawItem;
+		UniformCacheVK          m_uniformCache;
+
+		// Record jobs share pipeline, sampler and image view caches with render thread.
+		bx::Mutex m_cacheMutex;
+		DescriptorAllocatorVK m_recordDescriptor[BGFX_CONFIG_MAX_FRAME_LATENCY][kMaxRecordJobs];
 
 		uint32_t        m_numFramesInFlight;
 		CommandQueueVK  m_cmd;
@@ -4217,8 +4533,9 @@ VK_IMPORT_DEVICE
 		VkDevice m_device;
 		VkQueue  m_queueGraphics;
 		VkQueue  m_queueCompute;
-		VkDescriptorPool m_descriptorPool;
 		VkPipelineCache  m_pipelineCache;
+		PipelineCacheHeader m_pipelineCacheHeader;
+		bool m_pipelineCacheDirty;
 
 		TimerQueryVK m_gpuTimer;
 
@@ -4238,10 +4555,13 @@ VK_IMPORT_DEVICE
 		UniformRegistry m_uniformReg;
 
 		StateCacheT<VkPipeline> m_pipelineStateCache;
+		PipelineCompilerVK      m_pipelineCompiler;
 		StateCacheT<VkDescriptorSetLayout> m_descriptorSetLayoutCache;
 		StateCacheT<VkRenderPass> m_renderPassCache;
 		StateCacheT<VkSampler> m_samplerCache;
 		StateCacheLru<VkImageView, 1024> m_imageViewCache;
+		DescriptorSetCacheVK m_descriptorSetCache;
+		BindlessTextureSetVK m_bindlessTexture;
 
 		Resolution m_resolution;
 		float m_maxAnisotropy;
@@ -4249,7 +4569,7 @@ VK_IMPORT_DEVICE
 		bool m_wireframe;
 
 		VkBuffer m_captureBuffer;
-		VkDeviceMemory m_captureMemory;
+		DeviceMemoryAllocationVK m_captureMemory;
 		void* m_captureData;
 		uint32_t m_captureSize;
 
@@ -4325,2371 +4645,4295 @@ VK_DESTROY
 		s_renderVK->release(_obj);
 	}
 
-	void ScratchBufferVK::create(uint32_t _size, uint32_t _count, uint32_t _maxDescriptors)
+	DeviceMemoryAllocatorVK::DeviceMemoryAllocatorVK()
 	{
-		m_maxDescriptors = _maxDescriptors;
-		m_currentDs      = 0;
-		m_descriptorSet  = (VkDescriptorSet*)BX_ALLOC(g_allocator, m_maxDescriptors * sizeof(VkDescriptorSet) );
-		bx::memSet(m_descriptorSet, 0, sizeof(VkDescriptorSet) * m_maxDescriptors);
-
-		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		const VkDevice device = s_renderVK->m_device;
-		const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
+		bx::memSet(&m_memoryProperties, 0, sizeof(m_memoryProperties) );
+		bx::memSet(m_allocated, 0, sizeof(m_allocated) );
 
-		const uint32_t align = uint32_t(deviceLimits.minUniformBufferOffsetAlignment);
-		const uint32_t entrySize = bx::strideAlign(_size, align);
-		const uint32_t totalSize = entrySize * _count;
-
-		VkBufferCreateInfo bci;
-		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		bci.pNext = NULL;
-		bci.flags = 0;
-		bci.size  = totalSize;
-		bci.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-		bci.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-		bci.queueFamilyIndexCount = 0;
-		bci.pQueueFamilyIndices   = NULL;
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_pool); ++ii)
+		{
+			Pool& pool = m_pool[ii];
+			pool.m_blockSize       = 0;
+			pool.m_memoryTypeIndex = ii / Usage::Count;
+			pool.m_numLevels       = 0;
+			pool.m_linear          = Usage::Transient == ii % Usage::Count;
+		}
+	}
 
-		VK_CHECK(vkCreateBuffer(
-			  device
-			, &bci
-			, allocatorCb
-			, &m_buffer
-			) );
+	void DeviceMemoryAllocatorVK::init(const VkPhysicalDeviceMemoryProperties& _memoryProperties, VkDeviceSize _blockSize)
+	{
+		BX_ASSERT(0 == (_blockSize & (_blockSize - 1) ), "Block size must be power of two.");
 
-		VkMemoryRequirements mr;
-		vkGetBufferMemoryRequirements(
-			  device
-			, m_buffer
-			, &mr
-			);
+		m_memoryProperties = _memoryProperties;
+		bx::memSet(m_allocated, 0, sizeof(m_allocated) );
 
-		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &m_deviceMem) );
+		for (uint32_t ii = 0; ii < m_memoryProperties.memoryTypeCount; ++ii)
+		{
+			const VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[m_memoryProperties.memoryTypes[ii].heapIndex].size;
 
-		m_size = (uint32_t)mr.size;
-		m_pos  = 0;
+			// Don't let a single block take big chunk of small heaps (BAR memory, etc.).
+			VkDeviceSize blockSize = _blockSize;
+			while (blockSize > kMinAllocSize * 2
+			&&     blockSize > heapSize / 8)
+			{
+				blockSize >>= 1;
+			}
 
-		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
+			uint8_t numLevels = 1;
+			for (VkDeviceSize size = blockSize; size > kMinAllocSize && numLevels < kMaxLevels; size >>= 1)
+			{
+				++numLevels;
+			}
 
-		VK_CHECK(vkMapMemory(device, m_deviceMem, 0, m_size, 0, (void**)&m_data) );
+			for (uint32_t usage = 0; usage < Usage::Count; ++usage)
+			{
+				Pool& pool = m_pool[ii*Usage::Count + usage];
+				pool.m_blockSize = blockSize;
+				pool.m_numLevels = numLevels;
+			}
+		}
 	}
 
-	void ScratchBufferVK::destroy()
+	void DeviceMemoryAllocatorVK::shutdown()
 	{
-		reset();
-		BX_FREE(g_allocator, m_descriptorSet);
-
-		vkUnmapMemory(s_renderVK->m_device, m_deviceMem);
+		for (uint16_t ii = 0; ii < BX_COUNTOF(m_pool); ++ii)
+		{
+			Pool& pool = m_pool[ii];
 
-		s_renderVK->release(m_buffer);
-		s_renderVK->release(m_deviceMem);
-	}
+			for (uint16_t jj = 0, num = uint16_t(pool.m_blocks.size() ); jj < num; ++jj)
+			{
+				if (NULL != pool.m_blocks[jj])
+				{
+					BX_WARN(0 == pool.m_blocks[jj]->m_numAllocs
+						, "Device memory block %d of pool %d still has %d allocations."
+						, jj
+						, ii
+						, pool.m_blocks[jj]->m_numAllocs
+						);
+					freeBlock(ii, jj);
+				}
+			}
 
-	void ScratchBufferVK::reset()
-	{
-		if (m_currentDs > 0)
-		{
-			VK_CHECK(vkFreeDescriptorSets(
-				  s_renderVK->m_device
-				, s_renderVK->m_descriptorPool
-				, m_currentDs
-				, m_descriptorSet
-				) );
+			pool.m_blocks.clear();
 		}
-
-		bx::memSet(m_descriptorSet, 0, sizeof(VkDescriptorSet) * m_maxDescriptors);
-		m_pos = 0;
-		m_currentDs = 0;
 	}
 
-	uint32_t ScratchBufferVK::write(const void* _data, uint32_t _size)
+	VkResult DeviceMemoryAllocatorVK::alloc(const VkMemoryRequirements& _requirements, VkMemoryPropertyFlags _propertyFlags, Usage::Enum _usage, DeviceMemoryAllocationVK* _alloc)
 	{
-		BX_ASSERT(m_pos < m_size, "Out of scratch buffer memory");
+		VkResult result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
 
-		const uint32_t offset = m_pos;
-
-		if (_size > 0)
+		for (uint32_t attempt = 0; attempt < 2 && VK_SUCCESS != result; ++attempt)
 		{
-			bx::memCopy(&m_data[m_pos], _data, _size);
+			if (0 != attempt)
+			{
+				// Out of memory, return empty blocks to driver and try once more.
+				defragment();
+			}
 
-			const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
-			const uint32_t align = uint32_t(deviceLimits.minUniformBufferOffsetAlignment);
-			const uint32_t alignedSize = bx::strideAlign(_size, align);
+			int32_t searchIndex = -1;
+			do
+			{
+				searchIndex++;
+				searchIndex = s_renderVK->selectMemoryType(_requirements.memoryTypeBits, _propertyFlags, searchIndex);
 
-			m_pos += alignedSize;
+				if (searchIndex >= 0)
+				{
+					result = allocFromType(searchIndex, _requirements, _usage, _alloc);
+				}
+			}
+			while (result != VK_SUCCESS
+			   &&  searchIndex >= 0);
 		}
 
-		return offset;
+		return result;
 	}
 
-	void ScratchBufferVK::flush()
+	void DeviceMemoryAllocatorVK::free(DeviceMemoryAllocationVK& _alloc)
 	{
-		const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
-		VkDevice device = s_renderVK->m_device;
+		if (VK_NULL_HANDLE == _alloc.m_mem)
+		{
+			return;
+		}
 
-		const uint32_t align = uint32_t(deviceLimits.nonCoherentAtomSize);
-		const uint32_t size  = bx::min(bx::strideAlign(m_pos, align), m_size);
+		if (UINT16_MAX == _alloc.m_block)
+		{
+			if (NULL != _alloc.m_data)
+			{
+				vkUnmapMemory(s_renderVK->m_device, _alloc.m_mem);
+			}
 
-		VkMappedMemoryRange range;
-		range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-		range.pNext  = NULL;
-		range.memory = m_deviceMem;
-		range.offset = 0;
-		range.size   = size;
-		VK_CHECK(vkFlushMappedMemoryRanges(device, 1, &range) );
-	}
+			vkFreeMemory(s_renderVK->m_device, _alloc.m_mem, s_renderVK->m_allocatorCb);
+			m_allocated[getHeapIndex(_alloc.m_pool)] -= _alloc.m_size;
+		}
+		else
+		{
+			Pool& pool = m_pool[_alloc.m_pool];
+			Block* block = pool.m_blocks[_alloc.m_block];
 
-	void BufferVK::create(VkCommandBuffer _commandBuffer, uint32_t _size, void* _data, uint16_t _flags, bool _vertex, uint32_t _stride)
-	{
-		BX_UNUSED(_stride);
+			if (!pool.m_linear)
+			{
+				// Merge with free buddies as far up as possible.
+				uint32_t offset = uint32_t(_alloc.m_offset / kMinAllocSize);
+				uint32_t level  = _alloc.m_level;
 
-		m_size    = _size;
-		m_flags   = _flags;
-		m_dynamic = NULL == _data;
+				while (0 < level)
+				{
+					const uint32_t buddy = offset ^ uint32_t( (pool.m_blockSize >> level) / kMinAllocSize);
 
-		const bool storage  = m_flags & BGFX_BUFFER_COMPUTE_READ_WRITE;
-		const bool indirect = m_flags & BGFX_BUFFER_DRAW_INDIRECT;
+					FreeList::iterator it = block->m_free[level].find(buddy);
+					if (it == block->m_free[level].end() )
+					{
+						break;
+					}
 
-		VkBufferCreateInfo bci;
-		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		bci.pNext = NULL;
-		bci.flags = 0;
-		bci.size  = _size;
-		bci.usage = 0
-			| (_vertex              ? VK_BUFFER_USAGE_VERTEX_BUFFER_BIT   : VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
-			| (storage || indirect  ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT  : 0)
-			| (indirect             ? VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT : 0)
-			| VK_BUFFER_USAGE_TRANSFER_DST_BIT
-			;
-		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-		bci.queueFamilyIndexCount = 0;
-		bci.pQueueFamilyIndices   = NULL;
+					block->m_free[level].erase(it);
+					offset = bx::min(offset, buddy);
+					--level;
+				}
 
-		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		const VkDevice device = s_renderVK->m_device;
-		VK_CHECK(vkCreateBuffer(device, &bci, allocatorCb, &m_buffer) );
+				block->m_free[level].insert(offset);
+			}
 
-		VkMemoryRequirements mr;
-		vkGetBufferMemoryRequirements(device, m_buffer, &mr);
+			--block->m_numAllocs;
 
-		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_deviceMem) );
+			if (0 == block->m_numAllocs)
+			{
+				block->m_offset = 0;
 
-		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
+				// Keep only one empty block per pool around, so that create/destroy churn doesn't
+				// end up in driver.
+				for (uint16_t ii = 0, num = uint16_t(pool.m_blocks.size() ); ii < num; ++ii)
+				{
+					if (ii != _alloc.m_block
+					&&  NULL != pool.m_blocks[ii]
+					&&  0 == pool.m_blocks[ii]->m_numAllocs)
+					{
+						freeBlock(_alloc.m_pool, _alloc.m_block);
+						break;
+					}
+				}
+			}
+		}
 
-		if (!m_dynamic)
-		{
-			VkBuffer stagingBuffer;
-			VkDeviceMemory stagingMem;
-			VK_CHECK(s_renderVK->createStagingBuffer(_size, &stagingBuffer, &stagingMem, _data) );
+		_alloc = DeviceMemoryAllocationVK();
+	}
 
-			// copy buffer to buffer
-			VkBufferCopy region;
-			region.srcOffset = 0;
-			region.dstOffset = 0;
-			region.size      = _size;
-			vkCmdCopyBuffer(_commandBuffer, stagingBuffer, m_buffer, 1, &region);
+	void DeviceMemoryAllocatorVK::defragment()
+	{
+		for (uint16_t ii = 0; ii < BX_COUNTOF(m_pool); ++ii)
+		{
+			Pool& pool = m_pool[ii];
 
-			setMemoryBarrier(
-				  _commandBuffer
-				, VK_PIPELINE_STAGE_TRANSFER_BIT
-				, VK_PIPELINE_STAGE_TRANSFER_BIT
-				);
+			for (uint16_t jj = 0, num = uint16_t(pool.m_blocks.size() ); jj < num; ++jj)
+			{
+				if (NULL != pool.m_blocks[jj]
+				&&  0 == pool.m_blocks[jj]->m_numAllocs)
+				{
+					freeBlock(ii, jj);
+				}
+			}
 
-			s_renderVK->release(stagingBuffer);
-			s_renderVK->release(stagingMem);
+			while (!pool.m_blocks.empty()
+			&&     NULL == pool.m_blocks.back() )
+			{
+				pool.m_blocks.pop_back();
+			}
 		}
+
+		BX_TRACE("Device memory allocated %" PRIu64 " bytes (device local).", getDeviceLocalAllocated() );
 	}
 
-	void BufferVK::update(VkCommandBuffer _commandBuffer, uint32_t _offset, uint32_t _size, void* _data, bool _discard)
+	uint64_t DeviceMemoryAllocatorVK::getDeviceLocalAllocated() const
 	{
-		BX_UNUSED(_discard);
-
-		VkBuffer stagingBuffer;
-		VkDeviceMemory stagingMem;
-		VK_CHECK(s_renderVK->createStagingBuffer(_size, &stagingBuffer, &stagingMem, _data) );
-
-		VkBufferCopy region;
-		region.srcOffset = 0;
-		region.dstOffset = _offset;
-		region.size      = _size;
-		vkCmdCopyBuffer(_commandBuffer, stagingBuffer, m_buffer, 1, &region);
+		uint64_t allocated = 0;
 
-		setMemoryBarrier(
-			  _commandBuffer
-			, VK_PIPELINE_STAGE_TRANSFER_BIT
-			, VK_PIPELINE_STAGE_TRANSFER_BIT
-			);
+		for (uint32_t ii = 0; ii < m_memoryProperties.memoryHeapCount; ++ii)
+		{
+			if (0 != (m_memoryProperties.memoryHeaps[ii].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) )
+			{
+				allocated += m_allocated[ii];
+			}
+		}
 
-		s_renderVK->release(stagingBuffer);
-		s_renderVK->release(stagingMem);
+		return allocated;
 	}
 
-	void BufferVK::destroy()
+	uint64_t DeviceMemoryAllocatorVK::getDeviceLocalSize() const
 	{
-		if (VK_NULL_HANDLE != m_buffer)
-		{
-			s_renderVK->release(m_buffer);
-			s_renderVK->release(m_deviceMem);
+		uint64_t size = 0;
 
-			m_dynamic = false;
+		for (uint32_t ii = 0; ii < m_memoryProperties.memoryHeapCount; ++ii)
+		{
+			if (0 != (m_memoryProperties.memoryHeaps[ii].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) )
+			{
+				size += m_memoryProperties.memoryHeaps[ii].size;
+			}
 		}
-	}
 
-	void VertexBufferVK::create(VkCommandBuffer _commandBuffer, uint32_t _size, void* _data, VertexLayoutHandle _layoutHandle, uint16_t _flags)
-	{
-		BufferVK::create(_commandBuffer, _size, _data, _flags, true);
-		m_layoutHandle = _layoutHandle;
+		return size;
 	}
 
-	void ShaderVK::create(const Memory* _mem)
+	VkResult DeviceMemoryAllocatorVK::allocFromType(uint32_t _memoryTypeIndex, const VkMemoryRequirements& _requirements, Usage::Enum _usage, DeviceMemoryAllocationVK* _alloc)
 	{
-		bx::MemoryReader reader(_mem->data, _mem->size);
+		const uint16_t poolIdx = uint16_t(_memoryTypeIndex*Usage::Count + _usage);
+		Pool& pool = m_pool[poolIdx];
 
-		uint32_t magic;
-		bx::read(&reader, magic);
-
-		VkShaderStageFlagBits shaderStage = VK_SHADER_STAGE_ALL;
-		BX_UNUSED(shaderStage);
-
-		if (isShaderType(magic, 'C') )
+		if (_requirements.size > pool.m_blockSize / 2)
 		{
-			shaderStage = VK_SHADER_STAGE_COMPUTE_BIT;
+			return allocDedicated(poolIdx, _requirements.size, _alloc);
 		}
-		else if (isShaderType(magic, 'F') )
+
+		VkDeviceSize size  = _requirements.size;
+		VkDeviceSize align = bx::max<VkDeviceSize>(_requirements.alignment, 1);
+
+		if (!pool.m_linear)
 		{
-			shaderStage = VK_SHADER_STAGE_FRAGMENT_BIT;
+			// Buddy nodes are aligned to their size.
+			VkDeviceSize nodeSize = kMinAllocSize;
+			while (nodeSize < size
+			||     nodeSize < align)
+			{
+				nodeSize <<= 1;
+			}
+
+			size  = nodeSize;
+			align = nodeSize;
 		}
-		else if (isShaderType(magic, 'V') )
+
+		for (uint16_t ii = 0, num = uint16_t(pool.m_blocks.size() ); ii < num; ++ii)
 		{
-			shaderStage = VK_SHADER_STAGE_VERTEX_BIT;
+			if (NULL != pool.m_blocks[ii]
+			&&  suballoc(poolIdx, ii, size, align, _alloc) )
+			{
+				return VK_SUCCESS;
+			}
 		}
 
-		const bool fragment = isShaderType(magic, 'F');
+		uint16_t block;
+		VkResult result = allocBlock(poolIdx, &block);
 
-		uint32_t hashIn;
-		bx::read(&reader, hashIn);
+		if (VK_SUCCESS == result)
+		{
+			const bool ok = suballoc(poolIdx, block, size, align, _alloc);
+			BX_ASSERT(ok, "Allocation must fit into empty block.");
+			BX_UNUSED(ok);
+		}
 
-		uint32_t hashOut;
+		return result;
+	}
 
-		if (isShaderVerLess(magic, 6) )
+	VkResult DeviceMemoryAllocatorVK::allocDedicated(uint16_t _pool, VkDeviceSize _size, DeviceMemoryAllocationVK* _alloc)
+	{
+		VkMemoryAllocateInfo ma;
+		ma.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		ma.pNext = NULL;
+		ma.allocationSize  = _size;
+		ma.memoryTypeIndex = m_pool[_pool].m_memoryTypeIndex;
+
+		::VkDeviceMemory mem;
+		VkResult result = vkAllocateMemory(s_renderVK->m_device, &ma, s_renderVK->m_allocatorCb, &mem);
+		if (VK_SUCCESS != result)
 		{
-			hashOut = hashIn;
+			return result;
 		}
-		else
+
+		void* data = NULL;
+		if (isHostVisible(_pool) )
 		{
-			bx::read(&reader, hashOut);
+			result = vkMapMemory(s_renderVK->m_device, mem, 0, VK_WHOLE_SIZE, 0, &data);
+			if (VK_SUCCESS != result)
+			{
+				vkFreeMemory(s_renderVK->m_device, mem, s_renderVK->m_allocatorCb);
+				return result;
+			}
 		}
 
-		uint16_t count;
-		bx::read(&reader, count);
+		_alloc->m_mem    = mem;
+		_alloc->m_offset = 0;
+		_alloc->m_size   = _size;
+		_alloc->m_data   = (uint8_t*)data;
+		_alloc->m_pool   = _pool;
+		_alloc->m_block  = UINT16_MAX;
+		_alloc->m_level  = 0;
 
-		m_numPredefined = 0;
-		m_numUniforms = count;
-		m_numTextures = 0;
+		m_allocated[getHeapIndex(_pool)] += _size;
 
-		m_oldBindingModel = isShaderVerLess(magic, 11);
+		return VK_SUCCESS;
+	}
 
-		BX_TRACE("%s Shader consts %d"
-			, getShaderTypeName(magic)
-			, count
-			);
+	VkResult DeviceMemoryAllocatorVK::allocBlock(uint16_t _pool, uint16_t* _block)
+	{
+		Pool& pool = m_pool[_pool];
 
-		uint8_t fragmentBit = fragment ? kUniformFragmentBit : 0;
+		VkMemoryAllocateInfo ma;
+		ma.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		ma.pNext = NULL;
+		ma.allocationSize  = pool.m_blockSize;
+		ma.memoryTypeIndex = pool.m_memoryTypeIndex;
 
-		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+		::VkDeviceMemory mem;
+		VkResult result = vkAllocateMemory(s_renderVK->m_device, &ma, s_renderVK->m_allocatorCb, &mem);
+		if (VK_SUCCESS != result)
 		{
-			m_bindInfo[ii].uniformHandle  = BGFX_INVALID_HANDLE;
-			m_bindInfo[ii].type           = BindType::Count;
-			m_bindInfo[ii].binding        = 0;
-			m_bindInfo[ii].samplerBinding = 0;
-			m_bindInfo[ii].index          = UINT32_MAX;
+			BX_TRACE("Failed to allocate device memory block %d: %s.", result, getName(result) );
+			return result;
 		}
 
-		if (0 < count)
+		// Host visible blocks are mapped once, for the lifetime of block.
+		void* data = NULL;
+		if (isHostVisible(_pool) )
 		{
-			for (uint32_t ii = 0; ii < count; ++ii)
+			result = vkMapMemory(s_renderVK->m_device, mem, 0, VK_WHOLE_SIZE, 0, &data);
+			if (VK_SUCCESS != result)
 			{
-				uint8_t nameSize = 0;
-				bx::read(&reader, nameSize);
+				vkFreeMemory(s_renderVK->m_device, mem, s_renderVK->m_allocatorCb);
+				return result;
+			}
+		}
 
-				char name[256];
-				bx::read(&reader, &name, nameSize);
-				name[nameSize] = '\0';
+		Block* block = BX_NEW(g_allocator, Block);
+		block->m_mem       = mem;
+		block->m_data      = (uint8_t*)data;
+		block->m_offset    = 0;
+		block->m_numAllocs = 0;
 
-				uint8_t type = 0;
-				bx::read(&reader, type);
+		if (!pool.m_linear)
+		{
+			block->m_free[0].insert(0);
+		}
 
-				uint8_t num;
-				bx::read(&reader, num);
+		uint16_t idx = 0;
+		for (uint16_t num = uint16_t(pool.m_blocks.size() ); idx < num && NULL != pool.m_blocks[idx]; ++idx)
+		{
+		}
 
-				uint16_t regIndex;
-				bx::read(&reader, regIndex);
+		if (idx == pool.m_blocks.size() )
+		{
+			BX_ASSERT(idx < UINT16_MAX, "Too many device memory blocks.");
+			pool.m_blocks.push_back(block);
+		}
+		else
+		{
+			pool.m_blocks[idx] = block;
+		}
 
-				uint16_t regCount;
-				bx::read(&reader, regCount);
+		m_allocated[getHeapIndex(_pool)] += pool.m_blockSize;
 
-				const bool hasTexData = !isShaderVerLess(magic, 8);
-				const bool hasTexFormat = !isShaderVerLess(magic, 10);
-				uint8_t texComponent = 0;
-				uint8_t texDimension = 0;
-				uint16_t texFormat = 0;
+		*_block = idx;
 
-				if (hasTexData)
-				{
-					bx::read(&reader, texComponent);
-					bx::read(&reader, texDimension);
-				}
+		return VK_SUCCESS;
+	}
 
-				if (hasTexFormat)
-				{
-					bx::read(&reader, texFormat);
-				}
+	void DeviceMemoryAllocatorVK::freeBlock(uint16_t _pool, uint16_t _block)
+	{
+		Pool& pool = m_pool[_pool];
+		Block* block = pool.m_blocks[_block];
 
-				const char* kind = "invalid";
+		if (NULL != block->m_data)
+		{
+			vkUnmapMemory(s_renderVK->m_device, block->m_mem);
+		}
 
-				BX_UNUSED(num);
-				BX_UNUSED(texComponent);
-				BX_UNUSED(texFormat);
+		vkFreeMemory(s_renderVK->m_device, block->m_mem, s_renderVK->m_allocatorCb);
+		m_allocated[getHeapIndex(_pool)] -= pool.m_blockSize;
 
-				auto textureDimensionToViewType = [](TextureDimension::Enum dimension)
-				{
-					switch (dimension)
-					{
-					case TextureDimension::Dimension1D:        return VK_IMAGE_VIEW_TYPE_1D;
-					case TextureDimension::Dimension2D:        return VK_IMAGE_VIEW_TYPE_2D;
-					case TextureDimension::Dimension2DArray:   return VK_IMAGE_VIEW_TYPE_2D_ARRAY;
-					case TextureDimension::DimensionCube:      return VK_IMAGE_VIEW_TYPE_CUBE;
-					case TextureDimension::DimensionCubeArray: return VK_IMAGE_VIEW_TYPE_CUBE_ARRAY;
-					case TextureDimension::Dimension3D:        return VK_IMAGE_VIEW_TYPE_3D;
-					default:                                   return VK_IMAGE_VIEW_TYPE_MAX_ENUM;
-					}
-				};
-
-				if (UINT16_MAX != regIndex)
-				{
-					PredefinedUniform::Enum predefined = nameToPredefinedUniformEnum(name);
-					if (PredefinedUniform::Count != predefined)
-					{
-						kind = "predefined";
-						m_predefined[m_numPredefined].m_loc   = regIndex;
-						m_predefined[m_numPredefined].m_count = regCount;
-						m_predefined[m_numPredefined].m_type  = uint8_t(predefined|fragmentBit);
-						m_numPredefined++;
-					}
-					else if (UniformType::End == (~kUniformMask & type) )
-					{
-						// regCount is used for descriptor type
-						const bool isBuffer = idToDescriptorType(regCount) == DescriptorType::StorageBuffer;
-						if (0 == regIndex)
-						{
-							continue;
-						}
-
-						const uint8_t reverseShift = m_oldBindingModel
-							? (fragment ? kSpirvOldFragmentShift : 0) + (isBuffer ? kSpirvOldBufferShift : kSpirvOldImageShift)
-							: kSpirvBindShift;
-
-						const uint16_t stage = regIndex - reverseShift; // regIndex is used for buffer binding index
-
-						m_bindInfo[stage].type = isBuffer ? BindType::Buffer : BindType::Image;
-						m_bindInfo[stage].uniformHandle  = { 0 };
-						m_bindInfo[stage].binding        = regIndex;
-
-						if (!isBuffer)
-						{
-							const VkImageViewType viewType = hasTexData
-								? textureDimensionToViewType(idToTextureDimension(texDimension) )
-								: VK_IMAGE_VIEW_TYPE_MAX_ENUM
-								;
-
-							if (VK_IMAGE_VIEW_TYPE_MAX_ENUM != viewType)
-							{
-								m_bindInfo[stage].index = m_numTextures;
-								m_textures[m_numTextures].type = viewType;
-								m_numTextures++;
-							}
-						}
-
-						kind = "storage";
-					}
-					else if (UniformType::Sampler == (~kUniformMask & type) )
-					{
-						const uint8_t reverseShift = m_oldBindingModel
-							? (fragment ? kSpirvOldFragmentShift : 0) + kSpirvOldTextureShift
-							: kSpirvBindShift;
-
-						const uint16_t stage = regIndex - reverseShift; // regIndex is used for image/sampler binding index
-
-						const UniformRegInfo* info = s_renderVK->m_uniformReg.find(name);
-						BX_ASSERT(NULL != info, "User defined uniform '%s' is not found, it won't be set.", name);
-
-						m_bindInfo[stage].uniformHandle    = info->m_handle;
-						m_bindInfo[stage].type             = BindType::Sampler;
-						m_bindInfo[stage].binding          = regIndex;
-						m_bindInfo[stage].samplerBinding   = regIndex + kSpirvSamplerShift;
-
-						const VkImageViewType viewType = hasTexData
-							? textureDimensionToViewType(idToTextureDimension(texDimension) )
-							: VK_IMAGE_VIEW_TYPE_MAX_ENUM
-							;
+		BX_DELETE(g_allocator, block);
+		pool.m_blocks[_block] = NULL;
+	}
 
-						if (VK_IMAGE_VIEW_TYPE_MAX_ENUM != viewType)
-						{
-							m_bindInfo[stage].index = m_numTextures;
-							m_textures[m_numTextures].type = viewType;
-							m_numTextures++;
-						}
+	bool DeviceMemoryAllocatorVK::suballoc(uint16_t _pool, uint16_t _block, VkDeviceSize _size, VkDeviceSize _align, DeviceMemoryAllocationVK* _alloc)
+	{
+		Pool& pool = m_pool[_pool];
+		Block* block = pool.m_blocks[_block];
 
-						kind = "sampler";
-					}
-					else
-					{
-						const UniformRegInfo* info = s_renderVK->m_uniformReg.find(name);
-						BX_ASSERT(NULL != info, "User defined uniform '%s' is not found, it won't be set.", name);
+		VkDeviceSize offset;
+		uint8_t level = 0;
 
-						if (NULL != info)
-						{
-							if (NULL == m_constantBuffer)
-							{
-								m_constantBuffer = UniformBuffer::create(1024);
-							}
+		if (pool.m_linear)
+		{
+			offset = (block->m_offset + _align - 1) & ~(_align - 1);
 
-							kind = "user";
-							m_constantBuffer->writeUniformHandle( (UniformType::Enum)(type|fragmentBit), regIndex, info->m_handle, regCount);
-						}
-					}
-				}
+			if (offset + _size > pool.m_blockSize)
+			{
+				return false;
+			}
 
-				BX_TRACE("\t%s: %s (%s), r.index %3d, r.count %2d, r.texComponent %1d, r.texDimension %1d"
-					, kind
-					, name
-					, getUniformTypeName(UniformType::Enum(type&~kUniformMask) )
-					, regIndex
-					, regCount
-					, texComponent
-					, texDimension
-					);
-				BX_UNUSED(kind);
+			block->m_offset = offset + _size;
+		}
+		else
+		{
+			for (VkDeviceSize nodeSize = pool.m_blockSize; nodeSize > _size && level < pool.m_numLevels - 1; nodeSize >>= 1)
+			{
+				++level;
 			}
 
-			if (NULL != m_constantBuffer)
+			// Find smallest free node that fits, and split it down to requested level.
+			int32_t found = level;
+			while (0 <= found
+			&&     block->m_free[found].empty() )
 			{
-				m_constantBuffer->finish();
+				--found;
 			}
-		}
 
-		uint32_t shaderSize;
-		bx::read(&reader, shaderSize);
+			if (0 > found)
+			{
+				return false;
+			}
 
-		const void* code = reader.getDataPtr();
-		bx::skip(&reader, shaderSize+1);
+			FreeList::iterator it = block->m_free[found].begin();
+			const uint32_t node = *it;
+			block->m_free[found].erase(it);
 
-		m_code = alloc(shaderSize);
-		bx::memCopy(m_code->data, code, shaderSize);
+			for (uint32_t ii = uint32_t(found + 1); ii <= level; ++ii)
+			{
+				block->m_free[ii].insert(node + uint32_t( (pool.m_blockSize >> ii) / kMinAllocSize) );
+			}
 
-		VkShaderModuleCreateInfo smci;
-		smci.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-		smci.pNext    = NULL;
-		smci.flags    = 0;
-		smci.codeSize = m_code->size;
-		smci.pCode    = (const uint32_t*)m_code->data;
+			offset = VkDeviceSize(node) * kMinAllocSize;
+			_size  = pool.m_blockSize >> level;
+		}
 
-//		disassemble(bx::getDebugOut(), m_code->data, m_code->size);
+		++block->m_numAllocs;
 
-		VK_CHECK(vkCreateShaderModule(
-			  s_renderVK->m_device
-			, &smci
-			, s_renderVK->m_allocatorCb
-			, &m_module
-			) );
+		_alloc->m_mem    = block->m_mem;
+		_alloc->m_offset = offset;
+		_alloc->m_size   = _size;
+		_alloc->m_data   = NULL != block->m_data ? block->m_data + offset : NULL;
+		_alloc->m_pool   = _pool;
+		_alloc->m_block  = _block;
+		_alloc->m_level  = level;
 
-		bx::memSet(m_attrMask,  0, sizeof(m_attrMask) );
-		bx::memSet(m_attrRemap, 0, sizeof(m_attrRemap) );
+		return true;
+	}
 
-		bx::read(&reader, m_numAttrs);
+	void PipelineCompilerVK::init(uint32_t _numThreads)
+	{
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+		m_numThreads = bx::min(_numThreads, kMaxThreads);
+		m_exit       = false;
 
-		for (uint8_t ii = 0; ii < m_numAttrs; ++ii)
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
 		{
-			uint16_t id;
-			bx::read(&reader, id);
-
-			Attrib::Enum attr = idToAttrib(id);
-
-			if (Attrib::Count != attr)
-			{
-				m_attrMask[attr]  = UINT16_MAX;
-				m_attrRemap[attr] = ii;
-			}
+			m_thread[ii].init(compileThread, this, 0, "bgfx - pipeline compile thread");
 		}
+#else
+		BX_UNUSED(_numThreads);
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
 
-		bx::HashMurmur2A murmur;
-		murmur.begin();
-		murmur.add(hashIn);
-		murmur.add(hashOut);
-		murmur.add(m_code->data, m_code->size);
-		murmur.add(m_numAttrs);
-		murmur.add(m_attrMask,  m_numAttrs);
-		murmur.add(m_attrRemap, m_numAttrs);
-		m_hash = murmur.end();
+		BX_TRACE("Number of pipeline compile threads: %d", m_numThreads);
+	}
 
-		bx::read(&reader, m_size);
+	void PipelineCompilerVK::shutdown()
+	{
+#if BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
+		m_exit = true;
+		m_workSem.post(m_numThreads);
 
-		// fill binding description with uniform informations
-		uint16_t bidx = 0;
-		if (m_size > 0)
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
 		{
-			m_uniformBinding = fragment ? (m_oldBindingModel ? kSpirvOldFragmentBinding : kSpirvFragmentBinding) : 0;
-
-			VkDescriptorSetLayoutBinding& binding = m_bindings[bidx];
-			binding.stageFlags = shaderStage;
-			binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-			binding.binding = m_uniformBinding;
-			binding.pImmutableSamplers = NULL;
-			binding.descriptorCount = 1;
-			bidx++;
+			m_thread[ii].shutdown();
 		}
+#endif // BGFX_CONFIG_MULTITHREADED && BX_CONFIG_SUPPORTS_THREADING
 
-		for (uint32_t ii = 0; ii < BX_COUNTOF(m_bindInfo); ++ii)
+		m_numThreads = 0;
+
+		// Jobs that didn't get compiled are returned without pipeline, so that caller
+		// can release their resources.
+		for (JobArray::iterator it = m_queue.begin(), itEnd = m_queue.end(); it != itEnd; ++it)
 		{
-			switch (m_bindInfo[ii].type)
-			{
-				case BindType::Buffer:
-				case BindType::Image:
-				{
-					VkDescriptorSetLayoutBinding& binding = m_bindings[bidx];
-					binding.stageFlags = shaderStage;
-					binding.descriptorType = BindType::Buffer == m_bindInfo[ii].type
-						? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
-						: VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
-						;
-					binding.binding = m_bindInfo[ii].binding;
-					binding.pImmutableSamplers = NULL;
-					binding.descriptorCount = 1;
-					bidx++;
-				}
-				break;
+			m_done.push_back(*it);
+			m_doneSem.post();
+		}
 
-				case BindType::Sampler:
-				{
-					VkDescriptorSetLayoutBinding& textureBinding = m_bindings[bidx];
-					textureBinding.stageFlags = shaderStage;
-					textureBinding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-					textureBinding.binding = m_bindInfo[ii].binding;
-					textureBinding.pImmutableSamplers = NULL;
-					textureBinding.descriptorCount = 1;
-					bidx++;
+		m_queue.clear();
+	}
 
-					VkDescriptorSetLayoutBinding& samplerBinding = m_bindings[bidx];
-					samplerBinding.stageFlags = shaderStage;
-					samplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
-					samplerBinding.binding = m_bindInfo[ii].samplerBinding;
-					samplerBinding.pImmutableSamplers = NULL;
-					samplerBinding.descriptorCount = 1;
-					bidx++;
-				}
-				break;
+	void PipelineCompilerVK::push(Job* _job)
+	{
+		m_pending.insert(_job->m_hash);
 
-				default:
-					break;
-			}
+		{
+			bx::MutexScope lock(m_mutex);
+			m_queue.push_back(_job);
 		}
 
-		m_numBindings = bidx;
+		m_workSem.post();
 	}
 
-	void ShaderVK::destroy()
+	PipelineCompilerVK::Job* PipelineCompilerVK::pop(bool _wait)
 	{
-		if (NULL != m_constantBuffer)
+		if (m_pending.empty()
+		|| !m_doneSem.wait(_wait ? -1 : 0) )
 		{
-			UniformBuffer::destroy(m_constantBuffer);
-			m_constantBuffer = NULL;
+			return NULL;
 		}
 
-		m_numPredefined = 0;
+		Job* job;
 
-		if (NULL != m_code)
 		{
-			release(m_code);
-			m_code = NULL;
-			m_hash = 0;
+			bx::MutexScope lock(m_mutex);
+			job = m_done.back();
+			m_done.pop_back();
 		}
 
-		if (VK_NULL_HANDLE != m_module)
-		{
-			vkDestroy(m_module);
-		}
+		m_pending.erase(m_pending.find(job->m_hash) );
+
+		return job;
 	}
 
-	void ProgramVK::create(const ShaderVK* _vsh, const ShaderVK* _fsh)
+	int32_t PipelineCompilerVK::compileThread(bx::Thread* /*_self*/, void* _userData)
 	{
-		BX_ASSERT(NULL != _vsh->m_code, "Vertex shader doesn't exist.");
-		m_vsh = _vsh;
-		bx::memCopy(
-			  &m_predefined[0]
-			, _vsh->m_predefined
-			, _vsh->m_numPredefined * sizeof(PredefinedUniform)
-			);
-		m_numPredefined = _vsh->m_numPredefined;
+		PipelineCompilerVK* compiler = (PipelineCompilerVK*)_userData;
+		BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Pipeline Compile Thread");
 
-		if (NULL != _fsh)
-		{
-			BX_ASSERT(NULL != _fsh->m_code, "Fragment shader doesn't exist.");
-			m_fsh = _fsh;
-			bx::memCopy(
-				  &m_predefined[m_numPredefined]
-				, _fsh->m_predefined
-				, _fsh->m_numPredefined * sizeof(PredefinedUniform)
-				);
-			m_numPredefined += _fsh->m_numPredefined;
-		}
-
-		m_numTextures = 0;
-
-		for (uint8_t stage = 0; stage < BX_COUNTOF(m_bindInfo); ++stage)
+		for (;;)
 		{
-			const ShaderVK* shader = NULL;
-			if (isValid(m_vsh->m_bindInfo[stage].uniformHandle) )
-			{
-				shader = _vsh;
+			compiler->m_workSem.wait();
 
-				BX_ASSERT(false
-					  || NULL == m_fsh
-					  || !isValid(m_fsh->m_bindInfo[stage].uniformHandle)
-					  || !(m_vsh->m_oldBindingModel || m_fsh->m_oldBindingModel)
-					, "Shared vertex/fragment bindings require shader binary version >= 11."
-					);
-			}
-			else if (NULL != m_fsh
-				 &&  isValid(m_fsh->m_bindInfo[stage].uniformHandle) )
+			if (compiler->m_exit)
 			{
-				shader = _fsh;
+				break;
 			}
 
-			if (NULL != shader)
+			Job* job;
+
 			{
-				m_bindInfo[stage] = shader->m_bindInfo[stage];
-				uint32_t& index = m_bindInfo[stage].index;
-				if (UINT32_MAX != index)
-				{
-					m_textures[m_numTextures] = shader->m_textures[index];
-					index = m_numTextures;
-					m_numTextures++;
-				}
+				bx::MutexScope lock(compiler->m_mutex);
+				job = compiler->m_queue.front();
+				compiler->m_queue.erase(compiler->m_queue.begin() );
 			}
-		}
-
-		// create exact pipeline layout
-		m_descriptorSetLayout = VK_NULL_HANDLE;
 
-		uint32_t numBindings = m_vsh->m_numBindings + (m_fsh ? m_fsh->m_numBindings : 0);
-		if (0 < numBindings)
-		{
-			// generate descriptor set layout hash
-			bx::HashMurmur2A murmur;
-			murmur.begin();
-			murmur.add(m_vsh->m_bindings, sizeof(VkDescriptorSetLayoutBinding) * m_vsh->m_numBindings);
+			// Pipeline cache is internally synchronized, it's not created with
+			// VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT.
+			VK_CHECK(vkCreateGraphicsPipelines(
+				  s_renderVK->m_device
+				, s_renderVK->m_pipelineCache
+				, 1
+				, &job->m_desc.m_graphicsPipeline
+				, s_renderVK->m_allocatorCb
+				, &job->m_pipeline
+				) );
 
-			if (NULL != m_fsh)
 			{
-				murmur.add(m_fsh->m_bindings, sizeof(VkDescriptorSetLayoutBinding) * m_fsh->m_numBindings);
+				bx::MutexScope lock(compiler->m_mutex);
+				compiler->m_done.push_back(job);
 			}
 
-			uint32_t descriptorSetLayoutHash = murmur.end();
+			compiler->m_doneSem.post();
+		}
 
-			m_descriptorSetLayout = s_renderVK->m_descriptorSetLayoutCache.find(descriptorSetLayoutHash);
+		return bx::kExitSuccess;
+	}
 
-			if (VK_NULL_HANDLE == m_descriptorSetLayout)
-			{
-				VkDescriptorSetLayoutBinding bindings[2 * BX_COUNTOF(ShaderVK::m_bindings)];
+	void ScratchBufferVK::create(uint32_t _size, uint32_t _count)
+	{
+		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		const VkDevice device = s_renderVK->m_device;
+		const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
 
-				bx::memCopy(
-					  bindings
-					, m_vsh->m_bindings
-					, sizeof(VkDescriptorSetLayoutBinding) * m_vsh->m_numBindings
-					);
+		const uint32_t align = uint32_t(deviceLimits.minUniformBufferOffsetAlignment);
+		const uint32_t entrySize = bx::strideAlign(_size, align);
+		const uint32_t totalSize = entrySize * _count;
 
-				numBindings = m_vsh->m_numBindings;
+		VkBufferCreateInfo bci;
+		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bci.pNext = NULL;
+		bci.flags = 0;
+		bci.size  = totalSize;
+		bci.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+		bci.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+		bci.queueFamilyIndexCount = 0;
+		bci.pQueueFamilyIndices   = NULL;
 
-				if (NULL != m_fsh)
-				{
-					for (uint16_t ii = 0; ii < m_fsh->m_numBindings; ii++)
-					{
-						const VkDescriptorSetLayoutBinding& fsBinding = m_fsh->m_bindings[ii];
-						uint16_t vsBindingIdx = UINT16_MAX;
-						for (uint16_t jj = 0; jj < m_vsh->m_numBindings; jj++)
-						{
-							if (fsBinding.binding == bindings[jj].binding)
-							{
-								vsBindingIdx = jj;
-								break;
-							}
-						}
-						if (UINT16_MAX != vsBindingIdx)
-						{
-							BX_ASSERT(
-								bindings[vsBindingIdx].descriptorType == fsBinding.descriptorType
-								, "Mismatching descriptor types. Shaders compiled with different versions of shaderc?"
-								);
-							bindings[vsBindingIdx].stageFlags |= fsBinding.stageFlags;
-						}
-						else
-						{
-							bindings[numBindings] = fsBinding;
-							numBindings++;
-						}
-					}
-				}
+		VK_CHECK(vkCreateBuffer(
+			  device
+			, &bci
+			, allocatorCb
+			, &m_buffer
+			) );
 
-				VkDescriptorSetLayoutCreateInfo dslci;
-				dslci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-				dslci.pNext = NULL;
-				dslci.flags = 0;
-				dslci.bindingCount = numBindings;
-				dslci.pBindings = bindings;
+		VkMemoryRequirements mr;
+		vkGetBufferMemoryRequirements(
+			  device
+			, m_buffer
+			, &mr
+			);
 
-				VK_CHECK(vkCreateDescriptorSetLayout(
-					  s_renderVK->m_device
-					, &dslci
-					, s_renderVK->m_allocatorCb
-					, &m_descriptorSetLayout
-					) );
+		VK_CHECK(s_renderVK->allocateMemory(&mr, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &m_deviceMem) );
 
-				s_renderVK->m_descriptorSetLayoutCache.add(descriptorSetLayoutHash, m_descriptorSetLayout);
-			}
-		}
+		m_size = (uint32_t)mr.size;
+		m_pos  = 0;
 
-		VkPipelineLayoutCreateInfo plci;
-		plci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		plci.pNext = NULL;
-		plci.flags = 0;
-		plci.pushConstantRangeCount = 0;
-		plci.pPushConstantRanges = NULL;
-		plci.setLayoutCount = (m_descriptorSetLayout == VK_NULL_HANDLE ? 0 : 1);
-		plci.pSetLayouts = &m_descriptorSetLayout;
+		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
 
-		VK_CHECK(vkCreatePipelineLayout(
-			  s_renderVK->m_device
-			, &plci
-			, s_renderVK->m_allocatorCb
-			, &m_pipelineLayout
-			) );
+		VK_CHECK(vkMapMemory(device, m_deviceMem, 0, m_size, 0, (void**)&m_data) );
 	}
 
-	void ProgramVK::destroy()
+	void ScratchBufferVK::destroy()
 	{
-		s_renderVK->release(m_pipelineLayout);
-		m_numPredefined = 0;
-		m_vsh = NULL;
-		m_fsh = NULL;
-	}
+		reset();
 
-	void ReadbackVK::create(VkImage _image, uint32_t _width, uint32_t _height, TextureFormat::Enum _format)
-	{
-		m_image  = _image;
-		m_width  = _width;
-		m_height = _height;
-		m_format = _format;
+		vkUnmapMemory(s_renderVK->m_device, m_deviceMem);
+
+		s_renderVK->release(m_buffer);
+		s_renderVK->release(m_deviceMem);
 	}
 
-	void ReadbackVK::destroy()
+	void ScratchBufferVK::reset()
 	{
-		m_image = VK_NULL_HANDLE;
+		m_pos = 0;
 	}
 
-	uint32_t ReadbackVK::pitch(uint8_t _mip) const
+	uint32_t ScratchBufferVK::alloc(uint32_t _size)
 	{
-		uint32_t mipWidth = bx::uint32_max(1, m_width >> _mip);
-		uint8_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_format) );
-		return mipWidth * bpp / 8;
+		const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
+		const uint32_t align = uint32_t(deviceLimits.minUniformBufferOffsetAlignment);
+		const uint32_t alignedSize = bx::strideAlign(_size, align);
+
+		BX_ASSERT(m_pos + alignedSize <= m_size, "Out of scratch buffer memory");
+
+		const uint32_t offset = m_pos;
+		m_pos += alignedSize;
+
+		return offset;
 	}
 
-	void ReadbackVK::copyImageToBuffer(VkCommandBuffer _commandBuffer, VkBuffer _buffer, VkImageLayout _layout, VkImageAspectFlags _aspect, uint8_t _mip) const
+	uint32_t ScratchBufferVK::write(const void* _data, uint32_t _size)
 	{
-		uint32_t mipWidth  = bx::uint32_max(1, m_width  >> _mip);
-		uint32_t mipHeight = bx::uint32_max(1, m_height >> _mip);
+		BX_ASSERT(m_pos < m_size, "Out of scratch buffer memory");
 
-		setImageMemoryBarrier(
-			  _commandBuffer
-			, m_image
-			, _aspect
-			, _layout
-			, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-			, _mip
-			, 1
-			, 0
-			, 1
-			);
+		const uint32_t offset = m_pos;
 
-		VkBufferImageCopy bic;
-		bic.bufferOffset = 0;
-		bic.bufferRowLength   = mipWidth;
-		bic.bufferImageHeight = mipHeight;
-		bic.imageSubresource.aspectMask     = _aspect;
-		bic.imageSubresource.mipLevel       = _mip;
-		bic.imageSubresource.baseArrayLayer = 0;
-		bic.imageSubresource.layerCount     = 1;
-		bic.imageOffset = { 0, 0, 0 };
-		bic.imageExtent = { mipWidth, mipHeight, 1 };
+		if (_size > 0)
+		{
+			bx::memCopy(&m_data[m_pos], _data, _size);
 
-		vkCmdCopyImageToBuffer(
-			  _commandBuffer
-			, m_image
-			, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-			, _buffer
-			, 1
-			, &bic
-			);
+			const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
+			const uint32_t align = uint32_t(deviceLimits.minUniformBufferOffsetAlignment);
+			const uint32_t alignedSize = bx::strideAlign(_size, align);
 
-		// Make changes to the buffer visible to the host
-		setMemoryBarrier(
-			_commandBuffer
-			, VK_PIPELINE_STAGE_TRANSFER_BIT
-			, VK_PIPELINE_STAGE_HOST_BIT
-			);
+			m_pos += alignedSize;
+		}
 
-		setImageMemoryBarrier(
-			  _commandBuffer
-			, m_image
-			, _aspect
-			, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-			, _layout
-			, _mip
-			, 1
-			, 0
-			, 1
-			);
+		return offset;
 	}
 
-	void ReadbackVK::readback(VkDeviceMemory _memory, VkDeviceSize _offset, void* _data, uint8_t _mip) const
+	void ScratchBufferVK::flush()
 	{
-		if (m_image == VK_NULL_HANDLE)
-		{
-			return;
-		}
-
-		uint32_t mipHeight = bx::uint32_max(1, m_height >> _mip);
-		uint32_t rowPitch = pitch(_mip);
+		const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
+		VkDevice device = s_renderVK->m_device;
 
-		uint8_t* src;
-		VK_CHECK(vkMapMemory(s_renderVK->m_device, _memory, 0, VK_WHOLE_SIZE, 0, (void**)&src) );
-		src += _offset;
-		uint8_t* dst = (uint8_t*)_data;
+		const uint32_t align = uint32_t(deviceLimits.nonCoherentAtomSize);
+		const uint32_t size  = bx::min(bx::strideAlign(m_pos, align), m_size);
 
-		for (uint32_t yy = 0; yy < mipHeight; ++yy)
-		{
-			bx::memCopy(dst, src, rowPitch);
-			src += rowPitch;
-			dst += rowPitch;
-		}
+		VkMappedMemoryRange range;
+		range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+		range.pNext  = NULL;
+		range.memory = m_deviceMem;
+		range.offset = 0;
+		range.size   = size;
+		VK_CHECK(vkFlushMappedMemoryRanges(device, 1, &range) );
+	}
 
-		vkUnmapMemory(s_renderVK->m_device, _memory);
+	void UniformCacheVK::reset()
+	{
+		m_hashMap.clear();
+		m_data.clear();
+		m_hits   = 0;
+		m_misses = 0;
 	}
 
-	VkResult TextureVK::create(VkCommandBuffer _commandBuffer, uint32_t _width, uint32_t _height, uint64_t _flags, VkFormat _format)
+	uint32_t UniformCacheVK::write(ScratchBufferVK& _scratchBuffer, const void* _vs, uint32_t _vsize, const void* _fs, uint32_t _fsize)
 	{
-		BX_ASSERT(0 != (_flags & BGFX_TEXTURE_RT_MASK), "");
-		_flags |= BGFX_TEXTURE_RT_WRITE_ONLY;
+		bx::HashMurmur2A hash;
+		hash.begin();
+		hash.add(_vsize);
+		hash.add(_fsize);
+		hash.add(_vs, int32_t(_vsize) );
+		hash.add(_fs, int32_t(_fsize) );
+		const uint32_t hashKey = hash.end();
 
-		m_flags     = _flags;
-		m_width     = _width;
-		m_height    = _height;
-		m_depth     = 1;
-		m_numLayers = 1;
-		m_requestedFormat = uint8_t(bimg::TextureFormat::Count);
-		m_textureFormat   = uint8_t(bimg::TextureFormat::Count);
-		m_format = _format;
-		m_components = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
-		m_aspectMask = getAspectMask(m_format);
-		m_sampler = s_msaa[bx::uint32_satsub( (m_flags & BGFX_TEXTURE_RT_MSAA_MASK) >> BGFX_TEXTURE_RT_MSAA_SHIFT, 1)];
-		m_type = VK_IMAGE_VIEW_TYPE_2D;
-		m_numMips = 1;
-		m_numSides = 1;
+		HashMap::const_iterator it = m_hashMap.find(hashKey);
+		if (it != m_hashMap.end() )
+		{
+			const Entry& entry = it->second;
 
-		VkResult result = createImages(_commandBuffer);
+			if (entry.m_vsize == _vsize
+			&&  entry.m_fsize == _fsize
+			&&  0 == bx::memCmp(m_data.data() + entry.m_data, _vs, _vsize)
+			&&  0 == bx::memCmp(m_data.data() + entry.m_data + _vsize, _fs, _fsize) )
+			{
+				++m_hits;
+				return entry.m_offset;
+			}
+		}
 
-		if (VK_SUCCESS == result)
+		++m_misses;
+
+		// Fragment shader constants follow vertex shader constants at scratch buffer alignment,
+		// same as when they are written separately.
+		const VkPhysicalDeviceLimits& deviceLimits = s_renderVK->m_deviceProperties.limits;
+		const uint32_t align = uint32_t(deviceLimits.minUniformBufferOffsetAlignment);
+		const uint32_t vsizeAligned = bx::strideAlign(_vsize, align);
+
+		const uint32_t offset = _scratchBuffer.alloc(vsizeAligned + _fsize);
+		bx::memCopy(&_scratchBuffer.m_data[offset], _vs, _vsize);
+		bx::memCopy(&_scratchBuffer.m_data[offset + vsizeAligned], _fs, _fsize);
+
+		// On hash collision first entry stays cached, and colliding constants are not shared.
+		if (it == m_hashMap.end() )
 		{
-			const VkImageLayout layout = 0 != (m_aspectMask & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) )
-				? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
-				: VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-				;
-			setImageMemoryBarrier(_commandBuffer, layout);
+			Entry entry;
+			entry.m_offset = offset;
+			entry.m_data   = uint32_t(m_data.size() );
+			entry.m_vsize  = _vsize;
+			entry.m_fsize  = _fsize;
+
+			m_data.resize(entry.m_data + _vsize + _fsize);
+			bx::memCopy(m_data.data() + entry.m_data, _vs, _vsize);
+			bx::memCopy(m_data.data() + entry.m_data + _vsize, _fs, _fsize);
+
+			m_hashMap.insert(stl::make_pair(hashKey, entry) );
 		}
 
-		return result;
+		return offset;
 	}
 
-	VkResult TextureVK::createImages(VkCommandBuffer _commandBuffer)
+	bool DescriptorWriteVK::isBuffer() const
 	{
-		VkResult result = VK_SUCCESS;
+		return false
+			|| VK_DESCRIPTOR_TYPE_STORAGE_BUFFER         == m_type
+			|| VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER         == m_type
+			|| VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC == m_type
+			;
+	}
 
-		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		const VkDevice device = s_renderVK->m_device;
+	void DescriptorWriteVK::hash(bx::HashMurmur2A& _murmur) const
+	{
+		_murmur.add(m_type);
+		_murmur.add(m_binding);
 
-		if (m_sampler.Count > 1)
+		if (isBuffer() )
 		{
-			BX_ASSERT(VK_IMAGE_VIEW_TYPE_3D != m_type, "Can't create multisample 3D image.");
-			BX_ASSERT(m_numMips <= 1, "Can't create multisample image with mip chain.");
+			_murmur.add(m_buffer.buffer);
+			_murmur.add(m_buffer.offset);
+			_murmur.add(m_buffer.range);
 		}
-
-		// create texture and allocate its device memory
-		VkImageCreateInfo ici;
-		ici.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-		ici.pNext = NULL;
-		ici.flags = 0
-			| (VK_IMAGE_VIEW_TYPE_CUBE == m_type
-				? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT
-				: 0
-				)
-			| (VK_IMAGE_VIEW_TYPE_3D == m_type
-				? VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT_KHR
-				: 0
-				)
-			;
-		ici.pQueueFamilyIndices   = NULL;
-		ici.queueFamilyIndexCount = 0;
-		ici.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
-		ici.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-		ici.usage                 = 0
-			| VK_IMAGE_USAGE_TRANSFER_SRC_BIT
-			| VK_IMAGE_USAGE_TRANSFER_DST_BIT
-			| VK_IMAGE_USAGE_SAMPLED_BIT
-			| (m_flags & BGFX_TEXTURE_RT_MASK
-				? (m_aspectMask & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)
-					? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
-					: VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)
-				: 0
-				)
-			| (m_flags & BGFX_TEXTURE_COMPUTE_WRITE ? VK_IMAGE_USAGE_STORAGE_BIT : 0)
-			;
-		ici.format        = m_format;
-		ici.samples       = m_sampler.Sample;
-		ici.mipLevels     = m_numMips;
-		ici.arrayLayers   = m_numSides;
-		ici.extent.width  = m_width;
-		ici.extent.height = m_height;
-		ici.extent.depth  = m_depth;
-		ici.imageType     = VK_IMAGE_VIEW_TYPE_3D == m_type
-			? VK_IMAGE_TYPE_3D
-			: VK_IMAGE_TYPE_2D
-			;
-		ici.tiling        = VK_IMAGE_TILING_OPTIMAL;
-
-		result = vkCreateImage(device, &ici, allocatorCb, &m_textureImage);
-		if (VK_SUCCESS != result)
+		else
 		{
-			BX_TRACE("Create texture image error: vkCreateImage failed %d: %s.", result, getName(result) );
-			return result;
+			_murmur.add(m_image.sampler);
+			_murmur.add(m_image.imageView);
+			_murmur.add(m_image.imageLayout);
 		}
+	}
 
-		VkMemoryRequirements imageMemReq;
-		vkGetImageMemoryRequirements(device, m_textureImage, &imageMemReq);
-
-		result = s_renderVK->allocateMemory(&imageMemReq, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_textureDeviceMem);
-		if (VK_SUCCESS != result)
+	bool DescriptorWriteVK::isEqual(const DescriptorWriteVK& _other) const
+	{
+		if (m_type    != _other.m_type
+		||  m_binding != _other.m_binding)
 		{
-			BX_TRACE("Create texture image error: allocateMemory failed %d: %s.", result, getName(result) );
-			return result;
+			return false;
 		}
 
-		result = vkBindImageMemory(device, m_textureImage, m_textureDeviceMem, 0);
-		if (VK_SUCCESS != result)
+		if (isBuffer() )
 		{
-			BX_TRACE("Create texture image error: vkBindImageMemory failed %d: %s.", result, getName(result) );
-			return result;
+			return true
+				&& m_buffer.buffer == _other.m_buffer.buffer
+				&& m_buffer.offset == _other.m_buffer.offset
+				&& m_buffer.range  == _other.m_buffer.range
+				;
 		}
 
-		const bool needResolve = true
-			&& 1 < m_sampler.Count
-			&& 0 != (ici.usage & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)
-			&& 0 == (m_flags & BGFX_TEXTURE_MSAA_SAMPLE)
-			&& 0 == (m_flags & BGFX_TEXTURE_RT_WRITE_ONLY)
+		return true
+			&& m_image.sampler     == _other.m_image.sampler
+			&& m_image.imageView   == _other.m_image.imageView
+			&& m_image.imageLayout == _other.m_image.imageLayout
 			;
+	}
 
-		if (needResolve)
-		{
-			VkImageCreateInfo ici_resolve = ici;
-			ici_resolve.samples = s_msaa[0].Sample;
-			ici_resolve.usage &= ~VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-			ici_resolve.flags &= ~VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+	DescriptorSetCacheVK::DescriptorSetCacheVK()
+		: m_frame(0)
+		, m_hits(0)
+		, m_misses(0)
+		, m_current(0)
+	{
+	}
 
-			result = vkCreateImage(device, &ici_resolve, allocatorCb, &m_singleMsaaImage);
-			if (VK_SUCCESS != result)
-			{
-				BX_TRACE("Create texture image error: vkCreateImage failed %d: %s.", result, getName(result) );
-				return result;
-			}
+	VkDescriptorSet DescriptorSetCacheVK::find(uint32_t _hash, VkDescriptorSetLayout _layout, const DescriptorWriteVK* _writes, uint32_t _num)
+	{
+		HashMap::iterator it = m_hashMap.find(_hash);
+		if (it != m_hashMap.end() )
+		{
+			Entry& entry = it->second;
 
-			VkMemoryRequirements imageMemReq_resolve;
-			vkGetImageMemoryRequirements(device, m_singleMsaaImage, &imageMemReq_resolve);
+			bool equal = true
+				&& entry.m_layout        == _layout
+				&& entry.m_writes.size() == _num
+				;
 
-			result = s_renderVK->allocateMemory(&imageMemReq_resolve, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_singleMsaaDeviceMem);
-			if (VK_SUCCESS != result)
+			for (uint32_t ii = 0; ii < _num && equal; ++ii)
 			{
-				BX_TRACE("Create texture image error: allocateMemory failed %d: %s.", result, getName(result) );
-				return result;
+				equal = entry.m_writes[ii].isEqual(_writes[ii]);
 			}
 
-			result = vkBindImageMemory(device, m_singleMsaaImage, m_singleMsaaDeviceMem, 0);
-			if (VK_SUCCESS != result)
+			if (equal)
 			{
-				BX_TRACE("Create texture image error: vkBindImageMemory failed %d: %s.", result, getName(result) );
-				return result;
+				entry.m_frame = m_frame;
+				++m_hits;
+				return entry.m_descriptorSet;
 			}
 
-			setImageMemoryBarrier(_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, true);
+			// Hash collision, entry is replaced by caller with new descriptor set.
+			release(entry);
+			m_hashMap.erase(it);
 		}
 
-		return result;
+		++m_misses;
+		return VK_NULL_HANDLE;
 	}
 
-	void* TextureVK::create(VkCommandBuffer _commandBuffer, const Memory* _mem, uint64_t _flags, uint8_t _skip)
+	VkDescriptorSet DescriptorSetCacheVK::add(uint32_t _hash, VkDescriptorSetLayout _layout, const DescriptorWriteVK* _writes, uint32_t _num)
 	{
-		bimg::ImageContainer imageContainer;
+		Entry entry;
+		entry.m_pool = alloc(_layout, entry.m_descriptorSet);
 
-		if (bimg::imageParse(imageContainer, _mem->data, _mem->size) )
+		if (VK_NULL_HANDLE == entry.m_pool)
 		{
-			const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(imageContainer.m_format);
-			const uint8_t startLod = bx::min<uint8_t>(_skip, imageContainer.m_numMips - 1);
+			return VK_NULL_HANDLE;
+		}
 
-			bimg::TextureInfo ti;
-			bimg::imageGetSize(
-				  &ti
-				, uint16_t(imageContainer.m_width >> startLod)
-				, uint16_t(imageContainer.m_height >> startLod)
-				, uint16_t(imageContainer.m_depth >> startLod)
-				, imageContainer.m_cubeMap
-				, 1 < imageContainer.m_numMips
-				, imageContainer.m_numLayers
-				, imageContainer.m_format
-				);
+		VkWriteDescriptorSet wds[RendererContextVK::kMaxDescriptorWrites];
+		vkUpdateDescriptorSets(s_renderVK->m_device, RendererContextVK::toWriteDescriptorSet(wds, entry.m_descriptorSet, _writes, _num), wds, 0, NULL);
 
-			ti.numMips = bx::min<uint8_t>(imageContainer.m_numMips - startLod, ti.numMips);
+		entry.m_layout = _layout;
+		entry.m_writes.assign(_writes, _writes + _num);
+		entry.m_frame  = m_frame;
+		m_hashMap.insert(stl::make_pair(_hash, entry) );
 
-			m_flags     = _flags;
-			m_width     = ti.width;
-			m_height    = ti.height;
-			m_depth     = ti.depth;
-			m_numLayers = ti.numLayers;
-			m_requestedFormat = uint8_t(imageContainer.m_format);
-			m_textureFormat   = uint8_t(getViableTextureFormat(imageContainer) );
-			m_format = bimg::isDepth(bimg::TextureFormat::Enum(m_textureFormat) )
-				? s_textureFormat[m_textureFormat].m_fmtDsv
-				: (m_flags & BGFX_TEXTURE_SRGB) ? s_textureFormat[m_textureFormat].m_fmtSrgb : s_textureFormat[m_textureFormat].m_fmt
-				;
-			m_components = s_textureFormat[m_textureFormat].m_mapping;
+		return entry.m_descriptorSet;
+	}
 
-			const bool convert = m_textureFormat != m_requestedFormat;
-			const uint8_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
+	void DescriptorSetCacheVK::invalidate(uint64_t _handle)
+	{
+		// Released objects are destroyed once frame is done on GPU, and after that their handles
+		// might be reused by new objects. Entries referencing them are evicted before next frame
+		// looks up sets.
+		m_evict.insert(_handle);
+	}
 
-			m_aspectMask = getAspectMask(m_format);
-			m_sampler = s_msaa[bx::uint32_satsub( (m_flags & BGFX_TEXTURE_RT_MSAA_MASK) >> BGFX_TEXTURE_RT_MSAA_SHIFT, 1)];
+	void DescriptorSetCacheVK::consume(uint32_t _frameInFlight)
+	{
+		const VkDevice device = s_renderVK->m_device;
 
-			if (imageContainer.m_cubeMap)
+		for (const Free& entry : m_free[_frameInFlight])
+		{
+			vkFreeDescriptorSets(device, entry.m_pool, 1, &entry.m_descriptorSet);
+		}
+
+		m_free[_frameInFlight].clear();
+	}
+
+	void DescriptorSetCacheVK::update()
+	{
+		++m_frame;
+		m_hits   = 0;
+		m_misses = 0;
+
+		const bool evict = !m_evict.empty();
+
+		for (HashMap::iterator it = m_hashMap.begin(); it != m_hashMap.end();)
+		{
+			const Entry& entry = it->second;
+
+			bool remove = m_frame - entry.m_frame > BGFX_CONFIG_DESCRIPTOR_SET_CACHE_MAX_AGE;
+
+			for (uint32_t ii = 0, num = uint32_t(entry.m_writes.size() ); ii < num && evict && !remove; ++ii)
 			{
-				m_type = imageContainer.m_numLayers > 1
-					? VK_IMAGE_VIEW_TYPE_CUBE_ARRAY
-					: VK_IMAGE_VIEW_TYPE_CUBE
+				const DescriptorWriteVK& write = entry.m_writes[ii];
+
+				remove = write.isBuffer()
+					? m_evict.end() != m_evict.find(uint64_t(write.m_buffer.buffer) )
+					: m_evict.end() != m_evict.find(uint64_t(write.m_image.imageView) )
+					|| m_evict.end() != m_evict.find(uint64_t(write.m_image.sampler) )
 					;
 			}
-			else if (imageContainer.m_depth > 1)
-			{
-				m_type = VK_IMAGE_VIEW_TYPE_3D;
-			}
-			else if (imageContainer.m_numLayers > 1)
+
+			if (remove)
 			{
-				m_type = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+				release(entry);
+				it = m_hashMap.erase(it);
 			}
 			else
 			{
-				m_type = VK_IMAGE_VIEW_TYPE_2D;
+				++it;
 			}
+		}
 
-			m_numMips = ti.numMips;
-			m_numSides = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
-			const uint16_t numSides = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
-			const uint32_t numSrd = numSides * ti.numMips;
+		m_evict.clear();
+	}
 
-			uint32_t kk = 0;
+	void DescriptorSetCacheVK::destroy()
+	{
+		// Destroying descriptor pool frees all descriptor sets allocated from it.
+		for (uint32_t ii = 0, num = uint32_t(m_pool.size() ); ii < num; ++ii)
+		{
+			vkDestroy(m_pool[ii]);
+		}
 
-			const bool compressed = bimg::isCompressed(bimg::TextureFormat::Enum(m_textureFormat) );
-			const bool swizzle = TextureFormat::BGRA8 == m_textureFormat && 0 != (m_flags & BGFX_TEXTURE_COMPUTE_WRITE);
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_free); ++ii)
+		{
+			m_free[ii].clear();
+		}
 
-			const bool writeOnly    = 0 != (m_flags & BGFX_TEXTURE_RT_WRITE_ONLY);
-			const bool computeWrite = 0 != (m_flags & BGFX_TEXTURE_COMPUTE_WRITE);
-			const bool renderTarget = 0 != (m_flags & BGFX_TEXTURE_RT_MASK);
-			const bool blit         = 0 != (m_flags & BGFX_TEXTURE_BLIT_DST);
+		m_hashMap.clear();
+		m_evict.clear();
+		m_pool.clear();
+		m_current = 0;
+	}
 
-			BX_UNUSED(swizzle, writeOnly, computeWrite, renderTarget, blit);
+	VkDescriptorPool DescriptorSetCacheVK::alloc(VkDescriptorSetLayout _layout, VkDescriptorSet& _descriptorSet)
+	{
+		const VkDevice device = s_renderVK->m_device;
 
-			BX_TRACE(
-				  "Texture %3d: %s (requested: %s), %dx%dx%d%s RT[%c], BO[%c], CW[%c]%s."
-				, (int)(this - s_renderVK->m_textures)
-				, getName( (TextureFormat::Enum)m_textureFormat)
-				, getName( (TextureFormat::Enum)m_requestedFormat)
-				, ti.width
-				, ti.height
-				, ti.depth
-				, imageContainer.m_cubeMap ? "x6" : ""
-				, renderTarget ? 'x' : ' '
-				, writeOnly ? 'x' : ' '
-				, computeWrite ? 'x' : ' '
-				, swizzle ? " (swizzle BGRA8 -> RGBA8)" : ""
-				);
+		VkDescriptorSetAllocateInfo dsai;
+		dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		dsai.pNext              = NULL;
+		dsai.descriptorSetCount = 1;
+		dsai.pSetLayouts        = &_layout;
 
-			VK_CHECK(createImages(_commandBuffer) );
+		// Sets are freed individually, so any pool might have room. Start from pool that had
+		// room last time, and add new pool only when all are exhausted or fragmented.
+		const uint32_t numPools = uint32_t(m_pool.size() );
 
-			// decode images
-			struct ImageInfo
+		for (uint32_t ii = 0; ii < numPools; ++ii)
+		{
+			const uint32_t idx = (m_current + ii) % numPools;
+			dsai.descriptorPool = m_pool[idx];
+
+			if (VK_SUCCESS == vkAllocateDescriptorSets(device, &dsai, &_descriptorSet) )
 			{
-				uint8_t* data;
-				uint32_t width;
-				uint32_t height;
-				uint32_t depth;
-				uint32_t pitch;
-				uint32_t slice;
-				uint32_t size;
-				uint8_t  mipLevel;
-				uint8_t  layer;
-			};
+				m_current = idx;
+				return m_pool[idx];
+			}
+		}
 
-			ImageInfo* imageInfos = (ImageInfo*)BX_ALLOC(g_allocator, sizeof(ImageInfo) * numSrd);
-			bx::memSet(imageInfos, 0, sizeof(ImageInfo) * numSrd);
-			uint32_t alignment = 1; // tightly aligned buffer
+		VkDescriptorPoolSize dps[] =
+		{
+			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 10 },
+			{ VK_DESCRIPTOR_TYPE_SAMPLER,                BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 10 },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 2<<10                                   },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 8  },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 8  },
+		};
 
-			for (uint8_t side = 0; side < numSides; ++side)
-			{
-				for (uint8_t lod = 0; lod < ti.numMips; ++lod)
-				{
-					bimg::ImageMip mip;
+		VkDescriptorPoolCreateInfo dpci;
+		dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		dpci.pNext = NULL;
+		dpci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+		dpci.maxSets       = 1<<10;
+		dpci.poolSizeCount = BX_COUNTOF(dps);
+		dpci.pPoolSizes    = dps;
 
-					if (bimg::imageGetRawData(imageContainer, side, lod + startLod, _mem->data, _mem->size, mip) )
-					{
-						if (convert)
-						{
-							const uint32_t pitch = bx::strideAlign(bx::max<uint32_t>(mip.m_width, 4) * bpp / 8, alignment);
-							const uint32_t slice = bx::strideAlign(bx::max<uint32_t>(mip.m_height, 4) * pitch, alignment);
-							const uint32_t size  = slice * mip.m_depth;
-
-							uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, size);
-							bimg::imageDecodeToBgra8(
-								  g_allocator
-								, temp
-								, mip.m_data
-								, mip.m_width
-								, mip.m_height
-								, pitch
-								, mip.m_format
-								);
+		VkDescriptorPool pool;
+		VkResult result = vkCreateDescriptorPool(device, &dpci, s_renderVK->m_allocatorCb, &pool);
 
-							imageInfos[kk].data     = temp;
-							imageInfos[kk].width    = mip.m_width;
-							imageInfos[kk].height   = mip.m_height;
-							imageInfos[kk].depth    = mip.m_depth;
-							imageInfos[kk].pitch    = pitch;
-							imageInfos[kk].slice    = slice;
-							imageInfos[kk].size     = size;
-							imageInfos[kk].mipLevel = lod;
-							imageInfos[kk].layer    = side;
-						}
-						else if (compressed)
-						{
-							const uint32_t pitch = bx::strideAlign( (mip.m_width / blockInfo.blockWidth) * mip.m_blockSize, alignment);
-							const uint32_t slice = bx::strideAlign( (mip.m_height / blockInfo.blockHeight) * pitch, alignment);
-							const uint32_t size  = slice * mip.m_depth;
-
-							uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, size);
-							bimg::imageCopy(
-								  temp
-								, mip.m_height / blockInfo.blockHeight
-								, (mip.m_width / blockInfo.blockWidth) * mip.m_blockSize
-								, mip.m_depth
-								, mip.m_data
-								, pitch
-								);
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Descriptor set cache error: vkCreateDescriptorPool failed %d: %s.", result, getName(result) );
+			return VK_NULL_HANDLE;
+		}
 
-							imageInfos[kk].data     = temp;
-							imageInfos[kk].width    = mip.m_width;
-							imageInfos[kk].height   = mip.m_height;
-							imageInfos[kk].depth    = mip.m_depth;
-							imageInfos[kk].pitch    = pitch;
-							imageInfos[kk].slice    = slice;
-							imageInfos[kk].size     = size;
-							imageInfos[kk].mipLevel = lod;
-							imageInfos[kk].layer    = side;
-						}
-						else
-						{
-							const uint32_t pitch = bx::strideAlign(mip.m_width * mip.m_bpp / 8, alignment);
-							const uint32_t slice = bx::strideAlign(mip.m_height * pitch, alignment);
-							const uint32_t size  = slice * mip.m_depth;
-
-							uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, size);
-							bimg::imageCopy(
-								  temp
-								, mip.m_height
-								, mip.m_width * mip.m_bpp / 8
-								, mip.m_depth
-								, mip.m_data
-								, pitch
-								);
+		m_pool.push_back(pool);
+		m_current = numPools;
 
-							imageInfos[kk].data     = temp;
-							imageInfos[kk].width    = mip.m_width;
-							imageInfos[kk].height   = mip.m_height;
-							imageInfos[kk].depth    = mip.m_depth;
-							imageInfos[kk].pitch    = pitch;
-							imageInfos[kk].slice    = slice;
-							imageInfos[kk].size     = size;
-							imageInfos[kk].mipLevel = lod;
-							imageInfos[kk].layer    = side;
-						}
-					}
-					++kk;
-				}
-			}
+		dsai.descriptorPool = pool;
+		result = vkAllocateDescriptorSets(device, &dsai, &_descriptorSet);
 
-			uint32_t totalMemSize = 0;
-			VkBufferImageCopy* bufferCopyInfo = (VkBufferImageCopy*)BX_ALLOC(g_allocator, sizeof(VkBufferImageCopy) * numSrd);
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Descriptor set cache error: vkAllocateDescriptorSets failed %d: %s.", result, getName(result) );
+			return VK_NULL_HANDLE;
+		}
 
-			for (uint32_t ii = 0; ii < numSrd; ++ii)
-			{
-				const uint32_t idealWidth  = bx::max<uint32_t>(1, m_width  >> imageInfos[ii].mipLevel);
-				const uint32_t idealHeight = bx::max<uint32_t>(1, m_height >> imageInfos[ii].mipLevel);
-				bufferCopyInfo[ii].bufferOffset      = totalMemSize;
-				bufferCopyInfo[ii].bufferRowLength   = 0; // assume that image data are tightly aligned
-				bufferCopyInfo[ii].bufferImageHeight = 0; // assume that image data are tightly aligned
-				bufferCopyInfo[ii].imageSubresource.aspectMask     = m_aspectMask;
-				bufferCopyInfo[ii].imageSubresource.mipLevel       = imageInfos[ii].mipLevel;
-				bufferCopyInfo[ii].imageSubresource.baseArrayLayer = imageInfos[ii].layer;
-				bufferCopyInfo[ii].imageSubresource.layerCount     = 1;
-				bufferCopyInfo[ii].imageOffset = { 0, 0, 0 };
-				bufferCopyInfo[ii].imageExtent = { idealWidth, idealHeight, imageInfos[ii].depth };
-				totalMemSize += imageInfos[ii].size;
-			}
+		return pool;
+	}
 
-			if (totalMemSize > 0)
+	void DescriptorSetCacheVK::release(const Entry& _entry)
+	{
+		// Set might still be used by frames in flight.
+		Free entry;
+		entry.m_pool          = _entry.m_pool;
+		entry.m_descriptorSet = _entry.m_descriptorSet;
+		m_free[s_renderVK->m_cmd.m_currentFrameInFlight].push_back(entry);
+	}
+
+	DescriptorAllocatorVK::DescriptorAllocatorVK()
+		: m_current(0)
+	{
+	}
+
+	VkDescriptorSet DescriptorAllocatorVK::alloc(VkDescriptorSetLayout _layout, const DescriptorWriteVK* _writes, uint32_t _num)
+	{
+		const VkDevice device = s_renderVK->m_device;
+
+		VkDescriptorSetAllocateInfo dsai;
+		dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		dsai.pNext              = NULL;
+		dsai.descriptorSetCount = 1;
+		dsai.pSetLayouts        = &_layout;
+
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+		for (;; ++m_current)
+		{
+			const bool newPool = m_current == uint32_t(m_pool.size() );
+
+			if (newPool)
 			{
-				const VkDevice device = s_renderVK->m_device;
+				VkDescriptorPoolSize dps[] =
+				{
+					{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,          BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 8 },
+					{ VK_DESCRIPTOR_TYPE_SAMPLER,                BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 8 },
+					{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 2<<8                                  },
+					{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 6 },
+					{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,          BGFX_CONFIG_MAX_TEXTURE_SAMPLERS << 6 },
+				};
 
-				VkBuffer stagingBuffer;
-				VkDeviceMemory stagingDeviceMem;
-				VK_CHECK(s_renderVK->createStagingBuffer(totalMemSize, &stagingBuffer, &stagingDeviceMem) );
+				VkDescriptorPoolCreateInfo dpci;
+				dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+				dpci.pNext = NULL;
+				dpci.flags = 0;
+				dpci.maxSets       = 1<<8;
+				dpci.poolSizeCount = BX_COUNTOF(dps);
+				dpci.pPoolSizes    = dps;
 
-				uint8_t* mappedMemory;
-				VK_CHECK(vkMapMemory(
-					  device
-					, stagingDeviceMem
-					, 0
-					, totalMemSize
-					, 0
-					, (void**)&mappedMemory
-					) );
+				VkDescriptorPool pool;
+				VkResult result = vkCreateDescriptorPool(device, &dpci, s_renderVK->m_allocatorCb, &pool);
 
-				// copy image to staging buffer
-				for (uint32_t ii = 0; ii < numSrd; ++ii)
+				if (VK_SUCCESS != result)
 				{
-					bx::memCopy(mappedMemory, imageInfos[ii].data, imageInfos[ii].size);
-					mappedMemory += imageInfos[ii].size;
+					BX_TRACE("Allocate descriptor set error: vkCreateDescriptorPool failed %d: %s.", result, getName(result) );
+					return VK_NULL_HANDLE;
 				}
 
-				vkUnmapMemory(device, stagingDeviceMem);
+				m_pool.push_back(pool);
+			}
+
+			dsai.descriptorPool = m_pool[m_current];
 
-				copyBufferToTexture(_commandBuffer, stagingBuffer, numSrd, bufferCopyInfo);
+			const VkResult result = vkAllocateDescriptorSets(device, &dsai, &descriptorSet);
 
-				s_renderVK->release(stagingBuffer);
-				s_renderVK->release(stagingDeviceMem);
-			}
-			else
+			if (VK_SUCCESS == result)
 			{
-				setImageMemoryBarrier(
-					  _commandBuffer
-					, (m_flags & BGFX_TEXTURE_COMPUTE_WRITE
-						? VK_IMAGE_LAYOUT_GENERAL
-						: VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-					) );
+				VkWriteDescriptorSet wds[RendererContextVK::kMaxDescriptorWrites];
+				vkUpdateDescriptorSets(device, RendererContextVK::toWriteDescriptorSet(wds, descriptorSet, _writes, _num), wds, 0, NULL);
+				return descriptorSet;
 			}
 
-			BX_FREE(g_allocator, bufferCopyInfo);
-
-			for (uint32_t ii = 0; ii < numSrd; ++ii)
+			// Pool is exhausted, move on to next one. Allocation from empty pool must succeed.
+			if (newPool)
 			{
-				BX_FREE(g_allocator, imageInfos[ii].data);
+				BX_TRACE("Allocate descriptor set error: vkAllocateDescriptorSets failed %d: %s.", result, getName(result) );
+				return VK_NULL_HANDLE;
 			}
-
-			BX_FREE(g_allocator, imageInfos);
-
-			m_readback.create(m_textureImage, m_width, m_height, TextureFormat::Enum(m_textureFormat) );
 		}
-
-		return m_directAccessPtr;
 	}
 
-	void TextureVK::destroy()
+	void DescriptorAllocatorVK::reset()
 	{
-		m_readback.destroy();
-
-		if (VK_NULL_HANDLE != m_textureImage)
+		for (uint32_t ii = 0, num = bx::min<uint32_t>(m_current+1, uint32_t(m_pool.size() ) ); ii < num; ++ii)
 		{
-			s_renderVK->release(m_textureImage);
-			s_renderVK->release(m_textureDeviceMem);
+			vkResetDescriptorPool(s_renderVK->m_device, m_pool[ii], 0);
 		}
 
-		if (VK_NULL_HANDLE != m_singleMsaaImage)
+		m_current = 0;
+	}
+
+	void DescriptorAllocatorVK::destroy()
+	{
+		for (uint32_t ii = 0, num = uint32_t(m_pool.size() ); ii < num; ++ii)
 		{
-			s_renderVK->release(m_singleMsaaImage);
-			s_renderVK->release(m_singleMsaaDeviceMem);
+			vkDestroy(m_pool[ii]);
 		}
 
-		m_currentImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-		m_currentSingleMsaaImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		m_pool.clear();
+		m_current = 0;
 	}
 
-	void TextureVK::update(VkCommandBuffer _commandBuffer, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem)
+	BindlessTextureSetVK::BindlessTextureSetVK()
+		: m_layout(VK_NULL_HANDLE)
+		, m_pool(VK_NULL_HANDLE)
+		, m_numFramesInFlight(0)
 	{
-		const uint32_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
-		uint32_t rectpitch = _rect.m_width * bpp / 8;
-		uint32_t slicepitch = rectpitch * _rect.m_height;
-		if (bimg::isCompressed(bimg::TextureFormat::Enum(m_textureFormat) ) )
+		bx::memSet(m_descriptorSet, 0, sizeof(m_descriptorSet) );
+		bx::memSet(m_dirty, 0, sizeof(m_dirty) );
+		bx::memSet(m_inUse, 0, sizeof(m_inUse) );
+	}
+
+	VkResult BindlessTextureSetVK::init(uint32_t _numFramesInFlight)
+	{
+		const VkDevice device = s_renderVK->m_device;
+		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+
+		m_numFramesInFlight = _numFramesInFlight;
+
+		VkDescriptorSetLayoutBinding bindings[2];
+		bindings[0].binding            = 0;
+		bindings[0].descriptorType     = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		bindings[0].descriptorCount    = BGFX_CONFIG_MAX_BINDLESS_TEXTURES;
+		bindings[0].stageFlags         = VK_SHADER_STAGE_ALL;
+		bindings[0].pImmutableSamplers = NULL;
+		bindings[1] = bindings[0];
+		bindings[1].binding            = 1;
+		bindings[1].descriptorType     = VK_DESCRIPTOR_TYPE_SAMPLER;
+
+		// Slots of destroyed or never created textures are left stale, shader must not index
+		// them.
+		const VkDescriptorBindingFlagsEXT bindingFlags[2] =
 		{
-			const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(bimg::TextureFormat::Enum(m_textureFormat) );
-			rectpitch = (_rect.m_width / blockInfo.blockWidth) * blockInfo.blockSize;
-			slicepitch = (_rect.m_height / blockInfo.blockHeight) * rectpitch;
-		}
-		const uint32_t srcpitch = UINT16_MAX == _pitch ? rectpitch : _pitch;
-		const uint32_t size     = UINT16_MAX == _pitch ? slicepitch  * _depth: _rect.m_height * _pitch * _depth;
-		const bool convert = m_textureFormat != m_requestedFormat;
+			VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT,
+			VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT,
+		};
 
-		uint8_t* data = _mem->data;
-		uint8_t* temp = NULL;
+		VkDescriptorSetLayoutBindingFlagsCreateInfoEXT dslbfci;
+		dslbfci.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+		dslbfci.pNext         = NULL;
+		dslbfci.bindingCount  = BX_COUNTOF(bindingFlags);
+		dslbfci.pBindingFlags = bindingFlags;
 
-		if (convert)
+		VkDescriptorSetLayoutCreateInfo dslci;
+		dslci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		dslci.pNext = &dslbfci;
+		dslci.flags = 0;
+		dslci.bindingCount = BX_COUNTOF(bindings);
+		dslci.pBindings    = bindings;
+
+		VkResult result = vkCreateDescriptorSetLayout(device, &dslci, allocatorCb, &m_layout);
+
+		if (VK_SUCCESS != result)
 		{
-			temp = (uint8_t*)BX_ALLOC(g_allocator, slicepitch);
-			bimg::imageDecodeToBgra8(g_allocator, temp, data, _rect.m_width, _rect.m_height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
-			data = temp;
+			return result;
 		}
 
-		VkBuffer stagingBuffer = VK_NULL_HANDLE;
-		VkDeviceMemory stagingDeviceMem = VK_NULL_HANDLE;
-		VK_CHECK(s_renderVK->createStagingBuffer(size, &stagingBuffer, &stagingDeviceMem, data) );
+		VkDescriptorPoolSize dps[] =
+		{
+			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, BGFX_CONFIG_MAX_BINDLESS_TEXTURES * m_numFramesInFlight },
+			{ VK_DESCRIPTOR_TYPE_SAMPLER,       BGFX_CONFIG_MAX_BINDLESS_TEXTURES * m_numFramesInFlight },
+		};
 
-		VkBufferImageCopy region;
-		region.bufferOffset      = 0;
-		region.bufferRowLength   = (_pitch == UINT16_MAX ? 0 : _pitch * 8 / bpp);
-		region.bufferImageHeight = 0;
-		region.imageSubresource.aspectMask     = m_aspectMask;
-		region.imageSubresource.mipLevel       = _mip;
-		region.imageSubresource.baseArrayLayer = _side;
-		region.imageSubresource.layerCount     = 1;
-		region.imageOffset = { _rect.m_x, _rect.m_y, _z };
-		region.imageExtent = { _rect.m_width, _rect.m_height, _depth };
+		VkDescriptorPoolCreateInfo dpci;
+		dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		dpci.pNext = NULL;
+		dpci.flags = 0;
+		dpci.maxSets       = m_numFramesInFlight;
+		dpci.poolSizeCount = BX_COUNTOF(dps);
+		dpci.pPoolSizes    = dps;
 
-		copyBufferToTexture(_commandBuffer, stagingBuffer, 1, &region);
+		result = vkCreateDescriptorPool(device, &dpci, allocatorCb, &m_pool);
 
-		s_renderVK->release(stagingBuffer);
-		s_renderVK->release(stagingDeviceMem);
+		if (VK_SUCCESS != result)
+		{
+			return result;
+		}
 
-		if (NULL != temp)
+		VkDescriptorSetLayout layouts[BGFX_CONFIG_MAX_FRAME_LATENCY];
+		for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 		{
-			BX_FREE(g_allocator, temp);
+			layouts[ii] = m_layout;
 		}
-	}
 
-	void TextureVK::resolve(VkCommandBuffer _commandBuffer, uint8_t _resolve, uint32_t _layer, uint32_t _numLayers, uint32_t _mip)
-	{
-		const bool needResolve = VK_NULL_HANDLE != m_singleMsaaImage;
+		VkDescriptorSetAllocateInfo dsai;
+		dsai.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		dsai.pNext              = NULL;
+		dsai.descriptorPool     = m_pool;
+		dsai.descriptorSetCount = m_numFramesInFlight;
+		dsai.pSetLayouts        = layouts;
 
-		const bool needMipGen = true
-			&& 0 != (m_flags & BGFX_TEXTURE_RT_MASK)
-			&& 0 == (m_flags & BGFX_TEXTURE_RT_WRITE_ONLY)
-			&& (_mip + 1) < m_numMips
-			&& 0 != (_resolve & BGFX_RESOLVE_AUTO_GEN_MIPS);
+		result = vkAllocateDescriptorSets(device, &dsai, m_descriptorSet);
 
-		const VkImageLayout oldLayout = m_currentImageLayout;
-		const VkImageLayout oldSingleMsaaLayout = m_currentSingleMsaaImageLayout;
+		bx::memSet(m_dirty, 0, sizeof(m_dirty) );
+		bx::memSet(m_inUse, 0, sizeof(m_inUse) );
 
-		if (needResolve)
-		{
-			setImageMemoryBarrier(_commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-			setImageMemoryBarrier(_commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, true);
+		return result;
+	}
 
-			VkImageResolve resolve;
-			resolve.srcOffset.x = 0;
-			resolve.srcOffset.y = 0;
-			resolve.srcOffset.z = 0;
-			resolve.dstOffset.x = 0;
-			resolve.dstOffset.y = 0;
-			resolve.dstOffset.z = 0;
-			resolve.srcSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-			resolve.srcSubresource.mipLevel       = _mip;
-			resolve.srcSubresource.baseArrayLayer = _layer;
-			resolve.srcSubresource.layerCount     = _numLayers;
-			resolve.dstSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-			resolve.dstSubresource.mipLevel       = _mip;
-			resolve.dstSubresource.baseArrayLayer = _layer;
-			resolve.dstSubresource.layerCount     = _numLayers;
-			resolve.extent.width  = m_width;
-			resolve.extent.height = m_height;
-			resolve.extent.depth  = 1;
+	void BindlessTextureSetVK::shutdown()
+	{
+		// Sets are freed with the pool.
+		vkDestroy(m_pool);
+		vkDestroy(m_layout);
 
-			vkCmdResolveImage(
-				  _commandBuffer
-				, m_textureImage
-				, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-				, m_singleMsaaImage
-				, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-				, 1
-				, &resolve
-				);
+		bx::memSet(m_descriptorSet, 0, sizeof(m_descriptorSet) );
+	}
+
+	void BindlessTextureSetVK::invalidate(TextureHandle _handle)
+	{
+		// Set of each frame in flight is patched on its first use, once GPU is done with it.
+		const uint32_t idx = _handle.idx;
+		if (BGFX_CONFIG_MAX_BINDLESS_TEXTURES <= idx)
+		{
+			return;
 		}
 
-		if (needResolve && needMipGen)
+		for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 		{
-			setMemoryBarrier(
-				  _commandBuffer
-				, VK_PIPELINE_STAGE_TRANSFER_BIT
-				, VK_PIPELINE_STAGE_TRANSFER_BIT
-				);
+			m_dirty[ii][idx/32] |= UINT32_C(1) << (idx%32);
 		}
+	}
 
-		if (needMipGen)
+	void BindlessTextureSetVK::consume(uint32_t _frameInFlight)
+	{
+		m_inUse[_frameInFlight] = false;
+	}
+
+	VkDescriptorSet BindlessTextureSetVK::get(uint32_t _frameInFlight)
+	{
+		if (!m_inUse[_frameInFlight])
 		{
-			setImageMemoryBarrier(_commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, needResolve);
+			update(_frameInFlight);
+			m_inUse[_frameInFlight] = true;
+		}
 
-			int32_t mipWidth  = bx::max<int32_t>(int32_t(m_width)  >> _mip, 1);
-			int32_t mipHeight = bx::max<int32_t>(int32_t(m_height) >> _mip, 1);
+		return m_descriptorSet[_frameInFlight];
+	}
 
-			const VkImage image = needResolve ? m_singleMsaaImage : m_textureImage;
+	void BindlessTextureSetVK::update(uint32_t _frameInFlight)
+	{
+		const uint32_t kMaxWrites = 64;
 
-			const VkFilter filter = bimg::isDepth(bimg::TextureFormat::Enum(m_textureFormat) )
-				? VK_FILTER_NEAREST
-				: VK_FILTER_LINEAR
-				;
+		VkDescriptorImageInfo imageInfo[kMaxWrites];
+		VkDescriptorImageInfo samplerInfo[kMaxWrites];
+		VkWriteDescriptorSet wds[kMaxWrites*2];
+		uint32_t num = 0;
 
-			VkImageBlit blit;
-			blit.srcOffsets[0] = { 0, 0, 0 };
-			blit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
-			blit.srcSubresource.aspectMask = m_aspectMask;
-			blit.srcSubresource.mipLevel = 0;
-			blit.srcSubresource.baseArrayLayer = _layer;
-			blit.srcSubresource.layerCount = _numLayers;
-			blit.dstOffsets[0] = { 0, 0, 0 };
-			blit.dstOffsets[1] = { mipWidth, mipHeight, 1 };
-			blit.dstSubresource.aspectMask = m_aspectMask;
-			blit.dstSubresource.mipLevel = 0;
-			blit.dstSubresource.baseArrayLayer = _layer;
-			blit.dstSubresource.layerCount = _numLayers;
+		const VkCommandBuffer commandBuffer = s_renderVK->m_commandBuffer;
+		uint32_t* dirty = m_dirty[_frameInFlight];
 
-			for (uint32_t i = _mip + 1; i < m_numMips; i++)
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_dirty[0]); ++ii)
+		{
+			for (uint32_t bits = dirty[ii]; 0 != bits; bits &= bits - 1)
 			{
-				blit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
-				blit.srcSubresource.mipLevel = i - 1;
+				const uint16_t idx = uint16_t(ii*32 + bx::uint32_cnttz(bits) );
+				TextureVK& texture = s_renderVK->m_textures[idx];
 
-				mipWidth  = bx::uint32_max(mipWidth  >> 1, 1);
-				mipHeight = bx::uint32_max(mipHeight >> 1, 1);
+				if (VK_NULL_HANDLE == texture.m_textureImage
+				||  VK_IMAGE_VIEW_TYPE_2D != texture.m_type
+				||  0 == (texture.m_flags & BGFX_TEXTURE_BINDLESS) )
+				{
+					continue;
+				}
 
-				blit.dstOffsets[1] = { mipWidth, mipHeight, 1 };
-				blit.dstSubresource.mipLevel = i;
+				if (VK_IMAGE_LAYOUT_GENERAL != texture.m_currentImageLayout)
+				{
+					texture.setImageMemoryBarrier(commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+				}
 
-				vk::setImageMemoryBarrier(
-					  _commandBuffer
-					, image
-					, m_aspectMask
-					, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-					, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-					, blit.srcSubresource.mipLevel
-					, 1
-					, _layer
-					, _numLayers
+				VkDescriptorImageInfo& image = imageInfo[num];
+				image.imageLayout = texture.m_currentImageLayout;
+				image.sampler     = VK_NULL_HANDLE;
+				image.imageView   = s_renderVK->getCachedImageView(
+					  { idx }
+					, 0
+					, texture.m_numMips
+					, VK_IMAGE_VIEW_TYPE_2D
 					);
 
-				vkCmdBlitImage(
-					  _commandBuffer
-					, image
-					, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-					, image
-					, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-					, 1
-					, &blit
-					, filter
+				VkDescriptorImageInfo& sampler = samplerInfo[num];
+				sampler.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+				sampler.imageView   = VK_NULL_HANDLE;
+				sampler.sampler     = s_renderVK->getSampler(
+					  uint32_t(texture.m_flags) & (BGFX_SAMPLER_BITS_MASK | BGFX_SAMPLER_BORDER_COLOR_MASK)
+					, texture.m_numMips
+					, texture.m_minLod
 					);
+
+				for (uint32_t jj = 0; jj < 2; ++jj)
+				{
+					VkWriteDescriptorSet& write = wds[num*2 + jj];
+					write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+					write.pNext            = NULL;
+					write.dstSet           = m_descriptorSet[_frameInFlight];
+					write.dstBinding       = jj;
+					write.dstArrayElement  = idx;
+					write.descriptorCount  = 1;
+					write.descriptorType   = 0 == jj ? VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLER;
+					write.pImageInfo       = 0 == jj ? &image : &sampler;
+					write.pBufferInfo      = NULL;
+					write.pTexelBufferView = NULL;
+				}
+
+				++num;
+
+				if (kMaxWrites == num)
+				{
+					vkUpdateDescriptorSets(s_renderVK->m_device, num*2, wds, 0, NULL);
+					num = 0;
+				}
 			}
 
-			vk::setImageMemoryBarrier(
-				  _commandBuffer
-				, image
-				, m_aspectMask
-				, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-				, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-				, _mip
-				, m_numMips - _mip - 1
-				, _layer
-				, _numLayers
-				);
+			dirty[ii] = 0;
 		}
 
-		setImageMemoryBarrier(_commandBuffer, oldLayout);
-		setImageMemoryBarrier(_commandBuffer, oldSingleMsaaLayout, true);
+		if (0 < num)
+		{
+			vkUpdateDescriptorSets(s_renderVK->m_device, num*2, wds, 0, NULL);
+		}
 	}
 
-	void TextureVK::copyBufferToTexture(VkCommandBuffer _commandBuffer, VkBuffer _stagingBuffer, uint32_t _bufferImageCopyCount, VkBufferImageCopy* _bufferImageCopy)
+	static uint32_t getStagingAlignment(bimg::TextureFormat::Enum _format)
 	{
-		const VkImageLayout oldLayout = m_currentImageLayout == VK_IMAGE_LAYOUT_UNDEFINED
-			? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-			: m_currentImageLayout
-			;
-
-		setImageMemoryBarrier(_commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+		// Buffer offset of buffer to image copy must be multiple of 4 and of texel block size.
+		const uint32_t blockSize = bimg::getBlockInfo(_format).blockSize;
 
-		vkCmdCopyBufferToImage(
-			  _commandBuffer
-			, _stagingBuffer
-			, m_textureImage
-			, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-			, _bufferImageCopyCount
-			, _bufferImageCopy
-			);
+		uint32_t align = blockSize;
+		while (0 != align % 4)
+		{
+			align += blockSize;
+		}
 
-		setImageMemoryBarrier(_commandBuffer, oldLayout);
+		return align;
 	}
 
-	VkImageLayout TextureVK::setImageMemoryBarrier(VkCommandBuffer _commandBuffer, VkImageLayout _newImageLayout, bool _singleMsaaImage)
+	void StagingRingVK::create(uint32_t _size)
 	{
-		if (_singleMsaaImage && VK_NULL_HANDLE == m_singleMsaaImage)
-		{
-			return VK_IMAGE_LAYOUT_UNDEFINED;
-		}
+		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		const VkDevice device = s_renderVK->m_device;
 
-		VkImageLayout& currentLayout = _singleMsaaImage
-			? m_currentSingleMsaaImageLayout
-			: m_currentImageLayout
-			;
+		VkBufferCreateInfo bci;
+		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bci.pNext = NULL;
+		bci.flags = 0;
+		bci.size  = _size;
+		bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		bci.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+		bci.queueFamilyIndexCount = 0;
+		bci.pQueueFamilyIndices   = NULL;
 
-		const VkImageLayout oldLayout = currentLayout;
+		VK_CHECK(vkCreateBuffer(device, &bci, allocatorCb, &m_buffer) );
 
-		if (currentLayout == _newImageLayout)
-		{
-			return oldLayout;
-		}
+		VkMemoryRequirements mr;
+		vkGetBufferMemoryRequirements(device, m_buffer, &mr);
 
-		const VkImage image = _singleMsaaImage
-			? m_singleMsaaImage
-			: m_textureImage
-			;
+		VK_CHECK(s_renderVK->m_memoryAllocator.alloc(
+			  mr
+			, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+			, DeviceMemoryAllocatorVK::Usage::Buffer
+			, &m_deviceMem
+			) );
 
-		vk::setImageMemoryBarrier(
-			  _commandBuffer
-			, image
-			, m_aspectMask
-			, currentLayout
-			, _newImageLayout
-			);
+		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem.m_mem, m_deviceMem.m_offset) );
 
-		currentLayout = _newImageLayout;
-		return oldLayout;
+		m_size          = _size;
+		m_pos           = 0;
+		m_demand        = 0;
+		m_numIdleFrames = 0;
 	}
 
-	VkResult TextureVK::createView(uint32_t _layer, uint32_t _numLayers, uint32_t _mip, uint32_t _numMips, VkImageViewType _type, bool _renderTarget, ::VkImageView* _view) const
+	void StagingRingVK::destroy()
 	{
-		VkResult result = VK_SUCCESS;
+		s_renderVK->release(m_buffer);
+		s_renderVK->release(m_deviceMem);
 
-		if (VK_IMAGE_VIEW_TYPE_3D == m_type)
-		{
-			BX_ASSERT(false
-				  || !_renderTarget
-				  || !(m_aspectMask & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) )
-				, "3D image can't be a depth attachment"
-			);
-		}
+		m_size = 0;
+		m_pos  = 0;
+	}
 
-		if (VK_IMAGE_VIEW_TYPE_CUBE       == _type
-		||  VK_IMAGE_VIEW_TYPE_CUBE_ARRAY == _type)
+	void StagingRingVK::reset()
+	{
+		if (VK_NULL_HANDLE == m_buffer)
 		{
-			BX_ASSERT(_numLayers % 6 == 0, "");
-			BX_ASSERT(
-				  VK_IMAGE_VIEW_TYPE_3D != m_type
-				, "3D image can't be aliased as a cube texture"
-				);
+			return;
 		}
 
-		VkImageView view = VK_NULL_HANDLE;
-
-		const VkImageAspectFlags aspectMask = 0
-			| VK_IMAGE_ASPECT_COLOR_BIT
-			| VK_IMAGE_ASPECT_DEPTH_BIT
-			| (_renderTarget ? VK_IMAGE_ASPECT_STENCIL_BIT : 0)
-			;
+		uint32_t size = m_size;
 
-		VkImageViewCreateInfo viewInfo;
-		viewInfo.sType      = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-		viewInfo.pNext      = NULL;
-		viewInfo.flags      = 0;
-		viewInfo.image      = ((VK_NULL_HANDLE != m_singleMsaaImage) && !_renderTarget)
-			? m_singleMsaaImage
-			: m_textureImage
-			;
-		viewInfo.viewType   = _type;
-		viewInfo.format     = m_format;
-		viewInfo.components = m_components;
-		viewInfo.subresourceRange.aspectMask     = m_aspectMask & aspectMask;
-		viewInfo.subresourceRange.baseMipLevel   = _mip;
-		viewInfo.subresourceRange.levelCount     = _numMips;
-		viewInfo.subresourceRange.baseArrayLayer = _layer;
-		viewInfo.subresourceRange.layerCount     = 1;
+		if (m_demand > m_size)
+		{
+			// Uploads didn't fit, grow to what the frame needed.
+			while (size < m_demand
+			&&     size < BGFX_CONFIG_MAX_STAGING_BUFFER_SIZE)
+			{
+				size *= 2;
+			}
 
-		if (VK_IMAGE_VIEW_TYPE_2D != _type
-		&&  VK_IMAGE_VIEW_TYPE_3D != _type)
+			size = bx::min<uint32_t>(size, BGFX_CONFIG_MAX_STAGING_BUFFER_SIZE);
+			m_numIdleFrames = 0;
+		}
+		else if (m_demand < m_size/4
+		&&       m_size > BGFX_CONFIG_STAGING_BUFFER_SIZE)
 		{
-			viewInfo.subresourceRange.layerCount = VK_IMAGE_VIEW_TYPE_CUBE == _type
-				? 6
-				: _numLayers
-				;
+			// Shrink back after being mostly unused for a while.
+			if (++m_numIdleFrames > 256)
+			{
+				size = m_size/2;
+				m_numIdleFrames = 0;
+			}
 		}
-
-		result = vkCreateImageView(
-			  s_renderVK->m_device
-			, &viewInfo
-			, s_renderVK->m_allocatorCb
-			, &view
-			);
-
-		if (VK_SUCCESS != result)
+		else
 		{
-			BX_TRACE("Create texture view error: vkCreateImageView failed %d: %s.", result, getName(result) );
-			return result;
+			m_numIdleFrames = 0;
 		}
 
-		*_view = view;
+		if (size != m_size)
+		{
+			BX_TRACE("Staging buffer resize %d -> %d bytes.", m_size, size);
+			destroy();
+			create(size);
+		}
 
-		return result;
+		m_pos    = 0;
+		m_demand = 0;
 	}
 
-	VkImageAspectFlags TextureVK::getAspectMask(VkFormat _format)
+	bool StagingRingVK::alloc(uint32_t _size, uint32_t _align, StagingBufferVK* _staging)
 	{
-		switch (_format)
+		const uint32_t offset = (m_pos + _align - 1) / _align * _align;
+
+		m_demand += _size + _align - 1;
+
+		if (offset + _size > m_size)
 		{
-		case VK_FORMAT_S8_UINT:
-			return VK_IMAGE_ASPECT_STENCIL_BIT;
-			break;
-		case VK_FORMAT_D16_UNORM:
-		case VK_FORMAT_X8_D24_UNORM_PACK32:
-		case VK_FORMAT_D32_SFLOAT:
-			return VK_IMAGE_ASPECT_DEPTH_BIT;
-		case VK_FORMAT_D16_UNORM_S8_UINT:
-		case VK_FORMAT_D24_UNORM_S8_UINT:
-		case VK_FORMAT_D32_SFLOAT_S8_UINT:
-			return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
-		default:
-			return VK_IMAGE_ASPECT_COLOR_BIT;
+			return false;
 		}
+
+		m_pos = offset + _size;
+
+		_staging->m_buffer   = m_buffer;
+		_staging->m_data     = m_deviceMem.m_data + offset;
+		_staging->m_offset   = offset;
+		_staging->m_size     = _size;
+		_staging->m_fromRing = true;
+
+		return true;
 	}
 
-	VkResult SwapChainVK::create(VkCommandBuffer _commandBuffer, void* _nwh, const Resolution& _resolution, TextureFormat::Enum _depthFormat)
+	void BufferVK::create(VkCommandBuffer _commandBuffer, uint32_t _size, void* _data, uint16_t _flags, bool _vertex, uint32_t _stride)
 	{
-		struct ErrorState
-		{
-			enum Enum
-			{
-				Default,
-				SurfaceCreated,
-				SwapChainCreated,
-				AttachmentsCreated
-			};
-		};
+		BX_UNUSED(_stride);
 
-		ErrorState::Enum errorState = ErrorState::Default;
+		m_size    = _size;
+		m_flags   = _flags;
+		m_dynamic = NULL == _data;
 
-		VkResult result = VK_SUCCESS;
+		const bool storage  = m_flags & BGFX_BUFFER_COMPUTE_READ_WRITE;
+		const bool indirect = m_flags & BGFX_BUFFER_DRAW_INDIRECT;
 
-		if (NULL == _nwh)
-		{
-			return result;
-		}
+		VkBufferCreateInfo bci;
+		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bci.pNext = NULL;
+		bci.flags = 0;
+		bci.size  = _size;
+		bci.usage = 0
+			| (_vertex              ? VK_BUFFER_USAGE_VERTEX_BUFFER_BIT   : VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+			| (storage || indirect  ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT  : 0)
+			| (indirect             ? VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT : 0)
+			| VK_BUFFER_USAGE_TRANSFER_DST_BIT
+			;
+		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		bci.queueFamilyIndexCount = 0;
+		bci.pQueueFamilyIndices   = NULL;
 
-		m_nwh = _nwh;
-		m_resolution = _resolution;
-		m_depthFormat = TextureFormat::Count == _depthFormat ? TextureFormat::D24S8 : _depthFormat;
+		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		const VkDevice device = s_renderVK->m_device;
 
-		m_queue = s_renderVK->m_queueGraphics;
+		if (m_flags & BGFX_BUFFER_INTERNAL_TRANSIENT)
+		{
+			// One slot per frame in flight, plus the one being written by the API thread, plus
+			// the one being recorded by the render thread.
+			m_ring = (TransientRingVK*)BX_ALLOC(g_allocator, sizeof(TransientRingVK) );
+			m_ring->m_num     = s_renderVK->m_numFramesInFlight + 2;
+			m_ring->m_current = 0;
 
-		result = createSurface();
+			const VkMemoryPropertyFlags hostFlags = 0
+				| VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+				| VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+				;
 
-		if (VK_SUCCESS != result)
-		{
-			BX_TRACE("Create swap chain error: creating surface failed %d: %s.", result, getName(result) );
-			goto error;
-		}
+			for (uint32_t ii = 0; ii < m_ring->m_num; ++ii)
+			{
+				VK_CHECK(vkCreateBuffer(device, &bci, allocatorCb, &m_ring->m_buffer[ii]) );
 
-		errorState = ErrorState::SurfaceCreated;
+				VkMemoryRequirements mr;
+				vkGetBufferMemoryRequirements(device, m_ring->m_buffer[ii], &mr);
 
-		{
-			m_sci.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-			m_sci.pNext = NULL;
-			m_sci.flags = 0;
-			m_sci.imageArrayLayers      = 1;
-			m_sci.imageSharingMode      = VK_SHARING_MODE_EXCLUSIVE;
-			m_sci.queueFamilyIndexCount = 0;
-			m_sci.pQueueFamilyIndices   = NULL;
-			m_sci.preTransform          = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
-			m_sci.oldSwapchain          = VK_NULL_HANDLE;
+				// Prefer device local host visible memory when available.
+				VkResult result = s_renderVK->allocateMemory(&mr, hostFlags | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &m_ring->m_deviceMem[ii]);
+				if (VK_SUCCESS != result)
+				{
+					VK_CHECK(s_renderVK->allocateMemory(&mr, hostFlags, &m_ring->m_deviceMem[ii]) );
+				}
 
-			for (uint32_t ii = 0; ii < BX_COUNTOF(m_backBufferColorImageView); ++ii)
-			{
-				m_backBufferColorImage[ii]     = VK_NULL_HANDLE;
-				m_backBufferColorImageView[ii] = VK_NULL_HANDLE;
-				m_backBufferFrameBuffer[ii]    = VK_NULL_HANDLE;
-				m_backBufferFence[ii]          = VK_NULL_HANDLE;
-				m_presentDoneSemaphore[ii]     = VK_NULL_HANDLE;
-				m_renderDoneSemaphore[ii]      = VK_NULL_HANDLE;
+				VK_CHECK(vkBindBufferMemory(device, m_ring->m_buffer[ii], m_ring->m_deviceMem[ii], 0) );
+				VK_CHECK(vkMapMemory(device, m_ring->m_deviceMem[ii], 0, _size, 0, (void**)&m_ring->m_data[ii]) );
 			}
 
-			m_lastImageRenderedSemaphore = VK_NULL_HANDLE;
-			m_lastImageAcquiredSemaphore = VK_NULL_HANDLE;
+			m_buffer = m_ring->m_buffer[0];
+			return;
+		}
 
-			result = createSwapChain();
+		VK_CHECK(vkCreateBuffer(device, &bci, allocatorCb, &m_buffer) );
 
-			if (VK_SUCCESS != result)
-			{
-				BX_TRACE("Create swap chain error: creating swapchain and image views failed %d: %s", result, getName(result) );
-				goto error;
-			}
-		}
+		VkMemoryRequirements mr;
+		vkGetBufferMemoryRequirements(device, m_buffer, &mr);
 
-		errorState = ErrorState::SwapChainCreated;
+		VK_CHECK(s_renderVK->m_memoryAllocator.alloc(mr, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, DeviceMemoryAllocatorVK::Usage::Buffer, &m_deviceMem) );
 
-		{
-			result = createAttachments(_commandBuffer);
+		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem.m_mem, m_deviceMem.m_offset) );
 
-			if (VK_SUCCESS != result)
-			{
-				BX_TRACE("Create swap chain error: creating MSAA/depth attachments failed %d: %s.", result, getName(result) );
-				goto error;
-			}
+		if (!m_dynamic)
+		{
+			update(_commandBuffer, 0, _size, _data);
 		}
+	}
 
-		errorState = ErrorState::AttachmentsCreated;
+	void BufferVK::update(VkCommandBuffer _commandBuffer, uint32_t _offset, uint32_t _size, void* _data, bool _discard)
+	{
+		BX_UNUSED(_discard);
 
+		if (NULL != m_ring)
 		{
-			result = createFrameBuffer();
+			uint8_t* dst = &m_ring->m_data[m_ring->m_current][_offset];
 
-			if (VK_SUCCESS != result)
+			// Data written in place by the API thread is already visible, memory is coherent.
+			if (dst != _data)
 			{
-				BX_TRACE("Create swap chain error: creating frame buffers failed %d: %s.", result, getName(result) );
-				goto error;
+				bx::memCopy(dst, _data, _size);
 			}
-		}
-
-		return VK_SUCCESS;
 
-	error:
-		BX_TRACE("errorState %d", errorState);
-		switch (errorState)
-		{
-		case ErrorState::AttachmentsCreated:
-			releaseAttachments();
-			BX_FALLTHROUGH;
+			return;
+		}
 
-		case ErrorState::SwapChainCreated:
-			releaseSwapChain();
-			BX_FALLTHROUGH;
+		BX_UNUSED(_commandBuffer);
 
-		case ErrorState::SurfaceCreated:
-			releaseSurface();
-			BX_FALLTHROUGH;
+		StagingBufferVK staging = s_renderVK->allocStagingBuffer(_size, 4, _data);
 
-		case ErrorState::Default:
-			break;
-		};
+		VkBufferCopy region;
+		region.srcOffset = staging.m_offset;
+		region.dstOffset = _offset;
+		region.size      = _size;
+		s_renderVK->copyBuffer(staging.m_buffer, m_buffer, region);
 
-		return VK_SUCCESS != result
-			? result
-			: VK_ERROR_INITIALIZATION_FAILED
-			;
+		s_renderVK->releaseStagingBuffer(staging);
 	}
 
-	void SwapChainVK::destroy()
+	void BufferVK::destroy()
 	{
-		if (VK_NULL_HANDLE != m_swapchain)
+		if (NULL != m_ring)
 		{
-			releaseFrameBuffer();
-			releaseAttachments();
-			releaseSwapChain();
-			releaseSurface();
+			for (uint32_t ii = 0; ii < m_ring->m_num; ++ii)
+			{
+				s_renderVK->m_descriptorSetCache.invalidate(uint64_t(m_ring->m_buffer[ii].vk) );
+				vkUnmapMemory(s_renderVK->m_device, m_ring->m_deviceMem[ii]);
+				s_renderVK->release(m_ring->m_buffer[ii]);
+				s_renderVK->release(m_ring->m_deviceMem[ii]);
+			}
 
-			// can't delay-delete the surface, since there can only be one swapchain per surface
-			// new framebuffer with the same window would get an error at swapchain creation
-			s_renderVK->kick(true);
+			BX_FREE(g_allocator, m_ring);
+			m_ring    = NULL;
+			m_buffer  = VK_NULL_HANDLE;
+			m_dynamic = false;
 		}
+		else if (VK_NULL_HANDLE != m_buffer)
+		{
+			s_renderVK->m_descriptorSetCache.invalidate(uint64_t(m_buffer.vk) );
+			s_renderVK->release(m_buffer);
+			s_renderVK->release(m_deviceMem);
 
-		m_nwh = NULL;
+			m_dynamic = false;
+		}
 	}
 
-	void SwapChainVK::update(VkCommandBuffer _commandBuffer, void* _nwh, const Resolution& _resolution)
+	uint8_t* BufferVK::advance()
 	{
-		const VkPhysicalDevice physicalDevice = s_renderVK->m_physicalDevice;
+		BX_ASSERT(NULL != m_ring, "Only transient buffers have a ring.");
 
-		m_lastImageRenderedSemaphore = VK_NULL_HANDLE;
-		m_lastImageAcquiredSemaphore = VK_NULL_HANDLE;
+		m_ring->m_current = (m_ring->m_current + 1) % m_ring->m_num;
+		m_buffer = m_ring->m_buffer[m_ring->m_current];
 
-		const uint64_t recreateSurfaceMask     = BGFX_RESET_HIDPI;
-		const uint64_t recreateSwapchainMask   = BGFX_RESET_VSYNC | BGFX_RESET_SRGB_BACKBUFFER;
-		const uint64_t recreateAttachmentsMask = BGFX_RESET_MSAA_MASK;
+		return m_ring->m_data[m_ring->m_current];
+	}
 
-		const bool recreateSurface = false
-			|| m_needToRecreateSurface
-			|| m_nwh != _nwh
-			|| (m_resolution.reset & recreateSurfaceMask) != (_resolution.reset & recreateSurfaceMask)
-			;
+	void VertexBufferVK::create(VkCommandBuffer _commandBuffer, uint32_t _size, void* _data, VertexLayoutHandle _layoutHandle, uint16_t _flags)
+	{
+		BufferVK::create(_commandBuffer, _size, _data, _flags, true);
+		m_layoutHandle = _layoutHandle;
+	}
 
-		const bool recreateSwapchain = false
-			|| m_resolution.format != _resolution.format
-			|| m_resolution.width  != _resolution.width
-			|| m_resolution.height != _resolution.height
-			|| (m_resolution.reset & recreateSwapchainMask) != (_resolution.reset & recreateSwapchainMask)
-			|| recreateSurface
-			;
+	void ShaderVK::create(const Memory* _mem)
+	{
+		bx::MemoryReader reader(_mem->data, _mem->size);
 
-		const bool recreateAttachments = false
-			|| (m_resolution.reset & recreateAttachmentsMask) != (_resolution.reset & recreateAttachmentsMask)
-			|| recreateSwapchain
-			;
+		uint32_t magic;
+		bx::read(&reader, magic);
 
-		m_nwh = _nwh;
-		m_resolution = _resolution;
+		VkShaderStageFlagBits shaderStage = VK_SHADER_STAGE_ALL;
+		BX_UNUSED(shaderStage);
 
-		if (recreateAttachments)
+		if (isShaderType(magic, 'C') )
 		{
-			releaseFrameBuffer();
-			releaseAttachments();
-
-			if (recreateSwapchain)
-			{
-				releaseSwapChain();
+			shaderStage = VK_SHADER_STAGE_COMPUTE_BIT;
+		}
+		else if (isShaderType(magic, 'F') )
+		{
+			shaderStage = VK_SHADER_STAGE_FRAGMENT_BIT;
+		}
+		else if (isShaderType(magic, 'V') )
+		{
+			shaderStage = VK_SHADER_STAGE_VERTEX_BIT;
+		}
 
-				if (recreateSurface)
-				{
-					m_sci.oldSwapchain = VK_NULL_HANDLE;
-					releaseSurface();
-					s_renderVK->kick(true);
+		const bool fragment = isShaderType(magic, 'F');
 
-					VkResult result = createSurface();
-					if (VK_SUCCESS != result)
-					{
-						BX_TRACE("Surface lost.");
-						return;
-					}
-				}
+		uint32_t hashIn;
+		bx::read(&reader, hashIn);
 
-				VkSurfaceCapabilitiesKHR surfaceCapabilities;
-				VK_CHECK(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, m_surface, &surfaceCapabilities) );
+		uint32_t hashOut;
 
-				const uint32_t width = bx::clamp<uint32_t>(
-					  m_resolution.width
-					, surfaceCapabilities.minImageExtent.width
-					, surfaceCapabilities.maxImageExtent.width
-					);
-				const uint32_t height = bx::clamp<uint32_t>(
-					  m_resolution.height
-					, surfaceCapabilities.minImageExtent.height
-					, surfaceCapabilities.maxImageExtent.height
-					);
+		if (isShaderVerLess(magic, 6) )
+		{
+			hashOut = hashIn;
+		}
+		else
+		{
+			bx::read(&reader, hashOut);
+		}
 
-				// swapchain can't have size 0
-				// on some platforms this happens when minimized
-				if (width  == 0
-				||  height == 0)
-				{
-					m_sci.oldSwapchain = VK_NULL_HANDLE;
-					s_renderVK->kick(true);
-					return;
-				}
+		uint16_t count;
+		bx::read(&reader, count);
 
-				VK_CHECK(createSwapChain() );
-			}
+		m_numPredefined = 0;
+		m_numUniforms = count;
+		m_numTextures = 0;
 
-			VK_CHECK(createAttachments(_commandBuffer) );
-			VK_CHECK(createFrameBuffer() );
-		}
-	}
+		m_oldBindingModel = isShaderVerLess(magic, 11);
+		m_bindless        = false;
 
-	VkResult SwapChainVK::createSurface()
-	{
-		VkResult result = VK_ERROR_INITIALIZATION_FAILED;
+		BX_TRACE("%s Shader consts %d"
+			, getShaderTypeName(magic)
+			, count
+			);
 
-		const VkInstance instance = s_renderVK->m_instance;
-		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		uint8_t fragmentBit = fragment ? kUniformFragmentBit : 0;
 
-#if BX_PLATFORM_WINDOWS
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
 		{
-			if (NULL != vkCreateWin32SurfaceKHR)
-			{
-				VkWin32SurfaceCreateInfoKHR sci;
-				sci.sType = VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR;
-				sci.pNext = NULL;
-				sci.flags     = 0;
-				sci.hinstance = (HINSTANCE)GetModuleHandle(NULL);
-				sci.hwnd      = (HWND)m_nwh;
-				result = vkCreateWin32SurfaceKHR(instance, &sci, allocatorCb, &m_surface);
-			}
+			m_bindInfo[ii].uniformHandle  = BGFX_INVALID_HANDLE;
+			m_bindInfo[ii].type           = BindType::Count;
+			m_bindInfo[ii].binding        = 0;
+			m_bindInfo[ii].samplerBinding = 0;
+			m_bindInfo[ii].index          = UINT32_MAX;
 		}
-#elif BX_PLATFORM_ANDROID
+
+		if (0 < count)
 		{
-			if (NULL != vkCreateAndroidSurfaceKHR)
+			for (uint32_t ii = 0; ii < count; ++ii)
 			{
-				VkAndroidSurfaceCreateInfoKHR sci;
-				sci.sType = VK_STRUCTURE_TYPE_ANDROID_SURFACE_CREATE_INFO_KHR;
-				sci.pNext = NULL;
-				sci.flags = 0;
-				sci.window = (ANativeWindow*)m_nwh;
-				result = vkCreateAndroidSurfaceKHR(instance, &sci, allocatorCb, &m_surface);
-			}
-		}
-#elif BX_PLATFORM_LINUX
-		{
-			if (NULL != vkCreateXlibSurfaceKHR)
+				uint8_t nameSize = 0;
+				bx::read(&reader, nameSize);
+
+				char name[256];
+				bx::read(&reader, &name, nameSize);
+				name[nameSize] = '\0';
+
+				uint8_t type = 0;
+				bx::read(&reader, type);
+
+				uint8_t num;
+				bx::read(&reader, num);
+
+				uint16_t regIndex;
+				bx::read(&reader, regIndex);
+
+				uint16_t regCount;
+				bx::read(&reader, regCount);
+
+				const bool hasTexData = !isShaderVerLess(magic, 8);
+				const bool hasTexFormat = !isShaderVerLess(magic, 10);
+				uint8_t texComponent = 0;
+				uint8_t texDimension = 0;
+				uint16_t texFormat = 0;
+
+				if (hasTexData)
+				{
+					bx::read(&reader, texComponent);
+					bx::read(&reader, texDimension);
+				}
+
+				if (hasTexFormat)
+				{
+					bx::read(&reader, texFormat);
+				}
+
+				const char* kind = "invalid";
+
+				BX_UNUSED(num);
+				BX_UNUSED(texComponent);
+				BX_UNUSED(texFormat);
+
+				auto textureDimensionToViewType = [](TextureDimension::Enum dimension)
+				{
+					switch (dimension)
+					{
+					case TextureDimension::Dimension1D:        return VK_IMAGE_VIEW_TYPE_1D;
+					case TextureDimension::Dimension2D:        return VK_IMAGE_VIEW_TYPE_2D;
+					case TextureDimension::Dimension2DArray:   return VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+					case TextureDimension::DimensionCube:      return VK_IMAGE_VIEW_TYPE_CUBE;
+					case TextureDimension::DimensionCubeArray: return VK_IMAGE_VIEW_TYPE_CUBE_ARRAY;
+					case TextureDimension::Dimension3D:        return VK_IMAGE_VIEW_TYPE_3D;
+					default:                                   return VK_IMAGE_VIEW_TYPE_MAX_ENUM;
+					}
+				};
+
+				if (UINT16_MAX != regIndex)
+				{
+					PredefinedUniform::Enum predefined = nameToPredefinedUniformEnum(name);
+					if (PredefinedUniform::Count != predefined)
+					{
+						kind = "predefined";
+						m_predefined[m_numPredefined].m_loc   = regIndex;
+						m_predefined[m_numPredefined].m_count = regCount;
+						m_predefined[m_numPredefined].m_type  = uint8_t(predefined|fragmentBit);
+						m_numPredefined++;
+					}
+					else if (UniformType::End == (~kUniformMask & type) )
+					{
+						// regCount is used for descriptor type
+						if (DescriptorType::BindlessTexture == idToDescriptorType(regCount) )
+						{
+							// Bindless textures are in global descriptor set 1, and not part of
+							// shader's own descriptor set layout.
+							m_bindless = true;
+							continue;
+						}
+
+						const bool isBuffer = idToDescriptorType(regCount) == DescriptorType::StorageBuffer;
+						if (0 == regIndex)
+						{
+							continue;
+						}
+
+						const uint8_t reverseShift = m_oldBindingModel
+							? (fragment ? kSpirvOldFragmentShift : 0) + (isBuffer ? kSpirvOldBufferShift : kSpirvOldImageShift)
+							: kSpirvBindShift;
+
+						const uint16_t stage = regIndex - reverseShift; // regIndex is used for buffer binding index
+
+						m_bindInfo[stage].type = isBuffer ? BindType::Buffer : BindType::Image;
+						m_bindInfo[stage].uniformHandle  = { 0 };
+						m_bindInfo[stage].binding        = regIndex;
+
+						if (!isBuffer)
+						{
+							const VkImageViewType viewType = hasTexData
+								? textureDimensionToViewType(idToTextureDimension(texDimension) )
+								: VK_IMAGE_VIEW_TYPE_MAX_ENUM
+								;
+
+							if (VK_IMAGE_VIEW_TYPE_MAX_ENUM != viewType)
+							{
+								m_bindInfo[stage].index = m_numTextures;
+								m_textures[m_numTextures].type = viewType;
+								m_numTextures++;
+							}
+						}
+
+						kind = "storage";
+					}
+					else if (UniformType::Sampler == (~kUniformMask & type) )
+					{
+						const uint8_t reverseShift = m_oldBindingModel
+							? (fragment ? kSpirvOldFragmentShift : 0) + kSpirvOldTextureShift
+							: kSpirvBindShift;
+
+						const uint16_t stage = regIndex - reverseShift; // regIndex is used for image/sampler binding index
+
+						const UniformRegInfo* info = s_renderVK->m_uniformReg.find(name);
+						BX_ASSERT(NULL != info, "User defined uniform '%s' is not found, it won't be set.", name);
+
+						m_bindInfo[stage].uniformHandle    = info->m_handle;
+						m_bindInfo[stage].type             = BindType::Sampler;
+						m_bindInfo[stage].binding          = regIndex;
+						m_bindInfo[stage].samplerBinding   = regIndex + kSpirvSamplerShift;
+
+						const VkImageViewType viewType = hasTexData
+							? textureDimensionToViewType(idToTextureDimension(texDimension) )
+							: VK_IMAGE_VIEW_TYPE_MAX_ENUM
+							;
+
+						if (VK_IMAGE_VIEW_TYPE_MAX_ENUM != viewType)
+						{
+							m_bindInfo[stage].index = m_numTextures;
+							m_textures[m_numTextures].type = viewType;
+							m_numTextures++;
+						}
+
+						kind = "sampler";
+					}
+					else
+					{
+						const UniformRegInfo* info = s_renderVK->m_uniformReg.find(name);
+						BX_ASSERT(NULL != info, "User defined uniform '%s' is not found, it won't be set.", name);
+
+						if (NULL != info)
+						{
+							if (NULL == m_constantBuffer)
+							{
+								m_constantBuffer = UniformBuffer::create(1024);
+							}
+
+							kind = "user";
+							m_constantBuffer->writeUniformHandle( (UniformType::Enum)(type|fragmentBit), regIndex, info->m_handle, regCount);
+						}
+					}
+				}
+
+				BX_TRACE("\t%s: %s (%s), r.index %3d, r.count %2d, r.texComponent %1d, r.texDimension %1d"
+					, kind
+					, name
+					, getUniformTypeName(UniformType::Enum(type&~kUniformMask) )
+					, regIndex
+					, regCount
+					, texComponent
+					, texDimension
+					);
+				BX_UNUSED(kind);
+			}
+
+			if (NULL != m_constantBuffer)
+			{
+				m_constantBuffer->finish();
+			}
+		}
+
+		uint32_t shaderSize;
+		bx::read(&reader, shaderSize);
+
+		const void* code = reader.getDataPtr();
+		bx::skip(&reader, shaderSize+1);
+
+		m_code = alloc(shaderSize);
+		bx::memCopy(m_code->data, code, shaderSize);
+
+		VkShaderModuleCreateInfo smci;
+		smci.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		smci.pNext    = NULL;
+		smci.flags    = 0;
+		smci.codeSize = m_code->size;
+		smci.pCode    = (const uint32_t*)m_code->data;
+
+//		disassemble(bx::getDebugOut(), m_code->data, m_code->size);
+
+		VK_CHECK(vkCreateShaderModule(
+			  s_renderVK->m_device
+			, &smci
+			, s_renderVK->m_allocatorCb
+			, &m_module
+			) );
+
+		bx::memSet(m_attrMask,  0, sizeof(m_attrMask) );
+		bx::memSet(m_attrRemap, 0, sizeof(m_attrRemap) );
+
+		bx::read(&reader, m_numAttrs);
+
+		for (uint8_t ii = 0; ii < m_numAttrs; ++ii)
+		{
+			uint16_t id;
+			bx::read(&reader, id);
+
+			Attrib::Enum attr = idToAttrib(id);
+
+			if (Attrib::Count != attr)
+			{
+				m_attrMask[attr]  = UINT16_MAX;
+				m_attrRemap[attr] = ii;
+			}
+		}
+
+		bx::HashMurmur2A murmur;
+		murmur.begin();
+		murmur.add(hashIn);
+		murmur.add(hashOut);
+		murmur.add(m_code->data, m_code->size);
+		murmur.add(m_numAttrs);
+		murmur.add(m_attrMask,  m_numAttrs);
+		murmur.add(m_attrRemap, m_numAttrs);
+		m_hash = murmur.end();
+
+		bx::read(&reader, m_size);
+
+		// fill binding description with uniform informations
+		uint16_t bidx = 0;
+		if (m_size > 0)
+		{
+			m_uniformBinding = fragment ? (m_oldBindingModel ? kSpirvOldFragmentBinding : kSpirvFragmentBinding) : 0;
+
+			VkDescriptorSetLayoutBinding& binding = m_bindings[bidx];
+			binding.stageFlags = shaderStage;
+			binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+			binding.binding = m_uniformBinding;
+			binding.pImmutableSamplers = NULL;
+			binding.descriptorCount = 1;
+			bidx++;
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_bindInfo); ++ii)
+		{
+			switch (m_bindInfo[ii].type)
+			{
+				case BindType::Buffer:
+				case BindType::Image:
+				{
+					VkDescriptorSetLayoutBinding& binding = m_bindings[bidx];
+					binding.stageFlags = shaderStage;
+					binding.descriptorType = BindType::Buffer == m_bindInfo[ii].type
+						? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+						: VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
+						;
+					binding.binding = m_bindInfo[ii].binding;
+					binding.pImmutableSamplers = NULL;
+					binding.descriptorCount = 1;
+					bidx++;
+				}
+				break;
+
+				case BindType::Sampler:
+				{
+					VkDescriptorSetLayoutBinding& textureBinding = m_bindings[bidx];
+					textureBinding.stageFlags = shaderStage;
+					textureBinding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+					textureBinding.binding = m_bindInfo[ii].binding;
+					textureBinding.pImmutableSamplers = NULL;
+					textureBinding.descriptorCount = 1;
+					bidx++;
+
+					VkDescriptorSetLayoutBinding& samplerBinding = m_bindings[bidx];
+					samplerBinding.stageFlags = shaderStage;
+					samplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+					samplerBinding.binding = m_bindInfo[ii].samplerBinding;
+					samplerBinding.pImmutableSamplers = NULL;
+					samplerBinding.descriptorCount = 1;
+					bidx++;
+				}
+				break;
+
+				default:
+					break;
+			}
+		}
+
+		m_numBindings = bidx;
+	}
+
+	void ShaderVK::destroy()
+	{
+		if (NULL != m_constantBuffer)
+		{
+			UniformBuffer::destroy(m_constantBuffer);
+			m_constantBuffer = NULL;
+		}
+
+		m_numPredefined = 0;
+
+		if (NULL != m_code)
+		{
+			release(m_code);
+			m_code = NULL;
+			m_hash = 0;
+		}
+
+		if (VK_NULL_HANDLE != m_module)
+		{
+			vkDestroy(m_module);
+		}
+	}
+
+	void ProgramVK::create(const ShaderVK* _vsh, const ShaderVK* _fsh)
+	{
+		BX_ASSERT(NULL != _vsh->m_code, "Vertex shader doesn't exist.");
+		m_vsh = _vsh;
+		bx::memCopy(
+			  &m_predefined[0]
+			, _vsh->m_predefined
+			, _vsh->m_numPredefined * sizeof(PredefinedUniform)
+			);
+		m_numPredefined = _vsh->m_numPredefined;
+
+		if (NULL != _fsh)
+		{
+			BX_ASSERT(NULL != _fsh->m_code, "Fragment shader doesn't exist.");
+			m_fsh = _fsh;
+			bx::memCopy(
+				  &m_predefined[m_numPredefined]
+				, _fsh->m_predefined
+				, _fsh->m_numPredefined * sizeof(PredefinedUniform)
+				);
+			m_numPredefined += _fsh->m_numPredefined;
+		}
+
+		m_numTextures = 0;
+
+		for (uint8_t stage = 0; stage < BX_COUNTOF(m_bindInfo); ++stage)
+		{
+			const ShaderVK* shader = NULL;
+			if (isValid(m_vsh->m_bindInfo[stage].uniformHandle) )
+			{
+				shader = _vsh;
+
+				BX_ASSERT(false
+					  || NULL == m_fsh
+					  || !isValid(m_fsh->m_bindInfo[stage].uniformHandle)
+					  || !(m_vsh->m_oldBindingModel || m_fsh->m_oldBindingModel)
+					, "Shared vertex/fragment bindings require shader binary version >= 11."
+					);
+			}
+			else if (NULL != m_fsh
+				 &&  isValid(m_fsh->m_bindInfo[stage].uniformHandle) )
+			{
+				shader = _fsh;
+			}
+
+			if (NULL != shader)
+			{
+				m_bindInfo[stage] = shader->m_bindInfo[stage];
+				uint32_t& index = m_bindInfo[stage].index;
+				if (UINT32_MAX != index)
+				{
+					m_textures[m_numTextures] = shader->m_textures[index];
+					index = m_numTextures;
+					m_numTextures++;
+				}
+			}
+		}
+
+		// create exact pipeline layout
+		m_descriptorSetLayout = VK_NULL_HANDLE;
+		m_pushDescriptor      = false;
+
+		m_bindless = false
+			|| m_vsh->m_bindless
+			|| (NULL != m_fsh && m_fsh->m_bindless)
+			;
+
+		BX_WARN(!m_bindless || s_renderVK->m_bindlessSupport
+			, "Shader samples bindless textures, but bindless textures are not supported."
+			);
+		m_bindless &= s_renderVK->m_bindlessSupport;
+
+		uint32_t numBindings = m_vsh->m_numBindings + (m_fsh ? m_fsh->m_numBindings : 0);
+
+		// Bindless texture set is set 1, and set 0 must be valid even when program doesn't
+		// have any bindings of its own.
+		if (0 < numBindings
+		||  m_bindless)
+		{
+			// Implementations must support at least 32 push descriptors.
+			m_pushDescriptor = true
+				&& s_renderVK->m_pushDescriptorSupport
+				&& 0  <  numBindings
+				&& 32 >= numBindings
+				;
+
+			// generate descriptor set layout hash
+			bx::HashMurmur2A murmur;
+			murmur.begin();
+			murmur.add(m_pushDescriptor);
+			murmur.add(m_vsh->m_bindings, sizeof(VkDescriptorSetLayoutBinding) * m_vsh->m_numBindings);
+
+			if (NULL != m_fsh)
+			{
+				murmur.add(m_fsh->m_bindings, sizeof(VkDescriptorSetLayoutBinding) * m_fsh->m_numBindings);
+			}
+
+			uint32_t descriptorSetLayoutHash = murmur.end();
+
+			m_descriptorSetLayout = s_renderVK->m_descriptorSetLayoutCache.find(descriptorSetLayoutHash);
+
+			if (VK_NULL_HANDLE == m_descriptorSetLayout)
+			{
+				VkDescriptorSetLayoutBinding bindings[2 * BX_COUNTOF(ShaderVK::m_bindings)];
+
+				bx::memCopy(
+					  bindings
+					, m_vsh->m_bindings
+					, sizeof(VkDescriptorSetLayoutBinding) * m_vsh->m_numBindings
+					);
+
+				numBindings = m_vsh->m_numBindings;
+
+				if (NULL != m_fsh)
+				{
+					for (uint16_t ii = 0; ii < m_fsh->m_numBindings; ii++)
+					{
+						const VkDescriptorSetLayoutBinding& fsBinding = m_fsh->m_bindings[ii];
+						uint16_t vsBindingIdx = UINT16_MAX;
+						for (uint16_t jj = 0; jj < m_vsh->m_numBindings; jj++)
+						{
+							if (fsBinding.binding == bindings[jj].binding)
+							{
+								vsBindingIdx = jj;
+								break;
+							}
+						}
+						if (UINT16_MAX != vsBindingIdx)
+						{
+							BX_ASSERT(
+								bindings[vsBindingIdx].descriptorType == fsBinding.descriptorType
+								, "Mismatching descriptor types. Shaders compiled with different versions of shaderc?"
+								);
+							bindings[vsBindingIdx].stageFlags |= fsBinding.stageFlags;
+						}
+						else
+						{
+							bindings[numBindings] = fsBinding;
+							numBindings++;
+						}
+					}
+				}
+
+				if (m_pushDescriptor)
+				{
+					for (uint32_t ii = 0; ii < numBindings; ++ii)
+					{
+						if (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC == bindings[ii].descriptorType)
+						{
+							bindings[ii].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+						}
+					}
+				}
+
+				VkDescriptorSetLayoutCreateInfo dslci;
+				dslci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+				dslci.pNext = NULL;
+				dslci.flags = m_pushDescriptor ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0;
+				dslci.bindingCount = numBindings;
+				dslci.pBindings = bindings;
+
+				VK_CHECK(vkCreateDescriptorSetLayout(
+					  s_renderVK->m_device
+					, &dslci
+					, s_renderVK->m_allocatorCb
+					, &m_descriptorSetLayout
+					) );
+
+				s_renderVK->m_descriptorSetLayoutCache.add(descriptorSetLayoutHash, m_descriptorSetLayout);
+			}
+		}
+
+		VkPipelineLayoutCreateInfo plci;
+		plci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		plci.pNext = NULL;
+		plci.flags = 0;
+		plci.pushConstantRangeCount = 0;
+		plci.pPushConstantRanges = NULL;
+		const VkDescriptorSetLayout setLayouts[] =
+		{
+			m_descriptorSetLayout,
+			s_renderVK->m_bindlessTexture.m_layout,
+		};
+
+		plci.setLayoutCount = m_bindless ? 2 : (m_descriptorSetLayout == VK_NULL_HANDLE ? 0 : 1);
+		plci.pSetLayouts = setLayouts;
+
+		VK_CHECK(vkCreatePipelineLayout(
+			  s_renderVK->m_device
+			, &plci
+			, s_renderVK->m_allocatorCb
+			, &m_pipelineLayout
+			) );
+	}
+
+	void ProgramVK::destroy()
+	{
+		s_renderVK->release(m_pipelineLayout);
+		m_numPredefined = 0;
+		m_vsh = NULL;
+		m_fsh = NULL;
+	}
+
+	void ReadbackVK::create(VkImage _image, uint32_t _width, uint32_t _height, TextureFormat::Enum _format)
+	{
+		m_image  = _image;
+		m_width  = _width;
+		m_height = _height;
+		m_format = _format;
+	}
+
+	void ReadbackVK::destroy()
+	{
+		m_image = VK_NULL_HANDLE;
+	}
+
+	uint32_t ReadbackVK::pitch(uint8_t _mip) const
+	{
+		uint32_t mipWidth = bx::uint32_max(1, m_width >> _mip);
+		uint8_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_format) );
+		return mipWidth * bpp / 8;
+	}
+
+	void ReadbackVK::copyImageToBuffer(VkCommandBuffer _commandBuffer, VkBuffer _buffer, VkImageLayout _layout, VkImageAspectFlags _aspect, uint8_t _mip) const
+	{
+		uint32_t mipWidth  = bx::uint32_max(1, m_width  >> _mip);
+		uint32_t mipHeight = bx::uint32_max(1, m_height >> _mip);
+
+		setImageMemoryBarrier(
+			  _commandBuffer
+			, m_image
+			, _aspect
+			, _layout
+			, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+			, _mip
+			, 1
+			, 0
+			, 1
+			);
+
+		VkBufferImageCopy bic;
+		bic.bufferOffset = 0;
+		bic.bufferRowLength   = mipWidth;
+		bic.bufferImageHeight = mipHeight;
+		bic.imageSubresource.aspectMask     = _aspect;
+		bic.imageSubresource.mipLevel       = _mip;
+		bic.imageSubresource.baseArrayLayer = 0;
+		bic.imageSubresource.layerCount     = 1;
+		bic.imageOffset = { 0, 0, 0 };
+		bic.imageExtent = { mipWidth, mipHeight, 1 };
+
+		vkCmdCopyImageToBuffer(
+			  _commandBuffer
+			, m_image
+			, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+			, _buffer
+			, 1
+			, &bic
+			);
+
+		// Make changes to the buffer visible to the host
+		setMemoryBarrier(
+			_commandBuffer
+			, VK_PIPELINE_STAGE_TRANSFER_BIT
+			, VK_PIPELINE_STAGE_HOST_BIT
+			);
+
+		setImageMemoryBarrier(
+			  _commandBuffer
+			, m_image
+			, _aspect
+			, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+			, _layout
+			, _mip
+			, 1
+			, 0
+			, 1
+			);
+	}
+
+	void ReadbackVK::readback(const uint8_t* _src, void* _data, uint8_t _mip) const
+	{
+		if (m_image == VK_NULL_HANDLE)
+		{
+			return;
+		}
+
+		uint32_t mipHeight = bx::uint32_max(1, m_height >> _mip);
+		uint32_t rowPitch = pitch(_mip);
+
+		const uint8_t* src = _src;
+		uint8_t* dst = (uint8_t*)_data;
+
+		for (uint32_t yy = 0; yy < mipHeight; ++yy)
+		{
+			bx::memCopy(dst, src, rowPitch);
+			src += rowPitch;
+			dst += rowPitch;
+		}
+	}
+
+	VkResult TextureVK::create(VkCommandBuffer _commandBuffer, uint32_t _width, uint32_t _height, uint64_t _flags, VkFormat _format)
+	{
+		BX_ASSERT(0 != (_flags & BGFX_TEXTURE_RT_MASK), "");
+		_flags |= BGFX_TEXTURE_RT_WRITE_ONLY;
+
+		m_flags     = _flags;
+		m_width     = _width;
+		m_height    = _height;
+		m_depth     = 1;
+		m_numLayers = 1;
+		m_requestedFormat = uint8_t(bimg::TextureFormat::Count);
+		m_textureFormat   = uint8_t(bimg::TextureFormat::Count);
+		m_format = _format;
+		m_components = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+		m_aspectMask = getAspectMask(m_format);
+		m_sampler = s_msaa[bx::uint32_satsub( (m_flags & BGFX_TEXTURE_RT_MSAA_MASK) >> BGFX_TEXTURE_RT_MSAA_SHIFT, 1)];
+		m_type = VK_IMAGE_VIEW_TYPE_2D;
+		m_numMips = 1;
+		m_minLod  = 0;
+		m_numSides = 1;
+
+		VkResult result = createImages(_commandBuffer);
+
+		if (VK_SUCCESS == result)
+		{
+			const VkImageLayout layout = 0 != (m_aspectMask & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) )
+				? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+				: VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+				;
+			setImageMemoryBarrier(_commandBuffer, layout);
+		}
+
+		return result;
+	}
+
+	VkResult TextureVK::createImages(VkCommandBuffer _commandBuffer)
+	{
+		VkResult result = VK_SUCCESS;
+
+		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		const VkDevice device = s_renderVK->m_device;
+
+		if (m_sampler.Count > 1)
+		{
+			BX_ASSERT(VK_IMAGE_VIEW_TYPE_3D != m_type, "Can't create multisample 3D image.");
+			BX_ASSERT(m_numMips <= 1, "Can't create multisample image with mip chain.");
+		}
+
+		// create texture and allocate its device memory
+		VkImageCreateInfo ici;
+		ici.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		ici.pNext = NULL;
+		ici.flags = 0
+			| (VK_IMAGE_VIEW_TYPE_CUBE == m_type
+				? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT
+				: 0
+				)
+			| (VK_IMAGE_VIEW_TYPE_3D == m_type
+				? VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT_KHR
+				: 0
+				)
+			;
+		ici.pQueueFamilyIndices   = NULL;
+		ici.queueFamilyIndexCount = 0;
+		ici.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
+		ici.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+		ici.usage                 = 0
+			| VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+			| VK_IMAGE_USAGE_TRANSFER_DST_BIT
+			| VK_IMAGE_USAGE_SAMPLED_BIT
+			| (m_flags & BGFX_TEXTURE_RT_MASK
+				? (m_aspectMask & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)
+					? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
+					: VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)
+				: 0
+				)
+			| (m_flags & BGFX_TEXTURE_COMPUTE_WRITE ? VK_IMAGE_USAGE_STORAGE_BIT : 0)
+			;
+		ici.format        = m_format;
+		ici.samples       = m_sampler.Sample;
+		ici.mipLevels     = m_numMips;
+		ici.arrayLayers   = m_numSides;
+		ici.extent.width  = m_width;
+		ici.extent.height = m_height;
+		ici.extent.depth  = m_depth;
+		ici.imageType     = VK_IMAGE_VIEW_TYPE_3D == m_type
+			? VK_IMAGE_TYPE_3D
+			: VK_IMAGE_TYPE_2D
+			;
+		ici.tiling        = VK_IMAGE_TILING_OPTIMAL;
+
+		result = vkCreateImage(device, &ici, allocatorCb, &m_textureImage);
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Create texture image error: vkCreateImage failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		VkMemoryRequirements imageMemReq;
+		vkGetImageMemoryRequirements(device, m_textureImage, &imageMemReq);
+
+		result = s_renderVK->m_memoryAllocator.alloc(imageMemReq, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, DeviceMemoryAllocatorVK::Usage::Image, &m_textureDeviceMem);
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Create texture image error: allocateMemory failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		result = vkBindImageMemory(device, m_textureImage, m_textureDeviceMem.m_mem, m_textureDeviceMem.m_offset);
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Create texture image error: vkBindImageMemory failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		const bool needResolve = true
+			&& 1 < m_sampler.Count
+			&& 0 != (ici.usage & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)
+			&& 0 == (m_flags & BGFX_TEXTURE_MSAA_SAMPLE)
+			&& 0 == (m_flags & BGFX_TEXTURE_RT_WRITE_ONLY)
+			;
+
+		if (needResolve)
+		{
+			VkImageCreateInfo ici_resolve = ici;
+			ici_resolve.samples = s_msaa[0].Sample;
+			ici_resolve.usage &= ~VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+			ici_resolve.flags &= ~VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+
+			result = vkCreateImage(device, &ici_resolve, allocatorCb, &m_singleMsaaImage);
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create texture image error: vkCreateImage failed %d: %s.", result, getName(result) );
+				return result;
+			}
+
+			VkMemoryRequirements imageMemReq_resolve;
+			vkGetImageMemoryRequirements(device, m_singleMsaaImage, &imageMemReq_resolve);
+
+			result = s_renderVK->m_memoryAllocator.alloc(imageMemReq_resolve, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, DeviceMemoryAllocatorVK::Usage::Image, &m_singleMsaaDeviceMem);
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create texture image error: allocateMemory failed %d: %s.", result, getName(result) );
+				return result;
+			}
+
+			result = vkBindImageMemory(device, m_singleMsaaImage, m_singleMsaaDeviceMem.m_mem, m_singleMsaaDeviceMem.m_offset);
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create texture image error: vkBindImageMemory failed %d: %s.", result, getName(result) );
+				return result;
+			}
+
+			setImageMemoryBarrier(_commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, true);
+		}
+
+		return result;
+	}
+
+	void* TextureVK::create(VkCommandBuffer _commandBuffer, const Memory* _mem, uint64_t _flags, uint8_t _skip)
+	{
+		bimg::ImageContainer imageContainer;
+
+		if (bimg::imageParse(imageContainer, _mem->data, _mem->size) )
+		{
+			const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(imageContainer.m_format);
+			const uint8_t startLod = bx::min<uint8_t>(_skip, imageContainer.m_numMips - 1);
+
+			bimg::TextureInfo ti;
+			bimg::imageGetSize(
+				  &ti
+				, uint16_t(imageContainer.m_width >> startLod)
+				, uint16_t(imageContainer.m_height >> startLod)
+				, uint16_t(imageContainer.m_depth >> startLod)
+				, imageContainer.m_cubeMap
+				, 1 < imageContainer.m_numMips
+				, imageContainer.m_numLayers
+				, imageContainer.m_format
+				);
+
+			ti.numMips = bx::min<uint8_t>(imageContainer.m_numMips - startLod, ti.numMips);
+
+			m_flags     = _flags;
+			m_width     = ti.width;
+			m_height    = ti.height;
+			m_depth     = ti.depth;
+			m_numLayers = ti.numLayers;
+			m_requestedFormat = uint8_t(imageContainer.m_format);
+			m_textureFormat   = uint8_t(getViableTextureFormat(imageContainer) );
+			m_format = bimg::isDepth(bimg::TextureFormat::Enum(m_textureFormat) )
+				? s_textureFormat[m_textureFormat].m_fmtDsv
+				: (m_flags & BGFX_TEXTURE_SRGB) ? s_textureFormat[m_textureFormat].m_fmtSrgb : s_textureFormat[m_textureFormat].m_fmt
+				;
+			m_components = s_textureFormat[m_textureFormat].m_mapping;
+
+			const bool convert = m_textureFormat != m_requestedFormat;
+			const uint8_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
+
+			m_aspectMask = getAspectMask(m_format);
+			m_sampler = s_msaa[bx::uint32_satsub( (m_flags & BGFX_TEXTURE_RT_MSAA_MASK) >> BGFX_TEXTURE_RT_MSAA_SHIFT, 1)];
+
+			if (imageContainer.m_cubeMap)
+			{
+				m_type = imageContainer.m_numLayers > 1
+					? VK_IMAGE_VIEW_TYPE_CUBE_ARRAY
+					: VK_IMAGE_VIEW_TYPE_CUBE
+					;
+			}
+			else if (imageContainer.m_depth > 1)
+			{
+				m_type = VK_IMAGE_VIEW_TYPE_3D;
+			}
+			else if (imageContainer.m_numLayers > 1)
+			{
+				m_type = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+			}
+			else
+			{
+				m_type = VK_IMAGE_VIEW_TYPE_2D;
+			}
+
+			m_numMips = ti.numMips;
+			m_minLod  = 0;
+			m_numSides = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
+			const uint16_t numSides = ti.numLayers * (imageContainer.m_cubeMap ? 6 : 1);
+			const uint32_t numSrd = numSides * ti.numMips;
+
+			uint32_t kk = 0;
+
+			const bool compressed = bimg::isCompressed(bimg::TextureFormat::Enum(m_textureFormat) );
+			const bool swizzle = TextureFormat::BGRA8 == m_textureFormat && 0 != (m_flags & BGFX_TEXTURE_COMPUTE_WRITE);
+
+			const bool writeOnly    = 0 != (m_flags & BGFX_TEXTURE_RT_WRITE_ONLY);
+			const bool computeWrite = 0 != (m_flags & BGFX_TEXTURE_COMPUTE_WRITE);
+			const bool renderTarget = 0 != (m_flags & BGFX_TEXTURE_RT_MASK);
+			const bool blit         = 0 != (m_flags & BGFX_TEXTURE_BLIT_DST);
+
+			BX_UNUSED(swizzle, writeOnly, computeWrite, renderTarget, blit);
+
+			BX_TRACE(
+				  "Texture %3d: %s (requested: %s), %dx%dx%d%s RT[%c], BO[%c], CW[%c]%s."
+				, (int)(this - s_renderVK->m_textures)
+				, getName( (TextureFormat::Enum)m_textureFormat)
+				, getName( (TextureFormat::Enum)m_requestedFormat)
+				, ti.width
+				, ti.height
+				, ti.depth
+				, imageContainer.m_cubeMap ? "x6" : ""
+				, renderTarget ? 'x' : ' '
+				, writeOnly ? 'x' : ' '
+				, computeWrite ? 'x' : ' '
+				, swizzle ? " (swizzle BGRA8 -> RGBA8)" : ""
+				);
+
+			VK_CHECK(createImages(_commandBuffer) );
+
+			// Textures in formats renderer can't sample from are decoded by API thread before
+			// they get here, image data is copied straight into staging memory.
+			struct ImageInfo
+			{
+				bimg::ImageMip mip;
+				uint32_t pitch;
+				uint32_t size;
+			};
+
+			ImageInfo* imageInfos = (ImageInfo*)BX_ALLOC(g_allocator, sizeof(ImageInfo) * numSrd);
+			VkBufferImageCopy* bufferCopyInfo = (VkBufferImageCopy*)BX_ALLOC(g_allocator, sizeof(VkBufferImageCopy) * numSrd);
+
+			const uint32_t stagingAlign = getStagingAlignment(bimg::TextureFormat::Enum(m_textureFormat) );
+			uint32_t totalMemSize = 0;
+
+			for (uint16_t side = 0; side < numSides; ++side)
+			{
+				for (uint8_t lod = 0; lod < ti.numMips; ++lod)
+				{
+					ImageInfo& imageInfo = imageInfos[kk];
+
+					if (!bimg::imageGetRawData(imageContainer, side, lod + startLod, _mem->data, _mem->size, imageInfo.mip) )
+					{
+						continue;
+					}
+
+					const bimg::ImageMip& mip = imageInfo.mip;
+
+					if (convert)
+					{
+						imageInfo.pitch = bx::max<uint32_t>(mip.m_width, 4) * bpp / 8;
+						imageInfo.size  = bx::max<uint32_t>(mip.m_height, 4) * imageInfo.pitch;
+					}
+					else if (compressed)
+					{
+						imageInfo.pitch = (mip.m_width / blockInfo.blockWidth) * mip.m_blockSize;
+						imageInfo.size  = (mip.m_height / blockInfo.blockHeight) * imageInfo.pitch * mip.m_depth;
+					}
+					else
+					{
+						imageInfo.pitch = mip.m_width * mip.m_bpp / 8;
+						imageInfo.size  = mip.m_height * imageInfo.pitch * mip.m_depth;
+					}
+
+					const uint32_t idealWidth  = bx::max<uint32_t>(1, m_width  >> lod);
+					const uint32_t idealHeight = bx::max<uint32_t>(1, m_height >> lod);
+
+					totalMemSize = bx::strideAlign(totalMemSize, stagingAlign);
+
+					VkBufferImageCopy& copy = bufferCopyInfo[kk];
+					copy.bufferOffset      = totalMemSize;
+					copy.bufferRowLength   = 0; // assume that image data are tightly aligned
+					copy.bufferImageHeight = 0; // assume that image data are tightly aligned
+					copy.imageSubresource.aspectMask     = m_aspectMask;
+					copy.imageSubresource.mipLevel       = lod;
+					copy.imageSubresource.baseArrayLayer = side;
+					copy.imageSubresource.layerCount     = 1;
+					copy.imageOffset = { 0, 0, 0 };
+					copy.imageExtent = { idealWidth, idealHeight, mip.m_depth };
+
+					totalMemSize += imageInfo.size;
+					++kk;
+				}
+			}
+
+			const uint32_t numCopies = kk;
+
+			if (totalMemSize > 0)
+			{
+				StagingBufferVK staging = s_renderVK->allocStagingBuffer(totalMemSize, stagingAlign);
+
+				for (uint32_t ii = 0; ii < numCopies; ++ii)
+				{
+					const ImageInfo& imageInfo = imageInfos[ii];
+					uint8_t* dst = staging.m_data + bufferCopyInfo[ii].bufferOffset;
+
+					if (convert)
+					{
+						bimg::imageDecodeToBgra8(
+							  g_allocator
+							, dst
+							, imageInfo.mip.m_data
+							, imageInfo.mip.m_width
+							, imageInfo.mip.m_height
+							, imageInfo.pitch
+							, imageInfo.mip.m_format
+							);
+					}
+					else
+					{
+						bx::memCopy(dst, imageInfo.mip.m_data, imageInfo.size);
+					}
+
+					bufferCopyInfo[ii].bufferOffset += staging.m_offset;
+				}
+
+				copyBufferToTexture(_commandBuffer, staging.m_buffer, numCopies, bufferCopyInfo);
+
+				s_renderVK->releaseStagingBuffer(staging);
+			}
+			else
+			{
+				setImageMemoryBarrier(
+					  _commandBuffer
+					, (m_flags & BGFX_TEXTURE_COMPUTE_WRITE
+						? VK_IMAGE_LAYOUT_GENERAL
+						: VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+					) );
+			}
+
+			BX_FREE(g_allocator, bufferCopyInfo);
+			BX_FREE(g_allocator, imageInfos);
+
+			m_readback.create(m_textureImage, m_width, m_height, TextureFormat::Enum(m_textureFormat) );
+		}
+
+		return m_directAccessPtr;
+	}
+
+	void TextureVK::destroy()
+	{
+		m_readback.destroy();
+
+		if (VK_NULL_HANDLE != m_textureImage)
+		{
+			s_renderVK->release(m_textureImage);
+			s_renderVK->release(m_textureDeviceMem);
+		}
+
+		if (VK_NULL_HANDLE != m_singleMsaaImage)
+		{
+			s_renderVK->release(m_singleMsaaImage);
+			s_renderVK->release(m_singleMsaaDeviceMem);
+		}
+
+		m_currentImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		m_currentSingleMsaaImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	}
+
+	void TextureVK::update(VkCommandBuffer _commandBuffer, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem)
+	{
+		const uint32_t bpp = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(m_textureFormat) );
+		uint32_t rectpitch = _rect.m_width * bpp / 8;
+		uint32_t slicepitch = rectpitch * _rect.m_height;
+		if (bimg::isCompressed(bimg::TextureFormat::Enum(m_textureFormat) ) )
+		{
+			const bimg::ImageBlockInfo& blockInfo = bimg::getBlockInfo(bimg::TextureFormat::Enum(m_textureFormat) );
+			rectpitch = ( (_rect.m_width + blockInfo.blockWidth - 1) / blockInfo.blockWidth) * blockInfo.blockSize;
+			slicepitch = ( (_rect.m_height + blockInfo.blockHeight - 1) / blockInfo.blockHeight) * rectpitch;
+		}
+		const uint32_t srcpitch = UINT16_MAX == _pitch ? rectpitch : _pitch;
+		const uint32_t size     = UINT16_MAX == _pitch ? slicepitch  * _depth: _rect.m_height * _pitch * _depth;
+		const bool convert = m_textureFormat != m_requestedFormat;
+
+		uint8_t* data = _mem->data;
+		uint8_t* temp = NULL;
+
+		if (convert)
+		{
+			temp = (uint8_t*)BX_ALLOC(g_allocator, slicepitch);
+			bimg::imageDecodeToBgra8(g_allocator, temp, data, _rect.m_width, _rect.m_height, srcpitch, bimg::TextureFormat::Enum(m_requestedFormat) );
+			data = temp;
+		}
+
+		StagingBufferVK staging = s_renderVK->allocStagingBuffer(
+			  size
+			, getStagingAlignment(bimg::TextureFormat::Enum(m_textureFormat) )
+			, data
+			);
+
+		VkBufferImageCopy region;
+		region.bufferOffset      = staging.m_offset;
+		region.bufferRowLength   = (_pitch == UINT16_MAX ? 0 : _pitch * 8 / bpp);
+		region.bufferImageHeight = 0;
+		region.imageSubresource.aspectMask     = m_aspectMask;
+		region.imageSubresource.mipLevel       = _mip;
+		region.imageSubresource.baseArrayLayer = _side;
+		region.imageSubresource.layerCount     = 1;
+		region.imageOffset = { _rect.m_x, _rect.m_y, _z };
+		region.imageExtent = { _rect.m_width, _rect.m_height, _depth };
+
+		copyBufferToTexture(_commandBuffer, staging.m_buffer, 1, &region);
+
+		s_renderVK->releaseStagingBuffer(staging);
+
+		if (NULL != temp)
+		{
+			BX_FREE(g_allocator, temp);
+		}
+	}
+
+	void TextureVK::resolve(VkCommandBuffer _commandBuffer, uint8_t _resolve, uint32_t _layer, uint32_t _numLayers, uint32_t _mip)
+	{
+		const bool needResolve = VK_NULL_HANDLE != m_singleMsaaImage;
+
+		const bool needMipGen = true
+			&& 0 != (m_flags & BGFX_TEXTURE_RT_MASK)
+			&& 0 == (m_flags & BGFX_TEXTURE_RT_WRITE_ONLY)
+			&& (_mip + 1) < m_numMips
+			&& 0 != (_resolve & BGFX_RESOLVE_AUTO_GEN_MIPS);
+
+		const VkImageLayout oldLayout = m_currentImageLayout;
+		const VkImageLayout oldSingleMsaaLayout = m_currentSingleMsaaImageLayout;
+
+		if (needResolve)
+		{
+			setImageMemoryBarrier(_commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+			setImageMemoryBarrier(_commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, true);
+
+			VkImageResolve resolve;
+			resolve.srcOffset.x = 0;
+			resolve.srcOffset.y = 0;
+			resolve.srcOffset.z = 0;
+			resolve.dstOffset.x = 0;
+			resolve.dstOffset.y = 0;
+			resolve.dstOffset.z = 0;
+			resolve.srcSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+			resolve.srcSubresource.mipLevel       = _mip;
+			resolve.srcSubresource.baseArrayLayer = _layer;
+			resolve.srcSubresource.layerCount     = _numLayers;
+			resolve.dstSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+			resolve.dstSubresource.mipLevel       = _mip;
+			resolve.dstSubresource.baseArrayLayer = _layer;
+			resolve.dstSubresource.layerCount     = _numLayers;
+			resolve.extent.width  = m_width;
+			resolve.extent.height = m_height;
+			resolve.extent.depth  = 1;
+
+			vkCmdResolveImage(
+				  _commandBuffer
+				, m_textureImage
+				, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+				, m_singleMsaaImage
+				, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+				, 1
+				, &resolve
+				);
+		}
+
+		if (needResolve && needMipGen)
+		{
+			setMemoryBarrier(
+				  _commandBuffer
+				, VK_PIPELINE_STAGE_TRANSFER_BIT
+				, VK_PIPELINE_STAGE_TRANSFER_BIT
+				);
+		}
+
+		if (needMipGen)
+		{
+			setImageMemoryBarrier(_commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, needResolve);
+
+			int32_t mipWidth  = bx::max<int32_t>(int32_t(m_width)  >> _mip, 1);
+			int32_t mipHeight = bx::max<int32_t>(int32_t(m_height) >> _mip, 1);
+
+			const VkImage image = needResolve ? m_singleMsaaImage : m_textureImage;
+
+			const VkFilter filter = bimg::isDepth(bimg::TextureFormat::Enum(m_textureFormat) )
+				? VK_FILTER_NEAREST
+				: VK_FILTER_LINEAR
+				;
+
+			VkImageBlit blit;
+			blit.srcOffsets[0] = { 0, 0, 0 };
+			blit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
+			blit.srcSubresource.aspectMask = m_aspectMask;
+			blit.srcSubresource.mipLevel = 0;
+			blit.srcSubresource.baseArrayLayer = _layer;
+			blit.srcSubresource.layerCount = _numLayers;
+			blit.dstOffsets[0] = { 0, 0, 0 };
+			blit.dstOffsets[1] = { mipWidth, mipHeight, 1 };
+			blit.dstSubresource.aspectMask = m_aspectMask;
+			blit.dstSubresource.mipLevel = 0;
+			blit.dstSubresource.baseArrayLayer = _layer;
+			blit.dstSubresource.layerCount = _numLayers;
+
+			for (uint32_t i = _mip + 1; i < m_numMips; i++)
+			{
+				blit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
+				blit.srcSubresource.mipLevel = i - 1;
+
+				mipWidth  = bx::uint32_max(mipWidth  >> 1, 1);
+				mipHeight = bx::uint32_max(mipHeight >> 1, 1);
+
+				blit.dstOffsets[1] = { mipWidth, mipHeight, 1 };
+				blit.dstSubresource.mipLevel = i;
+
+				vk::setImageMemoryBarrier(
+					  _commandBuffer
+					, image
+					, m_aspectMask
+					, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+					, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+					, blit.srcSubresource.mipLevel
+					, 1
+					, _layer
+					, _numLayers
+					);
+
+				vkCmdBlitImage(
+					  _commandBuffer
+					, image
+					, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+					, image
+					, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+					, 1
+					, &blit
+					, filter
+					);
+			}
+
+			vk::setImageMemoryBarrier(
+				  _commandBuffer
+				, image
+				, m_aspectMask
+				, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+				, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+				, _mip
+				, m_numMips - _mip - 1
+				, _layer
+				, _numLayers
+				);
+		}
+
+		setImageMemoryBarrier(_commandBuffer, oldLayout);
+		setImageMemoryBarrier(_commandBuffer, oldSingleMsaaLayout, true);
+	}
+
+	void TextureVK::copyBufferToTexture(VkCommandBuffer _commandBuffer, VkBuffer _stagingBuffer, uint32_t _bufferImageCopyCount, VkBufferImageCopy* _bufferImageCopy)
+	{
+		const VkImageLayout oldLayout = m_currentImageLayout == VK_IMAGE_LAYOUT_UNDEFINED
+			? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+			: m_currentImageLayout
+			;
+
+		setImageMemoryBarrier(_commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+		vkCmdCopyBufferToImage(
+			  _commandBuffer
+			, _stagingBuffer
+			, m_textureImage
+			, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+			, _bufferImageCopyCount
+			, _bufferImageCopy
+			);
+
+		setImageMemoryBarrier(_commandBuffer, oldLayout);
+	}
+
+	VkImageLayout TextureVK::setImageMemoryBarrier(VkCommandBuffer _commandBuffer, VkImageLayout _newImageLayout, bool _singleMsaaImage)
+	{
+		if (_singleMsaaImage && VK_NULL_HANDLE == m_singleMsaaImage)
+		{
+			return VK_IMAGE_LAYOUT_UNDEFINED;
+		}
+
+		VkImageLayout& currentLayout = _singleMsaaImage
+			? m_currentSingleMsaaImageLayout
+			: m_currentImageLayout
+			;
+
+		const VkImageLayout oldLayout = currentLayout;
+
+		if (currentLayout == _newImageLayout)
+		{
+			return oldLayout;
+		}
+
+		const VkImage image = _singleMsaaImage
+			? m_singleMsaaImage
+			: m_textureImage
+			;
+
+		vk::setImageMemoryBarrier(
+			  _commandBuffer
+			, image
+			, m_aspectMask
+			, currentLayout
+			, _newImageLayout
+			);
+
+		currentLayout = _newImageLayout;
+		return oldLayout;
+	}
+
+	VkResult TextureVK::createView(uint32_t _layer, uint32_t _numLayers, uint32_t _mip, uint32_t _numMips, VkImageViewType _type, bool _renderTarget, ::VkImageView* _view) const
+	{
+		VkResult result = VK_SUCCESS;
+
+		if (VK_IMAGE_VIEW_TYPE_3D == m_type)
+		{
+			BX_ASSERT(false
+				  || !_renderTarget
+				  || !(m_aspectMask & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) )
+				, "3D image can't be a depth attachment"
+			);
+		}
+
+		if (VK_IMAGE_VIEW_TYPE_CUBE       == _type
+		||  VK_IMAGE_VIEW_TYPE_CUBE_ARRAY == _type)
+		{
+			BX_ASSERT(_numLayers % 6 == 0, "");
+			BX_ASSERT(
+				  VK_IMAGE_VIEW_TYPE_3D != m_type
+				, "3D image can't be aliased as a cube texture"
+				);
+		}
+
+		VkImageView view = VK_NULL_HANDLE;
+
+		const VkImageAspectFlags aspectMask = 0
+			| VK_IMAGE_ASPECT_COLOR_BIT
+			| VK_IMAGE_ASPECT_DEPTH_BIT
+			| (_renderTarget ? VK_IMAGE_ASPECT_STENCIL_BIT : 0)
+			;
+
+		VkImageViewCreateInfo viewInfo;
+		viewInfo.sType      = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.pNext      = NULL;
+		viewInfo.flags      = 0;
+		viewInfo.image      = ((VK_NULL_HANDLE != m_singleMsaaImage) && !_renderTarget)
+			? m_singleMsaaImage
+			: m_textureImage
+			;
+		viewInfo.viewType   = _type;
+		viewInfo.format     = m_format;
+		viewInfo.components = m_components;
+		viewInfo.subresourceRange.aspectMask     = m_aspectMask & aspectMask;
+		viewInfo.subresourceRange.baseMipLevel   = _mip;
+		viewInfo.subresourceRange.levelCount     = _numMips;
+		viewInfo.subresourceRange.baseArrayLayer = _layer;
+		viewInfo.subresourceRange.layerCount     = 1;
+
+		if (VK_IMAGE_VIEW_TYPE_2D != _type
+		&&  VK_IMAGE_VIEW_TYPE_3D != _type)
+		{
+			viewInfo.subresourceRange.layerCount = VK_IMAGE_VIEW_TYPE_CUBE == _type
+				? 6
+				: _numLayers
+				;
+		}
+
+		result = vkCreateImageView(
+			  s_renderVK->m_device
+			, &viewInfo
+			, s_renderVK->m_allocatorCb
+			, &view
+			);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Create texture view error: vkCreateImageView failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		*_view = view;
+
+		return result;
+	}
+
+	VkImageAspectFlags TextureVK::getAspectMask(VkFormat _format)
+	{
+		switch (_format)
+		{
+		case VK_FORMAT_S8_UINT:
+			return VK_IMAGE_ASPECT_STENCIL_BIT;
+			break;
+		case VK_FORMAT_D16_UNORM:
+		case VK_FORMAT_X8_D24_UNORM_PACK32:
+		case VK_FORMAT_D32_SFLOAT:
+			return VK_IMAGE_ASPECT_DEPTH_BIT;
+		case VK_FORMAT_D16_UNORM_S8_UINT:
+		case VK_FORMAT_D24_UNORM_S8_UINT:
+		case VK_FORMAT_D32_SFLOAT_S8_UINT:
+			return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+		default:
+			return VK_IMAGE_ASPECT_COLOR_BIT;
+		}
+	}
+
+	VkResult SwapChainVK::create(VkCommandBuffer _commandBuffer, void* _nwh, const Resolution& _resolution, TextureFormat::Enum _depthFormat)
+	{
+		struct ErrorState
+		{
+			enum Enum
+			{
+				Default,
+				SurfaceCreated,
+				SwapChainCreated,
+				AttachmentsCreated
+			};
+		};
+
+		ErrorState::Enum errorState = ErrorState::Default;
+
+		VkResult result = VK_SUCCESS;
+
+		if (NULL == _nwh)
+		{
+			return result;
+		}
+
+		m_nwh = _nwh;
+		m_resolution = _resolution;
+		m_depthFormat = TextureFormat::Count == _depthFormat ? TextureFormat::D24S8 : _depthFormat;
+
+		m_queue = s_renderVK->m_queueGraphics;
+
+		result = createSurface();
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Create swap chain error: creating surface failed %d: %s.", result, getName(result) );
+			goto error;
+		}
+
+		errorState = ErrorState::SurfaceCreated;
+
+		{
+			m_sci.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+			m_sci.pNext = NULL;
+			m_sci.flags = 0;
+			m_sci.imageArrayLayers      = 1;
+			m_sci.imageSharingMode      = VK_SHARING_MODE_EXCLUSIVE;
+			m_sci.queueFamilyIndexCount = 0;
+			m_sci.pQueueFamilyIndices   = NULL;
+			m_sci.preTransform          = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+			m_sci.oldSwapchain          = VK_NULL_HANDLE;
+
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_backBufferColorImageView); ++ii)
+			{
+				m_backBufferColorImage[ii]     = VK_NULL_HANDLE;
+				m_backBufferColorImageView[ii] = VK_NULL_HANDLE;
+				m_backBufferFrameBuffer[ii]    = VK_NULL_HANDLE;
+				m_backBufferFence[ii]          = VK_NULL_HANDLE;
+				m_presentDoneSemaphore[ii]     = VK_NULL_HANDLE;
+				m_renderDoneSemaphore[ii]      = VK_NULL_HANDLE;
+			}
+
+			m_lastImageRenderedSemaphore = VK_NULL_HANDLE;
+			m_lastImageAcquiredSemaphore = VK_NULL_HANDLE;
+
+			result = createSwapChain();
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create swap chain error: creating swapchain and image views failed %d: %s", result, getName(result) );
+				goto error;
+			}
+		}
+
+		errorState = ErrorState::SwapChainCreated;
+
+		{
+			result = createAttachments(_commandBuffer);
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create swap chain error: creating MSAA/depth attachments failed %d: %s.", result, getName(result) );
+				goto error;
+			}
+		}
+
+		errorState = ErrorState::AttachmentsCreated;
+
+		{
+			result = createFrameBuffer();
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create swap chain error: creating frame buffers failed %d: %s.", result, getName(result) );
+				goto error;
+			}
+		}
+
+		return VK_SUCCESS;
+
+	error:
+		BX_TRACE("errorState %d", errorState);
+		switch (errorState)
+		{
+		case ErrorState::AttachmentsCreated:
+			releaseAttachments();
+			BX_FALLTHROUGH;
+
+		case ErrorState::SwapChainCreated:
+			releaseSwapChain();
+			BX_FALLTHROUGH;
+
+		case ErrorState::SurfaceCreated:
+			releaseSurface();
+			BX_FALLTHROUGH;
+
+		case ErrorState::Default:
+			break;
+		};
+
+		return VK_SUCCESS != result
+			? result
+			: VK_ERROR_INITIALIZATION_FAILED
+			;
+	}
+
+	void SwapChainVK::destroy()
+	{
+		if (VK_NULL_HANDLE != m_swapchain)
+		{
+			releaseFrameBuffer();
+			releaseAttachments();
+			releaseSwapChain();
+			releaseSurface();
+
+			// can't delay-delete the surface, since there can only be one swapchain per surface
+			// new framebuffer with the same window would get an error at swapchain creation
+			s_renderVK->kick(true);
+		}
+
+		m_nwh = NULL;
+	}
+
+	void SwapChainVK::update(VkCommandBuffer _commandBuffer, void* _nwh, const Resolution& _resolution)
+	{
+		const VkPhysicalDevice physicalDevice = s_renderVK->m_physicalDevice;
+
+		m_lastImageRenderedSemaphore = VK_NULL_HANDLE;
+		m_lastImageAcquiredSemaphore = VK_NULL_HANDLE;
+
+		const uint64_t recreateSurfaceMask     = BGFX_RESET_HIDPI;
+		const uint64_t recreateSwapchainMask   = BGFX_RESET_VSYNC | BGFX_RESET_SRGB_BACKBUFFER;
+		const uint64_t recreateAttachmentsMask = BGFX_RESET_MSAA_MASK;
+
+		const bool recreateSurface = false
+			|| m_needToRecreateSurface
+			|| m_nwh != _nwh
+			|| (m_resolution.reset & recreateSurfaceMask) != (_resolution.reset & recreateSurfaceMask)
+			;
+
+		const bool recreateSwapchain = false
+			|| m_resolution.format != _resolution.format
+			|| m_resolution.width  != _resolution.width
+			|| m_resolution.height != _resolution.height
+			|| (m_resolution.reset & recreateSwapchainMask) != (_resolution.reset & recreateSwapchainMask)
+			|| recreateSurface
+			;
+
+		const bool recreateAttachments = false
+			|| (m_resolution.reset & recreateAttachmentsMask) != (_resolution.reset & recreateAttachmentsMask)
+			|| recreateSwapchain
+			;
+
+		m_nwh = _nwh;
+		m_resolution = _resolution;
+
+		if (recreateAttachments)
+		{
+			releaseFrameBuffer();
+			releaseAttachments();
+
+			if (recreateSwapchain)
+			{
+				releaseSwapChain();
+
+				if (recreateSurface)
+				{
+					m_sci.oldSwapchain = VK_NULL_HANDLE;
+					releaseSurface();
+					s_renderVK->kick(true);
+
+					VkResult result = createSurface();
+					if (VK_SUCCESS != result)
+					{
+						BX_TRACE("Surface lost.");
+						return;
+					}
+				}
+
+				VkSurfaceCapabilitiesKHR surfaceCapabilities;
+				VK_CHECK(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, m_surface, &surfaceCapabilities) );
+
+				const uint32_t width = bx::clamp<uint32_t>(
+					  m_resolution.width
+					, surfaceCapabilities.minImageExtent.width
+					, surfaceCapabilities.maxImageExtent.width
+					);
+				const uint32_t height = bx::clamp<uint32_t>(
+					  m_resolution.height
+					, surfaceCapabilities.minImageExtent.height
+					, surfaceCapabilities.maxImageExtent.height
+					);
+
+				// swapchain can't have size 0
+				// on some platforms this happens when minimized
+				if (width  == 0
+				||  height == 0)
+				{
+					m_sci.oldSwapchain = VK_NULL_HANDLE;
+					s_renderVK->kick(true);
+					return;
+				}
+
+				VK_CHECK(createSwapChain() );
+			}
+
+			VK_CHECK(createAttachments(_commandBuffer) );
+			VK_CHECK(createFrameBuffer() );
+		}
+	}
+
+	VkResult SwapChainVK::createSurface()
+	{
+		VkResult result = VK_ERROR_INITIALIZATION_FAILED;
+
+		const VkInstance instance = s_renderVK->m_instance;
+		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+
+#if BX_PLATFORM_WINDOWS
+		{
+			if (NULL != vkCreateWin32SurfaceKHR)
+			{
+				VkWin32SurfaceCreateInfoKHR sci;
+				sci.sType = VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR;
+				sci.pNext = NULL;
+				sci.flags     = 0;
+				sci.hinstance = (HINSTANCE)GetModuleHandle(NULL);
+				sci.hwnd      = (HWND)m_nwh;
+				result = vkCreateWin32SurfaceKHR(instance, &sci, allocatorCb, &m_surface);
+			}
+		}
+#elif BX_PLATFORM_ANDROID
+		{
+			if (NULL != vkCreateAndroidSurfaceKHR)
+			{
+				VkAndroidSurfaceCreateInfoKHR sci;
+				sci.sType = VK_STRUCTURE_TYPE_ANDROID_SURFACE_CREATE_INFO_KHR;
+				sci.pNext = NULL;
+				sci.flags = 0;
+				sci.window = (ANativeWindow*)m_nwh;
+				result = vkCreateAndroidSurfaceKHR(instance, &sci, allocatorCb, &m_surface);
+			}
+		}
+#elif BX_PLATFORM_LINUX
+		{
+			if (NULL != vkCreateXlibSurfaceKHR)
+			{
+				VkXlibSurfaceCreateInfoKHR sci;
+				sci.sType = VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR;
+				sci.pNext = NULL;
+				sci.flags  = 0;
+				sci.dpy    = (Display*)g_platformData.ndt;
+				sci.window = (Window)m_nwh;
+				result = vkCreateXlibSurfaceKHR(instance, &sci, allocatorCb, &m_surface);
+			}
+
+			if (VK_SUCCESS != result)
+			{
+				void* xcbdll = bx::dlopen("libX11-xcb.so.1");
+
+				if (NULL != xcbdll
+				&&  NULL != vkCreateXcbSurfaceKHR)
+				{
+					typedef xcb_connection_t* (*PFN_XGETXCBCONNECTION)(Display*);
+					PFN_XGETXCBCONNECTION XGetXCBConnection = (PFN_XGETXCBCONNECTION)bx::dlsym(xcbdll, "XGetXCBConnection");
+
+					union { void* ptr; xcb_window_t window; } cast = { m_nwh };
+
+					VkXcbSurfaceCreateInfoKHR sci;
+					sci.sType      = VK_STRUCTURE_TYPE_XCB_SURFACE_CREATE_INFO_KHR;
+					sci.pNext      = NULL;
+					sci.flags      = 0;
+					sci.connection = XGetXCBConnection( (Display*)g_platformData.ndt);
+					sci.window     = cast.window;
+					result = vkCreateXcbSurfaceKHR(instance, &sci, allocatorCb, &m_surface);
+
+					bx::dlclose(xcbdll);
+				}
+			}
+		}
+#elif BX_PLATFORM_OSX
+		{
+			if (NULL != vkCreateMacOSSurfaceMVK)
+			{
+				NSWindow* window    = (NSWindow*)(m_nwh);
+				NSView* contentView = (NSView*)window.contentView;
+				CAMetalLayer* layer = [CAMetalLayer layer];
+
+				if (m_resolution.reset & BGFX_RESET_HIDPI)
+				{
+					layer.contentsScale = [window backingScaleFactor];
+				}
+
+				[contentView setWantsLayer : YES];
+				[contentView setLayer : layer];
+
+				VkMacOSSurfaceCreateInfoMVK sci;
+				sci.sType = VK_STRUCTURE_TYPE_MACOS_SURFACE_CREATE_INFO_MVK;
+				sci.pNext = NULL;
+				sci.flags = 0;
+				sci.pView = (__bridge void*)layer;
+				result = vkCreateMacOSSurfaceMVK(instance, &sci, allocatorCb, &m_surface);
+			}
+		}
+#else
+#	error "Figure out KHR surface..."
+#endif // BX_PLATFORM_
+
+		m_needToRecreateSurface = false;
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Create surface error: vkCreate[Platform]SurfaceKHR failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		const VkPhysicalDevice physicalDevice = s_renderVK->m_physicalDevice;
+		const uint32_t queueFamily = s_renderVK->m_qfiGraphics;
+
+		VkBool32 surfaceSupported;
+		result = vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, queueFamily, m_surface, &surfaceSupported);
+
+		if (VK_SUCCESS != result
+		||  !surfaceSupported)
+		{
+			BX_TRACE("Create surface error: Presentation to the given surface not supported.");
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+
+		return result;
+	}
+
+	void SwapChainVK::releaseSurface()
+	{
+		release(m_surface);
+	}
+
+	VkResult SwapChainVK::createSwapChain()
+	{
+		VkResult result = VK_SUCCESS;
+
+		const VkPhysicalDevice physicalDevice = s_renderVK->m_physicalDevice;
+		const VkDevice device = s_renderVK->m_device;
+		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+
+		VkSurfaceCapabilitiesKHR surfaceCapabilities;
+		result = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, m_surface, &surfaceCapabilities);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Create swapchain error: vkGetPhysicalDeviceSurfaceCapabilitiesKHR failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		const uint32_t minSwapBufferCount = bx::max<uint32_t>(surfaceCapabilities.minImageCount, 2);
+		const uint32_t maxSwapBufferCount = surfaceCapabilities.maxImageCount == 0
+			? BGFX_CONFIG_MAX_BACK_BUFFERS
+			: bx::min<uint32_t>(surfaceCapabilities.maxImageCount, BGFX_CONFIG_MAX_BACK_BUFFERS)
+			;
+
+		if (minSwapBufferCount > maxSwapBufferCount)
+		{
+			BX_TRACE("Create swapchain error: Incompatible swapchain image count (min: %d, max: %d, BGFX_CONFIG_MAX_BACK_BUFFERS: %d)."
+				, minSwapBufferCount
+				, maxSwapBufferCount
+				, BGFX_CONFIG_MAX_BACK_BUFFERS
+				);
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+
+		const uint32_t swapBufferCount = bx::clamp<uint32_t>(m_resolution.numBackBuffers, minSwapBufferCount, maxSwapBufferCount);
+
+		const VkColorSpaceKHR surfaceColorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+
+		const bool srgb = !!(m_resolution.reset & BGFX_RESET_SRGB_BACKBUFFER);
+		m_colorFormat = findSurfaceFormat(m_resolution.format, surfaceColorSpace, srgb);
+
+		if (TextureFormat::Count == m_colorFormat)
+		{
+			BX_TRACE("Create swapchain error: Unable to find surface format (srgb: %d).", srgb);
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+
+		const VkFormat surfaceFormat = srgb
+			? s_textureFormat[m_colorFormat].m_fmtSrgb
+			: s_textureFormat[m_colorFormat].m_fmt
+			;
+
+		const uint32_t width = bx::clamp<uint32_t>(
+			  m_resolution.width
+			, surfaceCapabilities.minImageExtent.width
+			, surfaceCapabilities.maxImageExtent.width
+			);
+		const uint32_t height = bx::clamp<uint32_t>(
+			  m_resolution.height
+			, surfaceCapabilities.minImageExtent.height
+			, surfaceCapabilities.maxImageExtent.height
+			);
+
+		VkCompositeAlphaFlagBitsKHR compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+
+		if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR)
+		{
+			compositeAlpha = VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR;
+		}
+		else if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR)
+		{
+			compositeAlpha = VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR;
+		}
+		else if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR)
+		{
+			compositeAlpha = VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR;
+		}
+
+		const VkImageUsageFlags imageUsageMask = 0
+			| VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+			| VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+			| VK_IMAGE_USAGE_TRANSFER_DST_BIT
+			;
+		const VkImageUsageFlags imageUsage = surfaceCapabilities.supportedUsageFlags & imageUsageMask;
+
+		m_supportsReadback      = 0 != (imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+		m_supportsManualResolve = 0 != (imageUsage & VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+
+		const bool vsync = !!(m_resolution.reset & BGFX_RESET_VSYNC);
+		uint32_t presentModeIdx = findPresentMode(vsync);
+		if (UINT32_MAX == presentModeIdx)
+		{
+			BX_TRACE("Create swapchain error: Unable to find present mode (vsync: %d).", vsync);
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+
+		m_sci.surface            = m_surface;
+		m_sci.minImageCount      = swapBufferCount;
+		m_sci.imageFormat        = surfaceFormat;
+		m_sci.imageColorSpace    = surfaceColorSpace;
+		m_sci.imageExtent.width  = width;
+		m_sci.imageExtent.height = height;
+		m_sci.imageUsage         = imageUsage;
+		m_sci.compositeAlpha     = compositeAlpha;
+		m_sci.presentMode        = s_presentMode[presentModeIdx].mode;
+		m_sci.clipped            = VK_FALSE;
+
+		result = vkCreateSwapchainKHR(device, &m_sci, allocatorCb, &m_swapchain);
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Create swapchain error: vkCreateSwapchainKHR failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		m_sci.oldSwapchain = m_swapchain;
+
+		result = vkGetSwapchainImagesKHR(device, m_swapchain, &m_numSwapchainImages, NULL);
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		if (m_numSwapchainImages < m_sci.minImageCount)
+		{
+			BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR: numSwapchainImages %d < minImageCount %d."
+				, m_numSwapchainImages
+				, m_sci.minImageCount
+				);
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+
+		if (m_numSwapchainImages > BX_COUNTOF(m_backBufferColorImage) )
+		{
+			BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR: numSwapchainImages %d > countof(m_backBufferColorImage) %d."
+				, m_numSwapchainImages
+				, BX_COUNTOF(m_backBufferColorImage)
+				);
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+
+		result = vkGetSwapchainImagesKHR(device, m_swapchain, &m_numSwapchainImages, &m_backBufferColorImage[0]);
+		if (VK_SUCCESS != result && VK_INCOMPLETE != result)
+		{
+			BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR failed %d: %s."
+				, result
+				, getName(result)
+				);
+			return result;
+		}
+
+		VkImageViewCreateInfo ivci;
+		ivci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		ivci.pNext = NULL;
+		ivci.flags = 0;
+		ivci.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		ivci.format   = m_sci.imageFormat;
+		ivci.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+		ivci.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+		ivci.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+		ivci.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+		ivci.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+		ivci.subresourceRange.baseMipLevel   = 0;
+		ivci.subresourceRange.levelCount     = 1;
+		ivci.subresourceRange.baseArrayLayer = 0;
+		ivci.subresourceRange.layerCount     = 1;
+
+		for (uint32_t ii = 0; ii < m_numSwapchainImages; ++ii)
+		{
+			ivci.image = m_backBufferColorImage[ii];
+
+			result = vkCreateImageView(device, &ivci, allocatorCb, &m_backBufferColorImageView[ii]);
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create swapchain error: vkCreateImageView failed %d: %s.", result, getName(result) );
+				return result;
+			}
+
+			m_backBufferColorImageLayout[ii] = VK_IMAGE_LAYOUT_UNDEFINED;
+		}
+
+		VkSemaphoreCreateInfo sci;
+		sci.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		sci.pNext = NULL;
+		sci.flags = 0;
+
+		for (uint32_t ii = 0; ii < m_numSwapchainImages; ++ii)
+		{
+			if (VK_SUCCESS != vkCreateSemaphore(device, &sci, allocatorCb, &m_presentDoneSemaphore[ii])
+			||  VK_SUCCESS != vkCreateSemaphore(device, &sci, allocatorCb, &m_renderDoneSemaphore[ii]) )
+			{
+				BX_TRACE("Create swapchain error: vkCreateSemaphore failed %d: %s.", result, getName(result) );
+				return result;
+			}
+		}
+
+		m_backBufferColorIdx = 0;
+		m_currentSemaphore = 0;
+
+		m_needPresent = false;
+		m_needToRefreshSwapchain = false;
+
+		return result;
+	}
+
+	void SwapChainVK::releaseSwapChain()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_backBufferColorImageView); ++ii)
+		{
+			release(m_backBufferColorImageView[ii]);
+
+			m_backBufferColorImageLayout[ii] = VK_IMAGE_LAYOUT_UNDEFINED;
+			m_backBufferFence[ii] = VK_NULL_HANDLE;
+
+			release(m_presentDoneSemaphore[ii]);
+			release(m_renderDoneSemaphore[ii]);
+		}
+
+		release(m_swapchain);
+	}
+
+	VkResult SwapChainVK::createAttachments(VkCommandBuffer _commandBuffer)
+	{
+		VkResult result = VK_SUCCESS;
+
+		const uint32_t samplerIndex = (m_resolution.reset & BGFX_RESET_MSAA_MASK) >> BGFX_RESET_MSAA_SHIFT;
+		const uint64_t textureFlags = (uint64_t(samplerIndex + 1) << BGFX_TEXTURE_RT_MSAA_SHIFT) | BGFX_TEXTURE_RT | BGFX_TEXTURE_RT_WRITE_ONLY;
+		m_sampler = s_msaa[samplerIndex];
+
+		const uint16_t requiredCaps = m_sampler.Count > 1
+			? BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER_MSAA
+			: BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER
+			;
+
+		// the spec guarantees that at least one of D24S8 and D32FS8 is supported
+		VkFormat depthFormat = VK_FORMAT_D32_SFLOAT_S8_UINT;
+
+		if (g_caps.formats[m_depthFormat] & requiredCaps)
+		{
+			depthFormat = s_textureFormat[m_depthFormat].m_fmtDsv;
+		}
+		else if (g_caps.formats[TextureFormat::D24S8] & requiredCaps)
+		{
+			depthFormat = s_textureFormat[TextureFormat::D24S8].m_fmtDsv;
+		}
+
+		result = m_backBufferDepthStencil.create(
+			  _commandBuffer
+			, m_sci.imageExtent.width
+			, m_sci.imageExtent.height
+			, textureFlags
+			, depthFormat
+			);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Create swapchain error: creating depth stencil image failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		result = m_backBufferDepthStencil.createView(0, 1, 0, 1, VK_IMAGE_VIEW_TYPE_2D, true, &m_backBufferDepthStencilImageView);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("Create swapchain error: creating depth stencil image view failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		if (m_sampler.Count > 1)
+		{
+			result = m_backBufferColorMsaa.create(
+				  _commandBuffer
+				, m_sci.imageExtent.width
+				, m_sci.imageExtent.height
+				, textureFlags
+				, m_sci.imageFormat
+				);
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create swapchain error: creating MSAA color image failed %d: %s.", result, getName(result) );
+				return result;
+			}
+
+			result = m_backBufferColorMsaa.createView(0, 1, 0, 1, VK_IMAGE_VIEW_TYPE_2D, true, &m_backBufferColorMsaaImageView);
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Create swapchain error: creating MSAA color image view failed %d: %s.", result, getName(result) );
+				return result;
+			}
+		}
+
+		return result;
+	}
+
+	void SwapChainVK::releaseAttachments()
+	{
+		release(m_backBufferDepthStencilImageView);
+		release(m_backBufferColorMsaaImageView);
+
+		m_backBufferDepthStencil.destroy();
+		m_backBufferColorMsaa.destroy();
+	}
+
+	VkResult SwapChainVK::createFrameBuffer()
+	{
+		VkResult result = VK_SUCCESS;
+
+		const VkDevice device = s_renderVK->m_device;
+		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+
+		VkRenderPass renderPass;
+		result = s_renderVK->getRenderPass(*this, &renderPass);
+
+		if (VK_SUCCESS != result)
+		{
+			return result;
+		}
+
+		for (uint32_t ii = 0; ii < m_numSwapchainImages; ++ii)
+		{
+			uint32_t numAttachments = 2;
+			::VkImageView attachments[3] =
+			{
+				m_sampler.Count > 1
+					? m_backBufferColorMsaaImageView
+					: m_backBufferColorImageView[ii],
+				m_backBufferDepthStencilImageView,
+			};
+
+			if (m_sampler.Count > 1 && !m_supportsManualResolve)
 			{
-				VkXlibSurfaceCreateInfoKHR sci;
-				sci.sType = VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR;
-				sci.pNext = NULL;
-				sci.flags  = 0;
-				sci.dpy    = (Display*)g_platformData.ndt;
-				sci.window = (Window)m_nwh;
-				result = vkCreateXlibSurfaceKHR(instance, &sci, allocatorCb, &m_surface);
+				attachments[numAttachments++] = m_backBufferColorImageView[ii];
 			}
 
+			VkFramebufferCreateInfo fci;
+			fci.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+			fci.pNext = NULL;
+			fci.flags = 0;
+			fci.renderPass = renderPass;
+			fci.attachmentCount = numAttachments;
+			fci.pAttachments = attachments;
+			fci.width = m_sci.imageExtent.width;
+			fci.height = m_sci.imageExtent.height;
+			fci.layers = 1;
+
+			result = vkCreateFramebuffer(device, &fci, allocatorCb, &m_backBufferFrameBuffer[ii]);
+
 			if (VK_SUCCESS != result)
 			{
-				void* xcbdll = bx::dlopen("libX11-xcb.so.1");
+				return result;
+			}
+		}
 
-				if (NULL != xcbdll
-				&&  NULL != vkCreateXcbSurfaceKHR)
-				{
-					typedef xcb_connection_t* (*PFN_XGETXCBCONNECTION)(Display*);
-					PFN_XGETXCBCONNECTION XGetXCBConnection = (PFN_XGETXCBCONNECTION)bx::dlsym(xcbdll, "XGetXCBConnection");
+		return result;
+	}
 
-					union { void* ptr; xcb_window_t window; } cast = { m_nwh };
+	void SwapChainVK::releaseFrameBuffer()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_backBufferColorImageView); ++ii)
+		{
+			release(m_backBufferFrameBuffer[ii]);
+		}
+	}
 
-					VkXcbSurfaceCreateInfoKHR sci;
-					sci.sType      = VK_STRUCTURE_TYPE_XCB_SURFACE_CREATE_INFO_KHR;
-					sci.pNext      = NULL;
-					sci.flags      = 0;
-					sci.connection = XGetXCBConnection( (Display*)g_platformData.ndt);
-					sci.window     = cast.window;
-					result = vkCreateXcbSurfaceKHR(instance, &sci, allocatorCb, &m_surface);
+	uint32_t SwapChainVK::findPresentMode(bool _vsync)
+	{
+		VkResult result = VK_SUCCESS;
 
-					bx::dlclose(xcbdll);
+		const VkPhysicalDevice physicalDevice = s_renderVK->m_physicalDevice;
+
+		uint32_t numPresentModes;
+		result = vkGetPhysicalDeviceSurfacePresentModesKHR(
+			  physicalDevice
+			, m_surface
+			, &numPresentModes
+			, NULL
+			);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("findPresentMode error: vkGetPhysicalDeviceSurfacePresentModesKHR failed %d: %s.", result, getName(result) );
+			return UINT32_MAX;
+		}
+
+		VkPresentModeKHR presentModes[16];
+		numPresentModes = bx::min<uint32_t>(numPresentModes, BX_COUNTOF(presentModes) );
+		result = vkGetPhysicalDeviceSurfacePresentModesKHR(
+			  physicalDevice
+			, m_surface
+			, &numPresentModes
+			, presentModes
+			);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("findPresentMode error: vkGetPhysicalDeviceSurfacePresentModesKHR failed %d: %s.", result, getName(result) );
+			return UINT32_MAX;
+		}
+
+		uint32_t idx = UINT32_MAX;
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_presentMode) && UINT32_MAX == idx; ++ii)
+		{
+			for (uint32_t jj = 0; jj < numPresentModes; ++jj)
+			{
+				const PresentMode& pm = s_presentMode[ii];
+
+				if (pm.mode  == presentModes[jj]
+				&&  pm.vsync == _vsync)
+				{
+					idx = ii;
+					break;
 				}
 			}
 		}
-#elif BX_PLATFORM_OSX
+
+		if (UINT32_MAX == idx)
 		{
-			if (NULL != vkCreateMacOSSurfaceMVK)
-			{
-				NSWindow* window    = (NSWindow*)(m_nwh);
-				NSView* contentView = (NSView*)window.contentView;
-				CAMetalLayer* layer = [CAMetalLayer layer];
+			idx = 0;
+			BX_TRACE("Present mode not found! Defaulting to %s.", s_presentMode[idx].name);
+		}
 
-				if (m_resolution.reset & BGFX_RESET_HIDPI)
+		return idx;
+	}
+
+	TextureFormat::Enum SwapChainVK::findSurfaceFormat(TextureFormat::Enum _format, VkColorSpaceKHR _colorSpace, bool _srgb)
+	{
+		VkResult result = VK_SUCCESS;
+
+		TextureFormat::Enum selectedFormat = TextureFormat::Count;
+
+		const VkPhysicalDevice physicalDevice = s_renderVK->m_physicalDevice;
+
+		uint32_t numSurfaceFormats;
+		result = vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, m_surface, &numSurfaceFormats, NULL);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("findSurfaceFormat error: vkGetPhysicalDeviceSurfaceFormatsKHR failed %d: %s.", result, getName(result) );
+			return selectedFormat;
+		}
+
+		VkSurfaceFormatKHR* surfaceFormats = (VkSurfaceFormatKHR*)BX_ALLOC(g_allocator, numSurfaceFormats * sizeof(VkSurfaceFormatKHR) );
+		result = vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, m_surface, &numSurfaceFormats, surfaceFormats);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("findSurfaceFormat error: vkGetPhysicalDeviceSurfaceFormatsKHR failed %d: %s.", result, getName(result) );
+			BX_FREE(g_allocator, surfaceFormats);
+			return selectedFormat;
+		}
+
+		const TextureFormat::Enum requestedFormats[] =
+		{
+			_format,
+			TextureFormat::BGRA8,
+			TextureFormat::RGBA8,
+		};
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(requestedFormats) && TextureFormat::Count == selectedFormat; ii++)
+		{
+			const TextureFormat::Enum requested = requestedFormats[ii];
+			const VkFormat requestedVkFormat = _srgb
+				? s_textureFormat[requested].m_fmtSrgb
+				: s_textureFormat[requested].m_fmt
+				;
+
+			for (uint32_t jj = 0; jj < numSurfaceFormats; jj++)
+			{
+				if (_colorSpace == surfaceFormats[jj].colorSpace
+				&&  requestedVkFormat == surfaceFormats[jj].format)
 				{
-					layer.contentsScale = [window backingScaleFactor];
+					selectedFormat = requested;
+					if (0 != ii)
+					{
+						BX_TRACE(
+							"findSurfaceFormat: Surface format %s not found! Defaulting to %s."
+							, bimg::getName(bimg::TextureFormat::Enum(_format) )
+							, bimg::getName(bimg::TextureFormat::Enum(selectedFormat) )
+							);
+					}
+					break;
 				}
+			}
+		}
 
-				[contentView setWantsLayer : YES];
-				[contentView setLayer : layer];
+		BX_FREE(g_allocator, surfaceFormats);
 
-				VkMacOSSurfaceCreateInfoMVK sci;
-				sci.sType = VK_STRUCTURE_TYPE_MACOS_SURFACE_CREATE_INFO_MVK;
-				sci.pNext = NULL;
-				sci.flags = 0;
-				sci.pView = (__bridge void*)layer;
-				result = vkCreateMacOSSurfaceMVK(instance, &sci, allocatorCb, &m_surface);
+		if (TextureFormat::Count == selectedFormat)
+		{
+			BX_TRACE("findSurfaceFormat error: No supported surface format found.");
+		}
+
+		return selectedFormat;
+	}
+
+	bool SwapChainVK::acquire(VkCommandBuffer _commandBuffer)
+	{
+		if (VK_NULL_HANDLE == m_swapchain
+		||  m_needToRefreshSwapchain)
+		{
+			return false;
+		}
+
+		if (!m_needPresent)
+		{
+			const VkDevice device = s_renderVK->m_device;
+
+			m_lastImageAcquiredSemaphore = m_presentDoneSemaphore[m_currentSemaphore];
+			m_lastImageRenderedSemaphore = m_renderDoneSemaphore[m_currentSemaphore];
+			m_currentSemaphore = (m_currentSemaphore + 1) % m_numSwapchainImages;
+
+			VkResult result = vkAcquireNextImageKHR(
+				  device
+				, m_swapchain
+				, UINT64_MAX
+				, m_lastImageAcquiredSemaphore
+				, VK_NULL_HANDLE
+				, &m_backBufferColorIdx
+				);
+
+			switch (result)
+			{
+			case VK_SUCCESS:
+				break;
+			case VK_ERROR_SURFACE_LOST_KHR:
+				m_needToRecreateSurface = true;
+				BX_FALLTHROUGH;
+			case VK_ERROR_OUT_OF_DATE_KHR:
+				m_needToRefreshSwapchain = true;
+				return false;
+			default:
+				VK_CHECK(result);
+				return false;
+			}
+
+			if (VK_NULL_HANDLE != m_backBufferFence[m_backBufferColorIdx])
+			{
+				VK_CHECK(vkWaitForFences(
+					  device
+					, 1
+					, &m_backBufferFence[m_backBufferColorIdx]
+					, VK_TRUE
+					, UINT64_MAX
+					) );
 			}
+
+			transitionImage(_commandBuffer, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+
+			m_needPresent = true;
 		}
-#else
-#	error "Figure out KHR surface..."
-#endif // BX_PLATFORM_
 
-		m_needToRecreateSurface = false;
+		return true;
+	}
 
-		if (VK_SUCCESS != result)
+	void SwapChainVK::present()
+	{
+		if (VK_NULL_HANDLE != m_swapchain
+		&&  m_needPresent)
 		{
-			BX_TRACE("Create surface error: vkCreate[Platform]SurfaceKHR failed %d: %s.", result, getName(result) );
-			return result;
-		}
+			VkPresentInfoKHR pi;
+			pi.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+			pi.pNext = NULL;
+			pi.waitSemaphoreCount = 1;
+			pi.pWaitSemaphores    = &m_lastImageRenderedSemaphore;
+			pi.swapchainCount     = 1;
+			pi.pSwapchains        = &m_swapchain;
+			pi.pImageIndices      = &m_backBufferColorIdx;
+			pi.pResults           = NULL;
+			VkResult result = vkQueuePresentKHR(m_queue, &pi);
 
-		const VkPhysicalDevice physicalDevice = s_renderVK->m_physicalDevice;
-		const uint32_t queueFamily = s_renderVK->m_qfiGraphics;
+			switch (result)
+			{
+			case VK_ERROR_SURFACE_LOST_KHR:
+				m_needToRecreateSurface = true;
+				BX_FALLTHROUGH;
+			case VK_ERROR_OUT_OF_DATE_KHR:
+			case VK_SUBOPTIMAL_KHR:
+				m_needToRefreshSwapchain = true;
+				break;
+			default:
+				VK_CHECK(result);
+				break;
+			}
 
-		VkBool32 surfaceSupported;
-		result = vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, queueFamily, m_surface, &surfaceSupported);
+			m_needPresent = false;
+			m_lastImageRenderedSemaphore = VK_NULL_HANDLE;
+		}
+	}
 
-		if (VK_SUCCESS != result
-		||  !surfaceSupported)
+	void SwapChainVK::transitionImage(VkCommandBuffer _commandBuffer, VkImageLayout _newLayout)
+	{
+		VkImageLayout& layout = m_backBufferColorImageLayout[m_backBufferColorIdx];
+		if (_newLayout != layout)
 		{
-			BX_TRACE("Create surface error: Presentation to the given surface not supported.");
-			return VK_ERROR_INITIALIZATION_FAILED;
-		}
+			setImageMemoryBarrier(
+				  _commandBuffer
+				, m_backBufferColorImage[m_backBufferColorIdx]
+				, VK_IMAGE_ASPECT_COLOR_BIT
+				, layout
+				, _newLayout
+			);
 
-		return result;
+			layout = _newLayout;
+		}
 	}
 
-	void SwapChainVK::releaseSurface()
+	void FrameBufferVK::create(uint8_t _num, const Attachment* _attachment)
 	{
-		release(m_surface);
+		m_numTh = _num;
+		bx::memCopy(m_attachment, _attachment, sizeof(Attachment) * _num);
+
+		postReset();
 	}
 
-	VkResult SwapChainVK::createSwapChain()
+	VkResult FrameBufferVK::create(uint16_t _denseIdx, void* _nwh, uint32_t _width, uint32_t _height, TextureFormat::Enum _format, TextureFormat::Enum _depthFormat)
 	{
 		VkResult result = VK_SUCCESS;
 
-		const VkPhysicalDevice physicalDevice = s_renderVK->m_physicalDevice;
-		const VkDevice device = s_renderVK->m_device;
-		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		Resolution resolution = s_renderVK->m_resolution;
+		resolution.format = TextureFormat::Count == _format ? resolution.format : _format;
+		resolution.width  = _width;
+		resolution.height = _height;
+		if (_denseIdx != UINT16_MAX)
+		{
+			resolution.reset &= ~BGFX_RESET_MSAA_MASK;
+		}
 
-		VkSurfaceCapabilitiesKHR surfaceCapabilities;
-		result = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, m_surface, &surfaceCapabilities);
+		result = m_swapChain.create(s_renderVK->m_commandBuffer, _nwh, resolution, _depthFormat);
 
 		if (VK_SUCCESS != result)
 		{
-			BX_TRACE("Create swapchain error: vkGetPhysicalDeviceSurfaceCapabilitiesKHR failed %d: %s.", result, getName(result) );
 			return result;
 		}
 
-		const uint32_t minSwapBufferCount = bx::max<uint32_t>(surfaceCapabilities.minImageCount, 2);
-		const uint32_t maxSwapBufferCount = surfaceCapabilities.maxImageCount == 0
-			? BGFX_CONFIG_MAX_BACK_BUFFERS
-			: bx::min<uint32_t>(surfaceCapabilities.maxImageCount, BGFX_CONFIG_MAX_BACK_BUFFERS)
-			;
+		result = s_renderVK->getRenderPass(m_swapChain, &m_renderPass);
 
-		if (minSwapBufferCount > maxSwapBufferCount)
+		if (VK_SUCCESS != result)
 		{
-			BX_TRACE("Create swapchain error: Incompatible swapchain image count (min: %d, max: %d, BGFX_CONFIG_MAX_BACK_BUFFERS: %d)."
-				, minSwapBufferCount
-				, maxSwapBufferCount
-				, BGFX_CONFIG_MAX_BACK_BUFFERS
-				);
-			return VK_ERROR_INITIALIZATION_FAILED;
+			return result;
 		}
 
-		const uint32_t swapBufferCount = bx::clamp<uint32_t>(m_resolution.numBackBuffers, minSwapBufferCount, maxSwapBufferCount);
-
-		const VkColorSpaceKHR surfaceColorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+		m_denseIdx = _denseIdx;
+		m_nwh = _nwh;
+		m_width = _width;
+		m_height = _height;
+		m_sampler = m_swapChain.m_sampler;
 
-		const bool srgb = !!(m_resolution.reset & BGFX_RESET_SRGB_BACKBUFFER);
-		m_colorFormat = findSurfaceFormat(m_resolution.format, surfaceColorSpace, srgb);
+		return result;
+	}
 
-		if (TextureFormat::Count == m_colorFormat)
+	void FrameBufferVK::preReset()
+	{
+		if (VK_NULL_HANDLE != m_framebuffer)
 		{
-			BX_TRACE("Create swapchain error: Unable to find surface format (srgb: %d).", srgb);
-			return VK_ERROR_INITIALIZATION_FAILED;
-		}
-
-		const VkFormat surfaceFormat = srgb
-			? s_textureFormat[m_colorFormat].m_fmtSrgb
-			: s_textureFormat[m_colorFormat].m_fmt
-			;
-
-		const uint32_t width = bx::clamp<uint32_t>(
-			  m_resolution.width
-			, surfaceCapabilities.minImageExtent.width
-			, surfaceCapabilities.maxImageExtent.width
-			);
-		const uint32_t height = bx::clamp<uint32_t>(
-			  m_resolution.height
-			, surfaceCapabilities.minImageExtent.height
-			, surfaceCapabilities.maxImageExtent.height
-			);
+			s_renderVK->release(m_framebuffer);
 
-		VkCompositeAlphaFlagBitsKHR compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+			for (uint8_t ii = 0; ii < m_numTh; ++ii)
+			{
+				s_renderVK->release(m_textureImageViews[ii]);
+			}
 
-		if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR)
-		{
-			compositeAlpha = VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR;
-		}
-		else if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR)
-		{
-			compositeAlpha = VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR;
-		}
-		else if (surfaceCapabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR)
-		{
-			compositeAlpha = VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR;
+			m_depth = BGFX_INVALID_HANDLE;
 		}
+	}
 
-		const VkImageUsageFlags imageUsageMask = 0
-			| VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
-			| VK_IMAGE_USAGE_TRANSFER_SRC_BIT
-			| VK_IMAGE_USAGE_TRANSFER_DST_BIT
-			;
-		const VkImageUsageFlags imageUsage = surfaceCapabilities.supportedUsageFlags & imageUsageMask;
-
-		m_supportsReadback      = 0 != (imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
-		m_supportsManualResolve = 0 != (imageUsage & VK_IMAGE_USAGE_TRANSFER_DST_BIT);
-
-		const bool vsync = !!(m_resolution.reset & BGFX_RESET_VSYNC);
-		uint32_t presentModeIdx = findPresentMode(vsync);
-		if (UINT32_MAX == presentModeIdx)
+	void FrameBufferVK::postReset()
+	{
+		if (m_numTh > 0)
 		{
-			BX_TRACE("Create swapchain error: Unable to find present mode (vsync: %d).", vsync);
-			return VK_ERROR_INITIALIZATION_FAILED;
-		}
+			const VkDevice device = s_renderVK->m_device;
+			const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
 
-		m_sci.surface            = m_surface;
-		m_sci.minImageCount      = swapBufferCount;
-		m_sci.imageFormat        = surfaceFormat;
-		m_sci.imageColorSpace    = surfaceColorSpace;
-		m_sci.imageExtent.width  = width;
-		m_sci.imageExtent.height = height;
-		m_sci.imageUsage         = imageUsage;
-		m_sci.compositeAlpha     = compositeAlpha;
-		m_sci.presentMode        = s_presentMode[presentModeIdx].mode;
-		m_sci.clipped            = VK_FALSE;
+			VK_CHECK(s_renderVK->getRenderPass(m_numTh, m_attachment, &m_renderPass) );
 
-		result = vkCreateSwapchainKHR(device, &m_sci, allocatorCb, &m_swapchain);
-		if (VK_SUCCESS != result)
-		{
-			BX_TRACE("Create swapchain error: vkCreateSwapchainKHR failed %d: %s.", result, getName(result) );
-			return result;
-		}
+			m_depth = BGFX_INVALID_HANDLE;
+			m_num = 0;
 
-		m_sci.oldSwapchain = m_swapchain;
+			for (uint8_t ii = 0; ii < m_numTh; ++ii)
+			{
+				const Attachment& at = m_attachment[ii];
+				const TextureVK& texture = s_renderVK->m_textures[at.handle.idx];
+				VK_CHECK(texture.createView(
+					  at.layer
+					, at.numLayers
+					, at.mip
+					, 1
+					, at.numLayers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D
+					, true
+					, &m_textureImageViews[ii]
+					) );
 
-		result = vkGetSwapchainImagesKHR(device, m_swapchain, &m_numSwapchainImages, NULL);
-		if (VK_SUCCESS != result)
-		{
-			BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR failed %d: %s.", result, getName(result) );
-			return result;
-		}
+				if (texture.m_aspectMask & VK_IMAGE_ASPECT_COLOR_BIT)
+				{
+					m_texture[m_num] = at.handle;
+					m_num++;
+				}
+				else if (texture.m_aspectMask & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) )
+				{
+					m_depth = at.handle;
+				}
+			}
 
-		if (m_numSwapchainImages < m_sci.minImageCount)
-		{
-			BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR: numSwapchainImages %d < minImageCount %d."
-				, m_numSwapchainImages
-				, m_sci.minImageCount
-				);
-			return VK_ERROR_INITIALIZATION_FAILED;
-		}
+			const TextureVK& firstTexture = s_renderVK->m_textures[m_attachment[0].handle.idx];
+			m_width  = bx::uint32_max(firstTexture.m_width  >> m_attachment[0].mip, 1);
+			m_height = bx::uint32_max(firstTexture.m_height >> m_attachment[0].mip, 1);
+			m_sampler = firstTexture.m_sampler;
 
-		if (m_numSwapchainImages > BX_COUNTOF(m_backBufferColorImage) )
-		{
-			BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR: numSwapchainImages %d > countof(m_backBufferColorImage) %d."
-				, m_numSwapchainImages
-				, BX_COUNTOF(m_backBufferColorImage)
-				);
-			return VK_ERROR_INITIALIZATION_FAILED;
-		}
+			VkFramebufferCreateInfo fci;
+			fci.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+			fci.pNext = NULL;
+			fci.flags = 0;
+			fci.renderPass      = m_renderPass;
+			fci.attachmentCount = m_numTh;
+			fci.pAttachments    = &m_textureImageViews[0];
+			fci.width  = m_width;
+			fci.height = m_height;
+			fci.layers = m_attachment[0].numLayers;
 
-		result = vkGetSwapchainImagesKHR(device, m_swapchain, &m_numSwapchainImages, &m_backBufferColorImage[0]);
-		if (VK_SUCCESS != result && VK_INCOMPLETE != result)
-		{
-			BX_TRACE("Create swapchain error: vkGetSwapchainImagesKHR failed %d: %s."
-				, result
-				, getName(result)
-				);
-			return result;
+			VK_CHECK(vkCreateFramebuffer(device, &fci, allocatorCb, &m_framebuffer) );
+
+			m_currentFramebuffer = m_framebuffer;
 		}
+	}
 
-		VkImageViewCreateInfo ivci;
-		ivci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-		ivci.pNext = NULL;
-		ivci.flags = 0;
-		ivci.viewType = VK_IMAGE_VIEW_TYPE_2D;
-		ivci.format   = m_sci.imageFormat;
-		ivci.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-		ivci.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-		ivci.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-		ivci.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
-		ivci.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-		ivci.subresourceRange.baseMipLevel   = 0;
-		ivci.subresourceRange.levelCount     = 1;
-		ivci.subresourceRange.baseArrayLayer = 0;
-		ivci.subresourceRange.layerCount     = 1;
+	void FrameBufferVK::update(VkCommandBuffer _commandBuffer, const Resolution& _resolution)
+	{
+		m_swapChain.update(_commandBuffer, m_nwh, _resolution);
+		VK_CHECK(s_renderVK->getRenderPass(m_swapChain, &m_renderPass) );
+		m_width   = _resolution.width;
+		m_height  = _resolution.height;
+		m_sampler = m_swapChain.m_sampler;
+	}
 
-		for (uint32_t ii = 0; ii < m_numSwapchainImages; ++ii)
+	void FrameBufferVK::resolve()
+	{
+		if (NULL == m_nwh)
 		{
-			ivci.image = m_backBufferColorImage[ii];
-
-			result = vkCreateImageView(device, &ivci, allocatorCb, &m_backBufferColorImageView[ii]);
-
-			if (VK_SUCCESS != result)
+			for (uint32_t ii = 0; ii < m_numTh; ++ii)
 			{
-				BX_TRACE("Create swapchain error: vkCreateImageView failed %d: %s.", result, getName(result) );
-				return result;
+				const Attachment& at = m_attachment[ii];
+
+				if (isValid(at.handle) )
+				{
+					TextureVK& texture = s_renderVK->m_textures[at.handle.idx];
+					texture.resolve(s_renderVK->m_commandBuffer, at.resolve, at.layer, at.numLayers, at.mip);
+				}
 			}
+		}
+		else if (isRenderable()
+		&&       m_sampler.Count > 1
+		&&       m_swapChain.m_supportsManualResolve)
+		{
+			m_swapChain.m_backBufferColorMsaa.m_singleMsaaImage = m_swapChain.m_backBufferColorImage[m_swapChain.m_backBufferColorIdx];
+			m_swapChain.m_backBufferColorMsaa.m_currentSingleMsaaImageLayout = m_swapChain.m_backBufferColorImageLayout[m_swapChain.m_backBufferColorIdx];
 
-			m_backBufferColorImageLayout[ii] = VK_IMAGE_LAYOUT_UNDEFINED;
+			m_swapChain.m_backBufferColorMsaa.resolve(s_renderVK->m_commandBuffer, 0, 0, 1, 0);
+
+			m_swapChain.m_backBufferColorMsaa.m_singleMsaaImage = VK_NULL_HANDLE;
+			m_swapChain.m_backBufferColorMsaa.m_currentSingleMsaaImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 		}
+	}
 
-		VkSemaphoreCreateInfo sci;
-		sci.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-		sci.pNext = NULL;
-		sci.flags = 0;
+	uint16_t FrameBufferVK::destroy()
+	{
+		preReset();
 
-		for (uint32_t ii = 0; ii < m_numSwapchainImages; ++ii)
+		if (NULL != m_nwh)
 		{
-			if (VK_SUCCESS != vkCreateSemaphore(device, &sci, allocatorCb, &m_presentDoneSemaphore[ii])
-			||  VK_SUCCESS != vkCreateSemaphore(device, &sci, allocatorCb, &m_renderDoneSemaphore[ii]) )
-			{
-				BX_TRACE("Create swapchain error: vkCreateSemaphore failed %d: %s.", result, getName(result) );
-				return result;
-			}
+			m_swapChain.destroy();
+			m_nwh = NULL;
+			m_needPresent = false;
 		}
 
-		m_backBufferColorIdx = 0;
-		m_currentSemaphore = 0;
-
-		m_needPresent = false;
-		m_needToRefreshSwapchain = false;
+		m_numTh = 0;
+		m_num = 0;
 
-		return result;
+		uint16_t denseIdx = m_denseIdx;
+		m_denseIdx = UINT16_MAX;
+		return denseIdx;
 	}
 
-	void SwapChainVK::releaseSwapChain()
+	bool FrameBufferVK::acquire(VkCommandBuffer _commandBuffer)
 	{
-		for (uint32_t ii = 0; ii < BX_COUNTOF(m_backBufferColorImageView); ++ii)
+		if (NULL != m_nwh)
 		{
-			release(m_backBufferColorImageView[ii]);
-
-			m_backBufferColorImageLayout[ii] = VK_IMAGE_LAYOUT_UNDEFINED;
-			m_backBufferFence[ii] = VK_NULL_HANDLE;
+			const bool acquired = m_swapChain.acquire(_commandBuffer);
+			m_needPresent = m_swapChain.m_needPresent;
+			m_currentFramebuffer = m_swapChain.m_backBufferFrameBuffer[m_swapChain.m_backBufferColorIdx];
 
-			release(m_presentDoneSemaphore[ii]);
-			release(m_renderDoneSemaphore[ii]);
+			return acquired;
 		}
 
-		release(m_swapchain);
+		return true;
 	}
 
-	VkResult SwapChainVK::createAttachments(VkCommandBuffer _commandBuffer)
+	void FrameBufferVK::present()
 	{
-		VkResult result = VK_SUCCESS;
-
-		const uint32_t samplerIndex = (m_resolution.reset & BGFX_RESET_MSAA_MASK) >> BGFX_RESET_MSAA_SHIFT;
-		const uint64_t textureFlags = (uint64_t(samplerIndex + 1) << BGFX_TEXTURE_RT_MSAA_SHIFT) | BGFX_TEXTURE_RT | BGFX_TEXTURE_RT_WRITE_ONLY;
-		m_sampler = s_msaa[samplerIndex];
+		m_swapChain.present();
+		m_needPresent = false;
+	}
 
-		const uint16_t requiredCaps = m_sampler.Count > 1
-			? BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER_MSAA
-			: BGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER
+	bool FrameBufferVK::isRenderable() const
+	{
+		return false
+			|| (NULL == m_nwh)
+			|| m_swapChain.m_needPresent
 			;
+	}
 
-		// the spec guarantees that at least one of D24S8 and D32FS8 is supported
-		VkFormat depthFormat = VK_FORMAT_D32_SFLOAT_S8_UINT;
-
-		if (g_caps.formats[m_depthFormat] & requiredCaps)
-		{
-			depthFormat = s_textureFormat[m_depthFormat].m_fmtDsv;
-		}
-		else if (g_caps.formats[TextureFormat::D24S8] & requiredCaps)
-		{
-			depthFormat = s_textureFormat[TextureFormat::D24S8].m_fmtDsv;
-		}
-
-		result = m_backBufferDepthStencil.create(
-			  _commandBuffer
-			, m_sci.imageExtent.width
-			, m_sci.imageExtent.height
-			, textureFlags
-			, depthFormat
-			);
-
-		if (VK_SUCCESS != result)
-		{
-			BX_TRACE("Create swapchain error: creating depth stencil image failed %d: %s.", result, getName(result) );
-			return result;
-		}
+	VkResult CommandQueueVK::init(uint32_t _queueFamily, VkQueue _queue, uint32_t _numFramesInFlight)
+	{
+		m_queueFamily = _queueFamily;
+		m_queue = _queue;
+		m_numFramesInFlight = bx::clamp<uint32_t>(_numFramesInFlight, 1, BGFX_CONFIG_MAX_FRAME_LATENCY);
+		m_activeCommandBuffer = VK_NULL_HANDLE;
 
-		result = m_backBufferDepthStencil.createView(0, 1, 0, 1, VK_IMAGE_VIEW_TYPE_2D, true, &m_backBufferDepthStencilImageView);
+		return reset();
+	}
 
-		if (VK_SUCCESS != result)
-		{
-			BX_TRACE("Create swapchain error: creating depth stencil image view failed %d: %s.", result, getName(result) );
-			return result;
-		}
+	VkResult CommandQueueVK::reset()
+	{
+		shutdown();
 
-		if (m_sampler.Count > 1)
-		{
-			result = m_backBufferColorMsaa.create(
-				  _commandBuffer
-				, m_sci.imageExtent.width
-				, m_sci.imageExtent.height
-				, textureFlags
-				, m_sci.imageFormat
-				);
+		m_currentFrameInFlight = 0;
+		m_consumeIndex         = 0;
 
-			if (VK_SUCCESS != result)
-			{
-				BX_TRACE("Create swapchain error: creating MSAA color image failed %d: %s.", result, getName(result) );
-				return result;
-			}
+		m_numSignalSemaphores = 0;
+		m_numWaitSemaphores   = 0;
 
-			result = m_backBufferColorMsaa.createView(0, 1, 0, 1, VK_IMAGE_VIEW_TYPE_2D, true, &m_backBufferColorMsaaImageView);
+		m_activeCommandBuffer = VK_NULL_HANDLE;
+		m_upcomingFence       = VK_NULL_HANDLE;
+		m_kickedFence         = VK_NULL_HANDLE;
 
-			if (VK_SUCCESS != result)
-			{
-				BX_TRACE("Create swapchain error: creating MSAA color image view failed %d: %s.", result, getName(result) );
-				return result;
-			}
-		}
+		bx::memSet(m_numSecondary, 0, sizeof(m_numSecondary) );
 
-		return result;
-	}
+		VkCommandPoolCreateInfo cpci;
+		cpci.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		cpci.pNext = NULL;
+		cpci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		cpci.queueFamilyIndex = m_queueFamily;
 
-	void SwapChainVK::releaseAttachments()
-	{
-		release(m_backBufferDepthStencilImageView);
-		release(m_backBufferColorMsaaImageView);
+		VkCommandBufferAllocateInfo cbai;
+		cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		cbai.pNext = NULL;
+		cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		cbai.commandBufferCount = 1;
 
-		m_backBufferDepthStencil.destroy();
-		m_backBufferColorMsaa.destroy();
-	}
+		VkFenceCreateInfo fci;
+		fci.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fci.pNext = NULL;
+		fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-	VkResult SwapChainVK::createFrameBuffer()
-	{
 		VkResult result = VK_SUCCESS;
 
-		const VkDevice device = s_renderVK->m_device;
-		const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-
-		VkRenderPass renderPass;
-		result = s_renderVK->getRenderPass(*this, &renderPass);
-
-		if (VK_SUCCESS != result)
+		for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 		{
-			return result;
-		}
+			result = vkCreateCommandPool(
+				  s_renderVK->m_device
+				, &cpci
+				, s_renderVK->m_allocatorCb
+				, &m_commandList[ii].m_commandPool
+				);
 
-		for (uint32_t ii = 0; ii < m_numSwapchainImages; ++ii)
-		{
-			uint32_t numAttachments = 2;
-			::VkImageView attachments[3] =
+			if (VK_SUCCESS != result)
 			{
-				m_sampler.Count > 1
-					? m_backBufferColorMsaaImageView
-					: m_backBufferColorImageView[ii],
-				m_backBufferDepthStencilImageView,
-			};
+				BX_TRACE("Create command queue error: vkCreateCommandPool failed %d: %s.", result, getName(result) );
+				return result;
+			}
 
-			if (m_sampler.Count > 1 && !m_supportsManualResolve)
+			cbai.commandPool = m_commandList[ii].m_commandPool;
+
+			result = vkAllocateCommandBuffers(
+				  s_renderVK->m_device
+				, &cbai
+				, &m_commandList[ii].m_commandBuffer
+				);
+
+			if (VK_SUCCESS != result)
 			{
-				attachments[numAttachments++] = m_backBufferColorImageView[ii];
+				BX_TRACE("Create command queue error: vkAllocateCommandBuffers failed %d: %s.", result, getName(result) );
+				return result;
 			}
 
-			VkFramebufferCreateInfo fci;
-			fci.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-			fci.pNext = NULL;
-			fci.flags = 0;
-			fci.renderPass = renderPass;
-			fci.attachmentCount = numAttachments;
-			fci.pAttachments = attachments;
-			fci.width = m_sci.imageExtent.width;
-			fci.height = m_sci.imageExtent.height;
-			fci.layers = 1;
-
-			result = vkCreateFramebuffer(device, &fci, allocatorCb, &m_backBufferFrameBuffer[ii]);
+			result = vkCreateFence(
+				  s_renderVK->m_device
+				, &fci
+				, s_renderVK->m_allocatorCb
+				, &m_commandList[ii].m_fence
+				);
 
 			if (VK_SUCCESS != result)
 			{
+				BX_TRACE("Create command queue error: vkCreateFence failed %d: %s.", result, getName(result) );
 				return result;
 			}
 		}
@@ -6697,733 +8941,873 @@ VK_DESTROY
 		return result;
 	}
 
-	void SwapChainVK::releaseFrameBuffer()
+	void CommandQueueVK::shutdown()
 	{
-		for (uint32_t ii = 0; ii < BX_COUNTOF(m_backBufferColorImageView); ++ii)
+		kick(true);
+		finish(true);
+
+		for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 		{
-			release(m_backBufferFrameBuffer[ii]);
+			vkDestroy(m_commandList[ii].m_fence);
+
+			if (VK_NULL_HANDLE != m_commandList[ii].m_commandBuffer)
+			{
+				vkFreeCommandBuffers(s_renderVK->m_device, m_commandList[ii].m_commandPool, 1, &m_commandList[ii].m_commandBuffer);
+				m_commandList[ii].m_commandBuffer = VK_NULL_HANDLE;
+			}
+
+			vkDestroy(m_commandList[ii].m_commandPool);
+		}
+
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_FRAME_LATENCY; ++ii)
+		{
+			for (uint32_t jj = 0; jj < BGFX_CONFIG_MAX_SECONDARY_COMMAND_BUFFERS; ++jj)
+			{
+				CommandList& commandList = m_secondaryList[ii][jj];
+
+				if (VK_NULL_HANDLE != commandList.m_commandBuffer)
+				{
+					vkFreeCommandBuffers(s_renderVK->m_device, commandList.m_commandPool, 1, &commandList.m_commandBuffer);
+					commandList.m_commandBuffer = VK_NULL_HANDLE;
+				}
+
+				vkDestroy(commandList.m_commandPool);
+			}
 		}
 	}
 
-	uint32_t SwapChainVK::findPresentMode(bool _vsync)
+	VkResult CommandQueueVK::alloc(VkCommandBuffer* _commandBuffer)
 	{
 		VkResult result = VK_SUCCESS;
 
-		const VkPhysicalDevice physicalDevice = s_renderVK->m_physicalDevice;
-
-		uint32_t numPresentModes;
-		result = vkGetPhysicalDeviceSurfacePresentModesKHR(
-			  physicalDevice
-			, m_surface
-			, &numPresentModes
-			, NULL
-			);
-
-		if (VK_SUCCESS != result)
+		if (m_activeCommandBuffer == VK_NULL_HANDLE)
 		{
-			BX_TRACE("findPresentMode error: vkGetPhysicalDeviceSurfacePresentModesKHR failed %d: %s.", result, getName(result) );
-			return UINT32_MAX;
-		}
+			CommandList& commandList = m_commandList[m_currentFrameInFlight];
 
-		VkPresentModeKHR presentModes[16];
-		numPresentModes = bx::min<uint32_t>(numPresentModes, BX_COUNTOF(presentModes) );
-		result = vkGetPhysicalDeviceSurfacePresentModesKHR(
-			  physicalDevice
-			, m_surface
-			, &numPresentModes
-			, presentModes
-			);
+			result = vkWaitForFences(s_renderVK->m_device, 1, &commandList.m_fence, VK_TRUE, UINT64_MAX);
 
-		if (VK_SUCCESS != result)
-		{
-			BX_TRACE("findPresentMode error: vkGetPhysicalDeviceSurfacePresentModesKHR failed %d: %s.", result, getName(result) );
-			return UINT32_MAX;
-		}
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Allocate command buffer error: vkWaitForFences failed %d: %s.", result, getName(result) );
+				return result;
+			}
 
-		uint32_t idx = UINT32_MAX;
+			result = vkResetCommandPool(s_renderVK->m_device, commandList.m_commandPool, 0);
 
-		for (uint32_t ii = 0; ii < BX_COUNTOF(s_presentMode) && UINT32_MAX == idx; ++ii)
-		{
-			for (uint32_t jj = 0; jj < numPresentModes; ++jj)
+			if (VK_SUCCESS != result)
 			{
-				const PresentMode& pm = s_presentMode[ii];
+				BX_TRACE("Allocate command buffer error: vkResetCommandPool failed %d: %s.", result, getName(result) );
+				return result;
+			}
 
-				if (pm.mode  == presentModes[jj]
-				&&  pm.vsync == _vsync)
-				{
-					idx = ii;
-					break;
-				}
+			VkCommandBufferBeginInfo cbi;
+			cbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			cbi.pNext = NULL;
+			cbi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			cbi.pInheritanceInfo = NULL;
+
+			result = vkBeginCommandBuffer(commandList.m_commandBuffer, &cbi);
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Allocate command buffer error: vkBeginCommandBuffer failed %d: %s.", result, getName(result) );
+				return result;
 			}
+
+			m_activeCommandBuffer = commandList.m_commandBuffer;
+			m_upcomingFence = commandList.m_fence;
 		}
 
-		if (UINT32_MAX == idx)
+		if (NULL != _commandBuffer)
 		{
-			idx = 0;
-			BX_TRACE("Present mode not found! Defaulting to %s.", s_presentMode[idx].name);
+			*_commandBuffer = m_activeCommandBuffer;
 		}
 
-		return idx;
+		return result;
 	}
 
-	TextureFormat::Enum SwapChainVK::findSurfaceFormat(TextureFormat::Enum _format, VkColorSpaceKHR _colorSpace, bool _srgb)
+	VkCommandBuffer CommandQueueVK::allocSecondary()
 	{
-		VkResult result = VK_SUCCESS;
-
-		TextureFormat::Enum selectedFormat = TextureFormat::Count;
-
-		const VkPhysicalDevice physicalDevice = s_renderVK->m_physicalDevice;
+		uint32_t& num = m_numSecondary[m_currentFrameInFlight];
 
-		uint32_t numSurfaceFormats;
-		result = vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, m_surface, &numSurfaceFormats, NULL);
-
-		if (VK_SUCCESS != result)
+		if (BGFX_CONFIG_MAX_SECONDARY_COMMAND_BUFFERS == num)
 		{
-			BX_TRACE("findSurfaceFormat error: vkGetPhysicalDeviceSurfaceFormatsKHR failed %d: %s.", result, getName(result) );
-			return selectedFormat;
+			return VK_NULL_HANDLE;
 		}
 
-		VkSurfaceFormatKHR* surfaceFormats = (VkSurfaceFormatKHR*)BX_ALLOC(g_allocator, numSurfaceFormats * sizeof(VkSurfaceFormatKHR) );
-		result = vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, m_surface, &numSurfaceFormats, surfaceFormats);
+		CommandList& commandList = m_secondaryList[m_currentFrameInFlight][num];
 
-		if (VK_SUCCESS != result)
+		if (VK_NULL_HANDLE == commandList.m_commandBuffer)
 		{
-			BX_TRACE("findSurfaceFormat error: vkGetPhysicalDeviceSurfaceFormatsKHR failed %d: %s.", result, getName(result) );
-			BX_FREE(g_allocator, surfaceFormats);
-			return selectedFormat;
-		}
+			VkCommandPoolCreateInfo cpci;
+			cpci.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+			cpci.pNext = NULL;
+			cpci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+			cpci.queueFamilyIndex = m_queueFamily;
 
-		const TextureFormat::Enum requestedFormats[] =
-		{
-			_format,
-			TextureFormat::BGRA8,
-			TextureFormat::RGBA8,
-		};
+			VkResult result = vkCreateCommandPool(
+				  s_renderVK->m_device
+				, &cpci
+				, s_renderVK->m_allocatorCb
+				, &commandList.m_commandPool
+				);
 
-		for (uint32_t ii = 0; ii < BX_COUNTOF(requestedFormats) && TextureFormat::Count == selectedFormat; ii++)
-		{
-			const TextureFormat::Enum requested = requestedFormats[ii];
-			const VkFormat requestedVkFormat = _srgb
-				? s_textureFormat[requested].m_fmtSrgb
-				: s_textureFormat[requested].m_fmt
-				;
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Allocate secondary command buffer error: vkCreateCommandPool failed %d: %s.", result, getName(result) );
+				return VK_NULL_HANDLE;
+			}
 
-			for (uint32_t jj = 0; jj < numSurfaceFormats; jj++)
+			VkCommandBufferAllocateInfo cbai;
+			cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			cbai.pNext = NULL;
+			cbai.commandPool = commandList.m_commandPool;
+			cbai.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+			cbai.commandBufferCount = 1;
+
+			result = vkAllocateCommandBuffers(
+				  s_renderVK->m_device
+				, &cbai
+				, &commandList.m_commandBuffer
+				);
+
+			if (VK_SUCCESS != result)
 			{
-				if (_colorSpace == surfaceFormats[jj].colorSpace
-				&&  requestedVkFormat == surfaceFormats[jj].format)
-				{
-					selectedFormat = requested;
-					if (0 != ii)
-					{
-						BX_TRACE(
-							"findSurfaceFormat: Surface format %s not found! Defaulting to %s."
-							, bimg::getName(bimg::TextureFormat::Enum(_format) )
-							, bimg::getName(bimg::TextureFormat::Enum(selectedFormat) )
-							);
-					}
-					break;
-				}
+				BX_TRACE("Allocate secondary command buffer error: vkAllocateCommandBuffers failed %d: %s.", result, getName(result) );
+				commandList.m_commandBuffer = VK_NULL_HANDLE;
+				vkDestroy(commandList.m_commandPool);
+				return VK_NULL_HANDLE;
 			}
 		}
 
-		BX_FREE(g_allocator, surfaceFormats);
+		++num;
 
-		if (TextureFormat::Count == selectedFormat)
-		{
-			BX_TRACE("findSurfaceFormat error: No supported surface format found.");
-		}
+		return commandList.m_commandBuffer;
+	}
 
-		return selectedFormat;
+	void CommandQueueVK::addWaitSemaphore(VkSemaphore _semaphore, VkPipelineStageFlags _waitFlags)
+	{
+		BX_ASSERT(m_numWaitSemaphores < BX_COUNTOF(m_waitSemaphores), "Too many wait semaphores.");
+
+		m_waitSemaphores[m_numWaitSemaphores]      = _semaphore;
+		m_waitSemaphoreStages[m_numWaitSemaphores] = _waitFlags;
+		m_numWaitSemaphores++;
 	}
 
-	bool SwapChainVK::acquire(VkCommandBuffer _commandBuffer)
+	void CommandQueueVK::addSignalSemaphore(VkSemaphore _semaphore)
 	{
-		if (VK_NULL_HANDLE == m_swapchain
-		||  m_needToRefreshSwapchain)
-		{
-			return false;
-		}
+		BX_ASSERT(m_numSignalSemaphores < BX_COUNTOF(m_signalSemaphores), "Too many signal semaphores.");
 
-		if (!m_needPresent)
+		m_signalSemaphores[m_numSignalSemaphores] = _semaphore;
+		m_numSignalSemaphores++;
+	}
+
+	void CommandQueueVK::kick(bool _wait)
+	{
+		if (VK_NULL_HANDLE != m_activeCommandBuffer)
 		{
-			const VkDevice device = s_renderVK->m_device;
+			setMemoryBarrier(
+				  m_activeCommandBuffer
+				, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+				, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+				);
 
-			m_lastImageAcquiredSemaphore = m_presentDoneSemaphore[m_currentSemaphore];
-			m_lastImageRenderedSemaphore = m_renderDoneSemaphore[m_currentSemaphore];
-			m_currentSemaphore = (m_currentSemaphore + 1) % m_numSwapchainImages;
+			VK_CHECK(vkEndCommandBuffer(m_activeCommandBuffer) );
 
-			VkResult result = vkAcquireNextImageKHR(
-				  device
-				, m_swapchain
-				, UINT64_MAX
-				, m_lastImageAcquiredSemaphore
-				, VK_NULL_HANDLE
-				, &m_backBufferColorIdx
-				);
+			m_kickedFence = m_upcomingFence;
+			m_upcomingFence = VK_NULL_HANDLE;
 
-			switch (result)
-			{
-			case VK_SUCCESS:
-				break;
-			case VK_ERROR_SURFACE_LOST_KHR:
-				m_needToRecreateSurface = true;
-				BX_FALLTHROUGH;
-			case VK_ERROR_OUT_OF_DATE_KHR:
-				m_needToRefreshSwapchain = true;
-				return false;
-			default:
-				VK_CHECK(result);
-				return false;
-			}
+			VK_CHECK(vkResetFences(s_renderVK->m_device, 1, &m_kickedFence) );
+
+			VkSubmitInfo si;
+			si.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			si.pNext = NULL;
+			si.waitSemaphoreCount    = m_numWaitSemaphores;
+			si.pWaitSemaphores       = &m_waitSemaphores[0];
+			si.pWaitDstStageMask     = m_waitSemaphoreStages;
+			si.commandBufferCount    = 1;
+			si.pCommandBuffers       = &m_activeCommandBuffer;
+			si.signalSemaphoreCount  = m_numSignalSemaphores;
+			si.pSignalSemaphores     = &m_signalSemaphores[0];
 
-			if (VK_NULL_HANDLE != m_backBufferFence[m_backBufferColorIdx])
+			m_numWaitSemaphores   = 0;
+			m_numSignalSemaphores = 0;
+
+			VK_CHECK(vkQueueSubmit(m_queue, 1, &si, m_kickedFence) );
+
+			if (_wait)
 			{
-				VK_CHECK(vkWaitForFences(
-					  device
-					, 1
-					, &m_backBufferFence[m_backBufferColorIdx]
-					, VK_TRUE
-					, UINT64_MAX
-					) );
+				VK_CHECK(vkWaitForFences(s_renderVK->m_device, 1, &m_kickedFence, VK_TRUE, UINT64_MAX) );
 			}
 
-			transitionImage(_commandBuffer, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+			m_activeCommandBuffer = VK_NULL_HANDLE;
 
-			m_needPresent = true;
+			m_currentFrameInFlight = (m_currentFrameInFlight + 1) % m_numFramesInFlight;
 		}
-
-		return true;
 	}
 
-	void SwapChainVK::present()
+	void CommandQueueVK::finish(bool _finishAll)
 	{
-		if (VK_NULL_HANDLE != m_swapchain
-		&&  m_needPresent)
+		if (_finishAll)
 		{
-			VkPresentInfoKHR pi;
-			pi.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-			pi.pNext = NULL;
-			pi.waitSemaphoreCount = 1;
-			pi.pWaitSemaphores    = &m_lastImageRenderedSemaphore;
-			pi.swapchainCount     = 1;
-			pi.pSwapchains        = &m_swapchain;
-			pi.pImageIndices      = &m_backBufferColorIdx;
-			pi.pResults           = NULL;
-			VkResult result = vkQueuePresentKHR(m_queue, &pi);
-
-			switch (result)
+			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 			{
-			case VK_ERROR_SURFACE_LOST_KHR:
-				m_needToRecreateSurface = true;
-				BX_FALLTHROUGH;
-			case VK_ERROR_OUT_OF_DATE_KHR:
-			case VK_SUBOPTIMAL_KHR:
-				m_needToRefreshSwapchain = true;
-				break;
-			default:
-				VK_CHECK(result);
-				break;
+				consume();
 			}
 
-			m_needPresent = false;
-			m_lastImageRenderedSemaphore = VK_NULL_HANDLE;
+			m_consumeIndex = m_currentFrameInFlight;
+		}
+		else
+		{
+			consume();
 		}
 	}
 
-	void SwapChainVK::transitionImage(VkCommandBuffer _commandBuffer, VkImageLayout _newLayout)
+	void CommandQueueVK::release(uint64_t _handle, VkObjectType _type)
 	{
-		VkImageLayout& layout = m_backBufferColorImageLayout[m_backBufferColorIdx];
-		if (_newLayout != layout)
-		{
-			setImageMemoryBarrier(
-				  _commandBuffer
-				, m_backBufferColorImage[m_backBufferColorIdx]
-				, VK_IMAGE_ASPECT_COLOR_BIT
-				, layout
-				, _newLayout
-			);
+		Resource resource;
+		resource.m_type = _type;
+		resource.m_handle = _handle;
+		m_release[m_currentFrameInFlight].push_back(resource);
 
-			layout = _newLayout;
+		// Cached descriptor sets might reference released object.
+		if (VK_OBJECT_TYPE_IMAGE_VIEW == _type
+		||  VK_OBJECT_TYPE_SAMPLER    == _type)
+		{
+			s_renderVK->m_descriptorSetCache.invalidate(_handle);
 		}
 	}
 
-	void FrameBufferVK::create(uint8_t _num, const Attachment* _attachment)
+	void CommandQueueVK::release(const DeviceMemoryAllocationVK& _alloc)
 	{
-		m_numTh = _num;
-		bx::memCopy(m_attachment, _attachment, sizeof(Attachment) * _num);
+		m_releaseDeviceMemory[m_currentFrameInFlight].push_back(_alloc);
+	}
 
-		postReset();
+	void CommandQueueVK::readback(const ReadbackVK& _readback, VkBuffer _buffer, const DeviceMemoryAllocationVK& _alloc, void* _data, uint8_t _mip)
+	{
+		Readback readback;
+		readback.m_readback = _readback;
+		readback.m_buffer   = _buffer;
+		readback.m_alloc    = _alloc;
+		readback.m_data     = _data;
+		readback.m_mip      = _mip;
+		m_readback[m_currentFrameInFlight].push_back(readback);
 	}
 
-	VkResult FrameBufferVK::create(uint16_t _denseIdx, void* _nwh, uint32_t _width, uint32_t _height, TextureFormat::Enum _format, TextureFormat::Enum _depthFormat)
+	void CommandQueueVK::consume()
 	{
-		VkResult result = VK_SUCCESS;
+		m_consumeIndex = (m_consumeIndex + 1) % m_numFramesInFlight;
 
-		Resolution resolution = s_renderVK->m_resolution;
-		resolution.format = TextureFormat::Count == _format ? resolution.format : _format;
-		resolution.width  = _width;
-		resolution.height = _height;
-		if (_denseIdx != UINT16_MAX)
+		for (const Resource& resource : m_release[m_consumeIndex])
 		{
-			resolution.reset &= ~BGFX_RESET_MSAA_MASK;
-		}
-
-		result = m_swapChain.create(s_renderVK->m_commandBuffer, _nwh, resolution, _depthFormat);
+			switch (resource.m_type)
+			{
+			case VK_OBJECT_TYPE_BUFFER:                destroy<VkBuffer             >(resource.m_handle); break;
+			case VK_OBJECT_TYPE_IMAGE_VIEW:            destroy<VkImageView          >(resource.m_handle); break;
+			case VK_OBJECT_TYPE_IMAGE:                 destroy<VkImage              >(resource.m_handle); break;
+			case VK_OBJECT_TYPE_FRAMEBUFFER:           destroy<VkFramebuffer        >(resource.m_handle); break;
+			case VK_OBJECT_TYPE_PIPELINE_LAYOUT:       destroy<VkPipelineLayout     >(resource.m_handle); break;
+			case VK_OBJECT_TYPE_PIPELINE:              destroy<VkPipeline           >(resource.m_handle); break;
+			case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT: destroy<VkDescriptorSetLayout>(resource.m_handle); break;
+			case VK_OBJECT_TYPE_RENDER_PASS:           destroy<VkRenderPass         >(resource.m_handle); break;
+			case VK_OBJECT_TYPE_SAMPLER:               destroy<VkSampler            >(resource.m_handle); break;
+			case VK_OBJECT_TYPE_SEMAPHORE:             destroy<VkSemaphore          >(resource.m_handle); break;
+			case VK_OBJECT_TYPE_SURFACE_KHR:           destroy<VkSurfaceKHR         >(resource.m_handle); break;
+			case VK_OBJECT_TYPE_SWAPCHAIN_KHR:         destroy<VkSwapchainKHR       >(resource.m_handle); break;
+			case VK_OBJECT_TYPE_DEVICE_MEMORY:         destroy<VkDeviceMemory       >(resource.m_handle); break;
 
-		if (VK_SUCCESS != result)
-		{
-			return result;
+			default:
+				BX_ASSERT(false, "Invalid resource type: %d", resource.m_type);
+				break;
+			}
 		}
 
-		result = s_renderVK->getRenderPass(m_swapChain, &m_renderPass);
+		m_release[m_consumeIndex].clear();
 
-		if (VK_SUCCESS != result)
+		s_renderVK->m_descriptorSetCache.consume(m_consumeIndex);
+		s_renderVK->m_bindlessTexture.consume(m_consumeIndex);
+
+		for (Readback& readback : m_readback[m_consumeIndex])
 		{
-			return result;
+			readback.m_readback.readback(readback.m_alloc.m_data, readback.m_data, readback.m_mip);
+
+			vkDestroy(readback.m_buffer);
+			s_renderVK->m_memoryAllocator.free(readback.m_alloc);
 		}
 
-		m_denseIdx = _denseIdx;
-		m_nwh = _nwh;
-		m_width = _width;
-		m_height = _height;
-		m_sampler = m_swapChain.m_sampler;
+		m_readback[m_consumeIndex].clear();
 
-		return result;
-	}
+		s_renderVK->m_stagingRing[m_consumeIndex].reset();
 
-	void FrameBufferVK::preReset()
-	{
-		if (VK_NULL_HANDLE != m_framebuffer)
+		for (uint32_t ii = 0, num = m_numSecondary[m_consumeIndex]; ii < num; ++ii)
 		{
-			s_renderVK->release(m_framebuffer);
+			vkResetCommandPool(s_renderVK->m_device, m_secondaryList[m_consumeIndex][ii].m_commandPool, 0);
+		}
 
-			for (uint8_t ii = 0; ii < m_numTh; ++ii)
-			{
-				s_renderVK->release(m_textureImageViews[ii]);
-			}
+		m_numSecondary[m_consumeIndex] = 0;
 
-			m_depth = BGFX_INVALID_HANDLE;
+		for (uint32_t ii = 0; ii < RendererContextVK::kMaxRecordJobs; ++ii)
+		{
+			s_renderVK->m_recordDescriptor[m_consumeIndex][ii].reset();
 		}
-	}
 
-	void FrameBufferVK::postReset()
-	{
-		if (m_numTh > 0)
+		for (DeviceMemoryAllocationVK& alloc : m_releaseDeviceMemory[m_consumeIndex])
 		{
-			const VkDevice device = s_renderVK->m_device;
-			const VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-
-			VK_CHECK(s_renderVK->getRenderPass(m_numTh, m_attachment, &m_renderPass) );
-
-			m_depth = BGFX_INVALID_HANDLE;
-			m_num = 0;
-
-			for (uint8_t ii = 0; ii < m_numTh; ++ii)
-			{
-				const Attachment& at = m_attachment[ii];
-				const TextureVK& texture = s_renderVK->m_textures[at.handle.idx];
-				VK_CHECK(texture.createView(
-					  at.layer
-					, at.numLayers
-					, at.mip
-					, 1
-					, at.numLayers > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D
-					, true
-					, &m_textureImageViews[ii]
-					) );
-
-				if (texture.m_aspectMask & VK_IMAGE_ASPECT_COLOR_BIT)
-				{
-					m_texture[m_num] = at.handle;
-					m_num++;
-				}
-				else if (texture.m_aspectMask & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) )
-				{
-					m_depth = at.handle;
-				}
-			}
-
-			const TextureVK& firstTexture = s_renderVK->m_textures[m_attachment[0].handle.idx];
-			m_width  = bx::uint32_max(firstTexture.m_width  >> m_attachment[0].mip, 1);
-			m_height = bx::uint32_max(firstTexture.m_height >> m_attachment[0].mip, 1);
-			m_sampler = firstTexture.m_sampler;
-
-			VkFramebufferCreateInfo fci;
-			fci.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-			fci.pNext = NULL;
-			fci.flags = 0;
-			fci.renderPass      = m_renderPass;
-			fci.attachmentCount = m_numTh;
-			fci.pAttachments    = &m_textureImageViews[0];
-			fci.width  = m_width;
-			fci.height = m_height;
-			fci.layers = m_attachment[0].numLayers;
-
-			VK_CHECK(vkCreateFramebuffer(device, &fci, allocatorCb, &m_framebuffer) );
-
-			m_currentFramebuffer = m_framebuffer;
+			s_renderVK->m_memoryAllocator.free(alloc);
 		}
+
+		m_releaseDeviceMemory[m_consumeIndex].clear();
 	}
 
-	void FrameBufferVK::update(VkCommandBuffer _commandBuffer, const Resolution& _resolution)
+	void RecordStateVK::reset()
 	{
-		m_swapChain.update(_commandBuffer, m_nwh, _resolution);
-		VK_CHECK(s_renderVK->getRenderPass(m_swapChain, &m_renderPass) );
-		m_width   = _resolution.width;
-		m_height  = _resolution.height;
-		m_sampler = m_swapChain.m_sampler;
+		m_pipeline      = VK_NULL_HANDLE;
+		m_descriptorSet = VK_NULL_HANDLE;
+		m_numOffsets    = UINT32_MAX;
+		m_bindlessLayout = VK_NULL_HANDLE;
+		m_indexBuffer   = VK_NULL_HANDLE;
+		m_indexType     = VK_INDEX_TYPE_MAX_ENUM;
+		m_stencilRef    = UINT64_MAX;
+		m_blendFactor   = UINT64_MAX;
+		bx::memSet(&m_scissor, 0xff, sizeof(m_scissor) );
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_vertexBuffer); ++ii)
+		{
+			m_vertexBuffer[ii] = VK_NULL_HANDLE;
+			m_vertexOffset[ii] = 0;
+		}
 	}
 
-	void FrameBufferVK::resolve()
+	void RecordStateVK::draw(VkCommandBuffer _commandBuffer, const DrawCommandVK& _draw)
 	{
-		if (NULL == m_nwh)
+		if (m_pipeline != _draw.m_pipeline)
 		{
-			for (uint32_t ii = 0; ii < m_numTh; ++ii)
-			{
-				const Attachment& at = m_attachment[ii];
+			m_pipeline = _draw.m_pipeline;
+			vkCmdBindPipeline(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _draw.m_pipeline);
+		}
 
-				if (isValid(at.handle) )
-				{
-					TextureVK& texture = s_renderVK->m_textures[at.handle.idx];
-					texture.resolve(s_renderVK->m_commandBuffer, at.resolve, at.layer, at.numLayers, at.mip);
-				}
-			}
+		if (m_stencilRef != _draw.m_stencilRef)
+		{
+			m_stencilRef = _draw.m_stencilRef;
+			vkCmdSetStencilReference(_commandBuffer, VK_STENCIL_FRONT_AND_BACK, _draw.m_stencilRef);
 		}
-		else if (isRenderable()
-		&&       m_sampler.Count > 1
-		&&       m_swapChain.m_supportsManualResolve)
+
+		if (m_blendFactor != _draw.m_blendFactor)
 		{
-			m_swapChain.m_backBufferColorMsaa.m_singleMsaaImage = m_swapChain.m_backBufferColorImage[m_swapChain.m_backBufferColorIdx];
-			m_swapChain.m_backBufferColorMsaa.m_currentSingleMsaaImageLayout = m_swapChain.m_backBufferColorImageLayout[m_swapChain.m_backBufferColorIdx];
+			m_blendFactor = _draw.m_blendFactor;
 
-			m_swapChain.m_backBufferColorMsaa.resolve(s_renderVK->m_commandBuffer, 0, 0, 1, 0);
+			float bf[4];
+			bf[0] = ( (_draw.m_blendFactor>>24)     )/255.0f;
+			bf[1] = ( (_draw.m_blendFactor>>16)&0xff)/255.0f;
+			bf[2] = ( (_draw.m_blendFactor>> 8)&0xff)/255.0f;
+			bf[3] = ( (_draw.m_blendFactor    )&0xff)/255.0f;
+			vkCmdSetBlendConstants(_commandBuffer, bf);
+		}
 
-			m_swapChain.m_backBufferColorMsaa.m_singleMsaaImage = VK_NULL_HANDLE;
-			m_swapChain.m_backBufferColorMsaa.m_currentSingleMsaaImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		if (0 != bx::memCmp(&m_scissor, &_draw.m_scissor, sizeof(m_scissor) ) )
+		{
+			m_scissor = _draw.m_scissor;
+			vkCmdSetScissor(_commandBuffer, 0, 1, &_draw.m_scissor);
 		}
-	}
 
-	uint16_t FrameBufferVK::destroy()
-	{
-		preReset();
+		bool setRebound = false;
 
-		if (NULL != m_nwh)
+		// Push writes are only set when they changed.
+		if (0 != _draw.m_numPushWrites)
 		{
-			m_swapChain.destroy();
-			m_nwh = NULL;
-			m_needPresent = false;
+			m_descriptorSet = VK_NULL_HANDLE;
+			setRebound      = true;
+
+			RendererContextVK::pushDescriptorSet(
+				  _commandBuffer
+				, VK_PIPELINE_BIND_POINT_GRAPHICS
+				, _draw.m_pipelineLayout
+				, _draw.m_pushWrite
+				, _draw.m_numPushWrites
+				);
+		}
+
+		if (VK_NULL_HANDLE != _draw.m_descriptorSet
+		&& (m_descriptorSet != _draw.m_descriptorSet
+		||  m_numOffsets    != _draw.m_numOffsets
+		||  0 != bx::memCmp(m_offset, _draw.m_offset, _draw.m_numOffsets*sizeof(uint32_t) ) ) )
+		{
+			m_descriptorSet = _draw.m_descriptorSet;
+			m_numOffsets    = _draw.m_numOffsets;
+			setRebound      = true;
+			bx::memCopy(m_offset, _draw.m_offset, sizeof(m_offset) );
+
+			vkCmdBindDescriptorSets(
+				  _commandBuffer
+				, VK_PIPELINE_BIND_POINT_GRAPHICS
+				, _draw.m_pipelineLayout
+				, 0
+				, 1
+				, &_draw.m_descriptorSet
+				, _draw.m_numOffsets
+				, _draw.m_offset
+				);
 		}
 
-		m_numTh = 0;
-		m_num = 0;
+		// Rebinding set 0 with a different layout disturbs set 1.
+		if (VK_NULL_HANDLE != _draw.m_bindlessSet
+		&& (setRebound
+		||  m_bindlessLayout != _draw.m_pipelineLayout) )
+		{
+			m_bindlessLayout = _draw.m_pipelineLayout;
 
-		uint16_t denseIdx = m_denseIdx;
-		m_denseIdx = UINT16_MAX;
-		return denseIdx;
-	}
+			vkCmdBindDescriptorSets(
+				  _commandBuffer
+				, VK_PIPELINE_BIND_POINT_GRAPHICS
+				, _draw.m_pipelineLayout
+				, 1
+				, 1
+				, &_draw.m_bindlessSet
+				, 0
+				, NULL
+				);
+		}
 
-	bool FrameBufferVK::acquire(VkCommandBuffer _commandBuffer)
-	{
-		if (NULL != m_nwh)
+		for (uint32_t ii = 0; ii < _draw.m_numVertexBuffers; ++ii)
 		{
-			const bool acquired = m_swapChain.acquire(_commandBuffer);
-			m_needPresent = m_swapChain.m_needPresent;
-			m_currentFramebuffer = m_swapChain.m_backBufferFrameBuffer[m_swapChain.m_backBufferColorIdx];
+			if (m_vertexBuffer[ii] != _draw.m_vertexBuffer[ii]
+			||  m_vertexOffset[ii] != _draw.m_vertexOffset[ii])
+			{
+				m_vertexBuffer[ii] = _draw.m_vertexBuffer[ii];
+				m_vertexOffset[ii] = _draw.m_vertexOffset[ii];
 
-			return acquired;
+				vkCmdBindVertexBuffers(
+					  _commandBuffer
+					, ii
+					, 1
+					, &_draw.m_vertexBuffer[ii]
+					, &_draw.m_vertexOffset[ii]
+					);
+			}
 		}
 
-		return true;
+		if (VK_NULL_HANDLE == _draw.m_indexBuffer)
+		{
+			if (VK_NULL_HANDLE != _draw.m_indirectBuffer)
+			{
+				vkCmdDrawIndirect(
+					  _commandBuffer
+					, _draw.m_indirectBuffer
+					, _draw.m_indirectOffset
+					, _draw.m_numIndirect
+					, BGFX_CONFIG_DRAW_INDIRECT_STRIDE
+					);
+			}
+			else
+			{
+				vkCmdDraw(
+					  _commandBuffer
+					, _draw.m_num
+					, _draw.m_numInstances
+					, 0
+					, 0
+					);
+			}
+		}
+		else
+		{
+			if (m_indexBuffer != _draw.m_indexBuffer
+			||  m_indexType   != _draw.m_indexType)
+			{
+				m_indexBuffer = _draw.m_indexBuffer;
+				m_indexType   = _draw.m_indexType;
+
+				vkCmdBindIndexBuffer(
+					  _commandBuffer
+					, _draw.m_indexBuffer
+					, 0
+					, _draw.m_indexType
+					);
+			}
+
+			if (VK_NULL_HANDLE != _draw.m_indirectBuffer)
+			{
+				vkCmdDrawIndexedIndirect(
+					  _commandBuffer
+					, _draw.m_indirectBuffer
+					, _draw.m_indirectOffset
+					, _draw.m_numIndirect
+					, BGFX_CONFIG_DRAW_INDIRECT_STRIDE
+					);
+			}
+			else
+			{
+				vkCmdDrawIndexed(
+					  _commandBuffer
+					, _draw.m_num
+					, _draw.m_numInstances
+					, _draw.m_startIndex
+					, 0
+					, 0
+					);
+			}
+		}
 	}
 
-	void FrameBufferVK::present()
+	struct RecordDrawJob
 	{
-		m_swapChain.present();
-		m_needPresent = false;
-	}
+		Frame*                 m_render;
+		const DrawItemVK*      m_item;
+		ScratchBufferVK*       m_scratchBuffer;
+		DescriptorAllocatorVK* m_descriptorAllocator;
+		VkDescriptorSet        m_bindlessSet;
+		Rect                   m_viewScissorRect;
+		VkViewport             m_viewport;
+		VkCommandBufferInheritanceInfo m_inheritance;
+		VkCommandBuffer m_commandBuffer[RendererContextVK::kMaxRecordJobs];
+		uint32_t m_begin[RendererContextVK::kMaxRecordJobs];
+		uint32_t m_end[RendererContextVK::kMaxRecordJobs];
+
+		uint32_t m_numPrimsSubmitted[RendererContextVK::kMaxRecordJobs][BX_COUNTOF(s_primInfo)];
+		uint32_t m_numPrimsRendered[RendererContextVK::kMaxRecordJobs][BX_COUNTOF(s_primInfo)];
+		uint32_t m_numInstances[RendererContextVK::kMaxRecordJobs][BX_COUNTOF(s_primInfo)];
+		uint32_t m_numIndices[RendererContextVK::kMaxRecordJobs];
+	};
 
-	bool FrameBufferVK::isRenderable() const
+	static void recordDrawJob(void* _userData, uint32_t _idx)
 	{
-		return false
-			|| (NULL == m_nwh)
-			|| m_swapChain.m_needPresent
+		RecordDrawJob& job = *(RecordDrawJob*)_userData;
+		VkCommandBuffer commandBuffer = job.m_commandBuffer[_idx];
+
+		VkCommandBufferBeginInfo cbbi;
+		cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cbbi.pNext = NULL;
+		cbbi.flags = 0
+			| VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+			| VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT
 			;
-	}
+		cbbi.pInheritanceInfo = &job.m_inheritance;
 
-	VkResult CommandQueueVK::init(uint32_t _queueFamily, VkQueue _queue, uint32_t _numFramesInFlight)
-	{
-		m_queueFamily = _queueFamily;
-		m_queue = _queue;
-		m_numFramesInFlight = bx::clamp<uint32_t>(_numFramesInFlight, 1, BGFX_CONFIG_MAX_FRAME_LATENCY);
-		m_activeCommandBuffer = VK_NULL_HANDLE;
+		VK_CHECK(vkBeginCommandBuffer(commandBuffer, &cbbi) );
 
-		return reset();
+		s_renderVK->recordDraws(job, _idx, commandBuffer);
+
+		VK_CHECK(vkEndCommandBuffer(commandBuffer) );
 	}
 
-	VkResult CommandQueueVK::reset()
+	void RendererContextVK::recordDraws(RecordDrawJob& _job, uint32_t _idx, VkCommandBuffer _commandBuffer)
 	{
-		shutdown();
+		const uint64_t f0 = BGFX_STATE_BLEND_FACTOR;
+		const uint64_t f1 = BGFX_STATE_BLEND_INV_FACTOR;
+		const uint64_t f2 = BGFX_STATE_BLEND_FACTOR<<4;
+		const uint64_t f3 = BGFX_STATE_BLEND_INV_FACTOR<<4;
 
-		m_currentFrameInFlight = 0;
-		m_consumeIndex         = 0;
+		const Frame* render = _job.m_render;
+		const Rect& viewScissorRect = _job.m_viewScissorRect;
+		const ScratchBufferVK& scratchBuffer = *_job.m_scratchBuffer;
+		DescriptorAllocatorVK& descriptorAllocator = _job.m_descriptorAllocator[_idx];
 
-		m_numSignalSemaphores = 0;
-		m_numWaitSemaphores   = 0;
+		uint32_t* numPrimsSubmitted = _job.m_numPrimsSubmitted[_idx];
+		uint32_t* numPrimsRendered  = _job.m_numPrimsRendered[_idx];
+		uint32_t* numInstances      = _job.m_numInstances[_idx];
+		bx::memSet(numPrimsSubmitted, 0, sizeof(_job.m_numPrimsSubmitted[_idx]) );
+		bx::memSet(numPrimsRendered,  0, sizeof(_job.m_numPrimsRendered[_idx]) );
+		bx::memSet(numInstances,      0, sizeof(_job.m_numInstances[_idx]) );
+		_job.m_numIndices[_idx] = 0;
 
-		m_activeCommandBuffer = VK_NULL_HANDLE;
-		m_upcomingFence       = VK_NULL_HANDLE;
-		m_kickedFence         = VK_NULL_HANDLE;
+		vkCmdSetViewport(_commandBuffer, 0, 1, &_job.m_viewport);
 
-		VkCommandPoolCreateInfo cpci;
-		cpci.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-		cpci.pNext = NULL;
-		cpci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
-		cpci.queueFamilyIndex = m_queueFamily;
+		const uint32_t begin = _job.m_begin[_idx];
+		const uint32_t end   = _job.m_end[_idx];
 
-		VkCommandBufferAllocateInfo cbai;
-		cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-		cbai.pNext = NULL;
-		cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-		cbai.commandBufferCount = 1;
+		if (begin == end)
+		{
+			return;
+		}
 
-		VkFenceCreateInfo fci;
-		fci.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-		fci.pNext = NULL;
-		fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+		const VkPhysicalDeviceLimits& deviceLimits = m_deviceProperties.limits;
+		const uint32_t align = uint32_t(deviceLimits.minUniformBufferOffsetAlignment);
 
-		VkResult result = VK_SUCCESS;
+		VkRect2D viewScissor;
+		viewScissor.offset.x      = viewScissorRect.m_x;
+		viewScissor.offset.y      = viewScissorRect.m_y;
+		viewScissor.extent.width  = viewScissorRect.m_width;
+		viewScissor.extent.height = viewScissorRect.m_height;
+
+		// Most consecutive draws share pipeline, remember inputs of last lookup so that shared
+		// cache is locked only when they change.
+		struct PipelineKey
+		{
+			uint64_t m_state;
+			uint64_t m_stencil;
+			uint16_t m_layout[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+			uint16_t m_program;
+			uint8_t  m_numStreams;
+			uint8_t  m_numInstanceData;
+		};
 
-		for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
-		{
-			result = vkCreateCommandPool(
-				  s_renderVK->m_device
-				, &cpci
-				, s_renderVK->m_allocatorCb
-				, &m_commandList[ii].m_commandPool
-				);
+		PipelineKey currentPipelineKey;
+		bx::memSet(&currentPipelineKey, 0xff, sizeof(currentPipelineKey) );
+		VkPipeline currentPipeline = VK_NULL_HANDLE;
 
-			if (VK_SUCCESS != result)
-			{
-				BX_TRACE("Create command queue error: vkCreateCommandPool failed %d: %s.", result, getName(result) );
-				return result;
-			}
+		uint32_t currentBindHash         = 0;
+		VkDescriptorSetLayout currentDsl = VK_NULL_HANDLE;
+		uint32_t currentUniform          = UINT32_MAX;
+		uint32_t blendFactor             = 0;
+		VkDescriptorSet currentDescriptorSet = VK_NULL_HANDLE;
+		DescriptorWriteVK descriptorWrite[kMaxDescriptorWrites];
+		uint32_t numDescriptorWrites     = 0;
 
-			cbai.commandPool = m_commandList[ii].m_commandPool;
+		RecordStateVK state;
+		state.reset();
 
-			result = vkAllocateCommandBuffers(
-				  s_renderVK->m_device
-				, &cbai
-				, &m_commandList[ii].m_commandBuffer
-				);
+		for (uint32_t ii = begin; ii < end; ++ii)
+		{
+			const DrawItemVK& item       = _job.m_item[ii];
+			const RenderDraw& draw       = render->m_renderItem[item.m_itemIdx].draw;
+			const RenderBind& renderBind = render->m_renderItemBind[item.m_itemIdx];
+			const uint64_t newFlags      = draw.m_stateFlags;
 
-			if (VK_SUCCESS != result)
-			{
-				BX_TRACE("Create command queue error: vkAllocateCommandBuffers failed %d: %s.", result, getName(result) );
-				return result;
-			}
+			PipelineKey pipelineKey;
+			bx::memSet(&pipelineKey, 0, sizeof(pipelineKey) );
 
-			result = vkCreateFence(
-				  s_renderVK->m_device
-				, &fci
-				, s_renderVK->m_allocatorCb
-				, &m_commandList[ii].m_fence
-				);
+			const VertexLayout* layouts[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+			DrawCommandVK dc;
+			dc.m_numVertexBuffers = 0;
 
-			if (VK_SUCCESS != result)
+			uint32_t numVertices = draw.m_numVertices;
+			if (UINT8_MAX != draw.m_streamMask)
 			{
-				BX_TRACE("Create command queue error: vkCreateFence failed %d: %s.", result, getName(result) );
-				return result;
+				for (uint32_t idx = 0, streamMask = draw.m_streamMask
+					; 0 != streamMask
+					; streamMask >>= 1, idx += 1, ++dc.m_numVertexBuffers
+					)
+				{
+					const uint32_t ntz = bx::uint32_cnttz(streamMask);
+					streamMask >>= ntz;
+					idx         += ntz;
+
+					const VertexBufferVK& vb = m_vertexBuffers[draw.m_stream[idx].m_handle.idx];
+					const uint16_t decl = isValid(draw.m_stream[idx].m_layoutHandle)
+						? draw.m_stream[idx].m_layoutHandle.idx
+						: vb.m_layoutHandle.idx
+						;
+					const VertexLayout& layout = m_vertexLayouts[decl];
+					const uint32_t stride = layout.m_stride;
+
+					dc.m_vertexBuffer[dc.m_numVertexBuffers] = vb.m_buffer;
+					dc.m_vertexOffset[dc.m_numVertexBuffers] = draw.m_stream[idx].m_startVertex * stride;
+					layouts[dc.m_numVertexBuffers] = &layout;
+					pipelineKey.m_layout[dc.m_numVertexBuffers] = decl;
+
+					numVertices = bx::uint32_min(UINT32_MAX == draw.m_numVertices
+						? vb.m_size/stride
+						: draw.m_numVertices
+						, numVertices
+						);
+				}
 			}
-		}
-
-		return result;
-	}
 
-	void CommandQueueVK::shutdown()
-	{
-		kick(true);
-		finish(true);
+			const uint8_t numStreams = uint8_t(dc.m_numVertexBuffers);
 
-		for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
-		{
-			vkDestroy(m_commandList[ii].m_fence);
+			pipelineKey.m_state           = newFlags;
+			pipelineKey.m_stencil         = draw.m_stencil;
+			pipelineKey.m_program         = item.m_program.idx;
+			pipelineKey.m_numStreams      = numStreams;
+			pipelineKey.m_numInstanceData = uint8_t(draw.m_instanceDataStride/16);
 
-			if (VK_NULL_HANDLE != m_commandList[ii].m_commandBuffer)
+			if (0 != bx::memCmp(&currentPipelineKey, &pipelineKey, sizeof(pipelineKey) ) )
 			{
-				vkFreeCommandBuffers(s_renderVK->m_device, m_commandList[ii].m_commandPool, 1, &m_commandList[ii].m_commandBuffer);
-				m_commandList[ii].m_commandBuffer = VK_NULL_HANDLE;
+				currentPipelineKey = pipelineKey;
+
+				bx::MutexScope lock(m_cacheMutex);
+				currentPipeline = getPipeline(newFlags
+					, draw.m_stencil
+					, numStreams
+					, layouts
+					, item.m_program
+					, pipelineKey.m_numInstanceData
+					, m_fbh
+					, true
+					);
 			}
 
-			vkDestroy(m_commandList[ii].m_commandPool);
-		}
-	}
+			if (VK_NULL_HANDLE == currentPipeline)
+			{
+				// Pipeline is still being compiled in background, skip draw.
+				continue;
+			}
 
-	VkResult CommandQueueVK::alloc(VkCommandBuffer* _commandBuffer)
-	{
-		VkResult result = VK_SUCCESS;
+			dc.m_pipeline = currentPipeline;
 
-		if (m_activeCommandBuffer == VK_NULL_HANDLE)
-		{
-			CommandList& commandList = m_commandList[m_currentFrameInFlight];
+			const uint32_t fstencil = unpackStencil(0, draw.m_stencil);
+			dc.m_stencilRef = (fstencil&BGFX_STENCIL_FUNC_REF_MASK)>>BGFX_STENCIL_FUNC_REF_SHIFT;
 
-			result = vkWaitForFences(s_renderVK->m_device, 1, &commandList.m_fence, VK_TRUE, UINT64_MAX);
+			const bool hasFactor = 0
+				|| f0 == (newFlags & f0)
+				|| f1 == (newFlags & f1)
+				|| f2 == (newFlags & f2)
+				|| f3 == (newFlags & f3)
+				;
 
-			if (VK_SUCCESS != result)
+			if (hasFactor)
 			{
-				BX_TRACE("Allocate command buffer error: vkWaitForFences failed %d: %s.", result, getName(result) );
-				return result;
+				blendFactor = draw.m_rgba;
 			}
 
-			result = vkResetCommandPool(s_renderVK->m_device, commandList.m_commandPool, 0);
+			dc.m_blendFactor = blendFactor;
 
-			if (VK_SUCCESS != result)
+			if (UINT16_MAX == draw.m_scissor)
 			{
-				BX_TRACE("Allocate command buffer error: vkResetCommandPool failed %d: %s.", result, getName(result) );
-				return result;
+				dc.m_scissor = viewScissor;
 			}
-
-			VkCommandBufferBeginInfo cbi;
-			cbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-			cbi.pNext = NULL;
-			cbi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-			cbi.pInheritanceInfo = NULL;
-
-			result = vkBeginCommandBuffer(commandList.m_commandBuffer, &cbi);
-
-			if (VK_SUCCESS != result)
+			else
 			{
-				BX_TRACE("Allocate command buffer error: vkBeginCommandBuffer failed %d: %s.", result, getName(result) );
-				return result;
+				Rect scissorRect;
+				scissorRect.setIntersect(viewScissorRect, render->m_frameCache.m_rectCache.m_cache[draw.m_scissor]);
+
+				dc.m_scissor.offset.x      = scissorRect.m_x;
+				dc.m_scissor.offset.y      = scissorRect.m_y;
+				dc.m_scissor.extent.width  = scissorRect.m_width;
+				dc.m_scissor.extent.height = scissorRect.m_height;
 			}
 
-			m_activeCommandBuffer = commandList.m_commandBuffer;
-			m_upcomingFence = commandList.m_fence;
-		}
+			const ProgramVK& program = m_program[item.m_program.idx];
 
-		if (NULL != _commandBuffer)
-		{
-			*_commandBuffer = m_activeCommandBuffer;
-		}
+			dc.m_descriptorSet  = VK_NULL_HANDLE;
+			dc.m_pushWrite      = NULL;
+			dc.m_numPushWrites  = 0;
+			dc.m_numOffsets     = 0;
+			dc.m_pipelineLayout = program.m_pipelineLayout;
+			dc.m_bindlessSet    = program.m_bindless ? _job.m_bindlessSet : VK_NULL_HANDLE;
 
-		return result;
-	}
+			if (VK_NULL_HANDLE != program.m_descriptorSetLayout)
+			{
+				const bool bindChanged = false
+					|| currentBindHash != item.m_bindHash
+					|| currentDsl      != program.m_descriptorSetLayout
+					;
 
-	void CommandQueueVK::addWaitSemaphore(VkSemaphore _semaphore, VkPipelineStageFlags _waitFlags)
-	{
-		BX_ASSERT(m_numWaitSemaphores < BX_COUNTOF(m_waitSemaphores), "Too many wait semaphores.");
+				if (bindChanged)
+				{
+					currentBindHash = item.m_bindHash;
+					currentDsl      = program.m_descriptorSetLayout;
 
-		m_waitSemaphores[m_numWaitSemaphores]      = _semaphore;
-		m_waitSemaphoreStages[m_numWaitSemaphores] = _waitFlags;
-		m_numWaitSemaphores++;
-	}
+					// Image layouts were set while gathering draws.
+					bx::MutexScope lock(m_cacheMutex);
+					numDescriptorWrites = getDescriptorWrites(descriptorWrite, program, renderBind, false);
+				}
 
-	void CommandQueueVK::addSignalSemaphore(VkSemaphore _semaphore)
-	{
-		BX_ASSERT(m_numSignalSemaphores < BX_COUNTOF(m_signalSemaphores), "Too many signal semaphores.");
+				const uint32_t vsize = program.m_vsh->m_size;
+				const uint32_t fsize = NULL != program.m_fsh ? program.m_fsh->m_size : 0;
+				const uint32_t offset = item.m_uniform;
 
-		m_signalSemaphores[m_numSignalSemaphores] = _semaphore;
-		m_numSignalSemaphores++;
-	}
+				uint32_t offsets[2] = { 0, 0 };
+				uint32_t numOffsets = 0;
 
-	void CommandQueueVK::kick(bool _wait)
-	{
-		if (VK_NULL_HANDLE != m_activeCommandBuffer)
-		{
-			setMemoryBarrier(
-				  m_activeCommandBuffer
-				, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
-				, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
-				);
+				if (vsize > 0)
+				{
+					offsets[numOffsets++] = offset;
+				}
 
-			VK_CHECK(vkEndCommandBuffer(m_activeCommandBuffer) );
+				if (fsize > 0)
+				{
+					offsets[numOffsets++] = offset + bx::strideAlign(vsize, align);
+				}
 
-			m_kickedFence = m_upcomingFence;
-			m_upcomingFence = VK_NULL_HANDLE;
+				if (program.m_pushDescriptor)
+				{
+					if (bindChanged
+					||  currentUniform != item.m_uniform)
+					{
+						dc.m_pushWrite     = descriptorWrite;
+						dc.m_numPushWrites = numDescriptorWrites
+							+ getUniformWrites(&descriptorWrite[numDescriptorWrites], program, scratchBuffer, offsets)
+							;
+					}
+				}
+				else
+				{
+					if (bindChanged)
+					{
+						const uint32_t numWrites = numDescriptorWrites
+							+ getUniformWrites(&descriptorWrite[numDescriptorWrites], program, scratchBuffer, NULL)
+							;
 
-			VK_CHECK(vkResetFences(s_renderVK->m_device, 1, &m_kickedFence) );
+						// Sets are shared with render thread and other jobs through descriptor set
+						// cache, job's own allocator is used only when set can't be cached.
+						bx::MutexScope lock(m_cacheMutex);
+						currentDescriptorSet = getDescriptorSet(program, descriptorWrite, numWrites, &descriptorAllocator);
+					}
 
-			VkSubmitInfo si;
-			si.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-			si.pNext = NULL;
-			si.waitSemaphoreCount    = m_numWaitSemaphores;
-			si.pWaitSemaphores       = &m_waitSemaphores[0];
-			si.pWaitDstStageMask     = m_waitSemaphoreStages;
-			si.commandBufferCount    = 1;
-			si.pCommandBuffers       = &m_activeCommandBuffer;
-			si.signalSemaphoreCount  = m_numSignalSemaphores;
-			si.pSignalSemaphores     = &m_signalSemaphores[0];
+					if (VK_NULL_HANDLE == currentDescriptorSet)
+					{
+						continue;
+					}
 
-			m_numWaitSemaphores   = 0;
-			m_numSignalSemaphores = 0;
+					dc.m_descriptorSet = currentDescriptorSet;
+					dc.m_numOffsets    = numOffsets;
+					dc.m_offset[0]     = offsets[0];
+					dc.m_offset[1]     = offsets[1];
+				}
 
-			VK_CHECK(vkQueueSubmit(m_queue, 1, &si, m_kickedFence) );
+				currentUniform = item.m_uniform;
+			}
 
-			if (_wait)
+			if (isValid(draw.m_instanceDataBuffer) )
 			{
-				VK_CHECK(vkWaitForFences(s_renderVK->m_device, 1, &m_kickedFence, VK_TRUE, UINT64_MAX) );
+				dc.m_vertexBuffer[dc.m_numVertexBuffers] = m_vertexBuffers[draw.m_instanceDataBuffer.idx].m_buffer;
+				dc.m_vertexOffset[dc.m_numVertexBuffers] = draw.m_instanceDataOffset;
+				++dc.m_numVertexBuffers;
 			}
 
-			m_activeCommandBuffer = VK_NULL_HANDLE;
+			dc.m_indirectBuffer = VK_NULL_HANDLE;
+			dc.m_indirectOffset = 0;
+			dc.m_numIndirect    = 0;
+			if (isValid(draw.m_indirectBuffer) )
+			{
+				const VertexBufferVK& vb = m_vertexBuffers[draw.m_indirectBuffer.idx];
+				dc.m_indirectBuffer = vb.m_buffer;
+				dc.m_numIndirect    = UINT16_MAX == draw.m_numIndirect
+					? vb.m_size / BGFX_CONFIG_DRAW_INDIRECT_STRIDE
+					: draw.m_numIndirect
+					;
+				dc.m_indirectOffset = draw.m_startIndirect * BGFX_CONFIG_DRAW_INDIRECT_STRIDE;
+			}
 
-			m_currentFrameInFlight = (m_currentFrameInFlight + 1) % m_numFramesInFlight;
-		}
-	}
+			uint32_t numIndices = 0;
+			dc.m_numInstances = draw.m_numInstances;
+			dc.m_startIndex   = draw.m_startIndex;
 
-	void CommandQueueVK::finish(bool _finishAll)
-	{
-		if (_finishAll)
-		{
-			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+			if (!isValid(draw.m_indexBuffer) )
 			{
-				consume();
+				dc.m_indexBuffer = VK_NULL_HANDLE;
+				dc.m_indexType   = VK_INDEX_TYPE_UINT16;
+				dc.m_num         = numVertices;
 			}
+			else
+			{
+				const bool isIndex16     = draw.isIndex16();
+				const uint32_t indexSize = isIndex16 ? 2 : 4;
+				const BufferVK& ib       = m_indexBuffers[draw.m_indexBuffer.idx];
 
-			m_consumeIndex = m_currentFrameInFlight;
-		}
-		else
-		{
-			consume();
-		}
-	}
+				numIndices = UINT32_MAX == draw.m_numIndices
+					? ib.m_size / indexSize
+					: draw.m_numIndices
+					;
 
-	void CommandQueueVK::release(uint64_t _handle, VkObjectType _type)
-	{
-		Resource resource;
-		resource.m_type = _type;
-		resource.m_handle = _handle;
-		m_release[m_currentFrameInFlight].push_back(resource);
-	}
+				dc.m_indexBuffer = ib.m_buffer;
+				dc.m_indexType   = isIndex16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+				dc.m_num         = numIndices;
+			}
 
-	void CommandQueueVK::consume()
-	{
-		m_consumeIndex = (m_consumeIndex + 1) % m_numFramesInFlight;
+			state.draw(_commandBuffer, dc);
 
-		for (const Resource& resource : m_release[m_consumeIndex])
-		{
-			switch (resource.m_type)
-			{
-			case VK_OBJECT_TYPE_BUFFER:                destroy<VkBuffer             >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_IMAGE_VIEW:            destroy<VkImageView          >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_IMAGE:                 destroy<VkImage              >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_FRAMEBUFFER:           destroy<VkFramebuffer        >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_PIPELINE_LAYOUT:       destroy<VkPipelineLayout     >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_PIPELINE:              destroy<VkPipeline           >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT: destroy<VkDescriptorSetLayout>(resource.m_handle); break;
-			case VK_OBJECT_TYPE_RENDER_PASS:           destroy<VkRenderPass         >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_SAMPLER:               destroy<VkSampler            >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_SEMAPHORE:             destroy<VkSemaphore          >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_SURFACE_KHR:           destroy<VkSurfaceKHR         >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_SWAPCHAIN_KHR:         destroy<VkSwapchainKHR       >(resource.m_handle); break;
-			case VK_OBJECT_TYPE_DEVICE_MEMORY:         destroy<VkDeviceMemory       >(resource.m_handle); break;
+			const uint8_t primIndex = uint8_t( (newFlags&BGFX_STATE_PT_MASK) >> BGFX_STATE_PT_SHIFT);
+			const PrimInfo& prim = s_primInfo[primIndex];
 
-			default:
-				BX_ASSERT(false, "Invalid resource type: %d", resource.m_type);
-				break;
-			}
-		}
+			const uint32_t numPrims = numIndices / prim.m_div - prim.m_sub;
 
-		m_release[m_consumeIndex].clear();
+			numPrimsSubmitted[primIndex] += numPrims;
+			numPrimsRendered[primIndex]  += numPrims*draw.m_numInstances;
+			numInstances[primIndex]      += draw.m_numInstances;
+			_job.m_numIndices[_idx]      += numIndices;
+		}
 	}
 
 	void RendererContextVK::submitBlit(BlitState& _bs, uint16_t _view)
@@ -7544,6 +9928,213 @@ VK_DESTROY
 		}
 	}
 
+	void RendererContextVK::submitDrawsParallel(
+		  Frame* _render
+		, ViewState& _viewState
+		, uint16_t _view
+		, int32_t _begin
+		, int32_t _end
+		, const VkRenderPassBeginInfo& _rpbi
+		, const Rect& _viewScissorRect
+		, ScratchBufferVK& _scratchBuffer
+		, uint32_t* _numPrimsSubmitted
+		, uint32_t* _numPrimsRendered
+		, uint32_t* _numInstances
+		, uint32_t& _numIndices
+		)
+	{
+		// Only what has to be evaluated in submission order is done here on render thread:
+		// uniform values carry over between draws, constants are uploaded as they change, and
+		// image layout transitions must be recorded into primary command buffer. Pipelines,
+		// descriptor sets and command recording are done by record jobs.
+		ProgramHandle currentProgram     = BGFX_INVALID_HANDLE;
+		uint32_t currentBindHash         = 0;
+		VkDescriptorSetLayout currentDsl = VK_NULL_HANDLE;
+		bool     hasPredefined           = false;
+		uint64_t currentStateFlags       = BGFX_STATE_NONE;
+		uint32_t uniform                 = 0;
+
+		m_drawItem.clear();
+		m_drawItem.reserve(_end - _begin);
+
+		for (int32_t item = _begin; item < _end; ++item)
+		{
+			SortKey key;
+			key.decode(_render->m_sortKeys[item], _render->m_viewRemap);
+
+			const uint32_t itemIdx       = _render->m_sortValues[item];
+			const RenderDraw& draw       = _render->m_renderItem[itemIdx].draw;
+			const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+
+			if (_render->m_frameCache.isZeroArea(_viewScissorRect, draw.m_scissor) )
+			{
+				continue;
+			}
+
+			const uint64_t newFlags     = draw.m_stateFlags;
+			const uint64_t changedFlags = item == _begin ? BGFX_STATE_MASK : currentStateFlags ^ newFlags;
+			currentStateFlags = newFlags;
+
+			const bool uniformsChanged = rendererUpdateUniforms(this, _render, draw);
+
+			if (0 == draw.m_streamMask)
+			{
+				continue;
+			}
+
+			bool constantsChanged = false;
+			if (uniformsChanged
+			||  currentProgram.idx != key.m_program.idx
+			||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
+			{
+				currentProgram = key.m_program;
+				ProgramVK& program = m_program[currentProgram.idx];
+
+				UniformBuffer* vcb = program.m_vsh->m_constantBuffer;
+				if (NULL != vcb)
+				{
+					commit(*vcb);
+				}
+
+				if (NULL != program.m_fsh)
+				{
+					UniformBuffer* fcb = program.m_fsh->m_constantBuffer;
+					if (NULL != fcb)
+					{
+						commit(*fcb);
+					}
+				}
+
+				hasPredefined = 0 < program.m_numPredefined;
+				constantsChanged = true;
+			}
+
+			const ProgramVK& program = m_program[currentProgram.idx];
+
+			if (hasPredefined)
+			{
+				uint32_t ref = (newFlags & BGFX_STATE_ALPHA_REF_MASK) >> BGFX_STATE_ALPHA_REF_SHIFT;
+				_viewState.m_alphaRef = ref / 255.0f;
+				_viewState.setPredefined<4>(this, _view, program, _render, draw);
+			}
+
+			DrawItemVK di;
+			di.m_itemIdx  = itemIdx;
+			di.m_bindHash = 0;
+			di.m_program  = currentProgram;
+
+			if (VK_NULL_HANDLE != program.m_descriptorSetLayout)
+			{
+				di.m_bindHash = bx::hash<bx::HashMurmur2A>(renderBind.m_bind, sizeof(renderBind.m_bind) );
+
+				if (currentBindHash != di.m_bindHash
+				||  currentDsl      != program.m_descriptorSetLayout)
+				{
+					currentBindHash = di.m_bindHash;
+					currentDsl      = program.m_descriptorSetLayout;
+
+					setBindImageLayouts(program, renderBind);
+				}
+
+				if (constantsChanged
+				||  hasPredefined)
+				{
+					uniform = writeConstants(_scratchBuffer, program, draw, hasPredefined);
+				}
+			}
+
+			di.m_uniform = uniform;
+			m_drawItem.push_back(di);
+		}
+
+		const Rect& rect = _render->m_view[_view].m_rect;
+
+		RecordDrawJob job;
+		job.m_render              = _render;
+		job.m_item                = m_drawItem.data();
+		job.m_scratchBuffer       = &_scratchBuffer;
+		job.m_descriptorAllocator = m_recordDescriptor[m_cmd.m_currentFrameInFlight];
+		job.m_viewScissorRect     = _viewScissorRect;
+		job.m_bindlessSet         = m_bindlessSupport
+			? m_bindlessTexture.get(m_cmd.m_currentFrameInFlight)
+			: VK_NULL_HANDLE
+			;
+
+		job.m_viewport.x        =  float(rect.m_x);
+		job.m_viewport.y        =  float(rect.m_y + rect.m_height);
+		job.m_viewport.width    =  float(rect.m_width);
+		job.m_viewport.height   = -float(rect.m_height);
+		job.m_viewport.minDepth = 0.0f;
+		job.m_viewport.maxDepth = 1.0f;
+
+		job.m_inheritance.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		job.m_inheritance.pNext                = NULL;
+		job.m_inheritance.renderPass           = _rpbi.renderPass;
+		job.m_inheritance.subpass              = 0;
+		job.m_inheritance.framebuffer          = _rpbi.framebuffer;
+		job.m_inheritance.occlusionQueryEnable = VK_FALSE;
+		job.m_inheritance.queryFlags           = 0;
+		job.m_inheritance.pipelineStatistics   = 0;
+
+		JobPool& jobPool = rendererGetJobPool();
+
+		const uint32_t numDraws = uint32_t(m_drawItem.size() );
+		const uint32_t maxJobs  = bx::min<uint32_t>(
+			  jobPool.getNumThreads() + 1
+			, bx::max<uint32_t>(1, numDraws / BGFX_CONFIG_SECONDARY_COMMAND_BUFFER_MIN_DRAWS)
+			);
+
+		uint32_t numJobs = 0;
+		for (; numJobs < maxJobs; ++numJobs)
+		{
+			job.m_commandBuffer[numJobs] = m_cmd.allocSecondary();
+
+			if (VK_NULL_HANDLE == job.m_commandBuffer[numJobs])
+			{
+				break;
+			}
+		}
+
+		// Out of secondary command buffers this frame, whole range is recorded on render thread.
+		const uint32_t numRanges = bx::max<uint32_t>(1, numJobs);
+
+		for (uint32_t ii = 0; ii < numRanges; ++ii)
+		{
+			const uint32_t begin = uint32_t(uint64_t(numDraws) *  ii    / numRanges);
+			const uint32_t end   = uint32_t(uint64_t(numDraws) * (ii+1) / numRanges);
+
+			job.m_begin[ii] = begin;
+			job.m_end[ii]   = end;
+		}
+
+		if (0 == numJobs)
+		{
+			vkCmdBeginRenderPass(m_commandBuffer, &_rpbi, VK_SUBPASS_CONTENTS_INLINE);
+			recordDraws(job, 0, m_commandBuffer);
+			vkCmdEndRenderPass(m_commandBuffer);
+		}
+		else
+		{
+			jobPool.run(recordDrawJob, &job, numJobs);
+
+			vkCmdBeginRenderPass(m_commandBuffer, &_rpbi, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+			vkCmdExecuteCommands(m_commandBuffer, numJobs, &job.m_commandBuffer[0]);
+			vkCmdEndRenderPass(m_commandBuffer);
+		}
+
+		for (uint32_t ii = 0; ii < numRanges; ++ii)
+		{
+			for (uint32_t jj = 0; jj < BX_COUNTOF(s_primInfo); ++jj)
+			{
+				_numPrimsSubmitted[jj] += job.m_numPrimsSubmitted[ii][jj];
+				_numPrimsRendered[jj]  += job.m_numPrimsRendered[ii][jj];
+				_numInstances[jj]      += job.m_numInstances[ii][jj];
+			}
+
+			_numIndices += job.m_numIndices[ii];
+		}
+	}
+
 	void RendererContextVK::submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter)
 	{
 		BX_UNUSED(_clearQuad);
@@ -7553,6 +10144,8 @@ VK_DESTROY
 			return;
 		}
 
+		finishPipelines(false);
+
 		BGFX_VK_PROFILER_BEGIN_LITERAL("rendererSubmit", kColorView);
 
 		int64_t timeBegin = bx::getHPCounter();
@@ -7574,6 +10167,8 @@ VK_DESTROY
 			m_vertexBuffers[vb->handle.idx].update(m_commandBuffer, 0, _render->m_vboffset, vb->data);
 		}
 
+		flushCopyBuffers();
+
 		_render->sort();
 
 		RenderDraw currentState;
@@ -7591,8 +10186,12 @@ VK_DESTROY
 		ProgramHandle currentProgram     = BGFX_INVALID_HANDLE;
 		uint32_t currentBindHash         = 0;
 		VkDescriptorSetLayout currentDsl = VK_NULL_HANDLE;
+		bool     bindlessBound           = false;
 		bool     hasPredefined           = false;
 		bool     commandListChanged      = false;
+		VkDescriptorSet currentDescriptorSet = VK_NULL_HANDLE;
+		DescriptorWriteVK descriptorWrite[kMaxDescriptorWrites];
+		uint32_t numDescriptorWrites     = 0;
 		VkPipeline currentPipeline = VK_NULL_HANDLE;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
@@ -7627,6 +10226,17 @@ VK_DESTROY
 
 		ScratchBufferVK& scratchBuffer = m_scratchBuffer[m_cmd.m_currentFrameInFlight];
 		scratchBuffer.reset();
+		m_uniformCache.reset();
+
+		const VkPhysicalDeviceLimits& deviceLimits = m_deviceProperties.limits;
+		const uint32_t align = uint32_t(deviceLimits.minUniformBufferOffsetAlignment);
+
+		m_descriptorSetCache.update();
+
+		const VkDescriptorSet bindlessSet = m_bindlessSupport
+			? m_bindlessTexture.get(m_cmd.m_currentFrameInFlight)
+			: VK_NULL_HANDLE
+			;
 
 		setMemoryBarrier(
 			  m_commandBuffer
@@ -7765,6 +10375,43 @@ VK_DESTROY
 
 						submitBlit(bs, view);
 
+						if (0 < rendererGetJobPool().getNumThreads() )
+						{
+							const ViewId viewId = SortKey::decodeView(encodedKey);
+
+							bool viewHasCompute = false;
+							int32_t viewEnd = item;
+							for (; viewEnd < numItems && viewId == SortKey::decodeView(_render->m_sortKeys[viewEnd]); ++viewEnd)
+							{
+								viewHasCompute |= 0 == (_render->m_sortKeys[viewEnd] & kSortKeyDrawBit);
+							}
+
+							if (!viewHasCompute
+							&&  viewEnd - (item-1) >= 2*BGFX_CONFIG_SECONDARY_COMMAND_BUFFER_MIN_DRAWS)
+							{
+								statsKeyType[0] += viewEnd - item;
+								wasCompute = false;
+
+								submitDrawsParallel(
+									  _render
+									, viewState
+									, view
+									, item-1
+									, viewEnd
+									, rpbi
+									, viewScissorRect
+									, scratchBuffer
+									, statsNumPrimsSubmitted
+									, statsNumPrimsRendered
+									, statsNumInstances
+									, statsNumIndices
+									);
+
+								item = viewEnd;
+								continue;
+							}
+						}
+
 						vkCmdBeginRenderPass(m_commandBuffer, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
 						beginRenderPass = true;
 					}
@@ -7825,21 +10472,33 @@ VK_DESTROY
 					if (VK_NULL_HANDLE != program.m_descriptorSetLayout)
 					{
 						uint32_t bindHash = bx::hash<bx::HashMurmur2A>(renderBind.m_bind, sizeof(renderBind.m_bind) );
+						const bool bindChanged = false
+							|| currentBindHash != bindHash
+							|| currentDsl      != program.m_descriptorSetLayout
+							;
 
-						if (currentBindHash != bindHash
-						||  currentDsl      != program.m_descriptorSetLayout)
+						if (bindChanged)
 						{
 							currentBindHash = bindHash;
 							currentDsl      = program.m_descriptorSetLayout;
 
-							allocDescriptorSet(program, renderBind, scratchBuffer);
+							numDescriptorWrites = getDescriptorWrites(descriptorWrite, program, renderBind);
+
+							if (!program.m_pushDescriptor)
+							{
+								const uint32_t numWrites = numDescriptorWrites
+									+ getUniformWrites(&descriptorWrite[numDescriptorWrites], program, scratchBuffer, NULL)
+									;
+								currentDescriptorSet = getDescriptorSet(program, descriptorWrite, numWrites);
+							}
 						}
 
 						uint32_t numOffset = 0;
 						uint32_t offset = 0;
 
 						if (constantsChanged
-						||  hasPredefined)
+						||  hasPredefined
+						||  bindChanged)
 						{
 							const uint32_t vsize = program.m_vsh->m_size;
 							if (vsize > 0)
@@ -7849,16 +10508,50 @@ VK_DESTROY
 							}
 						}
 
-						vkCmdBindDescriptorSets(
-							  m_commandBuffer
-							, VK_PIPELINE_BIND_POINT_COMPUTE
-							, program.m_pipelineLayout
-							, 0
-							, 1
-							, &scratchBuffer.getCurrentDS()
-							, numOffset
-							, &offset
-							);
+						if (program.m_pushDescriptor)
+						{
+							if (bindChanged
+							||  0 < numOffset)
+							{
+								const uint32_t numWrites = numDescriptorWrites
+									+ getUniformWrites(&descriptorWrite[numDescriptorWrites], program, scratchBuffer, &offset)
+									;
+								pushDescriptorSet(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, program.m_pipelineLayout, descriptorWrite, numWrites);
+							}
+						}
+						else if (bindChanged
+						     ||  0 < numOffset)
+						{
+							vkCmdBindDescriptorSets(
+								  m_commandBuffer
+								, VK_PIPELINE_BIND_POINT_COMPUTE
+								, program.m_pipelineLayout
+								, 0
+								, 1
+								, &currentDescriptorSet
+								, numOffset
+								, &offset
+								);
+						}
+
+						// Rebinding set 0 with a different layout disturbs set 1.
+						bindlessBound &= !(bindChanged || 0 < numOffset);
+
+						if (program.m_bindless
+						&&  !bindlessBound)
+						{
+							bindlessBound = true;
+							vkCmdBindDescriptorSets(
+								  m_commandBuffer
+								, VK_PIPELINE_BIND_POINT_COMPUTE
+								, program.m_pipelineLayout
+								, 1
+								, 1
+								, &bindlessSet
+								, 0
+								, NULL
+								);
+						}
 					}
 
 					if (isValid(compute.m_indirectBuffer) )
@@ -7960,7 +10653,7 @@ VK_DESTROY
 					primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
 				}
 
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				const bool uniformsChanged = rendererUpdateUniforms(this, _render, draw);
 
 				if (0 != draw.m_streamMask)
 				{
@@ -8022,8 +10715,18 @@ VK_DESTROY
 							, layouts
 							, key.m_program
 							, uint8_t(draw.m_instanceDataStride/16)
+							, m_fbh
+							, true
 							);
 
+					if (VK_NULL_HANDLE == pipeline)
+					{
+						// Pipeline is still being compiled in background, skip draw and
+						// force state to be reapplied on next draw.
+						commandListChanged = true;
+						continue;
+					}
+
 					if (pipeline != currentPipeline
 					||  0 != changedStencil)
 					{
@@ -8095,7 +10798,7 @@ VK_DESTROY
 					}
 
 					bool constantsChanged = false;
-					if (draw.m_uniformBegin < draw.m_uniformEnd
+					if (uniformsChanged
 					||  currentProgram.idx != key.m_program.idx
 					||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
 					{
@@ -8133,45 +10836,93 @@ VK_DESTROY
 					if (VK_NULL_HANDLE != program.m_descriptorSetLayout)
 					{
 						uint32_t bindHash = bx::hash<bx::HashMurmur2A>(renderBind.m_bind, sizeof(renderBind.m_bind) );
-						if (currentBindHash != bindHash
-						||  currentDsl      != program.m_descriptorSetLayout)
+						const bool bindChanged = false
+							|| currentBindHash != bindHash
+							|| currentDsl      != program.m_descriptorSetLayout
+							;
+
+						if (bindChanged)
 						{
 							currentBindHash = bindHash;
 							currentDsl      = program.m_descriptorSetLayout;
 
-							allocDescriptorSet(program, renderBind, scratchBuffer);
+							numDescriptorWrites = getDescriptorWrites(descriptorWrite, program, renderBind);
+
+							if (!program.m_pushDescriptor)
+							{
+								const uint32_t numWrites = numDescriptorWrites
+									+ getUniformWrites(&descriptorWrite[numDescriptorWrites], program, scratchBuffer, NULL)
+									;
+								currentDescriptorSet = getDescriptorSet(program, descriptorWrite, numWrites);
+							}
 						}
 
 						uint32_t numOffset = 0;
 						uint32_t offsets[2] = { 0, 0 };
 
 						if (constantsChanged
-						||  hasPredefined)
+						||  hasPredefined
+						||  bindChanged)
 						{
 							const uint32_t vsize = program.m_vsh->m_size;
 							const uint32_t fsize = NULL != program.m_fsh ? program.m_fsh->m_size : 0;
+							const uint32_t offset = writeConstants(scratchBuffer, program, draw, hasPredefined);
 
 							if (vsize > 0)
 							{
-								offsets[numOffset++] = scratchBuffer.write(m_vsScratch, vsize);
+								offsets[numOffset++] = offset;
 							}
 
 							if (fsize > 0)
 							{
-								offsets[numOffset++] = scratchBuffer.write(m_fsScratch, fsize);
+								offsets[numOffset++] = offset + bx::strideAlign(vsize, align);
 							}
 						}
 
-						vkCmdBindDescriptorSets(
-							  m_commandBuffer
-							, VK_PIPELINE_BIND_POINT_GRAPHICS
-							, program.m_pipelineLayout
-							, 0
-							, 1
-							, &scratchBuffer.getCurrentDS()
-							, numOffset
-							, offsets
-							);
+						if (program.m_pushDescriptor)
+						{
+							if (bindChanged
+							||  0 < numOffset)
+							{
+								const uint32_t numWrites = numDescriptorWrites
+									+ getUniformWrites(&descriptorWrite[numDescriptorWrites], program, scratchBuffer, offsets)
+									;
+								pushDescriptorSet(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, program.m_pipelineLayout, descriptorWrite, numWrites);
+							}
+						}
+						else if (bindChanged
+						     ||  0 < numOffset)
+						{
+							vkCmdBindDescriptorSets(
+								  m_commandBuffer
+								, VK_PIPELINE_BIND_POINT_GRAPHICS
+								, program.m_pipelineLayout
+								, 0
+								, 1
+								, &currentDescriptorSet
+								, numOffset
+								, offsets
+								);
+						}
+
+						// Rebinding set 0 with a different layout disturbs set 1.
+						bindlessBound &= !(bindChanged || 0 < numOffset);
+
+						if (program.m_bindless
+						&&  !bindlessBound)
+						{
+							bindlessBound = true;
+							vkCmdBindDescriptorSets(
+								  m_commandBuffer
+								, VK_PIPELINE_BIND_POINT_GRAPHICS
+								, program.m_pipelineLayout
+								, 1
+								, 1
+								, &bindlessSet
+								, 0
+								, NULL
+								);
+						}
 					}
 
 					uint32_t numIndices = 0;
@@ -8382,6 +11133,11 @@ VK_DESTROY
 				}
 			}
 		}
+		else
+		{
+			gpuMemoryAvailable = int64_t(m_memoryAllocator.getDeviceLocalSize() );
+			gpuMemoryUsed      = int64_t(m_memoryAllocator.getDeviceLocalAllocated() );
+		}
 
 		Stats& perfStats = _render->m_perfStats;
 		perfStats.cpuTimeBegin  = timeBegin;
@@ -8509,7 +11265,22 @@ VK_DESTROY
 				tvm.printf(10, pos++, 0x8b, " %6d | %6d | %6d "
 					, m_pipelineStateCache.getCount()
 					, m_descriptorSetLayoutCache.getCount()
-					, scratchBuffer.m_currentDs
+					, m_descriptorSetCache.getCount()
+					);
+
+				const uint32_t numLookups = m_descriptorSetCache.m_hits + m_descriptorSetCache.m_misses;
+				tvm.printf(10, pos++, 0x8b, " DS hit: %6d / %6d (%5.1f%%) %s"
+					, m_descriptorSetCache.m_hits
+					, numLookups
+					, 0 < numLookups ? 100.0 * m_descriptorSetCache.m_hits / numLookups : 100.0
+					, m_pushDescriptorSupport ? "[push]" : ""
+					);
+
+				const uint32_t numUniformLookups = m_uniformCache.m_hits + m_uniformCache.m_misses;
+				tvm.printf(10, pos++, 0x8b, " UB hit: %6d / %6d (%5.1f%%) "
+					, m_uniformCache.m_hits
+					, numUniformLookups
+					, 0 < numUniformLookups ? 100.0 * m_uniformCache.m_hits / numUniformLookups : 100.0
 					);
 				pos++;
 
@@ -8545,6 +11316,18 @@ VK_DESTROY
 
 		scratchBuffer.flush();
 
+		// Next time this frame is submitted the API thread writes transient data directly into
+		// the next ring slot, and upload at the start of submit becomes a no-op.
+		if (NULL != _render->m_transientIb)
+		{
+			_render->m_transientIb->data = m_indexBuffers[_render->m_transientIb->handle.idx].advance();
+		}
+
+		if (NULL != _render->m_transientVb)
+		{
+			_render->m_transientVb->data = m_vertexBuffers[_render->m_transientVb->handle.idx].advance();
+		}
+
 		for (uint16_t ii = 0; ii < m_numWindows; ++ii)
 		{
 			FrameBufferVK& fb = isValid(m_windows[ii])
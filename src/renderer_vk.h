@@ -177,12 +177,15 @@
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdCopyImage);                  \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdCopyImageToBuffer);          \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdBlitImage);                  \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdExecuteCommands);            \
 			VK_IMPORT_DEVICE_FUNC(false, vkMapMemory);                     \
 			VK_IMPORT_DEVICE_FUNC(false, vkUnmapMemory);                   \
 			VK_IMPORT_DEVICE_FUNC(false, vkFlushMappedMemoryRanges);       \
 			VK_IMPORT_DEVICE_FUNC(false, vkInvalidateMappedMemoryRanges);  \
 			VK_IMPORT_DEVICE_FUNC(false, vkBindBufferMemory);              \
 			VK_IMPORT_DEVICE_FUNC(false, vkBindImageMemory);               \
+			/* VK_KHR_push_descriptor */                                   \
+			VK_IMPORT_DEVICE_FUNC(true,  vkCmdPushDescriptorSetKHR);       \
 			/* VK_EXT_debug_marker */                                      \
 			VK_IMPORT_DEVICE_FUNC(true,  vkDebugMarkerSetObjectTagEXT);    \
 			VK_IMPORT_DEVICE_FUNC(true,  vkDebugMarkerSetObjectNameEXT);   \
@@ -360,6 +363,109 @@ VK_DESTROY_FUNC(SurfaceKHR);
 		HashMap m_hashMap;
 	};
 
+	struct DeviceMemoryAllocationVK
+	{
+		DeviceMemoryAllocationVK()
+			: m_mem(VK_NULL_HANDLE)
+			, m_offset(0)
+			, m_size(0)
+			, m_data(NULL)
+			, m_pool(UINT16_MAX)
+			, m_block(UINT16_MAX)
+			, m_level(0)
+		{
+		}
+
+		VkDeviceMemory m_mem;
+		VkDeviceSize   m_offset;
+		VkDeviceSize   m_size;
+		uint8_t*       m_data;  // Persistently mapped pointer, only for host visible memory.
+		uint16_t       m_pool;
+		uint16_t       m_block; // UINT16_MAX for dedicated allocation.
+		uint8_t        m_level;
+	};
+
+	// Suballocates resources from large device memory blocks. Buffers and images are kept in
+	// separate pools of each memory type, so bufferImageGranularity never applies between
+	// neighbouring allocations. Long-lived resources are buddy allocated, transient resources
+	// (staging) are allocated linearly and block is recycled once all its allocations are freed.
+	class DeviceMemoryAllocatorVK
+	{
+	public:
+		struct Usage
+		{
+			enum Enum
+			{
+				Buffer,
+				Image,
+				Transient,
+
+				Count
+			};
+		};
+
+		DeviceMemoryAllocatorVK();
+
+		void init(const VkPhysicalDeviceMemoryProperties& _memoryProperties, VkDeviceSize _blockSize);
+		void shutdown();
+
+		VkResult alloc(const VkMemoryRequirements& _requirements, VkMemoryPropertyFlags _propertyFlags, Usage::Enum _usage, DeviceMemoryAllocationVK* _alloc);
+		void free(DeviceMemoryAllocationVK& _alloc);
+
+		// Returns all empty blocks back to driver. Live allocations are never moved.
+		void defragment();
+
+		// Memory allocated from driver in heaps with VK_MEMORY_HEAP_DEVICE_LOCAL_BIT.
+		uint64_t getDeviceLocalAllocated() const;
+
+		// Total size of heaps with VK_MEMORY_HEAP_DEVICE_LOCAL_BIT.
+		uint64_t getDeviceLocalSize() const;
+
+	private:
+		static constexpr uint32_t kMinAllocSize = 256;
+		static constexpr uint32_t kMaxLevels    = 32;
+
+		typedef stl::unordered_set<uint32_t> FreeList;
+
+		struct Block
+		{
+			VkDeviceMemory m_mem;
+			uint8_t*       m_data;
+			VkDeviceSize   m_offset;
+			uint32_t       m_numAllocs;
+			FreeList       m_free[kMaxLevels];
+		};
+
+		struct Pool
+		{
+			stl::vector<Block*> m_blocks;
+			VkDeviceSize m_blockSize;
+			uint32_t     m_memoryTypeIndex;
+			uint8_t      m_numLevels;
+			bool         m_linear;
+		};
+
+		VkResult allocFromType(uint32_t _memoryTypeIndex, const VkMemoryRequirements& _requirements, Usage::Enum _usage, DeviceMemoryAllocationVK* _alloc);
+		VkResult allocDedicated(uint16_t _pool, VkDeviceSize _size, DeviceMemoryAllocationVK* _alloc);
+		VkResult allocBlock(uint16_t _pool, uint16_t* _block);
+		void freeBlock(uint16_t _pool, uint16_t _block);
+		bool suballoc(uint16_t _pool, uint16_t _block, VkDeviceSize _size, VkDeviceSize _align, DeviceMemoryAllocationVK* _alloc);
+
+		uint32_t getHeapIndex(uint16_t _pool) const
+		{
+			return m_memoryProperties.memoryTypes[m_pool[_pool].m_memoryTypeIndex].heapIndex;
+		}
+
+		bool isHostVisible(uint16_t _pool) const
+		{
+			return 0 != (m_memoryProperties.memoryTypes[m_pool[_pool].m_memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+		}
+
+		VkPhysicalDeviceMemoryProperties m_memoryProperties;
+		Pool m_pool[VK_MAX_MEMORY_TYPES * Usage::Count];
+		uint64_t m_allocated[VK_MAX_MEMORY_HEAPS];
+	};
+
 	class ScratchBufferVK
 	{
 	public:
@@ -371,32 +477,227 @@ VK_DESTROY_FUNC(SurfaceKHR);
 		{
 		}
 
-		void create(uint32_t _size, uint32_t _count, uint32_t _maxDescriptors);
+		void create(uint32_t _size, uint32_t _count);
 		void destroy();
 		void reset();
+		uint32_t alloc(uint32_t _size);
 		uint32_t write(const void* _data, uint32_t _size);
 		void flush();
 
-		VkDescriptorSet& getCurrentDS()
-		{
-			return m_descriptorSet[m_currentDs - 1];
-		}
-
-		VkDescriptorSet* m_descriptorSet;
 		VkBuffer m_buffer;
 		VkDeviceMemory m_deviceMem;
 		uint8_t* m_data;
 		uint32_t m_size;
 		uint32_t m_pos;
-		uint32_t m_currentDs;
-		uint32_t m_maxDescriptors;
+	};
+
+	// Constants written to scratch buffer this frame, keyed by their content. Draws that take
+	// all their uniforms from the same uniform block end up with identical constants, and they
+	// reference single upload instead of writing their own copy.
+	class UniformCacheVK
+	{
+	public:
+		UniformCacheVK()
+			: m_hits(0)
+			, m_misses(0)
+		{
+		}
+
+		void reset();
+		uint32_t write(ScratchBufferVK& _scratchBuffer, const void* _vs, uint32_t _vsize, const void* _fs, uint32_t _fsize);
+
+		uint32_t m_hits;
+		uint32_t m_misses;
+
+	private:
+		struct Entry
+		{
+			uint32_t m_offset;
+			uint32_t m_data;
+			uint32_t m_vsize;
+			uint32_t m_fsize;
+		};
+
+		typedef stl::unordered_map<uint32_t, Entry> HashMap;
+		HashMap m_hashMap;
+
+		// Copy of cached constants, scratch buffer memory is write-combined and slow to read.
+		stl::vector<uint8_t> m_data;
+	};
+
+	struct DescriptorWriteVK
+	{
+		bool isBuffer() const;
+
+		// Only fields used by descriptor type are hashed and compared, union padding and
+		// unused fields are not initialized.
+		void hash(bx::HashMurmur2A& _murmur) const;
+		bool isEqual(const DescriptorWriteVK& _other) const;
+
+		VkDescriptorType m_type;
+		uint32_t         m_binding;
+
+		union
+		{
+			VkDescriptorImageInfo  m_image;
+			VkDescriptorBufferInfo m_buffer;
+		};
+	};
+
+	// Descriptor sets are cached by hash of their layout and content, and they are reused
+	// across frames. Entries keep layout and content, so that hash collision is not mistaken
+	// for a hit. Entries are evicted once they are not used for a while, or when object they
+	// reference is released. Sets are allocated from pools owned by cache, and pools are added
+	// when existing ones run out.
+	class DescriptorSetCacheVK
+	{
+	public:
+		DescriptorSetCacheVK();
+
+		VkDescriptorSet find(uint32_t _hash, VkDescriptorSetLayout _layout, const DescriptorWriteVK* _writes, uint32_t _num);
+		VkDescriptorSet add(uint32_t _hash, VkDescriptorSetLayout _layout, const DescriptorWriteVK* _writes, uint32_t _num);
+		void invalidate(uint64_t _handle);
+		void consume(uint32_t _frameInFlight);
+		void update();
+		void destroy();
+
+		uint32_t getCount() const
+		{
+			return uint32_t(m_hashMap.size() );
+		}
+
+		struct Entry
+		{
+			VkDescriptorSet       m_descriptorSet;
+			VkDescriptorPool      m_pool;
+			VkDescriptorSetLayout m_layout;
+			stl::vector<DescriptorWriteVK> m_writes;
+			uint32_t              m_frame;
+		};
+
+		typedef stl::unordered_map<uint32_t, Entry> HashMap;
+		HashMap m_hashMap;
+
+		uint32_t m_frame;
+		uint32_t m_hits;
+		uint32_t m_misses;
+
+	private:
+		VkDescriptorPool alloc(VkDescriptorSetLayout _layout, VkDescriptorSet& _descriptorSet);
+		void release(const Entry& _entry);
+
+		struct Free
+		{
+			VkDescriptorPool m_pool;
+			VkDescriptorSet  m_descriptorSet;
+		};
+
+		typedef stl::vector<Free> FreeList;
+		FreeList m_free[BGFX_CONFIG_MAX_FRAME_LATENCY];
+
+		typedef stl::unordered_set<uint64_t> HandleSet;
+		HandleSet m_evict;
+
+		stl::vector<VkDescriptorPool> m_pool;
+		uint32_t m_current;
+	};
+
+	// Transient descriptor sets, used when set can't be added to descriptor set cache. Each
+	// record job slot of each frame in flight has its own allocator, so that sets can be
+	// allocated without synchronization. Pools are added when current one runs out, and all
+	// pools are reset once GPU is done with the frame.
+	class DescriptorAllocatorVK
+	{
+	public:
+		DescriptorAllocatorVK();
+
+		VkDescriptorSet alloc(VkDescriptorSetLayout _layout, const DescriptorWriteVK* _writes, uint32_t _num);
+		void reset();
+		void destroy();
+
+		stl::vector<VkDescriptorPool> m_pool;
+		uint32_t m_current;
+	};
+
+	// Global descriptor set with all textures, indexed by TextureHandle.idx from shaders. Each
+	// frame in flight has its own copy, and texture changes are written into it only before it's
+	// bound first time after GPU is done with it.
+	class BindlessTextureSetVK
+	{
+	public:
+		BindlessTextureSetVK();
+
+		VkResult init(uint32_t _numFramesInFlight);
+		void shutdown();
+		void invalidate(TextureHandle _handle);
+		void consume(uint32_t _frameInFlight);
+		VkDescriptorSet get(uint32_t _frameInFlight);
+
+		VkDescriptorSetLayout m_layout;
+
+	private:
+		void update(uint32_t _frameInFlight);
+
+		VkDescriptorPool m_pool;
+		VkDescriptorSet  m_descriptorSet[BGFX_CONFIG_MAX_FRAME_LATENCY];
+		uint32_t         m_dirty[BGFX_CONFIG_MAX_FRAME_LATENCY][(BGFX_CONFIG_MAX_BINDLESS_TEXTURES+31)/32];
+		bool             m_inUse[BGFX_CONFIG_MAX_FRAME_LATENCY];
+		uint32_t         m_numFramesInFlight;
+	};
+
+	struct StagingBufferVK
+	{
+		VkBuffer                 m_buffer;
+		DeviceMemoryAllocationVK m_deviceMem; // Only for dedicated staging buffer.
+		uint8_t*                 m_data;
+		uint32_t                 m_offset;
+		uint32_t                 m_size;
+		bool                     m_fromRing;
+	};
+
+	// Per frame in flight persistently mapped staging memory, all uploads take their staging
+	// memory from it. Space is reclaimed once GPU is done with the frame, and ring grows to
+	// the demand of previous frames.
+	struct StagingRingVK
+	{
+		StagingRingVK()
+			: m_buffer(VK_NULL_HANDLE)
+			, m_size(0)
+			, m_pos(0)
+			, m_demand(0)
+			, m_numIdleFrames(0)
+		{
+		}
+
+		void create(uint32_t _size);
+		void destroy();
+		void reset();
+		bool alloc(uint32_t _size, uint32_t _align, StagingBufferVK* _staging);
+
+		VkBuffer                 m_buffer;
+		DeviceMemoryAllocationVK m_deviceMem;
+		uint32_t                 m_size;
+		uint32_t                 m_pos;
+		uint32_t                 m_demand;
+		uint32_t                 m_numIdleFrames;
+	};
+
+	// Persistently mapped host visible copies of a transient buffer. The API thread writes the
+	// next frame's data straight into the slot that the GPU is no longer reading from.
+	struct TransientRingVK
+	{
+		VkBuffer       m_buffer[BGFX_CONFIG_MAX_FRAME_LATENCY+2];
+		VkDeviceMemory m_deviceMem[BGFX_CONFIG_MAX_FRAME_LATENCY+2];
+		uint8_t*       m_data[BGFX_CONFIG_MAX_FRAME_LATENCY+2];
+		uint32_t       m_num;
+		uint32_t       m_current;
 	};
 
 	struct BufferVK
 	{
 		BufferVK()
 			: m_buffer(VK_NULL_HANDLE)
-			, m_deviceMem(VK_NULL_HANDLE)
+			, m_ring(NULL)
 			, m_size(0)
 			, m_flags(BGFX_BUFFER_NONE)
 			, m_dynamic(false)
@@ -407,8 +708,12 @@ VK_DESTROY_FUNC(SurfaceKHR);
 		void update(VkCommandBuffer _commandBuffer, uint32_t _offset, uint32_t _size, void* _data, bool _discard = false);
 		void destroy();
 
+		// Moves transient ring to the next slot, returns its mapped memory.
+		uint8_t* advance();
+
 		VkBuffer m_buffer;
-		VkDeviceMemory m_deviceMem;
+		DeviceMemoryAllocationVK m_deviceMem;
+		TransientRingVK* m_ring;
 		uint32_t m_size;
 		uint16_t m_flags;
 		bool m_dynamic;
@@ -467,6 +772,7 @@ VK_DESTROY_FUNC(SurfaceKHR);
 			, m_uniformBinding(0)
 			, m_numBindings(0)
 			, m_oldBindingModel(false)
+			, m_bindless(false)
 		{
 		}
 
@@ -497,6 +803,7 @@ VK_DESTROY_FUNC(SurfaceKHR);
 		VkDescriptorSetLayoutBinding m_bindings[2 * BGFX_CONFIG_MAX_TEXTURE_SAMPLERS + 1];
 
 		bool m_oldBindingModel;
+		bool m_bindless;
 	};
 
 	struct ProgramVK
@@ -506,6 +813,8 @@ VK_DESTROY_FUNC(SurfaceKHR);
 			, m_fsh(NULL)
 			, m_descriptorSetLayout(VK_NULL_HANDLE)
 			, m_pipelineLayout(VK_NULL_HANDLE)
+			, m_pushDescriptor(false)
+			, m_bindless(false)
 		{
 		}
 
@@ -525,6 +834,8 @@ VK_DESTROY_FUNC(SurfaceKHR);
 
 		VkDescriptorSetLayout m_descriptorSetLayout;
 		VkPipelineLayout m_pipelineLayout;
+		bool m_pushDescriptor;
+		bool m_bindless;
 	};
 
 	struct TimerQueryVK
@@ -595,7 +906,7 @@ VK_DESTROY_FUNC(SurfaceKHR);
 		void destroy();
 		uint32_t pitch(uint8_t _mip = 0) const;
 		void copyImageToBuffer(VkCommandBuffer _commandBuffer, VkBuffer _buffer, VkImageLayout _layout, VkImageAspectFlags _aspect, uint8_t _mip = 0) const;
-		void readback(VkDeviceMemory _memory, VkDeviceSize _offset, void* _data, uint8_t _mip = 0) const;
+		void readback(const uint8_t* _src, void* _data, uint8_t _mip = 0) const;
 
 		VkImage  m_image;
 		uint32_t m_width;
@@ -610,10 +921,8 @@ VK_DESTROY_FUNC(SurfaceKHR);
 			, m_sampler({ 1, VK_SAMPLE_COUNT_1_BIT })
 			, m_format(VK_FORMAT_UNDEFINED)
 			, m_textureImage(VK_NULL_HANDLE)
-			, m_textureDeviceMem(VK_NULL_HANDLE)
 			, m_currentImageLayout(VK_IMAGE_LAYOUT_UNDEFINED)
 			, m_singleMsaaImage(VK_NULL_HANDLE)
-			, m_singleMsaaDeviceMem(VK_NULL_HANDLE)
 			, m_currentSingleMsaaImageLayout(VK_IMAGE_LAYOUT_UNDEFINED)
 		{
 		}
@@ -642,6 +951,7 @@ VK_DESTROY_FUNC(SurfaceKHR);
 		uint8_t  m_requestedFormat;
 		uint8_t  m_textureFormat;
 		uint8_t  m_numMips;
+		uint8_t  m_minLod;
 
 		MsaaSamplerVK m_sampler;
 
@@ -650,13 +960,13 @@ VK_DESTROY_FUNC(SurfaceKHR);
 		VkComponentMapping m_components;
 		VkImageAspectFlags m_aspectMask;
 
-		VkImage        m_textureImage;
-		VkDeviceMemory m_textureDeviceMem;
-		VkImageLayout  m_currentImageLayout;
+		VkImage                  m_textureImage;
+		DeviceMemoryAllocationVK m_textureDeviceMem;
+		VkImageLayout            m_currentImageLayout;
 
-		VkImage        m_singleMsaaImage;
-		VkDeviceMemory m_singleMsaaDeviceMem;
-		VkImageLayout  m_currentSingleMsaaImageLayout;
+		VkImage                  m_singleMsaaImage;
+		DeviceMemoryAllocationVK m_singleMsaaDeviceMem;
+		VkImageLayout            m_currentSingleMsaaImageLayout;
 
 		ReadbackVK m_readback;
 
@@ -800,12 +1110,15 @@ VK_DESTROY_FUNC(SurfaceKHR);
 		void shutdown();
 
 		VkResult alloc(VkCommandBuffer* _commandBuffer);
+		VkCommandBuffer allocSecondary();
 		void addWaitSemaphore(VkSemaphore _semaphore, VkPipelineStageFlags _waitFlags = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
 		void addSignalSemaphore(VkSemaphore _semaphore);
 		void kick(bool _wait = false);
 		void finish(bool _finishAll = false);
 
 		void release(uint64_t _handle, VkObjectType _type);
+		void release(const DeviceMemoryAllocationVK& _alloc);
+		void readback(const ReadbackVK& _readback, VkBuffer _buffer, const DeviceMemoryAllocationVK& _alloc, void* _data, uint8_t _mip);
 		void consume();
 
 		uint32_t m_queueFamily;
@@ -830,6 +1143,11 @@ VK_DESTROY_FUNC(SurfaceKHR);
 
 		CommandList m_commandList[BGFX_CONFIG_MAX_FRAME_LATENCY];
 
+		// Secondary command buffers have their own pools, so that they can be recorded from
+		// different threads at the same time.
+		CommandList m_secondaryList[BGFX_CONFIG_MAX_FRAME_LATENCY][BGFX_CONFIG_MAX_SECONDARY_COMMAND_BUFFERS];
+		uint32_t    m_numSecondary[BGFX_CONFIG_MAX_FRAME_LATENCY];
+
 		uint32_t             m_numWaitSemaphores;
 		VkSemaphore          m_waitSemaphores[BGFX_CONFIG_MAX_FRAME_BUFFERS];
 		VkPipelineStageFlags m_waitSemaphoreStages[BGFX_CONFIG_MAX_FRAME_BUFFERS];
@@ -845,6 +1163,21 @@ VK_DESTROY_FUNC(SurfaceKHR);
 		typedef stl::vector<Resource> ResourceArray;
 		ResourceArray m_release[BGFX_CONFIG_MAX_FRAME_LATENCY];
 
+		typedef stl::vector<DeviceMemoryAllocationVK> DeviceMemoryArray;
+		DeviceMemoryArray m_releaseDeviceMemory[BGFX_CONFIG_MAX_FRAME_LATENCY];
+
+		struct Readback
+		{
+			ReadbackVK m_readback;
+			VkBuffer m_buffer;
+			DeviceMemoryAllocationVK m_alloc;
+			void* m_data;
+			uint8_t m_mip;
+		};
+
+		typedef stl::vector<Readback> ReadbackArray;
+		ReadbackArray m_readback[BGFX_CONFIG_MAX_FRAME_LATENCY];
+
 	private:
 		template<typename Ty>
 		void destroy(uint64_t _handle)
@@ -855,6 +1188,134 @@ VK_DESTROY_FUNC(SurfaceKHR);
 		}
 	};
 
+	struct DrawCommandVK
+	{
+		VkPipeline       m_pipeline;
+		VkPipelineLayout m_pipelineLayout;
+		VkDescriptorSet  m_descriptorSet;
+		VkDescriptorSet  m_bindlessSet;
+		uint32_t         m_offset[2];
+		uint32_t         m_numOffsets;
+		const DescriptorWriteVK* m_pushWrite;
+		uint32_t         m_numPushWrites;
+		VkBuffer         m_vertexBuffer[BGFX_CONFIG_MAX_VERTEX_STREAMS+1];
+		VkDeviceSize     m_vertexOffset[BGFX_CONFIG_MAX_VERTEX_STREAMS+1];
+		uint32_t         m_numVertexBuffers;
+		VkBuffer         m_indexBuffer;
+		VkIndexType      m_indexType;
+		VkBuffer         m_indirectBuffer;
+		uint32_t         m_indirectOffset;
+		uint32_t         m_numIndirect;
+		uint32_t         m_num;
+		uint32_t         m_numInstances;
+		uint32_t         m_startIndex;
+		uint32_t         m_stencilRef;
+		uint32_t         m_blendFactor;
+		VkRect2D         m_scissor;
+	};
+
+	// Draw gathered on render thread. Only state that has to be evaluated in submission order
+	// (uniforms and image layouts) is resolved there, the rest is resolved by record jobs.
+	// Constants are in scratch buffer at m_uniform, vertex shader constants first.
+	struct DrawItemVK
+	{
+		uint32_t      m_itemIdx;
+		uint32_t      m_bindHash;
+		uint32_t      m_uniform;
+		ProgramHandle m_program;
+	};
+
+	struct RecordStateVK
+	{
+		void reset();
+		void draw(VkCommandBuffer _commandBuffer, const DrawCommandVK& _draw);
+
+		VkPipeline      m_pipeline;
+		VkDescriptorSet m_descriptorSet;
+		uint32_t        m_offset[2];
+		uint32_t        m_numOffsets;
+		VkPipelineLayout m_bindlessLayout;
+		VkBuffer        m_vertexBuffer[BGFX_CONFIG_MAX_VERTEX_STREAMS+1];
+		VkDeviceSize    m_vertexOffset[BGFX_CONFIG_MAX_VERTEX_STREAMS+1];
+		VkBuffer        m_indexBuffer;
+		VkIndexType     m_indexType;
+		uint64_t        m_stencilRef;
+		uint64_t        m_blendFactor;
+		VkRect2D        m_scissor;
+	};
+
+	struct PipelineDescVK
+	{
+		VkGraphicsPipelineCreateInfo           m_graphicsPipeline;
+		VkPipelineShaderStageCreateInfo        m_shaderStages[2];
+		VkPipelineVertexInputStateCreateInfo   m_vertexInputState;
+		VkVertexInputBindingDescription        m_inputBinding[BGFX_CONFIG_MAX_VERTEX_STREAMS + 1];
+		VkVertexInputAttributeDescription      m_inputAttrib[Attrib::Count + BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT];
+		VkPipelineInputAssemblyStateCreateInfo m_inputAssemblyState;
+		VkPipelineViewportStateCreateInfo      m_viewportState;
+		VkPipelineRasterizationStateCreateInfo m_rasterizationState;
+		VkPipelineRasterizationConservativeStateCreateInfoEXT m_conservativeRasterizationState;
+		VkPipelineRasterizationLineStateCreateInfoEXT m_lineRasterizationState;
+		VkPipelineMultisampleStateCreateInfo   m_multisampleState;
+		VkPipelineDepthStencilStateCreateInfo  m_depthStencilState;
+		VkPipelineColorBlendAttachmentState    m_blendAttachmentState[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+		VkPipelineColorBlendStateCreateInfo    m_colorBlendState;
+		VkPipelineDynamicStateCreateInfo       m_dynamicState;
+	};
+
+	class PipelineCompilerVK
+	{
+	public:
+		struct Job
+		{
+			PipelineDescVK m_desc;
+			VkPipeline     m_pipeline;
+			uint32_t       m_hash;
+		};
+
+		PipelineCompilerVK()
+			: m_numThreads(0)
+			, m_exit(false)
+		{
+		}
+
+		void init(uint32_t _numThreads);
+		void shutdown();
+
+		bool isEnabled() const
+		{
+			return 0 < m_numThreads;
+		}
+
+		bool isPending(uint32_t _hash) const
+		{
+			return m_pending.end() != m_pending.find(_hash);
+		}
+
+		void push(Job* _job);
+		Job* pop(bool _wait);
+
+	private:
+		static int32_t compileThread(bx::Thread* _self, void* _userData);
+
+		static constexpr uint32_t kMaxThreads = 4;
+
+		bx::Thread    m_thread[kMaxThreads];
+		bx::Semaphore m_workSem;
+		bx::Semaphore m_doneSem;
+		bx::Mutex     m_mutex;
+
+		typedef stl::vector<Job*> JobArray;
+		JobArray m_queue;
+		JobArray m_done;
+
+		typedef stl::unordered_set<uint32_t> HashSet;
+		HashSet m_pending;
+
+		uint32_t m_numThreads;
+		volatile bool m_exit;
+	};
+
 } /* namespace bgfx */ } // namespace vk
 
 #endif // BGFX_RENDERER_VK_H_HEADER_GUARD
@@ -574,14 +574,14 @@ namespace bgfx { namespace webgpu
 			for (uint8_t ii = 0; ii < BGFX_CONFIG_MAX_FRAME_LATENCY; ++ii)
 			{
 				BX_TRACE("Create scratch buffer %d", ii);
-				m_scratchBuffers[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS * 128);
+				m_scratchBuffers[ii].create(g_caps.limits.maxDrawCalls * 128);
 				m_bindStateCache[ii].create(); // (1024);
 			}
 
 			for (uint8_t ii = 0; ii < WEBGPU_NUM_UNIFORM_BUFFERS; ++ii)
 			{
 				bool mapped = true; // ii == WEBGPU_NUM_UNIFORM_BUFFERS - 1;
-				m_uniformBuffers[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS * 128, mapped);
+				m_uniformBuffers[ii].create(g_caps.limits.maxDrawCalls * 128, mapped);
 			}
 
 			g_caps.supported |= (0
@@ -907,6 +907,11 @@ namespace bgfx { namespace webgpu
 			readback.m_buffer.MapAsync(wgpu::MapMode::Read, 0, size, finish, &readback);
 		}
 
+		uint32_t getReadTextureLatency() const override
+		{
+			return 0;
+		}
+
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
 			TextureWgpu& texture = m_textures[_handle.idx];
@@ -942,6 +947,10 @@ namespace bgfx { namespace webgpu
 			release(mem);
 		}
 
+		void setTextureMinLod(TextureHandle /*_handle*/, uint8_t /*_minLod*/) override
+		{
+		}
+
 		void overrideInternal(TextureHandle _handle, uintptr_t _ptr) override
 		{
 			BX_UNUSED(_handle, _ptr);
@@ -1093,6 +1102,19 @@ namespace bgfx { namespace webgpu
 			}
 		}
 
+		virtual void prewarmPipeline(ProgramHandle _program, uint64_t _state, VertexLayoutHandle _layoutHandle, FrameBufferHandle _frameBuffer) override
+		{
+			BX_UNUSED(_program, _state, _layoutHandle, _frameBuffer);
+		}
+
+		virtual void flushPipelineCache() override
+		{
+		}
+
+		virtual void defragment() override
+		{
+		}
+
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
@@ -2568,6 +2590,12 @@ namespace bgfx { namespace webgpu
 					m_predefined[m_numPredefined].m_type  = uint8_t(predefined|fragmentBit);
 					m_numPredefined++;
 				}
+				else if (UniformType::End == (~kUniformMask & type)
+					 &&  DescriptorType::BindlessTexture == idToDescriptorType(regCount) )
+				{
+					// Bindless textures are not supported, and cap is never reported.
+					kind = "bindless";
+				}
 				else if (UniformType::End == (~kUniformMask & type))
 				{
 					// regCount is used for descriptor type
@@ -3529,7 +3557,7 @@ namespace bgfx { namespace webgpu
 		m_size = _size;
 
 		wgpu::BufferDescriptor desc;
-		desc.size = BGFX_CONFIG_MAX_DRAW_CALLS * 128;
+		desc.size = _size;
 		desc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform;
 
 		m_buffer = s_renderWgpu->m_device.CreateBuffer(&desc);
@@ -4511,8 +4539,7 @@ namespace bgfx { namespace webgpu
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				bool constantsChanged = rendererUpdateUniforms(this, _render, draw);
 
 				bool vertexStreamChanged = hasVertexStreamChanged(currentState, draw);
 
@@ -21,8 +21,9 @@ namespace bgfx
 		// NOTICE:
 		// DescriptorType must be in order how it appears in DescriptorType::Enum! id is
 		// unique and should not be changed if new DescriptorTypes are added.
-		{ DescriptorType::StorageBuffer, 0x0007 },
-		{ DescriptorType::StorageImage,  0x0003 },
+		{ DescriptorType::StorageBuffer,   0x0007 },
+		{ DescriptorType::StorageImage,    0x0003 },
+		{ DescriptorType::BindlessTexture, 0x0010 },
 	};
 	BX_STATIC_ASSERT(BX_COUNTOF(s_descriptorTypeToId) == DescriptorType::Count);
 
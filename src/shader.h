@@ -16,6 +16,7 @@ namespace bgfx
 		{
 			StorageBuffer,
 			StorageImage,
+			BindlessTexture,
 
 			Count
 		};
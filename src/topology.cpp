@@ -6,10 +6,12 @@
 #include <bx/allocator.h>
 #include <bx/debug.h>
 #include <bx/math.h>
+#include <bx/simd_t.h>
 #include <bx/sort.h>
 #include <bx/uint32_t.h>
 
 #include "config.h"
+#include "parallel.h"
 #include "topology.h"
 
 namespace bgfx
@@ -262,45 +264,52 @@ namespace bgfx
 		return 0;
 	}
 
-	inline float fmin3(float _a, float _b, float _c)
+	const bx::Vec3 vertexPos(const void* _vertices, uint32_t _stride, uint32_t _index)
 	{
-		return bx::min(_a, _b, _c);
+		const uint8_t* vertices = (const uint8_t*)_vertices;
+		return bx::load<bx::Vec3>(&vertices[_index*_stride]);
 	}
 
-	inline float fmax3(float _a, float _b, float _c)
+	inline bx::simd128_t distanceDir(const bx::simd128_t* _dir, bx::simd128_t _x, bx::simd128_t _y, bx::simd128_t _z)
 	{
-		return bx::max(_a, _b, _c);
+		const bx::simd128_t xx = bx::simd_mul(_x, _dir[0]);
+		const bx::simd128_t yy = bx::simd_mul(_y, _dir[1]);
+		const bx::simd128_t zz = bx::simd_mul(_z, _dir[2]);
+		return bx::simd_add(bx::simd_add(xx, yy), zz);
 	}
 
-	inline float favg3(float _a, float _b, float _c)
+	inline bx::simd128_t distancePos(const bx::simd128_t* _pos, bx::simd128_t _x, bx::simd128_t _y, bx::simd128_t _z)
 	{
-		return (_a + _b + _c) * 1.0f/3.0f;
+		const bx::simd128_t xx = bx::simd_sub(_pos[0], _x);
+		const bx::simd128_t yy = bx::simd_sub(_pos[1], _y);
+		const bx::simd128_t zz = bx::simd_sub(_pos[2], _z);
+		const bx::simd128_t xx2 = bx::simd_mul(xx, xx);
+		const bx::simd128_t yy2 = bx::simd_mul(yy, yy);
+		const bx::simd128_t zz2 = bx::simd_mul(zz, zz);
+		return bx::simd_sqrt(bx::simd_add(bx::simd_add(xx2, yy2), zz2) );
 	}
 
-	const bx::Vec3 vertexPos(const void* _vertices, uint32_t _stride, uint32_t _index)
+	inline bx::simd128_t fmin3(bx::simd128_t _a, bx::simd128_t _b, bx::simd128_t _c)
 	{
-		const uint8_t* vertices = (const uint8_t*)_vertices;
-		return bx::load<bx::Vec3>(&vertices[_index*_stride]);
+		return bx::simd_min(bx::simd_min(_a, _b), _c);
 	}
 
-	inline float distanceDir(const float* _dir, const void* _vertices, uint32_t _stride, uint32_t _index)
+	inline bx::simd128_t fmax3(bx::simd128_t _a, bx::simd128_t _b, bx::simd128_t _c)
 	{
-		return bx::dot(vertexPos(_vertices, _stride, _index), bx::load<bx::Vec3>(_dir) );
+		return bx::simd_max(bx::simd_max(_a, _b), _c);
 	}
 
-	inline float distancePos(const float* _pos, const void* _vertices, uint32_t _stride, uint32_t _index)
+	inline bx::simd128_t favg3(bx::simd128_t _a, bx::simd128_t _b, bx::simd128_t _c)
 	{
-		const bx::Vec3 tmp = bx::sub(bx::load<bx::Vec3>(_pos), vertexPos(_vertices, _stride, _index) );
-		return bx::sqrt(bx::dot(tmp, tmp) );
+		return bx::simd_mul(bx::simd_add(bx::simd_add(_a, _b), _c), bx::simd_splat(1.0f/3.0f) );
 	}
 
-	typedef float (*KeyFn)(float, float, float);
-	typedef float (*DistanceFn)(const float*, const void*, uint32_t, uint32_t);
+	typedef bx::simd128_t (*KeyFn)(bx::simd128_t, bx::simd128_t, bx::simd128_t);
+	typedef bx::simd128_t (*DistanceFn)(const bx::simd128_t*, bx::simd128_t, bx::simd128_t, bx::simd128_t);
 
 	template<typename IndexT, DistanceFn dfn, KeyFn kfn, uint32_t xorBits>
 	inline void calcSortKeys(
 		  uint32_t* _keys
-		, uint32_t* _values
 		, const float _dirOrPos[3]
 		, const void* _vertices
 		, uint32_t _stride
@@ -308,60 +317,136 @@ namespace bgfx
 		, uint32_t _num
 		)
 	{
-		for (uint32_t ii = 0; ii < _num; ++ii)
+		using namespace bx;
+
+		const simd128_t dirOrPos[3] =
 		{
-			const uint32_t idx0 = _indices[0];
-			const uint32_t idx1 = _indices[1];
-			const uint32_t idx2 = _indices[2];
-			_indices += 3;
-
-			float distance0 = dfn(_dirOrPos, _vertices, _stride, idx0);
-			float distance1 = dfn(_dirOrPos, _vertices, _stride, idx1);
-			float distance2 = dfn(_dirOrPos, _vertices, _stride, idx2);
-
-			uint32_t ui = bx::floatToBits(kfn(distance0, distance1, distance2) );
-			_keys[ii]   = bx::floatFlip(ui) ^ xorBits;
-			_values[ii] = ii;
+			simd_splat(_dirOrPos[0]),
+			simd_splat(_dirOrPos[1]),
+			simd_splat(_dirOrPos[2]),
+		};
+
+		const simd128_t signBit = simd_isplat(UINT32_C(0x80000000) );
+		const simd128_t xorMask = simd_isplat(xorBits);
+
+		// Four triangles are processed at once, each SIMD lane is one triangle. Lanes past the
+		// end replicate the last triangle.
+		for (uint32_t ii = 0; ii < _num; ii += 4)
+		{
+			BX_ALIGN_DECL_16(float xyz[3][3][4]);
+
+			for (uint32_t lane = 0; lane < 4; ++lane)
+			{
+				const IndexT* tri = &_indices[uint32_min(ii+lane, _num-1)*3];
+
+				for (uint32_t vv = 0; vv < 3; ++vv)
+				{
+					const Vec3 pos = vertexPos(_vertices, _stride, tri[vv]);
+					xyz[vv][0][lane] = pos.x;
+					xyz[vv][1][lane] = pos.y;
+					xyz[vv][2][lane] = pos.z;
+				}
+			}
+
+			simd128_t distance[3];
+
+			for (uint32_t vv = 0; vv < 3; ++vv)
+			{
+				distance[vv] = dfn(dirOrPos
+					, simd_ld<simd128_t>(xyz[vv][0])
+					, simd_ld<simd128_t>(xyz[vv][1])
+					, simd_ld<simd128_t>(xyz[vv][2])
+					);
+			}
+
+			// Same as bx::floatFlip, negative floats flip all bits, positive only the sign bit.
+			const simd128_t ui   = kfn(distance[0], distance[1], distance[2]);
+			const simd128_t mask = simd_or(simd_sra(ui, 31), signBit);
+			const simd128_t key  = simd_xor(simd_xor(ui, mask), xorMask);
+
+			BX_ALIGN_DECL_16(uint32_t keys[4]);
+			simd_st(keys, key);
+
+			const uint32_t num = uint32_min(4, _num-ii);
+			for (uint32_t lane = 0; lane < num; ++lane)
+			{
+				_keys[ii+lane] = keys[lane];
+			}
 		}
 	}
 
 	template<typename IndexT>
-	void topologySortTriList(
-		  TopologySort::Enum  _sort
-		, IndexT* _dst
+	static void calcSortKeys(
+		  TopologySort::Enum _sort
 		, uint32_t* _keys
-		, uint32_t* _values
-		, uint32_t* _tempKeys
-		, uint32_t* _tempValues
-		, uint32_t  _num
 		, const float _dir[3]
 		, const float _pos[3]
 		, const void* _vertices
-		, uint32_t    _stride
+		, uint32_t _stride
 		, const IndexT* _indices
+		, uint32_t _num
 		)
 	{
-		using namespace bx;
-
 		switch (_sort)
 		{
 		default:
-		case TopologySort::DirectionFrontToBackMin: calcSortKeys<IndexT, distanceDir, fmin3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionFrontToBackAvg: calcSortKeys<IndexT, distanceDir, favg3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionFrontToBackMax: calcSortKeys<IndexT, distanceDir, fmax3, 0         >(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontMin: calcSortKeys<IndexT, distanceDir, fmin3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontAvg: calcSortKeys<IndexT, distanceDir, favg3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DirectionBackToFrontMax: calcSortKeys<IndexT, distanceDir, fmax3, UINT32_MAX>(_keys, _values, _dir, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackMin:  calcSortKeys<IndexT, distancePos, fmin3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackAvg:  calcSortKeys<IndexT, distancePos, favg3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceFrontToBackMax:  calcSortKeys<IndexT, distancePos, fmax3, 0         >(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontMin:  calcSortKeys<IndexT, distancePos, fmin3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontAvg:  calcSortKeys<IndexT, distancePos, favg3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
-		case TopologySort::DistanceBackToFrontMax:  calcSortKeys<IndexT, distancePos, fmax3, UINT32_MAX>(_keys, _values, _pos, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DirectionFrontToBackMin: calcSortKeys<IndexT, distanceDir, fmin3, 0         >(_keys, _dir, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DirectionFrontToBackAvg: calcSortKeys<IndexT, distanceDir, favg3, 0         >(_keys, _dir, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DirectionFrontToBackMax: calcSortKeys<IndexT, distanceDir, fmax3, 0         >(_keys, _dir, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DirectionBackToFrontMin: calcSortKeys<IndexT, distanceDir, fmin3, UINT32_MAX>(_keys, _dir, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DirectionBackToFrontAvg: calcSortKeys<IndexT, distanceDir, favg3, UINT32_MAX>(_keys, _dir, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DirectionBackToFrontMax: calcSortKeys<IndexT, distanceDir, fmax3, UINT32_MAX>(_keys, _dir, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DistanceFrontToBackMin:  calcSortKeys<IndexT, distancePos, fmin3, 0         >(_keys, _pos, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DistanceFrontToBackAvg:  calcSortKeys<IndexT, distancePos, favg3, 0         >(_keys, _pos, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DistanceFrontToBackMax:  calcSortKeys<IndexT, distancePos, fmax3, 0         >(_keys, _pos, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DistanceBackToFrontMin:  calcSortKeys<IndexT, distancePos, fmin3, UINT32_MAX>(_keys, _pos, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DistanceBackToFrontAvg:  calcSortKeys<IndexT, distancePos, favg3, UINT32_MAX>(_keys, _pos, _vertices, _stride, _indices, _num); break;
+		case TopologySort::DistanceBackToFrontMax:  calcSortKeys<IndexT, distancePos, fmax3, UINT32_MAX>(_keys, _pos, _vertices, _stride, _indices, _num); break;
+		}
+	}
+
+	// Keys are calculated on multiple threads only for meshes with more triangles than this.
+	static const uint32_t kSortMinTrianglesForThreads = 100000;
+
+	// Minimum number of triangles per thread when keys are calculated on multiple threads.
+	static const uint32_t kSortTrianglesPerJob = 16<<10;
+
+	// Previous order is refined with insertion sort only while number of moved elements is
+	// below this many per triangle, otherwise it falls back to radix sort.
+	static const uint32_t kSortMaxMovesPerTriangle = 2;
+
+	static bool insertionSort(uint32_t* _keys, uint32_t* _values, uint32_t _num, uint32_t _maxMoves)
+	{
+		uint32_t numMoves = 0;
+
+		for (uint32_t ii = 1; ii < _num; ++ii)
+		{
+			const uint32_t key   = _keys[ii];
+			const uint32_t value = _values[ii];
+
+			uint32_t jj = ii;
+			for (; 0 < jj && key < _keys[jj-1]; --jj)
+			{
+				_keys[jj]   = _keys[jj-1];
+				_values[jj] = _values[jj-1];
+			}
+
+			_keys[jj]   = key;
+			_values[jj] = value;
+
+			numMoves += ii - jj;
+			if (numMoves > _maxMoves)
+			{
+				return false;
+			}
 		}
 
-		radixSort(_keys, _tempKeys, _values, _tempValues, _num);
+		return true;
+	}
 
+	template<typename IndexT>
+	static void writeSorted(IndexT* _dst, const IndexT* _indices, const uint32_t* _values, uint32_t _num)
+	{
 		IndexT* sorted = _dst;
 
 		for (uint32_t ii = 0; ii < _num; ++ii)
@@ -378,7 +463,69 @@ namespace bgfx
 		}
 	}
 
-	void topologySortTriList(
+	TopologySorterImpl::TopologySorterImpl(bx::AllocatorI* _allocator)
+		: m_allocator(_allocator)
+		, m_faceKeys(NULL)
+		, m_keys(NULL)
+		, m_values(NULL)
+		, m_tempKeys(NULL)
+		, m_tempValues(NULL)
+		, m_max(0)
+		, m_num(0)
+	{
+	}
+
+	TopologySorterImpl::~TopologySorterImpl()
+	{
+		if (NULL != m_faceKeys)
+		{
+			BX_FREE(m_allocator, m_faceKeys);
+		}
+	}
+
+	void TopologySorterImpl::calcSortKeys(void* _userData, uint32_t _begin, uint32_t _end)
+	{
+		const TopologySorterImpl* sorter = (const TopologySorterImpl*)_userData;
+		const Job& job = sorter->m_job;
+		const uint32_t num = _end - _begin;
+
+		if (job.index32)
+		{
+			bgfx::calcSortKeys(job.sort, &sorter->m_faceKeys[_begin], job.dir, job.pos, job.vertices, job.stride, &( (const uint32_t*)job.indices)[_begin*3], num);
+		}
+		else
+		{
+			bgfx::calcSortKeys(job.sort, &sorter->m_faceKeys[_begin], job.dir, job.pos, job.vertices, job.stride, &( (const uint16_t*)job.indices)[_begin*3], num);
+		}
+	}
+
+	void TopologySorterImpl::reset()
+	{
+		m_num = 0;
+	}
+
+	void TopologySorterImpl::resize(uint32_t _num)
+	{
+		if (_num > m_max)
+		{
+			if (NULL != m_faceKeys)
+			{
+				BX_FREE(m_allocator, m_faceKeys);
+			}
+
+			m_max = _num;
+
+			uint32_t* temp = (uint32_t*)BX_ALLOC(m_allocator, sizeof(uint32_t)*m_max*5);
+			m_faceKeys   = &temp[m_max*0];
+			m_keys       = &temp[m_max*1];
+			m_values     = &temp[m_max*2];
+			m_tempKeys   = &temp[m_max*3];
+			m_tempValues = &temp[m_max*4];
+			m_num        = 0;
+		}
+	}
+
+	void TopologySorterImpl::sort(
 		  TopologySort::Enum  _sort
 		, void*       _dst
 		, uint32_t    _dstSize
@@ -389,57 +536,95 @@ namespace bgfx
 		, const void* _indices
 		, uint32_t    _numIndices
 		, bool        _index32
-		, bx::AllocatorI* _allocator
 		)
 	{
 		uint32_t indexSize = _index32
 			? sizeof(uint32_t)
 			: sizeof(uint16_t)
 			;
-		uint32_t  num  = bx::uint32_min(_numIndices*indexSize, _dstSize)/(indexSize*3);
-		uint32_t* temp = (uint32_t*)BX_ALLOC(_allocator, sizeof(uint32_t)*num*4);
+		uint32_t num = bx::uint32_min(_numIndices*indexSize, _dstSize)/(indexSize*3);
+
+		if (0 == num)
+		{
+			return;
+		}
+
+		resize(num);
+
+		m_job.sort     = _sort;
+		m_job.dir      = _dir;
+		m_job.pos      = _pos;
+		m_job.vertices = _vertices;
+		m_job.stride   = _stride;
+		m_job.indices  = _indices;
+		m_job.index32  = _index32;
+		m_job.num      = num;
+
+		if (num > kSortMinTrianglesForThreads)
+		{
+			parallelFor(calcSortKeys, this, num, kSortTrianglesPerJob);
+		}
+		else
+		{
+			calcSortKeys(this, 0, num);
+		}
+
+		// Values hold permutation of triangles from previous call. Even if indices changed in
+		// between, keys are recalculated, so refining previous order still produces correct
+		// result.
+		bool sorted = false;
 
-		uint32_t* keys       = &temp[num*0];
-		uint32_t* values     = &temp[num*1];
-		uint32_t* tempKeys   = &temp[num*2];
-		uint32_t* tempValues = &temp[num*3];
+		if (num == m_num)
+		{
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				m_keys[ii] = m_faceKeys[m_values[ii] ];
+			}
+
+			sorted = insertionSort(m_keys, m_values, num, num*kSortMaxMovesPerTriangle);
+		}
+		else
+		{
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				m_keys[ii]   = m_faceKeys[ii];
+				m_values[ii] = ii;
+			}
+		}
+
+		if (!sorted)
+		{
+			bx::radixSort(m_keys, m_tempKeys, m_values, m_tempValues, num);
+		}
+
+		m_num = num;
 
 		if (_index32)
 		{
-			topologySortTriList(
-					  _sort
-					, (uint32_t*)_dst
-					, keys
-					, values
-					, tempKeys
-					, tempValues
-					, num
-					, _dir
-					, _pos
-					, _vertices
-					, _stride
-					, (const uint32_t*)_indices
-					);
+			writeSorted( (uint32_t*)_dst, (const uint32_t*)_indices, m_values, num);
 		}
 		else
 		{
-			topologySortTriList(
-					  _sort
-					, (uint16_t*)_dst
-					, keys
-					, values
-					, tempKeys
-					, tempValues
-					, num
-					, _dir
-					, _pos
-					, _vertices
-					, _stride
-					, (const uint16_t*)_indices
-					);
+			writeSorted( (uint16_t*)_dst, (const uint16_t*)_indices, m_values, num);
 		}
+	}
 
-		BX_FREE(_allocator, temp);
+	void topologySortTriList(
+		  TopologySort::Enum  _sort
+		, void*       _dst
+		, uint32_t    _dstSize
+		, const float _dir[3]
+		, const float _pos[3]
+		, const void* _vertices
+		, uint32_t    _stride
+		, const void* _indices
+		, uint32_t    _numIndices
+		, bool        _index32
+		, bx::AllocatorI* _allocator
+		)
+	{
+		TopologySorterImpl sorter(_allocator);
+		sorter.sort(_sort, _dst, _dstSize, _dir, _pos, _vertices, _stride, _indices, _numIndices, _index32);
 	}
 
 } //namespace bgfx
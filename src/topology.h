@@ -51,6 +51,71 @@ namespace bgfx
 		, bx::AllocatorI* _allocator
 		);
 
+	/// Sorts triangle list same as `topologySortTriList`, but keeps scratch memory and sorted
+	/// order between calls. When order changed only a little since previous call (camera moved
+	/// slightly), previous order is refined with insertion sort instead of sorting from scratch.
+	/// Sort keys of meshes with more than 100K triangles are calculated on shared worker threads.
+	///
+	class TopologySorterImpl
+	{
+	public:
+		///
+		TopologySorterImpl(bx::AllocatorI* _allocator);
+
+		///
+		~TopologySorterImpl();
+
+		/// See `topologySortTriList` for parameters.
+		void sort(
+			  TopologySort::Enum _sort
+			, void* _dst
+			, uint32_t _dstSize
+			, const float _dir[3]
+			, const float _pos[3]
+			, const void* _vertices
+			, uint32_t _stride
+			, const void* _indices
+			, uint32_t _numIndices
+			, bool _index32
+			);
+
+		/// Forget previous order, next call will sort from scratch.
+		void reset();
+
+		///
+		bx::AllocatorI* getAllocator() const
+		{
+			return m_allocator;
+		}
+
+	private:
+		struct Job
+		{
+			TopologySort::Enum sort;
+			const float* dir;
+			const float* pos;
+			const void*  vertices;
+			uint32_t     stride;
+			const void*  indices;
+			bool         index32;
+			uint32_t     num;
+		};
+
+		void resize(uint32_t _num);
+		static void calcSortKeys(void* _userData, uint32_t _begin, uint32_t _end);
+
+		Job m_job;
+
+		bx::AllocatorI* m_allocator;
+		uint32_t* m_faceKeys;
+		uint32_t* m_keys;
+		uint32_t* m_values;
+		uint32_t* m_tempKeys;
+		uint32_t* m_tempValues;
+		uint32_t  m_max;
+		uint32_t  m_num;
+	};
+
 } // namespace bgfx
 
 #endif // BGFX_TOPOLOGY_H_HEADER_GUARD
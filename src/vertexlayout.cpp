@@ -5,11 +5,14 @@
 
 #include <bx/debug.h>
 #include <bx/hash.h>
+#include <bx/math.h>
 #include <bx/readerwriter.h>
+#include <bx/simd_t.h>
 #include <bx/sort.h>
 #include <bx/string.h>
 #include <bx/uint32_t.h>
 
+#include "parallel.h"
 #include "vertexlayout.h"
 
 namespace bgfx
@@ -620,32 +623,477 @@ namespace bgfx
 		}
 	}
 
-	void vertexConvert(const VertexLayout& _destLayout, void* _destData, const VertexLayout& _srcLayout, const void* _srcData, uint32_t _num)
+	// Number of vertices converted per attribute pass. Block of unpacked attributes stays in
+	// L1 cache while it's packed into destination. Must be multiple of 4.
+	static const uint32_t kConvertBlockSize = 64;
+	BX_STATIC_ASSERT(0 == kConvertBlockSize%4);
+
+	// Vertices are converted on multiple threads only when there is at least this many of them
+	// per thread.
+	static const uint32_t kConvertMinVerticesPerThread = 64<<10;
+
+	// Returns number of bytes vertexUnpack reads, and vertexPack writes.
+	inline uint8_t getAttribDataSize(AttribType::Enum _type, uint8_t _num)
 	{
-		if (_destLayout.m_hash == _srcLayout.m_hash)
+		switch (_type)
 		{
-			bx::memCopy(_destData, _srcData, _srcLayout.getSize(_num) );
-			return;
+		default:
+		case AttribType::Uint8:  return _num;
+		case AttribType::Uint10: return sizeof(uint32_t);
+		case AttribType::Int16:  return _num*sizeof(int16_t);
+		case AttribType::Half:   return _num*sizeof(uint16_t);
+		case AttribType::Float:  return _num*sizeof(float);
+		}
+	}
+
+	inline bool simdAnyLane(bx::simd128_t _mask)
+	{
+		BX_ALIGN_DECL_16(uint32_t) lanes[4];
+		bx::simd_st(lanes, _mask);
+
+		return 0 != (lanes[0] | lanes[1] | lanes[2] | lanes[3]);
+	}
+
+	// Selects _a in lanes with sign bit of _test set, otherwise _b.
+	inline bx::simd128_t simdSels(bx::simd128_t _test, bx::simd128_t _a, bx::simd128_t _b)
+	{
+		return bx::simd_selb(bx::simd_sra(_test, 31), _a, _b);
+	}
+
+	inline void simdTranspose(bx::simd128_t _result[4], const bx::simd128_t _a[4])
+	{
+		using namespace bx;
+
+		const simd128_t xy01 = simd_shuf_xAyB(_a[0], _a[1]);
+		const simd128_t zw01 = simd_shuf_zCwD(_a[0], _a[1]);
+		const simd128_t xy23 = simd_shuf_xAyB(_a[2], _a[3]);
+		const simd128_t zw23 = simd_shuf_zCwD(_a[2], _a[3]);
+
+		_result[0] = simd_shuf_xyAB(xy01, xy23);
+		_result[1] = simd_shuf_zwCD(xy01, xy23);
+		_result[2] = simd_shuf_xyAB(zw01, zw23);
+		_result[3] = simd_shuf_zwCD(zw01, zw23);
+	}
+
+	// Loads attribute of up to 4 vertices, and transposes it so that each register holds the
+	// same 32-bit word of all 4 vertices. Bytes past _size, and vertices past _num are zero.
+	static void gatherWords(bx::simd128_t _words[4], const uint8_t* _data, uint32_t _stride, uint32_t _num, uint32_t _size)
+	{
+		using namespace bx;
+
+		BX_ALIGN_DECL_16(uint32_t) vertex[4][4] = {};
+
+		for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride)
+		{
+			bx::memCopy(vertex[ii], _data, _size);
 		}
 
-		struct ConvertOp
+		const simd128_t rows[4] =
 		{
-			enum Enum
-			{
-				Set,
-				Copy,
-				Convert,
-			};
-
-			Attrib::Enum attr;
-			Enum op;
-			uint32_t src;
-			uint32_t dest;
-			uint32_t size;
+			simd_ld<simd128_t>(vertex[0]),
+			simd_ld<simd128_t>(vertex[1]),
+			simd_ld<simd128_t>(vertex[2]),
+			simd_ld<simd128_t>(vertex[3]),
 		};
 
-		ConvertOp convertOp[Attrib::Count];
-		uint32_t numOps = 0;
+		simdTranspose(_words, rows);
+	}
+
+	// Inverse of gatherWords, writes only first _size bytes of each vertex.
+	static void scatterWords(uint8_t* _data, uint32_t _stride, uint32_t _num, uint32_t _size, const bx::simd128_t _words[4])
+	{
+		using namespace bx;
+
+		simd128_t rows[4];
+		simdTranspose(rows, _words);
+
+		BX_ALIGN_DECL_16(uint32_t) vertex[4][4];
+		simd_st(vertex[0], rows[0]);
+		simd_st(vertex[1], rows[1]);
+		simd_st(vertex[2], rows[2]);
+		simd_st(vertex[3], rows[3]);
+
+		for (uint32_t ii = 0; ii < _num; ++ii, _data += _stride)
+		{
+			bx::memCopy(_data, vertex[ii], _size);
+		}
+	}
+
+	// Converts 4 halves in low 16 bits of each lane, same result as bx::halfToFloat. Half
+	// denormals need normalization shift that differs per lane, registers with any of them go
+	// through bx::halfToFloat.
+	static bx::simd128_t simdHalfToFloat(bx::simd128_t _a)
+	{
+		using namespace bx;
+
+		const simd128_t zero     = simd_zero<simd128_t>();
+		const simd128_t h_e      = simd_and(_a, simd_isplat<simd128_t>(0x00007c00) );
+		const simd128_t h_m      = simd_and(_a, simd_isplat<simd128_t>(0x000003ff) );
+		const simd128_t is_e_eqz = simd_icmpeq(h_e, zero);
+		const simd128_t is_m_eqz = simd_icmpeq(h_m, zero);
+
+		if (BX_UNLIKELY(simdAnyLane(simd_andc(is_e_eqz, is_m_eqz) ) ) )
+		{
+			BX_ALIGN_DECL_16(uint32_t) lanes[4];
+			simd_st(lanes, _a);
+
+			return simd_ld<simd128_t>(
+				  bx::halfToFloat(uint16_t(lanes[0]) )
+				, bx::halfToFloat(uint16_t(lanes[1]) )
+				, bx::halfToFloat(uint16_t(lanes[2]) )
+				, bx::halfToFloat(uint16_t(lanes[3]) )
+				);
+		}
+
+		const simd128_t f_s          = simd_sll(simd_and(_a, simd_isplat<simd128_t>(0x00008000) ), 16);
+		const simd128_t f_e          = simd_sll(simd_iadd(h_e, simd_isplat<simd128_t>(0x0001c000) ), 13);
+		const simd128_t f_m          = simd_sll(h_m, 13);
+		const simd128_t f_em         = simd_selb(is_e_eqz, zero, simd_or(f_e, f_m) );
+		const simd128_t f_em_nan     = simd_or(simd_isplat<simd128_t>(0x7f800000), f_m);
+		const simd128_t is_e_flagged = simd_icmpeq(h_e, simd_isplat<simd128_t>(0x00007c00) );
+
+		return simd_or(f_s, simd_selb(is_e_flagged, f_em_nan, f_em) );
+	}
+
+	// Converts 4 floats to halves in low 16 bits of each lane, with the same branch-free
+	// operations as bx::halfFromFloat. Floats which become half denormals need shift that
+	// differs per lane, registers with any of them go through bx::halfFromFloat. Zero and
+	// float denormals always convert to signed zero.
+	static bx::simd128_t simdHalfFromFloat(bx::simd128_t _a)
+	{
+		using namespace bx;
+
+		const simd128_t zero       = simd_zero<simd128_t>();
+		const simd128_t one        = simd_isplat<simd128_t>(0x00000001);
+		const simd128_t f_e        = simd_and(_a, simd_isplat<simd128_t>(0x7f800000) );
+		const simd128_t f_e_amount = simd_srl(f_e, 23);
+
+		const simd128_t is_h_denorm = simd_and(
+			  simd_icmpgt(f_e_amount, zero)
+			, simd_icmplt(f_e_amount, simd_isplat<simd128_t>(0x00000071) )
+			);
+
+		if (BX_UNLIKELY(simdAnyLane(is_h_denorm) ) )
+		{
+			BX_ALIGN_DECL_16(float) lanes[4];
+			simd_st(lanes, _a);
+
+			return simd_ild<simd128_t>(
+				  bx::halfFromFloat(lanes[0])
+				, bx::halfFromFloat(lanes[1])
+				, bx::halfFromFloat(lanes[2])
+				, bx::halfFromFloat(lanes[3])
+				);
+		}
+
+		const simd128_t f_s                       = simd_and(_a, simd_isplat<simd128_t>(0x80000000) );
+		const simd128_t f_m                       = simd_and(_a, simd_isplat<simd128_t>(0x007fffff) );
+		const simd128_t h_s                       = simd_srl(f_s, 16);
+		const simd128_t f_e_half_bias             = simd_isub(f_e_amount, simd_isplat<simd128_t>(0x00000070) );
+		const simd128_t f_snan                    = simd_and(_a, simd_isplat<simd128_t>(0x7fc00000) );
+		const simd128_t f_m_round_mask            = simd_and(f_m, simd_isplat<simd128_t>(0x00001000) );
+		const simd128_t f_m_round_offset          = simd_sll(f_m_round_mask, 1);
+		const simd128_t f_m_rounded               = simd_iadd(f_m, f_m_round_offset);
+		const simd128_t f_m_rounded_overflow      = simd_and(f_m_rounded, simd_isplat<simd128_t>(0x00800000) );
+		const simd128_t m_nan                     = simd_srl(f_m, 13);
+		const simd128_t h_em_nan                  = simd_or(simd_isplat<simd128_t>(0x00007c00), m_nan);
+		const simd128_t h_e_norm_overflow         = simd_sll(simd_iadd(f_e_half_bias, one), 10);
+		const simd128_t h_e_norm                  = simd_sll(f_e_half_bias, 10);
+		const simd128_t h_m_norm                  = simd_srl(f_m_rounded, 13);
+		const simd128_t h_em_norm                 = simd_or(h_e_norm, h_m_norm);
+		const simd128_t is_h_ndenorm_msb          = simd_isub(simd_isplat<simd128_t>(0x00000070), f_e_amount);
+		const simd128_t is_f_e_flagged_msb        = simd_isub(simd_isplat<simd128_t>(0x0000008f), f_e_half_bias);
+		const simd128_t is_h_denorm_msb           = simd_xor(is_h_ndenorm_msb, simd_isplat<simd128_t>(UINT32_MAX) );
+		const simd128_t is_f_m_eqz_msb            = simd_isub(f_m, one);
+		const simd128_t is_h_nan_eqz_msb          = simd_isub(m_nan, one);
+		const simd128_t is_f_inf_msb              = simd_and(is_f_e_flagged_msb, is_f_m_eqz_msb);
+		const simd128_t is_f_nan_underflow_msb    = simd_and(is_f_e_flagged_msb, is_h_nan_eqz_msb);
+		const simd128_t is_e_overflow_msb         = simd_isub(simd_isplat<simd128_t>(0x0000001f), f_e_half_bias);
+		const simd128_t is_h_inf_msb              = simd_or(is_e_overflow_msb, is_f_inf_msb);
+		const simd128_t is_f_nsnan_msb            = simd_isub(f_snan, simd_isplat<simd128_t>(0x7fc00000) );
+		const simd128_t is_m_norm_overflow_msb    = simd_isub(zero, f_m_rounded_overflow);
+		const simd128_t is_f_snan_msb             = simd_xor(is_f_nsnan_msb, simd_isplat<simd128_t>(UINT32_MAX) );
+		const simd128_t h_em_overflow_result      = simdSels(is_m_norm_overflow_msb, h_e_norm_overflow, h_em_norm);
+		const simd128_t h_em_nan_result           = simdSels(is_f_e_flagged_msb, h_em_nan, h_em_overflow_result);
+		const simd128_t h_em_nan_underflow_result = simdSels(is_f_nan_underflow_msb, simd_isplat<simd128_t>(0x00007c01), h_em_nan_result);
+		const simd128_t h_em_inf_result           = simdSels(is_h_inf_msb, simd_isplat<simd128_t>(0x00007c00), h_em_nan_underflow_result);
+		const simd128_t h_em_denorm_result        = simdSels(is_h_denorm_msb, zero, h_em_inf_result);
+		const simd128_t h_em_snan_result          = simdSels(is_f_snan_msb, simd_isplat<simd128_t>(0x00007e00), h_em_denorm_result);
+
+		return simd_and(simd_or(h_s, h_em_snan_result), simd_isplat<simd128_t>(0x0000ffff) );
+	}
+
+	// Unpacks block of attributes into groups of 4 registers, x, y, z and w component of 4
+	// vertices. Arithmetic and order of operations match vertexUnpack exactly, so results are
+	// bit-exact with it. Components past _numComp are zero.
+	static void unpackBlock(bx::simd128_t* _output, const uint8_t* _data, uint32_t _stride, uint32_t _num, AttribType::Enum _type, uint8_t _numComp, bool _asInt, uint32_t _size)
+	{
+		using namespace bx;
+
+		const simd128_t zero = simd_zero<simd128_t>();
+
+		simd128_t words[4];
+
+		switch (_type)
+		{
+		default:
+		case AttribType::Uint8:
+			{
+				const simd128_t mask  = simd_isplat<simd128_t>(0xff);
+				const simd128_t bias  = simd_splat<simd128_t>(_asInt ? 128.0f : 0.0f);
+				const simd128_t scale = simd_splat<simd128_t>(_asInt ? 127.0f : 255.0f);
+
+				for (uint32_t ii = 0; ii < _num; ii += 4, _data += 4*_stride, _output += 4)
+				{
+					gatherWords(words, _data, _stride, bx::min<uint32_t>(_num - ii, 4), _size);
+
+					const simd128_t unpacked[4] =
+					{
+						simd_itof(simd_and(words[0], mask) ),
+						simd_itof(simd_and(simd_srl(words[0],  8), mask) ),
+						simd_itof(simd_and(simd_srl(words[0], 16), mask) ),
+						simd_itof(simd_srl(words[0], 24) ),
+					};
+
+					for (uint32_t jj = 0; jj < 4; ++jj)
+					{
+						_output[jj] = jj >= _numComp ? zero
+							: _asInt
+							? simd_div(simd_sub(unpacked[jj], bias), scale)
+							: simd_div(unpacked[jj], scale)
+							;
+					}
+				}
+			}
+			break;
+
+		case AttribType::Uint10:
+			{
+				// Uint10 holds at most 3 components, first one in lowest bits.
+				const uint32_t numComp = bx::min<uint32_t>(_numComp, 3);
+
+				const simd128_t mask  = simd_isplat<simd128_t>(0x3ff);
+				const simd128_t bias  = simd_splat<simd128_t>(512.0f);
+				const simd128_t scale = simd_splat<simd128_t>(_asInt ? 511.0f : 1023.0f);
+
+				for (uint32_t ii = 0; ii < _num; ii += 4, _data += 4*_stride, _output += 4)
+				{
+					gatherWords(words, _data, _stride, bx::min<uint32_t>(_num - ii, 4), _size);
+
+					const simd128_t unpacked[3] =
+					{
+						simd_itof(simd_and(words[0], mask) ),
+						simd_itof(simd_and(simd_srl(words[0], 10), mask) ),
+						simd_itof(simd_and(simd_srl(words[0], 20), mask) ),
+					};
+
+					for (uint32_t jj = 0; jj < 3; ++jj)
+					{
+						_output[jj] = jj >= numComp ? zero
+							: _asInt
+							? simd_div(simd_sub(unpacked[jj], bias), scale)
+							: simd_div(unpacked[jj], scale)
+							;
+					}
+
+					_output[3] = zero;
+				}
+			}
+			break;
+
+		case AttribType::Int16:
+			{
+				const simd128_t bias  = simd_splat<simd128_t>(32768.0f);
+				const simd128_t scale = simd_splat<simd128_t>(_asInt ? 32767.0f : 65535.0f);
+
+				for (uint32_t ii = 0; ii < _num; ii += 4, _data += 4*_stride, _output += 4)
+				{
+					gatherWords(words, _data, _stride, bx::min<uint32_t>(_num - ii, 4), _size);
+
+					// Sign extend 16-bit components.
+					const simd128_t unpacked[4] =
+					{
+						simd_itof(simd_sra(simd_sll(words[0], 16), 16) ),
+						simd_itof(simd_sra(words[0], 16) ),
+						simd_itof(simd_sra(simd_sll(words[1], 16), 16) ),
+						simd_itof(simd_sra(words[1], 16) ),
+					};
+
+					for (uint32_t jj = 0; jj < 4; ++jj)
+					{
+						_output[jj] = jj >= _numComp ? zero
+							: _asInt
+							? simd_div(unpacked[jj], scale)
+							: simd_div(simd_add(unpacked[jj], bias), scale)
+							;
+					}
+				}
+			}
+			break;
+
+		case AttribType::Half:
+			{
+				const simd128_t mask = simd_isplat<simd128_t>(0xffff);
+
+				for (uint32_t ii = 0; ii < _num; ii += 4, _data += 4*_stride, _output += 4)
+				{
+					gatherWords(words, _data, _stride, bx::min<uint32_t>(_num - ii, 4), _size);
+
+					_output[0] =                simdHalfToFloat(simd_and(words[0], mask) );
+					_output[1] = 1 < _numComp ? simdHalfToFloat(simd_srl(words[0], 16) )   : zero;
+					_output[2] = 2 < _numComp ? simdHalfToFloat(simd_and(words[1], mask) ) : zero;
+					_output[3] = 3 < _numComp ? simdHalfToFloat(simd_srl(words[1], 16) )   : zero;
+				}
+			}
+			break;
+
+		case AttribType::Float:
+			// Words past _size are zero already.
+			for (uint32_t ii = 0; ii < _num; ii += 4, _data += 4*_stride, _output += 4)
+			{
+				gatherWords(_output, _data, _stride, bx::min<uint32_t>(_num - ii, 4), _size);
+			}
+			break;
+		}
+	}
+
+	// Packs block of normalized components in layout produced by unpackBlock. Matches
+	// vertexPack with _inputNormalized set.
+	static void packBlock(uint8_t* _data, uint32_t _stride, const bx::simd128_t* _input, uint32_t _num, AttribType::Enum _type, uint8_t _numComp, bool _asInt, uint32_t _size)
+	{
+		using namespace bx;
+
+		const simd128_t zero = simd_zero<simd128_t>();
+
+		simd128_t words[4] = { zero, zero, zero, zero };
+
+		switch (_type)
+		{
+		default:
+		case AttribType::Uint8:
+			{
+				const simd128_t mask  = simd_isplat<simd128_t>(0xff);
+				const simd128_t bias  = simd_splat<simd128_t>(128.0f);
+				const simd128_t scale = simd_splat<simd128_t>(_asInt ? 127.0f : 255.0f);
+
+				for (uint32_t ii = 0; ii < _num; ii += 4, _data += 4*_stride, _input += 4)
+				{
+					simd128_t packed[4];
+
+					for (uint32_t jj = 0; jj < 4; ++jj)
+					{
+						const simd128_t scaled = simd_mul(_input[jj], scale);
+						packed[jj] = simd_and(simd_ftoi(_asInt ? simd_add(scaled, bias) : scaled), mask);
+					}
+
+					words[0] = simd_or(
+						  simd_or(packed[0], simd_sll(packed[1],  8) )
+						, simd_or(simd_sll(packed[2], 16), simd_sll(packed[3], 24) )
+						);
+
+					scatterWords(_data, _stride, bx::min<uint32_t>(_num - ii, 4), _size, words);
+				}
+			}
+			break;
+
+		case AttribType::Uint10:
+			{
+				const simd128_t bias  = simd_splat<simd128_t>(512.0f);
+				const simd128_t scale = simd_splat<simd128_t>(_asInt ? 511.0f : 1023.0f);
+
+				for (uint32_t ii = 0; ii < _num; ii += 4, _data += 4*_stride, _input += 4)
+				{
+					simd128_t packed[3];
+
+					for (uint32_t jj = 0; jj < 3; ++jj)
+					{
+						const simd128_t scaled = simd_mul(_input[jj], scale);
+						packed[jj] = simd_ftoi(_asInt ? simd_add(scaled, bias) : scaled);
+					}
+
+					// First component ends up in highest bits, same as vertexPack.
+					switch (_numComp)
+					{
+					case 1:  words[0] = packed[0]; break;
+					case 2:  words[0] = simd_or(simd_sll(packed[0], 10), packed[1]); break;
+					default: words[0] = simd_or(simd_or(simd_sll(packed[0], 20), simd_sll(packed[1], 10) ), packed[2]); break;
+					}
+
+					scatterWords(_data, _stride, bx::min<uint32_t>(_num - ii, 4), _size, words);
+				}
+			}
+			break;
+
+		case AttribType::Int16:
+			{
+				const simd128_t mask  = simd_isplat<simd128_t>(0xffff);
+				const simd128_t bias  = simd_splat<simd128_t>(32768.0f);
+				const simd128_t scale = simd_splat<simd128_t>(_asInt ? 32767.0f : 65535.0f);
+
+				for (uint32_t ii = 0; ii < _num; ii += 4, _data += 4*_stride, _input += 4)
+				{
+					simd128_t packed[4];
+
+					for (uint32_t jj = 0; jj < 4; ++jj)
+					{
+						const simd128_t scaled = simd_mul(_input[jj], scale);
+						packed[jj] = simd_ftoi(_asInt ? scaled : simd_sub(scaled, bias) );
+					}
+
+					words[0] = simd_or(simd_and(packed[0], mask), simd_sll(packed[1], 16) );
+					words[1] = simd_or(simd_and(packed[2], mask), simd_sll(packed[3], 16) );
+
+					scatterWords(_data, _stride, bx::min<uint32_t>(_num - ii, 4), _size, words);
+				}
+			}
+			break;
+
+		case AttribType::Half:
+			for (uint32_t ii = 0; ii < _num; ii += 4, _data += 4*_stride, _input += 4)
+			{
+				const simd128_t packed[4] =
+				{
+					               simdHalfFromFloat(_input[0]),
+					1 < _numComp ? simdHalfFromFloat(_input[1]) : zero,
+					2 < _numComp ? simdHalfFromFloat(_input[2]) : zero,
+					3 < _numComp ? simdHalfFromFloat(_input[3]) : zero,
+				};
+
+				words[0] = simd_or(packed[0], simd_sll(packed[1], 16) );
+				words[1] = simd_or(packed[2], simd_sll(packed[3], 16) );
+
+				scatterWords(_data, _stride, bx::min<uint32_t>(_num - ii, 4), _size, words);
+			}
+			break;
+
+		case AttribType::Float:
+			for (uint32_t ii = 0; ii < _num; ii += 4, _data += 4*_stride, _input += 4)
+			{
+				scatterWords(_data, _stride, bx::min<uint32_t>(_num - ii, 4), _size, _input);
+			}
+			break;
+		}
+	}
+
+	VertexConvertPlan::VertexConvertPlan()
+		: m_numOps(0)
+		, m_srcStride(0)
+		, m_destStride(0)
+		, m_memCopy(false)
+	{
+	}
+
+	void VertexConvertPlan::init(const VertexLayout& _destLayout, const VertexLayout& _srcLayout)
+	{
+		m_numOps     = 0;
+		m_srcStride  = _srcLayout.getStride();
+		m_destStride = _destLayout.getStride();
+		m_memCopy    = _destLayout.m_hash == _srcLayout.m_hash;
+
+		if (m_memCopy)
+		{
+			return;
+		}
 
 		for (uint32_t ii = 0; ii < Attrib::Count; ++ii)
 		{
@@ -653,70 +1101,125 @@ namespace bgfx
 
 			if (_destLayout.has(attr) )
 			{
-				ConvertOp& cop = convertOp[numOps];
-				cop.attr = attr;
-				cop.dest = _destLayout.getOffset(attr);
+				Op& op = m_op[m_numOps];
+				op.dest = _destLayout.getOffset(attr);
+				op.src  = 0;
 
 				uint8_t num;
 				AttribType::Enum type;
 				bool normalized;
 				bool asInt;
 				_destLayout.decode(attr, num, type, normalized, asInt);
-				cop.size = (*s_attribTypeSize[0])[type][num-1];
+				op.size      = (*s_attribTypeSize[0])[type][num-1];
+				op.destType  = uint8_t(type);
+				op.destNum   = num;
+				op.destSize  = getAttribDataSize(type, num);
+				op.destAsInt = asInt;
 
 				if (_srcLayout.has(attr) )
 				{
-					cop.src = _srcLayout.getOffset(attr);
-					cop.op = _destLayout.m_attributes[attr] == _srcLayout.m_attributes[attr] ? ConvertOp::Copy : ConvertOp::Convert;
+					op.src = _srcLayout.getOffset(attr);
+					op.op  = _destLayout.m_attributes[attr] == _srcLayout.m_attributes[attr] ? Op::Copy : Op::Convert;
+
+					_srcLayout.decode(attr, num, type, normalized, asInt);
+					op.srcType  = uint8_t(type);
+					op.srcNum   = num;
+					op.srcSize  = getAttribDataSize(type, num);
+					op.srcAsInt = asInt;
 				}
 				else
 				{
-					cop.op = ConvertOp::Set;
+					op.op = Op::Set;
 				}
 
-				++numOps;
+				++m_numOps;
 			}
 		}
+	}
 
-		if (0 < numOps)
+	void VertexConvertPlan::convert(void* _destData, const void* _srcData, uint32_t _num) const
+	{
+		if (m_memCopy)
 		{
-			const uint8_t* src = (const uint8_t*)_srcData;
-			uint32_t srcStride = _srcLayout.getStride();
+			bx::memCopy(_destData, _srcData, _num*m_srcStride);
+			return;
+		}
 
-			uint8_t* dest = (uint8_t*)_destData;
-			uint32_t destStride = _destLayout.getStride();
+		const uint8_t* src = (const uint8_t*)_srcData;
+		uint8_t* dest = (uint8_t*)_destData;
 
-			float unpacked[4];
+		bx::simd128_t unpacked[kConvertBlockSize];
 
-			for (uint32_t ii = 0; ii < _num; ++ii)
+		for (uint32_t ii = 0; ii < _num; ii += kConvertBlockSize)
+		{
+			const uint32_t num = bx::min<uint32_t>(_num - ii, kConvertBlockSize);
+
+			for (uint32_t jj = 0; jj < m_numOps; ++jj)
 			{
-				for (uint32_t jj = 0; jj < numOps; ++jj)
-				{
-					const ConvertOp& cop = convertOp[jj];
+				const Op& op = m_op[jj];
+				uint8_t* opDest = dest + op.dest;
 
-					switch (cop.op)
+				switch (op.op)
+				{
+				case Op::Set:
+					for (uint32_t kk = 0; kk < num; ++kk, opDest += m_destStride)
 					{
-					case ConvertOp::Set:
-						bx::memSet(dest + cop.dest, 0, cop.size);
-						break;
-
-					case ConvertOp::Copy:
-						bx::memCopy(dest + cop.dest, src + cop.src, cop.size);
-						break;
+						bx::memSet(opDest, 0, op.size);
+					}
+					break;
 
-					case ConvertOp::Convert:
-						vertexUnpack(unpacked, cop.attr, _srcLayout, src);
-						vertexPack(unpacked, true, cop.attr, _destLayout, dest);
-						break;
+				case Op::Copy:
+					{
+						const uint8_t* opSrc = src + op.src;
+						for (uint32_t kk = 0; kk < num; ++kk, opSrc += m_srcStride, opDest += m_destStride)
+						{
+							bx::memCopy(opDest, opSrc, op.size);
+						}
 					}
-				}
+					break;
 
-				src += srcStride;
-				dest += destStride;
+				case Op::Convert:
+					unpackBlock(unpacked, src + op.src, m_srcStride, num, AttribType::Enum(op.srcType), op.srcNum, op.srcAsInt, op.srcSize);
+					packBlock(opDest, m_destStride, unpacked, num, AttribType::Enum(op.destType), op.destNum, op.destAsInt, op.destSize);
+					break;
+				}
 			}
+
+			src  += num*m_srcStride;
+			dest += num*m_destStride;
 		}
 	}
 
+	struct VertexConvertJob
+	{
+		const VertexConvertPlan* plan;
+		uint8_t*       dest;
+		const uint8_t* src;
+	};
+
+	static void vertexConvertRange(void* _userData, uint32_t _begin, uint32_t _end)
+	{
+		const VertexConvertJob& job = *(const VertexConvertJob*)_userData;
+		job.plan->convert(
+			  job.dest + _begin*job.plan->m_destStride
+			, job.src  + _begin*job.plan->m_srcStride
+			, _end - _begin
+			);
+	}
+
+	void vertexConvert(const VertexLayout& _destLayout, void* _destData, const VertexLayout& _srcLayout, const void* _srcData, uint32_t _num)
+	{
+		VertexConvertPlan plan;
+		plan.init(_destLayout, _srcLayout);
+
+		VertexConvertJob job;
+		job.plan = &plan;
+		job.dest = (uint8_t*)_destData;
+		job.src  = (const uint8_t*)_srcData;
+
+		parallelFor(vertexConvertRange, &job, _num, kConvertMinVerticesPerThread);
+	}
+
 	inline float sqLength(const float _a[3], const float _b[3])
 	{
 		const float xx = _a[0] - _b[0];
@@ -725,104 +1228,211 @@ namespace bgfx
 		return xx*xx + yy*yy + zz*zz;
 	}
 
-	template<typename IndexT>
-	static IndexT weldVerticesRef(IndexT* _output, const VertexLayout& _layout, const void* _data, uint32_t _num, float _epsilon)
-	{
-		// Brute force slow vertex welding...
-		const float epsilonSq = _epsilon*_epsilon;
-
-		uint32_t numVertices = 0;
-		bx::memSet(_output, 0xff, _num*sizeof(IndexT) );
+	// Vertices are prepared on multiple threads only when there is at least this many of them
+	// per thread.
+	static const uint32_t kWeldMinVerticesPerThread = 64<<10;
 
-		for (uint32_t ii = 0; ii < _num; ++ii)
-		{
-			if (IndexT(-1) != _output[ii])
-			{
-				continue;
-			}
+	// Maximum number of grid cells along each axis of mesh bounds. Cell coordinates and their
+	// neighbours fit into int32_t, and cells are never so large that they'd hold big part of
+	// mesh.
+	static const double kWeldMaxCells = double(1<<20);
 
-			_output[ii] = (IndexT)ii;
-			++numVertices;
+	struct WeldPrepareJob
+	{
+		const VertexConvertPlan* plan;
+		const uint8_t* data;
+		float*   attribs;
+		int32_t* cell;
+		uint32_t srcStride;
+		uint32_t numAttribs;
+		float    min[3];
+		double   invCellSize;
+	};
 
-			float pos[4];
-			vertexUnpack(pos, Attrib::Position, _layout, _data, ii);
+	// Unpacks compared attributes to floats.
+	static void weldConvert(void* _userData, uint32_t _begin, uint32_t _end)
+	{
+		const WeldPrepareJob& job = *(const WeldPrepareJob*)_userData;
+		job.plan->convert(job.attribs + _begin*job.numAttribs, job.data + _begin*job.srcStride, _end - _begin);
+	}
 
-			for (uint32_t jj = 0; jj < _num; ++jj)
-			{
-				if (IndexT(-1) != _output[jj])
-				{
-					continue;
-				}
+	// Quantizes position to grid cell relative to minimum of mesh bounds.
+	static void weldQuantize(void* _userData, uint32_t _begin, uint32_t _end)
+	{
+		const WeldPrepareJob& job = *(const WeldPrepareJob*)_userData;
 
-				float test[4];
-				vertexUnpack(test, Attrib::Position, _layout, _data, jj);
+		const float* attribs = job.attribs + _begin*job.numAttribs;
+		int32_t* cell = job.cell + _begin*3;
 
-				if (sqLength(test, pos) < epsilonSq)
-				{
-					_output[jj] = IndexT(ii);
-				}
+		for (uint32_t ii = _begin; ii < _end; ++ii, attribs += job.numAttribs, cell += 3)
+		{
+			for (uint32_t jj = 0; jj < 3; ++jj)
+			{
+				cell[jj] = int32_t( (double(attribs[jj]) - double(job.min[jj]) ) * job.invCellSize);
 			}
 		}
+	}
 
-		return IndexT(numVertices);
+	inline uint32_t weldCellHash(int32_t _x, int32_t _y, int32_t _z)
+	{
+		return 0
+			^ (uint32_t(_x) * 73856093u)
+			^ (uint32_t(_y) * 19349663u)
+			^ (uint32_t(_z) * 83492791u)
+			;
 	}
 
 	template<typename IndexT>
-	static IndexT weldVertices(IndexT* _output, const VertexLayout& _layout, const void* _data, uint32_t _num, float _epsilon, bx::AllocatorI* _allocator)
+	static IndexT weldVertices(IndexT* _output, void* _outVertices, const VertexLayout& _layout, const void* _data, uint32_t _num, float _epsilon, bool _attributes, bx::AllocatorI* _allocator)
 	{
+		const float epsilonSq = _epsilon*_epsilon;
+
+		VertexLayout weldLayout;
+		weldLayout.begin();
+		weldLayout.add(Attrib::Position, 3, AttribType::Float);
+
+		if (_attributes)
+		{
+			weldLayout.add(Attrib::Normal,    3, AttribType::Float);
+			weldLayout.add(Attrib::TexCoord0, 2, AttribType::Float);
+		}
+
+		weldLayout.end();
+
+		const uint32_t numAttribs = weldLayout.getStride()/sizeof(float);
+
+		VertexConvertPlan plan;
+		plan.init(weldLayout, _layout);
+
 		const uint32_t hashSize = bx::uint32_nextpow2(_num);
 		const uint32_t hashMask = hashSize-1;
-		const float epsilonSq = _epsilon*_epsilon;
 
-		uint32_t numVertices = 0;
+		const uint32_t size = 0
+			+ _num*numAttribs*sizeof(float)
+			+ _num*3*sizeof(int32_t)
+			+ (hashSize + _num)*sizeof(uint32_t)
+			;
+		uint8_t* mem = (uint8_t*)BX_ALLOC(_allocator, size);
+
+		float*    attribs   = (float*)mem;
+		int32_t*  cell      = (int32_t*)&attribs[_num*numAttribs];
+		uint32_t* hashTable = (uint32_t*)&cell[_num*3];
+		uint32_t* next      = hashTable + hashSize;
+		bx::memSet(hashTable, 0xff, hashSize*sizeof(uint32_t) );
+
+		WeldPrepareJob job;
+		job.plan       = &plan;
+		job.data       = (const uint8_t*)_data;
+		job.attribs    = attribs;
+		job.cell       = cell;
+		job.srcStride  = _layout.getStride();
+		job.numAttribs = numAttribs;
+
+		parallelFor(weldConvert, &job, _num, kWeldMinVerticesPerThread);
+
+		// Positions are quantized to grid with cell size of at least epsilon, so any two
+		// vertices within epsilon are in the same or in neighbouring cells. Cell size grows
+		// with mesh bounds when epsilon is tiny compared to them.
+		float max[3] = { -bx::kFloatMax, -bx::kFloatMax, -bx::kFloatMax };
+		job.min[0] = job.min[1] = job.min[2] = bx::kFloatMax;
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const float* pos = &attribs[ii*numAttribs];
+
+			for (uint32_t jj = 0; jj < 3; ++jj)
+			{
+				job.min[jj] = bx::min(job.min[jj], pos[jj]);
+				max[jj]     = bx::max(max[jj],     pos[jj]);
+			}
+		}
 
-		const uint32_t size = sizeof(IndexT)*(hashSize + _num);
-		IndexT* hashTable = (IndexT*)BX_ALLOC(_allocator, size);
-		bx::memSet(hashTable, 0xff, size);
+		double extent = 0.0;
+		for (uint32_t jj = 0; jj < 3 && 0 < _num; ++jj)
+		{
+			extent = bx::max(extent, double(max[jj]) - double(job.min[jj]) );
+		}
 
-		IndexT* next = hashTable + hashSize;
+		const double cellSize = bx::max(double(_epsilon), extent/kWeldMaxCells);
+		job.invCellSize = 0.0 < cellSize ? 1.0/cellSize : 1.0;
+
+		parallelFor(weldQuantize, &job, _num, kWeldMinVerticesPerThread);
+
+		const uint8_t* src = (const uint8_t*)_data;
+		uint8_t* dst = (uint8_t*)_outVertices;
+		const uint32_t stride = _layout.getStride();
+
+		uint32_t numVertices = 0;
 
 		for (uint32_t ii = 0; ii < _num; ++ii)
 		{
-			float pos[4];
-			vertexUnpack(pos, Attrib::Position, _layout, _data, ii);
-			uint32_t hashValue = bx::hash<bx::HashMurmur2A>(pos, 3*sizeof(float) ) & hashMask;
+			const float*   attr = &attribs[ii*numAttribs];
+			const int32_t* xyz  = &cell[ii*3];
 
-			IndexT offset = hashTable[hashValue];
-			for (; IndexT(-1) != offset; offset = next[offset])
+			uint32_t weld = UINT32_MAX;
+
+			for (int32_t zz = xyz[2]-1; zz <= xyz[2]+1 && UINT32_MAX == weld; ++zz)
+			for (int32_t yy = xyz[1]-1; yy <= xyz[1]+1 && UINT32_MAX == weld; ++yy)
+			for (int32_t xx = xyz[0]-1; xx <= xyz[0]+1 && UINT32_MAX == weld; ++xx)
 			{
-				float test[4];
-				vertexUnpack(test, Attrib::Position, _layout, _data, _output[offset]);
+				const uint32_t hashValue = weldCellHash(xx, yy, zz) & hashMask;
 
-				if (sqLength(test, pos) < epsilonSq)
+				for (uint32_t offset = hashTable[hashValue]; UINT32_MAX != offset; offset = next[offset])
 				{
-					_output[ii] = _output[offset];
-					break;
+					const float* test = &attribs[offset*numAttribs];
+
+					if (sqLength(test, attr) < epsilonSq
+					&& (!_attributes
+						|| (sqLength(&test[3], &attr[3]) < epsilonSq
+						&&  bx::square(test[6]-attr[6]) + bx::square(test[7]-attr[7]) < epsilonSq) ) )
+					{
+						weld = offset;
+						break;
+					}
 				}
 			}
 
-			if (IndexT(-1) == offset)
+			if (UINT32_MAX != weld)
+			{
+				_output[ii] = _output[weld];
+			}
+			else
 			{
-				_output[ii] = IndexT(ii);
+				// Compared attributes are already unpacked, so unique vertices can be compacted
+				// in place.
+				if (NULL != dst
+				&&  (dst != src || numVertices != ii) )
+				{
+					bx::memCopy(&dst[numVertices*stride], &src[ii*stride], stride);
+				}
+
+				_output[ii] = IndexT(NULL != dst ? numVertices : ii);
+
+				const uint32_t hashValue = weldCellHash(xyz[0], xyz[1], xyz[2]) & hashMask;
 				next[ii] = hashTable[hashValue];
-				hashTable[hashValue] = IndexT(ii);
+				hashTable[hashValue] = ii;
 				numVertices++;
 			}
 		}
 
-		BX_FREE(_allocator, hashTable);
+		BX_FREE(_allocator, mem);
 
 		return IndexT(numVertices);
 	}
 
-	uint32_t weldVertices(void* _output, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, bx::AllocatorI* _allocator)
+	uint32_t weldVertices(void* _output, void* _outVertices, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, bool _attributes, bx::AllocatorI* _allocator)
 	{
 		if (_index32)
 		{
-			return weldVertices( (uint32_t*)_output, _layout, _data, _num, _epsilon, _allocator);
+			return weldVertices( (uint32_t*)_output, _outVertices, _layout, _data, _num, _epsilon, _attributes, _allocator);
 		}
 
-		return weldVertices( (uint16_t*)_output, _layout, _data, _num, _epsilon, _allocator);
+		return weldVertices( (uint16_t*)_output, _outVertices, _layout, _data, _num, _epsilon, _attributes, _allocator);
+	}
+
+	uint32_t weldVertices(void* _output, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, bx::AllocatorI* _allocator)
+	{
+		return weldVertices(_output, NULL, _layout, _data, _num, _index32, _epsilon, false, _allocator);
 	}
 
 } // namespace bgfx
@@ -35,9 +35,62 @@ namespace bgfx
 	///
 	int32_t read(bx::ReaderI* _reader, bgfx::VertexLayout& _layout, bx::Error* _err = NULL);
 
+	/// Conversion between source and destination vertex layout, resolved once and executed on
+	/// blocks of vertices, 4 vertices per SIMD register. Results are bit-exact with
+	/// vertexUnpack/vertexPack. Plan is read-only after init, so disjoint vertex ranges can be
+	/// converted from multiple threads with the same plan.
+	///
+	struct VertexConvertPlan
+	{
+		///
+		VertexConvertPlan();
+
+		///
+		void init(const VertexLayout& _destLayout, const VertexLayout& _srcLayout);
+
+		///
+		void convert(void* _destData, const void* _srcData, uint32_t _num) const;
+
+		struct Op
+		{
+			enum Enum
+			{
+				Set,
+				Copy,
+				Convert,
+			};
+
+			uint16_t src;
+			uint16_t dest;
+			uint8_t  size;
+			uint8_t  op;
+			uint8_t  srcType;
+			uint8_t  srcNum;
+			uint8_t  srcSize;
+			uint8_t  destType;
+			uint8_t  destNum;
+			uint8_t  destSize;
+			bool     srcAsInt;
+			bool     destAsInt;
+		};
+
+		Op       m_op[Attrib::Count];
+		uint32_t m_numOps;
+		uint16_t m_srcStride;
+		uint16_t m_destStride;
+		bool     m_memCopy;
+	};
+
 	///
 	uint32_t weldVertices(void* _output, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, bx::AllocatorI* _allocator);
 
+	/// Weld vertices with position within `_epsilon`. With `_attributes` set, normal and first
+	/// texture coordinate must be within `_epsilon` too. When `_outVertices` is not NULL, unique
+	/// vertices are copied to it in order of first appearance, and `_output` remaps into it,
+	/// otherwise `_output` remaps to first occurrence in `_data`. `_outVertices` can be the same
+	/// as `_data`.
+	uint32_t weldVertices(void* _output, void* _outVertices, const VertexLayout& _layout, const void* _data, uint32_t _num, bool _index32, float _epsilon, bool _attributes, bx::AllocatorI* _allocator);
+
 } // namespace bgfx
 
 #endif // BGFX_VERTEXDECL_H_HEADER_GUARD
@@ -20,7 +20,7 @@ namespace stl = tinystl;
 #include <cgltf/cgltf.h>
 
 #define BGFX_GEOMETRYC_VERSION_MAJOR 1
-#define BGFX_GEOMETRYC_VERSION_MINOR 0
+#define BGFX_GEOMETRYC_VERSION_MINOR 1
 
 #if 0
 #	define BX_TRACE(_format, ...) \
@@ -158,15 +158,30 @@ constexpr uint32_t kChunkIndexBuffer            = BX_MAKEFOURCC('I', 'B', ' ', 0
 constexpr uint32_t kChunkIndexBufferCompressed  = BX_MAKEFOURCC('I', 'B', 'C', 0x1);
 constexpr uint32_t kChunkPrimitive              = BX_MAKEFOURCC('P', 'R', 'I', 0x0);
 
-void optimizeVertexCache(uint16_t* _indices, uint32_t _numIndices, uint32_t _numVertices)
+// 32-bit vertex count and index variants, no 64K vertices per group limit.
+constexpr uint32_t kChunkVertexBuffer32           = BX_MAKEFOURCC('V', 'B', '3', 0x0);
+constexpr uint32_t kChunkVertexBufferCompressed32 = BX_MAKEFOURCC('V', 'B', 'D', 0x0);
+constexpr uint32_t kChunkIndexBuffer32            = BX_MAKEFOURCC('I', 'B', '3', 0x0);
+constexpr uint32_t kChunkIndexBufferCompressed32  = BX_MAKEFOURCC('I', 'B', 'D', 0x0);
+
+constexpr uint32_t kChunkMeshlet                  = BX_MAKEFOURCC('M', 'S', 'H', 0x0);
+constexpr uint32_t kChunkLod                      = BX_MAKEFOURCC('L', 'O', 'D', 0x0);
+
+constexpr uint32_t kMeshletMaxVertices  = 64;
+constexpr uint32_t kMeshletMaxTriangles = 124;
+constexpr float    kMeshletConeWeight   = 0.25f;
+
+constexpr uint32_t kMaxLods = 8;
+
+void optimizeVertexCache(uint32_t* _indices, uint32_t _numIndices, uint32_t _numVertices)
 {
-	uint16_t* newIndexList = new uint16_t[_numIndices];
+	uint32_t* newIndexList = new uint32_t[_numIndices];
 	meshopt_optimizeVertexCache(newIndexList, _indices, _numIndices, _numVertices);
-	bx::memCopy(_indices, newIndexList, _numIndices * 2);
+	bx::memCopy(_indices, newIndexList, _numIndices * sizeof(uint32_t) );
 	delete[] newIndexList;
 }
 
-uint32_t optimizeVertexFetch(uint16_t* _indices, uint32_t _numIndices, uint8_t* _vertexData, uint32_t _numVertices, uint16_t _stride)
+uint32_t optimizeVertexFetch(uint32_t* _indices, uint32_t _numIndices, uint8_t* _vertexData, uint32_t _numVertices, uint16_t _stride)
 {
 	unsigned char* newVertices = (unsigned char*)malloc(_numVertices * _stride );
 	size_t vertexCount = meshopt_optimizeVertexFetch(newVertices, _indices, _numIndices, _vertexData, _numVertices, _stride);
@@ -176,15 +191,16 @@ uint32_t optimizeVertexFetch(uint16_t* _indices, uint32_t _numIndices, uint8_t*
 	return uint32_t(vertexCount);
 }
 
-void writeCompressedIndices(bx::WriterI* _writer, const uint16_t* _indices, uint32_t _numIndices, uint32_t _numVertices)
+template<typename Ty>
+void writeCompressedIndices(bx::WriterI* _writer, const Ty* _indices, uint32_t _numIndices, uint32_t _numVertices)
 {
 	size_t maxSize = meshopt_encodeIndexBufferBound(_numIndices, _numVertices);
 	unsigned char* compressedIndices = (unsigned char*)malloc(maxSize);
 	size_t compressedSize = meshopt_encodeIndexBuffer(compressedIndices, maxSize, _indices, _numIndices);
 	bx::printf("Indices uncompressed: %10d, compressed: %10d, ratio: %0.2f%%\n"
-		, _numIndices*2
+		, _numIndices*uint32_t(sizeof(Ty) )
 		, (uint32_t)compressedSize
-		, 100.0f - float(compressedSize ) / float(_numIndices*2)*100.0f
+		, 100.0f - float(compressedSize ) / float(_numIndices*sizeof(Ty) )*100.0f
 		);
 
 	bx::write(_writer, (uint32_t)compressedSize);
@@ -208,7 +224,7 @@ void writeCompressedVertices(bx::WriterI* _writer,  const uint8_t* _vertices, ui
 	free(compressedVertices);
 }
 
-void calcTangents(void* _vertices, uint16_t _numVertices, bgfx::VertexLayout _layout, const uint16_t* _indices, uint32_t _numIndices)
+void calcTangents(void* _vertices, uint32_t _numVertices, bgfx::VertexLayout _layout, const uint32_t* _indices, uint32_t _numIndices)
 {
 	struct PosTexcoord
 	{
@@ -231,7 +247,7 @@ void calcTangents(void* _vertices, uint16_t _numVertices, bgfx::VertexLayout _la
 
 	for (uint32_t ii = 0, num = _numIndices/3; ii < num; ++ii)
 	{
-		const uint16_t* indices = &_indices[ii*3];
+		const uint32_t* indices = &_indices[ii*3];
 		uint32_t i0 = indices[0];
 		uint32_t i1 = indices[1];
 		uint32_t i2 = indices[2];
@@ -331,14 +347,207 @@ void write(bx::WriterI* _writer, const void* _vertices, uint32_t _numVertices, u
 	bx::write(_writer, obb);
 }
 
+void writeIndices(bx::WriterI* _writer, const uint32_t* _indices, uint32_t _numIndices, uint32_t _numVertices, bool _index32, bool _compress)
+{
+	using namespace bx;
+
+	write(_writer, _numIndices);
+
+	if (_index32)
+	{
+		if (_compress)
+		{
+			writeCompressedIndices(_writer, _indices, _numIndices, _numVertices);
+		}
+		else
+		{
+			write(_writer, _indices, _numIndices*sizeof(uint32_t) );
+		}
+
+		return;
+	}
+
+	uint16_t* indices = new uint16_t[_numIndices];
+	for (uint32_t ii = 0; ii < _numIndices; ++ii)
+	{
+		indices[ii] = uint16_t(_indices[ii]);
+	}
+
+	if (_compress)
+	{
+		writeCompressedIndices(_writer, indices, _numIndices, _numVertices);
+	}
+	else
+	{
+		write(_writer, indices, _numIndices*sizeof(uint16_t) );
+	}
+
+	delete [] indices;
+}
+
+void writeMeshlets(bx::WriterI* _writer, const uint8_t* _vertices, uint32_t _numVertices, uint32_t _stride, const uint32_t* _indices, uint32_t _numIndices)
+{
+	using namespace bx;
+
+	const size_t maxMeshlets = meshopt_buildMeshletsBound(_numIndices, kMeshletMaxVertices, kMeshletMaxTriangles);
+
+	stl::vector<meshopt_Meshlet> meshlets(maxMeshlets);
+	stl::vector<uint32_t> meshletVertices(maxMeshlets * kMeshletMaxVertices);
+	stl::vector<uint8_t> meshletTriangles(maxMeshlets * kMeshletMaxTriangles * 3);
+
+	const float* positions = (const float*)_vertices;
+
+	const uint32_t numMeshlets = uint32_t(meshopt_buildMeshlets(
+		  meshlets.data()
+		, meshletVertices.data()
+		, meshletTriangles.data()
+		, _indices
+		, _numIndices
+		, positions
+		, _numVertices
+		, _stride
+		, kMeshletMaxVertices
+		, kMeshletMaxTriangles
+		, kMeshletConeWeight
+		) );
+
+	uint32_t numMeshletVertices  = 0;
+	uint32_t numMeshletTriangles = 0;
+
+	if (0 < numMeshlets)
+	{
+		// Triangles of each meshlet are padded to 4 bytes.
+		const meshopt_Meshlet& last = meshlets[numMeshlets-1];
+		numMeshletVertices  = last.vertex_offset + last.vertex_count;
+		numMeshletTriangles = last.triangle_offset + ( (last.triangle_count*3 + 3) & ~3);
+	}
+
+	write(_writer, kChunkMeshlet);
+	write(_writer, numMeshlets);
+
+	for (uint32_t ii = 0; ii < numMeshlets; ++ii)
+	{
+		const meshopt_Meshlet& meshlet = meshlets[ii];
+
+		const meshopt_Bounds bounds = meshopt_computeMeshletBounds(
+			  &meshletVertices[meshlet.vertex_offset]
+			, &meshletTriangles[meshlet.triangle_offset]
+			, meshlet.triangle_count
+			, positions
+			, _numVertices
+			, _stride
+			);
+
+		write(_writer, meshlet.vertex_offset);
+		write(_writer, meshlet.triangle_offset);
+		write(_writer, meshlet.vertex_count);
+		write(_writer, meshlet.triangle_count);
+
+		Sphere sphere;
+		sphere.center = bx::load<bx::Vec3>(bounds.center);
+		sphere.radius = bounds.radius;
+		write(_writer, sphere);
+
+		write(_writer, bounds.cone_apex, sizeof(bounds.cone_apex) );
+		write(_writer, bounds.cone_axis, sizeof(bounds.cone_axis) );
+		write(_writer, bounds.cone_cutoff);
+	}
+
+	write(_writer, numMeshletVertices);
+	write(_writer, meshletVertices.data(), numMeshletVertices*sizeof(uint32_t) );
+	write(_writer, numMeshletTriangles);
+	write(_writer, meshletTriangles.data(), numMeshletTriangles);
+
+	bx::printf("Meshlets: %10d, vertices: %10d, triangle bytes: %10d\n"
+		, numMeshlets
+		, numMeshletVertices
+		, numMeshletTriangles
+		);
+}
+
+void writeLods(bx::WriterI* _writer, const uint8_t* _vertices, uint32_t _numVertices, uint32_t _stride, const uint32_t* _indices, uint32_t _numIndices, uint32_t _numLods, bool _index32, bool _compress)
+{
+	using namespace bx;
+
+	const float* positions = (const float*)_vertices;
+	const float  scale     = meshopt_simplifyScale(positions, _numVertices, _stride);
+
+	stl::vector<uint32_t> lodIndices[kMaxLods];
+	float lodError[kMaxLods];
+
+	uint32_t numLods = 0;
+	uint32_t prevNumIndices = _numIndices;
+
+	for (uint32_t lod = 1; lod <= _numLods; ++lod)
+	{
+		stl::vector<uint32_t>& indices = lodIndices[numLods];
+		indices.resize(_numIndices);
+
+		// Each level halves triangle count, allowing more deformation at each step.
+		const uint32_t targetNumIndices = (_numIndices >> lod) / 3 * 3;
+		const float    targetError      = 0.01f * float(1<<lod);
+
+		float error = 0.0f;
+		const uint32_t numIndices = uint32_t(meshopt_simplify(
+			  indices.data()
+			, _indices
+			, _numIndices
+			, positions
+			, _numVertices
+			, _stride
+			, targetNumIndices
+			, targetError
+			, &error
+			) );
+
+		if (0 == numIndices
+		||  numIndices >= prevNumIndices)
+		{
+			// Simplifier can't go further within error budget.
+			break;
+		}
+
+		indices.resize(numIndices);
+		optimizeVertexCache(indices.data(), numIndices, _numVertices);
+
+		lodError[numLods] = error * scale;
+		prevNumIndices = numIndices;
+		++numLods;
+	}
+
+	if (0 == numLods)
+	{
+		return;
+	}
+
+	write(_writer, kChunkLod);
+	write(_writer, uint8_t(_compress) );
+	write(_writer, uint16_t(numLods) );
+
+	for (uint32_t ii = 0; ii < numLods; ++ii)
+	{
+		write(_writer, lodError[ii]);
+		writeIndices(_writer, lodIndices[ii].data(), uint32_t(lodIndices[ii].size() ), _numVertices, _index32, _compress);
+
+		bx::printf("LOD %d: indices: %10d, error: %f\n"
+			, ii + 1
+			, uint32_t(lodIndices[ii].size() )
+			, lodError[ii]
+			);
+	}
+}
+
 void write(
 	  bx::WriterI* _writer
 	, const uint8_t* _vertices
 	, uint32_t _numVertices
 	, const bgfx::VertexLayout& _layout
-	, const uint16_t* _indices
+	, const uint32_t* _indices
 	, uint32_t _numIndices
+	, bool _index32
 	, bool _compress
+	, bool _meshlets
+	, uint32_t _numLods
 	, const stl::string& _material
 	, const PrimitiveArray& _primitives
 	)
@@ -350,36 +559,60 @@ void write(
 
 	if (_compress)
 	{
-		write(_writer, kChunkVertexBufferCompressed);
+		write(_writer, _index32 ? kChunkVertexBufferCompressed32 : kChunkVertexBufferCompressed);
 		write(_writer, _vertices, _numVertices, stride);
 
 		write(_writer, _layout);
 
-		write(_writer, uint16_t(_numVertices) );
+		if (_index32)
+		{
+			write(_writer, _numVertices);
+		}
+		else
+		{
+			write(_writer, uint16_t(_numVertices) );
+		}
+
 		writeCompressedVertices(_writer, _vertices, _numVertices, uint16_t(stride) );
 	}
 	else
 	{
-		write(_writer, kChunkVertexBuffer);
+		write(_writer, _index32 ? kChunkVertexBuffer32 : kChunkVertexBuffer);
 		write(_writer, _vertices, _numVertices, stride);
 
 		write(_writer, _layout);
 
-		write(_writer, uint16_t(_numVertices) );
+		if (_index32)
+		{
+			write(_writer, _numVertices);
+		}
+		else
+		{
+			write(_writer, uint16_t(_numVertices) );
+		}
+
 		write(_writer, _vertices, _numVertices*stride);
 	}
 
 	if (_compress)
 	{
-		write(_writer, kChunkIndexBufferCompressed);
-		write(_writer, _numIndices);
-		writeCompressedIndices(_writer, _indices, _numIndices, _numVertices);
+		write(_writer, _index32 ? kChunkIndexBufferCompressed32 : kChunkIndexBufferCompressed);
 	}
 	else
 	{
-		write(_writer, kChunkIndexBuffer);
-		write(_writer, _numIndices);
-		write(_writer, _indices, _numIndices*2);
+		write(_writer, _index32 ? kChunkIndexBuffer32 : kChunkIndexBuffer);
+	}
+
+	writeIndices(_writer, _indices, _numIndices, _numVertices, _index32, _compress);
+
+	if (_meshlets)
+	{
+		writeMeshlets(_writer, _vertices, _numVertices, stride, _indices, _numIndices);
+	}
+
+	if (0 < _numLods)
+	{
+		writeLods(_writer, _vertices, _numVertices, stride, _indices, _numIndices, _numLods, _index32, _compress);
 	}
 
 	write(_writer, kChunkPrimitive);
@@ -934,6 +1167,9 @@ void help(const char* _error = NULL)
 		  "      --tangent            Calculate tangent vectors (packing mode is the same as normal).\n"
 		  "      --barycentric        Adds barycentric vertex attribute (packed in bgfx::Attrib::Color1).\n"
 		  "  -c, --compress           Compress indices.\n"
+		  "      --index32            Use 32-bit indices, groups are not split at 64K vertices.\n"
+		  "      --meshlets           Build meshlets with bounding spheres and normal cones for culling.\n"
+		  "      --lod <num>          Number of simplified LOD levels, each halving triangle count (max 8).\n"
 		  "      --[l/r]h-up+[y/z]	  Coordinate system. Default is '--lh-up+y' Left-Handed +Y is up.\n"
 
 		  "\n"
@@ -1001,6 +1237,12 @@ int main(int _argc, const char* _argv[])
 	bool flipV = cmdLine.hasArg("flipv");
 	bool hasTangent = cmdLine.hasArg("tangent");
 	bool hasBc = cmdLine.hasArg("barycentric");
+	bool index32 = cmdLine.hasArg("index32");
+	bool meshlets = cmdLine.hasArg("meshlets");
+
+	uint32_t numLods = 0;
+	cmdLine.hasArg(numLods, '\0', "lod");
+	numLods = bx::uint32_min(numLods, kMaxLods);
 
 	CoordinateSystem outputCoordinateSystem;
 	outputCoordinateSystem.m_handness = bx::Handness::Left;
@@ -1189,7 +1431,7 @@ int main(int _argc, const char* _argv[])
 
 	uint32_t stride = layout.getStride();
 	uint8_t* vertexData = new uint8_t[mesh.m_triangles.size() * 3 * stride];
-	uint16_t* indexData = new uint16_t[mesh.m_triangles.size() * 3];
+	uint32_t* indexData = new uint32_t[mesh.m_triangles.size() * 3];
 	int32_t numVertices = 0;
 	int32_t numIndices = 0;
 
@@ -1198,9 +1440,13 @@ int main(int _argc, const char* _argv[])
 	int32_t writtenIndices = 0;
 
 	uint8_t* vertices = vertexData;
-	uint16_t* indices = indexData;
+	uint32_t* indices = indexData;
 
-	const uint32_t tableSize = 65536 * 2;
+	// With 32-bit indices groups are not split, hash table must fit all vertices of the mesh.
+	const uint32_t tableSize = index32
+		? bx::uint32_max(bx::uint32_nextpow2(uint32_t(mesh.m_triangles.size() ) * 3 * 2), 65536 * 2)
+		: 65536 * 2
+		;
 	const uint32_t hashmod = tableSize - 1;
 	uint32_t* table = new uint32_t[tableSize];
 	bx::memSet(table, 0xff, tableSize * sizeof(uint32_t) );
@@ -1236,7 +1482,7 @@ int main(int _argc, const char* _argv[])
 		{
 			if (0 != bx::strCmp(material.c_str(), groupIt->m_material.c_str() )
 			|| sentinel
-			||  65533 <= numVertices)
+			|| (!index32 && 65533 <= numVertices) )
 			{
 				prim.m_numVertices = numVertices - prim.m_startVertex;
 				prim.m_numIndices  = numIndices  - prim.m_startIndex;
@@ -1247,7 +1493,7 @@ int main(int _argc, const char* _argv[])
 
 				if (hasTangent)
 				{
-					calcTangents(vertexData, uint16_t(numVertices), layout, indexData, numIndices);
+					calcTangents(vertexData, numVertices, layout, indexData, numIndices);
 				}
 
 				triReorderElapsed -= bx::getHPCounter();
@@ -1268,7 +1514,10 @@ int main(int _argc, const char* _argv[])
 						  , layout
 						  , indexData
 						  , numIndices
+						  , index32
 						  , compress
+						  , meshlets
+						  , numLods
 						  , material
 						  , primitives
 						  );
@@ -1372,7 +1621,7 @@ int main(int _argc, const char* _argv[])
 					exit(bx::kExitFailure);
 				}
 
-				*indices++ = (uint16_t)vertexIndex;
+				*indices++ = vertexIndex;
 				++numIndices;
 			}
 		}
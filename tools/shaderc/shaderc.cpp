@@ -254,6 +254,13 @@ namespace bgfx
 		NULL
 	};
 
+	static const char* s_ARB_bindless_texture[] =
+	{
+		"textureBindless2D",
+		"textureBindless2DLod",
+		NULL
+	};
+
 	const char* s_uniformTypeName[] =
 	{
 		"int",  "int",
@@ -1225,6 +1232,14 @@ namespace bgfx
 			return false;
 		}
 
+		// Bindless texture declarations in bgfx_shader.sh are opt-in, only shaders that sample
+		// textures by index pay for global descriptor array.
+		const bool usesBindlessTexture = !bx::findIdentifierMatch(_shader, s_ARB_bindless_texture).isEmpty();
+		if (usesBindlessTexture)
+		{
+			preprocessor.setDefine("BGFX_SHADER_TEXTURE_BINDLESS=1");
+		}
+
 		bool compiled = false;
 
 		VaryingMap varyingMap;
@@ -2425,6 +2440,13 @@ namespace bgfx
 							{
 								bx::stringPrintf(code, "#version %d\n", glsl_profile);
 
+								if (usesBindlessTexture)
+								{
+									bx::stringPrintf(code
+										, "#extension GL_ARB_bindless_texture : require\n"
+										);
+								}
+
 								bx::stringPrintf(code
 									, "#define texture2DLod       textureLod\n"
 									  "#define texture2DGrad      textureGrad\n"
@@ -723,9 +723,19 @@ namespace bgfx { namespace spirv
 					spirv_cross::CompilerReflection refl(spirv);
 					spirv_cross::ShaderResources resourcesrefl = refl.get_shader_resources();
 
+					bool bindless = false;
+
 					// Loop through the separate_images, and extract the uniform names:
 					for (auto &resource : resourcesrefl.separate_images)
 					{
+						if (0 != refl.get_decoration(resource.id, spv::Decoration::DecorationDescriptorSet) )
+						{
+							// Bindless texture array lives in its own descriptor set, and it's not
+							// bound per draw.
+							bindless = true;
+							continue;
+						}
+
 						std::string name = refl.get_name(resource.id);
 
 						if (name.size() > 7
@@ -817,6 +827,19 @@ namespace bgfx { namespace spirv
 						uniforms.push_back(un);
 					}
 
+					if (bindless)
+					{
+						Uniform un;
+						un.name = "s_bindlessTexture";
+						un.type = UniformType::End;
+						un.num = 0;
+						un.regIndex = 0;
+						un.regCount = descriptorTypeToId(DescriptorType::BindlessTexture);
+						un.texFormat = 0;
+
+						uniforms.push_back(un);
+					}
+
 					uint16_t size = writeUniformArray( _writer, uniforms, _options.shaderType == 'f');
 
 					uint32_t shaderSize = (uint32_t)spirv.size() * sizeof(uint32_t);